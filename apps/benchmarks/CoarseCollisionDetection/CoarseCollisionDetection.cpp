@@ -0,0 +1,237 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file CoarseCollisionDetection.cpp
+//! \brief Benchmark of the coarse collision detection of the pe (HashGrids and SimpleCCD)
+//
+//======================================================================================================================
+
+#include "pe/basic.h"
+#include "pe/ccd/SimpleCCDDataHandling.h"
+#include "pe/cr/PlainIntegrator.h"
+
+#include "blockforest/Initialization.h"
+
+#include "core/Environment.h"
+#include "core/OpenMP.h"
+#include "core/logging/Logging.h"
+#include "core/math/Random.h"
+#include "core/timing/TimingPool.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace coarse_collision_detection {
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Sphere, Plane> BodyTuple;
+
+
+
+static int maxThreads()
+{
+#ifdef _OPENMP
+   return omp_get_max_threads();
+#else
+   return 1;
+#endif
+}
+
+static std::string threadsString( const int threads )
+{
+   return std::to_string( threads ) + ( threads == 1 ? " thread" : " threads" );
+}
+
+static void setThreads( const int threads )
+{
+#ifdef _OPENMP
+   omp_set_num_threads( threads );
+#else
+   WALBERLA_UNUSED( threads );
+#endif
+}
+
+
+
+/// Moves all spheres back to their initial positions and velocities.
+static void reset( const std::vector<BodyID> & bodies, const std::vector<Vec3> & positions, const std::vector<Vec3> & velocities )
+{
+   for( size_t i = 0; i < bodies.size(); ++i )
+   {
+      bodies[i]->setPosition( positions[i] );
+      bodies[i]->setLinearVel( velocities[i] );
+   }
+}
+
+
+
+/// Runs 'timesteps' time steps of the plain integrator and measures the coarse collision detection
+/// of 'ccdID' after each step. Returns the number of (fine) contacts of each time step.
+static std::vector<size_t> run( const std::string & name, BlockForest & forest, const BlockDataID ccdID, const BlockDataID fcdID,
+                                cr::PlainIntegrator & integrator, const uint_t timesteps, const real_t dt, WcTimingPool & timing )
+{
+   std::vector<size_t> contacts;
+
+   for( uint_t t = 0; t < timesteps; ++t )
+   {
+      integrator( dt );
+
+      for( auto block = forest.begin(); block != forest.end(); ++block )
+      {
+         ccd::ICCD * ccd = block->getData< ccd::ICCD >( ccdID );
+         fcd::IFCD * fcd = block->getData< fcd::IFCD >( fcdID );
+
+         timing[name].start();
+         PossibleContacts & possibleContacts = ccd->generatePossibleContacts();
+         timing[name].end();
+
+         contacts.push_back( fcd->generateContacts( possibleContacts ).size() );
+      }
+   }
+
+   return contacts;
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   Environment env( argc, argv );
+
+   if( MPIManager::instance()->numProcesses() != 1 )
+      WALBERLA_ABORT( "This benchmark measures the coarse collision detection of a single process, run it without MPI!" );
+
+   if( !env.config() )
+      WALBERLA_ABORT( "No configuration file specified!" );
+
+   Config::BlockHandle configBlock = env.config()->getBlock( "CoarseCollisionDetection" );
+
+   const uint_t numParticles          = configBlock.getParameter< uint_t >( "numParticles", uint_t(100000) );
+   const real_t radius                = configBlock.getParameter< real_t >( "radius", real_t(0.5) );
+   const real_t spacing               = configBlock.getParameter< real_t >( "spacing", real_t(1.05) );
+   const real_t vMax                  = configBlock.getParameter< real_t >( "vMax", real_t(0.1) ) * radius;
+   const uint_t timesteps             = configBlock.getParameter< uint_t >( "timesteps", uint_t(10) );
+   const uint_t cellSortingInterval   = configBlock.getParameter< uint_t >( "cellSortingInterval", uint_t(5) );
+   const uint_t maxSimpleCCDParticles = configBlock.getParameter< uint_t >( "maxSimpleCCDParticles", uint_t(5000) );
+   const real_t dt                    = real_t(1);
+
+   // spheres on a simple cubic lattice in a cubic domain
+
+   const uint_t spheresPerDirection = uint_c( std::ceil( std::pow( real_c( numParticles ), real_t(1) / real_t(3) ) ) );
+   const real_t edge = real_c( spheresPerDirection ) * spacing;
+
+   shared_ptr< BlockForest > forest = blockforest::createBlockForest( math::AABB( 0, 0, 0, edge, edge, edge ), 1, 1, 1, 1, 1, 1 );
+
+   shared_ptr< BodyStorage > globalBodyStorage = make_shared< BodyStorage >();
+
+   SetBodyTypeIDs< BodyTuple >::execute();
+
+   auto storageID = forest->addBlockData( createStorageDataHandling< BodyTuple >(), "Storage" );
+   auto hccdID    = forest->addBlockData( ccd::createHashGridsDataHandling( globalBodyStorage, storageID ), "HCCD" );
+   auto sccdID    = forest->addBlockData( ccd::createSimpleCCDDataHandling( globalBodyStorage, storageID ), "SCCD" );
+   auto fcdID     = forest->addBlockData( fcd::createGenericFCDDataHandling< BodyTuple, fcd::AnalyticCollideFunctor >(), "FCD" );
+
+   cr::PlainIntegrator integrator( globalBodyStorage, forest, storageID, NULL );
+
+   const math::AABB & domain = forest->getDomain();
+   createPlane( *globalBodyStorage, 0, Vec3( 1, 0, 0), domain.minCorner() );
+   createPlane( *globalBodyStorage, 0, Vec3(-1, 0, 0), domain.maxCorner() );
+   createPlane( *globalBodyStorage, 0, Vec3( 0, 1, 0), domain.minCorner() );
+   createPlane( *globalBodyStorage, 0, Vec3( 0,-1, 0), domain.maxCorner() );
+   createPlane( *globalBodyStorage, 0, Vec3( 0, 0, 1), domain.minCorner() );
+   createPlane( *globalBodyStorage, 0, Vec3( 0, 0,-1), domain.maxCorner() );
+
+   math::seedRandomGenerator( 42 );
+
+   std::vector< BodyID > bodies;
+   std::vector< Vec3 >   positions;
+   std::vector< Vec3 >   velocities;
+   for( uint_t i = 0; i < numParticles; ++i )
+   {
+      const uint_t x = i % spheresPerDirection;
+      const uint_t y = ( i / spheresPerDirection ) % spheresPerDirection;
+      const uint_t z = i / ( spheresPerDirection * spheresPerDirection );
+      const Vec3 position( ( real_c(x) + real_t(0.5) ) * spacing, ( real_c(y) + real_t(0.5) ) * spacing, ( real_c(z) + real_t(0.5) ) * spacing );
+
+      SphereID sphere = createSphere( *globalBodyStorage, *forest, storageID, i, position, radius );
+      WALBERLA_CHECK_NOT_NULLPTR( sphere );
+      sphere->setLinearVel( Vec3( math::realRandom< real_t >( -vMax, vMax ), math::realRandom< real_t >( -vMax, vMax ), math::realRandom< real_t >( -vMax, vMax ) ) );
+
+      bodies.push_back( sphere );
+      positions.push_back( sphere->getPosition() );
+      velocities.push_back( sphere->getLinearVel() );
+   }
+
+   const int threads = maxThreads();
+
+   WALBERLA_LOG_INFO( "Coarse collision detection benchmark:"
+                      "\n   number of spheres: " << numParticles <<
+                      "\n   time steps:        " << timesteps <<
+                      "\n   threads:           " << threads );
+
+   WcTimingPool timing;
+
+   // the hierarchical hash grids with a single thread: the sequential reference
+
+   setThreads( 1 );
+   const std::string sequential( "HashGrids (" + threadsString( 1 ) + ")" );
+   std::vector< size_t > reference = run( sequential, *forest, hccdID, fcdID, integrator, timesteps, dt, timing );
+
+   if( threads > 1 )
+   {
+      reset( bodies, positions, velocities );
+      setThreads( threads );
+      const std::string parallel( "HashGrids (" + threadsString( threads ) + ")" );
+      std::vector< size_t > contacts = run( parallel, *forest, hccdID, fcdID, integrator, timesteps, dt, timing );
+      WALBERLA_CHECK_EQUAL( contacts, reference );
+   }
+
+   if( cellSortingInterval > 0 )
+   {
+      reset( bodies, positions, velocities );
+      setThreads( threads );
+      for( auto block = forest->begin(); block != forest->end(); ++block )
+         block->getData< ccd::HashGrids >( hccdID )->setCellSortingInterval( cellSortingInterval );
+      const std::string sorted( "HashGrids (" + threadsString( threads ) + ", sorted cells)" );
+      std::vector< size_t > contacts = run( sorted, *forest, hccdID, fcdID, integrator, timesteps, dt, timing );
+      WALBERLA_CHECK_EQUAL( contacts, reference );
+   }
+
+   if( numParticles <= maxSimpleCCDParticles )
+   {
+      reset( bodies, positions, velocities );
+      std::vector< size_t > contacts = run( "SimpleCCD", *forest, sccdID, fcdID, integrator, timesteps, dt, timing );
+      WALBERLA_CHECK_EQUAL( contacts, reference );
+   }
+   else
+   {
+      WALBERLA_LOG_INFO( "SimpleCCD skipped (more than " << maxSimpleCCDParticles << " spheres)" );
+   }
+
+   WALBERLA_LOG_INFO( "Contacts in the first/last time step: " << reference.front() << " / " << reference.back() );
+   timing.logResultOnRoot();
+
+   return EXIT_SUCCESS;
+}
+
+} // namespace coarse_collision_detection
+
+int main( int argc, char ** argv )
+{
+   return coarse_collision_detection::main( argc, argv );
+}
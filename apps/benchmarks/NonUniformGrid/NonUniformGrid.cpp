@@ -593,13 +593,14 @@ template< typename LatticeModel_T, typename Sweep_T >
 void addRefinementTimeStep( SweepTimeloop & timeloop, shared_ptr< blockforest::StructuredBlockForest > & blocks,
                             const BlockDataID & pdfFieldId, const BlockDataID & boundaryHandlingId,
                             const shared_ptr<WcTimingPool> & timingPool, const shared_ptr<WcTimingPool> & levelwiseTimingPool,
-                            const bool syncComm, const bool fullComm, const bool linearExplosion,
+                            const bool syncComm, const bool pipelinedComm, const bool fullComm, const bool linearExplosion,
                             shared_ptr< Sweep_T > & sweep, const std::string & info )
 {
    typedef typename MyBoundaryHandling< LatticeModel_T >::BoundaryHandling_T BH_T;
 
    auto ts = lbm::refinement::makeTimeStep< LatticeModel_T, BH_T >( blocks, sweep, pdfFieldId, boundaryHandlingId );
    ts->asynchronousCommunication( !syncComm );
+   ts->pipelinedCommunication( pipelinedComm );
    ts->optimizeCommunication( !fullComm );
    ts->performLinearExplosion( linearExplosion );
    ts->enableTiming( timingPool, levelwiseTimingPool );
@@ -613,7 +614,7 @@ struct AddRefinementTimeStep
    static void add( SweepTimeloop & timeloop, shared_ptr< blockforest::StructuredBlockForest > & blocks,
                     const BlockDataID & pdfFieldId, const BlockDataID & flagFieldId, const BlockDataID & boundaryHandlingId,
                     const shared_ptr<WcTimingPool> & timingPool, const shared_ptr<WcTimingPool> & levelwiseTimingPool,
-                    const bool split, const bool pure, const bool syncComm, const bool fullComm, const bool linearExplosion )
+                    const bool split, const bool pure, const bool syncComm, const bool pipelinedComm, const bool fullComm, const bool linearExplosion )
    {
       if( split )
       {
@@ -623,7 +624,7 @@ struct AddRefinementTimeStep
             auto mySweep = make_shared< Sweep_T >( pdfFieldId );
 
             addRefinementTimeStep< LatticeModel_T, Sweep_T >( timeloop, blocks, pdfFieldId, boundaryHandlingId, timingPool, levelwiseTimingPool,
-                                                              syncComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (split pure LB sweep)" );
+                                                              syncComm, pipelinedComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (split pure LB sweep)" );
          }
          else
          {
@@ -631,7 +632,7 @@ struct AddRefinementTimeStep
             auto mySweep = make_shared< Sweep_T >( pdfFieldId, flagFieldId, Fluid_Flag );
 
             addRefinementTimeStep< LatticeModel_T, Sweep_T >( timeloop, blocks, pdfFieldId, boundaryHandlingId, timingPool, levelwiseTimingPool,
-                                                              syncComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (split LB sweep)" );
+                                                              syncComm, pipelinedComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (split LB sweep)" );
          }
       }
       else
@@ -639,7 +640,7 @@ struct AddRefinementTimeStep
          auto mySweep = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( pdfFieldId, flagFieldId, Fluid_Flag );
 
          addRefinementTimeStep< LatticeModel_T >( timeloop, blocks, pdfFieldId, boundaryHandlingId, timingPool, levelwiseTimingPool,
-                                                  syncComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (cell-wise LB sweep)" );
+                                                  syncComm, pipelinedComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (cell-wise LB sweep)" );
       }
    }
 };
@@ -651,12 +652,12 @@ struct AddRefinementTimeStep< LatticeModel_T, typename boost::enable_if_c< boost
    static void add( SweepTimeloop & timeloop, shared_ptr< blockforest::StructuredBlockForest > & blocks,
                     const BlockDataID & pdfFieldId, const BlockDataID & flagFieldId, const BlockDataID & boundaryHandlingId,
                     const shared_ptr<WcTimingPool> & timingPool, const shared_ptr<WcTimingPool> & levelwiseTimingPool,
-                    const bool /*split*/, const bool /*pure*/, const bool syncComm, const bool fullComm, const bool linearExplosion )
+                    const bool /*split*/, const bool /*pure*/, const bool syncComm, const bool pipelinedComm, const bool fullComm, const bool linearExplosion )
    {
       auto mySweep = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( pdfFieldId, flagFieldId, Fluid_Flag );
 
       addRefinementTimeStep< LatticeModel_T >( timeloop, blocks, pdfFieldId, boundaryHandlingId, timingPool, levelwiseTimingPool,
-                                               syncComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (cell-wise LB sweep)" );
+                                               syncComm, pipelinedComm, fullComm, linearExplosion, mySweep, "LBM refinement time step (cell-wise LB sweep)" );
    }
 };
 
@@ -664,7 +665,7 @@ struct AddRefinementTimeStep< LatticeModel_T, typename boost::enable_if_c< boost
 
 template< typename LatticeModel_T >
 void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeModel, const bool split, const bool pure,
-          const bool fzyx, const bool syncComm, const bool fullComm, const bool linearExplosion )
+          const bool fzyx, const bool syncComm, const bool pipelinedComm, const bool fullComm, const bool linearExplosion )
 {
    Config::BlockHandle configBlock = config->getBlock( "NonUniformGrid" );
 
@@ -720,7 +721,7 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
    shared_ptr<WcTimingPool> refinementTimeStepLevelwiseTiming = make_shared<WcTimingPool>();
 
    AddRefinementTimeStep< LatticeModel_T >::add( timeloop, blocks, pdfFieldId, flagFieldId, boundaryHandlingId, refinementTimeStepTiming,
-                                                 refinementTimeStepLevelwiseTiming, split, pure, syncComm, fullComm, linearExplosion );
+                                                 refinementTimeStepLevelwiseTiming, split, pure, syncComm, pipelinedComm, fullComm, linearExplosion );
                                                  
    // dynamic block structure refresh
    
@@ -842,6 +843,7 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
                               "\n- data layout:      " << ( fzyx ? "fzyx (structure of arrays [SoA])" : "zyxf (array of structures [AoS])" ) <<
                               "\n- communication:    " << ( fullComm ? ( syncComm ? "synchronous, full synchronization" : "asynchronous, full synchronization" ) :
                                                                        ( syncComm ? "synchronous, block neighborhood and direction-aware optimizations" : "asynchronous, block neighborhood and direction-aware optimizations" ) ) <<
+                              "\n- pipelined comm.:  " << ( ( pipelinedComm && !syncComm ) ? "yes" : "no" ) <<
                               "\n- linear explosion: " << ( linearExplosion ? "yes" : "no" ) );
 
    if( dynamicBlockStructure )
@@ -991,6 +993,7 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
             stringProperties[ "pureKernel" ]        = ( pure ? "yes" : "no" );
             stringProperties[ "dataLayout" ]        = ( fzyx ? "fzyx" : "zyxf" );
             stringProperties[ "syncCommunication" ] = ( syncComm ? "yes" : "no" );
+            stringProperties[ "pipelinedCommunication" ] = ( ( pipelinedComm && !syncComm ) ? "yes" : "no" );
             stringProperties[ "fullCommunication" ] = ( fullComm ? "yes" : "no" );
             stringProperties[ "linearExplosion" ]   = ( linearExplosion ? "yes" : "no" );
             
@@ -1060,6 +1063,7 @@ void run( const shared_ptr< Config > & config, const LatticeModel_T & latticeMod
                               "\n- data layout:      " << ( fzyx ? "fzyx (structure of arrays [SoA])" : "zyxf (array of structures [AoS])" ) <<
                               "\n- communication:    " << ( fullComm ? ( syncComm ? "synchronous, full synchronization" : "asynchronous, full synchronization" ) :
                                                                        ( syncComm ? "synchronous, block neighborhood and direction-aware optimizations" : "asynchronous, block neighborhood and direction-aware optimizations" ) ) <<
+                              "\n- pipelined comm.:  " << ( ( pipelinedComm && !syncComm ) ? "yes" : "no" ) <<
                               "\n- linear explosion: " << ( linearExplosion ? "yes" : "no" ) );
                               
    if( dynamicBlockStructure )
@@ -1119,7 +1123,7 @@ int main( int argc, char **argv )
    {
       WALBERLA_ROOT_SECTION()
       {
-         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt | --mrt] [--comp] [--split [--pure]] [--fzyx] [--sync-comm] [--full-comm] [--linear-exp]\n"
+         std::cout << "Usage: " << argv[0] << " path-to-configuration-file [--trt | --mrt] [--comp] [--split [--pure]] [--fzyx] [--sync-comm | --pipelined-comm] [--full-comm] [--linear-exp]\n"
                       "\n"
                       "By default, SRT is selected as collision model, an asynchronous communication scheme with block neighborhood and\n"
                       "direction-aware optimizations is chosen, and an incompressible, basic LB kernel is executed on a PDF field with\n"
@@ -1136,6 +1140,8 @@ int main( int argc, char **argv )
                       " --fzyx:       data layout switched to 'fzyx' (structure of arrays [SoA])\n"
                       " --sync-comm:  A synchronous communication scheme is used instead of an asynchronous scheme\n"
                       "               which is used by default.\n"
+                      " --pipelined-comm: The communication of each refinement level is only completed after the next coarser level has\n"
+                      "               performed its stream step (only available for the asynchronous communication scheme).\n"
                       " --full-comm:  A full synchronization of neighboring blocks is performed instead of using a communication\n"
                       "               that uses block neighborhood and direction-aware optimizations.\n"
                       " --linear-exp: When communicating from coarse to fine grids, a linear interpolation scheme is used\n"
@@ -1230,6 +1236,7 @@ int main( int argc, char **argv )
    bool pure            = false;
    bool fzyx            = false;
    bool syncComm        = false;
+   bool pipelinedComm   = false;
    bool fullComm        = false;
    bool linearExplosion = false;
 
@@ -1242,6 +1249,7 @@ int main( int argc, char **argv )
       if( std::strcmp( argv[i], "--pure" )       == 0 ) pure            = true;
       if( std::strcmp( argv[i], "--fzyx" )       == 0 ) fzyx            = true;
       if( std::strcmp( argv[i], "--sync-comm" )  == 0 ) syncComm        = true;
+      if( std::strcmp( argv[i], "--pipelined-comm" ) == 0 ) pipelinedComm = true;
       if( std::strcmp( argv[i], "--full-comm" )  == 0 ) fullComm        = true;
       if( std::strcmp( argv[i], "--linear-exp" ) == 0 ) linearExplosion = true;
    }
@@ -1271,12 +1279,12 @@ int main( int argc, char **argv )
       if( compressible )
       {
          D3Q19_SRT_COMP latticeModel = D3Q19_SRT_COMP( lbm::collision_model::SRT( omega ) );
-         run( config, latticeModel, split, pure, fzyx, syncComm, fullComm, linearExplosion );
+         run( config, latticeModel, split, pure, fzyx, syncComm, pipelinedComm, fullComm, linearExplosion );
       }
       else
       {
          D3Q19_SRT_INCOMP latticeModel = D3Q19_SRT_INCOMP( lbm::collision_model::SRT( omega ) );
-         run( config, latticeModel, split, pure, fzyx, syncComm, fullComm, linearExplosion );
+         run( config, latticeModel, split, pure, fzyx, syncComm, pipelinedComm, fullComm, linearExplosion );
       }
    }
    else if( collisionModel == CMTRT ) // TRT
@@ -1284,18 +1292,18 @@ int main( int argc, char **argv )
       if( compressible )
       {
          D3Q19_TRT_COMP latticeModel = D3Q19_TRT_COMP( lbm::collision_model::TRT::constructWithMagicNumber( omega ) );
-         run( config, latticeModel, split, pure, fzyx, syncComm, fullComm, linearExplosion );
+         run( config, latticeModel, split, pure, fzyx, syncComm, pipelinedComm, fullComm, linearExplosion );
       }
       else
       {
          D3Q19_TRT_INCOMP latticeModel = D3Q19_TRT_INCOMP( lbm::collision_model::TRT::constructWithMagicNumber( omega ) );
-         run( config, latticeModel, split, pure, fzyx, syncComm, fullComm, linearExplosion );
+         run( config, latticeModel, split, pure, fzyx, syncComm, pipelinedComm, fullComm, linearExplosion );
       }
    }
    else // MRT
    {
       D3Q19_MRT_INCOMP latticeModel = D3Q19_MRT_INCOMP( lbm::collision_model::D3Q19MRT::constructTRTWithMagicNumber( omega ) );
-      run( config, latticeModel, split, pure, fzyx, syncComm, fullComm, linearExplosion );
+      run( config, latticeModel, split, pure, fzyx, syncComm, pipelinedComm, fullComm, linearExplosion );
    }
 
    logging::Logging::printFooterOnStream();
@@ -0,0 +1,453 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BlockDataCheckpoint.cpp
+//! \ingroup blockforest
+//
+//======================================================================================================================
+
+#include "BlockDataCheckpoint.h"
+
+#include "core/Abort.h"
+#include "core/EndianIndependentSerialization.h"
+#include "core/LZCompression.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Broadcast.h"
+#include "core/mpi/Gatherv.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/MPITextFile.h"
+#include "core/mpi/Reduce.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+
+namespace walberla {
+namespace blockforest {
+
+
+
+const uint_t BlockDataCheckpoint::VERSION;
+const uint_t BlockDataCheckpoint::COMPRESSED;
+const uint_t BlockDataCheckpoint::DELTA;
+const uint_t BlockDataCheckpoint::HEADER_SIZE;
+
+static const char * const CHECKPOINT_MAGIC = "waLBCkpt";
+
+
+
+namespace internal {
+
+inline bool isLittleEndian()
+{
+   const uint16_t one = uint16_t(1);
+   return *reinterpret_cast< const uint8_t * >( &one ) == uint8_t(1);
+}
+
+inline bool sortBlocksByID( const IBlock * lhs, const IBlock * rhs ) { return lhs->getId() < rhs->getId(); }
+
+inline std::vector< IBlock * > sortedBlocks( BlockForest & forest )
+{
+   std::vector< IBlock * > blocks;
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      blocks.push_back( block.get() );
+   std::sort( blocks.begin(), blocks.end(), sortBlocksByID );
+   return blocks;
+}
+
+/// all files of a delta chain are located in the same directory -> comparing the file names is sufficient
+inline bool isPartOfChain( const std::vector< std::string > & chain, const std::string & filename )
+{
+   const boost::filesystem::path name = boost::filesystem::path( filename ).filename();
+   for( auto file = chain.begin(); file != chain.end(); ++file )
+      if( boost::filesystem::path( *file ).filename() == name )
+         return true;
+   return false;
+}
+
+inline void xorBytes( std::vector< uint8_t > & data, const std::vector< uint8_t > & other )
+{
+   WALBERLA_ASSERT_EQUAL( data.size(), other.size() );
+   for( uint_t i = 0; i != data.size(); ++i )
+      data[i] = uint8_c( data[i] ^ other[i] );
+}
+
+} // namespace internal
+
+
+
+BlockDataCheckpoint::BlockDataCheckpoint( const weak_ptr< BlockForest > & forest, const BlockDataID & id, const bool compress,
+                                          const uint_t deltaCheckpoints ) :
+   forest_( forest ), id_( id ), compress_( compress ), deltaCheckpoints_( deltaCheckpoints )
+{}
+
+
+
+void BlockDataCheckpoint::write( const std::string & filename, mpi::AsyncFileWriter * asyncWriter )
+{
+   auto forest = forest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access 'BlockDataCheckpoint' for a block storage object that doesn't exist anymore" );
+
+   // a delta checkpoint must not overwrite any file it depends on (reusing or alternating file names)
+   const uint_t depth = chain_.empty() ? uint_t(0) : uint_c( chain_.size() ) - uint_t(1);
+   const bool delta = !chain_.empty() && depth < deltaCheckpoints_ &&
+                      boost::filesystem::path( chain_.back() ).parent_path() == boost::filesystem::path( filename ).parent_path() &&
+                      !internal::isPartOfChain( chain_, filename );
+   const std::string referenceName = delta ? boost::filesystem::path( chain_.back() ).filename().string() : std::string();
+
+   WALBERLA_LOG_PROGRESS( "Writing " << ( delta ? "delta" : "full" ) << " checkpoint of block data \""
+                          << forest->getBlockDataIdentifier( id_ ) << "\" to file \"" << filename << "\"" );
+
+   // serialize (and compress) the data of all local blocks
+
+   std::vector< Entry > entries;
+   std::string data;
+   std::map< BlockID, std::vector< uint8_t > > current;
+
+   std::vector< IBlock * > blocks = internal::sortedBlocks( *forest );
+   for( auto it = blocks.begin(); it != blocks.end(); ++it )
+   {
+      mpi::SendBuffer buffer;
+      if( !forest->serializeBlockData( *it, id_, buffer ) )
+         continue;
+
+      Entry entry( static_cast< Block * >( *it )->getId() );
+      entry.offset_ = uint_c( data.size() );
+      entry.size_ = uint_c( buffer.size() );
+
+      std::vector< uint8_t > bytes( buffer.ptr(), buffer.ptr() + buffer.size() );
+      std::vector< uint8_t > stored( bytes );
+
+      if( delta )
+      {
+         auto previous = previous_.find( entry.id_ );
+         if( previous != previous_.end() && previous->second.size() == stored.size() )
+         {
+            internal::xorBytes( stored, previous->second );
+            entry.flags_ |= DELTA;
+         }
+      }
+
+      if( compress_ )
+      {
+         std::vector< uint8_t > compressed;
+         lzCompress( stored, compressed );
+         if( compressed.size() < stored.size() )
+         {
+            stored.swap( compressed );
+            entry.flags_ |= COMPRESSED;
+         }
+      }
+
+      entry.storedSize_ = uint_c( stored.size() );
+      if( !stored.empty() )
+         data.append( reinterpret_cast< const char * >( &(stored[0]) ), stored.size() );
+
+      entries.push_back( entry );
+
+      if( deltaCheckpoints_ > uint_t(0) )
+         current[ entry.id_ ].swap( bytes );
+   }
+
+   // file offsets: the header and the index (of all blocks) are followed by the data of all processes in rank order
+
+   uint_t numberOfBlocks = uint_c( entries.size() );
+   uint_t dataOffset = uint_t(0);
+
+   WALBERLA_MPI_SECTION()
+   {
+      numberOfBlocks = mpi::allReduce( numberOfBlocks, mpi::SUM, MPIManager::instance()->comm() );
+
+      uint_t dataSize = uint_c( data.size() );
+      MPI_Exscan( &dataSize, &dataOffset, 1, MPITrait< uint_t >::type(), MPI_SUM, MPIManager::instance()->comm() );
+      if( MPIManager::instance()->rank() == 0 )
+         dataOffset = uint_t(0);
+   }
+
+   const uint_t blockIdBytes = forest->getBlockIdBytes();
+   const uint_t entrySize = blockIdBytes + uint_t(4) * uint_t(8);
+   const uint_t headerSize = HEADER_SIZE + uint_c( referenceName.size() ) + numberOfBlocks * entrySize;
+
+   std::vector< uint8_t > index( entries.size() * entrySize );
+   for( uint_t i = 0; i != entries.size(); ++i )
+   {
+      const uint_t pos = i * entrySize;
+      entries[i].id_.toByteArray( index, pos, blockIdBytes );
+      uintToByteArray( headerSize + dataOffset + entries[i].offset_, index, pos + blockIdBytes, uint_t(8) );
+      uintToByteArray( entries[i].storedSize_, index, pos + blockIdBytes + uint_t(8),  uint_t(8) );
+      uintToByteArray( entries[i].size_,       index, pos + blockIdBytes + uint_t(16), uint_t(8) );
+      uintToByteArray( entries[i].flags_,      index, pos + blockIdBytes + uint_t(24), uint_t(8) );
+   }
+
+   index = mpi::gatherv( index, 0, MPIManager::instance()->comm() );
+
+   std::string processLocalPart;
+
+   if( MPIManager::instance()->rank() == 0 )
+   {
+      std::vector< uint8_t > header( HEADER_SIZE, uint8_t(0) );
+      std::memcpy( &(header[0]), CHECKPOINT_MAGIC, uint_t(8) );
+      uintToByteArray( VERSION,                                        header,  8, uint_t(8) );
+      uintToByteArray( internal::isLittleEndian() ? uint_t(1) : uint_t(0), header, 16, uint_t(8) );
+      uintToByteArray( blockIdBytes,                                   header, 24, uint_t(8) );
+      uintToByteArray( numberOfBlocks,                                 header, 32, uint_t(8) );
+      uintToByteArray( delta ? depth + uint_t(1) : uint_t(0),          header, 40, uint_t(8) );
+      uintToByteArray( uint_c( referenceName.size() ),                 header, 48, uint_t(8) );
+
+      processLocalPart.reserve( headerSize + data.size() );
+      processLocalPart.append( reinterpret_cast< const char * >( &(header[0]) ), header.size() );
+      processLocalPart.append( referenceName );
+      if( !index.empty() )
+         processLocalPart.append( reinterpret_cast< const char * >( &(index[0]) ), index.size() );
+      WALBERLA_ASSERT_EQUAL( processLocalPart.size(), headerSize );
+      processLocalPart.append( data );
+   }
+   else
+   {
+      processLocalPart.swap( data );
+   }
+
+   if( asyncWriter != NULL )
+      asyncWriter->writeMPITextFile( filename, processLocalPart, MPIManager::instance()->comm() );
+   else
+      mpi::writeMPITextFile( filename, processLocalPart, MPIManager::instance()->comm() );
+
+   if( deltaCheckpoints_ > uint_t(0) )
+   {
+      previous_.swap( current );
+      if( !delta )
+         chain_.clear();
+      chain_.push_back( filename );
+   }
+}
+
+
+
+void BlockDataCheckpoint::read( const std::string & filename )
+{
+   auto forest = forest_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( forest, "Trying to access 'BlockDataCheckpoint' for a block storage object that doesn't exist anymore" );
+
+   WALBERLA_LOG_PROGRESS( "Reading block data \"" << forest->getBlockDataIdentifier( id_ ) << "\" from checkpoint \"" << filename << "\"" );
+
+   // the root process reads the header/index of the checkpoint and of all referenced checkpoints
+   // (a delta checkpoint of depth d references exactly d other files, each with a depth that is smaller by one)
+
+   std::vector< std::string > filenames;
+   std::vector< std::vector< uint8_t > > headers;
+
+   WALBERLA_ROOT_SECTION()
+   {
+      std::string file( filename );
+      while( true )
+      {
+         if( internal::isPartOfChain( filenames, file ) )
+            WALBERLA_ABORT( "Checkpoint \"" << filename << "\" is corrupt: checkpoint \"" << file << "\" is referenced more than once." );
+
+         filenames.push_back( file );
+         headers.push_back( readHeader( file ) );
+
+         const uint_t depth = byteArrayToUint( headers.back(), 40, uint_t(8) );
+         const uint_t referenceLength = byteArrayToUint( headers.back(), 48, uint_t(8) );
+
+         if( headers.size() > uint_t(1) && depth + uint_t(1) != byteArrayToUint( headers[ headers.size() - uint_t(2) ], 40, uint_t(8) ) )
+            WALBERLA_ABORT( "Checkpoint \"" << filename << "\" is corrupt: the delta depth of the referenced checkpoint \"" << file
+                            << "\" does not match (it was probably overwritten)." );
+
+         if( ( depth == uint_t(0) ) != ( referenceLength == uint_t(0) ) )
+            WALBERLA_ABORT( "Checkpoint \"" << file << "\" is corrupt: delta depth " << depth << " does not match the reference." );
+
+         if( referenceLength == uint_t(0) )
+            break;
+
+         const std::string reference( headers.back().begin() + numeric_cast< std::ptrdiff_t >( HEADER_SIZE ),
+                                      headers.back().begin() + numeric_cast< std::ptrdiff_t >( HEADER_SIZE + referenceLength ) );
+         file = ( boost::filesystem::path( file ).parent_path() / reference ).string();
+      }
+   }
+
+   mpi::broadcastObject( filenames, 0, MPIManager::instance()->comm() );
+   mpi::broadcastObject( headers,   0, MPIManager::instance()->comm() );
+
+   std::vector< Index > indices;
+   for( uint_t i = 0; i != filenames.size(); ++i )
+   {
+      indices.push_back( parseHeader( filenames[i], headers[i] ) );
+      std::vector< uint8_t >().swap( headers[i] );
+   }
+
+   // every process reads the data of its blocks
+
+   std::map< BlockID, std::vector< uint8_t > > current;
+
+   std::vector< IBlock * > blocks = internal::sortedBlocks( *forest );
+   for( auto it = blocks.begin(); it != blocks.end(); ++it )
+   {
+      if( !(*it)->isBlockDataAllocated( id_ ) )
+         continue;
+
+      const BlockID & id = static_cast< Block * >( *it )->getId();
+
+      std::vector< uint8_t > data;
+      readBlockData( indices, uint_t(0), id, data );
+
+      mpi::RecvBuffer buffer;
+      buffer.resize( data.size() );
+      if( !data.empty() )
+         std::memcpy( buffer.ptr(), &(data[0]), data.size() );
+
+      forest->deserializeBlockData( *it, id_, buffer );
+
+      if( deltaCheckpoints_ > uint_t(0) )
+         current[ id ].swap( data );
+   }
+
+   if( deltaCheckpoints_ > uint_t(0) )
+   {
+      previous_.swap( current );
+      chain_.assign( filenames.rbegin(), filenames.rend() );
+   }
+}
+
+
+
+std::vector< uint8_t > BlockDataCheckpoint::readHeader( const std::string & filename )
+{
+   std::ifstream ifs( filename.c_str(), std::ifstream::binary );
+   if( !ifs )
+      WALBERLA_ABORT( "Error while opening checkpoint \"" << filename << "\" for reading." );
+
+   std::vector< uint8_t > header( HEADER_SIZE );
+   ifs.read( reinterpret_cast< char * >( &(header[0]) ), numeric_cast< std::streamsize >( header.size() ) );
+   if( !ifs || std::memcmp( &(header[0]), CHECKPOINT_MAGIC, uint_t(8) ) != 0 )
+      WALBERLA_ABORT( "File \"" << filename << "\" is not a block data checkpoint." );
+
+   const uint_t version = byteArrayToUint( header, 8, uint_t(8) );
+   if( version != VERSION )
+      WALBERLA_ABORT( "Checkpoint \"" << filename << "\" was written with version " << version << " of the checkpoint format, "
+                      "only version " << VERSION << " is supported." );
+
+   const uint_t blockIdBytes    = byteArrayToUint( header, 24, uint_t(8) );
+   const uint_t numberOfBlocks  = byteArrayToUint( header, 32, uint_t(8) );
+   const uint_t referenceLength = byteArrayToUint( header, 48, uint_t(8) );
+
+   const uint_t size = HEADER_SIZE + referenceLength + numberOfBlocks * ( blockIdBytes + uint_t(4) * uint_t(8) );
+   header.resize( size );
+   if( size > HEADER_SIZE )
+      ifs.read( reinterpret_cast< char * >( &(header[ HEADER_SIZE ]) ), numeric_cast< std::streamsize >( size - HEADER_SIZE ) );
+   if( !ifs )
+      WALBERLA_ABORT( "Error while reading the index of checkpoint \"" << filename << "\"." );
+
+   return header;
+}
+
+
+
+BlockDataCheckpoint::Index BlockDataCheckpoint::parseHeader( const std::string & filename, const std::vector< uint8_t > & header )
+{
+   WALBERLA_CHECK_GREATER_EQUAL( header.size(), HEADER_SIZE );
+
+   if( ( byteArrayToUint( header, 16, uint_t(8) ) == uint_t(1) ) != internal::isLittleEndian() )
+      WALBERLA_ABORT( "Checkpoint \"" << filename << "\" was written on a machine with a different byte order." );
+
+   Index index;
+   index.filename_ = filename;
+   index.depth_ = byteArrayToUint( header, 40, uint_t(8) );
+
+   const uint_t blockIdBytes    = byteArrayToUint( header, 24, uint_t(8) );
+   const uint_t numberOfBlocks  = byteArrayToUint( header, 32, uint_t(8) );
+   const uint_t referenceLength = byteArrayToUint( header, 48, uint_t(8) );
+   const uint_t entrySize = blockIdBytes + uint_t(4) * uint_t(8);
+
+   WALBERLA_CHECK_EQUAL( header.size(), HEADER_SIZE + referenceLength + numberOfBlocks * entrySize );
+
+   index.reference_.assign( header.begin() + numeric_cast< std::ptrdiff_t >( HEADER_SIZE ),
+                            header.begin() + numeric_cast< std::ptrdiff_t >( HEADER_SIZE + referenceLength ) );
+
+   for( uint_t i = 0; i != numberOfBlocks; ++i )
+   {
+      const uint_t pos = HEADER_SIZE + referenceLength + i * entrySize;
+
+      Entry entry( BlockID( header, pos, blockIdBytes ) );
+      entry.offset_     = byteArrayToUint( header, pos + blockIdBytes,              uint_t(8) );
+      entry.storedSize_ = byteArrayToUint( header, pos + blockIdBytes + uint_t(8),  uint_t(8) );
+      entry.size_       = byteArrayToUint( header, pos + blockIdBytes + uint_t(16), uint_t(8) );
+      entry.flags_      = byteArrayToUint( header, pos + blockIdBytes + uint_t(24), uint_t(8) );
+
+      index.entries_.insert( std::make_pair( entry.id_, entry ) );
+   }
+
+   return index;
+}
+
+
+
+void BlockDataCheckpoint::readBlockData( const std::vector< Index > & indices, const uint_t level, const BlockID & id,
+                                         std::vector< uint8_t > & data )
+{
+   WALBERLA_ASSERT_LESS( level, indices.size() );
+   const Index & index = indices[ level ];
+
+   auto it = index.entries_.find( id );
+   if( it == index.entries_.end() )
+      WALBERLA_ABORT( "Block " << id << " is not contained in checkpoint \"" << index.filename_ << "\"." );
+   const Entry & entry = it->second;
+
+   std::vector< uint8_t > stored( entry.storedSize_ );
+
+   std::ifstream ifs( index.filename_.c_str(), std::ifstream::binary );
+   ifs.seekg( numeric_cast< std::streamoff >( entry.offset_ ) );
+   if( !stored.empty() )
+      ifs.read( reinterpret_cast< char * >( &(stored[0]) ), numeric_cast< std::streamsize >( stored.size() ) );
+   if( !ifs )
+      WALBERLA_ABORT( "Error while reading block " << id << " from checkpoint \"" << index.filename_ << "\"." );
+
+   if( entry.flags_ & COMPRESSED )
+   {
+      data.resize( entry.size_ );
+      if( !lzDecompress( stored, data ) )
+         WALBERLA_ABORT( "The data of block " << id << " in checkpoint \"" << index.filename_ << "\" is corrupt." );
+   }
+   else
+   {
+      WALBERLA_CHECK_EQUAL( stored.size(), entry.size_ );
+      data.swap( stored );
+   }
+
+   if( entry.flags_ & DELTA )
+   {
+      if( level + uint_t(1) >= indices.size() )
+         WALBERLA_ABORT( "The data of block " << id << " in checkpoint \"" << index.filename_ << "\" is a delta, "
+                         "but the checkpoint does not reference a previous checkpoint." );
+
+      std::vector< uint8_t > previous;
+      readBlockData( indices, level + uint_t(1), id, previous );
+      if( previous.size() != data.size() )
+         WALBERLA_ABORT( "The data of block " << id << " in checkpoint \"" << index.filename_ << "\" does not match "
+                         "the data of the referenced checkpoint \"" << indices[ level + uint_t(1) ].filename_ << "\"." );
+
+      internal::xorBytes( data, previous );
+   }
+}
+
+
+
+} // namespace blockforest
+} // namespace walberla
@@ -0,0 +1,147 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BlockDataCheckpoint.h
+//! \ingroup blockforest
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "BlockForest.h"
+#include "BlockID.h"
+
+#include "core/DataTypes.h"
+#include "core/mpi/AsyncFileWriter.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace walberla {
+namespace blockforest {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Writes/reads checkpoints of one block data item in a versioned, compressed container format
+*
+*   In contrast to 'BlockStorage::saveBlockData'/'loadBlockData', the serialized data of every block is stored together
+*   with its BlockID in an index at the beginning of the file. Hence, a checkpoint can be read by any number of
+*   processes: The only requirement is that the block structure (i.e., the BlockIDs) of the forest is the same, the
+*   distribution of the blocks to the processes may be different.
+*
+*   File layout (all integers of the header and the index are stored as little-endian 64 bit values):
+*   \code
+*     "waLBCkpt" | version | payload byte order | BlockID bytes | number of blocks | delta depth | length of the
+*     reference file name | reference file name | index (one entry per block) | block data
+*   \endcode
+*   Every index entry consists of the BlockID, the file offset, the stored size, and the uncompressed size of the block
+*   data, and flags that indicate whether the stored data is compressed and/or a delta.
+*
+*   If 'compress' is true, the data of every block is compressed with 'lzCompress' (if compression does not reduce the
+*   size, the block is stored uncompressed).
+*
+*   If 'deltaCheckpoints' is greater than zero, at most 'deltaCheckpoints' checkpoints following a full checkpoint only
+*   store the difference (byte-wise XOR) to the previous checkpoint. For data that only changes in parts of the domain,
+*   this difference consists of long runs of zero bytes and compresses very well. Reading a delta checkpoint requires
+*   all previous checkpoints up to the last full checkpoint. These files are referenced by name and must be located in
+*   the same directory. A delta checkpoint is only written if the previous checkpoint was written to the same directory
+*   and if the file name is not used by any of the checkpoints the delta would depend on (otherwise, a file would be
+*   overwritten that is still required for reading the delta). In all other cases, a full checkpoint is written. Delta
+*   checkpoints require the last checkpoint of every local block to be kept in memory.
+*
+*   Only the container (header and index) is stored independently of the byte order. The serialized block data itself
+*   is created by the block data handling of the block data item and stored as is, i.e., in the native byte order of the
+*   machine that wrote the checkpoint. Hence, a checkpoint can only be read on a machine with the same byte order (this
+*   is checked when reading the file).
+*
+*   Writing and reading are collective operations.
+*/
+//**********************************************************************************************************************
+
+class BlockDataCheckpoint
+{
+public:
+
+   static const uint_t VERSION = uint_t(1);
+
+   BlockDataCheckpoint( const weak_ptr< BlockForest > & forest, const BlockDataID & id, const bool compress = true,
+                        const uint_t deltaCheckpoints = uint_t(0) );
+
+   /// If 'asyncWriter' is given, the file is written in the background by 'asyncWriter'.
+   void write( const std::string & filename, mpi::AsyncFileWriter * asyncWriter = NULL );
+
+   /// Restores the data of all local blocks from file. If delta checkpoints are enabled, the next checkpoint written by
+   /// this object can be a delta to 'filename'.
+   void read( const std::string & filename );
+
+   /// the next checkpoint is a full checkpoint
+   void reset() { chain_.clear(); previous_.clear(); }
+
+private:
+
+   struct Entry
+   {
+      Entry( const BlockID & id ) : id_( id ), offset_( uint_t(0) ), storedSize_( uint_t(0) ), size_( uint_t(0) ), flags_( uint_t(0) ) {}
+
+      BlockID id_;
+      uint_t offset_;
+      uint_t storedSize_;
+      uint_t size_;
+      uint_t flags_;
+   };
+
+   struct Index
+   {
+      std::string filename_;
+      std::string reference_;
+      uint_t depth_;
+      std::map< BlockID, Entry > entries_;
+   };
+
+   static const uint_t COMPRESSED = uint_t(1);
+   static const uint_t DELTA      = uint_t(2);
+
+   static const uint_t HEADER_SIZE = uint_t(8) + uint_t(6) * uint_t(8); // without the reference file name
+
+   static std::vector< uint8_t > readHeader( const std::string & filename );
+   static Index parseHeader( const std::string & filename, const std::vector< uint8_t > & header );
+
+   static void readBlockData( const std::vector< Index > & indices, const uint_t level, const BlockID & id,
+                              std::vector< uint8_t > & data );
+
+   weak_ptr< BlockForest > forest_;
+   BlockDataID id_;
+
+   bool compress_;
+   uint_t deltaCheckpoints_;
+
+   // the last full checkpoint followed by all delta checkpoints that were written/read since then (empty if the next
+   // checkpoint is a full checkpoint) -> the last entry is the reference of the next delta checkpoint
+   std::vector< std::string > chain_;
+   std::map< BlockID, std::vector< uint8_t > > previous_;
+
+}; // class BlockDataCheckpoint
+
+
+
+} // namespace blockforest
+
+using blockforest::BlockDataCheckpoint;
+
+} // namespace walberla
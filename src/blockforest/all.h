@@ -24,6 +24,7 @@
 
 #include "AABBRefinementSelection.h"
 #include "Block.h"
+#include "BlockDataCheckpoint.h"
 #include "BlockDataHandling.h"
 #include "BlockForest.h"
 #include "BlockForestEvaluation.h"
@@ -120,6 +120,8 @@ public:
 protected:
    void setup();
 
+   static bool isEmpty( const mpi::Datatype & datatype );
+
    struct CommInfo
    {
       uint_t             dataIdx;       ///< index into dataInfos_
@@ -154,26 +154,53 @@ void UniformDirectScheme<Stencil>::setup()
    std::sort( sendInfos_.begin(), sendInfos_.end(), CommInfo::sortByLocal );
    std::sort( recvInfos_.begin(), recvInfos_.end(), CommInfo::sortByRemote );
 
+   // Messages whose datatype does not contain any data are not sent at all (e.g., there are no PDFs that stream
+   // across the corners of a block for D3Q19, see lbm::communication::PdfFieldMPIDatatypeInfo). The matching
+   // receive datatype of the neighbor is empty as well, so both sides skip the same messages.
+
+   std::vector<CommInfo> sendInfos;
+   std::vector<CommInfo> recvInfos;
+
    for( auto it = sendInfos_.begin(); it != sendInfos_.end(); ++it )
    {
       auto block = forest->getBlock( it->localBlockId );
       WALBERLA_ASSERT_NOT_NULLPTR( block );
-      mpiDatatypes_.push_back( dataInfos_[ it->dataIdx ]->getSendDatatype( block, it->dir )  );
+      auto datatype = dataInfos_[ it->dataIdx ]->getSendDatatype( block, it->dir );
+      if( isEmpty( *datatype ) )
+         continue;
+      sendInfos.push_back( *it );
+      mpiDatatypes_.push_back( datatype );
    }
 
    for( auto it = recvInfos_.begin(); it != recvInfos_.end(); ++it )
    {
       auto block = forest->getBlock( it->localBlockId );
       WALBERLA_ASSERT_NOT_NULLPTR( block );
-      mpiDatatypes_.push_back( dataInfos_[ it->dataIdx ]->getRecvDatatype( block, it->dir )  );
+      auto datatype = dataInfos_[ it->dataIdx ]->getRecvDatatype( block, it->dir );
+      if( isEmpty( *datatype ) )
+         continue;
+      recvInfos.push_back( *it );
+      mpiDatatypes_.push_back( datatype );
    }
 
+   sendInfos_.swap( sendInfos );
+   recvInfos_.swap( recvInfos );
+
    mpiRequests_.resize( sendInfos_.size() + recvInfos_.size(), MPI_REQUEST_NULL );
 
    setupRequired_ = false;
 }
 
 
+template< typename Stencil >
+bool UniformDirectScheme<Stencil>::isEmpty( const mpi::Datatype & datatype )
+{
+   int size = 0;
+   MPI_Type_size( datatype, &size );
+   return size == 0;
+}
+
+
 template< typename Stencil >
 void UniformDirectScheme<Stencil>::startCommunication()
 {
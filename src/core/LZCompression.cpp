@@ -0,0 +1,209 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file LZCompression.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "LZCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+
+namespace walberla {
+
+
+
+namespace lz_compression {
+
+static const uint_t MIN_MATCH     = uint_t(4);
+static const uint_t LAST_LITERALS = uint_t(5);  // the last 5 bytes are always stored as literals
+static const uint_t MF_LIMIT      = uint_t(12); // the last match must start at least 12 bytes before the end
+static const uint_t MAX_OFFSET    = uint_t(65535);
+static const uint_t HASH_LOG      = uint_t(12);
+static const uint_t NO_POSITION   = std::numeric_limits< uint_t >::max();
+
+inline uint32_t read32( const uint8_t * const p )
+{
+   uint32_t value;
+   std::memcpy( &value, p, sizeof( uint32_t ) ); // only used for hashing and comparing -> endianness does not matter
+   return value;
+}
+
+inline uint_t hash( const uint32_t sequence )
+{
+   return uint_c( ( sequence * uint32_t(2654435761u) ) >> ( uint32_t(32) - uint32_c( HASH_LOG ) ) );
+}
+
+inline void writeLength( std::vector< uint8_t > & out, uint_t length )
+{
+   while( length >= uint_t(255) )
+   {
+      out.push_back( uint8_t(255) );
+      length -= uint_t(255);
+   }
+   out.push_back( uint8_c( length ) );
+}
+
+inline void writeLiterals( std::vector< uint8_t > & out, const uint8_t * const literals, const uint_t length )
+{
+   if( length >= uint_t(15) )
+      writeLength( out, length - uint_t(15) );
+   out.insert( out.end(), literals, literals + length );
+}
+
+inline void writeSequence( std::vector< uint8_t > & out, const uint8_t * const literals, const uint_t literalLength,
+                           const uint_t offset, const uint_t matchLength )
+{
+   const uint_t matchCode = matchLength - MIN_MATCH;
+
+   out.push_back( uint8_c( ( std::min( literalLength, uint_t(15) ) << 4 ) | std::min( matchCode, uint_t(15) ) ) );
+   writeLiterals( out, literals, literalLength );
+   out.push_back( uint8_c( offset & uint_t(255) ) );
+   out.push_back( uint8_c( offset >> 8 ) );
+   if( matchCode >= uint_t(15) )
+      writeLength( out, matchCode - uint_t(15) );
+}
+
+inline bool readLength( const uint8_t * const compressed, const uint_t size, uint_t & pos, uint_t & length )
+{
+   uint8_t byte;
+   do
+   {
+      if( pos >= size )
+         return false;
+      byte = compressed[pos++];
+      length += uint_c( byte );
+   }
+   while( byte == uint8_t(255) );
+   return true;
+}
+
+} // namespace lz_compression
+
+
+
+void lzCompress( const uint8_t * const data, const uint_t size, std::vector< uint8_t > & compressed )
+{
+   using namespace lz_compression;
+
+   compressed.clear();
+   compressed.reserve( size + size / uint_t(255) + uint_t(16) );
+
+   uint_t anchor = uint_t(0); // first byte that is not yet encoded
+
+   if( size > MF_LIMIT )
+   {
+      const uint_t matchEnd  = size - LAST_LITERALS;
+      const uint_t searchEnd = size - MF_LIMIT;
+
+      std::vector< uint_t > table( uint_t(1) << HASH_LOG, NO_POSITION );
+
+      uint_t pos = uint_t(0);
+      while( pos <= searchEnd )
+      {
+         const uint32_t sequence = read32( data + pos );
+         const uint_t h = hash( sequence );
+         const uint_t candidate = table[h];
+         table[h] = pos;
+
+         if( candidate != NO_POSITION && pos - candidate <= MAX_OFFSET && read32( data + candidate ) == sequence )
+         {
+            uint_t length = MIN_MATCH;
+            while( pos + length < matchEnd && data[ candidate + length ] == data[ pos + length ] )
+               ++length;
+
+            writeSequence( compressed, data + anchor, pos - anchor, pos - candidate, length );
+
+            pos += length;
+            anchor = pos;
+         }
+         else
+         {
+            ++pos;
+         }
+      }
+   }
+
+   // last sequence: literals only
+
+   const uint_t literalLength = size - anchor;
+   compressed.push_back( uint8_c( std::min( literalLength, uint_t(15) ) << 4 ) );
+   writeLiterals( compressed, data + anchor, literalLength );
+}
+
+
+
+bool lzDecompress( const uint8_t * const compressed, const uint_t size, std::vector< uint8_t > & data )
+{
+   using namespace lz_compression;
+
+   const uint_t dataSize = data.size();
+
+   uint_t in  = uint_t(0);
+   uint_t out = uint_t(0);
+
+   while( true )
+   {
+      if( in >= size )
+         return false;
+
+      const uint8_t token = compressed[in++];
+
+      uint_t literalLength = uint_c( token >> 4 );
+      if( literalLength == uint_t(15) && !readLength( compressed, size, in, literalLength ) )
+         return false;
+
+      if( literalLength > size - in || literalLength > dataSize - out )
+         return false;
+
+      if( literalLength > uint_t(0) )
+         std::memcpy( &(data[out]), compressed + in, literalLength );
+      in  += literalLength;
+      out += literalLength;
+
+      if( in == size ) // the last sequence does not contain a match
+         return out == dataSize;
+
+      if( size - in < uint_t(2) )
+         return false;
+
+      const uint_t offset = uint_c( compressed[in] ) | ( uint_c( compressed[in + 1] ) << 8 );
+      in += uint_t(2);
+
+      if( offset == uint_t(0) || offset > out )
+         return false;
+
+      uint_t matchLength = uint_c( token & uint8_t(15) );
+      if( matchLength == uint_t(15) && !readLength( compressed, size, in, matchLength ) )
+         return false;
+      matchLength += MIN_MATCH;
+
+      if( matchLength > dataSize - out )
+         return false;
+
+      // source and destination may overlap (offset < matchLength) -> byte-wise copy
+      for( uint_t i = 0; i != matchLength; ++i, ++out )
+         data[out] = data[ out - offset ];
+   }
+}
+
+
+
+} // namespace walberla
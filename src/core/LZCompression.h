@@ -0,0 +1,69 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file LZCompression.h
+//! \ingroup core
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "DataTypes.h"
+
+#include <vector>
+
+
+
+namespace walberla {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Fast, lossless LZ77 compression of a byte array (no external dependencies)
+*
+*   The compressed data is stored in the LZ4 block format (sequences of literals followed by a match with a 16 bit
+*   little-endian offset), i.e., it is independent of the endianness of the machine. The compressor uses a single hash
+*   table lookup per position and favors speed over compression ratio. It is well suited for data with long runs of
+*   identical bytes or repeated patterns (for example, the XOR difference of two similar checkpoints).
+*
+*   'compressed' is overwritten with the compressed data of the 'size' bytes starting at 'data'.
+*/
+//**********************************************************************************************************************
+void lzCompress( const uint8_t * const data, const uint_t size, std::vector< uint8_t > & compressed );
+
+inline void lzCompress( const std::vector< uint8_t > & data, std::vector< uint8_t > & compressed )
+{
+   lzCompress( data.empty() ? NULL : &(data[0]), data.size(), compressed );
+}
+
+//**********************************************************************************************************************
+/*!
+*   \brief Decompresses data that was compressed with 'lzCompress'
+*
+*   'data' must already be resized to the size of the uncompressed data. Returns false if 'compressed' is corrupt or
+*   does not decompress to exactly 'data.size()' bytes.
+*/
+//**********************************************************************************************************************
+bool lzDecompress( const uint8_t * const compressed, const uint_t size, std::vector< uint8_t > & data );
+
+inline bool lzDecompress( const std::vector< uint8_t > & compressed, std::vector< uint8_t > & data )
+{
+   return lzDecompress( compressed.empty() ? NULL : &(compressed[0]), compressed.size(), data );
+}
+
+
+
+} // namespace walberla
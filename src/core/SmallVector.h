@@ -0,0 +1,225 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SmallVector.h
+//! \ingroup core
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "DataTypes.h"
+
+#include "core/debug/Debug.h"
+
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+
+namespace walberla {
+
+
+
+//**********************************************************************************************************************
+/*! \brief Vector that stores up to N elements inside of the object itself
+*
+*   Only if more than N elements are stored, the elements are moved to dynamically allocated memory. Hence, for
+*   containers that typically hold only very few elements (e.g. per cell data structures in fields) no dynamic
+*   memory allocation takes place and the elements are stored directly in the container. The storage for the N
+*   elements is shared with the pointer to the dynamically allocated memory.
+*
+*   The interface is a subset of the interface of std::vector. Iterators are plain pointers and are invalidated
+*   by every operation that changes the size of the container.
+*/
+//**********************************************************************************************************************
+template< typename T, uint_t N >
+class SmallVector
+{
+   static_assert( N > 0, "SmallVector requires storage for at least one element inside of the object" );
+
+public:
+
+   typedef T           value_type;
+   typedef T &         reference;
+   typedef const T &   const_reference;
+   typedef T *         iterator;
+   typedef const T *   const_iterator;
+   typedef std::size_t size_type;
+
+   SmallVector() : size_( 0 ), capacity_( N ) {}
+   SmallVector( const SmallVector & other );
+   ~SmallVector() { clear(); deallocate(); }
+
+   SmallVector & operator=( const SmallVector & other );
+
+   size_type size()     const { return size_; }
+   size_type capacity() const { return capacity_; }
+   bool      empty()    const { return size_ == 0; }
+
+   /// true as long as the elements are stored inside of the object
+   bool isInline() const { return capacity_ == N; }
+
+         T * data()       { return isInline() ? reinterpret_cast<       T * >( &storage_.inline_ ) : storage_.heap_; }
+   const T * data() const { return isInline() ? reinterpret_cast< const T * >( &storage_.inline_ ) : storage_.heap_; }
+
+   iterator       begin()       { return data(); }
+   const_iterator begin() const { return data(); }
+   iterator       end()         { return data() + size_; }
+   const_iterator end()   const { return data() + size_; }
+
+         T & operator[]( const size_type i )       { WALBERLA_ASSERT_LESS( i, size() ); return data()[i]; }
+   const T & operator[]( const size_type i ) const { WALBERLA_ASSERT_LESS( i, size() ); return data()[i]; }
+
+         T & front()       { WALBERLA_ASSERT( !empty() ); return data()[0]; }
+   const T & front() const { WALBERLA_ASSERT( !empty() ); return data()[0]; }
+         T & back()        { WALBERLA_ASSERT( !empty() ); return data()[size_ - 1]; }
+   const T & back()  const { WALBERLA_ASSERT( !empty() ); return data()[size_ - 1]; }
+
+   inline void push_back( const T & value );
+   inline void pop_back();
+
+   /// Removes the element at pos, the order of the remaining elements is preserved
+   inline iterator erase( iterator pos );
+
+   /// Destroys all elements, the capacity is not changed
+   inline void clear();
+
+   inline void reserve( const size_type n );
+
+   bool operator==( const SmallVector & other ) const { return size_ == other.size_ && std::equal( begin(), end(), other.begin() ); }
+   bool operator!=( const SmallVector & other ) const { return !operator==( other ); }
+
+private:
+
+   void deallocate() { if( !isInline() ) ::operator delete( storage_.heap_ ); }
+
+   union Storage
+   {
+      typename std::aligned_storage< N * sizeof(T), boost::alignment_of<T>::value >::type inline_;
+      T * heap_;
+   };
+
+   Storage  storage_;
+   uint32_t size_;
+   uint32_t capacity_;
+
+}; // class SmallVector
+
+
+
+template< typename T, uint_t N >
+SmallVector<T,N>::SmallVector( const SmallVector & other ) : size_( 0 ), capacity_( N )
+{
+   reserve( other.size() );
+   std::uninitialized_copy( other.begin(), other.end(), begin() );
+   size_ = other.size_;
+}
+
+
+
+template< typename T, uint_t N >
+SmallVector<T,N> & SmallVector<T,N>::operator=( const SmallVector & other )
+{
+   if( this != &other )
+   {
+      clear();
+      reserve( other.size() );
+      std::uninitialized_copy( other.begin(), other.end(), begin() );
+      size_ = other.size_;
+   }
+   return *this;
+}
+
+
+
+template< typename T, uint_t N >
+inline void SmallVector<T,N>::push_back( const T & value )
+{
+   if( size_ == capacity_ )
+   {
+      const T copy( value ); // value may be an element of this container
+      reserve( size_type(2) * capacity_ );
+      new ( data() + size_ ) T( copy );
+   }
+   else
+   {
+      new ( data() + size_ ) T( value );
+   }
+   ++size_;
+}
+
+
+
+template< typename T, uint_t N >
+inline void SmallVector<T,N>::pop_back()
+{
+   WALBERLA_ASSERT( !empty() );
+   --size_;
+   data()[size_].~T();
+}
+
+
+
+template< typename T, uint_t N >
+inline typename SmallVector<T,N>::iterator SmallVector<T,N>::erase( iterator pos )
+{
+   WALBERLA_ASSERT( pos >= begin() && pos < end() );
+   std::copy( pos + 1, end(), pos );
+   pop_back();
+   return pos;
+}
+
+
+
+template< typename T, uint_t N >
+inline void SmallVector<T,N>::clear()
+{
+   T * elements = data();
+   for( size_type i = 0; i != size_; ++i )
+      elements[i].~T();
+   size_ = 0;
+}
+
+
+
+template< typename T, uint_t N >
+inline void SmallVector<T,N>::reserve( const size_type n )
+{
+   if( n <= capacity_ )
+      return;
+
+   WALBERLA_ASSERT_LESS_EQUAL( n, size_type( std::numeric_limits<uint32_t>::max() ) );
+
+   T * elements = static_cast< T * >( ::operator new( n * sizeof(T) ) );
+   std::uninitialized_copy( begin(), end(), elements );
+
+   const uint32_t size = size_;
+   clear();
+   deallocate();
+
+   storage_.heap_ = elements;
+   size_          = size;
+   capacity_      = uint32_t( n );
+}
+
+
+
+} // namespace walberla
@@ -31,6 +31,7 @@
 #include "Environment.h"
 #include "GetPID.h"
 #include "Hostname.h"
+#include "LZCompression.h"
 #include "Macros.h"
 #include "NonCopyable.h"
 #include "NonCreateable.h"
@@ -38,6 +39,7 @@
 #include "Set.h"
 #include "SharedFunctor.h"
 #include "Sleep.h"
+#include "SmallVector.h"
 #include "VectorTrait.h"
 
 #include "cell/all.h"
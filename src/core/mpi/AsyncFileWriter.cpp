@@ -0,0 +1,341 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncFileWriter.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "AsyncFileWriter.h"
+
+#include "core/Abort.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/mpi/MPIManager.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+
+namespace walberla {
+namespace mpi {
+
+
+
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+
+namespace internal {
+
+/// MPI I/O may only be used by the I/O thread if MPI supports concurrent calls from multiple threads
+bool isMPIThreadMultiple()
+{
+#ifdef WALBERLA_BUILD_WITH_MPI
+   if( MPIManager::instance()->isMPIInitialized() )
+   {
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread( &provided );
+      return provided == MPI_THREAD_MULTIPLE;
+   }
+#endif
+   return false;
+}
+
+} // namespace internal
+
+AsyncFileWriter::AsyncFileWriter( const uint_t memoryBudget ) :
+   memoryBudget_( memoryBudget ), useMPIIO_( internal::isMPIThreadMultiple() ), pendingBytes_( uint_t(0) ), stop_( false ),
+   thread_( &AsyncFileWriter::run, this )
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+   {
+      boost::unique_lock< boost::mutex > lock( mutex_ );
+      stop_ = true;
+      jobAdded_.notify_one();
+   }
+   thread_.join(); // the I/O thread only terminates after all pending jobs have been written
+
+   reportErrors();
+}
+
+#else
+
+AsyncFileWriter::AsyncFileWriter( const uint_t memoryBudget ) : memoryBudget_( memoryBudget ), useMPIIO_( false ) {}
+
+AsyncFileWriter::~AsyncFileWriter() {}
+
+#endif
+
+
+
+void AsyncFileWriter::write( const std::string & filename, const uint64_t fileSize, std::vector< Segment > & segments, const MPI_Comm comm )
+{
+   reportErrors();
+
+   Job job;
+   job.filename_ = filename;
+   job.fileSize_ = fileSize;
+   job.segments_.swap( segments );
+   job.bytes_ = uint_t(0);
+   for( auto segment = job.segments_.begin(); segment != job.segments_.end(); ++segment )
+   {
+      WALBERLA_CHECK_LESS_EQUAL( segment->offset_ + segment->data_.size(), fileSize, "Segment of file \"" << filename << "\" exceeds the file size" );
+      job.bytes_ += uint_c( segment->data_.size() );
+   }
+
+   job.comm_ = MPI_COMM_NULL;
+   if( useMPIIO_ )
+   {
+      // the file is opened collectively by the I/O threads, they need their own communicator
+      MPI_Comm_dup( comm, &job.comm_ );
+   }
+   else
+   {
+      // the file is created and resized by one process before any process writes to it
+      int rank = 0;
+      WALBERLA_MPI_SECTION() { MPI_Comm_rank( comm, &rank ); }
+
+      const std::string error = ( rank == 0 ) ? createFile( filename, fileSize ) : std::string();
+
+      WALBERLA_MPI_SECTION() { MPI_Barrier( comm ); }
+
+      if( !error.empty() )
+         WALBERLA_ABORT( error );
+   }
+
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+
+   boost::unique_lock< boost::mutex > lock( mutex_ );
+
+   // bounded memory: wait until the staging buffer fits into the budget (or until no other job is pending)
+   while( pendingBytes_ > uint_t(0) && pendingBytes_ + job.bytes_ > memoryBudget_ )
+      jobFinished_.wait( lock );
+
+   pendingBytes_ += job.bytes_;
+   jobs_.push_back( std::move( job ) );
+   jobAdded_.notify_one();
+
+#else
+
+   std::string error = writeJob( job );
+   if( !error.empty() )
+      WALBERLA_ABORT( error );
+
+#endif
+}
+
+
+
+void AsyncFileWriter::writeMPITextFile( const std::string & filename, const std::string & processLocalPart, const MPI_Comm comm )
+{
+   uint64_t offset   = uint64_t(0);
+   uint64_t fileSize = uint64_c( processLocalPart.size() );
+
+   WALBERLA_MPI_SECTION()
+   {
+      int rank;
+      MPI_Comm_rank( comm, &rank );
+
+      uint64_t size = uint64_c( processLocalPart.size() );
+      MPI_Exscan( &size, &offset, 1, MPITrait< uint64_t >::type(), MPI_SUM, comm );
+      if( rank == 0 )
+         offset = uint64_t(0);
+      MPI_Allreduce( &size, &fileSize, 1, MPITrait< uint64_t >::type(), MPI_SUM, comm );
+   }
+
+   std::vector< Segment > segments( 1, Segment( offset ) );
+   segments[0].data_.assign( processLocalPart.begin(), processLocalPart.end() );
+
+   write( filename, fileSize, segments, comm );
+}
+
+
+
+void AsyncFileWriter::flush()
+{
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+   {
+      boost::unique_lock< boost::mutex > lock( mutex_ );
+      while( !jobs_.empty() )
+         jobFinished_.wait( lock );
+   }
+#endif
+   reportErrors();
+}
+
+
+
+uint_t AsyncFileWriter::pendingBytes() const
+{
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+   boost::unique_lock< boost::mutex > lock( mutex_ );
+   return pendingBytes_;
+#else
+   return uint_t(0);
+#endif
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   Creates file 'filename' (an existing file is truncated, so that gaps between the segments are filled with zeros)
+*   and resizes it to 'fileSize' bytes. Returns an error message, or an empty string on success.
+*/
+//**********************************************************************************************************************
+std::string AsyncFileWriter::createFile( const std::string & filename, const uint64_t fileSize )
+{
+   {
+      std::ofstream create( filename.c_str(), std::ofstream::binary | std::ofstream::trunc );
+      if( !create )
+         return "Error while opening file \"" + filename + "\" for writing.";
+   }
+
+   boost::system::error_code errorCode;
+   boost::filesystem::resize_file( filename, fileSize, errorCode );
+   if( errorCode )
+      return "Error while resizing file \"" + filename + "\": " + errorCode.message();
+
+   return std::string();
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   Writes all segments of one job. Returns an error message, or an empty string if the job was written successfully.
+*
+*   With MPI I/O, the file is opened, resized and closed collectively by the I/O threads of all processes. Otherwise,
+*   the file was already created with its final size during 'write' and is only opened for writing.
+*/
+//**********************************************************************************************************************
+std::string AsyncFileWriter::writeJob( const Job & job )
+{
+#ifdef WALBERLA_BUILD_WITH_MPI
+   if( job.comm_ != MPI_COMM_NULL )
+   {
+      MPI_Comm comm = job.comm_;
+      std::string error;
+
+      MPI_File file = MPI_FILE_NULL;
+      if( MPI_File_open( comm, const_cast< char * >( job.filename_.c_str() ), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                         MPI_INFO_NULL, &file ) != MPI_SUCCESS )
+      {
+         MPI_Comm_free( &comm );
+         return "Error while opening file \"" + job.filename_ + "\" for writing with MPI I/O.";
+      }
+
+      // an existing file is truncated first, so that gaps between the segments are filled with zeros
+      if( MPI_File_set_size( file, MPI_Offset(0) ) != MPI_SUCCESS || MPI_File_set_size( file, MPI_Offset( job.fileSize_ ) ) != MPI_SUCCESS )
+         error = "Error while resizing file \"" + job.filename_ + "\" with MPI I/O.";
+
+      // MPI counts are of type int -> large segments are written in several parts
+      const uint64_t maxCount = uint64_t(1) << 30;
+      for( auto segment = job.segments_.begin(); segment != job.segments_.end() && error.empty(); ++segment )
+      {
+         for( uint64_t written = uint64_t(0); written < segment->data_.size() && error.empty(); )
+         {
+            const uint64_t count = std::min( uint64_c( segment->data_.size() ) - written, maxCount );
+            if( MPI_File_write_at( file, MPI_Offset( segment->offset_ + written ), const_cast< char * >( &( segment->data_[ written ] ) ),
+                                   int_c( count ), MPI_CHAR, MPI_STATUS_IGNORE ) != MPI_SUCCESS )
+               error = "Error while writing to file \"" + job.filename_ + "\" with MPI I/O.";
+            written += count;
+         }
+      }
+
+      MPI_File_close( &file );
+      MPI_Comm_free( &comm );
+
+      return error;
+   }
+#endif
+
+   std::fstream file( job.filename_.c_str(), std::fstream::in | std::fstream::out | std::fstream::binary );
+   if( !file )
+      return "Error while opening file \"" + job.filename_ + "\" for writing.";
+
+   for( auto segment = job.segments_.begin(); segment != job.segments_.end() && file; ++segment )
+   {
+      if( segment->data_.empty() )
+         continue;
+      file.seekp( std::streamoff( segment->offset_ ) );
+      file.write( &( segment->data_[0] ), std::streamsize( segment->data_.size() ) );
+   }
+   file.close();
+
+   if( !file )
+      return "Error while writing to file \"" + job.filename_ + "\".";
+
+   return std::string();
+}
+
+
+
+void AsyncFileWriter::reportErrors()
+{
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+   std::string error;
+   {
+      boost::unique_lock< boost::mutex > lock( mutex_ );
+      error.swap( error_ );
+   }
+   if( !error.empty() )
+      WALBERLA_ABORT( "Asynchronous output failed: " << error );
+#endif
+}
+
+
+
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+
+void AsyncFileWriter::run()
+{
+   boost::unique_lock< boost::mutex > lock( mutex_ );
+
+   while( true )
+   {
+      while( jobs_.empty() && !stop_ )
+         jobAdded_.wait( lock );
+
+      if( jobs_.empty() )
+         return;
+
+      // the main thread only appends jobs at the back, references to the front element stay valid
+      const Job & job = jobs_.front();
+
+      lock.unlock();
+      const std::string error = writeJob( job );
+      lock.lock();
+
+      if( !error.empty() && error_.empty() )
+         error_ = error;
+
+      pendingBytes_ -= job.bytes_;
+      jobs_.pop_front();
+      jobFinished_.notify_all();
+   }
+}
+
+#endif
+
+
+
+} // namespace mpi
+} // namespace walberla
@@ -0,0 +1,150 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncFileWriter.h
+//! \ingroup core
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/NonCopyable.h"
+#include "core/mpi/MPIWrapper.h"
+
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace walberla {
+namespace mpi {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Writes files in a background thread while the simulation continues
+*
+*   At the output step, the data of the calling process is copied into a staging buffer that is owned by the
+*   AsyncFileWriter. A dedicated I/O thread then writes the staging buffers to disk in the order in which they were
+*   passed to the writer. Every process writes its part of a (shared) file at offsets that are computed by the caller
+*   (for example with an exclusive scan over the sizes of all process local parts). 'write' must therefore be called
+*   collectively by all processes of the given communicator.
+*
+*   If MPI was initialized with MPI_THREAD_MULTIPLE, the I/O thread writes the file with MPI I/O (on a duplicate of the
+*   communicator). Otherwise, the I/O thread does not call any MPI function: The first process of the communicator
+*   creates the file and resizes it to its final size during 'write' (i.e., on the calling thread), and all I/O threads
+*   then only write their segments into the existing file. In both cases, an existing file is truncated first, so gaps
+*   between the segments are filled with zeros.
+*   With MPI I/O, all pending writes must be finished before MPI is finalized, i.e., the writer must be flushed or
+*   destroyed before.
+*
+*   The memory used by the staging buffers is bounded by 'memoryBudget' (in bytes per process): If a new staging buffer
+*   does not fit into the budget, the calling thread blocks until enough pending writes have finished. A single
+*   buffer that is larger than the budget is accepted as soon as no other write is pending.
+*
+*   'flush()' blocks until all pending writes are finished. The destructor calls 'flush()', so all data is on disk once
+*   the writer is destroyed. Errors that occur in the I/O thread are reported on the calling thread during the next call
+*   to 'write' or 'flush'.
+*
+*   If waLBerla is built without boost thread support (WALBERLA_BUILD_WITH_BOOST_THREAD), all writes are synchronous.
+*
+*   Writing to a file that is still being written to by an earlier, unfinished write of another process is not
+*   supported. Hence, if the same file name is reused (for example for checkpoints), 'flush()' must be called
+*   (collectively) before.
+*/
+//**********************************************************************************************************************
+
+class AsyncFileWriter : public NonCopyable
+{
+public:
+
+   struct Segment
+   {
+      Segment( const uint64_t offset = uint64_t(0) ) : offset_( offset ) {}
+
+      uint64_t offset_;
+      std::vector< char > data_;
+   };
+
+   AsyncFileWriter( const uint_t memoryBudget = uint_t(1) << 30 );
+   ~AsyncFileWriter();
+
+   /// Queues the process local segments of file 'filename', the file is resized to 'fileSize' bytes. The data of the
+   /// segments is swapped into the staging buffer, i.e., 'segments' is empty when this function returns. Must be called
+   /// collectively by all processes of 'comm' (processes without data pass an empty vector).
+   void write( const std::string & filename, const uint64_t fileSize, std::vector< Segment > & segments, const MPI_Comm comm = MPI_COMM_WORLD );
+
+   /// Same as 'mpi::writeMPITextFile', but the file is written asynchronously (must be called collectively)
+   void writeMPITextFile( const std::string & filename, const std::string & processLocalPart, const MPI_Comm comm = MPI_COMM_WORLD );
+
+   /// blocks until all pending writes of this process are finished
+   void flush();
+
+   uint_t memoryBudget() const { return memoryBudget_; }
+   /// true if the files are written with MPI I/O (requires MPI_THREAD_MULTIPLE)
+   bool usesMPIIO() const { return useMPIIO_; }
+   /// number of bytes that are currently held in staging buffers
+   uint_t pendingBytes() const;
+
+private:
+
+   struct Job
+   {
+      std::string filename_;
+      uint64_t fileSize_;
+      std::vector< Segment > segments_;
+      uint_t bytes_;
+      MPI_Comm comm_; // only used for MPI I/O, MPI_COMM_NULL otherwise
+   };
+
+   static std::string createFile( const std::string & filename, const uint64_t fileSize );
+   static std::string writeJob( const Job & job );
+
+   void reportErrors();
+
+   uint_t memoryBudget_;
+   bool useMPIIO_;
+
+#ifdef WALBERLA_BUILD_WITH_BOOST_THREAD
+
+   void run();
+
+   std::deque< Job > jobs_;     // the job at the front is being written by the I/O thread
+   uint_t pendingBytes_;
+   bool stop_;
+   std::string error_;
+
+   mutable boost::mutex mutex_;
+   boost::condition_variable jobAdded_;
+   boost::condition_variable jobFinished_;
+
+   boost::thread thread_;
+
+#endif
+
+}; // class AsyncFileWriter
+
+
+
+} // namespace mpi
+} // namespace walberla
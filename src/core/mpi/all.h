@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "AsyncFileWriter.h"
 #include "Broadcast.h"
 #include "BufferDataTypeExtensions.h"
 #include "BufferSizeTrait.h"
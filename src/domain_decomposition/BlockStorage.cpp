@@ -237,6 +237,47 @@ BlockDataID BlockStorage::loadBlockData( const std::string & file, const interna
 
 
 
+//**********************************************************************************************************************
+/*!
+*   Serializes the data that corresponds to 'id' of one single block into 'buffer' by using the data handling object
+*   that was registered for this block. Returns false (and leaves 'buffer' unchanged) if no data handling object is
+*   registered for this block.
+*/
+//**********************************************************************************************************************
+bool BlockStorage::serializeBlockData( IBlock * const block, const BlockDataID & id, mpi::SendBuffer & buffer )
+{
+   WALBERLA_CHECK_LESS( uint_t(id), blockDataItem_.size() );
+
+   auto dh = blockDataItem_[ uint_t(id) ].getDataHandling( block );
+   if( !dh )
+      return false;
+
+   dh->serialize( block, id, buffer );
+   return true;
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   Counterpart to 'serializeBlockData': Restores the already allocated data that corresponds to 'id' of one single block
+*   from 'buffer'. Returns false if no data handling object is registered for this block.
+*/
+//**********************************************************************************************************************
+bool BlockStorage::deserializeBlockData( IBlock * const block, const BlockDataID & id, mpi::RecvBuffer & buffer )
+{
+   WALBERLA_CHECK_LESS( uint_t(id), blockDataItem_.size() );
+
+   auto dh = blockDataItem_[ uint_t(id) ].getDataHandling( block );
+   if( !dh )
+      return false;
+
+   dh->deserialize( block, id, buffer );
+   return true;
+}
+
+
+
 //**********************************************************************************************************************
 /*!
 *   This function can be used to store the data that corresponds to 'id' to file, so that later (probably when
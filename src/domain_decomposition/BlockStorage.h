@@ -489,6 +489,9 @@ public:
                               const internal::SelectableBlockDataHandlingWrapper & dataHandling, const std::string & identifier = std::string() );
                               
    void saveBlockData( const std::string & file, const BlockDataID & id );
+
+   bool   serializeBlockData( IBlock * const block, const BlockDataID & id, mpi::SendBuffer & buffer );
+   bool deserializeBlockData( IBlock * const block, const BlockDataID & id, mpi::RecvBuffer & buffer );
    
    inline void clearBlockData( const BlockDataID & id );
 
@@ -97,6 +97,38 @@ BlockDataID addFlagFieldToStorage( const shared_ptr< BlockStorage_T > & blocks,
 
 
 
+//**********************************************************************************************************************
+/*! Adds a flag field that is allocated with the given allocator (see field::FieldAllocator) to the BlockStorage
+*
+* Same as the overload for ghost layer fields, e.g., for selecting a NUMA-aware allocation strategy
+* (field::AllocateFirstTouch) for the flag field that is accessed by the sweeps.
+*/
+//**********************************************************************************************************************
+template< typename FlagField_T, typename BlockStorage_T >
+BlockDataID addFlagFieldToStorage( const shared_ptr< BlockStorage_T > & blocks,
+                                   const std::string & identifier,
+                                   const uint_t nrOfGhostLayers,
+                                   const shared_ptr< FieldAllocator< typename FlagField_T::value_type > > & alloc,
+                                   const bool alwaysInitialize = false,
+                                   const boost::function< void ( FlagField_T * field, IBlock * const block ) > & initFunction =
+                                      boost::function< void ( FlagField_T * field, IBlock * const block ) >(),
+                                   const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(),
+                                   const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+{
+   if( alwaysInitialize )
+   {
+      auto dataHandling = make_shared< field::AlwaysInitializeBlockDataHandling< FlagField_T > >( blocks, nrOfGhostLayers, internal::defaultSize, alloc );
+      dataHandling->addInitializationFunction( initFunction );
+      return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
+   }
+
+   auto dataHandling = make_shared< field::DefaultBlockDataHandling< FlagField_T > >( blocks, nrOfGhostLayers, internal::defaultSize, alloc );
+   dataHandling->addInitializationFunction( initFunction );
+   return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
+}
+
+
+
 ///////////////////////
 // GHOST LAYER FIELD //
 ///////////////////////
@@ -110,9 +142,11 @@ struct AddToStorage
                            const typename GhostLayerField_T::value_type & initValue, const Layout layout, const uint_t nrOfGhostLayers,
                            const bool /*alwaysInitialize*/, const boost::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction,
                            const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors,
-                           const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize )
+                           const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize,
+                           const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc =
+                              shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > >() )
    {
-      auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+      auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
       dataHandling->addInitializationFunction( initFunction );
       return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
    }
@@ -127,16 +161,18 @@ struct AddToStorage< GhostLayerField_T, BlockStorage_T,
                            const typename GhostLayerField_T::value_type & initValue, const Layout layout, const uint_t nrOfGhostLayers,
                            const bool alwaysInitialize, const boost::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction,
                            const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors,
-                           const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize )
+                           const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = defaultSize,
+                           const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc =
+                              shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > >() )
    {
       if( alwaysInitialize )
       {
-         auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+         auto dataHandling = walberla::make_shared< field::AlwaysInitializeBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
          dataHandling->addInitializationFunction( initFunction );
          return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
       }
 
-      auto dataHandling = walberla::make_shared< field::DefaultBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize );
+      auto dataHandling = walberla::make_shared< field::DefaultBlockDataHandling< GhostLayerField_T > >( blocks, nrOfGhostLayers, initValue, layout, calculateSize, alloc );
       dataHandling->addInitializationFunction( initFunction );
       return blocks->addBlockData( dataHandling, identifier, requiredSelectors, incompatibleSelectors );
    }
@@ -180,6 +216,33 @@ BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
 
 
 
+//**********************************************************************************************************************
+/*! Adds a field that is allocated with the given allocator (see field::FieldAllocator) to the BlockStorage
+*
+* This is, for example, used for selecting a NUMA-aware allocation strategy (field::AllocateFirstTouch) for
+* individual fields.
+*/
+//**********************************************************************************************************************
+template< typename GhostLayerField_T, typename BlockStorage_T >
+BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
+                          const std::string & identifier,
+                          const typename GhostLayerField_T::value_type & initValue,
+                          const Layout layout,
+                          const uint_t nrOfGhostLayers,
+                          const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc,
+                          const bool alwaysInitialize = false,
+                          const boost::function< void ( GhostLayerField_T * field, IBlock * const block ) > & initFunction =
+                             boost::function< void ( GhostLayerField_T * field, IBlock * const block ) >(),
+                          const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(),
+                          const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+{
+   return internal::AddToStorage< GhostLayerField_T, BlockStorage_T >::add( blocks, identifier, initValue, layout, nrOfGhostLayers,
+                                                                            alwaysInitialize, initFunction, requiredSelectors,
+                                                                            incompatibleSelectors, internal::defaultSize, alloc );
+}
+
+
+
 template< typename GhostLayerField_T, typename BlockStorage_T >
 BlockDataID addToStorage( const shared_ptr< BlockStorage_T > & blocks,
                           const std::string & identifier,
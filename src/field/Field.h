@@ -112,7 +112,7 @@ namespace field {
 
       void init( uint_t xSize, uint_t ySize, uint_t zSize, const Layout & layout = zyxf,
                  shared_ptr<FieldAllocator<T> > alloc = shared_ptr<FieldAllocator<T> >(),
-                 uint_t innerGhostLayerSizeForAlignedAlloc = 0 );
+                 uint_t innerGhostLayerSizeForAlignedAlloc = 0, uint_t nrOfGhostLayers = 0 );
 
 
       virtual void resize( uint_t xSize, uint_t ySize, uint_t zSize );
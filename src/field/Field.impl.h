@@ -242,11 +242,14 @@ namespace field {
     *                This parameter should be set to zero for field that have no ghost layers.
     *                This parameter is passed to the allocator and can there be used to ensure
     *                alignment of the first INNER cell in each line
+    * \param nrOfGhostLayers
+    *                Number of ghost layers that are included in the given sizes. This parameter is passed to the
+    *                allocator and can there be used to place the memory like the field is traversed.
     *******************************************************************************************************************/
    template<typename T, uint_t fSize_>
    void Field<T, fSize_>::init( uint_t _xSize, uint_t _ySize, uint_t _zSize,
                                 const Layout & l, shared_ptr<FieldAllocator<T> > alloc,
-                                uint_t innerGhostLayerSizeForAlignedAlloc )
+                                uint_t innerGhostLayerSizeForAlignedAlloc, uint_t nrOfGhostLayers )
    {
       WALBERLA_ASSERT_NULLPTR( values_ );
       WALBERLA_ASSERT_NULLPTR( valuesWithOffset_ );
@@ -279,7 +282,7 @@ namespace field {
       WALBERLA_ASSERT(layout_ == zyxf || layout_ == fzyx);
 
       if (layout_ == fzyx ) {
-         values_ = allocator_->allocate(fSize_, zSize_, ySize_, xSize_, zAllocSize_, yAllocSize_, xAllocSize_);
+         values_ = allocator_->allocate(fSize_, zSize_, ySize_, xSize_, zAllocSize_, yAllocSize_, xAllocSize_, layout_, nrOfGhostLayers);
          fAllocSize_ = fSize_;
 
          WALBERLA_CHECK_LESS_EQUAL( fSize_ * xAllocSize_ * yAllocSize_ * zAllocSize_ + xSize_ + ySize_ * xAllocSize_ + zSize_ * xAllocSize_ * yAllocSize_,
@@ -291,7 +294,7 @@ namespace field {
          yfact_ = cell_idx_c(xAllocSize_);
          xfact_ = 1;
       } else {
-         values_ = allocator_->allocate(zSize_, ySize_, xSize_, fSize_, yAllocSize_, xAllocSize_, fAllocSize_);
+         values_ = allocator_->allocate(zSize_, ySize_, xSize_, fSize_, yAllocSize_, xAllocSize_, fAllocSize_, layout_, nrOfGhostLayers);
          zAllocSize_ = zSize_;
 
          WALBERLA_CHECK_LESS_EQUAL( fSize_ + xSize_ * fAllocSize_ + ySize_ * fAllocSize_ * xAllocSize_ + zSize_ * fAllocSize_ * xAllocSize_ * yAllocSize_,
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <core/mpi/AsyncFileWriter.h>
 #include <core/mpi/MPIWrapper.h>
 #include <core/mpi/Reduce.h>
 
@@ -64,6 +65,28 @@ void writeToFile( const std::string & filename, const BlockStorage & blockStorag
 
 
 
+//======================================================================================================================
+/*!
+ *  \brief Writes a field from a BlockStorage to file asynchronously
+ *
+ *  Creates the same file as the synchronous version above. The field data of all blocks of this process is copied into
+ *  a staging buffer of 'asyncWriter' and written to file by its I/O thread while the simulation continues. The file is
+ *  only complete after 'asyncWriter.flush()' was called (or after 'asyncWriter' was destroyed).
+ *
+ *  This is a collective function, it has to be called by all MPI processes simultaneously.
+ *
+ *  \param filename     The name of the file to be created
+ *  \param blockStorage The BlockStorage the field is registered at
+ *  \param fieldID      The ID of the field as returned by the BlockStorage at its registration
+ *  \param asyncWriter  The writer that performs the actual file I/O
+ */
+//======================================================================================================================
+template< typename FieldT >
+void writeToFile( const std::string & filename, const BlockStorage & blockStorage, const BlockDataID & fieldID, mpi::AsyncFileWriter & asyncWriter,
+                  const Set<SUID> & requiredSelectors = Set<SUID>::emptySet(), const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
+
+
 //======================================================================================================================
 /*!
 *  \brief Reads a field from a file
@@ -38,6 +38,7 @@ public:
    }
 
    void writeToFile( const BlockStorage & blockStorage ) const;
+   void writeToFile( const BlockStorage & blockStorage, mpi::AsyncFileWriter & asyncWriter ) const;
    void readFromFile( BlockStorage & blockStorage ) const;
 private:
 
@@ -132,6 +133,43 @@ void FieldWriter<FieldT>::writeToFile( const BlockStorage & blockStorage ) const
 
 
 
+template< typename FieldT >
+void FieldWriter<FieldT>::writeToFile( const BlockStorage & blockStorage, mpi::AsyncFileWriter & asyncWriter ) const
+{
+   typedef typename FieldT::value_type value_type;
+
+   std::vector< const IBlock * > blocks = getBlocks( blockStorage );
+   std::vector< uint_t > blockOffsets = computeBlockOffsets( blocks );
+
+   uint64_t offset   = uint64_t(0);
+   uint64_t fileSize = uint64_c( blockOffsets.back() * sizeof( value_type ) );
+
+   WALBERLA_MPI_SECTION()
+   {
+      offset   = uint64_c( computeProcessByteOffset( blockOffsets.back() ) );
+      fileSize = uint64_c( mpi::allReduce( blockOffsets.back(), mpi::SUM, MPIManager::instance()->comm() ) * sizeof( value_type ) );
+   }
+
+   std::vector< mpi::AsyncFileWriter::Segment > segments( 1, mpi::AsyncFileWriter::Segment( offset ) );
+   std::vector< char > & data = segments[0].data_;
+   data.resize( blockOffsets.back() * sizeof( value_type ) );
+
+   size_t blockIdx = 0;
+   for( auto block = blocks.begin(); block != blocks.end(); ++block, ++blockIdx )
+   {
+      const FieldT * field = (*block)->template getData<FieldT>( fieldID_ );
+
+      value_type * dataIt = reinterpret_cast< value_type * >( &data[0] ) + blockOffsets[blockIdx];
+      for( auto fieldIt = field->begin(); fieldIt != field->end(); ++fieldIt, ++dataIt )
+         *dataIt = *fieldIt;
+      WALBERLA_ASSERT_EQUAL( dataIt, reinterpret_cast< value_type * >( &data[0] ) + blockOffsets[blockIdx + 1] );
+   }
+
+   asyncWriter.write( filename_, fileSize, segments, MPIManager::instance()->comm() );
+}
+
+
+
 template< typename FieldT >
 void FieldWriter<FieldT>::readFromFile( BlockStorage & blockStorage ) const
 {
@@ -328,6 +366,16 @@ void writeToFile( const std::string & filename, const BlockStorage & blockStorag
 
 
 
+template< typename FieldT >
+void writeToFile( const std::string & filename, const BlockStorage & blockStorage, const BlockDataID & fieldID, mpi::AsyncFileWriter & asyncWriter,
+                  const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors )
+{
+   internal::FieldWriter<FieldT> writer( filename, fieldID, requiredSelectors, incompatibleSelectors );
+   writer.writeToFile( blockStorage, asyncWriter );
+}
+
+
+
 template< typename FieldT >
 void readFromFile( const std::string & filename, BlockStorage & blockStorage, const BlockDataID & fieldID,
                    const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors )
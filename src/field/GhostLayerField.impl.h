@@ -132,7 +132,7 @@ namespace field {
        Field<T,fSize_>::init( _xSize + 2*gl ,
                               _ySize + 2*gl,
                               _zSize + 2*gl, l, alloc,
-                              innerGhostLayerSize );
+                              innerGhostLayerSize, gl );
 
        Field<T,fSize_>::setOffsets( gl, _xSize,
                                     gl, _ySize,
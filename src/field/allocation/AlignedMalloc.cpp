@@ -24,6 +24,11 @@
 
 #include "core/debug/Debug.h"
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 
 namespace walberla {
 namespace field {
@@ -98,6 +103,65 @@ namespace field {
          std::free(*((void **)ptr-1));
    }
 
+
+#ifdef __linux__
+
+   void *mapped_malloc_with_offset( uint_t size, uint_t alignment, uint_t offset, bool hugePages )
+   {
+      WALBERLA_ASSERT_GREATER( alignment, 0 );
+      WALBERLA_ASSERT( !(alignment & (alignment - 1)) );
+      WALBERLA_ASSERT_LESS( offset, alignment );
+
+      // the base address and the length of the mapping are stored just before the usable chunk
+      const size_t header = 2 * sizeof(size_t);
+      const size_t length = size + alignment + header;
+
+      void *pa = mmap( NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+      if( pa == MAP_FAILED )
+         return 0;
+
+#ifdef MADV_HUGEPAGE
+      // only a hint, the allocation is still valid if the kernel does not support transparent huge pages
+      if( hugePages )
+         madvise( pa, length, MADV_HUGEPAGE );
+#else
+      WALBERLA_UNUSED( hugePages );
+#endif
+
+      // Find next position such that ptr+offset is aligned, starting at pa+header
+      void *ptr = (void*)( ( ( (size_t)pa + header + offset + alignment - 1 ) & ~(alignment-1) ) - offset );
+
+      *((size_t *)ptr-1) = (size_t)pa;
+      *((size_t *)ptr-2) = length;
+
+      WALBERLA_ASSERT_EQUAL( ((size_t)ptr+offset) % alignment, 0 );
+      WALBERLA_ASSERT_LESS_EQUAL( (size_t)ptr + size, (size_t)pa + length );
+
+      return ptr;
+   }
+
+
+   void mapped_free( void *ptr )
+   {
+      if(ptr)
+         munmap( (void*)( *((size_t *)ptr-1) ), *((size_t *)ptr-2) );
+   }
+
+#else
+
+   void *mapped_malloc_with_offset( uint_t size, uint_t alignment, uint_t offset, bool /*hugePages*/ )
+   {
+      return aligned_malloc_with_offset( size, alignment, offset );
+   }
+
+
+   void mapped_free( void *ptr )
+   {
+      aligned_free( ptr );
+   }
+
+#endif
+
 } // namespace field
 } // namespace walberla
 
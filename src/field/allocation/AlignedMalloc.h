@@ -77,6 +77,39 @@ namespace field {
    void aligned_free( void *ptr );
 
 
+
+   //*******************************************************************************************************************
+   /*!
+    * Allocates memory such that (ptr+offset) is aligned, using pages that have never been touched before
+    *
+    * \ingroup field
+    *
+    * On Linux, the memory is mapped directly from the operating system (mmap) instead of being taken from the heap.
+    * The physical pages are therefore only placed when they are written for the first time ("first touch"), which
+    * allows to place the memory in the NUMA domain of the threads that later work on it. Optionally, transparent huge
+    * pages are requested for the allocation (madvise). On all other platforms, this function falls back to
+    * aligned_malloc_with_offset() and 'hugePages' is ignored.
+    * Memory allocated with mapped_malloc_with_offset can only be freed with mapped_free()
+    *
+    * \param size       see aligned_malloc()
+    * \param alignment  see aligned_malloc()
+    * \param offset     see aligned_malloc_with_offset()
+    * \param hugePages  if true, transparent huge pages are requested for the allocated memory
+    */
+   //*******************************************************************************************************************
+   void *mapped_malloc_with_offset( uint_t size, uint_t alignment, uint_t offset, bool hugePages = false );
+
+
+   /****************************************************************************************************************//**
+    * Analogous to free for memory allocated with mapped_malloc_with_offset
+    *
+    * \ingroup field
+    *
+    * \param ptr  The pointer returned by mapped_malloc_with_offset
+    *******************************************************************************************************************/
+   void mapped_free( void *ptr );
+
+
 } // namespace field
 } // namespace walberla
 
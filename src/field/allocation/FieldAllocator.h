@@ -25,10 +25,13 @@
 #include "AlignedMalloc.h"
 #include "core/debug/Debug.h"
 #include "field/CMakeDefs.h"
+#include "field/Layout.h"
 
 #include <boost/static_assert.hpp>
+#include <limits>
 #include <map>
 #include <new>
+#include <ostream>
 
 
 namespace walberla {
@@ -77,6 +80,32 @@ namespace field {
          }
 
 
+         /**
+          * \brief Same as the function above, additionally passes the layout of the field to the allocator
+          *
+          * \param layout           The layout of the field, determines the meaning of size0 to size3
+          * \param nrOfGhostLayers  The number of ghost layers that are included in the sizes
+          *
+          * Allocators can use this information to place the memory according to how the field is traversed later.
+          */
+         T * allocate (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
+                         uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3,
+                         const Layout & layout, uint_t nrOfGhostLayers )
+         {
+            T * mem = allocateMemory(size0,size1,size2,size3,allocSize1,allocSize2,allocSize3,layout,nrOfGhostLayers);
+            #ifdef WALBERLA_THREAD_SAFE_FIELD_ALLOCATION
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_allocator_refcount )
+            #endif
+            #endif
+            {
+               WALBERLA_ASSERT( referenceCounts_.find(mem) == referenceCounts_.end() || referenceCounts_[mem] == 0 );
+               referenceCounts_[mem] = 1;
+            }
+            return mem;
+         }
+
+
          virtual void setInnerGhostLayerSize( uint_t /*innerGhostLayerSize*/ ) {}
 
          /**
@@ -183,6 +212,18 @@ namespace field {
          virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
                                        uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3 ) = 0;
 
+         /**
+          * \brief Same as allocated with layout, without handling of reference counter
+          *
+          * By default, the layout is ignored.
+          */
+         virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
+                                       uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3,
+                                       const Layout & /*layout*/, uint_t /*nrOfGhostLayers*/ )
+         {
+            return allocateMemory( size0, size1, size2, size3, allocSize1, allocSize2, allocSize3 );
+         }
+
 
          /**
           * \brief Same as allocated, without handling of reference counter
@@ -303,6 +344,414 @@ namespace field {
 
 
 
+   /****************************************************************************************************************//**
+   * Aligned allocation strategy for fields that places the memory in the NUMA domains of the threads using it
+   *
+   * \ingroup field
+   *
+   * Memory pages are physically placed in the NUMA domain of the thread that writes them first ("first touch").
+   * Fields that are allocated and initialized by the master thread therefore end up completely in one NUMA domain
+   * and OpenMP parallel sweeps read most of their data from remote memory. This allocator takes fresh pages from
+   * the operating system (see mapped_malloc_with_offset()) and constructs the elements in parallel with the same
+   * static schedule as the cell loop macros (WALBERLA_FOR_ALL_CELLS_XYZ_OMP etc.), which are used by the sweeps:
+   * the inner z slices (y slices if the field has more y than z cells) are distributed evenly among the threads,
+   * the ghost layer slices belong to the first and the last thread, respectively.
+   * Optionally, transparent huge pages are requested for the allocated memory, which reduces TLB misses.
+   *
+   * Template parameters:
+   *  - T          type that is stored in field
+   *  - alignment  see AllocateAligned
+   *
+   * The allocator is selected per field, for example:
+   * \code
+   *   field::addToStorage< ScalarField_T >( blocks, "scalar field", real_t(0), field::fzyx, uint_t(1),
+   *                                         make_shared< field::AllocateFirstTouch< real_t, 64 > >( true ) );
+   * \endcode
+   *
+   * The layout and the number of ghost layers are passed by the field with every allocation, the allocator itself is
+   * stateless (apart from the inner ghost layer size, see AllocateAligned) and can be shared by any number of fields.
+   * Memory that is allocated without this information (e.g., for a clone of a field) is constructed in equally sized
+   * consecutive chunks, one chunk per thread.
+   ********************************************************************************************************************/
+   template <typename T, uint_t alignment>
+   class AllocateFirstTouch : public FieldAllocator<T>
+   {
+      public:
+
+         AllocateFirstTouch( const bool hugePages = false ) : hugePages_( hugePages ), offset_( uint_t(0) ) {}
+
+         bool hugePages() const { return hugePages_; }
+
+      protected:
+
+         virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
+                                       uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3)
+         {
+            computeAllocSizes( size1, size2, size3, allocSize1, allocSize2, allocSize3 );
+
+            const uint_t size = size0 * allocSize1 * allocSize2 * allocSize3;
+            T * ret = mappedMalloc( size );
+            constructLinear( ret, size );
+            return ret;
+         }
+
+         virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
+                                       uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3,
+                                       const Layout & layout, uint_t nrOfGhostLayers )
+         {
+            computeAllocSizes( size1, size2, size3, allocSize1, allocSize2, allocSize3 );
+
+            T * ret = mappedMalloc( size0 * allocSize1 * allocSize2 * allocSize3 );
+            constructSlices( ret, layout, nrOfGhostLayers, size0, allocSize1, allocSize2, allocSize3 );
+            return ret;
+         }
+
+         virtual T * allocateMemory (  uint_t size )
+         {
+            T * ret = mappedMalloc( size );
+            constructLinear( ret, size );
+            return ret;
+         }
+
+         virtual void setInnerGhostLayerSize( uint_t innerGhostLayerSize ) {
+            offset_ = sizeof(T) * innerGhostLayerSize;
+         }
+
+         virtual void deallocate(T *& values )
+         {
+            size_t nrOfValues = 0;
+
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_first_touch_allocator_nrOfElements )
+            #endif
+            {
+               WALBERLA_ASSERT ( nrOfElements_.find(values) != nrOfElements_.end() );
+               nrOfValues = nrOfElements_[values];
+               nrOfElements_.erase( values );
+            }
+
+            for( uint_t i = 0; i < nrOfValues; ++i )
+               values[i].~T();
+
+            mapped_free(values);
+         }
+
+         BOOST_STATIC_ASSERT_MSG(alignment > 0, "Use StdFieldAlloc");
+         BOOST_STATIC_ASSERT_MSG(!(alignment & (alignment - 1)) , "Alignment has to be power of 2");
+
+      private:
+
+         static void computeAllocSizes( uint_t size1, uint_t size2, uint_t size3,
+                                        uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3 )
+         {
+            allocSize1=size1;
+            allocSize2=size2;
+            allocSize3=size3;
+            uint_t lineLength = size3 * static_cast<uint_t>( sizeof(T) );
+            if(lineLength % alignment !=0 )
+               allocSize3 = ((lineLength + alignment) / alignment ) * (alignment / sizeof(T));
+
+            WALBERLA_ASSERT_GREATER_EQUAL( allocSize3, size3 );
+            WALBERLA_ASSERT_EQUAL( (allocSize3 * sizeof(T)) % alignment, 0 );
+         }
+
+         /// Takes 'size' elements of fresh, untouched memory from the operating system
+         T * mappedMalloc( uint_t size ) const
+         {
+            void * ptr = mapped_malloc_with_offset( size * sizeof(T), alignment, offset_ % alignment, hugePages_ );
+            if(!ptr)
+               throw std::bad_alloc();
+
+            T * ret = reinterpret_cast<T*>( ptr );
+
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_first_touch_allocator_nrOfElements )
+            #endif
+            {
+               nrOfElements_[ret] = size;
+            }
+            return ret;
+         }
+
+         /// Constructs the elements slice by slice, with the same static schedule as the cell loop macros
+         static void constructSlices( T * const values, const Layout & layout, const uint_t gl,
+                                      const uint_t size0, const uint_t allocSize1, const uint_t allocSize2, const uint_t allocSize3 )
+         {
+            // memory is organized in 'outer' blocks of z slices of y lines with 'line' consecutive elements each
+            const uint_t outer = ( layout == fzyx ) ? size0      : uint_t(1);
+            const uint_t zSize = ( layout == fzyx ) ? allocSize1 : size0;
+            const uint_t ySize = ( layout == fzyx ) ? allocSize2 : allocSize1;
+            const uint_t line  = ( layout == fzyx ) ? allocSize3 : allocSize2 * allocSize3;
+
+            // the cell loop macros distribute z slices if there are at least as many inner z as inner y cells
+            const bool   zSlices = ( zSize >= ySize );
+            const uint_t slices  = zSlices ? zSize : ySize;
+            const uint_t rows    = zSlices ? ySize : zSize;
+            const int    inner   = ( slices > uint_t(2) * gl ) ? int_c( slices - uint_t(2) * gl ) : ( slices > uint_t(0) ? 1 : 0 );
+
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for( int i = 0; i < inner; ++i )
+            {
+               const uint_t first = ( i == 0 )         ? uint_t(0) : uint_c(i) + gl;
+               const uint_t last  = ( i == inner - 1 ) ? slices    : uint_c(i) + gl + uint_t(1);
+
+               for( uint_t o = uint_t(0); o < outer; ++o )
+                  for( uint_t s = first; s < last; ++s )
+                     for( uint_t r = uint_t(0); r < rows; ++r )
+                     {
+                        const uint_t z = zSlices ? s : r;
+                        const uint_t y = zSlices ? r : s;
+                        T * const begin = values + ( ( o * zSize + z ) * ySize + y ) * line;
+                        for( uint_t e = uint_t(0); e < line; ++e )
+                           new ( begin + e ) T();
+                     }
+            }
+         }
+
+         /// Constructs the elements in equally sized consecutive chunks, one chunk per thread
+         static void constructLinear( T * const values, const uint_t size )
+         {
+            const int iSize = int_c( size );
+
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+            #endif
+            for( int i = 0; i < iSize; ++i )
+               new ( values + i ) T();
+         }
+
+         /// Nr of elements per allocated pointer has to be stored to call the destructor on each element
+         static std::map<T*, uint_t> nrOfElements_;
+
+         bool   hugePages_;
+         uint_t offset_;
+   };
+   template <typename T, uint_t alignment>
+   std::map<T*,uint_t> AllocateFirstTouch<T,alignment>::nrOfElements_ = std::map<T*,uint_t>();
+
+
+
+   //*******************************************************************************************************************
+   /*! Statistics of a PooledFieldAlloc
+   *
+   * \ingroup field
+   */
+   //*******************************************************************************************************************
+   struct PooledFieldAllocStatistics
+   {
+      PooledFieldAllocStatistics() : allocations( uint_t(0) ), reuses( uint_t(0) ), allocatedBytes( uint_t(0) ), reusedBytes( uint_t(0) ),
+                                     freedBytes( uint_t(0) ), pooledBytes( uint_t(0) ) {}
+
+      uint_t allocations;     ///< number of allocations that had to allocate new memory
+      uint_t reuses;          ///< number of allocations that were served from the pool
+      uint_t allocatedBytes;  ///< bytes of newly allocated memory
+      uint_t reusedBytes;     ///< bytes of memory that were served from the pool
+      uint_t freedBytes;      ///< bytes of memory that were returned to the system
+      uint_t pooledBytes;     ///< bytes of memory that are currently held in the pool
+   };
+
+   inline std::ostream & operator<<( std::ostream & os, const PooledFieldAllocStatistics & statistics )
+   {
+      os << "newly allocated: " << statistics.allocatedBytes << " bytes (" << statistics.allocations << " allocations), "
+         << "reused: " << statistics.reusedBytes << " bytes (" << statistics.reuses << " allocations), "
+         << "freed: " << statistics.freedBytes << " bytes, currently pooled: " << statistics.pooledBytes << " bytes";
+      return os;
+   }
+
+
+
+   /****************************************************************************************************************//**
+   * Aligned allocation strategy for fields that recycles the memory of deallocated fields
+   *
+   * \ingroup field
+   *
+   * Deallocated memory is not returned to the system but kept in a pool, and a later allocation of the same size
+   * (and the same alignment offset) reuses it. Whenever blocks are created and destroyed (BlockForest::refresh(),
+   * migration of blocks during load balancing, temporary fields of sweeps, ...) the memory of the fields is
+   * therefore recycled instead of being freed and allocated again via aligned_malloc().
+   *
+   * For being effective, the same allocator instance has to be used for all fields that should share the pool, for
+   * example by passing it to field::addToStorage. Since the block data handling keeps the allocator, it is also used
+   * when blocks are recreated after being migrated to this process or after being refined/coarsened.
+   *
+   * The pool is bounded by 'maxPooledBytes', memory that does not fit into the pool anymore is freed.
+   * All pooled memory is freed when the allocator is destroyed or when releasePool() is called.
+   * Statistics on newly allocated versus reused memory are available via getStatistics().
+   *
+   * Template parameters:
+   *  - T          type that is stored in field
+   *  - alignment  see AllocateAligned
+   ********************************************************************************************************************/
+   template <typename T, uint_t alignment>
+   class PooledFieldAlloc : public FieldAllocator<T>
+   {
+      public:
+
+         typedef PooledFieldAllocStatistics Statistics;
+
+         PooledFieldAlloc( const uint_t maxPooledBytes = std::numeric_limits< uint_t >::max() ) :
+            maxPooledBytes_( maxPooledBytes ), offset_( uint_t(0) ) {}
+
+         virtual ~PooledFieldAlloc() { releasePool(); }
+
+         Statistics getStatistics() const
+         {
+            Statistics statistics;
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               statistics = statistics_;
+            }
+            return statistics;
+         }
+
+         /// Returns all memory that is currently held in the pool to the system
+         void releasePool()
+         {
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               for( auto it = pool_.begin(); it != pool_.end(); ++it )
+               {
+                  statistics_.freedBytes += it->first.first * sizeof(T);
+                  aligned_free( it->second );
+               }
+               pool_.clear();
+               statistics_.pooledBytes = uint_t(0);
+            }
+         }
+
+      protected:
+
+         virtual T * allocateMemory (  uint_t size0, uint_t size1, uint_t size2, uint_t size3,
+                                       uint_t & allocSize1, uint_t & allocSize2, uint_t & allocSize3)
+         {
+            allocSize1=size1;
+            allocSize2=size2;
+            allocSize3=size3;
+            uint_t lineLength = size3 * static_cast<uint_t>( sizeof(T) );
+            if(lineLength % alignment !=0 )
+               allocSize3 = ((lineLength + alignment) / alignment ) * (alignment / sizeof(T));
+
+            WALBERLA_ASSERT_GREATER_EQUAL( allocSize3, size3 );
+            WALBERLA_ASSERT_EQUAL( (allocSize3 * sizeof(T)) % alignment, 0 );
+
+            return allocateMemory ( size0 * allocSize1 * allocSize2 * allocSize3 );
+         }
+
+         virtual T * allocateMemory (  uint_t size )
+         {
+            const Key key( size, offset_ % alignment );
+            void * ptr = NULL;
+
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               auto it = pool_.find( key );
+               if( it != pool_.end() )
+               {
+                  ptr = it->second;
+                  pool_.erase( it );
+                  statistics_.pooledBytes -= size * sizeof(T);
+                  statistics_.reusedBytes += size * sizeof(T);
+                  ++statistics_.reuses;
+               }
+            }
+
+            if( ptr == NULL )
+            {
+               ptr = aligned_malloc_with_offset( size * sizeof(T), alignment, key.second );
+               if(!ptr)
+                  throw std::bad_alloc();
+
+               #ifdef _OPENMP
+               #pragma omp critical( walberla_field_pooled_allocator )
+               #endif
+               {
+                  statistics_.allocatedBytes += size * sizeof(T);
+                  ++statistics_.allocations;
+               }
+            }
+
+            // placement new
+            new (ptr) T[ size ];
+
+            T * ret = reinterpret_cast<T*>( ptr );
+
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               allocated_[ret] = key;
+            }
+            return ret;
+         }
+
+         virtual void setInnerGhostLayerSize( uint_t innerGhostLayerSize ) {
+            offset_ = sizeof(T) * innerGhostLayerSize;
+         }
+
+         virtual void deallocate(T *& values )
+         {
+            Key key;
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               WALBERLA_ASSERT ( allocated_.find(values) != allocated_.end() );
+               key = allocated_[values];
+               allocated_.erase( values );
+            }
+
+            for( uint_t i = 0; i < key.first; ++i )
+               values[i].~T();
+
+            bool pooled = false;
+            #ifdef _OPENMP
+            #pragma omp critical( walberla_field_pooled_allocator )
+            #endif
+            {
+               if( key.first * sizeof(T) <= maxPooledBytes_ - statistics_.pooledBytes )
+               {
+                  pool_.insert( std::make_pair( key, values ) );
+                  statistics_.pooledBytes += key.first * sizeof(T);
+                  pooled = true;
+               }
+               else
+               {
+                  statistics_.freedBytes += key.first * sizeof(T);
+               }
+            }
+
+            if( !pooled )
+               aligned_free(values);
+            values = 0;
+         }
+
+         BOOST_STATIC_ASSERT_MSG(alignment > 0, "Use StdFieldAlloc");
+         BOOST_STATIC_ASSERT_MSG(!(alignment & (alignment - 1)) , "Alignment has to be power of 2");
+
+      private:
+
+         /// number of elements and alignment offset of an allocation
+         typedef std::pair< uint_t, uint_t > Key;
+
+         std::multimap< Key, T* > pool_;       ///< memory that is currently not in use
+         std::map< T*, Key >      allocated_;  ///< memory that is currently in use
+
+         Statistics statistics_;
+
+         uint_t maxPooledBytes_;
+         uint_t offset_;
+   };
+
+
+
    /****************************************************************************************************************//**
    *  Allocator without alignment using new and delete[]
    *
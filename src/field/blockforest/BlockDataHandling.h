@@ -327,55 +327,67 @@ namespace internal
 
 template< typename GhostLayerField_T >
 inline GhostLayerField_T * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl,
-                                     const typename GhostLayerField_T::value_type & v, Layout l )
+                                     const typename GhostLayerField_T::value_type & v, Layout l,
+                                     const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc =
+                                        shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > >() )
 {
-   return new GhostLayerField_T(x,y,z,gl,v,l);
+   return new GhostLayerField_T(x,y,z,gl,v,l,alloc);
 }
 template<>
-inline FlagField<uint8_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint8_t &, Layout )
+inline FlagField<uint8_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint8_t &, Layout,
+                                      const shared_ptr< FieldAllocator< uint8_t > > & alloc )
 {
-   return new FlagField<uint8_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint8_t>(x,y,z,gl,alloc) : new FlagField<uint8_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint16_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint16_t &, Layout )
+inline FlagField<uint16_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint16_t &, Layout,
+                                      const shared_ptr< FieldAllocator< uint16_t > > & alloc )
 {
-   return new FlagField<uint16_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint16_t>(x,y,z,gl,alloc) : new FlagField<uint16_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint32_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint32_t &, Layout )
+inline FlagField<uint32_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint32_t &, Layout,
+                                      const shared_ptr< FieldAllocator< uint32_t > > & alloc )
 {
-   return new FlagField<uint32_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint32_t>(x,y,z,gl,alloc) : new FlagField<uint32_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint64_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint64_t &, Layout )
+inline FlagField<uint64_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, const uint64_t &, Layout,
+                                      const shared_ptr< FieldAllocator< uint64_t > > & alloc )
 {
-   return new FlagField<uint64_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint64_t>(x,y,z,gl,alloc) : new FlagField<uint64_t>(x,y,z,gl);
 }
 
 template< typename GhostLayerField_T >
-inline GhostLayerField_T * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout l )
+inline GhostLayerField_T * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout l,
+                                     const shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > > & alloc =
+                                        shared_ptr< FieldAllocator< typename GhostLayerField_T::value_type > >() )
 {
-   return new GhostLayerField_T(x,y,z,gl,l);
+   return new GhostLayerField_T(x,y,z,gl,l,alloc);
 }
 template<>
-inline FlagField<uint8_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout )
+inline FlagField<uint8_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout,
+                                      const shared_ptr< FieldAllocator< uint8_t > > & alloc )
 {
-   return new FlagField<uint8_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint8_t>(x,y,z,gl,alloc) : new FlagField<uint8_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint16_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout )
+inline FlagField<uint16_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout,
+                                      const shared_ptr< FieldAllocator< uint16_t > > & alloc )
 {
-   return new FlagField<uint16_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint16_t>(x,y,z,gl,alloc) : new FlagField<uint16_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint32_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout )
+inline FlagField<uint32_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout,
+                                      const shared_ptr< FieldAllocator< uint32_t > > & alloc )
 {
-   return new FlagField<uint32_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint32_t>(x,y,z,gl,alloc) : new FlagField<uint32_t>(x,y,z,gl);
 }
 template<>
-inline FlagField<uint64_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout )
+inline FlagField<uint64_t> * allocate( const uint_t x, const uint_t y, const uint_t z, const uint_t gl, Layout,
+                                      const shared_ptr< FieldAllocator< uint64_t > > & alloc )
 {
-   return new FlagField<uint64_t>(x,y,z,gl);
+   return alloc ? new FlagField<uint64_t>(x,y,z,gl,alloc) : new FlagField<uint64_t>(x,y,z,gl);
 }
 
 inline Vector3< uint_t > defaultSize( const shared_ptr< StructuredBlockStorage > & blocks, IBlock * const block )
@@ -400,14 +412,16 @@ public:
    {}
 
    DefaultBlockDataHandling( const weak_ptr< StructuredBlockStorage > & blocks, const uint_t nrOfGhostLayers,
-                             const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = internal::defaultSize ) :
-      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_(), layout_( zyxf ), calculateSize_( calculateSize )
+                             const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = internal::defaultSize,
+                             const shared_ptr< FieldAllocator< Value_T > > & alloc = shared_ptr< FieldAllocator< Value_T > >() ) :
+      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_(), layout_( zyxf ), calculateSize_( calculateSize ), alloc_( alloc )
    {}
 
    DefaultBlockDataHandling( const weak_ptr< StructuredBlockStorage > & blocks, const uint_t nrOfGhostLayers,
                              const Value_T & initValue, const Layout layout = zyxf,
-                             const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = internal::defaultSize ) :
-      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_( initValue ), layout_( layout ), calculateSize_( calculateSize )
+                             const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = internal::defaultSize,
+                             const shared_ptr< FieldAllocator< Value_T > > & alloc = shared_ptr< FieldAllocator< Value_T > >() ) :
+      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_( initValue ), layout_( layout ), calculateSize_( calculateSize ), alloc_( alloc )
    {
       static_assert( !boost::is_same< GhostLayerField_T, FlagField< Value_T > >::value,
                      "When using class FlagField, only constructors without the explicit specification of an initial value and the field layout are available!" );
@@ -421,7 +435,7 @@ protected:
       WALBERLA_CHECK_NOT_NULLPTR( blocks, "Trying to access 'DefaultBlockDataHandling' for a block storage object that doesn't exist anymore" );
       const Vector3< uint_t > size = calculateSize_( blocks, block );
       return internal::allocate< GhostLayerField_T >( size[0], size[1], size[2],
-                                                      nrOfGhostLayers_, initValue_, layout_ );
+                                                      nrOfGhostLayers_, initValue_, layout_, alloc_ );
    }
 
    GhostLayerField_T * reallocate( IBlock * const block )
@@ -430,7 +444,7 @@ protected:
       WALBERLA_CHECK_NOT_NULLPTR( blocks, "Trying to access 'DefaultBlockDataHandling' for a block storage object that doesn't exist anymore" );
       const Vector3< uint_t > size = calculateSize_( blocks, block );
       return internal::allocate< GhostLayerField_T >( size[0], size[1], size[2],
-                                                      nrOfGhostLayers_, layout_ );
+                                                      nrOfGhostLayers_, layout_, alloc_ );
    }
 
 private:
@@ -442,6 +456,8 @@ private:
    Layout  layout_;
    const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize_;
 
+   shared_ptr< FieldAllocator< Value_T > > alloc_;
+
 }; // class DefaultBlockDataHandling
 
 
@@ -463,14 +479,16 @@ public:
    {}
 
    AlwaysInitializeBlockDataHandling( const weak_ptr< StructuredBlockStorage > & blocks, const uint_t nrOfGhostLayers,
-                                      const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) >() ) :
-      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_(), layout_( zyxf ), calculateSize_( calculateSize )
+                                      const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) >(),
+                                      const shared_ptr< FieldAllocator< Value_T > > & alloc = shared_ptr< FieldAllocator< Value_T > >() ) :
+      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_(), layout_( zyxf ), calculateSize_( calculateSize ), alloc_( alloc )
    {}
 
    AlwaysInitializeBlockDataHandling( const weak_ptr< StructuredBlockStorage > & blocks, const uint_t nrOfGhostLayers,
                                       const Value_T & initValue, const Layout layout = zyxf,
-                                      const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) >() ) :
-      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_( initValue ), layout_( layout ), calculateSize_( calculateSize )
+                                      const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize = boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) >(),
+                                      const shared_ptr< FieldAllocator< Value_T > > & alloc = shared_ptr< FieldAllocator< Value_T > >() ) :
+      blocks_( blocks ), nrOfGhostLayers_( nrOfGhostLayers ), initValue_( initValue ), layout_( layout ), calculateSize_( calculateSize ), alloc_( alloc )
    {
       static_assert( !boost::is_same< GhostLayerField_T, FlagField< Value_T > >::value,
                      "When using class FlagField, only constructors without the explicit specification of an initial value and the field layout are available!" );
@@ -484,7 +502,7 @@ public:
       WALBERLA_CHECK_NOT_NULLPTR( blocks, "Trying to access 'AlwaysInitializeBlockDataHandling' for a block storage object that doesn't exist anymore" );
       Vector3<uint_t> size = calculateSize_( blocks, block );
       GhostLayerField_T * field = internal::allocate< GhostLayerField_T >( size[0], size[1], size[2],
-                                                                           nrOfGhostLayers_, initValue_, layout_ );
+                                                                           nrOfGhostLayers_, initValue_, layout_, alloc_ );
       if( initFunction_ )
          initFunction_( field, block );
 
@@ -500,6 +518,8 @@ private:
    Layout  layout_;
    const boost::function< Vector3< uint_t > ( const shared_ptr< StructuredBlockStorage > &, IBlock * const ) > calculateSize_;
 
+   shared_ptr< FieldAllocator< Value_T > > alloc_;
+
    InitializationFunction_T initFunction_;
 
 }; // class AlwaysInitializeBlockDataHandling
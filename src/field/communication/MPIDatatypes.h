@@ -304,6 +304,31 @@ template<typename GhostLayerField_T>
 MPI_Datatype mpiDatatypeGhostLayerOnlyXYZ( const GhostLayerField_T & field, const stencil::Direction dir, const bool fullSlice, const std::set<cell_idx_t> & fs );
 
 
+
+//======================================================================================================================
+/*!
+*  \brief Creates a MPI datatype to communicate parts of the ghost layers of a GhostLayerField
+*
+*  The specified ghost layers of a Field are communicated, when the returned datatype is used in MPI communication.
+*  In contrast to the function above, only the 'thickness' innermost ghost layers are communicated, which is required
+*  if the sending side uses mpiDatatypeSliceBeforeGhostlayerXYZ with the same thickness for a field with more ghost
+*  layers.
+*
+*  The returned MPI_Datatype still has to be committed before used in communication and should be freed if it is not
+*  needed any longer.
+*
+*  \param field          The GhostLayerField to be communicated
+*  \param thickness      As described at GhostLayerField::getGhostRegion
+*  \param dir            As described at GhostLayerField::getGhostRegion
+*  \param fullSlice      As described at GhostLayerField::getGhostRegion
+*  \param fs             Communicated components
+*  \returns              The MPI datatype
+*/
+//======================================================================================================================
+template<typename GhostLayerField_T>
+MPI_Datatype mpiDatatypeGhostLayerOnlyXYZ( const GhostLayerField_T & field, const uint_t thickness, const stencil::Direction dir, const bool fullSlice, const std::set<cell_idx_t> & fs );
+
+
 //======================================================================================================================
 /*!
 *  \brief Creates a MPI datatype to communicate inner parts if a GhostLayerField near the ghost layers
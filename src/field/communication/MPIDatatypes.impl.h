@@ -280,6 +280,15 @@ MPI_Datatype mpiDatatypeGhostLayerOnlyXYZ( const GhostLayerField_T & field, cons
    return mpiDatatypeSliceXYZ( field, ci, fs );
 }
 
+template<typename GhostLayerField_T>
+MPI_Datatype mpiDatatypeGhostLayerOnlyXYZ( const GhostLayerField_T & field, const uint_t thickness, const stencil::Direction dir, const bool fullSlice, const std::set<cell_idx_t> & fs )
+{
+   CellInterval ci;
+   field.getGhostRegion( dir, ci, cell_idx_c( thickness ), fullSlice );
+
+   return mpiDatatypeSliceXYZ( field, ci, fs );
+}
+
 template<typename GhostLayerField_T>
 MPI_Datatype mpiDatatypeSliceBeforeGhostlayer( const GhostLayerField_T & field, const stencil::Direction dir, const uint_t thickness /*= 1*/, const bool fullSlice /*= false*/ )
 {
@@ -37,6 +37,9 @@ namespace communication {
  * Data packing/unpacking for ghost layer based communication of a single walberla::field::Field
  * \ingroup field
  * Template parameters are equivalent of the parameters of GhostLayerField that is communicated
+ *
+ * All components of the ghost layers are communicated. If the components of the field belong to the directions of a
+ * stencil (e.g. PDFs), see StencilRestrictedPackInfo, which only sends the components pointing to the neighbor.
  */
 template<typename GhostLayerField_T>
 class PackInfo : public walberla::communication::UniformPackInfo
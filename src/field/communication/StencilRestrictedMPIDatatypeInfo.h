@@ -0,0 +1,105 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file StencilRestrictedMPIDatatypeInfo.h
+//! \ingroup field
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/debug/Debug.h"
+#include "communication/UniformMPIDatatypeInfo.h"
+#include "field/communication/MPIDatatypes.h"
+
+#include <set>
+
+namespace walberla {
+namespace field {
+namespace communication {
+
+//**********************************************************************************************************************
+/*!
+*   \brief Bufferless communication of a field whose f-th component belongs to the f-th direction of 'Stencil_T'
+*
+*   In contrast to field::communication::UniformMPIDatatypeInfo, which describes all components of all ghost layers,
+*   the MPI datatypes only describe the components that point into the direction of the neighboring block
+*   (Stencil_T::d_per_d): 5 of 19 values per cell for a face of a D3Q19 field and 1 value per cell for an edge. The
+*   datatypes select the values directly in the field (for both fzyx and zyxf layout), i.e., no packing/unpacking into
+*   intermediate buffers is required. Exactly one ghost layer is communicated, even if the field has more ghost layers.
+*   Directions in which no component points (e.g. the corners for D3Q19) result in empty datatypes for which
+*   blockforest::communication::UniformDirectScheme sends no message.
+*/
+//**********************************************************************************************************************
+template< typename GhostLayerField_T, typename Stencil_T >
+class StencilRestrictedMPIDatatypeInfo : public walberla::communication::UniformMPIDatatypeInfo
+{
+public:
+
+   static_assert( GhostLayerField_T::F_SIZE == Stencil_T::Size, "Size of stencil and f size of field have to be equal" );
+
+   StencilRestrictedMPIDatatypeInfo( BlockDataID fieldID ) : fieldID_( fieldID ) {}
+
+   virtual ~StencilRestrictedMPIDatatypeInfo() {}
+
+   virtual shared_ptr<mpi::Datatype> getSendDatatype ( IBlock * block, const stencil::Direction dir )
+   {
+      return make_shared<mpi::Datatype>( mpiDatatypeSliceBeforeGhostlayerXYZ(
+         *getField( block ), dir, uint_t( 1 ), getOptimizedCommunicationIndices( dir ), false ) );
+   }
+
+   virtual shared_ptr<mpi::Datatype> getRecvDatatype ( IBlock * block, const stencil::Direction dir )
+   {
+      return make_shared<mpi::Datatype>( mpiDatatypeGhostLayerOnlyXYZ(
+         *getField( block ), uint_t( 1 ), dir, false, getOptimizedCommunicationIndices( stencil::inverseDir[dir] ) ) );
+   }
+
+   virtual void * getSendPointer( IBlock * block, const stencil::Direction )
+   {
+      return getField(block)->data();
+   }
+
+   virtual void * getRecvPointer( IBlock * block, const stencil::Direction )
+   {
+      return getField(block)->data();
+   }
+
+private:
+
+   inline static std::set< cell_idx_t > getOptimizedCommunicationIndices( const stencil::Direction dir )
+   {
+      std::set< cell_idx_t > result;
+      for( uint_t i = 0; i < Stencil_T::d_per_d_length[dir]; ++i )
+      {
+         result.insert( cell_idx_c( Stencil_T::idx[Stencil_T::d_per_d[dir][i]] ) );
+      }
+
+      return result;
+   }
+
+   GhostLayerField_T * getField( IBlock * block )
+   {
+      GhostLayerField_T * const f = block->getData<GhostLayerField_T>( fieldID_ );
+      WALBERLA_ASSERT_NOT_NULLPTR( f );
+      return f;
+   }
+
+   BlockDataID fieldID_;
+};
+
+
+} // namespace communication
+} // namespace field
+} // namespace walberla
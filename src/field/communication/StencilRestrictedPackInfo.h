@@ -0,0 +1,139 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file StencilRestrictedPackInfo.h
+//! \ingroup field
+//! \brief Packing of fields whose components correspond to the directions of a stencil
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "field/GhostLayerField.h"
+#include "communication/UniformPackInfo.h"
+#include "core/debug/Debug.h"
+#include "stencil/Directions.h"
+
+
+namespace walberla {
+namespace field {
+namespace communication {
+
+
+
+/**
+ * \brief PackInfo for fields whose f-th component belongs to the f-th direction of 'Stencil_T'
+ *
+ * A field::communication::PackInfo has no knowledge about the meaning of the components of a field and therefore
+ * communicates all components of all ghost layers. If the components of the field are associated with the directions
+ * of a stencil (e.g. PDFs that are not stored in an lbm::PdfField), only the components pointing into the direction of
+ * the neighboring block (Stencil_T::d_per_d) are required. This PackInfo communicates only these components of the
+ * innermost ghost layer. For lbm::PdfField, see lbm::PdfFieldPackInfo.
+ *
+ * \ingroup field
+ */
+template< typename GhostLayerField_T, typename Stencil_T >
+class StencilRestrictedPackInfo : public walberla::communication::UniformPackInfo
+{
+public:
+
+   static_assert( GhostLayerField_T::F_SIZE == Stencil_T::Size, "Size of stencil and f size of field have to be equal" );
+
+   StencilRestrictedPackInfo( const BlockDataID & fieldId ) : fieldId_( fieldId ) {}
+   virtual ~StencilRestrictedPackInfo() {}
+
+   bool constantDataExchange() const { return true; }
+   bool threadsafeReceiving()  const { return true; }
+
+   void unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer );
+
+   void communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir );
+
+protected:
+
+   void packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const;
+
+
+
+   const BlockDataID fieldId_;
+};
+
+
+
+template< typename GhostLayerField_T, typename Stencil_T >
+void StencilRestrictedPackInfo< GhostLayerField_T, Stencil_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+   if( Stencil_T::idx[ stencil::inverseDir[dir] ] >= Stencil_T::Size )
+      return;
+
+   GhostLayerField_T * field = receiver->getData< GhostLayerField_T >( fieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( field );
+
+   stencil::Direction packerDirection = stencil::inverseDir[dir];
+
+   for( auto i = field->beginGhostLayerOnlyXYZ( uint_t(1), dir ); i != field->end(); ++i )
+      for( uint_t f = 0; f < Stencil_T::d_per_d_length[packerDirection]; ++f )
+         buffer >> i.getF( Stencil_T::idx[ Stencil_T::d_per_d[packerDirection][f] ] );
+}
+
+
+
+template< typename GhostLayerField_T, typename Stencil_T >
+void StencilRestrictedPackInfo< GhostLayerField_T, Stencil_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
+{
+   if( Stencil_T::idx[dir] >= Stencil_T::Size )
+      return;
+
+   const GhostLayerField_T * sf = sender  ->getData< GhostLayerField_T >( fieldId_ );
+         GhostLayerField_T * rf = receiver->getData< GhostLayerField_T >( fieldId_ );
+
+   WALBERLA_ASSERT_EQUAL( sf->xyzSize(), rf->xyzSize() );
+
+   auto srcIter = sf->beginSliceBeforeGhostLayerXYZ( dir );
+   auto dstIter = rf->beginGhostLayerOnlyXYZ( uint_t(1), stencil::inverseDir[dir] );
+
+   while( srcIter != sf->end() )
+   {
+      for( uint_t f = 0; f < Stencil_T::d_per_d_length[dir]; ++f )
+         dstIter.getF( Stencil_T::idx[ Stencil_T::d_per_d[dir][f] ] ) = srcIter.getF( Stencil_T::idx[ Stencil_T::d_per_d[dir][f] ] );
+
+      ++srcIter;
+      ++dstIter;
+   }
+   WALBERLA_ASSERT( srcIter == sf->end() );
+   WALBERLA_ASSERT( dstIter == rf->end() );
+}
+
+
+
+template< typename GhostLayerField_T, typename Stencil_T >
+void StencilRestrictedPackInfo< GhostLayerField_T, Stencil_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
+{
+   if( Stencil_T::idx[dir] >= Stencil_T::Size )
+      return;
+
+   const GhostLayerField_T * field = sender->getData< GhostLayerField_T >( fieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( field );
+
+   for( auto i = field->beginSliceBeforeGhostLayerXYZ( dir ); i != field->end(); ++i )
+      for( uint_t f = 0; f < Stencil_T::d_per_d_length[dir]; ++f )
+         outBuffer << i.getF( Stencil_T::idx[ Stencil_T::d_per_d[dir][f] ] );
+}
+
+
+
+} // namespace communication
+} // namespace field
+} // namespace walberla
@@ -29,6 +29,14 @@ namespace walberla {
 namespace field {
 namespace communication {
 
+//**********************************************************************************************************************
+/*!
+*   \brief Bufferless communication of all components of the ghost layers of a field
+*
+*   If the components of the field belong to the directions of a stencil (e.g. PDFs), see
+*   StencilRestrictedMPIDatatypeInfo, which only describes the components pointing to the neighbor.
+*/
+//**********************************************************************************************************************
 template<typename GhostLayerField_T>
 class UniformMPIDatatypeInfo : public walberla::communication::UniformMPIDatatypeInfo
 {
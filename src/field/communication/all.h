@@ -26,4 +26,6 @@
 #include "PackInfo.h"
 #include "MPIDatatypes.h"
 #include "ReducePackInfo.h"
+#include "StencilRestrictedMPIDatatypeInfo.h"
+#include "StencilRestrictedPackInfo.h"
 #include "UniformMPIDatatypeInfo.h"
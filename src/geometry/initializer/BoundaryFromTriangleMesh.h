@@ -0,0 +1,90 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BoundaryFromTriangleMesh.h
+//! \ingroup geometry
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "BoundarySetter.h"
+
+#include "geometry/mesh/TriangleMeshBVH.h"
+
+#include "boundary/Boundary.h"
+#include "boundary/BoundaryHandling.h"
+
+#include "core/DataTypes.h"
+
+#include "domain_decomposition/StructuredBlockStorage.h"
+
+
+namespace walberla {
+namespace geometry {
+namespace initializer {
+
+
+
+//*******************************************************************************************************************
+/*! Initializes a boundary handler from a closed triangle mesh
+*   (works for both boundary handlings and boundary handlings collections).
+*
+* All cells whose centers lie inside of the mesh are set. The containment tests are accelerated by the bounding
+* volume hierarchy of the mesh (see TriangleMeshBVH): blocks and cells that are not crossed by the surface are
+* classified with a single test. The tests of the cells of a block are executed in parallel with OpenMP, the
+* boundary handling is modified sequentially afterwards.
+*
+* Additionally, initQValues() computes the wall distances along the lattice links that are needed by boundary
+* conditions for curved walls (e.g. interpolated bounce back).
+*
+* \ingroup geometry
+*/
+//*******************************************************************************************************************
+template <typename BoundaryHandlerT>
+class BoundaryFromTriangleMesh
+{
+public:
+   BoundaryFromTriangleMesh( StructuredBlockStorage & structuredBlockStorage, BlockDataID & boundaryHandlerID );
+
+   void init( const TriangleMeshBVH & mesh, const BoundaryUID & uid, const shared_ptr<BoundaryConfiguration> & bcConfig );
+   void init( const TriangleMeshBVH & mesh, const FlagUID & uid );
+
+   /*************************************************************************************************************//**
+   * Computes the fraction q of the lattice links that lies outside of the mesh
+   *
+   * For every cell (without ghost layers) whose center lies outside of the mesh and every direction d of the stencil,
+   * q(x,y,z,d) is set to the normalized distance from the cell center to the surface along the link to the neighbor
+   * in direction d, if the link is cut by the surface (0 <= q <= 1). All other values are set to -1.
+   *
+   * \param qFieldID   field with Stencil_T::Size values per cell, e.g. GhostLayerField< real_t, Stencil_T::Size >
+   *****************************************************************************************************************/
+   template< typename Stencil_T, typename QField_T >
+   void initQValues( const TriangleMeshBVH & mesh, BlockDataID qFieldID ) const;
+
+protected:
+   void init( const TriangleMeshBVH & mesh, BoundarySetter<BoundaryHandlerT> & boundarySetter );
+
+   StructuredBlockStorage & structuredBlockStorage_;
+   BlockDataID boundaryHandlerID_;
+};
+
+
+
+} // namespace initializer
+} // namespace geometry
+} // namespace walberla
+
+#include "BoundaryFromTriangleMesh.impl.h"
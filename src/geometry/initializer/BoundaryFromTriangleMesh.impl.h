@@ -0,0 +1,161 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BoundaryFromTriangleMesh.impl.h
+//! \ingroup geometry
+//! \brief Implementations for BoundaryFromTriangleMesh
+//
+//======================================================================================================================
+
+
+#include "core/cell/CellInterval.h"
+#include "core/math/Vector3.h"
+
+#include "field/iterators/IteratorMacros.h"
+
+#include <vector>
+
+
+namespace walberla {
+namespace geometry {
+namespace initializer {
+
+
+
+template< typename BoundaryHandlerT >
+BoundaryFromTriangleMesh<BoundaryHandlerT>::BoundaryFromTriangleMesh( StructuredBlockStorage & blocks, BlockDataID & boundaryHandlerID )
+   : structuredBlockStorage_( blocks ),
+     boundaryHandlerID_( boundaryHandlerID )
+{}
+
+
+
+template< typename BoundaryHandlerT >
+void BoundaryFromTriangleMesh<BoundaryHandlerT>::init( const TriangleMeshBVH & mesh, BoundarySetter<BoundaryHandlerT> & boundarySetter )
+{
+   for( auto blockIt = structuredBlockStorage_.begin(); blockIt != structuredBlockStorage_.end(); ++blockIt )
+   {
+      IBlock & block = *blockIt;
+
+      const uint_t level = structuredBlockStorage_.getLevel( block );
+
+      boundarySetter.configure( block, boundaryHandlerID_ );
+      auto ff = boundarySetter.getFlagField();
+      const cell_idx_t gl = cell_idx_c( ff->nrOfGhostLayers() );
+
+      AABB blockBB = block.getAABB();
+      blockBB.extend( Vector3< real_t >( structuredBlockStorage_.dx( level ) * real_c( gl ),
+                                         structuredBlockStorage_.dy( level ) * real_c( gl ),
+                                         structuredBlockStorage_.dz( level ) * real_c( gl ) ) );
+
+      const FastOverlapResult blockOverlap = fastOverlapCheck( mesh, blockBB );
+      if( blockOverlap == COMPLETELY_OUTSIDE )
+         continue;
+      if( blockOverlap == CONTAINED_INSIDE_BODY )
+      {
+         boundarySetter.set( ff->xyzSizeWithGhostLayer() );
+         continue;
+      }
+
+      // containment tests in parallel ...
+
+      const cell_idx_t xSize = cell_idx_c( ff->xSize() ) + cell_idx_t(2) * gl;
+      const cell_idx_t ySize = cell_idx_c( ff->ySize() ) + cell_idx_t(2) * gl;
+      const cell_idx_t zSize = cell_idx_c( ff->zSize() ) + cell_idx_t(2) * gl;
+      std::vector< uint8_t > inside( uint_c( xSize * ySize * zSize ), uint8_t(0) );
+
+      WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ_OMP( ff, gl, omp parallel for schedule(dynamic),
+         const Vector3< real_t > center = structuredBlockStorage_.getBlockLocalCellCenter( block, Cell( x, y, z ) );
+         if( mesh.contains( center ) )
+            inside[ uint_c( ( ( z + gl ) * ySize + ( y + gl ) ) * xSize + ( x + gl ) ) ] = uint8_t(1);
+      )
+
+      // ... modification of the boundary handling in serial
+
+      for( cell_idx_t z = -gl; z < zSize - gl; ++z )
+         for( cell_idx_t y = -gl; y < ySize - gl; ++y )
+            for( cell_idx_t x = -gl; x < xSize - gl; ++x )
+               if( inside[ uint_c( ( ( z + gl ) * ySize + ( y + gl ) ) * xSize + ( x + gl ) ) ] != uint8_t(0) )
+                  boundarySetter.set( x, y, z );
+   }
+}
+
+
+
+template< typename BoundaryHandlerT >
+void BoundaryFromTriangleMesh<BoundaryHandlerT>::init( const TriangleMeshBVH & mesh, const BoundaryUID & uid, const shared_ptr<BoundaryConfiguration> & bcConfig )
+{
+   BoundarySetter<BoundaryHandlerT> boundarySetter;
+   boundarySetter.setBoundaryConfig( uid, bcConfig );
+   init( mesh, boundarySetter );
+}
+
+
+
+template< typename BoundaryHandlerT >
+void BoundaryFromTriangleMesh<BoundaryHandlerT>::init( const TriangleMeshBVH & mesh, const FlagUID & uid )
+{
+   BoundarySetter<BoundaryHandlerT> boundarySetter;
+   boundarySetter.setFlagUID( uid );
+   init( mesh, boundarySetter );
+}
+
+
+
+template< typename BoundaryHandlerT >
+template< typename Stencil_T, typename QField_T >
+void BoundaryFromTriangleMesh<BoundaryHandlerT>::initQValues( const TriangleMeshBVH & mesh, BlockDataID qFieldID ) const
+{
+   for( auto blockIt = structuredBlockStorage_.begin(); blockIt != structuredBlockStorage_.end(); ++blockIt )
+   {
+      IBlock & block = *blockIt;
+
+      QField_T * qField = block.getData< QField_T >( qFieldID );
+      WALBERLA_ASSERT_NOT_NULLPTR( qField );
+
+      qField->setWithGhostLayer( real_t(-1) );
+
+      const uint_t level = structuredBlockStorage_.getLevel( block );
+      const Vector3< real_t > dx( structuredBlockStorage_.dx( level ), structuredBlockStorage_.dy( level ), structuredBlockStorage_.dz( level ) );
+
+      // links can only be cut if the cell center is closer to the surface than the longest link
+      const real_t maxSqLinkLength = dx.sqrLength();
+
+      AABB blockBB = block.getAABB();
+      blockBB.extend( dx );
+      if( !mesh.surfaceMayIntersect( blockBB ) )
+         continue;
+
+      WALBERLA_FOR_ALL_CELLS_XYZ_OMP( qField, omp parallel for schedule(dynamic),
+         const Vector3< real_t > center = structuredBlockStorage_.getBlockLocalCellCenter( block, Cell( x, y, z ) );
+         if( mesh.sqDistance( center ) <= maxSqLinkLength && !mesh.contains( center ) )
+         {
+            for( auto d = Stencil_T::beginNoCenter(); d != Stencil_T::end(); ++d )
+            {
+               const Vector3< real_t > link( real_c( d.cx() ) * dx[0], real_c( d.cy() ) * dx[1], real_c( d.cz() ) * dx[2] );
+               real_t q;
+               if( mesh.intersectRay( center, link, q, real_t(1) ) )
+                  qField->get( x, y, z, d.toIdx() ) = q;
+            }
+         }
+      )
+   }
+}
+
+
+
+} // namespace initializer
+} // namespace geometry
+} // namespace walberla
@@ -22,6 +22,10 @@
 #include "BoundaryFromVoxelFile.h"
 #include "core/mpi/BufferDataTypeExtensions.h"
 #include "core/mpi/BufferSystem.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/Reduce.h"
+
+#include <limits>
 
 
 namespace walberla {
@@ -134,6 +138,225 @@ CellIntervalDataMap readCellIntervalsOnRoot( const std::string & geometryFile,
    return result;
 }
 
+namespace internal {
+
+//**********************************************************************************************************************
+/*! Reads sub-volumes of a voxel file with collective MPI-IO calls
+*
+* Only the root process parses the header of the file. Afterwards, all processes open the file and read their
+* sub-volumes directly: the layout of a sub-volume in the file is described by an MPI subarray datatype, hence the
+* MPI-IO implementation can merge the requests of all processes into few large, aligned file accesses.
+*
+* All member functions are collective and must be called by all processes.
+*/
+//**********************************************************************************************************************
+class CollectiveVoxelFileReader
+{
+public:
+   CollectiveVoxelFileReader( const std::string & geometryFile ) : filename_( geometryFile ), mpiFile_( MPI_FILE_NULL )
+   {
+      std::vector<uint_t> header( 4, uint_t(0) ); // xSize, ySize, zSize, data offset
+      WALBERLA_ROOT_SECTION()
+      {
+         VoxelFileReader<uint8_t> reader( geometryFile );
+         header[0] = reader.xSize();
+         header[1] = reader.ySize();
+         header[2] = reader.zSize();
+         header[3] = reader.dataOffset();
+      }
+      mpi::broadcastObject( header );
+
+      xSize_      = header[0];
+      ySize_      = header[1];
+      zSize_      = header[2];
+      dataOffset_ = header[3];
+
+      if( xSize_ > uint_c( std::numeric_limits<int>::max() ) || ySize_ > uint_c( std::numeric_limits<int>::max() ) ||
+          zSize_ > uint_c( std::numeric_limits<int>::max() ) )
+         WALBERLA_ABORT( "Voxel file \"" << filename_ << "\" is too large for MPI-IO: " << xSize_ << " x " << ySize_ << " x " << zSize_ );
+
+      int result = MPI_File_open( MPIManager::instance()->comm(), const_cast<char*>( filename_.c_str() ), MPI_MODE_RDONLY, MPI_INFO_NULL, &mpiFile_ );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while opening file \"" << filename_ << "\" for reading. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+
+   ~CollectiveVoxelFileReader()
+   {
+      int result = MPI_File_close( &mpiFile_ );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while closing file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+
+   /// Reads the cells of 'cellInterval' (file coordinates) in zyx order. Processes with nothing to read pass an empty interval.
+   void read( const CellInterval & cellInterval, std::vector<uint8_t> & data )
+   {
+      MPI_Datatype fileType;
+      if( cellInterval.empty() )
+      {
+         MPI_Type_contiguous( 0, MPI_BYTE, &fileType );
+         data.clear();
+      }
+      else
+      {
+         WALBERLA_ASSERT_GREATER_EQUAL( cellInterval.xMin(), 0 );
+         WALBERLA_ASSERT_GREATER_EQUAL( cellInterval.yMin(), 0 );
+         WALBERLA_ASSERT_GREATER_EQUAL( cellInterval.zMin(), 0 );
+         WALBERLA_ASSERT_LESS( cellInterval.xMax(), cell_idx_c( xSize_ ) );
+         WALBERLA_ASSERT_LESS( cellInterval.yMax(), cell_idx_c( ySize_ ) );
+         WALBERLA_ASSERT_LESS( cellInterval.zMax(), cell_idx_c( zSize_ ) );
+
+         if( cellInterval.numCells() > uint_c( std::numeric_limits<int>::max() ) )
+            WALBERLA_ABORT( "Reading more than " << std::numeric_limits<int>::max() << " voxels per block from file \"" << filename_ << "\" is not supported!" );
+
+         const int sizes   [] = { int_c( zSize_ ), int_c( ySize_ ), int_c( xSize_ ) };
+         const int subsizes[] = { int_c( cellInterval.zSize() ), int_c( cellInterval.ySize() ), int_c( cellInterval.xSize() ) };
+         const int starts  [] = { int_c( cellInterval.zMin()  ), int_c( cellInterval.yMin()  ), int_c( cellInterval.xMin()  ) };
+
+         MPI_Type_create_subarray( 3, sizes, subsizes, starts, MPI_ORDER_C, MPI_BYTE, &fileType );
+         data.resize( cellInterval.numCells() );
+      }
+      MPI_Type_commit( &fileType );
+
+      int result = MPI_File_set_view( mpiFile_, numeric_cast<MPI_Offset>( dataOffset_ ), MPI_BYTE, fileType, const_cast<char*>( "native" ), MPI_INFO_NULL );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Internal MPI-IO error! MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      result = MPI_File_read_all( mpiFile_, data.empty() ? NULL : &data[0], int_c( data.size() ), MPI_BYTE, MPI_STATUS_IGNORE );
+
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while reading from file \"" << filename_ << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      MPI_Type_free( &fileType );
+   }
+
+private:
+   std::string filename_;
+   MPI_File    mpiFile_;
+
+   uint_t xSize_;
+   uint_t ySize_;
+   uint_t zSize_;
+   uint_t dataOffset_;
+};
+
+
+
+// Reads all cell intervals (global coordinates) and passes the data of every interval to 'store' (functor with
+// signature void( const IBlockID *, const CellInterval &, std::vector<uint8_t> & ) ) directly after it has been read.
+template< typename Store_T >
+void readCellIntervalsCollective( const std::string & geometryFile, const Cell & offset,
+                                  const CellIntervalMap & cellIntervals, Store_T & store )
+{
+   std::vector<uint8_t> data;
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      VoxelFileReader<uint8_t> reader( geometryFile );
+      for( auto ciIt = cellIntervals.begin(); ciIt != cellIntervals.end(); ++ciIt )
+      {
+         CellInterval shifted = ciIt->second;
+         shifted.shift( -offset );
+         reader.read( shifted, data );
+         store( ciIt->first, ciIt->second, data );
+      }
+      return;
+   }
+
+   // all processes have to take part in the same number of collective reads
+   const uint_t numReads = mpi::allReduce( uint_c( cellIntervals.size() ), mpi::MAX, MPIManager::instance()->comm() );
+
+   CollectiveVoxelFileReader reader( geometryFile );
+
+   auto ciIt = cellIntervals.begin();
+   for( uint_t i = uint_t(0); i < numReads; ++i )
+   {
+      if( ciIt != cellIntervals.end() )
+      {
+         CellInterval shifted = ciIt->second;
+         shifted.shift( -offset );
+         reader.read( shifted, data );
+         store( ciIt->first, ciIt->second, data );
+         ++ciIt;
+      }
+      else
+      {
+         reader.read( CellInterval(), data );
+      }
+   }
+}
+
+struct StoreData
+{
+   void operator()( const IBlockID * id, const CellInterval & ci, std::vector<uint8_t> & data )
+   {
+      auto & entry = result[ id ];
+      entry.first = ci;
+      entry.second.swap( data );
+   }
+   CellIntervalDataMap result;
+};
+
+struct StoreRunLengthData
+{
+   void operator()( const IBlockID * id, const CellInterval & ci, std::vector<uint8_t> & data )
+   {
+      auto & entry = result[ id ];
+      entry.first = ci;
+      runLengthEncode( data, entry.second );
+   }
+   CellIntervalRunLengthDataMap result;
+};
+
+} // namespace internal
+
+
+
+//**********************************************************************************************************************
+/*! Reads the data of the given cell intervals (global cell coordinates) from the voxel file, every process reads
+*   its own cell intervals with collective MPI-IO calls (see internal::CollectiveVoxelFileReader).
+*
+*   Collective function, must be called by all processes.
+*/
+//**********************************************************************************************************************
+CellIntervalDataMap readCellIntervalsCollective( const std::string & geometryFile, const Cell & offset,
+                                                 const CellIntervalMap & cellIntervals )
+{
+   internal::StoreData store;
+   internal::readCellIntervalsCollective( geometryFile, offset, cellIntervals, store );
+   return store.result;
+}
+
+//**********************************************************************************************************************
+/*! Same as readCellIntervalsCollective, but the data of each cell interval is run-length encoded directly after it
+*   has been read. Hence, at most the data of one cell interval is stored uncompressed at any time.
+*/
+//**********************************************************************************************************************
+CellIntervalRunLengthDataMap readCellIntervalsCollectiveRunLength( const std::string & geometryFile, const Cell & offset,
+                                                                   const CellIntervalMap & cellIntervals )
+{
+   internal::StoreRunLengthData store;
+   internal::readCellIntervalsCollective( geometryFile, offset, cellIntervals, store );
+   return store.result;
+}
+
+void runLengthEncode( const std::vector<uint8_t> & data, RunLengthData & runs )
+{
+   runs.clear();
+
+   for( auto dataIt = data.begin(); dataIt != data.end(); ++dataIt )
+   {
+      if( runs.empty() || runs.back().first != *dataIt || runs.back().second == std::numeric_limits<uint32_t>::max() )
+         runs.push_back( std::make_pair( *dataIt, uint32_t(1) ) );
+      else
+         ++runs.back().second;
+   }
+
+   RunLengthData( runs ).swap( runs ); // shrink to fit
+}
+
 CellVector findCellsWithFlag( const CellInterval & cellInterval, const std::vector<uint8_t> & data, uint8_t flag )
 {
    WALBERLA_ASSERT_EQUAL( cellInterval.numCells(), data.size() );
@@ -152,6 +375,31 @@ CellVector findCellsWithFlag( const CellInterval & cellInterval, const std::vect
    return result;
 }
 
+CellVector findCellsWithFlag( const CellInterval & cellInterval, const RunLengthData & runs, uint8_t flag )
+{
+   CellVector result;
+
+   const uint_t xSize = cellInterval.xSize();
+   const uint_t ySize = cellInterval.ySize();
+
+   uint_t linearIdx = 0;
+   for( auto runIt = runs.begin(); runIt != runs.end(); ++runIt )
+   {
+      if( runIt->first == flag )
+      {
+         for( uint_t i = linearIdx; i < linearIdx + runIt->second; ++i )
+            result.push_back( cellInterval.xMin() + cell_idx_c(   i               % xSize ),
+                              cellInterval.yMin() + cell_idx_c( ( i / xSize     ) % ySize ),
+                              cellInterval.zMin() + cell_idx_c(   i / ( xSize * ySize ) ) );
+      }
+      linearIdx += runIt->second;
+   }
+
+   WALBERLA_ASSERT_EQUAL( linearIdx, cellInterval.numCells() );
+
+   return result;
+}
+
 
 } // namespace initializer
 } // namespace geometry
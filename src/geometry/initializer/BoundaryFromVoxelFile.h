@@ -59,8 +59,12 @@ struct IBlockIDPtrCompare {
    bool operator()( const IBlockID * lhs, const IBlockID * rhs ) const;
 };
 
+/// Run-length encoded voxel data: sequence of ( value, number of consecutive cells with this value ) in zyx order
+typedef std::vector< std::pair<uint8_t, uint32_t> > RunLengthData;
+
 typedef std::map<const IBlockID*, CellInterval, IBlockIDPtrCompare> CellIntervalMap;
 typedef std::map<const IBlockID*, std::pair<CellInterval, std::vector<uint8_t> >, IBlockIDPtrCompare> CellIntervalDataMap;
+typedef std::map<const IBlockID*, std::pair<CellInterval, RunLengthData >, IBlockIDPtrCompare> CellIntervalRunLengthDataMap;
 
 
 //*******************************************************************************************************************
@@ -71,6 +75,9 @@ typedef std::map<const IBlockID*, std::pair<CellInterval, std::vector<uint8_t> >
     file    pathToVoxelFile.dat;
     offset  <5,5,5>;
 
+    collective  true;  // optional, default: true
+    compressed  false; // optional, default: false
+
     Flag
     {
        value 2;
@@ -80,6 +87,14 @@ typedef std::map<const IBlockID*, std::pair<CellInterval, std::vector<uint8_t> >
 }
 \endverbatim
 *
+* With 'collective' enabled, all processes read the sub-volumes of their blocks directly from the file with
+* collective MPI-IO calls (see readCellIntervalsCollective). Otherwise, the root process reads the sub-volumes of
+* all blocks and sends them to the owning processes, which does not scale to large files and many processes.
+*
+* With 'compressed' enabled, the data of each block is run-length encoded directly after it has been read, which
+* drastically reduces the memory required for typical (porous media, CT scan) geometries until the boundary
+* handling is initialized.
+*
 * \ingroup geometry
 */
 //*******************************************************************************************************************
@@ -96,6 +111,10 @@ protected:
 
    CellIntervalMap getIntersectedCellIntervals( const std::string & geometryFile, const Cell & offset ) const;
 
+   template< typename DataMap >
+   void setBoundaries( BlockStorage & blockStorage, std::map<uint8_t, BoundarySetter<BoundaryHandlerT> > & flags,
+                       const DataMap & cellIntervalData ) const;
+
    BlockDataID                    boundaryHandlerID_;
    const StructuredBlockStorage & structuredBlockStorage_;
 };
@@ -106,7 +125,16 @@ protected:
 CellIntervalDataMap readCellIntervalsOnRoot( const std::string & geometryFile, const Cell & offset,
                                              const CellIntervalMap & cellIntervals );
 
+CellIntervalDataMap readCellIntervalsCollective( const std::string & geometryFile, const Cell & offset,
+                                                 const CellIntervalMap & cellIntervals );
+
+CellIntervalRunLengthDataMap readCellIntervalsCollectiveRunLength( const std::string & geometryFile, const Cell & offset,
+                                                                   const CellIntervalMap & cellIntervals );
+
+void runLengthEncode( const std::vector<uint8_t> & data, RunLengthData & runs );
+
 CellVector findCellsWithFlag( const CellInterval & cellInterval, const std::vector<uint8_t> & data, uint8_t flag );
+CellVector findCellsWithFlag( const CellInterval & cellInterval, const RunLengthData & runs, uint8_t flag );
 
 
 } // namespace initializer
@@ -40,8 +40,10 @@ void BoundaryFromVoxelFile<BoundaryHandlerT>::init( BlockStorage & blockStorage,
    auto file   = blockHandle.getParameter<std::string>( "file"   );
    auto offset = blockHandle.getParameter<Cell>       ( "offset" );
 
-   auto cellIntervals    = getIntersectedCellIntervals( file, offset );
-   auto cellIntervalData = readCellIntervalsOnRoot( file, offset, cellIntervals );
+   const bool collective = blockHandle.getParameter<bool>( "collective", true  );
+   const bool compressed = blockHandle.getParameter<bool>( "compressed", false );
+
+   auto cellIntervals = getIntersectedCellIntervals( file, offset );
 
    Config::Blocks configBlocks;
    blockHandle.getBlocks( configBlocks );
@@ -59,6 +61,38 @@ void BoundaryFromVoxelFile<BoundaryHandlerT>::init( BlockStorage & blockStorage,
       }
    }
 
+   if( compressed )
+   {
+      CellIntervalRunLengthDataMap cellIntervalData;
+      if( collective )
+         cellIntervalData = readCellIntervalsCollectiveRunLength( file, offset, cellIntervals );
+      else
+      {
+         CellIntervalDataMap uncompressed = readCellIntervalsOnRoot( file, offset, cellIntervals );
+         for( auto it = uncompressed.begin(); it != uncompressed.end(); ++it )
+         {
+            auto & entry = cellIntervalData[ it->first ];
+            entry.first = it->second.first;
+            runLengthEncode( it->second.second, entry.second );
+            std::vector<uint8_t>().swap( it->second.second );
+         }
+      }
+      setBoundaries( blockStorage, flags, cellIntervalData );
+   }
+   else
+   {
+      setBoundaries( blockStorage, flags, collective ? readCellIntervalsCollective( file, offset, cellIntervals ) :
+                                                       readCellIntervalsOnRoot    ( file, offset, cellIntervals ) );
+   }
+}
+
+
+template <typename BoundaryHandlerT>
+template< typename DataMap >
+void BoundaryFromVoxelFile<BoundaryHandlerT>::setBoundaries( BlockStorage & blockStorage,
+                                                             std::map<uint8_t, BoundarySetter<BoundaryHandlerT> > & flags,
+                                                             const DataMap & cellIntervalData ) const
+{
    for( auto blockIt = blockStorage.begin(); blockIt != blockStorage.end(); ++blockIt )
    {
       auto cellIntervalDataIt = cellIntervalData.find( &(blockIt->getId()) );
@@ -25,6 +25,7 @@
 #include "BoundaryFromCellInterval.h"
 #include "BoundaryFromDomainBorder.h"
 #include "BoundaryFromImage.h"
+#include "BoundaryFromTriangleMesh.h"
 #include "BoundaryFromVoxelFile.h"
 #include "InitializationManager.h"
 #include "Initializer.h"
@@ -0,0 +1,509 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TriangleMeshBVH.cpp
+//! \ingroup geometry
+//
+//======================================================================================================================
+
+#include "TriangleMeshBVH.h"
+
+#include "core/Abort.h"
+#include "core/debug/Debug.h"
+
+#include <algorithm>
+
+
+namespace walberla {
+namespace geometry {
+
+
+
+namespace bvh {
+
+/// Closest point to p on the triangle (a,b,c), see Ericson: Real-Time Collision Detection, section 5.1.5
+static Vector3<real_t> closestPointOnTriangle( const Vector3<real_t> & p, const Vector3<real_t> & a, const Vector3<real_t> & b, const Vector3<real_t> & c )
+{
+   const Vector3<real_t> ab = b - a;
+   const Vector3<real_t> ac = c - a;
+   const Vector3<real_t> ap = p - a;
+
+   const real_t d1 = ab * ap;
+   const real_t d2 = ac * ap;
+   if( d1 <= real_t(0) && d2 <= real_t(0) )
+      return a;
+
+   const Vector3<real_t> bp = p - b;
+   const real_t d3 = ab * bp;
+   const real_t d4 = ac * bp;
+   if( d3 >= real_t(0) && d4 <= d3 )
+      return b;
+
+   const real_t vc = d1 * d4 - d3 * d2;
+   if( vc <= real_t(0) && d1 >= real_t(0) && d3 <= real_t(0) )
+      return a + ( d1 / ( d1 - d3 ) ) * ab;
+
+   const Vector3<real_t> cp = p - c;
+   const real_t d5 = ab * cp;
+   const real_t d6 = ac * cp;
+   if( d6 >= real_t(0) && d5 <= d6 )
+      return c;
+
+   const real_t vb = d5 * d2 - d1 * d6;
+   if( vb <= real_t(0) && d2 >= real_t(0) && d6 <= real_t(0) )
+      return a + ( d2 / ( d2 - d6 ) ) * ac;
+
+   const real_t va = d3 * d6 - d5 * d4;
+   if( va <= real_t(0) && ( d4 - d3 ) >= real_t(0) && ( d5 - d6 ) >= real_t(0) )
+      return b + ( ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) ) ) * ( c - b );
+
+   const real_t denom = real_t(1) / ( va + vb + vc );
+   return a + ( vb * denom ) * ab + ( vc * denom ) * ac;
+}
+
+enum RayTriangleResult { MISS, HIT, DEGENERATE };
+
+/// Intersection of the ray o + t * d with the triangle (a,b,c), see Moeller and Trumbore: Fast, Minimum Storage
+/// Ray/Triangle Intersection. DEGENERATE is returned if the ray hits the triangle close to an edge or a vertex.
+static RayTriangleResult intersectRayTriangle( const Vector3<real_t> & o, const Vector3<real_t> & d,
+                                               const Vector3<real_t> & a, const Vector3<real_t> & b, const Vector3<real_t> & c,
+                                               real_t & t )
+{
+   static const real_t eps = real_t(1e-9);
+
+   const Vector3<real_t> e1 = b - a;
+   const Vector3<real_t> e2 = c - a;
+   const Vector3<real_t> pvec = d % e2;
+   const real_t det = e1 * pvec;
+
+   if( std::fabs( det ) <= eps * e1.length() * e2.length() * d.length() )
+      return MISS; // ray is parallel to the triangle
+
+   const real_t invDet = real_t(1) / det;
+   const Vector3<real_t> tvec = o - a;
+   const real_t u = ( tvec * pvec ) * invDet;
+   if( u < -eps || u > real_t(1) + eps )
+      return MISS;
+
+   const Vector3<real_t> qvec = tvec % e1;
+   const real_t v = ( d * qvec ) * invDet;
+   if( v < -eps || u + v > real_t(1) + eps )
+      return MISS;
+
+   t = ( e2 * qvec ) * invDet;
+
+   if( u < eps || v < eps || u + v > real_t(1) - eps )
+      return DEGENERATE;
+
+   return HIT;
+}
+
+/// Entry and exit parameter of the ray o + t * d into the box, returns false if the ray misses the box
+static bool intersectRayAABB( const Vector3<real_t> & o, const Vector3<real_t> & invD, const AABB & box, real_t & tEnter, real_t & tExit )
+{
+   tEnter = real_t(0);
+   for( uint_t i = 0; i < 3; ++i )
+   {
+      real_t t0 = ( box.min(i) - o[i] ) * invD[i];
+      real_t t1 = ( box.max(i) - o[i] ) * invD[i];
+      if( t0 > t1 )
+         std::swap( t0, t1 );
+      tEnter = std::max( tEnter, t0 );
+      tExit  = std::min( tExit,  t1 );
+   }
+   return tEnter <= tExit;
+}
+
+static Vector3<real_t> inverse( const Vector3<real_t> & d )
+{
+   return Vector3<real_t>( real_t(1) / d[0], real_t(1) / d[1], real_t(1) / d[2] );
+}
+
+/// orders triangles by the coordinate \a axis of their centroids
+class CentroidComparator
+{
+public:
+   CentroidComparator( const std::vector< Vector3<real_t> > & centroids, const uint_t axis ) : centroids_( centroids ), axis_( axis ) {}
+   bool operator()( const TriangleMesh::index_t a, const TriangleMesh::index_t b ) const { return centroids_[a][axis_] < centroids_[b][axis_]; }
+private:
+   const std::vector< Vector3<real_t> > & centroids_;
+   uint_t axis_;
+};
+
+/// maximum depth of the traversal stacks
+static const uint_t MAX_DEPTH = 64;
+
+} // namespace bvh
+
+
+
+TriangleMeshBVH::TriangleMeshBVH( const TriangleMesh & mesh, uint_t maxTrianglesPerLeaf )
+   : mesh_( mesh ), maxTrianglesPerLeaf_( std::max( maxTrianglesPerLeaf, uint_t(1) ) ), depth_( 0 )
+{
+   if( mesh.getNumTriangles() == 0 )
+      WALBERLA_ABORT( "Cannot build a bounding volume hierarchy for a mesh without triangles!" );
+
+   const index_t numTriangles = TriangleMesh::index_c( mesh.getNumTriangles() );
+
+   std::vector< Vector3<real_t> > centroids( numTriangles );
+   triangles_.resize( numTriangles );
+   for( index_t i = 0; i < numTriangles; ++i )
+   {
+      TriangleMesh::vertex_t v0, v1, v2;
+      mesh.getTriangle( i, v0, v1, v2 );
+      centroids[i] = ( v0 + v1 + v2 ) / real_t(3);
+      triangles_[i] = i;
+   }
+
+   nodes_.reserve( 2 * ( numTriangles / maxTrianglesPerLeaf_ + 1 ) );
+   build( 0, numTriangles, centroids, 1 );
+
+   WALBERLA_CHECK_LESS( depth_, bvh::MAX_DEPTH );
+}
+
+
+
+TriangleMeshBVH::index_t TriangleMeshBVH::build( index_t first, index_t count, std::vector< Vector3<real_t> > & centroids, uint_t depth )
+{
+   depth_ = std::max( depth_, depth );
+
+   const index_t nodeIdx = TriangleMesh::index_c( nodes_.size() );
+   nodes_.push_back( Node() );
+
+   Vector3<real_t> minCorner(  std::numeric_limits<real_t>::max() );
+   Vector3<real_t> maxCorner( -std::numeric_limits<real_t>::max() );
+   Vector3<real_t> minCentroid = minCorner;
+   Vector3<real_t> maxCentroid = maxCorner;
+   for( index_t i = first; i < first + count; ++i )
+   {
+      for( uint8_t j = 0; j < 3; ++j )
+      {
+         const TriangleMesh::vertex_t & v = mesh_.getVertex( mesh_.getVertexIndex( triangles_[i], j ) );
+         for( uint_t k = 0; k < 3; ++k )
+         {
+            minCorner[k] = std::min( minCorner[k], v[k] );
+            maxCorner[k] = std::max( maxCorner[k], v[k] );
+         }
+      }
+      const Vector3<real_t> & c = centroids[ triangles_[i] ];
+      for( uint_t k = 0; k < 3; ++k )
+      {
+         minCentroid[k] = std::min( minCentroid[k], c[k] );
+         maxCentroid[k] = std::max( maxCentroid[k], c[k] );
+      }
+   }
+
+   nodes_[nodeIdx].aabb  = AABB::createFromMinMaxCorner( minCorner, maxCorner );
+   nodes_[nodeIdx].first = first;
+   nodes_[nodeIdx].count = count;
+   nodes_[nodeIdx].right = 0;
+
+   if( count <= maxTrianglesPerLeaf_ )
+      return nodeIdx;
+
+   const Vector3<real_t> extent = maxCentroid - minCentroid;
+   uint_t axis = 0;
+   if( extent[1] > extent[axis] ) axis = 1;
+   if( extent[2] > extent[axis] ) axis = 2;
+
+   const index_t mid = first + count / 2;
+   std::nth_element( triangles_.begin() + first, triangles_.begin() + mid, triangles_.begin() + first + count,
+                     bvh::CentroidComparator( centroids, axis ) );
+
+   nodes_[nodeIdx].count = 0;
+   build( first, mid - first, centroids, depth + 1 );
+   const index_t right = build( mid, first + count - mid, centroids, depth + 1 );
+   nodes_[nodeIdx].right = right;
+
+   return nodeIdx;
+}
+
+
+
+real_t TriangleMeshBVH::sqDistance( const Vector3<real_t> & point, Vector3<real_t> * closestPoint, size_t * triangle ) const
+{
+   real_t best = std::numeric_limits<real_t>::max();
+   Vector3<real_t> bestPoint;
+   index_t bestTriangle = 0;
+
+   index_t stack[ bvh::MAX_DEPTH ];
+   uint_t stackSize = 0;
+   stack[ stackSize++ ] = 0;
+
+   while( stackSize > 0 )
+   {
+      const Node & node = nodes_[ stack[ --stackSize ] ];
+      if( node.aabb.sqDistance( point ) >= best )
+         continue;
+
+      if( node.count > 0 )
+      {
+         for( index_t i = node.first; i < node.first + node.count; ++i )
+         {
+            TriangleMesh::vertex_t v0, v1, v2;
+            mesh_.getTriangle( triangles_[i], v0, v1, v2 );
+            const Vector3<real_t> p = bvh::closestPointOnTriangle( point, v0, v1, v2 );
+            const real_t sqDist = ( p - point ).sqrLength();
+            if( sqDist < best )
+            {
+               best = sqDist;
+               bestPoint = p;
+               bestTriangle = triangles_[i];
+            }
+         }
+      }
+      else
+      {
+         // the nearer child is visited first
+         const index_t left  = static_cast<index_t>( &node - &nodes_.front() ) + 1;
+         const index_t right = node.right;
+         if( nodes_[left].aabb.sqDistance( point ) < nodes_[right].aabb.sqDistance( point ) )
+         {
+            stack[ stackSize++ ] = right;
+            stack[ stackSize++ ] = left;
+         }
+         else
+         {
+            stack[ stackSize++ ] = left;
+            stack[ stackSize++ ] = right;
+         }
+      }
+   }
+
+   if( closestPoint != NULL )
+      *closestPoint = bestPoint;
+   if( triangle != NULL )
+      *triangle = bestTriangle;
+
+   return best;
+}
+
+
+
+real_t TriangleMeshBVH::signedDistance( const Vector3<real_t> & point ) const
+{
+   const real_t d = distance( point );
+   return contains( point ) ? -d : d;
+}
+
+
+
+bool TriangleMeshBVH::contains( const Vector3<real_t> & point ) const
+{
+   if( !getAABB().contains( point ) )
+      return false;
+
+   // The parity of the number of intersections of a ray with the surface decides whether the point is inside. Rays
+   // in "arbitrary" directions are used, since axis-parallel rays often hit the edges of (structured) meshes exactly.
+   // If a ray hits an edge or a vertex, the next direction is tried.
+   static const Vector3<real_t> directions[] = { Vector3<real_t>( real_t( 0.5719), real_t( 0.6298), real_t(0.5257) ),
+                                                 Vector3<real_t>( real_t(-0.4741), real_t( 0.3927), real_t(0.7880) ),
+                                                 Vector3<real_t>( real_t( 0.3212), real_t(-0.8710), real_t(0.3716) ) };
+   uint_t count = 0;
+   for( uint_t i = 0; i < 3; ++i )
+   {
+      if( countIntersections( point, directions[i], count ) )
+         break;
+   }
+
+   return count % 2 == 1;
+}
+
+
+
+bool TriangleMeshBVH::countIntersections( const Vector3<real_t> & origin, const Vector3<real_t> & direction, uint_t & count ) const
+{
+   const Vector3<real_t> invDirection = bvh::inverse( direction );
+
+   count = 0;
+   bool valid = true;
+
+   index_t stack[ bvh::MAX_DEPTH ];
+   uint_t stackSize = 0;
+   stack[ stackSize++ ] = 0;
+
+   while( stackSize > 0 )
+   {
+      const index_t nodeIdx = stack[ --stackSize ];
+      const Node & node = nodes_[ nodeIdx ];
+
+      real_t tEnter;
+      real_t tExit = std::numeric_limits<real_t>::max();
+      if( !bvh::intersectRayAABB( origin, invDirection, node.aabb, tEnter, tExit ) )
+         continue;
+
+      if( node.count > 0 )
+      {
+         for( index_t i = node.first; i < node.first + node.count; ++i )
+         {
+            TriangleMesh::vertex_t v0, v1, v2;
+            mesh_.getTriangle( triangles_[i], v0, v1, v2 );
+            real_t t;
+            const bvh::RayTriangleResult result = bvh::intersectRayTriangle( origin, direction, v0, v1, v2, t );
+            if( result == bvh::MISS || t < real_t(0) )
+               continue;
+            if( result == bvh::DEGENERATE )
+               valid = false;
+            ++count;
+         }
+      }
+      else
+      {
+         stack[ stackSize++ ] = nodeIdx + 1;
+         stack[ stackSize++ ] = node.right;
+      }
+   }
+
+   return valid;
+}
+
+
+
+bool TriangleMeshBVH::intersectRay( const Vector3<real_t> & origin, const Vector3<real_t> & direction, real_t & t,
+                                    real_t tMax, size_t * triangle ) const
+{
+   const Vector3<real_t> invDirection = bvh::inverse( direction );
+
+   bool hit = false;
+
+   index_t stack[ bvh::MAX_DEPTH ];
+   uint_t stackSize = 0;
+   stack[ stackSize++ ] = 0;
+
+   while( stackSize > 0 )
+   {
+      const index_t nodeIdx = stack[ --stackSize ];
+      const Node & node = nodes_[ nodeIdx ];
+
+      real_t tEnter;
+      real_t tExit = tMax;
+      if( !bvh::intersectRayAABB( origin, invDirection, node.aabb, tEnter, tExit ) )
+         continue;
+
+      if( node.count > 0 )
+      {
+         for( index_t i = node.first; i < node.first + node.count; ++i )
+         {
+            TriangleMesh::vertex_t v0, v1, v2;
+            mesh_.getTriangle( triangles_[i], v0, v1, v2 );
+            real_t tTriangle;
+            if( bvh::intersectRayTriangle( origin, direction, v0, v1, v2, tTriangle ) == bvh::MISS )
+               continue;
+            if( tTriangle < real_t(0) || tTriangle > tMax )
+               continue;
+
+            // later intersections are only searched in front of this one
+            tMax = tTriangle;
+            hit = true;
+            if( triangle != NULL )
+               *triangle = triangles_[i];
+         }
+      }
+      else
+      {
+         stack[ stackSize++ ] = nodeIdx + 1;
+         stack[ stackSize++ ] = node.right;
+      }
+   }
+
+   if( hit )
+      t = tMax;
+
+   return hit;
+}
+
+
+
+bool TriangleMeshBVH::surfaceMayIntersect( const AABB & box ) const
+{
+   index_t stack[ bvh::MAX_DEPTH ];
+   uint_t stackSize = 0;
+   stack[ stackSize++ ] = 0;
+
+   while( stackSize > 0 )
+   {
+      const index_t nodeIdx = stack[ --stackSize ];
+      const Node & node = nodes_[ nodeIdx ];
+
+      if( !node.aabb.intersectsClosedInterval( box ) )
+         continue;
+
+      if( node.count > 0 )
+      {
+         for( index_t i = node.first; i < node.first + node.count; ++i )
+         {
+            TriangleMesh::vertex_t v0, v1, v2;
+            mesh_.getTriangle( triangles_[i], v0, v1, v2 );
+            bool separated = false;
+            for( uint_t k = 0; k < 3 && !separated; ++k )
+            {
+               separated = std::max( v0[k], std::max( v1[k], v2[k] ) ) < box.min(k) ||
+                           std::min( v0[k], std::min( v1[k], v2[k] ) ) > box.max(k);
+            }
+            if( !separated )
+               return true;
+         }
+      }
+      else
+      {
+         stack[ stackSize++ ] = nodeIdx + 1;
+         stack[ stackSize++ ] = node.right;
+      }
+   }
+
+   return false;
+}
+
+
+
+
+//===================================================================================================================
+//
+//  Body concept implementation
+//
+//===================================================================================================================
+
+
+template<>
+FastOverlapResult fastOverlapCheck ( const TriangleMeshBVH & mesh, const AABB & box )
+{
+   if( !mesh.getAABB().intersects( box ) )
+      return COMPLETELY_OUTSIDE;
+
+   // if the surface does not cross the box, the box is either completely inside or completely outside
+   if( !mesh.surfaceMayIntersect( box ) )
+      return mesh.contains( box.center() ) ? CONTAINED_INSIDE_BODY : COMPLETELY_OUTSIDE;
+
+   return DONT_KNOW;
+}
+
+template<>
+FastOverlapResult fastOverlapCheck ( const TriangleMeshBVH & mesh, const Vector3<real_t> & cellMidpoint, real_t dx )
+{
+   const real_t halfDx = real_t(0.5) * dx;
+   return fastOverlapCheck( mesh, AABB::createFromMinMaxCorner( cellMidpoint[0] - halfDx, cellMidpoint[1] - halfDx, cellMidpoint[2] - halfDx,
+                                                                cellMidpoint[0] + halfDx, cellMidpoint[1] + halfDx, cellMidpoint[2] + halfDx ) );
+}
+
+template<>
+bool contains ( const TriangleMeshBVH & mesh, const Vector3<real_t> & point )
+{
+   return mesh.contains( point );
+}
+
+
+
+} // namespace geometry
+} // namespace walberla
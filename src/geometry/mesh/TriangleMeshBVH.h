@@ -0,0 +1,124 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TriangleMeshBVH.h
+//! \ingroup geometry
+//! \brief Bounding volume hierarchy for distance, ray and containment queries on a TriangleMesh
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "TriangleMesh.h"
+
+#include "geometry/bodies/BodyOverlapFunctions.h"
+
+#include "core/DataTypes.h"
+#include "core/math/AABB.h"
+#include "core/math/Vector3.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+namespace walberla {
+namespace geometry {
+
+
+
+   //*******************************************************************************************************************
+   /*! \brief Axis-aligned bounding box tree over the triangles of a TriangleMesh
+   *
+   *  The tree is built top-down: the triangles of a node are split at the median of their centroids along the
+   *  longest edge of the bounding box of the centroids until at most maxTrianglesPerLeaf triangles are left.
+   *  The nodes are stored depth-first in a single array, the left child of an inner node directly follows its parent.
+   *
+   *  All queries descend only into nodes whose bounding box can still contribute, hence they cost
+   *  O(log(triangles)) for typical meshes instead of O(triangles).
+   *
+   *  The BVH references the mesh, the mesh must not be modified or destroyed as long as the BVH is used.
+   *  Containment and signed distances require a closed (watertight) mesh, the orientation of the triangles is
+   *  not used.
+   *
+   *  Implements the body concept (see BodyOverlapFunctions.h), hence it can directly be used with
+   *  initializer::BoundaryFromBody, initializer::ScalarFieldFromBody etc.
+   *
+   *  \ingroup geometry
+   */
+   //*******************************************************************************************************************
+   class TriangleMeshBVH
+   {
+   public:
+      typedef TriangleMesh::index_t index_t;
+
+      explicit TriangleMeshBVH( const TriangleMesh & mesh, uint_t maxTrianglesPerLeaf = uint_t(4) );
+
+      const TriangleMesh & getMesh()     const { return mesh_; }
+      const AABB &         getAABB()     const { return nodes_.front().aabb; }
+      size_t               getNumNodes() const { return nodes_.size(); }
+      uint_t               getDepth()    const { return depth_; }
+
+      /// Squared distance of \p point to the mesh. Optionally returns the closest point and the index of the closest triangle.
+      real_t sqDistance( const Vector3<real_t> & point, Vector3<real_t> * closestPoint = NULL, size_t * triangle = NULL ) const;
+      real_t distance  ( const Vector3<real_t> & point ) const { return std::sqrt( sqDistance( point ) ); }
+
+      /// Distance of \p point to the mesh, negative if \p point is contained in the mesh
+      real_t signedDistance( const Vector3<real_t> & point ) const;
+
+      /// Tests if \p point lies inside of the (closed) mesh
+      bool contains( const Vector3<real_t> & point ) const;
+
+      /// Nearest intersection of the ray origin + t * direction (0 <= t <= tMax) with the mesh.
+      /// Returns false if there is no intersection, otherwise t and optionally the index of the triangle hit.
+      bool intersectRay( const Vector3<real_t> & origin, const Vector3<real_t> & direction, real_t & t,
+                         real_t tMax = std::numeric_limits<real_t>::max(), size_t * triangle = NULL ) const;
+
+      /// Conservative test if the surface of the mesh intersects \p box: false is exact, true may also be returned
+      /// for boxes that are only close to the surface.
+      bool surfaceMayIntersect( const AABB & box ) const;
+
+   private:
+      struct Node
+      {
+         AABB    aabb;
+         index_t first;  ///< first triangle in triangles_ (leaves only)
+         index_t count;  ///< number of triangles, zero for inner nodes
+         index_t right;  ///< index of the right child (inner nodes only), the left child is the next node
+      };
+
+      index_t build( index_t first, index_t count, std::vector< Vector3<real_t> > & centroids, uint_t depth );
+
+      /// Counts the intersections of the ray with the mesh, returns false if the ray hits an edge or a vertex
+      bool countIntersections( const Vector3<real_t> & origin, const Vector3<real_t> & direction, uint_t & count ) const;
+
+      const TriangleMesh & mesh_;
+      uint_t               maxTrianglesPerLeaf_;
+      uint_t               depth_;
+      std::vector<Node>    nodes_;
+      std::vector<index_t> triangles_; ///< triangle indices of the mesh, sorted by leaves
+   };
+
+
+
+   // Body concept
+   template<> FastOverlapResult fastOverlapCheck ( const TriangleMeshBVH & mesh, const AABB & box );
+   template<> FastOverlapResult fastOverlapCheck ( const TriangleMeshBVH & mesh, const Vector3<real_t> & cellMidpoint, real_t dx );
+   template<> bool contains ( const TriangleMeshBVH & mesh, const Vector3<real_t> & point );
+
+
+
+} // namespace geometry
+} // namespace walberla
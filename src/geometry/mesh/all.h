@@ -24,4 +24,5 @@
 
 #include "TriangleMesh.h"
 #include "TriangleMeshComm.h"
-#include "TriangleMeshIO.h"
\ No newline at end of file
+#include "TriangleMeshIO.h"
+#include "TriangleMeshBVH.h"
\ No newline at end of file
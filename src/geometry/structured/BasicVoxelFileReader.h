@@ -67,6 +67,8 @@ public:
    size_t ySize() const;
    size_t zSize() const;
 
+   size_t dataOffset() const;
+
    void read ( const CellAABB & cellAABB,       std::vector<T> & data ) const;
    void write( const CellAABB & cellAABB, const std::vector<T> & data );
 
@@ -445,6 +445,24 @@ size_t BasicVoxelFileReader<T>::zSize() const
    return zSize_;
 }
 
+/*******************************************************************************************************************//**
+ * \brief Gets the position of the raw data in the geometry file.
+ *
+ * The raw data is stored in zyx order directly after the header, hence the data of cell (x,y,z) starts at byte
+ * dataOffset() + ( z * ySize() * xSize() + y * xSize() + x ) * sizeof(T). This allows other (e.g. parallel) readers
+ * to access the data directly.
+ *
+ * \pre isOpen() == true
+ *
+ * \return The offset of the raw data from the beginning of the file in bytes.
+ **********************************************************************************************************************/
+template<typename T>
+size_t BasicVoxelFileReader<T>::dataOffset() const
+{
+   assert( isOpen() );
+   return static_cast<size_t>( dataBegin_ - std::streampos() );
+}
+
 /*******************************************************************************************************************//**
  * \brief Gets the number of cells of the currently loaded geometry file.
  *
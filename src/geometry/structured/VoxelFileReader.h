@@ -69,6 +69,8 @@ public:
 	uint_t ySize() const;
 	uint_t zSize() const;
 
+	uint_t dataOffset() const;
+
 	void read ( const CellInterval & cellInterval,       std::vector<T> & data ) const;
 	void write( const CellInterval & cellInterval, const std::vector<T> & data );
 private:
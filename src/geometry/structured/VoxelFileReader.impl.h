@@ -254,6 +254,19 @@ uint_t VoxelFileReader<T>::zSize() const
    return uint_c( geometryFile_.zSize() );
 }
 
+/*******************************************************************************************************************//**
+ * \brief Gets the position of the raw data (stored in zyx order) in the geometry file in bytes.
+ *
+ * \pre isOpen() == true
+ *
+ * \return The offset of the raw data from the beginning of the file in bytes.
+ **********************************************************************************************************************/
+template <typename T>
+uint_t VoxelFileReader<T>::dataOffset() const
+{
+   return uint_c( geometryFile_.dataOffset() );
+}
+
 /*******************************************************************************************************************//**
  * \brief Reads a block of data from the opened geometry file.
  *
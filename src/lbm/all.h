@@ -34,6 +34,7 @@
 #include "geometry/all.h"
 #include "gui/all.h"
 #include "lattice_model/all.h"
+#include "list/all.h"
 #include "refinement/all.h"
 #include "sweeps/all.h"
 #include "vtk/all.h"
@@ -0,0 +1,242 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlacePdfFieldPackInfo.h
+//! \ingroup lbm
+//! \brief PackInfo for PDF fields that are updated with the in-place (AA pattern) sweep
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/field/PdfField.h"
+#include "lbm/sweeps/InPlaceTimestep.h"
+#include "communication/UniformPackInfo.h"
+#include "core/cell/CellInterval.h"
+#include "core/debug/Debug.h"
+#include "stencil/Directions.h"
+
+#include <algorithm>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+/**
+ * \brief PackInfo for PDF fields that are updated with lbm::InPlaceSweep
+ *
+ * Must be executed before the in-place sweep and before the InPlaceTimestep object is advanced (see documentation of
+ * lbm::InPlaceSweep).
+ *
+ * - Before an even time step, the cells next to the block border pull the post-collision values of the neighbor
+ *   block from the ghost layer. These values are copied from the interior of the sender into the ghost layer of the
+ *   receiver (the usual ghost layer exchange).
+ * - Before an odd time step, the values that were streamed across the block border during the last (even) time step
+ *   are stored in the ghost layer of the sender. They are copied from the ghost layer of the sender into the interior
+ *   of the receiver.
+ *
+ * For every direction, only those components and cells are communicated that are actually read/written during the
+ * in-place update. Hence, the message sizes are the same as for PdfFieldPackInfo.
+ *
+ * \ingroup lbm
+ */
+template< typename LatticeModel_T >
+class InPlacePdfFieldPackInfo : public walberla::communication::UniformPackInfo
+{
+public:
+
+   typedef PdfField<LatticeModel_T>          PdfField_T;
+   typedef typename LatticeModel_T::Stencil  Stencil;
+
+   InPlacePdfFieldPackInfo( const BlockDataID & pdfFieldId, const shared_ptr< InPlaceTimestep > & timestep ) :
+      pdfFieldId_( pdfFieldId ), timestep_( timestep ) { WALBERLA_ASSERT_NOT_NULLPTR( timestep_ ); }
+   virtual ~InPlacePdfFieldPackInfo() {}
+
+   bool constantDataExchange() const { return true; }
+   bool threadsafeReceiving()  const { return true; }
+
+   void unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer );
+
+   void communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir );
+
+protected:
+
+   void packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const;
+
+   /// Cells of the ghost layer in direction 'ghostDir' that hold values of component 'f' which are read/written by
+   /// the interior cells during an even time step ('f' points away from the ghost layer)
+   static CellInterval ghostInterval( const PdfField_T * const field, const stencil::Direction ghostDir, const stencil::Direction f );
+
+   /// The cells of the block in direction 'ghostDir' that correspond to 'ghostInterval( field, ghostDir, f )'
+   static CellInterval interiorInterval( const PdfField_T * const field, const stencil::Direction ghostDir, const stencil::Direction f );
+
+
+
+   const BlockDataID pdfFieldId_;
+
+   shared_ptr< InPlaceTimestep > timestep_;
+};
+
+
+
+template< typename LatticeModel_T >
+CellInterval InPlacePdfFieldPackInfo< LatticeModel_T >::ghostInterval( const PdfField_T * const field, const stencil::Direction ghostDir,
+                                                                       const stencil::Direction f )
+{
+   const cell_idx_t size[] = { cell_idx_c( field->xSize() ), cell_idx_c( field->ySize() ), cell_idx_c( field->zSize() ) };
+   const int        cdir[] = { stencil::cx[ghostDir], stencil::cy[ghostDir], stencil::cz[ghostDir] };
+   const int        cf  [] = { stencil::cx[f], stencil::cy[f], stencil::cz[f] };
+
+   CellInterval ci;
+   for( uint_t i = 0; i != 3; ++i )
+   {
+      cell_idx_t lo = ( cdir[i] == 1 ) ? size[i] : ( ( cdir[i] == -1 ) ? cell_idx_t(-1) : cell_idx_t(0) );
+      cell_idx_t hi = ( cdir[i] == 1 ) ? size[i] : ( ( cdir[i] == -1 ) ? cell_idx_t(-1) : size[i] - cell_idx_t(1) );
+
+      // the cell that reads from (or streams into) the ghost layer cell must be an interior cell
+      lo = std::max( lo, - cell_idx_c( cf[i] ) );
+      hi = std::min( hi, size[i] - cell_idx_t(1) - cell_idx_c( cf[i] ) );
+
+      ci.min()[i] = lo;
+      ci.max()[i] = hi;
+   }
+   return ci;
+}
+
+
+
+template< typename LatticeModel_T >
+CellInterval InPlacePdfFieldPackInfo< LatticeModel_T >::interiorInterval( const PdfField_T * const field, const stencil::Direction ghostDir,
+                                                                          const stencil::Direction f )
+{
+   CellInterval ci = ghostInterval( field, ghostDir, f );
+   ci.shift( - cell_idx_c( stencil::cx[ghostDir] ) * cell_idx_c( field->xSize() ),
+             - cell_idx_c( stencil::cy[ghostDir] ) * cell_idx_c( field->ySize() ),
+             - cell_idx_c( stencil::cz[ghostDir] ) * cell_idx_c( field->zSize() ) );
+   return ci;
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+   if( Stencil::idx[ stencil::inverseDir[dir] ] >= Stencil::Size )
+      return;
+
+   PdfField_T * pdfField = receiver->getData< PdfField_T >( pdfFieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+   WALBERLA_ASSERT_GREATER_EQUAL( pdfField->nrOfGhostLayers(), 1 );
+
+   if( timestep_->isEven() )
+   {
+      // interior of sender -> ghost layer of receiver
+      const stencil::Direction ghostDir = dir;
+      for( uint_t i = 0; i < Stencil::d_per_d_length[ stencil::inverseDir[ghostDir] ]; ++i )
+      {
+         const stencil::Direction f = Stencil::d_per_d[ stencil::inverseDir[ghostDir] ][i];
+         const CellInterval ci = ghostInterval( pdfField, ghostDir, f );
+         for( auto cell = ci.begin(); cell != ci.end(); ++cell )
+            buffer >> pdfField->get( *cell, cell_idx_c( Stencil::idx[f] ) );
+      }
+   }
+   else
+   {
+      // ghost layer of sender -> interior of receiver
+      const stencil::Direction ghostDir = stencil::inverseDir[dir];
+      for( uint_t i = 0; i < Stencil::d_per_d_length[dir]; ++i )
+      {
+         const stencil::Direction f = Stencil::d_per_d[dir][i];
+         const CellInterval ci = interiorInterval( pdfField, ghostDir, f );
+         for( auto cell = ci.begin(); cell != ci.end(); ++cell )
+            buffer >> pdfField->get( *cell, cell_idx_c( Stencil::idx[f] ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const PdfField_T * sf = sender  ->getData< PdfField_T >( pdfFieldId_ );
+         PdfField_T * rf = receiver->getData< PdfField_T >( pdfFieldId_ );
+
+   WALBERLA_ASSERT_NOT_NULLPTR( sf );
+   WALBERLA_ASSERT_NOT_NULLPTR( rf );
+   WALBERLA_ASSERT_EQUAL( sf->xyzSize(), rf->xyzSize() );
+
+   const bool even = timestep_->isEven();
+
+   // even: ghost layer of the receiver, odd: ghost layer of the sender
+   const stencil::Direction ghostDir = even ? stencil::inverseDir[dir] : dir;
+
+   for( uint_t i = 0; i < Stencil::d_per_d_length[ stencil::inverseDir[ghostDir] ]; ++i )
+   {
+      const stencil::Direction f = Stencil::d_per_d[ stencil::inverseDir[ghostDir] ][i];
+      const cell_idx_t fIdx = cell_idx_c( Stencil::idx[f] );
+
+      const CellInterval   ghost =    ghostInterval( sf, ghostDir, f );
+      const CellInterval interior = interiorInterval( sf, ghostDir, f );
+
+      const CellInterval & src = even ? interior : ghost;
+      const CellInterval & dst = even ? ghost : interior;
+
+      WALBERLA_ASSERT_EQUAL( src.numCells(), dst.numCells() );
+
+      auto srcCell = src.begin();
+      auto dstCell = dst.begin();
+      while( srcCell != src.end() )
+      {
+         rf->get( *dstCell, fIdx ) = sf->get( *srcCell, fIdx );
+         ++srcCell;
+         ++dstCell;
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void InPlacePdfFieldPackInfo< LatticeModel_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const PdfField_T * pdfField = sender->getData< PdfField_T >( pdfFieldId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+   WALBERLA_ASSERT_GREATER_EQUAL( pdfField->nrOfGhostLayers(), 1 );
+
+   const bool even = timestep_->isEven();
+   const stencil::Direction ghostDir = even ? stencil::inverseDir[dir] : dir;
+
+   for( uint_t i = 0; i < Stencil::d_per_d_length[ stencil::inverseDir[ghostDir] ]; ++i )
+   {
+      const stencil::Direction f = Stencil::d_per_d[ stencil::inverseDir[ghostDir] ][i];
+      const CellInterval ci = even ? interiorInterval( pdfField, ghostDir, f ) : ghostInterval( pdfField, ghostDir, f );
+      for( auto cell = ci.begin(); cell != ci.end(); ++cell )
+         outBuffer << pdfField->get( *cell, cell_idx_c( Stencil::idx[f] ) );
+   }
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "InPlacePdfFieldPackInfo.h"
 #include "PdfFieldMPIDatatypeInfo.h"
 #include "PdfFieldPackInfo.h"
 
@@ -90,7 +90,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
    const real_t omega_trm10( real_t(1.0) - omega10 );
   
    
-   WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( interval,
 
       using namespace stencil;
 
@@ -471,7 +471,7 @@ WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( WALBERLA_LBM_CELLWISE_SWEEP_SPE
 	 
       }
 
-   ) // WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( src, numberOfGhostLayersToInclude,
+   ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_XYZ( interval,
    
 }
 WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT()
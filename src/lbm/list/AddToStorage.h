@@ -0,0 +1,114 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AddToStorage.h
+//! \ingroup lbm
+//! \brief Functions for adding a lbm::List to the block storage
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "List.h"
+
+#include "core/debug/CheckFunctions.h"
+#include "core/uid/SUID.h"
+#include "domain_decomposition/StructuredBlockStorage.h"
+#include "field/FlagField.h"
+
+#include <string>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+namespace internal {
+
+template< typename LatticeModel_T, typename FlagField_T >
+class ListCreator
+{
+public:
+
+   ListCreator( const LatticeModel_T & latticeModel, const ConstBlockDataID & flagFieldId, const Set< FlagUID > & fluid,
+                const Vector3< real_t > & initialVelocity, const real_t initialDensity ) :
+      latticeModel_( latticeModel ), flagFieldId_( flagFieldId ), fluid_( fluid ),
+      initialVelocity_( initialVelocity ), initialDensity_( initialDensity ) {}
+
+   List< LatticeModel_T > * operator()( IBlock * const block, StructuredBlockStorage * const storage ) const
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( block );
+      WALBERLA_ASSERT_NOT_NULLPTR( storage );
+
+      const FlagField_T * flagField = block->getData< const FlagField_T >( flagFieldId_ );
+      WALBERLA_CHECK_NOT_NULLPTR( flagField );
+
+      typename FlagField_T::flag_t fluidMask( 0 );
+      for( auto flag = fluid_.begin(); flag != fluid_.end(); ++flag )
+         if( flagField->flagExists( *flag ) )
+            fluidMask = static_cast< typename FlagField_T::flag_t >( fluidMask | flagField->getFlag( *flag ) );
+
+      LatticeModel_T latticeModel( latticeModel_ );
+      latticeModel.configure( *block, *storage );
+
+      List< LatticeModel_T > * list = new List< LatticeModel_T >( latticeModel, *flagField, fluidMask );
+
+      for( uint_t i = 0; i != list->numCells(); ++i )
+         list->setDensityAndVelocity( typename List< LatticeModel_T >::index_t( i ), initialVelocity_, initialDensity_ );
+
+      return list;
+   }
+
+private:
+
+   LatticeModel_T latticeModel_;
+   ConstBlockDataID flagFieldId_;
+   Set< FlagUID > fluid_;
+
+   Vector3< real_t > initialVelocity_;
+   real_t initialDensity_;
+};
+
+} // namespace internal
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Adds a lbm::List to every block that contains all cells that are marked with one of the 'fluid' flags
+*
+*   The flag field must be fully initialized (including its ghost layer) before this function is called. The PDFs
+*   of all fluid cells are initialized with the equilibrium for 'initialVelocity' and 'initialDensity'. The list is
+*   not rebuilt if the flag field changes afterwards.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename FlagField_T >
+BlockDataID addListToStorage( const shared_ptr< StructuredBlockStorage > & blocks, const std::string & identifier,
+                              const LatticeModel_T & latticeModel, const ConstBlockDataID & flagFieldId, const Set< FlagUID > & fluid,
+                              const Vector3< real_t > & initialVelocity = Vector3< real_t >(), const real_t initialDensity = real_t(1),
+                              const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                              const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() )
+{
+   return blocks->addStructuredBlockData< List< LatticeModel_T > >(
+            internal::ListCreator< LatticeModel_T, FlagField_T >( latticeModel, flagFieldId, fluid, initialVelocity, initialDensity ),
+            identifier, requiredSelectors, incompatibleSelectors );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -0,0 +1,298 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file List.h
+//! \ingroup lbm
+//! \brief Sparse (list-based) storage of the PDFs of all fluid cells of a block
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/lattice_model/EquilibriumDistribution.h"
+#include "lbm/sweeps/LocalCollision.h"
+
+#include "core/DataTypes.h"
+#include "core/cell/Cell.h"
+#include "core/cell/CellInterval.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/debug/Debug.h"
+#include "core/math/Vector3.h"
+
+#include "stencil/D3Q27.h"
+#include "stencil/Directions.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Block data that stores the PDFs of the fluid cells of a block in a compact list
+*
+*   For geometries with a low fluid fraction (porous media, packed beds, ...), a PdfField wastes most of its memory and
+*   bandwidth on solid cells, and the sweeps still have to check the flag of every cell. A List only stores the fluid
+*   cells of a block:
+*   - The fluid cells of the block interior come first (index 0 to numFluidCells()-1), followed by the fluid cells in
+*     the (single) ghost layer (index numFluidCells() to numCells()-1). Both parts are ordered like the field
+*     iterators (x fastest, z slowest).
+*   - The PDFs are stored as structure of arrays: value f of cell i is located at position f * fStride() + i.
+*   - For every interior fluid cell i and every direction f, the pull index table stores the position of the value
+*     that is streamed into (i,f). If the neighbor in direction -f is not a fluid cell, the position of value inv(f) of
+*     cell i itself is stored instead, i.e., all non-fluid cells act as no slip walls (half-way bounce back, equivalent
+*     to lbm::NoSlip). The stream & collide kernel (see ListSweep) therefore does not need any flags or boundary
+*     handling.
+*
+*   Memory and run time scale with the number of fluid cells. A List is created from a flag field (see
+*   addListToStorage in 'AddToStorage.h'). The flags in the ghost layer of the flag field must already be set, since
+*   the ghost fluid cells are needed for communication (see ListPackInfo).
+*
+*   Only works with lattice models without force model, the collision is performed by internal::LocalCollision
+*   (SRT and TRT).
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T >
+class List
+{
+public:
+
+   typedef LatticeModel_T                     LatticeModel;
+   typedef typename LatticeModel_T::Stencil   Stencil;
+   typedef uint32_t                           index_t;
+
+   static const index_t INVALID_IDX = std::numeric_limits< index_t >::max();
+
+   template< typename FlagField_T >
+   List( const LatticeModel_T & latticeModel, const FlagField_T & flagField, const typename FlagField_T::flag_t fluidMask );
+
+   bool operator==( const List & rhs ) const { return cells_ == rhs.cells_ && pdfs_ == rhs.pdfs_; }
+
+   const LatticeModel_T & latticeModel() const { return latticeModel_; }
+         LatticeModel_T & latticeModel()       { return latticeModel_; }
+
+   /// number of fluid cells in the interior of the block
+   uint_t numFluidCells() const { return numFluidCells_; }
+   /// number of fluid cells in the interior and in the ghost layer of the block
+   uint_t numCells() const { return cells_.size(); }
+
+   uint_t fStride() const { return cells_.size(); }
+
+   const Cell & getCell( const index_t idx ) const { WALBERLA_ASSERT_LESS( idx, cells_.size() ); return cells_[ idx ]; }
+
+   /// returns INVALID_IDX if 'cell' is not a fluid cell (interior or ghost layer)
+   index_t getIdx( const Cell & cell ) const;
+   bool isFluidCell( const Cell & cell ) const { return getIdx( cell ) != INVALID_IDX; }
+
+         real_t & get( const index_t idx, const uint_t f )       { return pdfs_[ f * fStride() + idx ]; }
+   const real_t & get( const index_t idx, const uint_t f ) const { return pdfs_[ f * fStride() + idx ]; }
+
+         real_t * getPdfs()          { return pdfs_.empty() ? NULL : &pdfs_[0]; }
+   const real_t * getPdfs()    const { return pdfs_.empty() ? NULL : &pdfs_[0]; }
+         real_t * getTmpPdfs()       { return tmpPdfs_.empty() ? NULL : &tmpPdfs_[0]; }
+
+   /// the pull index table of direction f, contains numFluidCells() entries
+   const index_t * getPullIdx( const uint_t f ) const { return pullIdx_.empty() ? NULL : &pullIdx_[ f * numFluidCells_ ]; }
+
+   void swapTmpPdfs() { pdfs_.swap( tmpPdfs_ ); }
+
+   /// interior fluid cells in the slice next to the ghost layer in direction 'dir'
+   const std::vector< index_t > & getSendIdx( const stencil::Direction dir ) const { return sendIdx_[ dir ]; }
+   /// fluid cells in the ghost layer in direction 'dir'
+   const std::vector< index_t > & getRecvIdx( const stencil::Direction dir ) const { return recvIdx_[ dir ]; }
+
+   real_t getDensity( const index_t idx ) const;
+   Vector3< real_t > getVelocity( const index_t idx ) const;
+   real_t getDensityAndVelocity( Vector3< real_t > & velocity, const index_t idx ) const;
+
+   void setDensityAndVelocity( const index_t idx, const Vector3< real_t > & velocity, const real_t rho );
+
+private:
+
+   static bool cellLess( const Cell & lhs, const Cell & rhs )
+   {
+      return ( lhs.z() != rhs.z() ) ? ( lhs.z() < rhs.z() ) : ( ( lhs.y() != rhs.y() ) ? ( lhs.y() < rhs.y() ) : ( lhs.x() < rhs.x() ) );
+   }
+
+   LatticeModel_T latticeModel_;
+
+   uint_t numFluidCells_;
+   std::vector< Cell > cells_;
+
+   std::vector< real_t > pdfs_;
+   std::vector< real_t > tmpPdfs_;
+
+   std::vector< index_t > pullIdx_;
+
+   std::vector< index_t > sendIdx_[ stencil::NR_OF_DIRECTIONS ];
+   std::vector< index_t > recvIdx_[ stencil::NR_OF_DIRECTIONS ];
+};
+
+template< typename LatticeModel_T >
+const typename List< LatticeModel_T >::index_t List< LatticeModel_T >::INVALID_IDX;
+
+
+
+template< typename LatticeModel_T >
+template< typename FlagField_T >
+List< LatticeModel_T >::List( const LatticeModel_T & latticeModel, const FlagField_T & flagField,
+                              const typename FlagField_T::flag_t fluidMask ) :
+   latticeModel_( latticeModel ), numFluidCells_( uint_t(0) )
+{
+   WALBERLA_CHECK_GREATER_EQUAL( flagField.nrOfGhostLayers(), uint_t(1) );
+
+   // collect fluid cells: interior first, then the ghost layer
+
+   CellInterval interior = flagField.xyzSize();
+   CellInterval withGhostLayer = interior;
+   withGhostLayer.expand( cell_idx_t(1) );
+
+   for( cell_idx_t z = interior.zMin(); z <= interior.zMax(); ++z )
+      for( cell_idx_t y = interior.yMin(); y <= interior.yMax(); ++y )
+         for( cell_idx_t x = interior.xMin(); x <= interior.xMax(); ++x )
+            if( flagField.isPartOfMaskSet( x, y, z, fluidMask ) )
+               cells_.push_back( Cell( x, y, z ) );
+
+   numFluidCells_ = cells_.size();
+
+   for( cell_idx_t z = withGhostLayer.zMin(); z <= withGhostLayer.zMax(); ++z )
+      for( cell_idx_t y = withGhostLayer.yMin(); y <= withGhostLayer.yMax(); ++y )
+         for( cell_idx_t x = withGhostLayer.xMin(); x <= withGhostLayer.xMax(); ++x )
+            if( !interior.contains( x, y, z ) && flagField.isPartOfMaskSet( x, y, z, fluidMask ) )
+               cells_.push_back( Cell( x, y, z ) );
+
+   WALBERLA_CHECK_LESS( cells_.size(), uint_c( INVALID_IDX ) );
+
+   pdfs_.assign( Stencil::Size * cells_.size(), real_t(0) );
+   tmpPdfs_.assign( Stencil::Size * cells_.size(), real_t(0) );
+
+   // pull index table
+
+   pullIdx_.resize( Stencil::Size * numFluidCells_ );
+
+   for( index_t i = 0; i < index_t( numFluidCells_ ); ++i )
+   {
+      const Cell & cell = cells_[i];
+      for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+      {
+         const index_t neighbor = getIdx( Cell( cell.x() - d.cx(), cell.y() - d.cy(), cell.z() - d.cz() ) );
+         pullIdx_[ d.toIdx() * numFluidCells_ + i ] = ( neighbor != INVALID_IDX ) ? index_t( d.toIdx()    * fStride() + neighbor ) :
+                                                                                    index_t( d.toInvIdx() * fStride() + i );
+      }
+   }
+
+   // communication lists
+
+   for( auto dir = stencil::D3Q27::beginNoCenter(); dir != stencil::D3Q27::end(); ++dir )
+   {
+      CellInterval sendInterval;
+      flagField.getSliceBeforeGhostLayer( *dir, sendInterval, cell_idx_t(1), false );
+      CellInterval recvInterval;
+      flagField.getGhostRegion( *dir, recvInterval, cell_idx_t(1), false );
+
+      for( cell_idx_t z = sendInterval.zMin(); z <= sendInterval.zMax(); ++z )
+         for( cell_idx_t y = sendInterval.yMin(); y <= sendInterval.yMax(); ++y )
+            for( cell_idx_t x = sendInterval.xMin(); x <= sendInterval.xMax(); ++x )
+            {
+               const index_t idx = getIdx( Cell( x, y, z ) );
+               if( idx != INVALID_IDX )
+                  sendIdx_[ *dir ].push_back( idx );
+            }
+
+      for( cell_idx_t z = recvInterval.zMin(); z <= recvInterval.zMax(); ++z )
+         for( cell_idx_t y = recvInterval.yMin(); y <= recvInterval.yMax(); ++y )
+            for( cell_idx_t x = recvInterval.xMin(); x <= recvInterval.xMax(); ++x )
+            {
+               const index_t idx = getIdx( Cell( x, y, z ) );
+               if( idx != INVALID_IDX )
+                  recvIdx_[ *dir ].push_back( idx );
+            }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+typename List< LatticeModel_T >::index_t List< LatticeModel_T >::getIdx( const Cell & cell ) const
+{
+   // both the interior and the ghost layer part of 'cells_' are sorted
+
+   auto interiorEnd = cells_.begin() + numFluidCells_;
+
+   auto it = std::lower_bound( cells_.begin(), interiorEnd, cell, cellLess );
+   if( it != interiorEnd && *it == cell )
+      return index_t( it - cells_.begin() );
+
+   it = std::lower_bound( interiorEnd, cells_.end(), cell, cellLess );
+   if( it != cells_.end() && *it == cell )
+      return index_t( it - cells_.begin() );
+
+   return INVALID_IDX;
+}
+
+
+
+template< typename LatticeModel_T >
+real_t List< LatticeModel_T >::getDensity( const index_t idx ) const
+{
+   Vector3< real_t > velocity;
+   return getDensityAndVelocity( velocity, idx );
+}
+
+
+
+template< typename LatticeModel_T >
+Vector3< real_t > List< LatticeModel_T >::getVelocity( const index_t idx ) const
+{
+   Vector3< real_t > velocity;
+   getDensityAndVelocity( velocity, idx );
+   return velocity;
+}
+
+
+
+template< typename LatticeModel_T >
+real_t List< LatticeModel_T >::getDensityAndVelocity( Vector3< real_t > & velocity, const index_t idx ) const
+{
+   WALBERLA_ASSERT_LESS( idx, cells_.size() );
+
+   real_t pdfs[ Stencil::Size ];
+   for( uint_t f = 0; f != Stencil::Size; ++f )
+      pdfs[f] = get( idx, f );
+
+   return internal::localDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+}
+
+
+
+template< typename LatticeModel_T >
+void List< LatticeModel_T >::setDensityAndVelocity( const index_t idx, const Vector3< real_t > & velocity, const real_t rho )
+{
+   WALBERLA_ASSERT_LESS( idx, cells_.size() );
+
+   for( auto d = Stencil::begin(); d != Stencil::end(); ++d )
+      get( idx, d.toIdx() ) = EquilibriumDistribution< LatticeModel_T >::get( *d, velocity, rho );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
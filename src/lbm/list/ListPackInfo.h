@@ -0,0 +1,144 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ListPackInfo.h
+//! \ingroup lbm
+//! \brief Pack info for the sparse (list-based) PDF storage
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "List.h"
+
+#include "communication/UniformPackInfo.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/debug/Debug.h"
+#include "stencil/Directions.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+/**
+ * \brief PackInfo for lbm::List (communicates only components pointing to the neighbor, see PdfFieldPackInfo)
+ *
+ * Only the fluid cells of the slice next to the block border are sent, they are received by the fluid cells in the
+ * ghost layer of the neighbor. Therefore, the fluid cells in the ghost layer of the flag field the list was created
+ * from must match the fluid cells of the neighboring block. The number of cells is sent along with the data and
+ * checked upon receiving.
+ *
+ * \ingroup lbm
+ */
+template< typename LatticeModel_T >
+class ListPackInfo : public walberla::communication::UniformPackInfo
+{
+public:
+
+   typedef List< LatticeModel_T >            List_T;
+   typedef typename LatticeModel_T::Stencil  Stencil;
+
+   ListPackInfo( const BlockDataID & listId ) : listId_( listId ) {}
+   virtual ~ListPackInfo() {}
+
+   bool constantDataExchange() const { return true; }
+   bool threadsafeReceiving()  const { return true; }
+
+   void unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer );
+
+   void communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir );
+
+protected:
+
+   void packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const;
+
+
+
+   const BlockDataID listId_;
+};
+
+
+
+template< typename LatticeModel_T >
+void ListPackInfo< LatticeModel_T >::unpackData( IBlock * receiver, stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+   if( Stencil::idx[ stencil::inverseDir[dir] ] >= Stencil::Size )
+      return;
+
+   List_T * list = receiver->getData< List_T >( listId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( list );
+
+   stencil::Direction packerDirection = stencil::inverseDir[dir];
+
+   const auto & recvIdx = list->getRecvIdx( dir );
+
+   uint_t numCells( 0 );
+   buffer >> numCells;
+   WALBERLA_CHECK_EQUAL( numCells, recvIdx.size(), "The fluid cells in the ghost layer of lbm::List do not match the fluid cells of the "
+                                                   "neighboring block (direction " << stencil::dirToString[dir] << ")!" );
+
+   for( auto i = recvIdx.begin(); i != recvIdx.end(); ++i )
+      for( uint_t f = 0; f < Stencil::d_per_d_length[packerDirection]; ++f )
+         buffer >> list->get( *i, Stencil::idx[ Stencil::d_per_d[packerDirection][f] ] );
+}
+
+
+
+template< typename LatticeModel_T >
+void ListPackInfo< LatticeModel_T >::communicateLocal( const IBlock * sender, IBlock * receiver, stencil::Direction dir )
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const List_T * sl = sender  ->getData< List_T >( listId_ );
+         List_T * rl = receiver->getData< List_T >( listId_ );
+
+   const auto & sendIdx = sl->getSendIdx( dir );
+   const auto & recvIdx = rl->getRecvIdx( stencil::inverseDir[dir] );
+
+   WALBERLA_CHECK_EQUAL( sendIdx.size(), recvIdx.size(), "The fluid cells in the ghost layer of lbm::List do not match the fluid cells of the "
+                                                         "neighboring block (direction " << stencil::dirToString[dir] << ")!" );
+
+   for( uint_t i = 0; i != sendIdx.size(); ++i )
+      for( uint_t f = 0; f < Stencil::d_per_d_length[dir]; ++f )
+         rl->get( recvIdx[i], Stencil::idx[ Stencil::d_per_d[dir][f] ] ) = sl->get( sendIdx[i], Stencil::idx[ Stencil::d_per_d[dir][f] ] );
+}
+
+
+
+template< typename LatticeModel_T >
+void ListPackInfo< LatticeModel_T >::packDataImpl( const IBlock * sender, stencil::Direction dir, mpi::SendBuffer & outBuffer ) const
+{
+   if( Stencil::idx[dir] >= Stencil::Size )
+      return;
+
+   const List_T * list = sender->getData< List_T >( listId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( list );
+
+   const auto & sendIdx = list->getSendIdx( dir );
+
+   outBuffer << sendIdx.size();
+
+   for( auto i = sendIdx.begin(); i != sendIdx.end(); ++i )
+      for( uint_t f = 0; f < Stencil::d_per_d_length[dir]; ++f )
+         outBuffer << list->get( *i, Stencil::idx[ Stencil::d_per_d[dir][f] ] );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
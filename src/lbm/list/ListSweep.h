@@ -0,0 +1,126 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ListSweep.h
+//! \ingroup lbm
+//! \brief Stream & collide sweep for the sparse (list-based) PDF storage
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "List.h"
+
+#include "lbm/lattice_model/ForceModel.h"
+#include "lbm/sweeps/LocalCollision.h"
+
+#include "core/OpenMP.h"
+#include "core/debug/Debug.h"
+#include "domain_decomposition/IBlock.h"
+
+#include <boost/type_traits/is_same.hpp>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Stream (pull) & collide sweep that operates on a lbm::List
+*
+*   Only the fluid cells are visited, the neighbors are taken from the pull index table of the list. Walls are treated
+*   as no slip (see lbm::List), no BoundaryHandling and no flag checks are required. Prior to each call, the ghost
+*   layer of the list must be communicated with a ListPackInfo.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T >
+class ListSweep
+{
+public:
+
+   static_assert( (boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >::value), "Only works without additional forces!" );
+
+   typedef List< LatticeModel_T >            List_T;
+   typedef typename LatticeModel_T::Stencil  Stencil_T;
+   typedef typename List_T::index_t          index_t;
+
+   ListSweep( const BlockDataID & listId ) : listId_( listId ) {}
+
+   void operator()( IBlock * const block );
+
+private:
+
+   BlockDataID listId_;
+};
+
+
+
+template< typename LatticeModel_T >
+void ListSweep< LatticeModel_T >::operator()( IBlock * const block )
+{
+   List_T * list = block->getData< List_T >( listId_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( list );
+
+   const auto & lm = list->latticeModel();
+
+   const real_t * WALBERLA_RESTRICT src = list->getPdfs();
+         real_t * WALBERLA_RESTRICT dst = list->getTmpPdfs();
+
+   const index_t * pullIdx[ Stencil_T::Size ];
+   for( uint_t f = 0; f != Stencil_T::Size; ++f )
+      pullIdx[f] = list->getPullIdx( f );
+
+   const uint_t fStride = list->fStride();
+
+   const int numFluidCells = int_c( list->numFluidCells() );
+
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for( int i = 0; i < numFluidCells; ++i )
+   {
+      real_t pdfs[ Stencil_T::Size ];
+
+      for( uint_t f = 0; f != Stencil_T::Size; ++f )
+         pdfs[f] = src[ pullIdx[f][i] ];
+
+      Vector3<real_t> velocity;
+      const real_t rho = internal::localDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+
+      const Cell & cell = list->getCell( index_t( i ) );
+      internal::LocalCollision< LatticeModel_T >::apply( pdfs, lm, cell.x(), cell.y(), cell.z(), velocity, rho );
+
+      for( uint_t f = 0; f != Stencil_T::Size; ++f )
+         dst[ f * fStride + uint_c( i ) ] = pdfs[f];
+   }
+
+   list->swapTmpPdfs();
+}
+
+
+
+template< typename LatticeModel_T >
+shared_ptr< ListSweep< LatticeModel_T > > makeListSweep( const BlockDataID & listId )
+{
+   return make_shared< ListSweep< LatticeModel_T > >( listId );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
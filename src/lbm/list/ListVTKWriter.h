@@ -0,0 +1,104 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ListVTKWriter.h
+//! \ingroup lbm
+//! \brief VTK cell data writers for the sparse (list-based) PDF storage
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "List.h"
+
+#include "core/debug/Debug.h"
+#include "vtk/BlockCellDataWriter.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Writes the velocity of the fluid cells of a lbm::List, all other cells are written as zero
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename OutputType = float >
+class ListVelocityVTKWriter : public vtk::BlockCellDataWriter< OutputType, 3 >
+{
+public:
+
+   typedef List< LatticeModel_T > List_T;
+
+   ListVelocityVTKWriter( const ConstBlockDataID & listId, const std::string & id ) :
+      vtk::BlockCellDataWriter< OutputType, 3 >( id ), bdid_( listId ), list_( NULL ) {}
+
+protected:
+
+   void configure() { WALBERLA_ASSERT_NOT_NULLPTR( this->block_ ); list_ = this->block_->template getData< List_T >( bdid_ ); }
+
+   OutputType evaluate( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const cell_idx_t f )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( list_ );
+      const typename List_T::index_t idx = list_->getIdx( Cell( x, y, z ) );
+      return ( idx == List_T::INVALID_IDX ) ? OutputType(0) : numeric_cast< OutputType >( ( list_->getVelocity( idx ) )[ uint_c(f) ] );
+   }
+
+   const ConstBlockDataID bdid_;
+   const List_T * list_;
+
+}; // class ListVelocityVTKWriter
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Writes the density of the fluid cells of a lbm::List, all other cells are written as zero
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename OutputType = float >
+class ListDensityVTKWriter : public vtk::BlockCellDataWriter< OutputType >
+{
+public:
+
+   typedef List< LatticeModel_T > List_T;
+
+   ListDensityVTKWriter( const ConstBlockDataID & listId, const std::string & id ) :
+      vtk::BlockCellDataWriter< OutputType >( id ), bdid_( listId ), list_( NULL ) {}
+
+protected:
+
+   void configure() { WALBERLA_ASSERT_NOT_NULLPTR( this->block_ ); list_ = this->block_->template getData< List_T >( bdid_ ); }
+
+   OutputType evaluate( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z, const cell_idx_t /*f*/ )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( list_ );
+      const typename List_T::index_t idx = list_->getIdx( Cell( x, y, z ) );
+      return ( idx == List_T::INVALID_IDX ) ? OutputType(0) : numeric_cast< OutputType >( list_->getDensity( idx ) );
+   }
+
+   const ConstBlockDataID bdid_;
+   const List_T * list_;
+
+}; // class ListDensityVTKWriter
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -49,6 +49,8 @@ namespace internal
       c.def( "stream",       &Sweep::stream,        (arg("block"),arg("numberOfGhostLayersToInclude")=uint_t(0) ) )
        .def( "collide",      &Sweep::collide,       (arg("block"),arg("numberOfGhostLayersToInclude")=uint_t(0) ) )
        .def("streamCollide", &Sweep::streamCollide, (arg("block"),arg("numberOfGhostLayersToInclude")=uint_t(0) ) )
+       .def( "inner",        &Sweep::inner,         (arg("block") ) )
+       .def( "outer",        &Sweep::outer,         (arg("block") ) )
        .def("__call__",      &Sweep::operator(),    (arg("block"),arg("numberOfGhostLayersToInclude")=uint_t(0) ) )
       ;
    }
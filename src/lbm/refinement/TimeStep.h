@@ -132,6 +132,18 @@ public:
    bool asynchronousCommunicationIsUsed() const { return asynchronousCommunication_; }
    void asynchronousCommunication( const bool value = true ) { asynchronousCommunication_ = value; }
 
+   /// If pipelined communication is enabled (only has an effect if asynchronous communication is used), the
+   /// communication that a level starts at the end of its time step is only completed after the next coarser level
+   /// has performed its own stream step (see 'pipelinedRecursiveStep').
+   /// Pipelining pays off if the communication of the finer levels is not already hidden by asynchronous communication
+   /// alone, i.e., for inter-node communication with only few cells per block and a large number of refinement levels.
+   /// If the communication is mostly process-local (or the blocks are large), the stream step of the next coarser level
+   /// has nothing left to hide and plain asynchronous communication should be preferred. In any case, measure both
+   /// variants (e.g., with the '--pipelined-comm' switch of the NonUniformGrid benchmark).
+   /// Attention: The functions that are registered for different levels are then called in a different order!
+   bool pipelinedCommunicationIsUsed() const { return pipelinedCommunication_; }
+   void pipelinedCommunication( const bool value = true ) { pipelinedCommunication_ = value; }
+
    bool optimizedCommunicationIsUsed() const { return optimizedCommunication_; }
    void optimizeCommunication( const bool value = true )
    {
@@ -181,7 +193,10 @@ public:
       WALBERLA_CHECK_NOT_NULLPTR( blocks, "Trying to access 'TimeStep' (refinement) for a block storage object that doesn't exist anymore" );
       if( blocks->getNumberOfLevels() > postCollideVoidFunctions_.size() )
          refresh( blocks->getNumberOfLevels() );
-      recursiveStep( uint_t(0), uint_t(0) );
+      if( asynchronousCommunication_ && pipelinedCommunication_ )
+         pipelinedRecursiveStep( uint_t(0), uint_t(0) );
+      else
+         recursiveStep( uint_t(0), uint_t(0) );
    }
 
    void addPackInfo( const typename blockforest::communication::NonUniformBufferedScheme< CommunicationStencil_T >::PackInfo & packInfo )
@@ -270,6 +285,9 @@ private:
    void performLinearExplosion( std::vector< Block * > & blocks, const uint_t level );
 
    void recursiveStep( const uint_t level, const uint_t executionCount );
+
+   void pipelinedRecursiveStep( const uint_t level, const uint_t executionCount );
+   void finishPipelinedStep( const uint_t level, const uint_t executionCount );
    
    
    
@@ -280,6 +298,7 @@ private:
    typename BoundaryHandling_T::BlockSweep boundarySweepWithLayers_; // pre-stream boundary treatment (including ghost layers)
 
    bool asynchronousCommunication_;
+   bool pipelinedCommunication_;
    bool optimizedCommunication_;
 
    shared_ptr< TimeStepPdfPackInfo > pdfPackInfo_;
@@ -332,7 +351,7 @@ TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::TimeStep( weak_ptr< Str
    blocks_( blocks ), sweep_( sweep ),
    boundarySweep_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, uint_t(0) ) ),
    boundarySweepWithLayers_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, StreamIncludedGhostLayers ) ),
-   asynchronousCommunication_( true ), optimizedCommunication_( true ),
+   asynchronousCommunication_( true ), pipelinedCommunication_( false ), optimizedCommunication_( true ),
 #ifdef NDEBUG   
    pdfPackInfo_( make_shared< lbm::refinement::PdfFieldPackInfo< LatticeModel_T > >( pdfFieldId, true, true ) ),
 #else
@@ -358,7 +377,7 @@ TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::TimeStep( weak_ptr< Str
    blocks_( blocks ), sweep_( sweep ),
    boundarySweep_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, uint_t(0) ) ),
    boundarySweepWithLayers_( BoundaryHandling_T::getBlockSweep( boundaryHandlingId, StreamIncludedGhostLayers ) ),
-   asynchronousCommunication_( true ), optimizedCommunication_( true ),
+   asynchronousCommunication_( true ), pipelinedCommunication_( false ), optimizedCommunication_( true ),
    pdfPackInfo_( pdfPackInfo ),
    communication_( blocks, requiredBlockSelectors, incompatibleBlockSelectors ),
    performEqualLevelBorderStreamCorrection_( true ), equalLevelBorderStreamCorrection_( pdfFieldId ),
@@ -1677,6 +1696,128 @@ void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::recursiveStep( con
 
 
 
+template< typename LatticeModel_T, typename Sweep_T, typename BoundaryHandling_T >
+void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::pipelinedRecursiveStep( const uint_t level, const uint_t executionCount )
+{
+   // Same algorithm as 'recursiveStep' with asynchronous communication, but the communication is completed later:
+   // In 'recursiveStep', every level (except for the coarsest) waits for its last equal level communication (finest
+   // level) or for the fine to coarse communication of the next finer level (all other levels) immediately before it
+   // returns to the next coarser level. Here, every level returns while this communication is still in progress, and
+   // the next coarser level completes the time step of the finer level by calling 'finishPipelinedStep':
+   // - After the first sub step of the finer level, the coarser level first waits for its own explosion and equal
+   //   level communication. The fine to coarse communication that follows is still hidden behind the stream step of
+   //   the coarser level, as in 'recursiveStep'.
+   // - After the second sub step of the finer level, the coarser level first performs its own stream step (which
+   //   does not depend on the data of the finer level). Since the finer level then returns from its second sub step
+   //   right after starting the fine to coarse communication of its own finer level, this communication is again
+   //   hidden behind the stream step of the next coarser level.
+   // Hence, the last communication of every level - not only of the finest level - overlaps with computation.
+
+   auto _blocks = blocks_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( _blocks, "Trying to access 'TimeStep' (refinement) for a block storage object that doesn't exist anymore" );
+
+   const uint_t coarsestLevel = uint_t(0);
+   const uint_t   finestLevel = _blocks->getNumberOfLevels() - uint_t(1);
+
+   const uint_t executionCount1st = (executionCount + uint_t(1)) * uint_t(2) - uint_t(2);
+   const uint_t executionCount2nd = (executionCount + uint_t(1)) * uint_t(2) - uint_t(1);
+
+   std::vector< Block * > blocks = selectedBlocks( level );
+
+   if( level != coarsestLevel )
+      startCommunicationCoarseToFine( level ); // [start] explosion (initiated by fine level, involves "level" and "level-1")
+
+   collide( blocks, level, executionCount1st );
+
+   startCommunicationEqualLevel( level ); // [start] equal level communication
+
+   if( level != finestLevel )
+      pipelinedRecursiveStep( level + uint_t(1), executionCount1st ); // returns with communication still in progress
+
+   if( level != coarsestLevel )
+   {
+      endCommunicationCoarseToFine( level ); // [end] explosion (initiated by fine level, involves "level" and "level-1")
+      performLinearExplosion( blocks, level );
+   }
+
+   endCommunicationEqualLevel( level ); // [end] equal level communication
+
+   if( level == finestLevel && level != coarsestLevel )
+   {
+      streamCollide( blocks, level, executionCount1st );
+   }
+   else
+   {
+      if( level != finestLevel )
+      {
+         // The communication of the finer level was hidden behind the explosion and the equal level communication of
+         // this level. The finer level must be completed before its coalescence can start, which in turn is hidden
+         // behind the stream step of this level (just like in 'recursiveStep').
+         finishPipelinedStep( level + uint_t(1), executionCount1st );
+         startCommunicationFineToCoarse( level + uint_t(1) ); // [start] coalescence (initiated by coarse level)
+      }
+
+      stream( blocks, level, executionCount1st );
+
+      if( level != finestLevel )
+         endCommunicationFineToCoarse( level + uint_t(1) ); // [end] coalescence (initiated by coarse level)
+
+      finishStream( blocks, level, executionCount1st );
+
+      if( level == coarsestLevel )
+         return;
+
+      collide( blocks, level, executionCount2nd );
+   }
+
+   startCommunicationEqualLevel( level ); // [start] equal level communication
+
+   if( level != finestLevel )
+   {
+      pipelinedRecursiveStep( level + uint_t(1), executionCount2nd ); // returns with communication still in progress
+
+      endCommunicationEqualLevel( level ); // [end] equal level communication
+
+      stream( blocks, level, executionCount2nd );
+
+      finishPipelinedStep( level + uint_t(1), executionCount2nd );
+      startCommunicationFineToCoarse( level + uint_t(1) ); // [start] coalescence (initiated by coarse level)
+   }
+
+   // the rest of the time step is performed by 'finishPipelinedStep', called by the next coarser level
+}
+
+
+
+template< typename LatticeModel_T, typename Sweep_T, typename BoundaryHandling_T >
+void TimeStep< LatticeModel_T, Sweep_T, BoundaryHandling_T >::finishPipelinedStep( const uint_t level, const uint_t executionCount )
+{
+   // completes the time step that was started by 'pipelinedRecursiveStep( level, executionCount )'
+
+   auto _blocks = blocks_.lock();
+   WALBERLA_CHECK_NOT_NULLPTR( _blocks, "Trying to access 'TimeStep' (refinement) for a block storage object that doesn't exist anymore" );
+
+   const uint_t finestLevel = _blocks->getNumberOfLevels() - uint_t(1);
+
+   const uint_t executionCount2nd = (executionCount + uint_t(1)) * uint_t(2) - uint_t(1);
+
+   std::vector< Block * > blocks = selectedBlocks( level );
+
+   if( level == finestLevel )
+   {
+      endCommunicationEqualLevel( level ); // [end] equal level communication
+      stream( blocks, level, executionCount2nd );
+   }
+   else
+   {
+      endCommunicationFineToCoarse( level + uint_t(1) ); // [end] coalescence (initiated by coarse level)
+   }
+
+   finishStream( blocks, level, executionCount2nd );
+}
+
+
+
 
 
 
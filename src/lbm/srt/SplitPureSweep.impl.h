@@ -90,10 +90,13 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_PURE_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval );
 };
 
 template< typename LatticeModel_T >
@@ -104,14 +107,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::not_< boost::mpl::bool_< LatticeModel_T::compressible > >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -125,7 +127,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -141,31 +144,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -184,8 +187,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = omega_trm * pC[x] + omega_w0 * dir_indep_trm[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -196,8 +199,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSE[x] = omega_trm * pSE[x] + omega_w2 * ( vel_trm_NW_SE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -208,8 +211,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = omega_trm * pSW[x] + omega_w2 * ( vel_trm_NE_SW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -220,8 +223,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBE[x] = omega_trm * pBE[x] + omega_w2 * ( vel_trm_TW_BE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -232,8 +235,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = omega_trm * pBW[x] + omega_w2 * ( vel_trm_TE_BW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -244,8 +247,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBN[x] = omega_trm * pBN[x] + omega_w2 * ( vel_trm_TS_BN + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -256,8 +259,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = omega_trm * pBS[x] + omega_w2 * ( vel_trm_TN_BS - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -267,8 +270,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = omega_trm * pS[x] + omega_w1 * ( vel_trm_N_S - velY[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -278,8 +281,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = omega_trm * pW[x] + omega_w1 * ( vel_trm_E_W - velX[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -289,35 +292,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = omega_trm * pB[x] + omega_w1 * ( vel_trm_T_B - velZ[x] );
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -331,7 +334,7 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             dir_indep_trm[x] = one_third * rho - real_c(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
+            dst->get(xMin+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -339,8 +342,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velY[x];
             const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
-            dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xMin+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xMin+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -348,8 +351,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velY[x];
             const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
-            dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xMin+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xMin+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -357,8 +360,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velZ[x];
             const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
-            dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xMin+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xMin+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -366,8 +369,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velZ[x];
             const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
-            dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xMin+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xMin+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -375,8 +378,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] - velZ[x];
             const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
-            dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xMin+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xMin+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -384,35 +387,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] + velZ[x];
             const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
-            dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xMin+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xMin+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_N_S = dir_indep_trm[x] + real_c(1.5) * velY[x] * velY[x];
 
-            dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
-            dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xMin+x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xMin+x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_E_W = dir_indep_trm[x] + real_c(1.5) * velX[x] * velX[x];
 
-            dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
-            dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xMin+x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xMin+x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_T_B = dir_indep_trm[x] + real_c(1.5) * velZ[x] * velZ[x];
 
-            dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
-            dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xMin+x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xMin+x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -423,8 +426,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 
@@ -790,10 +791,13 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_PURE_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval );
 };
 
 template< typename LatticeModel_T >
@@ -804,14 +808,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::bool_< LatticeModel_T::compressible >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -825,7 +828,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -843,31 +847,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -887,8 +891,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
               dC[x] = omega_trm * pC[x] + omega_w0 * rho[x] * dir_indep_trm[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -899,8 +903,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSE[x] = omega_trm * pSE[x] + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -911,8 +915,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = omega_trm * pSW[x] + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -923,8 +927,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBE[x] = omega_trm * pBE[x] + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
 
          X_LOOP
@@ -936,8 +940,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = omega_trm * pBW[x] + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -948,8 +952,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBN[x] = omega_trm * pBN[x] + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -960,8 +964,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = omega_trm * pBS[x] + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -971,8 +975,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = omega_trm * pS[x] + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -982,8 +986,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = omega_trm * pW[x] + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -993,35 +997,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = omega_trm * pB[x] + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
          )
 
-       ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+       ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -1036,7 +1040,7 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             dir_indep_trm[x] = one_third - real_c(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
+            dst->get(xMin+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1044,8 +1048,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velY[x];
             const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
-            dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xMin+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xMin+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1053,8 +1057,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velY[x];
             const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
-            dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xMin+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xMin+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1062,8 +1066,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] - velZ[x];
             const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
-            dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xMin+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xMin+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1071,8 +1075,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velX[x] + velZ[x];
             const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
-            dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xMin+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xMin+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1080,8 +1084,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] - velZ[x];
             const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
-            dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xMin+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xMin+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
@@ -1089,35 +1093,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             const real_t vel = velY[x] + velZ[x];
             const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_c(1.5) * vel * vel;
 
-            dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
-            dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
+            dst->get(xMin+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xMin+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
+            dst->get(xMin+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xMin+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_N_S = dir_indep_trm[x] + real_c(1.5) * velY[x] * velY[x];
 
-            dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
-            dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xMin+x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xMin+x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_E_W = dir_indep_trm[x] + real_c(1.5) * velX[x] * velX[x];
 
-            dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
-            dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xMin+x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xMin+x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
             const real_t vel_trm_T_B = dir_indep_trm[x] + real_c(1.5) * velZ[x] * velZ[x];
 
-            dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
-            dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xMin+x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
+            dst->get(xMin+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xMin+x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -1129,8 +1133,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
@@ -83,10 +83,14 @@ public:
    SplitSweep( const BlockDataID & src, const BlockDataID & dst, const ConstBlockDataID & flagField, const Set< FlagUID > & lbmMask ) :
       FlagFieldSweepBase<LatticeModel_T,FlagField_T>( src, dst, flagField, lbmMask ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const FlagField_T * const flagField, const typename FlagField_T::flag_t lbm,
+                               const CellInterval & interval );
 };
 
 template< typename LatticeModel_T, typename FlagField_T >
@@ -97,15 +101,15 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                                                                                            boost::mpl::not_< boost::mpl::bool_< LatticeModel_T::compressible > >,
                                                                                            boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                            force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const FlagField_T * const flagField, const typename FlagField_T::flag_t lbm,
+                               const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-   const FlagField_T * flagField( NULL );
-
-   auto lbm = this->getLbmMaskAndFields( block, src, dst, flagField );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( flagField );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -119,7 +123,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -137,35 +142,35 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
-            if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
+            if( flagField->isPartOfMaskSet( xMin+x, y, z, lbm ) )
             {
                const real_t velX_trm = pE[x] + pNE[x] + pSE[x] + pTE[x] + pBE[x];
                const real_t velY_trm = pN[x] + pNW[x] + pTN[x] + pBN[x];
@@ -186,8 +191,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             else perform_lbm[x] = false;
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -201,8 +206,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -216,8 +221,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -231,8 +236,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -246,8 +251,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -261,8 +266,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -276,8 +281,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -290,8 +295,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -304,8 +309,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -322,33 +327,33 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
-            {
-               const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-               const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-               const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-               const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-               const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-               const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-               const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-               const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-               const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-               const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-               const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-               const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-               const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-               const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-               const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-               const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-               const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-               const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-               const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            if( flagField->isPartOfMaskSet( xMin+x, y, z, lbm ) )
+            {
+               const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+               const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+               const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+               const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+               const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+               const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+               const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+               const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+               const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+               const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+               const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+               const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+               const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+               const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+               const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+               const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+               const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+               const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+               const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
                const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
                const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -362,7 +367,7 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
                dir_indep_trm[x] = one_third * rho - real_t(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-               dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
+               dst->get(xMin+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * dir_indep_trm[x];
 
                perform_lbm[x] = true;
             }
@@ -376,8 +381,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] - velY[x];
                const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
-               dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xMin+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * ( vel_trm_NW_SE - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xMin+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * ( vel_trm_NW_SE + vel );
             }
          }
 
@@ -388,8 +393,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] + velY[x];
                const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
-               dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xMin+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * ( vel_trm_NE_SW + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xMin+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * ( vel_trm_NE_SW - vel );
             }
          }
 
@@ -400,8 +405,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] - velZ[x];
                const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
-               dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xMin+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * ( vel_trm_TW_BE - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xMin+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * ( vel_trm_TW_BE + vel );
             }
          }
 
@@ -412,8 +417,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] + velZ[x];
                const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
-               dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xMin+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * ( vel_trm_TE_BW + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xMin+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * ( vel_trm_TE_BW - vel );
             }
          }
 
@@ -424,8 +429,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velY[x] - velZ[x];
                const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
-               dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xMin+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * ( vel_trm_TS_BN - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xMin+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * ( vel_trm_TS_BN + vel );
             }
          }
 
@@ -436,8 +441,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velY[x] + velZ[x];
                const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
-               dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xMin+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * ( vel_trm_TN_BS + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xMin+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * ( vel_trm_TN_BS - vel );
             }
          }
 
@@ -447,8 +452,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_N_S = dir_indep_trm[x] + real_t(1.5) * velY[x] * velY[x];
 
-               dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
-               dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xMin+x, y-1, z, Stencil::idx[N]) + omega_w1 * ( vel_trm_N_S + velY[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xMin+x, y+1, z, Stencil::idx[S]) + omega_w1 * ( vel_trm_N_S - velY[x] );
             }
          }
 
@@ -458,8 +463,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_E_W = dir_indep_trm[x] + real_t(1.5) * velX[x] * velX[x];
 
-               dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
-               dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xMin+x-1, y, z, Stencil::idx[E]) + omega_w1 * ( vel_trm_E_W + velX[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xMin+x+1, y, z, Stencil::idx[W]) + omega_w1 * ( vel_trm_E_W - velX[x] );
             }
          }
 
@@ -469,12 +474,12 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_T_B = dir_indep_trm[x] + real_t(1.5) * velZ[x] * velZ[x];
 
-               dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
-               dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xMin+x, y, z-1, Stencil::idx[T]) + omega_w1 * ( vel_trm_T_B + velZ[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xMin+x, y, z+1, Stencil::idx[B]) + omega_w1 * ( vel_trm_T_B - velZ[x] );
             }
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -486,8 +491,6 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T, typename FlagField_T >
@@ -923,10 +926,14 @@ public:
    SplitSweep( const BlockDataID & src, const BlockDataID & dst, const ConstBlockDataID & flagField, const Set< FlagUID > & lbmMask ) :
       FlagFieldSweepBase<LatticeModel_T,FlagField_T>( src, dst, flagField, lbmMask ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const FlagField_T * const flagField, const typename FlagField_T::flag_t lbm,
+                               const CellInterval & interval );
 };
 
 template< typename LatticeModel_T, typename FlagField_T >
@@ -937,15 +944,15 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                                                                                            boost::mpl::bool_< LatticeModel_T::compressible >,
                                                                                            boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                            force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )                                              
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const FlagField_T * const flagField, const typename FlagField_T::flag_t lbm,
+                               const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-   const FlagField_T * flagField( NULL );
-
-   auto lbm = this->getLbmMaskAndFields( block, src, dst, flagField );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( flagField );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -959,7 +966,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -979,35 +987,35 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
-            if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
+            if( flagField->isPartOfMaskSet( xMin+x, y, z, lbm ) )
             {
                const real_t velX_trm = pE[x] + pNE[x] + pSE[x] + pTE[x] + pBE[x];
                const real_t velY_trm = pN[x] + pNW[x] + pTN[x] + pBN[x];
@@ -1029,8 +1037,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             else perform_lbm[x] = false;
          )
 
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
 
          X_LOOP
          (
@@ -1044,8 +1052,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -1059,8 +1067,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
 
          X_LOOP
          (
@@ -1074,8 +1082,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -1089,8 +1097,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
 
          X_LOOP
          (
@@ -1104,8 +1112,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -1119,8 +1127,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -1133,8 +1141,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -1147,8 +1155,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -1161,37 +1169,37 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             }
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
-            {
-               const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-               const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-               const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-               const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-               const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-               const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-               const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-               const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-               const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-               const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-               const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-               const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-               const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-               const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-               const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-               const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-               const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-               const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-               const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            if( flagField->isPartOfMaskSet( xMin+x, y, z, lbm ) )
+            {
+               const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+               const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+               const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+               const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+               const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+               const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+               const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+               const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+               const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+               const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+               const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+               const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+               const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+               const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+               const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+               const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+               const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+               const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+               const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
                const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
                const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -1206,7 +1214,7 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 
                dir_indep_trm[x] = one_third - real_t(0.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-               dst->get(x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
+               dst->get(xMin+x,y,z,Stencil::idx[C]) = omega_trm * dd_tmp_C + omega_w0 * rho[x] * dir_indep_trm[x];
 
                perform_lbm[x] = true;
             }
@@ -1220,8 +1228,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] - velY[x];
                const real_t vel_trm_NW_SE = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[NW]) = omega_trm * src->get(x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
-               dst->get(x,y,z,Stencil::idx[SE]) = omega_trm * src->get(x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[NW]) = omega_trm * src->get(xMin+x+1, y-1, z, Stencil::idx[NW]) + omega_w2 * rho[x] * ( vel_trm_NW_SE - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[SE]) = omega_trm * src->get(xMin+x-1, y+1, z, Stencil::idx[SE]) + omega_w2 * rho[x] * ( vel_trm_NW_SE + vel );
             }
          }
 
@@ -1232,8 +1240,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] + velY[x];
                const real_t vel_trm_NE_SW = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[NE]) = omega_trm * src->get(x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
-               dst->get(x,y,z,Stencil::idx[SW]) = omega_trm * src->get(x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[NE]) = omega_trm * src->get(xMin+x-1, y-1, z, Stencil::idx[NE]) + omega_w2 * rho[x] * ( vel_trm_NE_SW + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[SW]) = omega_trm * src->get(xMin+x+1, y+1, z, Stencil::idx[SW]) + omega_w2 * rho[x] * ( vel_trm_NE_SW - vel );
             }
          }
 
@@ -1244,8 +1252,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] - velZ[x];
                const real_t vel_trm_TW_BE = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TW]) = omega_trm * src->get(x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
-               dst->get(x,y,z,Stencil::idx[BE]) = omega_trm * src->get(x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TW]) = omega_trm * src->get(xMin+x+1, y, z-1, Stencil::idx[TW]) + omega_w2 * rho[x] * ( vel_trm_TW_BE - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BE]) = omega_trm * src->get(xMin+x-1, y, z+1, Stencil::idx[BE]) + omega_w2 * rho[x] * ( vel_trm_TW_BE + vel );
             }
          }
 
@@ -1256,8 +1264,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velX[x] + velZ[x];
                const real_t vel_trm_TE_BW = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TE]) = omega_trm * src->get(x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
-               dst->get(x,y,z,Stencil::idx[BW]) = omega_trm * src->get(x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TE]) = omega_trm * src->get(xMin+x-1, y, z-1, Stencil::idx[TE]) + omega_w2 * rho[x] * ( vel_trm_TE_BW + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BW]) = omega_trm * src->get(xMin+x+1, y, z+1, Stencil::idx[BW]) + omega_w2 * rho[x] * ( vel_trm_TE_BW - vel );
             }
          }
 
@@ -1268,8 +1276,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velY[x] - velZ[x];
                const real_t vel_trm_TS_BN = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TS]) = omega_trm * src->get(x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
-               dst->get(x,y,z,Stencil::idx[BN]) = omega_trm * src->get(x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TS]) = omega_trm * src->get(xMin+x, y+1, z-1, Stencil::idx[TS]) + omega_w2 * rho[x] * ( vel_trm_TS_BN - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BN]) = omega_trm * src->get(xMin+x, y-1, z+1, Stencil::idx[BN]) + omega_w2 * rho[x] * ( vel_trm_TS_BN + vel );
             }
          }
 
@@ -1280,8 +1288,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
                const real_t vel = velY[x] + velZ[x];
                const real_t vel_trm_TN_BS = dir_indep_trm[x] + real_t(1.5) * vel * vel;
 
-               dst->get(x,y,z,Stencil::idx[TN]) = omega_trm * src->get(x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
-               dst->get(x,y,z,Stencil::idx[BS]) = omega_trm * src->get(x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
+               dst->get(xMin+x,y,z,Stencil::idx[TN]) = omega_trm * src->get(xMin+x, y-1, z-1, Stencil::idx[TN]) + omega_w2 * rho[x] * ( vel_trm_TN_BS + vel );
+               dst->get(xMin+x,y,z,Stencil::idx[BS]) = omega_trm * src->get(xMin+x, y+1, z+1, Stencil::idx[BS]) + omega_w2 * rho[x] * ( vel_trm_TN_BS - vel );
             }
          }
 
@@ -1291,8 +1299,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_N_S = dir_indep_trm[x] + real_t(1.5) * velY[x] * velY[x];
 
-               dst->get(x,y,z,Stencil::idx[N]) = omega_trm * src->get(x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
-               dst->get(x,y,z,Stencil::idx[S]) = omega_trm * src->get(x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[N]) = omega_trm * src->get(xMin+x, y-1, z, Stencil::idx[N]) + omega_w1 * rho[x] * ( vel_trm_N_S + velY[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[S]) = omega_trm * src->get(xMin+x, y+1, z, Stencil::idx[S]) + omega_w1 * rho[x] * ( vel_trm_N_S - velY[x] );
             }
          }
 
@@ -1302,8 +1310,8 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_E_W = dir_indep_trm[x] + real_t(1.5) * velX[x] * velX[x];
 
-               dst->get(x,y,z,Stencil::idx[E]) = omega_trm * src->get(x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
-               dst->get(x,y,z,Stencil::idx[W]) = omega_trm * src->get(x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[E]) = omega_trm * src->get(xMin+x-1, y, z, Stencil::idx[E]) + omega_w1 * rho[x] * ( vel_trm_E_W + velX[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[W]) = omega_trm * src->get(xMin+x+1, y, z, Stencil::idx[W]) + omega_w1 * rho[x] * ( vel_trm_E_W - velX[x] );
             }
          }
 
@@ -1313,12 +1321,12 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
             {
                const real_t vel_trm_T_B = dir_indep_trm[x] + real_t(1.5) * velZ[x] * velZ[x];
 
-               dst->get(x,y,z,Stencil::idx[T]) = omega_trm * src->get(x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
-               dst->get(x,y,z,Stencil::idx[B]) = omega_trm * src->get(x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[T]) = omega_trm * src->get(xMin+x, y, z-1, Stencil::idx[T]) + omega_w1 * rho[x] * ( vel_trm_T_B + velZ[x] );
+               dst->get(xMin+x,y,z,Stencil::idx[B]) = omega_trm * src->get(xMin+x, y, z+1, Stencil::idx[B]) + omega_w1 * rho[x] * ( vel_trm_T_B - velZ[x] );
             }
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -1331,8 +1339,6 @@ void SplitSweep< LatticeModel_T, FlagField_T, typename boost::enable_if< boost::
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T, typename FlagField_T >
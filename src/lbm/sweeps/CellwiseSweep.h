@@ -76,6 +76,15 @@ namespace lbm {
 *
 *   Note that the shared pointer returned by all 'makeCellwiseSweep' functions can be captured by a SharedSweep
 *   for immediate registration at a time loop (see domain_decomposition::makeSharedSweep).
+*
+*   In order to overlap the ghost layer communication with computation, the stream & collide step can be split into
+*   two parts: 'inner' processes all cells that do not depend on the ghost layers (the interior of the block shrunk
+*   by one cell), 'outer' processes the remaining frame of one cell width and swaps the source and destination field.
+*   'inner' can therefore run while the communication is still in flight, 'outer' must wait for the communication to
+*   finish. Both functions must always be called in this order for every block. Unless a dedicated dst field is
+*   provided via block data, the sweep allocates one temporary PDF field per block for 'inner' and 'outer'. The sweep wrappers returned by
+*   lbm::makeInnerSweep and lbm::makeOuterSweep can be registered at a time loop together with a communication scheme
+*   via timeloop::addCommunicationOverlap.
 */
 //**********************************************************************************************************************
 
@@ -131,11 +140,67 @@ class CellwiseSweep
       \
       void streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
       \
+      void inner( IBlock * const block ); \
+      void outer( IBlock * const block ); \
+      \
       void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
       void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) ); \
+      \
+   protected: \
+      \
+      void streamCollideInterval( IBlock * const block, PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval ); \
    }; \
    \
    template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
+   void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
+      >::streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst ); \
+      \
+      WALBERLA_ASSERT_GREATER( src->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+      WALBERLA_ASSERT_GREATER_EQUAL( dst->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+      \
+      CellInterval interval = src->xyzSize(); \
+      interval.expand( cell_idx_c( numberOfGhostLayersToInclude ) ); \
+      \
+      streamCollideInterval( block, src, dst, interval ); \
+      src->swapDataPointers( dst ); \
+   } \
+   \
+   template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
+   void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
+      >::inner( IBlock * const block ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst, true ); \
+      \
+      CellInterval interval = src->xyzSize(); \
+      interval.expand( cell_idx_t(-1) ); \
+      \
+      if( !interval.empty() ) \
+         streamCollideInterval( block, src, dst, interval ); \
+   } \
+   \
+   template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
+   void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
+      >::outer( IBlock * const block ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst, true ); /* dst already contains the results of 'inner' */ \
+      \
+      std::vector< CellInterval > frame; \
+      this->getFrame( src->xyzSize(), frame ); \
+      for( auto interval = frame.begin(); interval != frame.end(); ++interval ) \
+         streamCollideInterval( block, src, dst, *interval ); \
+      \
+      src->swapDataPointers( dst ); \
+   } \
+   \
+   template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
    void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
       >::stream( IBlock * const block, const uint_t numberOfGhostLayersToInclude ) \
    { \
@@ -150,15 +215,13 @@ class CellwiseSweep
 #define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_HEAD( specialization) \
    template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T > \
    void CellwiseSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T, typename boost::enable_if< specialization >::type \
-      >::streamCollide( IBlock * const block, const uint_t numberOfGhostLayersToInclude ) \
+      >::streamCollideInterval( IBlock * const block, PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval ) \
    { \
-      PdfField_T * src( NULL ); \
-      PdfField_T * dst( NULL ); \
-      \
-      this->getFields( block, src, dst ); \
+      WALBERLA_ASSERT_NOT_NULLPTR( src ); \
+      WALBERLA_ASSERT_NOT_NULLPTR( dst ); \
       \
-      WALBERLA_ASSERT_GREATER( src->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
-      WALBERLA_ASSERT_GREATER_EQUAL( dst->nrOfGhostLayers(), numberOfGhostLayersToInclude ); \
+      WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 ); \
+      WALBERLA_ASSERT( dst->xyzSizeWithGhostLayer().contains( interval ) ); \
       \
       const auto & lm = src->latticeModel(); \
       dst->resetLatticeModel( lm ); /* required so that member functions for getting density and equilibrium velocity can be called for dst! */ \
@@ -167,7 +230,7 @@ class CellwiseSweep
       this->densityVelocityIn( *block ); \
       this->densityVelocityOut( *block );
 
-#define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT() src->swapDataPointers( dst ); }
+#define WALBERLA_LBM_CELLWISE_SWEEP_STREAM_COLLIDE_FOOT() }
 
 
 
@@ -49,12 +49,14 @@ public:
 protected:
 
    using SweepBase<LatticeModel_T>::getFields;
-   inline void getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst, const FlagField_T * & flags );
+   inline void getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst, const FlagField_T * & flags,
+                          const bool dedicated = false );
    inline void getFields( IBlock * const block, PdfField_T * & src,                     const FlagField_T * & flags );
 
-   flag_t getLbmMaskAndFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst, const FlagField_T * & flags )
+   flag_t getLbmMaskAndFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst, const FlagField_T * & flags,
+                               const bool dedicated = false )
    {
-      getFields( block, src, dst, flags );
+      getFields( block, src, dst, flags, dedicated );
       return flags->getMask( lbmMask_ );
    }
 
@@ -75,11 +77,11 @@ protected:
 
 template< typename LatticeModel_T, typename FlagField_T >
 inline void FlagFieldSweepBase< LatticeModel_T, FlagField_T >::getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst,
-                                                                          const FlagField_T * & flags )
+                                                                          const FlagField_T * & flags, const bool dedicated )
 {
    WALBERLA_ASSERT_NOT_NULLPTR( block );
 
-   this->getFields( block, src, dst );
+   this->getFields( block, src, dst, dedicated );
    flags = block->getData<FlagField_T>( flagField_ );
 
    WALBERLA_ASSERT_NOT_NULLPTR( flags );
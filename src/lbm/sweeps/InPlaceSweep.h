@@ -0,0 +1,249 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSweep.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "InPlaceTimestep.h"
+#include "LocalCollision.h"
+#include "lbm/lattice_model/LatticeModelBase.h"
+#include "lbm/sweeps/FlagFieldSweepBase.h"
+
+#include "core/debug/Debug.h"
+#include "field/iterators/IteratorMacros.h"
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+
+namespace walberla {
+namespace lbm {
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Stream & collide sweep that works on a single PDF field (AA pattern, in-place streaming)
+*
+*   All other LBM sweeps stream from a source into a destination field and therefore need a second PDF field per block.
+*   This sweep implements the AA pattern (Bailey et al., "Accelerating lattice Boltzmann fluid flow simulations using
+*   graphics processors", 2009) and needs no temporary field at all. Each cell update reads and writes its Q values
+*   from/to the same memory locations, which avoids the second field and the write-allocate traffic of the
+*   destination field. For memory-bound kernels, this roughly halves the amount of data transferred per cell update.
+*
+*   The sweep alternates between two kinds of time steps:
+*   - even time step: the PDFs are gathered from the neighbors (stream pull, slot d of the neighbor in direction -d),
+*                     collided, and scattered back to the memory locations they were read from (the post-collision
+*                     value of direction d is stored in slot inv(d) of the neighbor in direction d)
+*   - odd time step:  the PDFs of a cell are read from the cell itself in inverted order (values reflected at a wall
+*                     are read from the wall cell), collided, and written back to the cell in regular order
+*   Every time step is equivalent to one stream pull & collide step of the two-grid sweeps (e.g. lbm::CellwiseSweep).
+*   After an odd time step, i.e. after every second time step, the PDF field is in the same state as the field of
+*   a two-grid sweep. Only then, macroscopic values (density, velocity, ...) can be evaluated with the usual member
+*   functions of the PdfField.
+*
+*   The parity of the time step is shared with the pack info via an InPlaceTimestep object that must be advanced after
+*   each time step. The ghost layers must be communicated BEFORE the sweep with an InPlacePdfFieldPackInfo that uses
+*   the same InPlaceTimestep object:
+*
+*   \code
+*   auto timestep = make_shared< lbm::InPlaceTimestep >();
+*
+*   blockforest::communication::UniformBufferedScheme< LatticeModel_T::CommunicationStencil > communication( blocks );
+*   communication.addPackInfo( make_shared< lbm::InPlacePdfFieldPackInfo< LatticeModel_T > >( pdfFieldId, timestep ) );
+*
+*   timeloop.add() << BeforeFunction( communication, "LB communication" )
+*                  << Sweep( makeSharedSweep( lbm::makeInPlaceSweep< LatticeModel_T, FlagField_T >( pdfFieldId, flagFieldId, fluid, timestep ) ), "LB in-place" )
+*                  << AfterFunction( lbm::InPlaceTimestep::getAdvanceFunction( timestep ), "LB in-place time step" );
+*   \endcode
+*
+*   Only cells marked in the flag field with one of the flags of the lbm mask are processed. All other cells
+*   (including the ghost layer cells at the domain border) act as no slip walls (half-way bounce back, which is
+*   equivalent to lbm::NoSlip). Since the boundary treatment is part of the kernel, no BoundaryHandling sweep must be
+*   executed for the in-place PDF field. The ghost layers of the flag field must be up to date.
+*
+*   Supported lattice models: SRT and TRT, any stencil (tested with D3Q19 and D3Q27),
+*   compressible and incompressible, no additional forces.
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename FlagField_T >
+class InPlaceSweep : public FlagFieldSweepBase< LatticeModel_T, FlagField_T >
+{
+public:
+
+   static_assert( (boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >::value), "Only works without additional forces!" );
+
+   typedef typename FlagFieldSweepBase< LatticeModel_T, FlagField_T >::PdfField_T  PdfField_T;
+   typedef typename LatticeModel_T::Stencil                                        Stencil_T;
+   typedef typename FlagField_T::flag_t                                            flag_t;
+
+   InPlaceSweep( const BlockDataID & pdfField, const ConstBlockDataID & flagField, const Set< FlagUID > & lbmMask,
+                 const shared_ptr< InPlaceTimestep > & timestep ) :
+      FlagFieldSweepBase< LatticeModel_T, FlagField_T >( pdfField, flagField, lbmMask ), timestep_( timestep )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( timestep_ );
+   }
+
+   void operator()( IBlock * const block )
+   {
+      if( timestep_->isEven() )
+         evenStep( block );
+      else
+         oddStep( block );
+   }
+
+   void evenStep( IBlock * const block );
+   void  oddStep( IBlock * const block );
+
+   const shared_ptr< InPlaceTimestep > & getTimestep() const { return timestep_; }
+
+private:
+
+   shared_ptr< InPlaceTimestep > timestep_;
+};
+
+
+
+template< typename LatticeModel_T, typename FlagField_T >
+void InPlaceSweep< LatticeModel_T, FlagField_T >::evenStep( IBlock * const block )
+{
+   PdfField_T * src( NULL );
+   const FlagField_T * flagField( NULL );
+
+   const flag_t lbm = this->getLbmMaskAndFields( block, src, flagField );
+
+   WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT_GREATER_EQUAL( flagField->nrOfGhostLayers(), 1 );
+
+   const auto & lm = src->latticeModel();
+
+   // Every fluid cell overwrites exactly the values that it has read before (slot d of the neighbor in direction -d is
+   // replaced by slot inv(d)) plus slots of adjacent wall cells that are only ever touched by this very cell
+   // -> the cells can be processed in any order/in parallel.
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+#endif
+
+   real_t pdfs[ Stencil_T::Size ];
+   bool   fluidNeighbor[ Stencil_T::Size ];
+
+   WALBERLA_FOR_ALL_CELLS_XYZ_OMP( src, omp for schedule(static),
+
+      if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
+      {
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+            fluidNeighbor[ d.toIdx() ] = flagField->isPartOfMaskSet( x + d.cx(), y + d.cy(), z + d.cz(), lbm );
+
+         // gather (pull): values coming from a wall are the reflected post-collision values of the cell itself
+
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+         {
+            pdfs[ d.toIdx() ] = fluidNeighbor[ d.toInvIdx() ] ? src->get( x - d.cx(), y - d.cy(), z - d.cz(), d.toIdx() ) :
+                                                                src->get( x, y, z, d.toInvIdx() );
+         }
+
+         Vector3<real_t> velocity;
+         const real_t rho = internal::localDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+
+         internal::LocalCollision< LatticeModel_T >::apply( pdfs, lm, x, y, z, velocity, rho );
+
+         // scatter (inverted): the post-collision value of direction d is stored in slot inv(d) of the neighbor in
+         // direction d - also if the neighbor is a wall, the value is then reflected during the next (odd) time step
+
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+            src->get( x + d.cx(), y + d.cy(), z + d.cz(), d.toInvIdx() ) = pdfs[ d.toIdx() ];
+      }
+
+   ) // WALBERLA_FOR_ALL_CELLS_XYZ_OMP
+
+#ifdef _OPENMP
+   }
+#endif
+}
+
+
+
+template< typename LatticeModel_T, typename FlagField_T >
+void InPlaceSweep< LatticeModel_T, FlagField_T >::oddStep( IBlock * const block )
+{
+   PdfField_T * src( NULL );
+   const FlagField_T * flagField( NULL );
+
+   const flag_t lbm = this->getLbmMaskAndFields( block, src, flagField );
+
+   WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT_GREATER_EQUAL( flagField->nrOfGhostLayers(), 1 );
+
+   const auto & lm = src->latticeModel();
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+#endif
+
+   real_t pdfs[ Stencil_T::Size ];
+
+   WALBERLA_FOR_ALL_CELLS_XYZ_OMP( src, omp for schedule(static),
+
+      if( flagField->isPartOfMaskSet( x, y, z, lbm ) )
+      {
+         // the streamed values of the last (even) time step are stored in inverted order in the cell itself, the
+         // values that are reflected at a wall are stored in the wall cell (written by this cell during the last time step)
+
+         real_t * const pdf0 = &src->get( x, y, z, 0 );
+
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+         {
+            pdfs[ d.toIdx() ] = flagField->isPartOfMaskSet( x - d.cx(), y - d.cy(), z - d.cz(), lbm ) ? src->getF( pdf0, d.toInvIdx() ) :
+                                                                                                      src->get( x - d.cx(), y - d.cy(), z - d.cz(), d.toIdx() );
+         }
+
+         Vector3<real_t> velocity;
+         const real_t rho = internal::localDensityAndVelocity< LatticeModel_T >( velocity, pdfs );
+
+         internal::LocalCollision< LatticeModel_T >::apply( pdfs, lm, x, y, z, velocity, rho );
+
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+            src->getF( pdf0, d.toIdx() ) = pdfs[ d.toIdx() ];
+      }
+
+   ) // WALBERLA_FOR_ALL_CELLS_XYZ_OMP
+
+#ifdef _OPENMP
+   }
+#endif
+}
+
+
+
+template< typename LatticeModel_T, typename FlagField_T >
+shared_ptr< InPlaceSweep< LatticeModel_T, FlagField_T > >
+makeInPlaceSweep( const BlockDataID & pdfFieldId, const ConstBlockDataID & flagFieldId, const Set< FlagUID > & lbmMask,
+                  const shared_ptr< InPlaceTimestep > & timestep )
+{
+   typedef InPlaceSweep< LatticeModel_T, FlagField_T > Sweep_T;
+   return shared_ptr< Sweep_T >( new Sweep_T( pdfFieldId, flagFieldId, lbmMask, timestep ) );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
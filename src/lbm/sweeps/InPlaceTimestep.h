@@ -0,0 +1,72 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceTimestep.h
+//! \ingroup lbm
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Keeps track of the parity of the time step for in-place (AA pattern) streaming
+*
+*   The in-place sweep and the in-place PDF pack info (see 'InPlaceSweep.h' and 'InPlacePdfFieldPackInfo.h') behave
+*   differently in even and odd time steps. Both share one instance of this class (via a shared pointer) that must be
+*   advanced exactly once per time step - after the communication and after the sweep (see 'getAdvanceFunction').
+*/
+//**********************************************************************************************************************
+
+class InPlaceTimestep
+{
+public:
+
+   InPlaceTimestep() : counter_( uint_t(0) ) {}
+
+   bool isEven() const { return ( counter_ & uint_t(1) ) == uint_t(0); }
+   bool isOdd()  const { return !isEven(); }
+
+   uint_t getCounter() const { return counter_; }
+
+   void advance() { ++counter_; }
+   void reset() { counter_ = uint_t(0); }
+
+   /// Function that can be registered at a time loop, the returned function keeps this object alive
+   static boost::function< void () > getAdvanceFunction( const shared_ptr< InPlaceTimestep > & timestep )
+   {
+      return boost::bind( &InPlaceTimestep::advance, timestep );
+   }
+
+private:
+
+   uint_t counter_;
+};
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -0,0 +1,124 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file LocalCollision.h
+//! \ingroup lbm
+//! \brief SRT/TRT collision of the PDFs of a single cell that are stored in a plain array
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/lattice_model/CollisionModel.h"
+#include "lbm/lattice_model/EquilibriumDistribution.h"
+#include "lbm/lattice_model/LatticeModelBase.h"
+
+#include "core/DataTypes.h"
+#include "core/math/Vector3.h"
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+namespace internal {
+
+/// Calculates density and velocity from the PDFs of one cell that are stored in a plain array (no forces)
+template< typename LatticeModel_T >
+inline real_t localDensityAndVelocity( Vector3<real_t> & velocity, const real_t * const pdfs )
+{
+   typedef typename LatticeModel_T::Stencil Stencil_T;
+
+   real_t rho = ( LatticeModel_T::compressible ) ? real_t(0) : real_t(1);
+   velocity.set( real_t(0), real_t(0), real_t(0) );
+   for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+   {
+      const real_t pdf = pdfs[ d.toIdx() ];
+      rho         += pdf;
+      velocity[0] += real_c( d.cx() ) * pdf;
+      velocity[1] += real_c( d.cy() ) * pdf;
+      velocity[2] += real_c( d.cz() ) * pdf;
+   }
+   if( LatticeModel_T::compressible )
+      velocity /= rho;
+   return rho;
+}
+
+
+
+/// Collides the PDFs of one cell that are stored in a plain array (used by kernels that do not stream field to field)
+template< typename LatticeModel_T, class Enable = void >
+struct LocalCollision
+{
+   static_assert( never_true<LatticeModel_T>::value, "'lbm::internal::LocalCollision' only supports SRT and TRT lattice models!" );
+};
+
+template< typename LatticeModel_T >
+struct LocalCollision< LatticeModel_T, typename boost::enable_if< boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                  collision_model::SRT_tag > >::type >
+{
+   typedef typename LatticeModel_T::Stencil Stencil_T;
+
+   static void apply( real_t * const pdfs, const LatticeModel_T & lm, const cell_idx_t x, const cell_idx_t y, const cell_idx_t z,
+                      const Vector3<real_t> & velocity, const real_t rho )
+   {
+      const real_t omega = lm.collisionModel().omega( x, y, z, velocity, rho );
+
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+         pdfs[ d.toIdx() ] = ( real_t(1.0) - omega ) * pdfs[ d.toIdx() ] + omega * EquilibriumDistribution< LatticeModel_T >::get( *d, velocity, rho );
+   }
+};
+
+template< typename LatticeModel_T >
+struct LocalCollision< LatticeModel_T, typename boost::enable_if< boost::is_same< typename LatticeModel_T::CollisionModel::tag,
+                                                                                  collision_model::TRT_tag > >::type >
+{
+   typedef typename LatticeModel_T::Stencil Stencil_T;
+
+   static void apply( real_t * const pdfs, const LatticeModel_T & lm, const cell_idx_t, const cell_idx_t, const cell_idx_t,
+                      const Vector3<real_t> & velocity, const real_t rho )
+   {
+      const real_t lambda_e = lm.collisionModel().lambda_e();
+      const real_t lambda_d = lm.collisionModel().lambda_d();
+
+      real_t post[ Stencil_T::Size ];
+
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         const real_t fsym  = EquilibriumDistribution< LatticeModel_T >::getSymmetricPart ( *d, velocity, rho );
+         const real_t fasym = EquilibriumDistribution< LatticeModel_T >::getAsymmetricPart( *d, velocity, rho );
+
+         const real_t f    = pdfs[ d.toIdx() ];
+         const real_t finv = pdfs[ d.toInvIdx() ];
+
+         post[ d.toIdx() ] = f - lambda_e * ( real_t( 0.5 ) * ( f + finv ) - fsym )
+                               - lambda_d * ( real_t( 0.5 ) * ( f - finv ) - fasym );
+      }
+
+      for( uint_t i = 0; i != Stencil_T::Size; ++i )
+         pdfs[i] = post[i];
+   }
+};
+
+} // namespace internal
+
+
+
+} // namespace lbm
+} // namespace walberla
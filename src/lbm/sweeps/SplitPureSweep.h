@@ -21,6 +21,58 @@
 
 #pragma once
 
+#include "core/cell/CellInterval.h"
+
+#include <vector>
+
+
+//**********************************************************************************************************************
+/*!
+*   Defines 'operator()', 'inner' and 'outer' for a specialization of class 'SplitPureSweep' that implements the stream & collide
+*   kernel as 'streamCollideInterval' for an arbitrary cell interval. 'inner' and 'outer' split the sweep in order to
+*   overlap the ghost layer communication with computation (see lbm::CellwiseSweep): 'inner' processes the interior of
+*   the block shrunk by one cell, 'outer' processes the remaining frame of one cell width and swaps the source and
+*   destination field. Both functions must always be called in this order for every block.
+*/
+//**********************************************************************************************************************
+#define WALBERLA_LBM_SPLIT_PURE_SWEEP_INNER_OUTER() \
+   void operator()( IBlock * const block ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst ); \
+      \
+      streamCollideInterval( src, dst, src->xyzSize() ); \
+      src->swapDataPointers( dst ); \
+   } \
+   \
+   void inner( IBlock * const block ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst, true ); \
+      \
+      CellInterval interval = src->xyzSize(); \
+      interval.expand( cell_idx_t(-1) ); \
+      \
+      if( !interval.empty() ) \
+         streamCollideInterval( src, dst, interval ); \
+   } \
+   \
+   void outer( IBlock * const block ) \
+   { \
+      PdfField_T * src( NULL ); \
+      PdfField_T * dst( NULL ); \
+      this->getFields( block, src, dst, true ); /* dst already contains the results of 'inner' */ \
+      \
+      std::vector< CellInterval > frame; \
+      this->getFrame( src->xyzSize(), frame ); \
+      for( auto interval = frame.begin(); interval != frame.end(); ++interval ) \
+         streamCollideInterval( src, dst, *interval ); \
+      \
+      src->swapDataPointers( dst ); \
+   }
+
 
 
 namespace walberla {
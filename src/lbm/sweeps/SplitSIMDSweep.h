@@ -0,0 +1,560 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SplitSIMDSweep.h
+//! \ingroup lbm
+//! \brief Stream-pull-collide split sweep for D3Q19 that is explicitly vectorized with the simd module
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/lattice_model/CollisionModel.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/ForceModel.h"
+#include "lbm/sweeps/SweepBase.h"
+
+#include "core/debug/CheckFunctions.h"
+
+#include "field/iterators/IteratorMacros.h"
+
+#include "simd/AlignedAllocator.h"
+#include "simd/SIMD.h"
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/logical.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+namespace internal {
+
+// relaxation rates of the symmetric and the anti-symmetric part, SRT is treated as TRT with lambda_e == lambda_d
+
+inline real_t splitSIMDLambdaE( const collision_model::SRT & cm ) { return cm.omega(); }
+inline real_t splitSIMDLambdaD( const collision_model::SRT & cm ) { return cm.omega(); }
+
+inline real_t splitSIMDLambdaE( const collision_model::TRT & cm ) { return cm.lambda_e(); }
+inline real_t splitSIMDLambdaD( const collision_model::TRT & cm ) { return cm.lambda_d(); }
+
+// only collision models with constant relaxation rates are supported (SRT, but not SRTField)
+
+template< typename CollisionModel_T, typename Tag_T = typename CollisionModel_T::tag >
+struct SplitSIMDCollisionModel : public boost::false_type {};
+
+template< typename CollisionModel_T >
+struct SplitSIMDCollisionModel< CollisionModel_T, collision_model::SRT_tag > : public boost::mpl::bool_< CollisionModel_T::constant > {};
+
+template< typename CollisionModel_T >
+struct SplitSIMDCollisionModel< CollisionModel_T, collision_model::TRT_tag > : public boost::true_type {};
+
+// vector types the sweep can be instantiated with: simd::double4_t is always available (depending on the instruction
+// set, possibly emulated), simd::double8_t only if the AVX-512 backend is used
+
+enum SplitSIMDStoreMode { SPLIT_SIMD_STORE, SPLIT_SIMD_STREAM, SPLIT_SIMD_STORE_UNALIGNED, SPLIT_SIMD_STREAM_HALVES };
+
+struct SplitSIMDVector4
+{
+   typedef simd::double4_t type;
+   static const uint_t width = 4;
+
+   static inline type make( const double a ) { return simd::make_double4( a ); }
+
+   /// 'p' is located on an x-line at an offset that is a multiple of the vector width
+   static inline type loadLine( const double * const p ) { return simd::load_aligned( p ); }
+   static inline type loadUnaligned( const double * const p ) { return simd::load_unaligned( p ); }
+
+   /// 'p' points into one of the thread-local buffers of the sweep
+   static inline type loadBuffer( const double * const p ) { return simd::load_aligned( p ); }
+   static inline void storeBuffer( double * const p, const type & v ) { simd::store_aligned( p, v ); }
+
+   static inline void store( double * const p, const type & v, const SplitSIMDStoreMode mode )
+   {
+      if( mode == SPLIT_SIMD_STREAM )
+         simd::stream_aligned( p, v );
+      else
+         simd::store_aligned( p, v );
+   }
+};
+
+#ifdef WALBERLA_USE_AVX512
+
+/// x-lines only need to be 32 byte aligned (the default alignment of fzyx fields), if they are not 64 byte aligned,
+/// unaligned loads/stores are used
+struct SplitSIMDVector8
+{
+   typedef simd::double8_t type;
+   static const uint_t width = 8;
+
+   static inline type make( const double a ) { return simd::make_double8( a ); }
+
+   static inline type loadLine( const double * const p ) { return simd::load8_unaligned( p ); }
+   static inline type loadUnaligned( const double * const p ) { return simd::load8_unaligned( p ); }
+
+   static inline type loadBuffer( const double * const p ) { return simd::load8_aligned( p ); }
+   static inline void storeBuffer( double * const p, const type & v ) { simd::store8_aligned( p, v ); }
+
+   static inline void store( double * const p, const type & v, const SplitSIMDStoreMode mode )
+   {
+      switch( mode )
+      {
+      case SPLIT_SIMD_STORE:           simd::store8_aligned( p, v );   break;
+      case SPLIT_SIMD_STREAM:          simd::stream8_aligned( p, v );  break;
+      case SPLIT_SIMD_STORE_UNALIGNED: simd::store8_unaligned( p, v ); break;
+      case SPLIT_SIMD_STREAM_HALVES:   simd::stream8_halves( p, v );   break;
+      }
+   }
+};
+
+#endif
+
+} // namespace internal
+
+
+
+template< typename LatticeModel_T, class Enable = void >
+class SplitSIMDSweep
+{
+   static_assert( never_true<LatticeModel_T>::value, "Instantiating 'lbm::SplitSIMDSweep' failed, possible reasons:\n"
+                                                     " - For your current LB lattice model, there is yet no implementation for class 'lbm::SplitSIMDSweep'.\n"
+                                                     "   Only D3Q19 with SRT or TRT (constant relaxation rates) and without forces is supported.\n"
+                                                     " - You are providing more than just one template argument to class 'lbm::SplitSIMDSweep'.\n"
+                                                     "   'lbm::SplitSIMDSweep' only needs the type of the lattice model - no further template arguments are required!" );
+};
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Stream-pull-collide sweep for D3Q19 SRT/TRT that is written with the types and functions of the simd module
+*
+*   Same algorithm as lbm::SplitPureSweep: For every x-line, density and velocity are calculated in a first pass and
+*   stored in small thread-local buffers, afterwards each pair of opposing directions is relaxed in a separate pass.
+*   Instead of relying on the auto-vectorization of the compiler, the passes operate on simd::double4_t. The best
+*   instruction set that is enabled at compile time is used (AVX-512, AVX2, AVX, SSE, QPX, or scalar emulation; see
+*   'simd/SIMD.h'). With the AVX-512 backend, blocks with an x-size that is a multiple of eight are processed with the
+*   8-wide simd::double8_t (full 512 bit registers) instead. If the x-lines of the fields are 64 byte aligned (e.g.,
+*   by using field::AllocateAligned< double, 64 >), all accesses without x-component are aligned, otherwise unaligned
+*   512 bit loads/stores are used.
+*
+*   - Loads of directions without x-component and all stores are aligned.
+*   - Optionally (default), the destination field is written with non-temporal (streaming) stores, avoiding the
+*     read-for-ownership of the destination cache lines. For blocks that fit into the cache, regular stores may be
+*     faster.
+*
+*   Requirements (checked at runtime): both PDF fields use the field::fzyx layout, every x-line of the fields starts
+*   at a 32 byte boundary (which is the default for fzyx fields, see field::AllocateAligned), and the number of cells
+*   in x-direction is a multiple of four. Only works with double precision (real_t == double).
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T >
+class SplitSIMDSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_< internal::SplitSIMDCollisionModel< typename LatticeModel_T::CollisionModel >,
+                                                                                  boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >,
+                                                                                  boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >
+                                                                 > >::type > :
+   public SweepBase< LatticeModel_T >
+{
+public:
+
+   static_assert( (boost::is_same< real_t, double >::value), "Only works with double precision!" );
+   static_assert( (boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >::value), "Only works with D3Q19!" );
+   static_assert( (boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >::value), "Only works without additional forces!" );
+   static_assert( LatticeModel_T::equilibriumAccuracyOrder == 2, "Only works for lattice models that require the equilibrium distribution to be order 2 accurate!" );
+
+   typedef typename SweepBase<LatticeModel_T>::PdfField_T  PdfField_T;
+   typedef typename LatticeModel_T::Stencil                Stencil;
+
+   // block has NO dst pdf field
+   SplitSIMDSweep( const BlockDataID & pdfField, const bool useStreamingStores = true ) :
+      SweepBase<LatticeModel_T>( pdfField ), useStreamingStores_( useStreamingStores ) {}
+
+   // every block has a dedicated dst pdf field
+   SplitSIMDSweep( const BlockDataID & src, const BlockDataID & dst, const bool useStreamingStores = true ) :
+      SweepBase<LatticeModel_T>( src, dst ), useStreamingStores_( useStreamingStores ) {}
+
+   void operator()( IBlock * const block );
+
+   /// Returns true if 'pdfField' meets the layout/alignment requirements of this sweep
+   static bool isVectorizable( const PdfField_T * const pdfField );
+
+private:
+
+   /// Returns true if the x-lines of 'pdfField' start at a 'alignment' byte boundary
+   static bool isAligned( const PdfField_T * const pdfField, const std::size_t alignment );
+
+   template< typename Vector_T >
+   void streamCollide( PdfField_T * const src, PdfField_T * const dst, const internal::SplitSIMDStoreMode storeMode ) const;
+
+   /// Relaxes a pair of opposing directions, 'cu' is the velocity projected onto the direction of 'fd'
+   template< typename Vector_T >
+   static inline void relax( typename Vector_T::type & fd, typename Vector_T::type & fi, const typename Vector_T::type & cu,
+                             const typename Vector_T::type & feqCommon, const typename Vector_T::type & rho, const typename Vector_T::type & w,
+                             const typename Vector_T::type & lambda_e, const typename Vector_T::type & lambda_d )
+   {
+      typedef typename Vector_T::type V;
+
+      const V half = Vector_T::make( 0.5 );
+
+      const V  sym_eq = w * ( feqCommon + Vector_T::make( 4.5 ) * rho * cu * cu );
+      const V asym_eq = w * Vector_T::make( 3.0 ) * rho * cu;
+
+      const V  sym_trm = lambda_e * ( half * ( fd + fi ) -  sym_eq );
+      const V asym_trm = lambda_d * ( half * ( fd - fi ) - asym_eq );
+
+      fd = fd - sym_trm - asym_trm;
+      fi = fi - sym_trm + asym_trm;
+   }
+
+   bool useStreamingStores_;
+};
+
+
+
+template< typename LatticeModel_T >
+bool SplitSIMDSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_< internal::SplitSIMDCollisionModel< typename LatticeModel_T::CollisionModel >,
+                                                                                  boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >,
+                                                                                  boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >
+                                                                 > >::type
+   >::isVectorizable( const PdfField_T * const pdfField )
+{
+   return pdfField->layout() == field::fzyx && ( pdfField->xSize() % uint_t(4) ) == uint_t(0) && isAligned( pdfField, std::size_t(32) );
+}
+
+
+
+template< typename LatticeModel_T >
+bool SplitSIMDSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_< internal::SplitSIMDCollisionModel< typename LatticeModel_T::CollisionModel >,
+                                                                                  boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >,
+                                                                                  boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >
+                                                                 > >::type
+   >::isAligned( const PdfField_T * const pdfField, const std::size_t alignment )
+{
+   const cell_idx_t vectorSize = cell_idx_c( alignment / sizeof( double ) );
+
+   return ( reinterpret_cast< std::size_t >( &pdfField->get( 0, 0, 0, 0 ) ) % alignment ) == std::size_t(0) &&
+          ( pdfField->yStride() % vectorSize ) == cell_idx_t(0) &&
+          ( pdfField->zStride() % vectorSize ) == cell_idx_t(0) &&
+          ( pdfField->fStride() % vectorSize ) == cell_idx_t(0);
+}
+
+
+
+template< typename LatticeModel_T >
+void SplitSIMDSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_< internal::SplitSIMDCollisionModel< typename LatticeModel_T::CollisionModel >,
+                                                                                  boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >,
+                                                                                  boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >
+                                                                 > >::type
+   >::operator()( IBlock * const block )
+{
+   PdfField_T * src( NULL );
+   PdfField_T * dst( NULL );
+
+   this->getFields( block, src, dst );
+
+   WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_CHECK( isVectorizable( src ) && isVectorizable( dst ),
+                   "lbm::SplitSIMDSweep requires PDF fields with fzyx layout, 32 byte aligned x-lines, and an x-size "
+                   "that is a multiple of 4 (x-size of the current block: " << src->xSize() << ")" );
+
+#ifdef WALBERLA_USE_AVX512
+   if( ( src->xSize() % uint_t(8) ) == uint_t(0) )
+   {
+      internal::SplitSIMDStoreMode storeMode = useStreamingStores_ ? internal::SPLIT_SIMD_STREAM_HALVES : internal::SPLIT_SIMD_STORE_UNALIGNED;
+      if( isAligned( dst, std::size_t(64) ) )
+         storeMode = useStreamingStores_ ? internal::SPLIT_SIMD_STREAM : internal::SPLIT_SIMD_STORE;
+
+      streamCollide< internal::SplitSIMDVector8 >( src, dst, storeMode );
+      src->swapDataPointers( dst );
+      return;
+   }
+#endif
+
+   streamCollide< internal::SplitSIMDVector4 >( src, dst, useStreamingStores_ ? internal::SPLIT_SIMD_STREAM : internal::SPLIT_SIMD_STORE );
+   src->swapDataPointers( dst );
+}
+
+
+
+template< typename LatticeModel_T >
+template< typename Vector_T >
+void SplitSIMDSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_< internal::SplitSIMDCollisionModel< typename LatticeModel_T::CollisionModel >,
+                                                                                  boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >,
+                                                                                  boost::is_same< typename LatticeModel_T::ForceModel::tag, force_model::None_tag >
+                                                                 > >::type
+   >::streamCollide( PdfField_T * const src, PdfField_T * const dst,
+                   const internal::SplitSIMDStoreMode storeMode ) const
+{
+   typedef typename Vector_T::type V;
+
+   const cell_idx_t width = cell_idx_c( Vector_T::width );
+
+   // constants used during stream/collide
+
+   const V lambda_e = Vector_T::make( internal::splitSIMDLambdaE( src->latticeModel().collisionModel() ) );
+   const V lambda_d = Vector_T::make( internal::splitSIMDLambdaD( src->latticeModel().collisionModel() ) );
+
+   const V w0 = Vector_T::make( 1.0 /  3.0 );
+   const V w1 = Vector_T::make( 1.0 / 18.0 );
+   const V w2 = Vector_T::make( 1.0 / 36.0 );
+
+   const V one          = Vector_T::make( 1.0 );
+   const V oneAndAHalf  = Vector_T::make( 1.5 );
+
+   const bool compressible = LatticeModel_T::compressible;
+
+   // loop constants
+
+   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+#endif
+   // temporaries, calculated by the first innermost loop
+
+   std::vector< double, simd::aligned_allocator< double, 64 > > velXBuffer( src->xSize() );
+   std::vector< double, simd::aligned_allocator< double, 64 > > velYBuffer( src->xSize() );
+   std::vector< double, simd::aligned_allocator< double, 64 > > velZBuffer( src->xSize() );
+   std::vector< double, simd::aligned_allocator< double, 64 > >  rhoBuffer( src->xSize() );
+   std::vector< double, simd::aligned_allocator< double, 64 > >  feqBuffer( src->xSize() );
+
+   double * WALBERLA_RESTRICT velX      = &velXBuffer[0];
+   double * WALBERLA_RESTRICT velY      = &velYBuffer[0];
+   double * WALBERLA_RESTRICT velZ      = &velZBuffer[0];
+   double * WALBERLA_RESTRICT rho       =  &rhoBuffer[0];
+   double * WALBERLA_RESTRICT feqCommon =  &feqBuffer[0];
+
+   WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+
+      using namespace stencil;
+
+      const double * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
+      const double * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
+      const double * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
+      const double * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
+      const double * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
+      const double * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
+      const double * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
+      const double * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
+      const double * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
+      const double * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
+      const double * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
+      const double * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
+      const double * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
+      const double * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
+      const double * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
+      const double * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
+      const double * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
+      const double * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
+      const double * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
+
+      double * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         const V fNE = Vector_T::loadUnaligned( pNE + x );
+         const V fN  = Vector_T::loadLine( pN + x );
+         const V fNW = Vector_T::loadUnaligned( pNW + x );
+         const V fW  = Vector_T::loadUnaligned( pW + x );
+         const V fSW = Vector_T::loadUnaligned( pSW + x );
+         const V fS  = Vector_T::loadLine( pS + x );
+         const V fSE = Vector_T::loadUnaligned( pSE + x );
+         const V fE  = Vector_T::loadUnaligned( pE + x );
+         const V fT  = Vector_T::loadLine( pT + x );
+         const V fTE = Vector_T::loadUnaligned( pTE + x );
+         const V fTN = Vector_T::loadLine( pTN + x );
+         const V fTW = Vector_T::loadUnaligned( pTW + x );
+         const V fTS = Vector_T::loadLine( pTS + x );
+         const V fB  = Vector_T::loadLine( pB + x );
+         const V fBE = Vector_T::loadUnaligned( pBE + x );
+         const V fBN = Vector_T::loadLine( pBN + x );
+         const V fBW = Vector_T::loadUnaligned( pBW + x );
+         const V fBS = Vector_T::loadLine( pBS + x );
+         const V fC  = Vector_T::loadLine( pC + x );
+
+         const V velX_trm = fE + fNE + fSE + fTE + fBE;
+         const V velY_trm = fN + fNW + fTN + fBN;
+         const V velZ_trm = fT + fTS + fTW;
+
+         const V rho_v = fC + fS + fW + fB + fSW + fBS + fBW + velX_trm + velY_trm + velZ_trm;
+
+         V ux = velX_trm - fW  - fNW - fSW - fTW - fBW;
+         V uy = velY_trm + fNE - fS  - fSW - fSE - fTS - fBS;
+         V uz = velZ_trm + fTN + fTE - fB  - fBN - fBS - fBW - fBE;
+
+         V feq;
+         if( compressible )
+         {
+            const V rho_inv = one / rho_v;
+            ux = rho_inv * ux;
+            uy = rho_inv * uy;
+            uz = rho_inv * uz;
+            feq = rho_v * ( one - oneAndAHalf * ( ux * ux + uy * uy + uz * uz ) );
+            Vector_T::storeBuffer( rho + x, rho_v );
+         }
+         else
+         {
+            feq = rho_v - oneAndAHalf * ( ux * ux + uy * uy + uz * uz );
+         }
+
+         Vector_T::storeBuffer( velX + x, ux );
+         Vector_T::storeBuffer( velY + x, uy );
+         Vector_T::storeBuffer( velZ + x, uz );
+         Vector_T::storeBuffer( feqCommon + x, feq );
+
+         Vector_T::store( dC + x, fC - lambda_e * ( fC - w0 * feq ), storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
+      double * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fNW = Vector_T::loadUnaligned( pNW + x );
+         V fSE = Vector_T::loadUnaligned( pSE + x );
+         relax< Vector_T >( fNW, fSE, Vector_T::loadBuffer( velY + x ) - Vector_T::loadBuffer( velX + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dNW + x, fNW, storeMode );
+         Vector_T::store( dSE + x, fSE, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
+      double * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fNE = Vector_T::loadUnaligned( pNE + x );
+         V fSW = Vector_T::loadUnaligned( pSW + x );
+         relax< Vector_T >( fNE, fSW, Vector_T::loadBuffer( velX + x ) + Vector_T::loadBuffer( velY + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dNE + x, fNE, storeMode );
+         Vector_T::store( dSW + x, fSW, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
+      double * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fTW = Vector_T::loadUnaligned( pTW + x );
+         V fBE = Vector_T::loadUnaligned( pBE + x );
+         relax< Vector_T >( fTW, fBE, Vector_T::loadBuffer( velZ + x ) - Vector_T::loadBuffer( velX + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dTW + x, fTW, storeMode );
+         Vector_T::store( dBE + x, fBE, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
+      double * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fTE = Vector_T::loadUnaligned( pTE + x );
+         V fBW = Vector_T::loadUnaligned( pBW + x );
+         relax< Vector_T >( fTE, fBW, Vector_T::loadBuffer( velX + x ) + Vector_T::loadBuffer( velZ + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dTE + x, fTE, storeMode );
+         Vector_T::store( dBW + x, fBW, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
+      double * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fTS = Vector_T::loadLine( pTS + x );
+         V fBN = Vector_T::loadLine( pBN + x );
+         relax< Vector_T >( fTS, fBN, Vector_T::loadBuffer( velZ + x ) - Vector_T::loadBuffer( velY + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dTS + x, fTS, storeMode );
+         Vector_T::store( dBN + x, fBN, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
+      double * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fTN = Vector_T::loadLine( pTN + x );
+         V fBS = Vector_T::loadLine( pBS + x );
+         relax< Vector_T >( fTN, fBS, Vector_T::loadBuffer( velY + x ) + Vector_T::loadBuffer( velZ + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w2, lambda_e, lambda_d );
+         Vector_T::store( dTN + x, fTN, storeMode );
+         Vector_T::store( dBS + x, fBS, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
+      double * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fN = Vector_T::loadLine( pN + x );
+         V fS = Vector_T::loadLine( pS + x );
+         relax< Vector_T >( fN, fS, Vector_T::loadBuffer( velY + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w1, lambda_e, lambda_d );
+         Vector_T::store( dN + x, fN, storeMode );
+         Vector_T::store( dS + x, fS, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
+      double * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fE = Vector_T::loadUnaligned( pE + x );
+         V fW = Vector_T::loadUnaligned( pW + x );
+         relax< Vector_T >( fE, fW, Vector_T::loadBuffer( velX + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w1, lambda_e, lambda_d );
+         Vector_T::store( dE + x, fE, storeMode );
+         Vector_T::store( dW + x, fW, storeMode );
+      }
+
+      double * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
+      double * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+
+      for( cell_idx_t x = 0; x < xSize; x += width )
+      {
+         V fT = Vector_T::loadLine( pT + x );
+         V fB = Vector_T::loadLine( pB + x );
+         relax< Vector_T >( fT, fB, Vector_T::loadBuffer( velZ + x ), Vector_T::loadBuffer( feqCommon + x ),
+                           compressible ? Vector_T::loadBuffer( rho + x ) : one, w1, lambda_e, lambda_d );
+         Vector_T::store( dT + x, fT, storeMode );
+         Vector_T::store( dB + x, fB, storeMode );
+      }
+
+   ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+
+   if( storeMode == internal::SPLIT_SIMD_STREAM || storeMode == internal::SPLIT_SIMD_STREAM_HALVES )
+      simd::stream_fence();
+
+#ifdef _OPENMP
+   }
+#endif
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
@@ -23,13 +23,17 @@
 
 #include "lbm/field/DensityVelocityCallback.h"
 #include "lbm/field/PdfField.h"
+#include "core/OpenMP.h"
+#include "core/cell/CellInterval.h"
 #include "core/debug/Debug.h"
+#include "domain_decomposition/BlockStorage.h"
 #include "domain_decomposition/IBlock.h"
 #include "field/EvaluationFilter.h"
 #include "field/Field.h"
 #include "field/SwapableCompare.h"
 #include "field/iterators/IteratorMacros.h"
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -65,7 +69,12 @@ public:
       src_( src ), dstFromBlockData_( true ), dst_( dst ), filter_( _filter ),
       densityVelocityIn_( _densityVelocityIn ), densityVelocityOut_( _densityVelocityOut ) {}
 
-   virtual ~SweepBase() { for( auto field = dstFields_.begin(); field != dstFields_.end(); ++field ) delete *field; }
+   virtual ~SweepBase()
+   {
+      for( auto fields = dstFields_.begin(); fields != dstFields_.end(); ++fields )
+         for( auto field = fields->second.begin(); field != fields->second.end(); ++field ) delete *field;
+      for( auto field = dedicatedDstFields_.begin(); field != dedicatedDstFields_.end(); ++field ) delete field->second;
+   }
 
    void filter( IBlock & block ) { filter_( block ); }
    bool filter( const cell_idx_t x, const cell_idx_t y, const cell_idx_t z ) const { return filter_(x,y,z); }
@@ -87,9 +96,11 @@ public:
 protected:
 
    inline PdfField_T * getSrcField( IBlock * const block ) const;
-          PdfField_T * getDstField( IBlock * const block, PdfField_T * const src );
+          PdfField_T * getDstField( IBlock * const block, PdfField_T * const src, const bool dedicated = false );
 
-   inline void getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst );
+   inline void getFields( IBlock * const block, PdfField_T * & src, PdfField_T * & dst, const bool dedicated = false );
+
+   static void getFrame( const CellInterval & interval, std::vector< CellInterval > & frame );
 
 
 
@@ -97,7 +108,8 @@ protected:
 
    const bool dstFromBlockData_;
    const BlockDataID dst_;
-   std::set< PdfField_T *, field::SwapableCompare< PdfField_T * > > dstFields_;
+   std::map< int, std::set< PdfField_T *, field::SwapableCompare< PdfField_T * > > > dstFields_; // per OpenMP thread
+   std::map< PdfField_T *, PdfField_T * > dedicatedDstFields_; // one temporary field per src field (= per block)
 
    Filter_T filter_;
    DensityVelocityIn_T densityVelocityIn_;
@@ -123,7 +135,8 @@ SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >
 
 template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
 typename SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::PdfField_T *
-SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getDstField( IBlock * const block, PdfField_T * const src )
+SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getDstField( IBlock * const block, PdfField_T * const src,
+                                                                                                 const bool dedicated )
 {
    WALBERLA_ASSERT_NOT_NULLPTR( block );
    WALBERLA_ASSERT_NOT_NULLPTR( src );
@@ -135,8 +148,88 @@ SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >
       return dst;
    }
 
-   auto it = dstFields_.find( src );
-   if( it != dstFields_.end() )
+   // The temporary fields in 'dstFields_' are shared by all blocks with equally sized fields, i.e., their content is
+   // lost as soon as the next block is processed. Sweeps that are split into multiple passes over all blocks (see
+   // 'getFrame') must therefore use a dedicated temporary field for every block.
+   if( dedicated )
+   {
+      PdfField_T * dst( NULL );
+
+#ifdef _OPENMP
+      #pragma omp critical( walberla_lbm_sweep_base_dst_fields )
+#endif
+      {
+         auto it = dedicatedDstFields_.find( src );
+         if( it != dedicatedDstFields_.end() )
+         {
+            // 'src' may be a new field that was allocated at the address of a field that no longer exists (e.g. after
+            // the block structure was refreshed) -> the temporary field must be recreated if it does not match 'src'
+            if( it->second->xyzSize() == src->xyzSize() && it->second->layout() == src->layout() &&
+                it->second->nrOfGhostLayers() == src->nrOfGhostLayers() )
+               dst = it->second;
+            else
+            {
+               delete it->second;
+               dedicatedDstFields_.erase( it );
+            }
+         }
+      }
+      if( dst != NULL )
+         return dst;
+
+      dst = src->cloneUninitialized();
+      WALBERLA_ASSERT_NOT_NULLPTR( dst );
+
+      WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ( dst,
+         for( uint_t f = uint_t(0); f < LatticeModel_T::Stencil::Size; ++f )
+            dst->get(x,y,z,f) = std::numeric_limits< typename PdfField_T::value_type >::quiet_NaN();
+      )
+
+#ifdef _OPENMP
+      #pragma omp critical( walberla_lbm_sweep_base_dst_fields )
+#endif
+      {
+         // A new temporary field is only required for a new block. If blocks were removed in the meantime, their
+         // temporary fields are released here.
+         std::set< PdfField_T * > srcFields;
+         const BlockStorage & blocks = block->getBlockStorage();
+         for( auto it = blocks.begin(); it != blocks.end(); ++it )
+            srcFields.insert( const_cast< PdfField_T * >( it->getData< PdfField_T >( src_ ) ) );
+
+         for( auto it = dedicatedDstFields_.begin(); it != dedicatedDstFields_.end(); )
+         {
+            if( srcFields.find( it->first ) == srcFields.end() )
+            {
+               delete it->second;
+               dedicatedDstFields_.erase( it++ );
+            }
+            else
+               ++it;
+         }
+
+         dedicatedDstFields_[ src ] = dst;
+      }
+
+      return dst;
+   }
+
+   // The shared temporary fields are only in use while one block is processed. If the sweep is executed for different
+   // blocks at the same time (e.g. by a timeloop::TaskSweepTimeloop, which runs sweeps as OpenMP tasks), every thread
+   // needs its own temporary fields.
+   std::set< PdfField_T *, field::SwapableCompare< PdfField_T * > > * dstFields( NULL );
+
+#ifdef _OPENMP
+   const int thread = omp_get_thread_num();
+   #pragma omp critical( walberla_lbm_sweep_base_dst_fields )
+   {
+      dstFields = &( dstFields_[ thread ] );
+   }
+#else
+   dstFields = &( dstFields_[0] );
+#endif
+
+   auto it = dstFields->find( src );
+   if( it != dstFields->end() )
    {
 #ifndef NDEBUG
       std::fill( (*it)->beginWithGhostLayer(), (*it)->end(), std::numeric_limits< typename PdfField_T::value_type >::quiet_NaN() );
@@ -153,7 +246,7 @@ SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >
       for( uint_t f = uint_t(0); f < LatticeModel_T::Stencil::Size; ++f )
          dst->get(x,y,z,f) = std::numeric_limits< typename PdfField_T::value_type >::quiet_NaN();
    )
-   dstFields_.insert( dst );
+   dstFields->insert( dst );
 
    return dst;
 }
@@ -162,12 +255,13 @@ SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >
 
 template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
 inline void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getFields( IBlock * const block,
-                                                                                                         PdfField_T * & src, PdfField_T * & dst )
+                                                                                                         PdfField_T * & src, PdfField_T * & dst,
+                                                                                                         const bool dedicated )
 {
    WALBERLA_ASSERT_NOT_NULLPTR( block );
 
    src = getSrcField( block );
-   dst = getDstField( block, src );
+   dst = getDstField( block, src, dedicated );
 
    WALBERLA_ASSERT_NOT_NULLPTR( src );
    WALBERLA_ASSERT_NOT_NULLPTR( dst );
@@ -177,5 +271,37 @@ inline void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVel
 
 
 
+/// Splits 'interval' into its outermost layer of cells (at most six non-overlapping slabs, returned via 'frame').
+/// The remaining part is 'interval' shrunk by one cell in every direction. If this inner part is empty, 'frame'
+/// consists of 'interval' itself.
+template< typename LatticeModel_T, typename Filter_T, typename DensityVelocityIn_T, typename DensityVelocityOut_T >
+void SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::getFrame( const CellInterval & interval,
+                                                                                                std::vector< CellInterval > & frame )
+{
+   frame.clear();
+
+   CellInterval inner( interval );
+   inner.expand( cell_idx_t(-1) );
+
+   if( inner.empty() )
+   {
+      if( !interval.empty() )
+         frame.push_back( interval );
+      return;
+   }
+
+   // bottom and top: complete xy-planes
+   frame.push_back( CellInterval( interval.xMin(), interval.yMin(), interval.zMin(), interval.xMax(), interval.yMax(), interval.zMin() ) );
+   frame.push_back( CellInterval( interval.xMin(), interval.yMin(), interval.zMax(), interval.xMax(), interval.yMax(), interval.zMax() ) );
+   // south and north: xz-planes without bottom and top
+   frame.push_back( CellInterval( interval.xMin(), interval.yMin(), inner.zMin(), interval.xMax(), interval.yMin(), inner.zMax() ) );
+   frame.push_back( CellInterval( interval.xMin(), interval.yMax(), inner.zMin(), interval.xMax(), interval.yMax(), inner.zMax() ) );
+   // west and east: remaining yz-planes
+   frame.push_back( CellInterval( interval.xMin(), inner.yMin(), inner.zMin(), interval.xMin(), inner.yMax(), inner.zMax() ) );
+   frame.push_back( CellInterval( interval.xMax(), inner.yMin(), inner.zMin(), interval.xMax(), inner.yMax(), inner.zMax() ) );
+}
+
+
+
 } // namespace lbm
 } // namespace walberla
@@ -70,6 +70,51 @@ template< typename Kernel >
 inline CollideSweep< Kernel > makeCollideSweep( const shared_ptr< Kernel > & kernel ) { return CollideSweep<Kernel>( kernel ); }
 
 
+/// Calls 'inner' of the kernel, i.e., performs the part of the stream & collide step that does not depend on the ghost
+/// layers. Must be followed by an OuterSweep for the same kernel (see timeloop::addCommunicationOverlap).
+template< typename Kernel >
+class InnerSweep
+{
+public:
+
+   InnerSweep( const shared_ptr< Kernel > & kernel ) : kernel_( kernel ) {}
+
+   void operator()( IBlock * const block )
+   {
+      kernel_->inner( block );
+   }
+
+private:
+
+   shared_ptr< Kernel > kernel_;
+};
+
+template< typename Kernel >
+inline InnerSweep< Kernel > makeInnerSweep( const shared_ptr< Kernel > & kernel ) { return InnerSweep<Kernel>( kernel ); }
+
+
+/// Calls 'outer' of the kernel, i.e., finishes the stream & collide step that was started by an InnerSweep
+template< typename Kernel >
+class OuterSweep
+{
+public:
+
+   OuterSweep( const shared_ptr< Kernel > & kernel ) : kernel_( kernel ) {}
+
+   void operator()( IBlock * const block )
+   {
+      kernel_->outer( block );
+   }
+
+private:
+
+   shared_ptr< Kernel > kernel_;
+};
+
+template< typename Kernel >
+inline OuterSweep< Kernel > makeOuterSweep( const shared_ptr< Kernel > & kernel ) { return OuterSweep<Kernel>( kernel ); }
+
+
 
 } // namespace lbm
 } // namespace walberla
@@ -0,0 +1,199 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TemporalBlockingSweep.h
+//! \ingroup lbm
+//! \brief Sweep that fuses several LBM time steps using wide ghost layers and a wavefront along z
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "lbm/sweeps/SweepBase.h"
+#include "lbm/sweeps/cell_operations/DefaultCellOperation.h"
+
+#include "core/OpenMP.h"
+#include "core/debug/CheckFunctions.h"
+
+
+namespace walberla {
+namespace lbm {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Performs 'timesteps' stream & collide steps per call by traversing each block with a wavefront
+*
+*   The PDF field must have at least 'timesteps' ghost layers that are all synchronized before the sweep is called,
+*   for example with a blockforest::communication::UniformBufferedScheme< stencil::D3Q27 > and a
+*   field::communication::PackInfo< PdfField_T > (which communicates all ghost layers). Consequently, only one
+*   ghost layer exchange is required every 'timesteps' time steps. Time step t (0 <= t < timesteps) updates the
+*   interior of the block plus the innermost (timesteps - 1 - t) ghost layers, i.e., the redundantly computed region
+*   shrinks by one layer with every step.
+*
+*   Within one call, the block is traversed plane by plane in z-direction. At wavefront position p, time step t is
+*   applied to plane z = p - t (for t = 0, 1, ..., timesteps-1). All data required by a plane is therefore still
+*   present in the cache as long as about 2 * (timesteps + 2) xy-planes of the PDF field fit into the cache - choose
+*   the x- and y-size of the blocks accordingly. The two PDF fields (src/dst) are sufficient: when plane z is written
+*   in time step t, all readers of the previous content of plane z (time step t-2) have already been processed.
+*
+*   The collision and streaming of a single cell is delegated to 'CellOperation' (by default lbm::DefaultCellOperation,
+*   see ActiveCellSweep). Boundary handling cannot be executed between the fused time steps, the sweep is therefore
+*   meant for domains that do not require boundary handling (e.g., periodic domains).
+*
+*   Usage (see makeTemporalBlockingSweep):
+*   \code
+*   SweepTimeloop timeloop( blocks->getBlockStorage(), timesteps / k );
+*
+*   blockforest::communication::UniformBufferedScheme< stencil::D3Q27 > communication( blocks );
+*   communication.addPackInfo( make_shared< field::communication::PackInfo< PdfField_T > >( pdfFieldId ) );
+*
+*   timeloop.add() << BeforeFunction( communication, "communication" )
+*                  << Sweep( makeSharedSweep( lbm::makeTemporalBlockingSweep< LatticeModel_T >( pdfFieldId, k ) ), "LB stream & collide" );
+*   \endcode
+*/
+//**********************************************************************************************************************
+
+template< typename LatticeModel_T, typename CellOperation = DefaultCellOperation< LatticeModel_T > >
+class TemporalBlockingSweep : public SweepBase< LatticeModel_T >
+{
+public:
+
+   typedef typename SweepBase< LatticeModel_T >::PdfField_T  PdfField_T;
+
+   // block has NO dst pdf field
+   TemporalBlockingSweep( const CellOperation & op, const BlockDataID & pdfField, const uint_t timesteps ) :
+      SweepBase< LatticeModel_T >( pdfField ), cellOperation_( op ), timesteps_( timesteps )
+   {
+      WALBERLA_CHECK_GREATER( timesteps_, uint_t(0) );
+   }
+
+   // every block has a dedicated dst pdf field
+   TemporalBlockingSweep( const CellOperation & op, const BlockDataID & src, const BlockDataID & dst, const uint_t timesteps ) :
+      SweepBase< LatticeModel_T >( src, dst ), cellOperation_( op ), timesteps_( timesteps )
+   {
+      WALBERLA_CHECK_GREATER( timesteps_, uint_t(0) );
+   }
+
+   virtual ~TemporalBlockingSweep() {}
+
+   const CellOperation & getCellOperation() const { return cellOperation_; }
+         CellOperation & getCellOperation()       { return cellOperation_; }
+
+   /// number of LBM time steps that are performed during one call of the sweep
+   uint_t getTimesteps() const { return timesteps_; }
+
+   void operator()( IBlock * const block );
+
+private:
+
+   void plane( PdfField_T * const src, PdfField_T * const dst, const cell_idx_t z, const cell_idx_t layers ) const;
+
+   CellOperation cellOperation_;
+   uint_t timesteps_;
+};
+
+
+
+template< typename LatticeModel_T, typename CellOperation >
+void TemporalBlockingSweep< LatticeModel_T, CellOperation >::plane( PdfField_T * const src, PdfField_T * const dst,
+                                                                    const cell_idx_t z, const cell_idx_t layers ) const
+{
+   const cell_idx_t xEnd = cell_idx_c( src->xSize() ) + layers;
+   const cell_idx_t yEnd = cell_idx_c( src->ySize() ) + layers;
+
+#ifdef _OPENMP
+   const int iyBegin = int_c( -layers );
+   const int iyEnd   = int_c( yEnd );
+   #pragma omp parallel for schedule(static)
+   for( int iy = iyBegin; iy < iyEnd; ++iy ) {
+      const cell_idx_t y = cell_idx_c( iy );
+#else
+   for( cell_idx_t y = -layers; y < yEnd; ++y ) {
+#endif
+      for( cell_idx_t x = -layers; x < xEnd; ++x )
+         cellOperation_( src, dst, x, y, z );
+   }
+}
+
+
+
+template< typename LatticeModel_T, typename CellOperation >
+void TemporalBlockingSweep< LatticeModel_T, CellOperation >::operator()( IBlock * const block )
+{
+   PdfField_T * src( NULL );
+   PdfField_T * dst( NULL );
+
+   this->getFields( block, src, dst );
+
+   WALBERLA_CHECK_GREATER_EQUAL( src->nrOfGhostLayers(), timesteps_,
+                                 "lbm::TemporalBlockingSweep: fusing " << timesteps_ << " time steps requires a PDF field with at least "
+                                 << timesteps_ << " ghost layers!" );
+
+   const auto & lm = src->latticeModel();
+   dst->resetLatticeModel( lm ); /* required so that member functions for getting density and equilibrium velocity can be called for dst! */
+
+   cellOperation_.configure( lm );
+
+   const cell_idx_t k     = cell_idx_c( timesteps_ );
+   const cell_idx_t zSize = cell_idx_c( src->zSize() );
+
+   // wavefront: at position p, time step t is applied to plane p - t, which requires the planes p - t - 1 to p - t + 1
+   // of time step t - 1 (processed at positions p - 2 to p)
+
+   for( cell_idx_t p = -( k - cell_idx_t(1) ); p < zSize + k - cell_idx_t(1); ++p )
+   {
+      for( cell_idx_t t = cell_idx_t(0); t < k; ++t )
+      {
+         const cell_idx_t layers = k - cell_idx_t(1) - t;
+         const cell_idx_t z = p - t;
+
+         if( z < -layers || z >= zSize + layers )
+            continue;
+
+         if( ( t & cell_idx_t(1) ) == cell_idx_t(0) )
+            plane( src, dst, z, layers );
+         else
+            plane( dst, src, z, layers );
+      }
+   }
+
+   if( ( timesteps_ & uint_t(1) ) == uint_t(1) )
+      src->swapDataPointers( dst );
+}
+
+
+
+template< typename LatticeModel_T >
+shared_ptr< TemporalBlockingSweep< LatticeModel_T > >
+makeTemporalBlockingSweep( const BlockDataID & pdfFieldId, const uint_t timesteps )
+{
+   typedef TemporalBlockingSweep< LatticeModel_T > Sweep_T;
+   return make_shared< Sweep_T >( DefaultCellOperation< LatticeModel_T >(), pdfFieldId, timesteps );
+}
+
+template< typename LatticeModel_T >
+shared_ptr< TemporalBlockingSweep< LatticeModel_T > >
+makeTemporalBlockingSweep( const BlockDataID & src, const BlockDataID & dst, const uint_t timesteps )
+{
+   typedef TemporalBlockingSweep< LatticeModel_T > Sweep_T;
+   return make_shared< Sweep_T >( DefaultCellOperation< LatticeModel_T >(), src, dst, timesteps );
+}
+
+
+
+} // namespace lbm
+} // namespace walberla
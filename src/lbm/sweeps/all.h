@@ -24,9 +24,14 @@
 
 #include "ActiveCellSweep.h"
 #include "CellwiseSweep.h"
+#include "InPlaceSweep.h"
+#include "InPlaceTimestep.h"
+#include "LocalCollision.h"
 #include "SplitPureSweep.h"
+#include "SplitSIMDSweep.h"
 #include "SplitSweep.h"
 #include "SweepWrappers.h"
+#include "TemporalBlockingSweep.h"
 
 #include "cell_operations/AdvectionDiffusionCellOperation.h"
 #include "cell_operations/DefaultCellOperation.h"
@@ -90,10 +90,13 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_PURE_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval );
 };
 
 template< typename LatticeModel_T >
@@ -103,14 +106,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::not_< boost::mpl::bool_< LatticeModel_T::compressible > >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )                                       
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -132,7 +134,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -148,31 +151,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -191,8 +194,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = pC[x] * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -204,8 +207,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = pSW[x] - sym_NE_SW + asym_NE_SW;
          )
 
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
 
          X_LOOP
          (
@@ -217,8 +220,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dNW[x] = pNW[x] - sym_SE_NW + asym_SE_NW;
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -230,8 +233,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = pBW[x] - sym_TE_BW + asym_TE_BW;
          )
 
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
 
          X_LOOP
          (
@@ -243,8 +246,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTW[x] = pTW[x] - sym_BE_TW + asym_BE_TW;
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -256,8 +259,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = pBS[x] - sym_TN_BS + asym_TN_BS;
          )
 
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
 
          X_LOOP
          (
@@ -269,8 +272,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTS[x] = pTS[x] - sym_BN_TS + asym_BN_TS;
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -281,8 +284,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = pS[x] - sym_N_S + asym_N_S;
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -293,8 +296,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = pW[x] - sym_E_W + asym_E_W;
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -305,35 +308,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = pB[x] - sym_T_B + asym_T_B;
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -347,124 +350,124 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             feq_common[x] = rho - real_t(1.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
+            dst->get(xMin+x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0 * feq_common[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z, Stencil::idx[NE]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z, Stencil::idx[SW]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z, Stencil::idx[NE]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z, Stencil::idx[SW]);
 
             const real_t velXPY = velX[x] + velY[x];
             const real_t  sym_NE_SW = lambda_e_scaled * ( dd_tmp_NE + dd_tmp_SW - fac2 * velXPY * velXPY - t2x2 * feq_common[x] );
             const real_t asym_NE_SW = lambda_d_scaled * ( dd_tmp_NE - dd_tmp_SW - real_t(3.0) * t2x2 * velXPY );
 
-            dst->get( x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
-            dst->get( x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
+            dst->get(xMin+x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
+            dst->get(xMin+x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z, Stencil::idx[SE]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z, Stencil::idx[NW]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z, Stencil::idx[SE]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z, Stencil::idx[NW]);
 
             const real_t velXMY = velX[x] - velY[x];
             const real_t  sym_SE_NW = lambda_e_scaled * ( dd_tmp_SE + dd_tmp_NW - fac2 * velXMY * velXMY - t2x2 * feq_common[x] );
             const real_t asym_SE_NW = lambda_d_scaled * ( dd_tmp_SE - dd_tmp_NW - real_t(3.0) * t2x2 * velXMY );
 
-            dst->get( x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
-            dst->get( x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
+            dst->get(xMin+x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
+            dst->get(xMin+x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TE = src->get(x-1, y, z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_BW = src->get(x+1, y, z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y, z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y, z+1, Stencil::idx[BW]);
 
             const real_t velXPZ = velX[x] + velZ[x];
             const real_t  sym_TE_BW = lambda_e_scaled * ( dd_tmp_TE + dd_tmp_BW - fac2 * velXPZ * velXPZ - t2x2 * feq_common[x] );
             const real_t asym_TE_BW = lambda_d_scaled * ( dd_tmp_TE - dd_tmp_BW - real_t(3.0) * t2x2 * velXPZ );
 
-            dst->get( x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
-            dst->get( x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
+            dst->get(xMin+x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
+            dst->get(xMin+x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BE = src->get(x-1, y, z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_TW = src->get(x+1, y, z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y, z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y, z-1, Stencil::idx[TW]);
 
             const real_t velXMZ = velX[x] - velZ[x];
             const real_t  sym_BE_TW = lambda_e_scaled * ( dd_tmp_BE + dd_tmp_TW - fac2 * velXMZ * velXMZ - t2x2 * feq_common[x] );
             const real_t asym_BE_TW = lambda_d_scaled * ( dd_tmp_BE - dd_tmp_TW - real_t(3.0) * t2x2 * velXMZ );
 
-            dst->get( x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
-            dst->get( x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
+            dst->get(xMin+x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
+            dst->get(xMin+x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TN = src->get(x, y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_BS = src->get(x, y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_TN = src->get(xMin+x, y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_BS = src->get(xMin+x, y+1, z+1, Stencil::idx[BS]);
 
             const real_t velYPZ = velY[x] + velZ[x];
             const real_t  sym_TN_BS = lambda_e_scaled * ( dd_tmp_TN + dd_tmp_BS - fac2 * velYPZ * velYPZ - t2x2 * feq_common[x] );
             const real_t asym_TN_BS = lambda_d_scaled * ( dd_tmp_TN - dd_tmp_BS - real_t(3.0) * t2x2 * velYPZ );
 
-            dst->get( x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
-            dst->get( x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
+            dst->get(xMin+x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
+            dst->get(xMin+x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BN = src->get(x, y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_TS = src->get(x, y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_BN = src->get(xMin+x, y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_TS = src->get(xMin+x, y+1, z-1, Stencil::idx[TS]);
 
             const real_t velYMZ = velY[x] - velZ[x];
             const real_t  sym_BN_TS = lambda_e_scaled * ( dd_tmp_BN + dd_tmp_TS - fac2 * velYMZ * velYMZ - t2x2 * feq_common[x] );
             const real_t asym_BN_TS = lambda_d_scaled * ( dd_tmp_BN - dd_tmp_TS - real_t(3.0) * t2x2 * velYMZ );
 
-            dst->get( x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
-            dst->get( x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
+            dst->get(xMin+x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
+            dst->get(xMin+x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_N  = src->get(x, y-1, z, Stencil::idx[N]);
-            const real_t dd_tmp_S  = src->get(x, y+1, z, Stencil::idx[S]);
+            const real_t dd_tmp_N  = src->get(xMin+x, y-1, z, Stencil::idx[N]);
+            const real_t dd_tmp_S  = src->get(xMin+x, y+1, z, Stencil::idx[S]);
 
             const real_t  sym_N_S = lambda_e_scaled * ( dd_tmp_N + dd_tmp_S - fac1 * velY[x] * velY[x] - t1x2 * feq_common[x] );
             const real_t asym_N_S = lambda_d_scaled * ( dd_tmp_N - dd_tmp_S - real_t(3.0) * t1x2 * velY[x] );
 
-            dst->get( x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
-            dst->get( x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
+            dst->get(xMin+x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
+            dst->get(xMin+x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_E  = src->get(x-1, y, z, Stencil::idx[E]);
-            const real_t dd_tmp_W  = src->get(x+1, y, z, Stencil::idx[W]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y, z, Stencil::idx[E]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y, z, Stencil::idx[W]);
 
             const real_t  sym_E_W = lambda_e_scaled * ( dd_tmp_E + dd_tmp_W - fac1 * velX[x] * velX[x] - t1x2 * feq_common[x] );
             const real_t asym_E_W = lambda_d_scaled * ( dd_tmp_E - dd_tmp_W - real_t(3.0) * t1x2 * velX[x] );
 
-            dst->get( x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
-            dst->get( x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
+            dst->get(xMin+x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
+            dst->get(xMin+x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_T  = src->get(x, y, z-1, Stencil::idx[T]);
-            const real_t dd_tmp_B  = src->get(x, y, z+1, Stencil::idx[B]);
+            const real_t dd_tmp_T  = src->get(xMin+x, y, z-1, Stencil::idx[T]);
+            const real_t dd_tmp_B  = src->get(xMin+x, y, z+1, Stencil::idx[B]);
 
             const real_t  sym_T_B = lambda_e_scaled * ( dd_tmp_T + dd_tmp_B - fac1 * velZ[x] * velZ[x] - t1x2 * feq_common[x] );
             const real_t asym_T_B = lambda_d_scaled * ( dd_tmp_T - dd_tmp_B - real_t(3.0) * t1x2 * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
-            dst->get( x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
+            dst->get(xMin+x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
+            dst->get(xMin+x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -475,8 +478,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
@@ -888,10 +889,13 @@ public:
    SplitPureSweep( const BlockDataID & src, const BlockDataID & dst ) :
       SweepBase<LatticeModel_T>( src, dst ) {}
 
-   void operator()( IBlock * const block );
+   WALBERLA_LBM_SPLIT_PURE_SWEEP_INNER_OUTER()
 
    void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
    void collide( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+protected:
+
+   void streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval );
 };
 
 template< typename LatticeModel_T >
@@ -901,14 +905,13 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
                                                                                   boost::mpl::bool_< LatticeModel_T::compressible >,
                                                                                   boost::is_same< typename LatticeModel_T::ForceModel::tag,
                                                                                                   force_model::None_tag > > >::type
-   >::operator()( IBlock * const block )
+   >::streamCollideInterval( PdfField_T * const src, PdfField_T * const dst, const CellInterval & interval )
 {
-   PdfField_T * src( NULL );
-   PdfField_T * dst( NULL );
-
-   this->getFields( block, src, dst );
+   WALBERLA_ASSERT_NOT_NULLPTR( src );
+   WALBERLA_ASSERT_NOT_NULLPTR( dst );
 
    WALBERLA_ASSERT_GREATER_EQUAL( src->nrOfGhostLayers(), 1 );
+   WALBERLA_ASSERT( dst->xyzSize().contains( interval ) );
 
    // constants used during stream/collide
 
@@ -928,7 +931,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    // loop constants
 
-   const cell_idx_t xSize = cell_idx_c( src->xSize() );
+   const cell_idx_t xMin  = interval.xMin();
+   const cell_idx_t xSize = cell_idx_c( interval.xSize() );
 
 #ifdef _OPENMP
    #pragma omp parallel
@@ -949,31 +953,31 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
    if( src->layout() == field::fzyx && dst->layout() == field::fzyx )
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
-         real_t * WALBERLA_RESTRICT pNE = &src->get(-1, y-1, z  , Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT pN  = &src->get(0 , y-1, z  , Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT pNW = &src->get(+1, y-1, z  , Stencil::idx[NW]);
-         real_t * WALBERLA_RESTRICT pW  = &src->get(+1, y  , z  , Stencil::idx[W]);
-         real_t * WALBERLA_RESTRICT pSW = &src->get(+1, y+1, z  , Stencil::idx[SW]);
-         real_t * WALBERLA_RESTRICT pS  = &src->get(0 , y+1, z  , Stencil::idx[S]);
-         real_t * WALBERLA_RESTRICT pSE = &src->get(-1, y+1, z  , Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT pE  = &src->get(-1, y  , z  , Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT pT  = &src->get(0 , y  , z-1, Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT pTE = &src->get(-1, y  , z-1, Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT pTN = &src->get(0 , y-1, z-1, Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT pTW = &src->get(+1, y  , z-1, Stencil::idx[TW]);
-         real_t * WALBERLA_RESTRICT pTS = &src->get(0 , y+1, z-1, Stencil::idx[TS]);
-         real_t * WALBERLA_RESTRICT pB  = &src->get(0 , y  , z+1, Stencil::idx[B]);
-         real_t * WALBERLA_RESTRICT pBE = &src->get(-1, y  , z+1, Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT pBN = &src->get(0 , y-1, z+1, Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT pBW = &src->get(+1, y  , z+1, Stencil::idx[BW]);
-         real_t * WALBERLA_RESTRICT pBS = &src->get(0 , y+1, z+1, Stencil::idx[BS]);
-         real_t * WALBERLA_RESTRICT pC  = &src->get(0 , y  , z  , Stencil::idx[C]);
-
-         real_t * WALBERLA_RESTRICT dC = &dst->get(0,y,z,Stencil::idx[C]);
+         real_t * WALBERLA_RESTRICT pNE = &src->get(xMin-1, y-1, z  , Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT pN  = &src->get(xMin  , y-1, z  , Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT pNW = &src->get(xMin+1, y-1, z  , Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT pW  = &src->get(xMin+1, y  , z  , Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT pSW = &src->get(xMin+1, y+1, z  , Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT pS  = &src->get(xMin  , y+1, z  , Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT pSE = &src->get(xMin-1, y+1, z  , Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT pE  = &src->get(xMin-1, y  , z  , Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT pT  = &src->get(xMin  , y  , z-1, Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT pTE = &src->get(xMin-1, y  , z-1, Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT pTN = &src->get(xMin  , y-1, z-1, Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT pTW = &src->get(xMin+1, y  , z-1, Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT pTS = &src->get(xMin  , y+1, z-1, Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT pB  = &src->get(xMin  , y  , z+1, Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT pBE = &src->get(xMin-1, y  , z+1, Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT pBN = &src->get(xMin  , y-1, z+1, Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT pBW = &src->get(xMin+1, y  , z+1, Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT pBS = &src->get(xMin  , y+1, z+1, Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT pC  = &src->get(xMin  , y  , z  , Stencil::idx[C]);
+
+         real_t * WALBERLA_RESTRICT dC = &dst->get(xMin,y,z,Stencil::idx[C]);
 
          X_LOOP
          (
@@ -998,8 +1002,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dC[x] = pC[x] * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
          )
 
-         real_t * WALBERLA_RESTRICT dNE = &dst->get(0,y,z,Stencil::idx[NE]);
-         real_t * WALBERLA_RESTRICT dSW = &dst->get(0,y,z,Stencil::idx[SW]);
+         real_t * WALBERLA_RESTRICT dNE = &dst->get(xMin,y,z,Stencil::idx[NE]);
+         real_t * WALBERLA_RESTRICT dSW = &dst->get(xMin,y,z,Stencil::idx[SW]);
 
          X_LOOP
          (
@@ -1011,8 +1015,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dSW[x] = pSW[x] - sym_NE_SW + asym_NE_SW;
          )
 
-         real_t * WALBERLA_RESTRICT dSE = &dst->get(0,y,z,Stencil::idx[SE]);
-         real_t * WALBERLA_RESTRICT dNW = &dst->get(0,y,z,Stencil::idx[NW]);
+         real_t * WALBERLA_RESTRICT dSE = &dst->get(xMin,y,z,Stencil::idx[SE]);
+         real_t * WALBERLA_RESTRICT dNW = &dst->get(xMin,y,z,Stencil::idx[NW]);
 
          X_LOOP
          (
@@ -1024,8 +1028,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dNW[x] = pNW[x] - sym_SE_NW + asym_SE_NW;
          )
 
-         real_t * WALBERLA_RESTRICT dTE = &dst->get(0,y,z,Stencil::idx[TE]);
-         real_t * WALBERLA_RESTRICT dBW = &dst->get(0,y,z,Stencil::idx[BW]);
+         real_t * WALBERLA_RESTRICT dTE = &dst->get(xMin,y,z,Stencil::idx[TE]);
+         real_t * WALBERLA_RESTRICT dBW = &dst->get(xMin,y,z,Stencil::idx[BW]);
 
          X_LOOP
          (
@@ -1037,8 +1041,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBW[x] = pBW[x] - sym_TE_BW + asym_TE_BW;
          )
 
-         real_t * WALBERLA_RESTRICT dBE = &dst->get(0,y,z,Stencil::idx[BE]);
-         real_t * WALBERLA_RESTRICT dTW = &dst->get(0,y,z,Stencil::idx[TW]);
+         real_t * WALBERLA_RESTRICT dBE = &dst->get(xMin,y,z,Stencil::idx[BE]);
+         real_t * WALBERLA_RESTRICT dTW = &dst->get(xMin,y,z,Stencil::idx[TW]);
 
          X_LOOP
          (
@@ -1050,8 +1054,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTW[x] = pTW[x] - sym_BE_TW + asym_BE_TW;
          )
 
-         real_t * WALBERLA_RESTRICT dTN = &dst->get(0,y,z,Stencil::idx[TN]);
-         real_t * WALBERLA_RESTRICT dBS = &dst->get(0,y,z,Stencil::idx[BS]);
+         real_t * WALBERLA_RESTRICT dTN = &dst->get(xMin,y,z,Stencil::idx[TN]);
+         real_t * WALBERLA_RESTRICT dBS = &dst->get(xMin,y,z,Stencil::idx[BS]);
 
          X_LOOP
          (
@@ -1063,8 +1067,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dBS[x] = pBS[x] - sym_TN_BS + asym_TN_BS;
          )
 
-         real_t * WALBERLA_RESTRICT dBN = &dst->get(0,y,z,Stencil::idx[BN]);
-         real_t * WALBERLA_RESTRICT dTS = &dst->get(0,y,z,Stencil::idx[TS]);
+         real_t * WALBERLA_RESTRICT dBN = &dst->get(xMin,y,z,Stencil::idx[BN]);
+         real_t * WALBERLA_RESTRICT dTS = &dst->get(xMin,y,z,Stencil::idx[TS]);
 
          X_LOOP
          (
@@ -1076,8 +1080,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dTS[x] = pTS[x] - sym_BN_TS + asym_BN_TS;
          )
 
-         real_t * WALBERLA_RESTRICT dN = &dst->get(0,y,z,Stencil::idx[N]);
-         real_t * WALBERLA_RESTRICT dS = &dst->get(0,y,z,Stencil::idx[S]);
+         real_t * WALBERLA_RESTRICT dN = &dst->get(xMin,y,z,Stencil::idx[N]);
+         real_t * WALBERLA_RESTRICT dS = &dst->get(xMin,y,z,Stencil::idx[S]);
 
          X_LOOP
          (
@@ -1088,8 +1092,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dS[x] = pS[x] - sym_N_S + asym_N_S;
          )
 
-         real_t * WALBERLA_RESTRICT dE = &dst->get(0,y,z,Stencil::idx[E]);
-         real_t * WALBERLA_RESTRICT dW = &dst->get(0,y,z,Stencil::idx[W]);
+         real_t * WALBERLA_RESTRICT dE = &dst->get(xMin,y,z,Stencil::idx[E]);
+         real_t * WALBERLA_RESTRICT dW = &dst->get(xMin,y,z,Stencil::idx[W]);
 
          X_LOOP
          (
@@ -1100,8 +1104,8 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dW[x] = pW[x] - sym_E_W + asym_E_W;
          )
 
-         real_t * WALBERLA_RESTRICT dT = &dst->get(0,y,z,Stencil::idx[T]);
-         real_t * WALBERLA_RESTRICT dB = &dst->get(0,y,z,Stencil::idx[B]);
+         real_t * WALBERLA_RESTRICT dT = &dst->get(xMin,y,z,Stencil::idx[T]);
+         real_t * WALBERLA_RESTRICT dB = &dst->get(xMin,y,z,Stencil::idx[B]);
 
          X_LOOP
          (
@@ -1112,35 +1116,35 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
             dB[x] = pB[x] - sym_T_B + asym_T_B;
          )
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
    else // ==> src->layout() == field::zyxf || dst->layout() == field::zyxf
    {
-      WALBERLA_FOR_ALL_CELLS_YZ_OMP( src, omp for schedule(static),
+      WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP( interval, omp for schedule(static),
 
          using namespace stencil;
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z  , Stencil::idx[NE]);
-            const real_t dd_tmp_N  = src->get(x  , y-1, z  , Stencil::idx[N]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z  , Stencil::idx[NW]);
-            const real_t dd_tmp_W  = src->get(x+1, y  , z  , Stencil::idx[W]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z  , Stencil::idx[SW]);
-            const real_t dd_tmp_S  = src->get(x  , y+1, z  , Stencil::idx[S]);
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z  , Stencil::idx[SE]);
-            const real_t dd_tmp_E  = src->get(x-1, y  , z  , Stencil::idx[E]);
-            const real_t dd_tmp_T  = src->get(x  , y  , z-1, Stencil::idx[T]);
-            const real_t dd_tmp_TE = src->get(x-1, y  , z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_TN = src->get(x  , y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_TW = src->get(x+1, y  , z-1, Stencil::idx[TW]);
-            const real_t dd_tmp_TS = src->get(x  , y+1, z-1, Stencil::idx[TS]);
-            const real_t dd_tmp_B  = src->get(x  , y  , z+1, Stencil::idx[B]);
-            const real_t dd_tmp_BE = src->get(x-1, y  , z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_BN = src->get(x  , y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_BW = src->get(x+1, y  , z+1, Stencil::idx[BW]);
-            const real_t dd_tmp_BS = src->get(x  , y+1, z+1, Stencil::idx[BS]);
-            const real_t dd_tmp_C  = src->get(x  , y  , z  , Stencil::idx[C]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z  , Stencil::idx[NE]);
+            const real_t dd_tmp_N  = src->get(xMin+x  , y-1, z  , Stencil::idx[N]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z  , Stencil::idx[NW]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y  , z  , Stencil::idx[W]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z  , Stencil::idx[SW]);
+            const real_t dd_tmp_S  = src->get(xMin+x  , y+1, z  , Stencil::idx[S]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z  , Stencil::idx[SE]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y  , z  , Stencil::idx[E]);
+            const real_t dd_tmp_T  = src->get(xMin+x  , y  , z-1, Stencil::idx[T]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y  , z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_TN = src->get(xMin+x  , y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y  , z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_TS = src->get(xMin+x  , y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_B  = src->get(xMin+x  , y  , z+1, Stencil::idx[B]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y  , z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_BN = src->get(xMin+x  , y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y  , z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_BS = src->get(xMin+x  , y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_C  = src->get(xMin+x  , y  , z  , Stencil::idx[C]);
 
             const real_t velX_trm = dd_tmp_E + dd_tmp_NE + dd_tmp_SE + dd_tmp_TE + dd_tmp_BE;
             const real_t velY_trm = dd_tmp_N + dd_tmp_NW + dd_tmp_TN + dd_tmp_BN;
@@ -1160,124 +1164,124 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 
             feq_common[x] = real_t(1.0) - real_t(1.5) * ( velX[x] * velX[x] + velY[x] * velY[x] + velZ[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
+            dst->get(xMin+x, y, z, Stencil::idx[C] ) = dd_tmp_C * (real_t(1.0) - lambda_e) + lambda_e * t0_0 * rho * feq_common[x];
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_NE = src->get(x-1, y-1, z, Stencil::idx[NE]);
-            const real_t dd_tmp_SW = src->get(x+1, y+1, z, Stencil::idx[SW]);
+            const real_t dd_tmp_NE = src->get(xMin+x-1, y-1, z, Stencil::idx[NE]);
+            const real_t dd_tmp_SW = src->get(xMin+x+1, y+1, z, Stencil::idx[SW]);
 
             const real_t velXPY = velX[x] + velY[x];
             const real_t  sym_NE_SW = lambda_e_scaled * ( dd_tmp_NE + dd_tmp_SW - fac2[x] * velXPY * velXPY - t2x2[x] * feq_common[x] );
             const real_t asym_NE_SW = lambda_d_scaled * ( dd_tmp_NE - dd_tmp_SW - real_t(3.0) * t2x2[x] * velXPY );
 
-            dst->get( x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
-            dst->get( x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
+            dst->get(xMin+x, y, z, Stencil::idx[NE] ) = dd_tmp_NE - sym_NE_SW - asym_NE_SW;
+            dst->get(xMin+x, y, z, Stencil::idx[SW] ) = dd_tmp_SW - sym_NE_SW + asym_NE_SW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_SE = src->get(x-1, y+1, z, Stencil::idx[SE]);
-            const real_t dd_tmp_NW = src->get(x+1, y-1, z, Stencil::idx[NW]);
+            const real_t dd_tmp_SE = src->get(xMin+x-1, y+1, z, Stencil::idx[SE]);
+            const real_t dd_tmp_NW = src->get(xMin+x+1, y-1, z, Stencil::idx[NW]);
 
             const real_t velXMY = velX[x] - velY[x];
             const real_t  sym_SE_NW = lambda_e_scaled * ( dd_tmp_SE + dd_tmp_NW - fac2[x] * velXMY * velXMY - t2x2[x] * feq_common[x] );
             const real_t asym_SE_NW = lambda_d_scaled * ( dd_tmp_SE - dd_tmp_NW - real_t(3.0) * t2x2[x] * velXMY );
 
-            dst->get( x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
-            dst->get( x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
+            dst->get(xMin+x, y, z, Stencil::idx[SE] ) = dd_tmp_SE - sym_SE_NW - asym_SE_NW;
+            dst->get(xMin+x, y, z, Stencil::idx[NW] ) = dd_tmp_NW - sym_SE_NW + asym_SE_NW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TE = src->get(x-1, y, z-1, Stencil::idx[TE]);
-            const real_t dd_tmp_BW = src->get(x+1, y, z+1, Stencil::idx[BW]);
+            const real_t dd_tmp_TE = src->get(xMin+x-1, y, z-1, Stencil::idx[TE]);
+            const real_t dd_tmp_BW = src->get(xMin+x+1, y, z+1, Stencil::idx[BW]);
 
             const real_t velXPZ = velX[x] + velZ[x];
             const real_t  sym_TE_BW = lambda_e_scaled * ( dd_tmp_TE + dd_tmp_BW - fac2[x] * velXPZ * velXPZ - t2x2[x] * feq_common[x] );
             const real_t asym_TE_BW = lambda_d_scaled * ( dd_tmp_TE - dd_tmp_BW - real_t(3.0) * t2x2[x] * velXPZ );
 
-            dst->get( x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
-            dst->get( x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
+            dst->get(xMin+x, y, z, Stencil::idx[TE] ) = dd_tmp_TE - sym_TE_BW - asym_TE_BW;
+            dst->get(xMin+x, y, z, Stencil::idx[BW] ) = dd_tmp_BW - sym_TE_BW + asym_TE_BW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BE = src->get(x-1, y, z+1, Stencil::idx[BE]);
-            const real_t dd_tmp_TW = src->get(x+1, y, z-1, Stencil::idx[TW]);
+            const real_t dd_tmp_BE = src->get(xMin+x-1, y, z+1, Stencil::idx[BE]);
+            const real_t dd_tmp_TW = src->get(xMin+x+1, y, z-1, Stencil::idx[TW]);
 
             const real_t velXMZ = velX[x] - velZ[x];
             const real_t  sym_BE_TW = lambda_e_scaled * ( dd_tmp_BE + dd_tmp_TW - fac2[x] * velXMZ * velXMZ - t2x2[x] * feq_common[x] );
             const real_t asym_BE_TW = lambda_d_scaled * ( dd_tmp_BE - dd_tmp_TW - real_t(3.0) * t2x2[x] * velXMZ );
 
-            dst->get( x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
-            dst->get( x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
+            dst->get(xMin+x, y, z, Stencil::idx[BE] ) = dd_tmp_BE - sym_BE_TW - asym_BE_TW;
+            dst->get(xMin+x, y, z, Stencil::idx[TW] ) = dd_tmp_TW - sym_BE_TW + asym_BE_TW;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_TN = src->get(x, y-1, z-1, Stencil::idx[TN]);
-            const real_t dd_tmp_BS = src->get(x, y+1, z+1, Stencil::idx[BS]);
+            const real_t dd_tmp_TN = src->get(xMin+x, y-1, z-1, Stencil::idx[TN]);
+            const real_t dd_tmp_BS = src->get(xMin+x, y+1, z+1, Stencil::idx[BS]);
 
             const real_t velYPZ = velY[x] + velZ[x];
             const real_t  sym_TN_BS = lambda_e_scaled * ( dd_tmp_TN + dd_tmp_BS - fac2[x] * velYPZ * velYPZ - t2x2[x] * feq_common[x] );
             const real_t asym_TN_BS = lambda_d_scaled * ( dd_tmp_TN - dd_tmp_BS - real_t(3.0) * t2x2[x] * velYPZ );
 
-            dst->get( x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
-            dst->get( x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
+            dst->get(xMin+x, y, z, Stencil::idx[TN] ) = dd_tmp_TN - sym_TN_BS - asym_TN_BS;
+            dst->get(xMin+x, y, z, Stencil::idx[BS] ) = dd_tmp_BS - sym_TN_BS + asym_TN_BS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_BN = src->get(x, y-1, z+1, Stencil::idx[BN]);
-            const real_t dd_tmp_TS = src->get(x, y+1, z-1, Stencil::idx[TS]);
+            const real_t dd_tmp_BN = src->get(xMin+x, y-1, z+1, Stencil::idx[BN]);
+            const real_t dd_tmp_TS = src->get(xMin+x, y+1, z-1, Stencil::idx[TS]);
 
             const real_t velYMZ = velY[x] - velZ[x];
             const real_t  sym_BN_TS = lambda_e_scaled * ( dd_tmp_BN + dd_tmp_TS - fac2[x] * velYMZ * velYMZ - t2x2[x] * feq_common[x] );
             const real_t asym_BN_TS = lambda_d_scaled * ( dd_tmp_BN - dd_tmp_TS - real_t(3.0) * t2x2[x] * velYMZ );
 
-            dst->get( x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
-            dst->get( x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
+            dst->get(xMin+x, y, z, Stencil::idx[BN] ) = dd_tmp_BN - sym_BN_TS - asym_BN_TS;
+            dst->get(xMin+x, y, z, Stencil::idx[TS] ) = dd_tmp_TS - sym_BN_TS + asym_BN_TS;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_N  = src->get(x, y-1, z, Stencil::idx[N]);
-            const real_t dd_tmp_S  = src->get(x, y+1, z, Stencil::idx[S]);
+            const real_t dd_tmp_N  = src->get(xMin+x, y-1, z, Stencil::idx[N]);
+            const real_t dd_tmp_S  = src->get(xMin+x, y+1, z, Stencil::idx[S]);
 
             const real_t  sym_N_S = lambda_e_scaled * ( dd_tmp_N + dd_tmp_S - fac1[x] * velY[x] * velY[x] - t1x2[x] * feq_common[x] );
             const real_t asym_N_S = lambda_d_scaled * ( dd_tmp_N - dd_tmp_S - real_t(3.0) * t1x2[x] * velY[x] );
 
-            dst->get( x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
-            dst->get( x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
+            dst->get(xMin+x, y, z, Stencil::idx[N] ) = dd_tmp_N - sym_N_S - asym_N_S;
+            dst->get(xMin+x, y, z, Stencil::idx[S] ) = dd_tmp_S - sym_N_S + asym_N_S;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_E  = src->get(x-1, y, z, Stencil::idx[E]);
-            const real_t dd_tmp_W  = src->get(x+1, y, z, Stencil::idx[W]);
+            const real_t dd_tmp_E  = src->get(xMin+x-1, y, z, Stencil::idx[E]);
+            const real_t dd_tmp_W  = src->get(xMin+x+1, y, z, Stencil::idx[W]);
 
             const real_t  sym_E_W = lambda_e_scaled * ( dd_tmp_E + dd_tmp_W - fac1[x] * velX[x] * velX[x] - t1x2[x] * feq_common[x] );
             const real_t asym_E_W = lambda_d_scaled * ( dd_tmp_E - dd_tmp_W - real_t(3.0) * t1x2[x] * velX[x] );
 
-            dst->get( x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
-            dst->get( x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
+            dst->get(xMin+x, y, z, Stencil::idx[E] ) = dd_tmp_E - sym_E_W - asym_E_W;
+            dst->get(xMin+x, y, z, Stencil::idx[W] ) = dd_tmp_W - sym_E_W + asym_E_W;
          }
 
          for( cell_idx_t x = 0; x != xSize; ++x )
          {
-            const real_t dd_tmp_T  = src->get(x, y, z-1, Stencil::idx[T]);
-            const real_t dd_tmp_B  = src->get(x, y, z+1, Stencil::idx[B]);
+            const real_t dd_tmp_T  = src->get(xMin+x, y, z-1, Stencil::idx[T]);
+            const real_t dd_tmp_B  = src->get(xMin+x, y, z+1, Stencil::idx[B]);
 
             const real_t  sym_T_B = lambda_e_scaled * ( dd_tmp_T + dd_tmp_B - fac1[x] * velZ[x] * velZ[x] - t1x2[x] * feq_common[x] );
             const real_t asym_T_B = lambda_d_scaled * ( dd_tmp_T - dd_tmp_B - real_t(3.0) * t1x2[x] * velZ[x] );
 
-            dst->get( x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
-            dst->get( x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
+            dst->get(xMin+x, y, z, Stencil::idx[T] ) = dd_tmp_T - sym_T_B - asym_T_B;
+            dst->get(xMin+x, y, z, Stencil::idx[B] ) = dd_tmp_B - sym_T_B + asym_T_B;
          }
 
-      ) // WALBERLA_FOR_ALL_CELLS_YZ_OMP
+      ) // WALBERLA_FOR_ALL_CELLS_IN_INTERVAL_YZ_OMP
    }
 
    delete[] velX;
@@ -1292,8 +1296,6 @@ void SplitPureSweep< LatticeModel_T, typename boost::enable_if< boost::mpl::and_
 #ifdef _OPENMP
    }
 #endif
-
-   src->swapDataPointers( dst );
 }
 
 template< typename LatticeModel_T >
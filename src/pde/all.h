@@ -27,4 +27,5 @@
 
 #include "pde/boundary/all.h"
 #include "pde/iterations/all.h"
+#include "pde/refinement/all.h"
 #include "pde/sweeps/all.h"
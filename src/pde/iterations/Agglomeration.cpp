@@ -0,0 +1,220 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file Agglomeration.cpp
+//! \ingroup pde
+//
+//======================================================================================================================
+
+#include "Agglomeration.h"
+
+#include "blockforest/BlockForest.h"
+#include "blockforest/SetupBlockForest.h"
+
+#include "core/Abort.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/logging/Logging.h"
+
+#include <algorithm>
+
+
+
+namespace walberla {
+namespace pde {
+
+
+
+namespace agglomeration {
+
+/// assigns block i (in x-y-z order) to process i % (number of processes)
+class ProcessAssignment
+{
+public:
+
+   ProcessAssignment( const Vector3< uint_t > & blocks ) : blocks_( blocks ) {}
+
+   uint_t operator()( SetupBlockForest & forest, const uint_t numberOfProcesses, const memory_t /*perProcessMemoryLimit*/ ) const
+   {
+      const AABB & domain = forest.getDomain();
+
+      for( auto block = forest.begin(); block != forest.end(); ++block )
+      {
+         const Vector3< real_t > center = block->getAABB().center();
+
+         uint_t index[3];
+         for( uint_t i = 0; i != 3; ++i )
+            index[i] = std::min( uint_c( ( center[i] - domain.min(i) ) / domain.size(i) * real_c( blocks_[i] ) ), blocks_[i] - uint_t(1) );
+
+         block->assignTargetProcess( ( index[0] + blocks_[0] * ( index[1] + blocks_[1] * index[2] ) ) % numberOfProcesses );
+      }
+
+      return std::min( blocks_[0] * blocks_[1] * blocks_[2], numberOfProcesses );
+   }
+
+private:
+
+   Vector3< uint_t > blocks_;
+};
+
+} // namespace agglomeration
+
+
+
+Agglomeration::Agglomeration( StructuredBlockForest & blocks, const Vector3< uint_t > & cells, const Vector3< uint_t > & agglomeratedBlocks,
+                              const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors ) :
+   blocks_( blocks ), cells_( cells ), agglomeratedBlocksPerDimension_( agglomeratedBlocks ),
+   requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+{
+   const uint_t forestBlocks[] = { blocks_.getXSize(), blocks_.getYSize(), blocks_.getZSize() };
+   const bool periodic[] = { blocks_.isXPeriodic(), blocks_.isYPeriodic(), blocks_.isZPeriodic() };
+
+   const uint_t finestLevel = blocks_.getNumberOfLevels() - uint_t(1);
+
+   for( uint_t i = 0; i != 3; ++i )
+   {
+      if( cells_[i] % ( uint_t(1) << finestLevel ) != uint_t(0) )
+         WALBERLA_ABORT( "Agglomeration: The number of cells per block (" << cells_[i] << ") must be divisible by 2^" << finestLevel
+                         << " in every direction, since the block forest has " << blocks_.getNumberOfLevels() << " levels!" );
+
+      if( agglomeratedBlocks[i] == uint_t(0) || forestBlocks[i] % agglomeratedBlocks[i] != uint_t(0) )
+         WALBERLA_ABORT( "Agglomeration: The number of blocks (" << forestBlocks[i] << ") must be divisible by the number of agglomerated "
+                         "blocks (" << agglomeratedBlocks[i] << ") in every direction!" );
+
+      agglomeratedCells_[i] = cells_[i] * ( forestBlocks[i] / agglomeratedBlocks[i] );
+   }
+
+   // agglomerated block forest
+
+   const uint_t numberOfProcesses = uint_c( MPIManager::instance()->numProcesses() );
+
+   SetupBlockForest sforest;
+   sforest.init( blocks_.getDomain(), agglomeratedBlocks[0], agglomeratedBlocks[1], agglomeratedBlocks[2],
+                 periodic[0], periodic[1], periodic[2] );
+   sforest.balanceLoad( agglomeration::ProcessAssignment( agglomeratedBlocks ), numberOfProcesses );
+
+   WALBERLA_LOG_PROGRESS_ON_ROOT( "Agglomerating " << ( forestBlocks[0] * forestBlocks[1] * forestBlocks[2] ) << " blocks with "
+                                  << cells_[0] << "x" << cells_[1] << "x" << cells_[2] << " cells into " << sforest.getNumberOfBlocks()
+                                  << " block(s) with " << agglomeratedCells_[0] << "x" << agglomeratedCells_[1] << "x" << agglomeratedCells_[2]
+                                  << " cells on " << sforest.getNumberOfWorkerProcesses() << " process(es)" );
+
+   agglomeratedBlocks_ = make_shared< StructuredBlockForest >( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, false ),
+                                                               agglomeratedCells_[0], agglomeratedCells_[1], agglomeratedCells_[2] );
+   agglomeratedBlocks_->createCellBoundingBoxes();
+
+   // communication partners: every process knows to which processes it sends during 'gather', the processes it receives
+   // from are determined with one all-to-all exchange (the offsets of the remote blocks are required for 'scatter')
+
+   const mpi::MPIRank rank = MPIManager::instance()->rank();
+
+   std::map< mpi::MPIRank, std::vector< std::pair< Cell, uint_t > > > localBlocks;
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      const Cell cell = offset( *block );
+      const mpi::MPIRank process = agglomeratedProcess( cell );
+      if( process != rank )
+      {
+         localBlocks[ process ].push_back( std::make_pair( cell, blocks_.getLevel( *block ) ) );
+         scatterSources_.insert( process );
+      }
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      std::vector< int > sends( numberOfProcesses, 0 );
+      std::vector< int > receives( numberOfProcesses, 0 );
+      for( auto process = scatterSources_.begin(); process != scatterSources_.end(); ++process )
+         sends[ uint_c( *process ) ] = 1;
+
+      MPI_Alltoall( &(sends[0]), 1, MPI_INT, &(receives[0]), 1, MPI_INT, MPIManager::instance()->comm() );
+
+      for( uint_t process = 0; process != numberOfProcesses; ++process )
+         if( receives[ process ] != 0 )
+            gatherSources_.insert( int_c( process ) );
+
+      mpi::BufferSystem bufferSystem( MPIManager::instance()->comm(), 4710 );
+      bufferSystem.setReceiverInfo( gatherSources_, true );
+
+      for( auto it = localBlocks.begin(); it != localBlocks.end(); ++it )
+         bufferSystem.sendBuffer( it->first ) << it->second;
+
+      bufferSystem.sendAll();
+
+      for( auto it = bufferSystem.begin(); it != bufferSystem.end(); ++it )
+         it.buffer() >> remoteBlocks_[ it.rank() ];
+   }
+}
+
+
+
+Cell Agglomeration::offset( const IBlock & block ) const
+{
+   const AABB & domain = blocks_.getDomain();
+   const AABB & aabb   = block.getAABB();
+
+   const uint_t level = blocks_.getLevel( block );
+   const uint_t forestBlocks[] = { blocks_.getXSize() << level, blocks_.getYSize() << level, blocks_.getZSize() << level };
+   const Vector3< uint_t > blockCells = cells( level );
+
+   Cell cell;
+   for( uint_t i = 0; i != 3; ++i )
+   {
+      const uint_t index = uint_c( ( aabb.center()[i] - domain.min(i) ) / domain.size(i) * real_c( forestBlocks[i] ) );
+      cell[i] = cell_idx_c( index * blockCells[i] );
+   }
+   return cell;
+}
+
+
+
+Vector3< uint_t > Agglomeration::cells( const uint_t level ) const
+{
+   return Vector3< uint_t >( cells_[0] >> level, cells_[1] >> level, cells_[2] >> level );
+}
+
+
+
+mpi::MPIRank Agglomeration::agglomeratedProcess( const Cell & cell ) const
+{
+   uint_t index[3];
+   for( uint_t i = 0; i != 3; ++i )
+      index[i] = uint_c( cell[i] ) / agglomeratedCells_[i];
+
+   const uint_t numberOfProcesses = uint_c( MPIManager::instance()->numProcesses() );
+
+   return int_c( ( index[0] + agglomeratedBlocksPerDimension_[0] * ( index[1] + agglomeratedBlocksPerDimension_[1] * index[2] ) ) % numberOfProcesses );
+}
+
+
+
+IBlock * Agglomeration::agglomeratedBlock( const Cell & cell, Cell & blockOffset )
+{
+   for( auto block = agglomeratedBlocks_->begin(); block != agglomeratedBlocks_->end(); ++block )
+   {
+      const CellInterval & cellBB = agglomeratedBlocks_->getBlockCellBB( *block );
+      if( cellBB.contains( cell ) )
+      {
+         blockOffset = cellBB.min();
+         return &*block;
+      }
+   }
+
+   WALBERLA_ABORT( "Agglomeration: cell " << cell << " is not contained in any local agglomerated block!" );
+   return NULL;
+}
+
+
+
+} // namespace pde
+} // namespace walberla
@@ -0,0 +1,293 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file Agglomeration.h
+//! \ingroup pde
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "blockforest/StructuredBlockForest.h"
+
+#include "core/Set.h"
+#include "core/cell/Cell.h"
+#include "core/debug/Debug.h"
+#include "core/math/Vector3.h"
+#include "core/mpi/BufferSystem.h"
+#include "core/mpi/MPIManager.h"
+#include "core/uid/SUID.h"
+
+#include "field/GhostLayerField.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+
+namespace walberla {
+namespace pde {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Agglomerates fields of a block forest onto a uniform block forest with fewer, larger blocks
+*
+*   The agglomerated block forest covers the same domain (with the same periodicity) with 'agglomeratedBlocks' blocks.
+*   Every block of the original forest must be completely contained in one agglomerated block, i.e., the number of
+*   blocks of the original forest must be divisible by the number of agglomerated blocks in every direction. The
+*   agglomerated blocks are assigned to the processes 0, 1, 2, ... (if there are more agglomerated blocks than processes,
+*   the blocks are assigned round-robin), all other processes do not hold any agglomerated block.
+*
+*   The fields that are transferred do not need to have the size of the blocks of the original forest: 'cells' is the
+*   number of cells per block of these fields (e.g., the size of a coarse multigrid level). The agglomerated fields
+*   then have 'cells' * (blocks of the original forest) / 'agglomeratedBlocks' cells per block.
+*
+*   'gather' and 'scatter' only transfer the interior cells, both are collective operations. Data of blocks that stay
+*   on the same process is copied directly, all other data is sent with one message per pair of processes.
+*
+*   On refined block forests, all fields must have the same resolution on all blocks (e.g., the coarsest multigrid
+*   level, see 'VCycles::getSizeForLevel'): 'cells' is the number of cells per block on the coarsest level of the
+*   forest, blocks on level l have 'cells' / 2^l cells.
+*/
+//**********************************************************************************************************************
+
+class Agglomeration
+{
+public:
+
+   Agglomeration( StructuredBlockForest & blocks, const Vector3< uint_t > & cells,
+                  const Vector3< uint_t > & agglomeratedBlocks = Vector3< uint_t >( uint_t(1) ),
+                  const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                  const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
+   const shared_ptr< StructuredBlockForest > & getAgglomeratedBlockForest() const { return agglomeratedBlocks_; }
+
+   const Vector3< uint_t > & getAgglomeratedCellsPerBlock() const { return agglomeratedCells_; }
+
+   /// copies the field 'srcId' of the original block forest into the field 'dstId' of the agglomerated block forest
+   template< typename Field_T >
+   void gather( const BlockDataID & srcId, const BlockDataID & dstId );
+
+   /// copies the field 'srcId' of the agglomerated block forest into the field 'dstId' of the original block forest
+   template< typename Field_T >
+   void scatter( const BlockDataID & srcId, const BlockDataID & dstId );
+
+private:
+
+   /// first (global) cell of 'block' of the original block forest in the agglomerated cell grid
+   Cell offset( const IBlock & block ) const;
+
+   /// number of cells of the fields of the blocks on level 'level' of the original block forest
+   Vector3< uint_t > cells( const uint_t level ) const;
+
+   /// process that holds the agglomerated block that contains the (global) cell 'cell'
+   mpi::MPIRank agglomeratedProcess( const Cell & cell ) const;
+
+   /// local agglomerated block that contains the (global) cell 'cell' + the first cell of this block
+   IBlock * agglomeratedBlock( const Cell & cell, Cell & blockOffset );
+
+   template< typename Field_T >
+   static void copy( const Field_T * src, const Cell & srcOffset, Field_T * dst, const Cell & dstOffset, const Vector3< uint_t > & size );
+
+   template< typename Field_T >
+   static void pack( mpi::SendBuffer & buffer, const Field_T * src, const Cell & srcOffset, const Vector3< uint_t > & size );
+
+   template< typename Field_T >
+   static void unpack( mpi::RecvBuffer & buffer, Field_T * dst, const Cell & dstOffset, const Vector3< uint_t > & size );
+
+
+
+   StructuredBlockForest & blocks_;
+   shared_ptr< StructuredBlockForest > agglomeratedBlocks_;
+
+   Vector3< uint_t > cells_;
+   Vector3< uint_t > agglomeratedBlocksPerDimension_;
+   Vector3< uint_t > agglomeratedCells_;
+
+   std::set< mpi::MPIRank > gatherSources_;                     // processes that send data during 'gather'
+   std::set< mpi::MPIRank > scatterSources_;                    // processes that send data during 'scatter'
+   std::map< mpi::MPIRank, std::vector< std::pair< Cell, uint_t > > > remoteBlocks_; // offsets and levels of all blocks of the
+                                                                                     // original forest that are located on
+                                                                                     // another process and belong to one of
+                                                                                     // the local agglomerated blocks
+   Set<SUID> requiredSelectors_;
+   Set<SUID> incompatibleSelectors_;
+};
+
+
+
+template< typename Field_T >
+void Agglomeration::gather( const BlockDataID & srcId, const BlockDataID & dstId )
+{
+   const mpi::MPIRank rank = MPIManager::instance()->rank();
+
+   mpi::BufferSystem bufferSystem( MPIManager::instance()->comm(), 4711 );
+   bufferSystem.setReceiverInfo( gatherSources_, true );
+
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      const uint_t level = blocks_.getLevel( *block );
+
+      const Field_T * src = block->template getData< const Field_T >( srcId );
+      WALBERLA_ASSERT_EQUAL( src->xSize(), cells( level )[0] );
+      WALBERLA_ASSERT_EQUAL( src->ySize(), cells( level )[1] );
+      WALBERLA_ASSERT_EQUAL( src->zSize(), cells( level )[2] );
+
+      const Cell cell = offset( *block );
+      const mpi::MPIRank process = agglomeratedProcess( cell );
+
+      if( process == rank )
+      {
+         Cell dstOffset;
+         IBlock * dstBlock = agglomeratedBlock( cell, dstOffset );
+         copy( src, Cell( 0, 0, 0 ), dstBlock->template getData< Field_T >( dstId ), cell - dstOffset, cells( level ) );
+      }
+      else
+      {
+         mpi::SendBuffer & buffer = bufferSystem.sendBuffer( process );
+         buffer << cell << level;
+         pack( buffer, src, Cell( 0, 0, 0 ), cells( level ) );
+      }
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      bufferSystem.sendAll();
+
+      for( auto it = bufferSystem.begin(); it != bufferSystem.end(); ++it )
+      {
+         while( !it.buffer().isEmpty() )
+         {
+            Cell cell;
+            uint_t level;
+            it.buffer() >> cell >> level;
+
+            Cell dstOffset;
+            IBlock * dstBlock = agglomeratedBlock( cell, dstOffset );
+            unpack( it.buffer(), dstBlock->template getData< Field_T >( dstId ), cell - dstOffset, cells( level ) );
+         }
+      }
+   }
+}
+
+
+
+template< typename Field_T >
+void Agglomeration::scatter( const BlockDataID & srcId, const BlockDataID & dstId )
+{
+   const mpi::MPIRank rank = MPIManager::instance()->rank();
+
+   mpi::BufferSystem bufferSystem( MPIManager::instance()->comm(), 4712 );
+   bufferSystem.setReceiverInfo( scatterSources_, true );
+
+   for( auto remote = remoteBlocks_.begin(); remote != remoteBlocks_.end(); ++remote )
+   {
+      mpi::SendBuffer & buffer = bufferSystem.sendBuffer( remote->first );
+      for( auto remoteBlock = remote->second.begin(); remoteBlock != remote->second.end(); ++remoteBlock )
+      {
+         const Cell & cell = remoteBlock->first;
+
+         Cell srcOffset;
+         IBlock * srcBlock = agglomeratedBlock( cell, srcOffset );
+         buffer << cell;
+         pack( buffer, srcBlock->template getData< const Field_T >( srcId ), cell - srcOffset, cells( remoteBlock->second ) );
+      }
+   }
+
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      const Cell cell = offset( *block );
+      if( agglomeratedProcess( cell ) == rank )
+      {
+         Cell srcOffset;
+         IBlock * srcBlock = agglomeratedBlock( cell, srcOffset );
+         copy( srcBlock->template getData< const Field_T >( srcId ), cell - srcOffset, block->template getData< Field_T >( dstId ), Cell( 0, 0, 0 ),
+               cells( blocks_.getLevel( *block ) ) );
+      }
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      bufferSystem.sendAll();
+
+      for( auto it = bufferSystem.begin(); it != bufferSystem.end(); ++it )
+      {
+         while( !it.buffer().isEmpty() )
+         {
+            Cell cell;
+            it.buffer() >> cell;
+
+            Field_T * dst = NULL;
+            uint_t level = uint_t(0);
+            for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end() && dst == NULL; ++block )
+            {
+               if( offset( *block ) == cell )
+               {
+                  dst = block->template getData< Field_T >( dstId );
+                  level = blocks_.getLevel( *block );
+               }
+            }
+            WALBERLA_ASSERT_NOT_NULLPTR( dst );
+
+            unpack( it.buffer(), dst, Cell( 0, 0, 0 ), cells( level ) );
+         }
+      }
+   }
+}
+
+
+
+template< typename Field_T >
+void Agglomeration::copy( const Field_T * src, const Cell & srcOffset, Field_T * dst, const Cell & dstOffset, const Vector3< uint_t > & size )
+{
+   for( cell_idx_t z = 0; z != cell_idx_c( size[2] ); ++z )
+      for( cell_idx_t y = 0; y != cell_idx_c( size[1] ); ++y )
+         for( cell_idx_t x = 0; x != cell_idx_c( size[0] ); ++x )
+            for( uint_t f = 0; f != Field_T::F_SIZE; ++f )
+               dst->get( dstOffset[0] + x, dstOffset[1] + y, dstOffset[2] + z, f ) = src->get( srcOffset[0] + x, srcOffset[1] + y, srcOffset[2] + z, f );
+}
+
+
+
+template< typename Field_T >
+void Agglomeration::pack( mpi::SendBuffer & buffer, const Field_T * src, const Cell & srcOffset, const Vector3< uint_t > & size )
+{
+   for( cell_idx_t z = 0; z != cell_idx_c( size[2] ); ++z )
+      for( cell_idx_t y = 0; y != cell_idx_c( size[1] ); ++y )
+         for( cell_idx_t x = 0; x != cell_idx_c( size[0] ); ++x )
+            for( uint_t f = 0; f != Field_T::F_SIZE; ++f )
+               buffer << src->get( srcOffset[0] + x, srcOffset[1] + y, srcOffset[2] + z, f );
+}
+
+
+
+template< typename Field_T >
+void Agglomeration::unpack( mpi::RecvBuffer & buffer, Field_T * dst, const Cell & dstOffset, const Vector3< uint_t > & size )
+{
+   for( cell_idx_t z = 0; z != cell_idx_c( size[2] ); ++z )
+      for( cell_idx_t y = 0; y != cell_idx_c( size[1] ); ++y )
+         for( cell_idx_t x = 0; x != cell_idx_c( size[0] ); ++x )
+            for( uint_t f = 0; f != Field_T::F_SIZE; ++f )
+               buffer >> dst->get( dstOffset[0] + x, dstOffset[1] + y, dstOffset[2] + z, f );
+}
+
+
+
+} // namespace pde
+} // namespace walberla
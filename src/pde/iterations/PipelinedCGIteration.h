@@ -0,0 +1,619 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PipelinedCGIteration.h
+//! \ingroup pde
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/Set.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/MPIWrapper.h"
+#include "core/mpi/Reduce.h"
+#include "core/uid/SUID.h"
+
+#include "domain_decomposition/BlockStorage.h"
+
+#include "field/GhostLayerField.h"
+#include "field/iterators/IteratorMacros.h"
+
+#include <boost/function.hpp>
+
+#include <vector>
+
+
+
+namespace walberla {
+namespace pde {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Pipelined (preconditioned) conjugate gradient method according to Ghysels and Vanroose
+*
+*   In contrast to 'CGIteration', which needs two global reductions and five passes over the fields per iteration,
+*   every iteration of this variant consists of
+*    - one sweep that performs all vector updates and, at the same time, computes the local contributions to all three
+*      scalar products (r*u, w*u, and r*r) required for the next iteration,
+*    - one global reduction of these three values, which is started as a non-blocking reduction (MPI_Iallreduce,
+*      requires MPI 3, otherwise a blocking reduction is used) and only completed after the preconditioner has been
+*      applied, the ghost layers of 'm' have been synchronized, and the stencil has been applied.
+*   Hence, the latency of the global reduction is hidden behind the communication and computation of the stencil
+*   application. The price are additional work fields and slightly different rounding errors compared to the
+*   standard CG method.
+*
+*   Notation (u denotes the preconditioned residual and x the solution): r = f - Ax, u = M^-1 r, w = Au, m = M^-1 w,
+*   n = Am, z/q/s/p are the auxiliary vectors of the recurrences for Ap/M^-1 Ap/Ap/p.
+*
+*   Without a preconditioner (first constructor), u is identical to r, m is identical to w, and q is identical to s. In
+*   this case, only the fields x, f, r, w, n, z, s, and p are required and 'synchronizeM' must synchronize the ghost
+*   layers of w. With a preconditioner (second constructor), 'synchronizeM' must synchronize the ghost layers of m.
+*   The preconditioner is given as a function that computes dst = M^-1 src for the two fields it is called with (all
+*   interior cells of dst must be set, the ghost layers of dst are synchronized afterwards), M must be symmetric positive
+*   definite. See 'JacobiPreconditioner' for an example.
+*
+*   As for 'CGIteration', the ghost layers of x must contain the boundary values when the iteration is started, the
+*   ghost layers of all other fields at the domain boundary must be zero.
+*/
+//**********************************************************************************************************************
+
+template< typename Stencil_T >
+class PipelinedCGIteration
+{
+public:
+
+   typedef GhostLayerField< real_t, 1 >                Field_T;
+   typedef GhostLayerField< real_t, Stencil_T::Size >  StencilField_T;
+
+   typedef boost::function< void ( const BlockDataID & dstId, const BlockDataID & srcId ) > Preconditioner_T;
+
+   PipelinedCGIteration( BlockStorage & blocks,
+                         const BlockDataID & xId, const BlockDataID & rId, const BlockDataID & wId, const BlockDataID & nId,
+                         const BlockDataID & zId, const BlockDataID & sId, const BlockDataID & pId,
+                         const BlockDataID & fId, const BlockDataID & stencilId,
+                         const uint_t iterations, const boost::function< void () > & synchronizeM,
+                         const real_t residualNormThreshold = real_t(0),
+                         const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                         const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
+   PipelinedCGIteration( BlockStorage & blocks,
+                         const BlockDataID & xId, const BlockDataID & rId, const BlockDataID & uId, const BlockDataID & wId,
+                         const BlockDataID & mId, const BlockDataID & nId,
+                         const BlockDataID & zId, const BlockDataID & qId, const BlockDataID & sId, const BlockDataID & pId,
+                         const BlockDataID & fId, const BlockDataID & stencilId,
+                         const uint_t iterations, const boost::function< void () > & synchronizeM,
+                         const Preconditioner_T & preconditioner,
+                         const real_t residualNormThreshold = real_t(0),
+                         const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                         const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
+
+   void operator()();
+
+protected:
+
+   enum { RU = 0, WU = 1, RR = 2 }; // indices of the scalar products in 'scalarProducts_'
+
+   //////////////////////////////////////
+   // building blocks for pipelined CG //
+   //////////////////////////////////////
+   void init();
+   void calcR();   // r = f - Ax
+   void calcN();   // n = Am
+   void initUW();  // u = m, w = n (with preconditioner) or w = n (without preconditioner) + local scalar products
+   void update( const real_t alpha, const real_t beta ); // all vector updates + local scalar products
+
+   void startReduction();
+   void waitForReduction();
+
+   bool preconditioned() const { return !preconditioner_.empty(); }
+
+
+
+   BlockStorage & blocks_;
+
+   const BlockDataID xId_;
+   const BlockDataID rId_;
+   const BlockDataID uId_;
+   const BlockDataID wId_;
+   const BlockDataID mId_;
+   const BlockDataID nId_;
+   const BlockDataID zId_;
+   const BlockDataID qId_;
+   const BlockDataID sId_;
+   const BlockDataID pId_;
+   const BlockDataID fId_;
+   const BlockDataID stencilId_;
+
+   real_t cells_;
+
+   uint_t iterations_;
+   real_t residualNormThreshold_;
+
+   boost::function< void () > synchronizeM_;
+   Preconditioner_T preconditioner_;
+
+   std::vector< real_t > scalarProducts_;
+   MPI_Request request_;
+   bool requestActive_;
+
+   Set<SUID> requiredSelectors_;
+   Set<SUID> incompatibleSelectors_;
+};
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Jacobi (diagonal) preconditioner for 'PipelinedCGIteration': dst = src / center weight of the stencil
+*/
+//**********************************************************************************************************************
+
+template< typename Stencil_T >
+class JacobiPreconditioner
+{
+public:
+
+   typedef GhostLayerField< real_t, 1 >                Field_T;
+   typedef GhostLayerField< real_t, Stencil_T::Size >  StencilField_T;
+
+   JacobiPreconditioner( BlockStorage & blocks, const BlockDataID & stencilId,
+                         const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
+                         const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() ) :
+      blocks_( blocks ), stencilId_( stencilId ),
+      requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors ) {}
+
+   void operator()( const BlockDataID & dstId, const BlockDataID & srcId )
+   {
+      for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+      {
+         Field_T * dst                  = block->template getData< Field_T >( dstId );
+         const Field_T * src            = block->template getData< const Field_T >( srcId );
+         const StencilField_T * stencil = block->template getData< const StencilField_T >( stencilId_ );
+
+         WALBERLA_ASSERT_NOT_NULLPTR( dst     );
+         WALBERLA_ASSERT_NOT_NULLPTR( src     );
+         WALBERLA_ASSERT_NOT_NULLPTR( stencil );
+
+         WALBERLA_ASSERT_EQUAL( dst->xyzSize(), src->xyzSize()     );
+         WALBERLA_ASSERT_EQUAL( dst->xyzSize(), stencil->xyzSize() );
+
+         WALBERLA_FOR_ALL_CELLS_XYZ( dst,
+
+            dst->get(x,y,z) = src->get(x,y,z) / stencil->get( x, y, z, Stencil_T::idx[stencil::C] );
+         )
+      }
+   }
+
+private:
+
+   BlockStorage & blocks_;
+   const BlockDataID stencilId_;
+
+   Set<SUID> requiredSelectors_;
+   Set<SUID> incompatibleSelectors_;
+};
+
+
+
+template< typename Stencil_T >
+PipelinedCGIteration< Stencil_T >::PipelinedCGIteration( BlockStorage & blocks,
+                                                         const BlockDataID & xId, const BlockDataID & rId, const BlockDataID & wId, const BlockDataID & nId,
+                                                         const BlockDataID & zId, const BlockDataID & sId, const BlockDataID & pId,
+                                                         const BlockDataID & fId, const BlockDataID & stencilId,
+                                                         const uint_t iterations, const boost::function< void () > & synchronizeM,
+                                                         const real_t residualNormThreshold,
+                                                         const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors ) :
+   blocks_( blocks ), xId_( xId ), rId_( rId ), uId_( rId ), wId_( wId ), mId_( wId ), nId_( nId ),
+   zId_( zId ), qId_( sId ), sId_( sId ), pId_( pId ), fId_( fId ), stencilId_( stencilId ),
+   iterations_( iterations ),
+   residualNormThreshold_( residualNormThreshold ),
+   synchronizeM_( synchronizeM ),
+   scalarProducts_( uint_t(3), real_t(0) ), request_( MPI_REQUEST_NULL ), requestActive_( false ),
+   requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+{
+   init();
+}
+
+
+
+template< typename Stencil_T >
+PipelinedCGIteration< Stencil_T >::PipelinedCGIteration( BlockStorage & blocks,
+                                                         const BlockDataID & xId, const BlockDataID & rId, const BlockDataID & uId, const BlockDataID & wId,
+                                                         const BlockDataID & mId, const BlockDataID & nId,
+                                                         const BlockDataID & zId, const BlockDataID & qId, const BlockDataID & sId, const BlockDataID & pId,
+                                                         const BlockDataID & fId, const BlockDataID & stencilId,
+                                                         const uint_t iterations, const boost::function< void () > & synchronizeM,
+                                                         const Preconditioner_T & preconditioner,
+                                                         const real_t residualNormThreshold,
+                                                         const Set<SUID> & requiredSelectors, const Set<SUID> & incompatibleSelectors ) :
+   blocks_( blocks ), xId_( xId ), rId_( rId ), uId_( uId ), wId_( wId ), mId_( mId ), nId_( nId ),
+   zId_( zId ), qId_( qId ), sId_( sId ), pId_( pId ), fId_( fId ), stencilId_( stencilId ),
+   iterations_( iterations ),
+   residualNormThreshold_( residualNormThreshold ),
+   synchronizeM_( synchronizeM ), preconditioner_( preconditioner ),
+   scalarProducts_( uint_t(3), real_t(0) ), request_( MPI_REQUEST_NULL ), requestActive_( false ),
+   requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+{
+   WALBERLA_CHECK( !preconditioner_.empty(), "No preconditioner given for the preconditioned pipelined CG iteration!" );
+   init();
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::init()
+{
+   uint_t cells( uint_t(0) );
+
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      const Field_T * const x = block->template getData< const Field_T >( xId_ );
+      cells += x->xyzSize().numCells();
+   }
+
+   cells_ = real_c( cells );
+   mpi::allReduceInplace( cells_, mpi::SUM );
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::operator()()
+{
+   WALBERLA_LOG_PROGRESS_ON_ROOT( "Starting pipelined CG iteration with a maximum number of " << iterations_ << " iterations" );
+
+   calcR(); // r = f - Ax
+
+   if( preconditioned() )
+      preconditioner_( mId_, rId_ ); // m = M^-1 r
+   else
+   {
+      for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+      {
+         Field_T * rf = block->template getData< Field_T >( rId_ );
+         Field_T * mf = block->template getData< Field_T >( mId_ );
+
+         WALBERLA_FOR_ALL_CELLS_XYZ( rf,
+
+            mf->get(x,y,z) = rf->get(x,y,z);
+         )
+      }
+   }
+
+   synchronizeM_();
+   calcN();  // n = Am
+   initUW(); // u = m, w = n + local scalar products
+
+   real_t gammaOld( real_t(0) );
+   real_t alphaOld( real_t(0) );
+
+   uint_t i( uint_t(0) );
+   while( true )
+   {
+      startReduction();
+
+      if( i < iterations_ )
+      {
+         if( preconditioned() )
+            preconditioner_( mId_, wId_ ); // m = M^-1 w
+         synchronizeM_();
+         calcN(); // n = Am
+      }
+
+      waitForReduction();
+
+      const real_t residualNorm = std::sqrt( scalarProducts_[RR] / cells_ );
+      if( residualNorm < residualNormThreshold_ )
+      {
+         if( i == uint_t(0) )
+         {
+            WALBERLA_LOG_PROGRESS_ON_ROOT( "Aborting pipelined CG without a single iteration (residual norm threshold already reached):"
+                                           "\n  residual norm threshold: " << residualNormThreshold_ <<
+                                           "\n  residual norm:           " << residualNorm );
+         }
+         else
+         {
+            WALBERLA_LOG_PROGRESS_ON_ROOT( "Aborting pipelined CG iteration (residual norm threshold reached):"
+                                           "\n  residual norm threshold: " << residualNormThreshold_ <<
+                                           "\n  residual norm:           " << residualNorm );
+         }
+         break;
+      }
+
+      if( i == iterations_ )
+         break;
+
+      const real_t gamma = scalarProducts_[RU];
+      const real_t delta = scalarProducts_[WU];
+
+      real_t alpha( real_t(0) );
+      real_t beta( real_t(0) );
+      if( i == uint_t(0) )
+      {
+         alpha = gamma / delta;
+      }
+      else
+      {
+         beta  = gamma / gammaOld;
+         alpha = gamma / ( delta - beta * gamma / alphaOld );
+      }
+
+      update( alpha, beta );
+
+      gammaOld = gamma;
+      alphaOld = alpha;
+
+      ++i;
+   }
+
+   WALBERLA_LOG_PROGRESS_ON_ROOT( "Pipelined CG iteration finished after " << i << " iterations" );
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::calcR() // r = f - Ax
+{
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      Field_T * rf             = block->template getData< Field_T >( rId_ );
+      Field_T * ff             = block->template getData< Field_T >( fId_ );
+      Field_T * xf             = block->template getData< Field_T >( xId_ );
+      StencilField_T * stencil = block->template getData< StencilField_T >( stencilId_ );
+
+      WALBERLA_ASSERT_NOT_NULLPTR( rf      );
+      WALBERLA_ASSERT_NOT_NULLPTR( ff      );
+      WALBERLA_ASSERT_NOT_NULLPTR( xf      );
+      WALBERLA_ASSERT_NOT_NULLPTR( stencil );
+
+      WALBERLA_ASSERT_EQUAL( rf->xyzSize(), ff->xyzSize()      );
+      WALBERLA_ASSERT_EQUAL( rf->xyzSize(), xf->xyzSize()      );
+      WALBERLA_ASSERT_EQUAL( rf->xyzSize(), stencil->xyzSize() );
+
+      WALBERLA_ASSERT_GREATER_EQUAL( xf->nrOfGhostLayers(), 1 );
+
+      WALBERLA_FOR_ALL_CELLS_XYZ( xf,
+
+         rf->get(x,y,z) = ff->get(x,y,z);
+
+         for( auto dir = Stencil_T::begin(); dir != Stencil_T::end(); ++dir )
+            rf->get(x,y,z) -= stencil->get( x, y, z, dir.toIdx() ) * xf->getNeighbor( x, y, z, *dir );
+      )
+   }
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::calcN() // n = Am
+{
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      Field_T * nf             = block->template getData< Field_T >( nId_ );
+      Field_T * mf             = block->template getData< Field_T >( mId_ );
+      StencilField_T * stencil = block->template getData< StencilField_T >( stencilId_ );
+
+      WALBERLA_ASSERT_NOT_NULLPTR( nf      );
+      WALBERLA_ASSERT_NOT_NULLPTR( mf      );
+      WALBERLA_ASSERT_NOT_NULLPTR( stencil );
+
+      WALBERLA_ASSERT_EQUAL( nf->xyzSize(), mf->xyzSize()      );
+      WALBERLA_ASSERT_EQUAL( nf->xyzSize(), stencil->xyzSize() );
+
+      WALBERLA_ASSERT_GREATER_EQUAL( mf->nrOfGhostLayers(), 1 );
+
+      WALBERLA_FOR_ALL_CELLS_XYZ( mf,
+
+         nf->get(x,y,z) = stencil->get( x, y, z, Stencil_T::idx[stencil::C] ) * mf->get(x,y,z);
+
+         for( auto dir = Stencil_T::beginNoCenter(); dir != Stencil_T::end(); ++dir )
+            nf->get(x,y,z) += stencil->get( x, y, z, dir.toIdx() ) * mf->getNeighbor( x, y, z, *dir );
+      )
+   }
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::initUW() // u = m, w = n + local scalar products
+{
+   real_t ru( real_t(0) );
+   real_t wu( real_t(0) );
+   real_t rr( real_t(0) );
+
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      Field_T * rf = block->template getData< Field_T >( rId_ );
+      Field_T * uf = block->template getData< Field_T >( uId_ );
+      Field_T * wf = block->template getData< Field_T >( wId_ );
+      Field_T * mf = block->template getData< Field_T >( mId_ );
+      Field_T * nf = block->template getData< Field_T >( nId_ );
+
+      real_t blockRU( real_t(0) );
+      real_t blockWU( real_t(0) );
+      real_t blockRR( real_t(0) );
+
+      WALBERLA_FOR_ALL_CELLS_XYZ_OMP( rf, omp parallel for schedule(static) reduction(+:blockRU,blockWU,blockRR),
+
+         const real_t rNew = rf->get(x,y,z);
+         const real_t uNew = mf->get(x,y,z);
+         const real_t wNew = nf->get(x,y,z);
+
+         uf->get(x,y,z) = uNew; // without preconditioner: u == r and m == w -> u and w are not changed
+         wf->get(x,y,z) = wNew;
+
+         blockRU += rNew * uNew;
+         blockWU += wNew * uNew;
+         blockRR += rNew * rNew;
+      )
+
+      ru += blockRU;
+      wu += blockWU;
+      rr += blockRR;
+   }
+
+   scalarProducts_[RU] = ru;
+   scalarProducts_[WU] = wu;
+   scalarProducts_[RR] = rr;
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::update( const real_t alpha, const real_t beta )
+{
+   const bool preconditioned = this->preconditioned();
+
+   real_t ru( real_t(0) );
+   real_t wu( real_t(0) );
+   real_t rr( real_t(0) );
+
+   for( auto block = blocks_.begin( requiredSelectors_, incompatibleSelectors_ ); block != blocks_.end(); ++block )
+   {
+      Field_T * xf = block->template getData< Field_T >( xId_ );
+      Field_T * rf = block->template getData< Field_T >( rId_ );
+      Field_T * uf = block->template getData< Field_T >( uId_ );
+      Field_T * wf = block->template getData< Field_T >( wId_ );
+      Field_T * mf = block->template getData< Field_T >( mId_ );
+      Field_T * nf = block->template getData< Field_T >( nId_ );
+      Field_T * zf = block->template getData< Field_T >( zId_ );
+      Field_T * qf = block->template getData< Field_T >( qId_ );
+      Field_T * sf = block->template getData< Field_T >( sId_ );
+      Field_T * pf = block->template getData< Field_T >( pId_ );
+
+      WALBERLA_ASSERT_NOT_NULLPTR( xf );
+      WALBERLA_ASSERT_NOT_NULLPTR( rf );
+      WALBERLA_ASSERT_NOT_NULLPTR( uf );
+      WALBERLA_ASSERT_NOT_NULLPTR( wf );
+      WALBERLA_ASSERT_NOT_NULLPTR( mf );
+      WALBERLA_ASSERT_NOT_NULLPTR( nf );
+      WALBERLA_ASSERT_NOT_NULLPTR( zf );
+      WALBERLA_ASSERT_NOT_NULLPTR( qf );
+      WALBERLA_ASSERT_NOT_NULLPTR( sf );
+      WALBERLA_ASSERT_NOT_NULLPTR( pf );
+
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), rf->xyzSize() );
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), wf->xyzSize() );
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), nf->xyzSize() );
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), zf->xyzSize() );
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), sf->xyzSize() );
+      WALBERLA_ASSERT_EQUAL( xf->xyzSize(), pf->xyzSize() );
+
+      real_t blockRU( real_t(0) );
+      real_t blockWU( real_t(0) );
+      real_t blockRR( real_t(0) );
+
+      if( preconditioned )
+      {
+         WALBERLA_FOR_ALL_CELLS_XYZ_OMP( xf, omp parallel for schedule(static) reduction(+:blockRU,blockWU,blockRR),
+
+            const real_t zNew = nf->get(x,y,z) + beta * zf->get(x,y,z); // z = n + beta * z
+            const real_t qNew = mf->get(x,y,z) + beta * qf->get(x,y,z); // q = m + beta * q
+            const real_t sNew = wf->get(x,y,z) + beta * sf->get(x,y,z); // s = w + beta * s
+            const real_t pNew = uf->get(x,y,z) + beta * pf->get(x,y,z); // p = u + beta * p
+
+            const real_t rNew = rf->get(x,y,z) - alpha * sNew; // r = r - alpha * s
+            const real_t uNew = uf->get(x,y,z) - alpha * qNew; // u = u - alpha * q
+            const real_t wNew = wf->get(x,y,z) - alpha * zNew; // w = w - alpha * z
+
+            xf->get(x,y,z) += alpha * pNew; // x = x + alpha * p
+
+            zf->get(x,y,z) = zNew;
+            qf->get(x,y,z) = qNew;
+            sf->get(x,y,z) = sNew;
+            pf->get(x,y,z) = pNew;
+            rf->get(x,y,z) = rNew;
+            uf->get(x,y,z) = uNew;
+            wf->get(x,y,z) = wNew;
+
+            blockRU += rNew * uNew;
+            blockWU += wNew * uNew;
+            blockRR += rNew * rNew;
+         )
+      }
+      else
+      {
+         WALBERLA_FOR_ALL_CELLS_XYZ_OMP( xf, omp parallel for schedule(static) reduction(+:blockRU,blockWU,blockRR),
+
+            const real_t zNew = nf->get(x,y,z) + beta * zf->get(x,y,z); // z = n + beta * z
+            const real_t sNew = wf->get(x,y,z) + beta * sf->get(x,y,z); // s = w + beta * s
+            const real_t pNew = rf->get(x,y,z) + beta * pf->get(x,y,z); // p = r + beta * p
+
+            const real_t rNew = rf->get(x,y,z) - alpha * sNew; // r = r - alpha * s
+            const real_t wNew = wf->get(x,y,z) - alpha * zNew; // w = w - alpha * z
+
+            xf->get(x,y,z) += alpha * pNew; // x = x + alpha * p
+
+            zf->get(x,y,z) = zNew;
+            sf->get(x,y,z) = sNew;
+            pf->get(x,y,z) = pNew;
+            rf->get(x,y,z) = rNew;
+            wf->get(x,y,z) = wNew;
+
+            blockWU += wNew * rNew;
+            blockRR += rNew * rNew;
+         )
+         blockRU = blockRR;
+      }
+
+      ru += blockRU;
+      wu += blockWU;
+      rr += blockRR;
+   }
+
+   scalarProducts_[RU] = ru;
+   scalarProducts_[WU] = wu;
+   scalarProducts_[RR] = rr;
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::startReduction()
+{
+   WALBERLA_ASSERT( !requestActive_ );
+
+   WALBERLA_NON_MPI_SECTION() { return; }
+
+#if defined( MPI_VERSION ) && MPI_VERSION >= 3
+   MPI_Iallreduce( MPI_IN_PLACE, &(scalarProducts_[0]), int_c( scalarProducts_.size() ), MPITrait< real_t >::type(),
+                   MPI_SUM, MPIManager::instance()->comm(), &request_ );
+   requestActive_ = true;
+#else
+   mpi::allReduceInplace( scalarProducts_, mpi::SUM );
+#endif
+}
+
+
+
+template< typename Stencil_T >
+void PipelinedCGIteration< Stencil_T >::waitForReduction()
+{
+   if( requestActive_ )
+   {
+      MPI_Wait( &request_, MPI_STATUS_IGNORE );
+      requestActive_ = false;
+   }
+}
+
+
+
+} // namespace pde
+} // namespace walberla
@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include "Agglomeration.h"
+
+#include "blockforest/communication/NonUniformBufferedScheme.h"
 #include "blockforest/communication/UniformBufferedScheme.h"
 
 #include "core/uid/SUID.h"
@@ -59,6 +62,8 @@ public:
             const Set<SUID> & requiredSelectors     = Set<SUID>::emptySet(),
             const Set<SUID> & incompatibleSelectors = Set<SUID>::emptySet() );
 
+   /// Refined block forests are only supported with a stencil field, since the stencil weights depend on the level
+   /// of the block.
    VCycles( shared_ptr< StructuredBlockForest > blocks, const BlockDataID & uFieldId, const BlockDataID & fFieldId,
             const BlockDataID & stencilFieldId,
             const uint_t iterations, const uint_t numLvl,
@@ -71,14 +76,30 @@ public:
    void operator()();
    void VCycle();
 
+   /// Replaces the CG iteration on the coarsest level: The coarsest level is agglomerated onto a block forest with
+   /// 'agglomeratedBlocks' blocks that are located on the first processes (see 'Agglomeration'). There, the coarse-grid
+   /// problem is solved with 'coarseCycles' V-cycles (with as many levels as the size of the agglomerated blocks
+   /// allows). Hence, coarsening is no longer limited by the size of the blocks and the convergence rate no longer
+   /// depends on the number of blocks.
+   /// On refined block forests, all blocks must have reached the resolution of the coarsest level of the forest on
+   /// the coarsest multigrid level, i.e., there must be at least as many multigrid levels as levels of the forest.
+   void agglomerateCoarsestLevel( const Vector3< uint_t > & agglomeratedBlocks = Vector3< uint_t >( uint_t(1) ),
+                                  const uint_t coarseCycles = uint_t(1) );
+
    uint_t iterationsPerformed() const { return iterationsPerformed_; }
    bool   thresholdReached() const { return thresholdReached_; }
    const std::vector<real_t> & convergenceRate() { return convergenceRate_; }
+   /// Size of the fields of 'block' on multigrid level 'level'. On refined block forests, the blocks of the finest
+   /// level of the forest are coarsened first: a block is only coarsened once all finer blocks have reached its
+   /// resolution, so that the coarsening uses the level hierarchy of the forest and all blocks have the resolution of
+   /// the coarsest level of the forest after (number of forest levels - 1) multigrid levels.
    static Vector3<uint_t> getSizeForLevel( const uint_t level, const shared_ptr< StructuredBlockStorage > & blocks, IBlock * const block );
 
 protected:
 
+   void addCommunication( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId, const uint_t level );
    void coarsenStencilFields();
+   void solveAgglomeratedCoarsestLevel();
 
    StructuredBlockForest & blocks_;
    std::vector< Weight_T  > weights_;
@@ -109,7 +130,12 @@ protected:
    boost::function< void() > CGIteration_;
    std::vector<boost::function< void(IBlock *) > > computeResidual_, restrict_, zeroize_, prolongateAndCorrect_;
 
-   std::vector< blockforest::communication::UniformBufferedScheme< Stencil_T > > communication_;
+   std::vector< boost::function< void () > > communication_;
+
+   shared_ptr< Agglomeration > agglomeration_;
+   shared_ptr< VCycles< Stencil_T > > agglomeratedVCycles_;
+   BlockDataID agglomeratedUId_, agglomeratedFId_;
+   uint_t coarseCycles_;
 
    Set< SUID > requiredSelectors_;
    Set< SUID > incompatibleSelectors_;
@@ -25,6 +25,7 @@
 #include "core/logging/Logging.h"
 #include "pde/sweeps/Multigrid.h"
 
+#include "core/SharedFunctor.h"
 #include "core/math/Limits.h"
 #include "field/AddToStorage.h"
 #include "field/communication/PackInfo.h"
@@ -33,6 +34,7 @@
 #include "pde/iterations/RBGSIteration.h"
 #include "pde/iterations/CGFixedStencilIteration.h"
 #include "pde/iterations/CGIteration.h"
+#include "pde/refinement/PackInfo.h"
 
 namespace walberla {
 namespace pde {
@@ -50,18 +52,20 @@ VCycles< Stencil_T >::VCycles( shared_ptr< StructuredBlockForest > blocks, const
    postSmoothingIters_(postSmoothingIters), coarseIters_(coarseIters),
    residualNormThreshold_( residualNormThreshold ), residualCheckFrequency_( residualCheckFrequency ),
    iterationsPerformed_( uint_t(0) ), thresholdReached_( false ), residualNorm_( residualNorm ), convergenceRate_(), stencilId_(),
-   requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+   coarseCycles_( uint_t(0) ), requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
 {
+   if( blocks->getNumberOfLevels() != uint_t(1) )
+      WALBERLA_ABORT( "Multigrid V-cycles with fixed stencil weights are only supported for block forests without refinement, use a stencil field instead!" );
+
    // Set up fields for finest level
    uId_.push_back( uFieldId );
    fId_.push_back( fFieldId );
    rId_.push_back( field::addToStorage< PdeField_T >( blocks, "r_0", real_t(0), field::zyxf, uint_t(1) ) );
 
    // Check that coarsest grid has more than one cell per dimension
-   auto   block = blocks->begin();
-   uint_t xLvl  = blocks->getNumberOfXCells( *block );
-   uint_t yLvl  = blocks->getNumberOfYCells( *block );
-   uint_t zLvl  = blocks->getNumberOfZCells( *block );
+   uint_t xLvl  = blocks->getNumberOfXCellsPerBlock();
+   uint_t yLvl  = blocks->getNumberOfYCellsPerBlock();
+   uint_t zLvl  = blocks->getNumberOfZCellsPerBlock();
 
    for( uint_t i = 1; i<numLvl; ++i ){
 
@@ -109,13 +113,11 @@ VCycles< Stencil_T >::VCycles( shared_ptr< StructuredBlockForest > blocks, const
    // Set up communication
    for ( uint_t lvl = 0; lvl < numLvl-1; ++lvl )
    {
-      communication_.emplace_back( blocks );
-      communication_[lvl].addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( uId_[lvl] ) );
+      addCommunication( blocks, uId_[lvl], lvl );
    }
 
    // Set up communication for CG on coarsest level
-   communication_.emplace_back( blocks );
-   communication_.back().addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( dId_ ) );
+   addCommunication( blocks, dId_, numLvl-1 );
 
    // calculate residual norm on the finest level
    residualNorm_ = ResidualNorm<Stencil_T>( blocks->getBlockStorage(), uId_[0], fId_[0], weights_[0],
@@ -160,7 +162,7 @@ VCycles< Stencil_T >::VCycles( shared_ptr< StructuredBlockForest > blocks, const
    postSmoothingIters_(postSmoothingIters), coarseIters_(coarseIters),
    residualNormThreshold_( residualNormThreshold ), residualCheckFrequency_( residualCheckFrequency ),
    iterationsPerformed_( uint_t(0) ), thresholdReached_( false ), residualNorm_( residualNorm ), convergenceRate_(),
-   requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
+   coarseCycles_( uint_t(0) ), requiredSelectors_( requiredSelectors ), incompatibleSelectors_( incompatibleSelectors )
 {
    // Set up fields for finest level
    uId_.push_back( uFieldId );
@@ -169,10 +171,9 @@ VCycles< Stencil_T >::VCycles( shared_ptr< StructuredBlockForest > blocks, const
    stencilId_.push_back( stencilFieldId );
 
    // Check that coarsest grid has more than one cell per dimension
-   auto   block = blocks->begin();
-   uint_t xLvl  = blocks->getNumberOfXCells( *block );
-   uint_t yLvl  = blocks->getNumberOfYCells( *block );
-   uint_t zLvl  = blocks->getNumberOfZCells( *block );
+   uint_t xLvl  = blocks->getNumberOfXCellsPerBlock();
+   uint_t yLvl  = blocks->getNumberOfYCellsPerBlock();
+   uint_t zLvl  = blocks->getNumberOfZCellsPerBlock();
 
    for( uint_t i = 1; i<numLvl; ++i ){
 
@@ -215,13 +216,11 @@ VCycles< Stencil_T >::VCycles( shared_ptr< StructuredBlockForest > blocks, const
    // Set up communication
    for ( uint_t lvl = 0; lvl < numLvl-1; ++lvl )
    {
-      communication_.emplace_back( blocks );
-      communication_[lvl].addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( uId_[lvl] ) );
+      addCommunication( blocks, uId_[lvl], lvl );
    }
 
    // Set up communication for CG on coarsest level
-   communication_.emplace_back( blocks );
-   communication_.back().addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( dId_ ) );
+   addCommunication( blocks, dId_, numLvl-1 );
 
    // calculate residual norm on the finest level
    residualNorm_ = ResidualNormStencilField<Stencil_T>( blocks->getBlockStorage(), uId_[0], fId_[0], stencilId_[0],
@@ -319,10 +318,13 @@ void VCycles< Stencil_T >::coarsenStencilFields()
       {
          StencilField_T * fine   = block->template getData< StencilField_T >( stencilId_[lvl-1] );
          StencilField_T * coarse = block->template getData< StencilField_T >( stencilId_[lvl] );
+
+         // blocks that are not coarsened on this level (refined block forests) keep their mesh size
+         const real_t factor = ( coarse->xyzSize() == fine->xyzSize() ) ? real_t(1) : scalingFactor;
          
          WALBERLA_FOR_ALL_CELLS_XYZ(coarse,
             for( auto dir = Stencil_T::begin(); dir != Stencil_T::end(); ++dir )
-               coarse->get(x,y,z, dir.toIdx()) = scalingFactor * fine->get(x,y,z, dir.toIdx());
+               coarse->get(x,y,z, dir.toIdx()) = factor * fine->get(x,y,z, dir.toIdx());
          )
       }
    }
@@ -357,7 +359,10 @@ void VCycles< Stencil_T >::VCycle()
    WALBERLA_LOG_PROGRESS_ON_ROOT("Solving coarsest grid, level "<< numLvl_ - 1 );
 
    // solve coarsest level
-   CGIteration_();
+   if( agglomeration_ )
+      solveAgglomeratedCoarsestLevel();
+   else
+      CGIteration_();
 
    // correct and post-smoothen -- go from coarse to fine
    for (uint_t ll = 0; ll < numLvl_-1; ++ll)
@@ -382,23 +387,100 @@ void VCycles< Stencil_T >::VCycle()
 
 
 
+template< typename Stencil_T >
+void VCycles< Stencil_T >::agglomerateCoarsestLevel( const Vector3< uint_t > & agglomeratedBlocks, const uint_t coarseCycles )
+{
+   const uint_t finestLevel = blocks_.getNumberOfLevels() - uint_t(1);
+   if( numLvl_ - uint_t(1) < finestLevel )
+      WALBERLA_ABORT( "Agglomerating the coarsest multigrid level requires at least as many multigrid levels (" << numLvl_ << ") "
+                      "as levels of the block forest (" << blocks_.getNumberOfLevels() << ")!" );
+
+   // cells of the blocks on the coarsest level of the forest, the blocks on finer levels have the same resolution
+   const uint_t coarsening = numLvl_ - uint_t(1) - finestLevel;
+   Vector3< uint_t > cells( blocks_.getNumberOfXCellsPerBlock() >> coarsening, blocks_.getNumberOfYCellsPerBlock() >> coarsening,
+                            ( Stencil_T::D == uint_t(3) ) ? ( blocks_.getNumberOfZCellsPerBlock() >> coarsening ) : blocks_.getNumberOfZCellsPerBlock() );
+
+   agglomeration_ = make_shared< Agglomeration >( blocks_, cells, agglomeratedBlocks, requiredSelectors_, incompatibleSelectors_ );
+   coarseCycles_ = coarseCycles;
+
+   auto agglomeratedBlockForest = agglomeration_->getAgglomeratedBlockForest();
+
+   agglomeratedUId_ = field::addToStorage< PdeField_T >( agglomeratedBlockForest, "u (agglomerated)", real_t(0), field::zyxf, uint_t(1) );
+   agglomeratedFId_ = field::addToStorage< PdeField_T >( agglomeratedBlockForest, "f (agglomerated)", real_t(0), field::zyxf, uint_t(1) );
+
+   // as many levels as possible on the agglomerated block forest
+
+   cells = agglomeration_->getAgglomeratedCellsPerBlock();
+   uint_t numLvl = uint_t(1);
+   while( cells[0] % uint_t(2) == uint_t(0) && cells[0] >= uint_t(4) &&
+          cells[1] % uint_t(2) == uint_t(0) && cells[1] >= uint_t(4) &&
+          ( Stencil_T::D == uint_t(2) || ( cells[2] % uint_t(2) == uint_t(0) && cells[2] >= uint_t(4) ) ) )
+   {
+      cells[0] /= uint_t(2);
+      cells[1] /= uint_t(2);
+      if( Stencil_T::D == uint_t(3) )
+         cells[2] /= uint_t(2);
+      ++numLvl;
+   }
+
+   WALBERLA_LOG_PROGRESS_ON_ROOT( "Solving the coarsest level with " << coarseCycles_ << " V-cycle(s) with " << numLvl << " level(s) on the agglomerated block forest" );
+
+   if( weights_.empty() ) // stencil fields
+   {
+      const BlockDataID stencilId = field::addToStorage< StencilField_T >( agglomeratedBlockForest, "w (agglomerated)", real_t(0), field::zyxf, uint_t(1) );
+      agglomeration_->gather< StencilField_T >( stencilId_.back(), stencilId );
+
+      agglomeratedVCycles_ = walberla::make_shared< VCycles< Stencil_T > >( agglomeratedBlockForest, agglomeratedUId_, agglomeratedFId_, stencilId, coarseCycles_,
+                                                                  numLvl, preSmoothingIters_, postSmoothingIters_, coarseIters_, boost::function< real_t () >() );
+   }
+   else
+   {
+      agglomeratedVCycles_ = walberla::make_shared< VCycles< Stencil_T > >( agglomeratedBlockForest, agglomeratedUId_, agglomeratedFId_, weights_.back(), coarseCycles_,
+                                                                  numLvl, preSmoothingIters_, postSmoothingIters_, coarseIters_, boost::function< real_t () >() );
+   }
+}
+
+
+
+template< typename Stencil_T >
+void VCycles< Stencil_T >::solveAgglomeratedCoarsestLevel()
+{
+   agglomeration_->gather< PdeField_T >( fId_.back(), agglomeratedFId_ );
+
+   auto agglomeratedBlockForest = agglomeration_->getAgglomeratedBlockForest();
+   for( auto block = agglomeratedBlockForest->begin(); block != agglomeratedBlockForest->end(); ++block )
+      block->template getData< PdeField_T >( agglomeratedUId_ )->setWithGhostLayer( real_t(0) );
+
+   for( uint_t i = 0; i < coarseCycles_; ++i )
+      agglomeratedVCycles_->VCycle();
+
+   agglomeration_->scatter< PdeField_T >( agglomeratedUId_, uId_.back() );
+}
+
+
+
 template< typename Stencil_T >
 Vector3<uint_t> VCycles< Stencil_T >::getSizeForLevel( const uint_t level, const shared_ptr< StructuredBlockStorage > & blocks, IBlock * const block )
 {
    Vector3<uint_t> cells( blocks->getNumberOfXCells( *block ), blocks->getNumberOfYCells( *block ), blocks->getNumberOfZCells( *block ) );
 
-   if( level == 0 )
+   // number of times the block is coarsened (blocks on the finest level of the forest are coarsened on every level)
+   const uint_t finestLevel = blocks->getNumberOfLevels() - uint_t(1);
+   const uint_t blockLevel = blocks->getLevel( *block );
+   const uint_t coarsening = ( level + blockLevel > finestLevel ) ? ( level + blockLevel - finestLevel ) : uint_t(0);
+
+   if( coarsening == 0 )
       return cells;
 
-   WALBERLA_ASSERT_EQUAL(cells[0] % (uint_t(2) << uint_c(level-1)), 0, "can only coarsen an even number of cells!");
-   WALBERLA_ASSERT_EQUAL(cells[1] % (uint_t(2) << uint_c(level-1)), 0, "can only coarsen an even number of cells!");
+   WALBERLA_ASSERT_EQUAL(cells[0] % (uint_t(2) << uint_c(coarsening-1)), 0, "can only coarsen an even number of cells!");
+   WALBERLA_ASSERT_EQUAL(cells[1] % (uint_t(2) << uint_c(coarsening-1)), 0, "can only coarsen an even number of cells!");
 
-   cells[0] = (cells[0] >> level);
-   cells[1] = (cells[1] >> level);
+   cells[0] = (cells[0] >> coarsening);
+   cells[1] = (cells[1] >> coarsening);
    if( Stencil_T::D == 3 )
    {
-      WALBERLA_ASSERT_EQUAL(cells[2] % (uint_t(2) << uint_c(level-1)), 0, "can only coarsen an even number of cells!");
-      cells[2] = (cells[2] >> level);
+      WALBERLA_ASSERT_EQUAL(cells[2] % (uint_t(2) << uint_c(coarsening-1)), 0, "can only coarsen an even number of cells!");
+      cells[2] = (cells[2] >> coarsening);
    }
 
    return cells;
@@ -406,5 +488,28 @@ Vector3<uint_t> VCycles< Stencil_T >::getSizeForLevel( const uint_t level, const
 
 
 
+template< typename Stencil_T >
+void VCycles< Stencil_T >::addCommunication( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId, const uint_t level )
+{
+   if( blocks->getNumberOfLevels() == uint_t(1) )
+   {
+      auto communication = make_shared< blockforest::communication::UniformBufferedScheme< Stencil_T > >( blocks );
+      communication->addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( fieldId ) );
+      communication_.push_back( makeSharedFunctor( communication ) );
+   }
+   else
+   {
+      // blocks on levels finer than 'finestLevel' have already been coarsened to the resolution of 'finestLevel'
+      const uint_t finestLevel = blocks->getNumberOfLevels() - uint_t(1);
+      const uint_t resolvedLevel = ( level < finestLevel ) ? ( finestLevel - level ) : uint_t(0);
+
+      auto communication = make_shared< blockforest::communication::NonUniformBufferedScheme< Stencil_T > >( blocks );
+      communication->addPackInfo( make_shared< refinement::PackInfo< PdeField_T, Stencil_T > >( fieldId, resolvedLevel ) );
+      communication_.push_back( makeSharedFunctor( communication ) );
+   }
+}
+
+
+
 } // namespace pde
 } // namespace walberla
@@ -22,8 +22,10 @@
 
 #pragma once
 
+#include "Agglomeration.h"
 #include "CGIteration.h"
 #include "CGFixedStencilIteration.h"
 #include "JacobiIteration.h"
+#include "PipelinedCGIteration.h"
 #include "RBGSIteration.h"
 #include "VCycles.h"
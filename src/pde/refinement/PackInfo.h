@@ -0,0 +1,471 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PackInfo.h
+//! \ingroup pde
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "field/refinement/PackInfo.h"
+
+
+namespace walberla {
+namespace pde {
+namespace refinement {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Ghost layer synchronization of multigrid fields with one ghost layer on refined block forests
+*
+*   On the coarser levels of the V-cycles, blocks on levels finer than 'finestLevel' store their fields at the
+*   resolution of 'finestLevel' (see 'VCycles::getSizeForLevel'). Two neighboring blocks on different levels therefore
+*   either differ in resolution by a factor of two or have the same resolution.
+*   In the first case, the ghost cells are interpolated linearly (normal to the interface) between the cells next to
+*   the interface: the ghost cells of the fine block between the coarse cell they are located in and the fine cell
+*   next to them, the ghost cells of the coarse block between the coarse cell next to them and the average of the
+*   layer of fine cells next to the interface. The fluxes through both sides of the interface are then equal, i.e.,
+*   the operator on the composite grid is conservative (otherwise, the right-hand side of singular problems is no
+*   longer consistent on the coarsest multigrid level).
+*   In the second case, the cells next to the interface are copied into the ghost layer of the neighbor.
+*/
+//**********************************************************************************************************************
+
+template< typename Field_T, typename Stencil >
+class PackInfo : public field::refinement::PackInfo< Field_T, Stencil >
+{
+public:
+
+   typedef field::refinement::PackInfo< Field_T, Stencil > Base;
+
+   PackInfo( const BlockDataID & fieldId, const uint_t finestLevel ) : Base( fieldId ), finestLevel_( finestLevel ) {}
+   virtual ~PackInfo() {}
+
+   void       unpackDataCoarseToFine( Block * fineReceiver, const BlockID & coarseSender, stencil::Direction dir, mpi::RecvBuffer & buffer );
+   void communicateLocalCoarseToFine( const Block * coarseSender, Block * fineReceiver, stencil::Direction dir );
+
+   void       unpackDataFineToCoarse( Block * coarseReceiver, const BlockID & fineSender, stencil::Direction dir, mpi::RecvBuffer & buffer );
+   void communicateLocalFineToCoarse( const Block * fineSender, Block * coarseReceiver, stencil::Direction dir );
+
+protected:
+
+   void packDataFineToCoarseImpl( const Block * fineSender, const BlockID & coarseReceiver, stencil::Direction dir, mpi::SendBuffer & buffer ) const;
+
+   /// true if the fine block has already been coarsened to the resolution of its coarse neighbor
+   bool sameResolution( const uint_t fineLevel ) const { return fineLevel > finestLevel_; }
+
+   /// the ghost layer of the fine block next to the coarse block, extended by one cell in all directions in which the
+   /// coarse block continues beyond the fine block
+   static CellInterval coarseToFineUnpackInterval( stencil::Direction dir, const CellInterval & cellBB, const BlockID & smallBlock );
+
+   /// number of fine cells per coarse cell in every direction if the resolutions differ
+   static Vector3< cell_idx_t > coarseToFineStep( stencil::Direction dir, const BlockID & smallBlock );
+
+   /// first fine cell that is covered by the first coarse cell of 'coarseToFinePackInterval' if the resolutions differ
+   static Cell coarseToFineFirstCell( const CellInterval & unpackingInterval, const BlockID & smallBlock, stencil::Direction dir );
+
+   /// sets all cells of 'unpackingInterval' (the ghost layer in direction 'dir') that are covered by the coarse cell
+   /// starting at 'first', whose value is 'value'
+   static void setCoveredCells( Field_T * field, const CellInterval & unpackingInterval, const Cell & first, const Vector3< cell_idx_t > & step,
+                                stencil::Direction dir, const uint_t idx, const typename Field_T::value_type & value );
+
+   /// number of fine cells per coarse cell in every direction within the layer of fine cells next to the interface
+   static Vector3< cell_idx_t > fineToCoarseStep( stencil::Direction dir );
+
+   /// average of the fine cells starting at 'first' within the layer of fine cells next to the interface
+   static typename Field_T::value_type fineLayerAverage( const Field_T * field, const Cell & first, const Vector3< cell_idx_t > & step, const uint_t idx );
+
+   /// ghost cell 'cell' (in direction 'dir') of the coarse block, 'value' is the average of the fine cells next to the interface
+   static void setCoarseGhostCell( Field_T * field, const Cell & cell, stencil::Direction dir, const uint_t idx,
+                                   const typename Field_T::value_type & value );
+
+   const uint_t finestLevel_;
+};
+
+
+
+////////////////////
+// Coarse to fine //
+////////////////////
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::unpackDataCoarseToFine( Block * fineReceiver, const BlockID & /*coarseSender*/,
+                                                           stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+#ifndef NDEBUG
+   if( Stencil::D == uint_t(2) )
+      WALBERLA_ASSERT_EQUAL( stencil::cz[dir], 0 );
+#endif
+
+   Field_T * field = fineReceiver->getData< Field_T >( this->fieldId_ );
+
+   const CellInterval unpackingInterval = coarseToFineUnpackInterval( dir, field->xyzSize(), fineReceiver->getId() );
+
+   if( sameResolution( fineReceiver->getLevel() ) )
+   {
+      for( cell_idx_t z = unpackingInterval.zMin(); z <= unpackingInterval.zMax(); ++z )
+         for( cell_idx_t y = unpackingInterval.yMin(); y <= unpackingInterval.yMax(); ++y )
+            for( cell_idx_t x = unpackingInterval.xMin(); x <= unpackingInterval.xMax(); ++x )
+               for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+                  buffer >> field->get( x, y, z, idx );
+      return;
+   }
+
+   const Vector3< cell_idx_t > step = coarseToFineStep( dir, fineReceiver->getId() );
+   const Cell first = coarseToFineFirstCell( unpackingInterval, fineReceiver->getId(), dir );
+
+   for( cell_idx_t z = first.z(); z <= unpackingInterval.zMax(); z += step[2] ) {
+      for( cell_idx_t y = first.y(); y <= unpackingInterval.yMax(); y += step[1] ) {
+         for( cell_idx_t x = first.x(); x <= unpackingInterval.xMax(); x += step[0] ) {
+            for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+            {
+               typename Field_T::value_type value;
+               buffer >> value;
+               setCoveredCells( field, unpackingInterval, Cell( x, y, z ), step, dir, idx, value );
+            }
+         }
+      }
+   }
+}
+
+
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::communicateLocalCoarseToFine( const Block * coarseSender, Block * fineReceiver, stencil::Direction dir )
+{
+#ifndef NDEBUG
+   if( Stencil::D == uint_t(2) )
+      WALBERLA_ASSERT_EQUAL( stencil::cz[dir], 0 );
+#endif
+
+   const Field_T * sf = coarseSender->getData< Field_T >( this->fieldId_ );
+         Field_T * rf = fineReceiver->getData< Field_T >( this->fieldId_ );
+
+   const CellInterval   packingInterval = Base::coarseToFinePackInterval( dir, sf->xyzSize(), fineReceiver->getId() );
+   const CellInterval unpackingInterval = coarseToFineUnpackInterval( stencil::inverseDir[dir], rf->xyzSize(), fineReceiver->getId() );
+
+   if( sameResolution( fineReceiver->getLevel() ) )
+   {
+      WALBERLA_ASSERT_EQUAL( packingInterval.numCells(), unpackingInterval.numCells() );
+
+      auto sCell = sf->beginSliceXYZ(   packingInterval );
+      auto rCell = rf->beginSliceXYZ( unpackingInterval );
+      while( sCell != sf->end() )
+      {
+         WALBERLA_ASSERT( rCell != rf->end() );
+
+         for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+            rCell.getF( idx ) = sCell.getF( idx );
+
+         ++sCell;
+         ++rCell;
+      }
+      WALBERLA_ASSERT( rCell == rf->end() );
+      return;
+   }
+
+   WALBERLA_ASSERT_EQUAL( sf->xyzSize(), rf->xyzSize() );
+
+   const Vector3< cell_idx_t > step = coarseToFineStep( dir, fineReceiver->getId() );
+   const Cell first = coarseToFineFirstCell( unpackingInterval, fineReceiver->getId(), dir );
+
+   cell_idx_t rz = first.z();
+   for( cell_idx_t sz = packingInterval.zMin(); sz <= packingInterval.zMax(); ++sz )
+   {
+      cell_idx_t ry = first.y();
+      for( cell_idx_t sy = packingInterval.yMin(); sy <= packingInterval.yMax(); ++sy )
+      {
+         cell_idx_t rx = first.x();
+         for( cell_idx_t sx = packingInterval.xMin(); sx <= packingInterval.xMax(); ++sx )
+         {
+            for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+               setCoveredCells( rf, unpackingInterval, Cell( rx, ry, rz ), step, stencil::inverseDir[dir], idx, sf->get( sx, sy, sz, idx ) );
+            rx += step[0];
+         }
+         ry += step[1];
+         WALBERLA_ASSERT_GREATER( rx, unpackingInterval.xMax() );
+      }
+      rz += step[2];
+      WALBERLA_ASSERT_GREATER( ry, unpackingInterval.yMax() );
+   }
+   WALBERLA_ASSERT_GREATER( rz, unpackingInterval.zMax() );
+}
+
+
+
+////////////////////
+// Fine to coarse //
+////////////////////
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::packDataFineToCoarseImpl( const Block * fineSender, const BlockID & coarseReceiver,
+                                                             stencil::Direction dir, mpi::SendBuffer & buffer ) const
+{
+#ifndef NDEBUG
+   if( Stencil::D == uint_t(2) )
+      WALBERLA_ASSERT_EQUAL( stencil::cz[dir], 0 );
+#endif
+
+   if( ( ( Base::isEdgeDirection(dir) || Base::isCornerDirection(dir) ) && Base::blocksConnectedByFaces( fineSender, coarseReceiver ) ) ||
+       ( Base::isCornerDirection(dir) && Base::blocksConnectedByEdges( fineSender, coarseReceiver ) ) )
+      return;
+
+   const Field_T * field = fineSender->getData< Field_T >( this->fieldId_ );
+
+   // the unpacking interval of the coarse block ('fineToCoarseUnpackInterval') has the size of one layer of the fine block
+   // if the resolutions are equal, otherwise the fine cells of this layer are averaged
+   const CellInterval packingInterval = Base::equalLevelPackInterval( dir, field->xyzSize(), uint_t(1) );
+
+   const Vector3< cell_idx_t > step = sameResolution( fineSender->getLevel() ) ? Vector3< cell_idx_t >( cell_idx_t(1) ) : fineToCoarseStep( dir );
+
+   for( cell_idx_t z = packingInterval.zMin(); z <= packingInterval.zMax(); z += step[2] )
+      for( cell_idx_t y = packingInterval.yMin(); y <= packingInterval.yMax(); y += step[1] )
+         for( cell_idx_t x = packingInterval.xMin(); x <= packingInterval.xMax(); x += step[0] )
+            for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+               buffer << fineLayerAverage( field, Cell( x, y, z ), step, idx );
+}
+
+
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::unpackDataFineToCoarse( Block * coarseReceiver, const BlockID & fineSender,
+                                                           stencil::Direction dir, mpi::RecvBuffer & buffer )
+{
+   if( sameResolution( coarseReceiver->getLevel() + uint_t(1) ) )
+   {
+      Base::unpackDataFineToCoarse( coarseReceiver, fineSender, dir, buffer );
+      return;
+   }
+
+#ifndef NDEBUG
+   if( Stencil::D == uint_t(2) )
+      WALBERLA_ASSERT_EQUAL( stencil::cz[dir], 0 );
+#endif
+
+   if( ( ( Base::isEdgeDirection(dir) || Base::isCornerDirection(dir) ) && Base::blocksConnectedByFaces( coarseReceiver, fineSender ) ) ||
+       ( Base::isCornerDirection(dir) && Base::blocksConnectedByEdges( coarseReceiver, fineSender ) ) )
+      return;
+
+   Field_T * field = coarseReceiver->getData< Field_T >( this->fieldId_ );
+
+   const CellInterval unpackingInterval = Base::fineToCoarseUnpackInterval( dir, field->xyzSize(), fineSender );
+
+   for( cell_idx_t z = unpackingInterval.zMin(); z <= unpackingInterval.zMax(); ++z )
+      for( cell_idx_t y = unpackingInterval.yMin(); y <= unpackingInterval.yMax(); ++y )
+         for( cell_idx_t x = unpackingInterval.xMin(); x <= unpackingInterval.xMax(); ++x )
+            for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+            {
+               typename Field_T::value_type value;
+               buffer >> value;
+               setCoarseGhostCell( field, Cell( x, y, z ), dir, idx, value );
+            }
+}
+
+
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::communicateLocalFineToCoarse( const Block * fineSender, Block * coarseReceiver, stencil::Direction dir )
+{
+#ifndef NDEBUG
+   if( Stencil::D == uint_t(2) )
+      WALBERLA_ASSERT_EQUAL( stencil::cz[dir], 0 );
+#endif
+
+   if( ( ( Base::isEdgeDirection(dir) || Base::isCornerDirection(dir) ) && Base::blocksConnectedByFaces( fineSender, coarseReceiver->getId() ) ) ||
+       ( Base::isCornerDirection(dir) && Base::blocksConnectedByEdges( fineSender, coarseReceiver->getId() ) ) )
+      return;
+
+   const Field_T * sf =     fineSender->getData< Field_T >( this->fieldId_ );
+         Field_T * rf = coarseReceiver->getData< Field_T >( this->fieldId_ );
+
+   const CellInterval   packingInterval = Base::equalLevelPackInterval( dir, sf->xyzSize(), uint_t(1) );
+   const CellInterval unpackingInterval = Base::fineToCoarseUnpackInterval( stencil::inverseDir[dir], rf->xyzSize(), fineSender->getId() );
+
+   if( sameResolution( fineSender->getLevel() ) )
+   {
+      WALBERLA_ASSERT_EQUAL( packingInterval.numCells(), unpackingInterval.numCells() );
+
+      auto sCell = sf->beginSliceXYZ(   packingInterval );
+      auto rCell = rf->beginSliceXYZ( unpackingInterval );
+      while( sCell != sf->end() )
+      {
+         WALBERLA_ASSERT( rCell != rf->end() );
+
+         for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+            rCell.getF( idx ) = sCell.getF( idx );
+
+         ++sCell;
+         ++rCell;
+      }
+      WALBERLA_ASSERT( rCell == rf->end() );
+      return;
+   }
+
+   const Vector3< cell_idx_t > step = fineToCoarseStep( dir );
+
+   cell_idx_t sz = packingInterval.zMin();
+   for( cell_idx_t rz = unpackingInterval.zMin(); rz <= unpackingInterval.zMax(); ++rz )
+   {
+      cell_idx_t sy = packingInterval.yMin();
+      for( cell_idx_t ry = unpackingInterval.yMin(); ry <= unpackingInterval.yMax(); ++ry )
+      {
+         cell_idx_t sx = packingInterval.xMin();
+         for( cell_idx_t rx = unpackingInterval.xMin(); rx <= unpackingInterval.xMax(); ++rx )
+         {
+            for( uint_t idx = 0; idx < Field_T::F_SIZE; ++idx )
+               setCoarseGhostCell( rf, Cell( rx, ry, rz ), stencil::inverseDir[dir], idx, fineLayerAverage( sf, Cell( sx, sy, sz ), step, idx ) );
+            sx += step[0];
+         }
+         WALBERLA_ASSERT_GREATER( sx, packingInterval.xMax() );
+         sy += step[1];
+      }
+      WALBERLA_ASSERT_GREATER( sy, packingInterval.yMax() );
+      sz += step[2];
+   }
+   WALBERLA_ASSERT_GREATER( sz, packingInterval.zMax() );
+}
+
+
+
+///////////////////////////////////////////////////////////////////////
+// Helper functions for determining packing/unpacking cell intervals //
+///////////////////////////////////////////////////////////////////////
+
+template< typename Field_T, typename Stencil >
+CellInterval PackInfo< Field_T, Stencil >::coarseToFineUnpackInterval( stencil::Direction dir, const CellInterval & cellBB,
+                                                                       const BlockID & smallBlock )
+{
+   CellInterval interval = Base::equalLevelUnpackInterval( dir, cellBB, uint_t(1) );
+   Vector3< cell_idx_t > shift = Base::getNeighborShift( smallBlock, dir );
+
+   for( uint_t i = 0; i != Stencil::D; ++i )
+   {
+      if( shift[i] == cell_idx_t(-1) )
+         interval.max()[i] += cell_idx_t(1);
+      if( shift[i] == cell_idx_t( 1) )
+         interval.min()[i] -= cell_idx_t(1);
+   }
+
+#ifndef NDEBUG
+   CellInterval expandedCellBB( cellBB );
+   expandedCellBB.expand( cell_idx_t(1) );
+   WALBERLA_ASSERT( expandedCellBB.contains( interval ) );
+#endif
+
+   return interval;
+}
+
+
+
+template< typename Field_T, typename Stencil >
+Vector3< cell_idx_t > PackInfo< Field_T, Stencil >::coarseToFineStep( stencil::Direction dir, const BlockID & smallBlock )
+{
+   // only the directions parallel to the interface are refined, there is just one ghost layer normal to the interface
+   Vector3< cell_idx_t > shift = Base::getNeighborShift( smallBlock, dir );
+
+   Vector3< cell_idx_t > step;
+   for( uint_t i = 0; i != 3; ++i )
+      step[i] = ( shift[i] == cell_idx_t(0) ) ? cell_idx_t(1) : cell_idx_t(2);
+   return step;
+}
+
+
+
+template< typename Field_T, typename Stencil >
+Cell PackInfo< Field_T, Stencil >::coarseToFineFirstCell( const CellInterval & unpackingInterval, const BlockID & smallBlock,
+                                                          stencil::Direction dir )
+{
+   // the unpacking interval contains one fine cell beyond the fine block, the coarse cell that covers it also covers
+   // the next fine cell (which is not set) if the fine block is located in the upper half of the coarse block
+   Vector3< cell_idx_t > shift = Base::getNeighborShift( smallBlock, dir );
+
+   Cell first( unpackingInterval.min() );
+   for( uint_t i = 0; i != 3; ++i )
+      if( shift[i] == cell_idx_t(1) )
+         first[i] -= cell_idx_t(1);
+   return first;
+}
+
+
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::setCoveredCells( Field_T * field, const CellInterval & unpackingInterval, const Cell & first,
+                                                    const Vector3< cell_idx_t > & step, stencil::Direction dir, const uint_t idx,
+                                                    const typename Field_T::value_type & value )
+{
+   // the ghost cell is located between the fine cell next to it (distance: one fine cell) and the center of the coarse
+   // cell (distance: half a fine cell), the cells that extend the ghost layer beyond the fine block keep the coarse value
+   const CellInterval & cellBB = field->xyzSize();
+
+   for( cell_idx_t z = first.z(); z != first.z() + step[2]; ++z )
+      for( cell_idx_t y = first.y(); y != first.y() + step[1]; ++y )
+         for( cell_idx_t x = first.x(); x != first.x() + step[0]; ++x )
+         {
+            if( !unpackingInterval.contains( x, y, z ) )
+               continue;
+
+            const Cell inner( x - stencil::cx[dir], y - stencil::cy[dir], z - stencil::cz[dir] );
+            if( cellBB.contains( inner ) )
+               field->get( x, y, z, idx ) = ( real_t(2) * value + field->get( inner, idx ) ) / real_t(3);
+            else
+               field->get( x, y, z, idx ) = value;
+         }
+}
+
+
+
+template< typename Field_T, typename Stencil >
+Vector3< cell_idx_t > PackInfo< Field_T, Stencil >::fineToCoarseStep( stencil::Direction dir )
+{
+   Vector3< cell_idx_t > step;
+   for( uint_t i = 0; i != 3; ++i )
+      step[i] = ( i < Stencil::D && stencil::c[i][dir] == 0 ) ? cell_idx_t(2) : cell_idx_t(1);
+   return step;
+}
+
+
+
+template< typename Field_T, typename Stencil >
+typename Field_T::value_type PackInfo< Field_T, Stencil >::fineLayerAverage( const Field_T * field, const Cell & first,
+                                                                             const Vector3< cell_idx_t > & step, const uint_t idx )
+{
+   typename Field_T::value_type value( 0 );
+   for( cell_idx_t z = first.z(); z != first.z() + step[2]; ++z )
+      for( cell_idx_t y = first.y(); y != first.y() + step[1]; ++y )
+         for( cell_idx_t x = first.x(); x != first.x() + step[0]; ++x )
+            value += field->get( x, y, z, idx );
+   return value / real_c( step[0] * step[1] * step[2] );
+}
+
+
+
+template< typename Field_T, typename Stencil >
+void PackInfo< Field_T, Stencil >::setCoarseGhostCell( Field_T * field, const Cell & cell, stencil::Direction dir, const uint_t idx,
+                                                       const typename Field_T::value_type & value )
+{
+   // the average of the fine cells is located at a quarter of a coarse cell from the interface, the value is
+   // extrapolated from the center of the coarse cell next to the ghost cell
+   const Cell inner( cell.x() - stencil::cx[dir], cell.y() - stencil::cy[dir], cell.z() - stencil::cz[dir] );
+   field->get( cell, idx ) = ( real_t(4) * value - field->get( inner, idx ) ) / real_t(3);
+}
+
+
+
+} // namespace refinement
+} // namespace pde
+} // namespace walberla
@@ -37,6 +37,17 @@ void Restrict< Stencil_T >::operator()( IBlock * const block ) const
    auto fine   = block->getData< Field_T >( fineFieldId_ );
    auto coarse = block->getData< Field_T >( coarseFieldId_ );
 
+   // blocks that are not coarsened on this level (refined block forests): the residual is only scaled like the
+   // restricted residual of the coarsened blocks
+   if( coarse->xyzSize() == fine->xyzSize() )
+   {
+      const real_t factor = ( Stencil_T::D == uint_t(3) ) ? real_t(8) : real_t(4);
+      WALBERLA_FOR_ALL_CELLS_XYZ( coarse,
+         coarse->get(x,y,z) = factor * fine->get(x,y,z);
+      );
+      return;
+   }
+
    WALBERLA_FOR_ALL_CELLS_XYZ( coarse,
 
       const cell_idx_t fx = 2*x;
@@ -68,6 +79,16 @@ void ProlongateAndCorrect< Stencil_T >::operator()( IBlock * const block ) const
    auto fine   = block->getData< Field_T >( fineFieldId_ );
    auto coarse = block->getData< Field_T >( coarseFieldId_ );
 
+   // blocks that are not coarsened on this level (refined block forests)
+   if( coarse->xyzSize() == fine->xyzSize() )
+   {
+      const real_t factor = ( Stencil_T::D == uint_t(3) ) ? real_t(0.125) : real_t(0.25);
+      WALBERLA_FOR_ALL_CELLS_XYZ( fine,
+         fine->get(x,y,z) += factor * coarse->get(x,y,z);
+      );
+      return;
+   }
+
    WALBERLA_FOR_ALL_CELLS_XYZ( fine,
       if( Stencil_T::D == uint_t(3) )
       {
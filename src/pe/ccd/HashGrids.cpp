@@ -30,6 +30,9 @@
 
 #include "core/timing/TimingTree.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace walberla{
 namespace pe{
 namespace ccd {
@@ -223,6 +226,27 @@ void HashGrids::HashGrid::clear()
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Sorts the body-occupied cells by their position in the grid.
+ *
+ * \return void
+ *
+ * Removing bodies from cells shuffles the order of the \a occupiedCells_ vector over time. After
+ * sorting, the cells are traversed in memory order during the detection step, i.e. neighboring
+ * cells are processed one after another and the bodies collected by process() are ordered by
+ * their cell association. This improves the data locality of the detection step. Since the
+ * order of the generated contacts changes, the sorting is only performed on request.
+ */
+void HashGrids::HashGrid::sortOccupiedCells()
+{
+   std::sort( occupiedCells_.begin(), occupiedCells_.end(), std::less<Cell*>() );
+   for( size_t i = 0; i < occupiedCells_.size(); ++i ) {
+      occupiedCells_[i]->occupiedCellsId_ = i;
+   }
+}
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\brief Sets up the neighborhood relationships for all grid cells.
  *
@@ -595,6 +619,8 @@ HashGrids::HashGrids( BodyStorage& globalStorage, BodyStorage& bodystorage, Body
    , bodystorage_( bodystorage )
    , bodystorageShadowCopies_( bodystorageShadowCopies )
    , observedBodyCount_(0)
+   , cellSortingInterval_(0)
+   , detectionCount_(0)
 {
    nonGridBodies_.reserve( gridActivationThreshold );
 
@@ -922,36 +948,40 @@ PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
    }
    if (tt != NULL) tt->stop("Update");
 
+   if( cellSortingInterval_ > 0 && detectionCount_ % cellSortingInterval_ == 0 )
+   {
+      if (tt != NULL) tt->start("SortCells");
+      for( auto gridIt = gridList_.begin(); gridIt != gridList_.end(); ++gridIt ) {
+         (*gridIt)->sortOccupiedCells();
+      }
+      if (tt != NULL) tt->stop("SortCells");
+   }
+   ++detectionCount_;
+
    if (tt != NULL) tt->start("Detection");
    // ----- DETECTION STEP ----- //
 
+#ifdef _OPENMP
+   threadContacts_.resize( uint_c( omp_get_max_threads() ) );
+#endif
+
    // Contact generation by traversing through all hash grids (which are sorted in ascending order
    // with respect to the size of their cells).
    for( auto gridIt = gridList_.begin(); gridIt != gridList_.end(); ++gridIt ) {
 
       // Contact generation for all bodies stored in the currently processed grid 'grid'.
       BodyID* bodies     = NULL;
-      size_t  bodyCount = (*gridIt)->process( &bodies, contacts_ );
+      size_t  bodyCount = (*gridIt)->process( &bodies, contacts_, threadContacts_ );
 
       if( bodyCount > 0 ) {
 
          // Test all bodies stored in 'grid' against bodies stored in grids with larger sized cells.
          auto nextGridIt = gridIt;
          for( ++nextGridIt; nextGridIt != gridList_.end(); ++nextGridIt ) {
-            (*nextGridIt)->processBodies( bodies, bodyCount, contacts_ );
+            (*nextGridIt)->processBodies( bodies, bodyCount, contacts_, threadContacts_ );
          }
 
-         BodyID* bodiesEnd = bodies + bodyCount;
-         for( BodyID* a = bodies; a < bodiesEnd; ++a ) {
-            // Test all bodies stored in 'grid' against all bodies stored in 'nonGridBodies_'.
-            for( auto bIt = nonGridBodies_.begin(); bIt < nonGridBodies_.end(); ++bIt ) {
-               collide( *a, *bIt, contacts_ );
-            }
-            // Test all bodies stored in 'grid' against all bodies stored in 'globalStorage_'.
-            for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
-               collide( *a, *bIt, contacts_ );
-            }
-         }
+         processNonGridBodies( bodies, bodyCount );
       }
 
       delete[] bodies;
@@ -990,6 +1020,65 @@ PossibleContacts& HashGrids::generatePossibleContacts( WcTimingTree* tt )
 }
 
 
+//=================================================================================================
+//
+//  DETECTION FUNCTIONS
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Checks the bodies of a grid against all unassigned and all global bodies.
+ *
+ * \param bodies Linear array of (handles to) the bodies stored in a grid.
+ * \param bodyCount The number of bodies that are stored in \a bodies.
+ * \return void
+ *
+ * The bodies are distributed among the threads like in HashGrid::processBodies().
+ */
+void HashGrids::processNonGridBodies( BodyID* bodies, size_t bodyCount )
+{
+#ifdef _OPENMP
+   if( threadContacts_.size() > 1 )
+   {
+      const int count = int_c( bodyCount );
+
+      #pragma omp parallel num_threads( int_c( threadContacts_.size() ) )
+      {
+         PossibleContacts& localContacts = threadContacts_[ uint_c( omp_get_thread_num() ) ];
+
+         #pragma omp for schedule(static)
+         for( int i = 0; i < count; ++i ) {
+            for( auto bIt = nonGridBodies_.begin(); bIt < nonGridBodies_.end(); ++bIt ) {
+               collide( bodies[i], *bIt, localContacts );
+            }
+            for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
+               collide( bodies[i], *bIt, localContacts );
+            }
+         }
+      }
+
+      mergeContacts( threadContacts_, contacts_ );
+      return;
+   }
+#endif
+
+   BodyID* bodiesEnd = bodies + bodyCount;
+   for( BodyID* a = bodies; a < bodiesEnd; ++a ) {
+      // Test all bodies stored in 'grid' against all bodies stored in 'nonGridBodies_'.
+      for( auto bIt = nonGridBodies_.begin(); bIt < nonGridBodies_.end(); ++bIt ) {
+         collide( *a, *bIt, contacts_ );
+      }
+      // Test all bodies stored in 'grid' against all bodies stored in 'globalStorage_'.
+      for( auto bIt = globalStorage_.begin(); bIt < globalStorage_.end(); ++bIt ) {
+         collide( *a, *bIt, contacts_ );
+      }
+   }
+}
+//*************************************************************************************************
+
+
+
+
 //=================================================================================================
 //
 //  ADD FUNCTIONS
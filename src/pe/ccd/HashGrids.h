@@ -34,6 +34,7 @@
 #include <core/logging/Logging.h>
 #include <core/debug/Debug.h>
 #include <core/NonCopyable.h>
+#include <core/OpenMP.h>
 
 #include <cmath>
 #include <list>
@@ -76,6 +77,13 @@ namespace ccd {
  * is <b>especially well-suited for large-scale simulations</b> involving very large numbers of
  * bodies.
  *
+ * If waLBerla is built with OpenMP, the detection step is executed by all threads: the occupied
+ * cells of a grid (and the bodies checked against grids with larger cells) are distributed among
+ * the threads, which collect their contacts in thread-local buffers. The possible contacts are
+ * identical to the ones of the sequential detection, including their order. Optionally, the
+ * occupied cells can be sorted by their position in the grid every few time steps (see
+ * setCellSortingInterval()) to improve the data locality of the detection step.
+ *
  * For further information and a much more detailed explanation of this algorithm see
  *     http://www10.informatik.uni-erlangen.de/Publications/Theses/2009/Schornbaum_SA09.pdf
  */
@@ -172,11 +180,12 @@ private:
       void update( BodyID body );
 
       template< typename Contacts >
-      size_t process      ( BodyID** gridBodies, Contacts& contacts ) const;
+      size_t process      ( BodyID** gridBodies, Contacts& contacts, std::vector<Contacts>& threadContacts ) const;
 
       template< typename Contacts >
-      void   processBodies( BodyID* bodies, size_t bodyCount, Contacts& contacts ) const;
+      void   processBodies( BodyID* bodies, size_t bodyCount, Contacts& contacts, std::vector<Contacts>& threadContacts ) const;
 
+      void sortOccupiedCells();
       void clear();
       //@}
       //*******************************************************************************************
@@ -187,6 +196,12 @@ private:
       //@{
       void initializeNeighborOffsets();
 
+      template< typename Contacts >
+      void processCell( const Cell* cell, Contacts& contacts ) const;
+
+      template< typename Contacts >
+      void processBody( BodyID body, Contacts& contacts ) const;
+
       size_t hash( BodyID body ) const;
 
       void add   ( BodyID body, Cell* cell );
@@ -268,6 +283,14 @@ public:
    //@}
    //**********************************************************************************************
 
+   //**Get/set functions***************************************************************************
+   /*!\name Get/set functions */
+   //@{
+   inline size_t getCellSortingInterval() const { return cellSortingInterval_; }
+   inline void   setCellSortingInterval( size_t interval ) { cellSortingInterval_ = interval; }
+   //@}
+   //**********************************************************************************************
+
    //**Utility functions***************************************************************************
    /*!\name Utility functions */
    //@{
@@ -287,6 +310,9 @@ protected:
    //@{
    template< typename Contacts >
    static inline void collide( BodyID a, BodyID b, Contacts& contacts );
+
+   template< typename Contacts >
+   static inline void mergeContacts( std::vector<Contacts>& threadContacts, Contacts& contacts );
    //@}
    //**********************************************************************************************
 
@@ -299,6 +325,13 @@ private:
    //@}
    //**********************************************************************************************
 
+   //**Detection functions*************************************************************************
+   /*!\name Detection functions */
+   //@{
+   void processNonGridBodies( BodyID* bodies, size_t bodyCount );
+   //@}
+   //**********************************************************************************************
+
    //**Utility functions***************************************************************************
    /*!\name Utility functions */
    //@{
@@ -333,6 +366,9 @@ private:
                                       faster than involving the far more complex mechanisms of the
                                       hierarchical hash grids. */
    int          observedBodyCount_;  /// number of bodies currently tracked by this hashgrid
+   size_t       cellSortingInterval_;  //!< Number of detection steps between two sortings of the occupied cells (0: never).
+   size_t       detectionCount_;       //!< Number of calls of generatePossibleContacts().
+   std::vector<PossibleContacts> threadContacts_;  //!< Thread-local contact buffers of the parallel detection step.
    //@}
    //**********************************************************************************************
 };
@@ -353,66 +389,59 @@ private:
  *
  * \param gridBodies Linear array of (handles to) all the bodies stored in this hash grid.
  * \param contacts Contact container for the generated contacts.
+ * \param threadContacts One contact buffer per thread for the parallel traversal.
  * \return The number of bodies stored in this grid - which is the number of bodies stored in \a gridBodies.
  *
  * This function generates all contacts between all rigid bodies that are assigned to this grid. The
  * contacts are added to the contact container \a contacts. Moreover, a linear array that contains
  * (handles to) all bodies that are stored in this grid is returned in order to being able to check
  * these bodies against other bodies that are stored in grids with larger sized cells.
+ *
+ * If \a threadContacts provides more than one buffer, the occupied cells are distributed among
+ * the threads in contiguous chunks and each thread stores its contacts in its own buffer. The
+ * buffers are appended to \a contacts in the order of the threads, hence the contacts are the
+ * same and in the same order as in the sequential traversal.
  */
 template< typename Contacts >  // Contact container type
-size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts ) const
+size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts, std::vector<Contacts>& threadContacts ) const
 {
    BodyID* bodies = new BodyID[ bodyCount_ ];
    *gridBodies    = bodies;
 
-   // Iterate through all cells that are occupied by bodies (=> 'occupiedCells_') and ...
+   // Collect all bodies in the order of the occupied cells.
    for( typename CellVector::const_iterator cell = occupiedCells_.begin(); cell < occupiedCells_.end(); ++cell )
    {
       BodyVector* cellBodies = (*cell)->bodies_;
-
-      // ... perform pairwise collision checks within each of these cells.
       for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
-         auto end = cellBodies->begin();
-         if ((*aIt)->isFixed())
-         {
-            end = cellBodies->begin() + ((*cell)->lastNonFixedBody_ + 1);
-         } else
-         {
-            end = cellBodies->end();
-         }
-         for( auto bIt = aIt + 1; bIt < end; ++bIt ) {
-            WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
-            HashGrids::collide( *aIt, *bIt, contacts );
-         }
          *(bodies++) = *aIt;
       }
+   }
 
-      // Moreover, check all the bodies that are stored in the currently processed cell against all
-      // bodies that are stored in the first half of all directly adjacent cells.
-      for( unsigned int i = 0; i < 13; ++i )
+#ifdef _OPENMP
+   if( threadContacts.size() > 1 )
+   {
+      const int cellCount = int_c( occupiedCells_.size() );
+
+      #pragma omp parallel num_threads( int_c( threadContacts.size() ) )
       {
-         Cell*       nbCell   = (*cell) + (*cell)->neighborOffset_[i];
-         BodyVector* nbBodies = nbCell->bodies_;
+         Contacts& localContacts = threadContacts[ uint_c( omp_get_thread_num() ) ];
 
-         if( nbBodies != NULL )
-         {
-            for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
-               auto endNeighbour = nbBodies->begin();
-               if ((*aIt)->isFixed())
-               {
-                  endNeighbour = nbBodies->begin() + (nbCell->lastNonFixedBody_ + 1);
-               } else
-               {
-                  endNeighbour = nbBodies->end();
-               }
-               for( auto bIt = nbBodies->begin(); bIt < endNeighbour; ++bIt ) {
-                  WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
-                  HashGrids::collide( *aIt, *bIt, contacts );
-               }
-            }
+         #pragma omp for schedule(static)
+         for( int i = 0; i < cellCount; ++i ) {
+            processCell( occupiedCells_[ uint_c(i) ], localContacts );
          }
       }
+
+      mergeContacts( threadContacts, contacts );
+      return bodyCount_;
+   }
+#else
+   WALBERLA_UNUSED( threadContacts );
+#endif
+
+   // Iterate through all cells that are occupied by bodies (=> 'occupiedCells_').
+   for( typename CellVector::const_iterator cell = occupiedCells_.begin(); cell < occupiedCells_.end(); ++cell ) {
+      processCell( *cell, contacts );
    }
 
    return bodyCount_;
@@ -428,31 +457,85 @@ size_t HashGrids::HashGrid::process( BodyID** gridBodies, Contacts& contacts ) c
  *        collisions with the bodies that are stored in this grid.
  * \param bodyCount The number of bodies that are stored in \a bodies.
  * \param contacts Contact container for the generated contacts.
+ * \param threadContacts One contact buffer per thread for the parallel traversal.
  * \return void
  *
  * This function generates all contacts between the rigid bodies that are stored in \a bodies and
  * all the rigid bodies that are assigned to this grid. The contacts are added to the contact
- * container \a contacts.
+ * container \a contacts. The bodies are distributed among the threads like the cells in process().
  */
 template< typename Contacts >  // Contact container type
-void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Contacts& contacts ) const
+void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Contacts& contacts, std::vector<Contacts>& threadContacts ) const
 {
-   // For each body 'a' that is stored in 'bodies' ...
-   for( BodyID* aIt = bodies; aIt < bodies + bodyCount; ++aIt )
+#ifdef _OPENMP
+   if( threadContacts.size() > 1 )
    {
-      // ... calculate the body's cell association (=> "hash()") within this hash grid and ...
-      Cell* cell = cell_ + hash( *aIt );
-
-      // ... check 'a' against every body that is stored in this or in any of the directly adjacent
-      // cells. Note: one entry in the offset array of a cell is always referring back to the cell
-      // itself. As a consequence, a specific cell X and all of its neighbors can be addressed by
-      // simply iterating through all entries of X's offset array!
-      for( unsigned int i = 0; i < 27; ++i )
+      const int count = int_c( bodyCount );
+
+      #pragma omp parallel num_threads( int_c( threadContacts.size() ) )
+      {
+         Contacts& localContacts = threadContacts[ uint_c( omp_get_thread_num() ) ];
+
+         #pragma omp for schedule(static)
+         for( int i = 0; i < count; ++i ) {
+            processBody( bodies[i], localContacts );
+         }
+      }
+
+      mergeContacts( threadContacts, contacts );
+      return;
+   }
+#else
+   WALBERLA_UNUSED( threadContacts );
+#endif
+
+   // For each body 'a' that is stored in 'bodies' ...
+   for( BodyID* aIt = bodies; aIt < bodies + bodyCount; ++aIt ) {
+      processBody( *aIt, contacts );
+   }
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Generates all contacts between the bodies of a cell and with the bodies that are stored
+ *        in the first half of all directly adjacent cells.
+ *
+ * \param cell The body-occupied cell.
+ * \param contacts Contact container for the generated contacts.
+ * \return void
+ */
+template< typename Contacts >  // Contact container type
+void HashGrids::HashGrid::processCell( const Cell* cell, Contacts& contacts ) const
+{
+   BodyVector* cellBodies = cell->bodies_;
+
+   // Perform pairwise collision checks within the cell.
+   for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
+      auto end = cellBodies->begin();
+      if ((*aIt)->isFixed())
       {
-         Cell*       nbCell   = cell + cell->neighborOffset_[i];
-         BodyVector* nbBodies = nbCell->bodies_;
+         end = cellBodies->begin() + (cell->lastNonFixedBody_ + 1);
+      } else
+      {
+         end = cellBodies->end();
+      }
+      for( auto bIt = aIt + 1; bIt < end; ++bIt ) {
+         WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
+         HashGrids::collide( *aIt, *bIt, contacts );
+      }
+   }
+
+   // Moreover, check all the bodies that are stored in the cell against all bodies that are
+   // stored in the first half of all directly adjacent cells.
+   for( unsigned int i = 0; i < 13; ++i )
+   {
+      const Cell* nbCell   = cell + cell->neighborOffset_[i];
+      BodyVector* nbBodies = nbCell->bodies_;
 
-         if( nbBodies != NULL ) {
+      if( nbBodies != NULL )
+      {
+         for( auto aIt = cellBodies->begin(); aIt < cellBodies->end(); ++aIt ) {
             auto endNeighbour = nbBodies->begin();
             if ((*aIt)->isFixed())
             {
@@ -461,7 +544,7 @@ void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Conta
             {
                endNeighbour = nbBodies->end();
             }
-            for( auto bIt = nbBodies->begin(); bIt != endNeighbour; ++bIt ) {
+            for( auto bIt = nbBodies->begin(); bIt < endNeighbour; ++bIt ) {
                WALBERLA_ASSERT( !((*aIt)->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
                HashGrids::collide( *aIt, *bIt, contacts );
             }
@@ -472,6 +555,47 @@ void HashGrids::HashGrid::processBodies( BodyID* bodies, size_t bodyCount, Conta
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Checks a body for collisions with the bodies that are stored in this grid.
+ *
+ * \param body The body that is about to be checked.
+ * \param contacts Contact container for the generated contacts.
+ * \return void
+ */
+template< typename Contacts >  // Contact container type
+void HashGrids::HashGrid::processBody( BodyID body, Contacts& contacts ) const
+{
+   // Calculate the body's cell association (=> "hash()") within this hash grid and ...
+   const Cell* cell = cell_ + hash( body );
+
+   // ... check the body against every body that is stored in this or in any of the directly adjacent
+   // cells. Note: one entry in the offset array of a cell is always referring back to the cell
+   // itself. As a consequence, a specific cell X and all of its neighbors can be addressed by
+   // simply iterating through all entries of X's offset array!
+   for( unsigned int i = 0; i < 27; ++i )
+   {
+      const Cell* nbCell   = cell + cell->neighborOffset_[i];
+      BodyVector* nbBodies = nbCell->bodies_;
+
+      if( nbBodies != NULL ) {
+         auto endNeighbour = nbBodies->begin();
+         if (body->isFixed())
+         {
+            endNeighbour = nbBodies->begin() + (nbCell->lastNonFixedBody_ + 1);
+         } else
+         {
+            endNeighbour = nbBodies->end();
+         }
+         for( auto bIt = nbBodies->begin(); bIt != endNeighbour; ++bIt ) {
+            WALBERLA_ASSERT( !(body->isFixed() && (*bIt)->isFixed()), "collision between two fixed bodies" );
+            HashGrids::collide( body, *bIt, contacts );
+         }
+      }
+   }
+}
+//*************************************************************************************************
+
+
 
 
 //=================================================================================================
@@ -502,6 +626,30 @@ void HashGrids::collide( BodyID a, BodyID b, Contacts& contacts )
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Appends the thread-local contact buffers in the order of the threads and clears them.
+ *
+ * \param threadContacts The thread-local contact buffers.
+ * \param contacts Contact container for the generated contacts.
+ * \return void
+ */
+template< typename Contacts >  // Contact container type
+void HashGrids::mergeContacts( std::vector<Contacts>& threadContacts, Contacts& contacts )
+{
+   size_t size = contacts.size();
+   for( auto it = threadContacts.begin(); it != threadContacts.end(); ++it ) {
+      size += it->size();
+   }
+   contacts.reserve( size );
+
+   for( auto it = threadContacts.begin(); it != threadContacts.end(); ++it ) {
+      contacts.insert( contacts.end(), it->begin(), it->end() );
+      it->clear();
+   }
+}
+//*************************************************************************************************
+
+
 }  // namespace ccd
 
 }  // namespace pe
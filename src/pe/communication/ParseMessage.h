@@ -25,6 +25,7 @@
 #include "pe/rigidbody/BodyStorage.h"
 #include "pe/communication/DynamicMarshalling.h"
 #include "pe/communication/RigidBodyCopyNotification.h"
+#include "pe/communication/RigidBodyDeltaUpdateNotification.h"
 #include "pe/communication/RigidBodyDeletionNotification.h"
 #include "pe/communication/RigidBodyForceNotification.h"
 #include "pe/communication/RigidBodyMigrationNotification.h"
@@ -103,6 +104,32 @@ void parseMessage(Owner sender, mpi::RecvBuffer& rb, const domain_decomposition:
 
             break;
          }
+         case rigidBodyDeltaUpdateNotification: {
+            typename RigidBodyDeltaUpdateNotification::Parameters objparam;
+            unmarshal( rb, objparam );
+
+            WALBERLA_LOG_DETAIL( "Received rigid body delta update notification for body " << objparam.sid_ << " from neighboring process with rank " << sender << " (fields " << int_c(objparam.fields_) << ")" );
+
+            auto bodyIt = shadowStorage.find( objparam.sid_ );
+            WALBERLA_ASSERT_UNEQUAL( bodyIt, shadowStorage.end() );
+            BodyID b( *bodyIt );
+
+            WALBERLA_ASSERT( b->MPITrait.getOwner().blockID_ == sender.blockID_, "Update notifications must be sent by owner.\n" << b->MPITrait.getOwner().blockID_ << " != "<< sender.blockID_ );
+            WALBERLA_ASSERT( b->isRemote(), "Update notification must only concern shadow copies." );
+
+            if( objparam.fields_ & RigidBodyDeltaUpdateNotification::POSITION )
+            {
+               correctBodyPosition(blockStorage.getDomain(), block.getAABB().center(), objparam.gpos_);
+               b->setPosition( objparam.gpos_ );
+            }
+            if( objparam.fields_ & RigidBodyDeltaUpdateNotification::ORIENTATION ) b->setOrientation( objparam.q_ );
+            if( objparam.fields_ & RigidBodyDeltaUpdateNotification::LINEAR_VEL  ) b->setLinearVel  ( objparam.v_ );
+            if( objparam.fields_ & RigidBodyDeltaUpdateNotification::ANGULAR_VEL ) b->setAngularVel ( objparam.w_ );
+
+            WALBERLA_LOG_DETAIL( "Processed rigid body delta update notification.");
+
+            break;
+         }
          case rigidBodyMigrationNotification: {
             RigidBodyMigrationNotification::Parameters objparam;
             unmarshal( rb, objparam );
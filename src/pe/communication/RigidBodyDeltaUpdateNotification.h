@@ -0,0 +1,168 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file RigidBodyDeltaUpdateNotification.h
+//! \brief Header file for the RigidBodyDeltaUpdateNotification class
+//
+//======================================================================================================================
+
+#pragma once
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include <pe/rigidbody/RigidBody.h>
+#include "NotificationType.h"
+#include "Marshalling.h"
+
+#include <cstring>
+
+
+namespace walberla {
+namespace pe {
+namespace communication {
+
+//=================================================================================================
+//
+//  CLASS DEFINITION
+//
+//=================================================================================================
+
+//*************************************************************************************************
+/*!\brief Wrapper class for rigid body updates that only contain the changed parts of the state.
+ *
+ * In contrast to the RigidBodyUpdateNotification, only those of the position, orientation, linear
+ * and angular velocity are marshalled which differ from the state that was sent in the previous
+ * synchronization (see State). The fields that are contained in the notification are flagged in
+ * a bit mask. The receiver keeps the values of its shadow copy for all other fields.
+ */
+class RigidBodyDeltaUpdateNotification {
+public:
+   //! Bit flags of the fields contained in the notification.
+   enum Field {
+      POSITION    = 1,
+      ORIENTATION = 2,
+      LINEAR_VEL  = 4,
+      ANGULAR_VEL = 8,
+      ALL         = 15
+   };
+
+   //! The part of the rigid body state that is synchronized.
+   struct State {
+      State() {}
+      explicit State( const RigidBody& b ) : gpos_( b.getPosition() ), q_( b.getQuaternion() ), v_( b.getLinearVel() ), w_( b.getAngularVel() ) {}
+
+      Vec3 gpos_;
+      Quat q_;
+      Vec3 v_, w_;
+   };
+
+   struct Parameters {
+      id_t sid_;
+      uint8_t fields_;
+      Vec3 gpos_, v_, w_;
+      Quat q_;
+   };
+
+   inline RigidBodyDeltaUpdateNotification( const RigidBody& b, const uint8_t fields ) : body_(b), fields_(fields) {}
+
+   static inline uint8_t changedFields( const RigidBody& b, const State& last );
+
+   const RigidBody& body_;
+   const uint8_t fields_;
+};
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Returns the fields of the state of body \a b that differ from \a last.
+ *
+ * \param b The rigid body.
+ * \param last The state of the rigid body that was sent in the previous synchronization.
+ * \return Bit mask of the changed fields (see Field).
+ *
+ * The values are compared bitwise, hence the shadow copies are identical to the ones obtained with
+ * RigidBodyUpdateNotification.
+ */
+inline uint8_t RigidBodyDeltaUpdateNotification::changedFields( const RigidBody& b, const State& last ) {
+   uint8_t fields( 0 );
+   if( std::memcmp( &b.getPosition(),   &last.gpos_, sizeof(Vec3) ) != 0 ) fields |= POSITION;
+   if( std::memcmp( &b.getQuaternion(), &last.q_,    sizeof(Quat) ) != 0 ) fields |= ORIENTATION;
+   if( std::memcmp( &b.getLinearVel(),  &last.v_,    sizeof(Vec3) ) != 0 ) fields |= LINEAR_VEL;
+   if( std::memcmp( &b.getAngularVel(), &last.w_,    sizeof(Vec3) ) != 0 ) fields |= ANGULAR_VEL;
+   return fields;
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Marshalling rigid body delta updates.
+ *
+ * \param buffer The buffer to be filled.
+ * \param obj The object to be marshalled.
+ * \return void
+ *
+ * The update consists of the bit mask of the contained fields followed by the flagged fields of
+ * position, orientation and linear and angular velocities.
+ */
+template< typename Buffer >
+inline void marshal( Buffer& buffer, const RigidBodyDeltaUpdateNotification& obj ) {
+
+   buffer << obj.body_.getSystemID();
+   buffer << obj.fields_;
+   if( obj.fields_ & RigidBodyDeltaUpdateNotification::POSITION    ) buffer << obj.body_.getPosition();
+   if( obj.fields_ & RigidBodyDeltaUpdateNotification::ORIENTATION ) buffer << obj.body_.getQuaternion();
+   if( obj.fields_ & RigidBodyDeltaUpdateNotification::LINEAR_VEL  ) buffer << obj.body_.getLinearVel();
+   if( obj.fields_ & RigidBodyDeltaUpdateNotification::ANGULAR_VEL ) buffer << obj.body_.getAngularVel();
+
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Unmarshalling rigid body delta updates.
+ *
+ * \param buffer The buffer from where to read.
+ * \param objparam The object to be reconstructed.
+ * \return void
+ *
+ * Only the flagged fields of \a objparam are set.
+ */
+template< typename Buffer >
+inline void unmarshal( Buffer& buffer, typename RigidBodyDeltaUpdateNotification::Parameters& objparam ) {
+   buffer >> objparam.sid_;
+   buffer >> objparam.fields_;
+   if( objparam.fields_ & RigidBodyDeltaUpdateNotification::POSITION    ) buffer >> objparam.gpos_;
+   if( objparam.fields_ & RigidBodyDeltaUpdateNotification::ORIENTATION ) buffer >> objparam.q_;
+   if( objparam.fields_ & RigidBodyDeltaUpdateNotification::LINEAR_VEL  ) buffer >> objparam.v_;
+   if( objparam.fields_ & RigidBodyDeltaUpdateNotification::ANGULAR_VEL ) buffer >> objparam.w_;
+
+}
+//*************************************************************************************************
+
+//*************************************************************************************************
+/*!\brief Returns the notification type of a rigid body delta update.
+ * \return The notification type of a rigid body delta update.
+ */
+template<>
+inline NotificationType notificationType< RigidBodyDeltaUpdateNotification >() {
+   return rigidBodyDeltaUpdateNotification;
+}
+//*************************************************************************************************
+
+}  // namespace communication
+}  // namespace pe
+}  // namespace walberla
@@ -0,0 +1,102 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ContactHistory.h
+//! \brief Storage for data of persistent contacts across time steps
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "pe/Types.h"
+
+#include "core/DataTypes.h"
+
+#include <algorithm>
+#include <map>
+
+namespace walberla {
+namespace pe {
+
+//*************************************************************************************************
+/*!\brief Stores data of the contacts of one time step for the next time step.
+ *
+ * Contacts are identified by the system IDs of the two bodies. If the same pair of bodies has
+ * several contacts (e.g. box-box contacts), the contacts are distinguished by the order in which
+ * they are accessed within a time step. The values are stored with respect to the body with the
+ * smaller system ID, quantities which change sign if the bodies are swapped have to be multiplied
+ * by orientation().
+ *
+ * In each time step, value() has to be called once for every contact. It returns the value of the
+ * same contact in the previous time step, or a default constructed value for new contacts. After
+ * all contacts have been processed, finishTimestep() forgets all contacts that were not accessed
+ * in the current time step (i.e. contacts that were broken up).
+ *
+ * The history is local to a process: if the treatment of a contact moves to another process, the
+ * contact starts without history there.
+ */
+template< typename T >
+class ContactHistory
+{
+public:
+   //! Returns the value of the contact between the bodies \a sid1 and \a sid2 for the current time step.
+   T& value( const walberla::id_t sid1, const walberla::id_t sid2 );
+
+   //! Forgets all contacts which were not accessed since the last call.
+   void finishTimestep() { last_.swap( current_ ); current_.clear(); }
+
+   //! Removes all contacts.
+   void clear() { last_.clear(); current_.clear(); }
+
+   //! Number of contacts in the history of the previous time step.
+   size_t size() const { return last_.size(); }
+
+   //! +1 if \a sid1 is the reference body of the pair, -1 otherwise
+   static real_t orientation( const walberla::id_t sid1, const walberla::id_t sid2 ) { return sid1 < sid2 ? real_t(1) : real_t(-1); }
+
+private:
+   struct Key
+   {
+      Key( walberla::id_t s1, walberla::id_t s2, uint_t i ) : sid1( s1 ), sid2( s2 ), index( i ) {}
+
+      bool operator<( const Key& other ) const
+      {
+         if( sid1 != other.sid1 ) return sid1 < other.sid1;
+         if( sid2 != other.sid2 ) return sid2 < other.sid2;
+         return index < other.index;
+      }
+
+      walberla::id_t sid1;
+      walberla::id_t sid2;
+      uint_t         index;
+   };
+
+   std::map< Key, T > last_;
+   std::map< Key, T > current_;
+};
+
+template< typename T >
+T& ContactHistory<T>::value( const walberla::id_t sid1, const walberla::id_t sid2 )
+{
+   Key key( std::min( sid1, sid2 ), std::max( sid1, sid2 ), uint_t(0) );
+   while( current_.find( key ) != current_.end() )
+      ++key.index;
+
+   auto last = last_.find( key );
+   return current_.insert( std::make_pair( key, last != last_.end() ? last->second : T() ) ).first->second;
+}
+
+} // namespace pe
+} // namespace walberla
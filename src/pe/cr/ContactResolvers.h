@@ -4,6 +4,13 @@
 #include "ICR.h"
 #include "pe/contact/Contact.h"
 #include "pe/contact/ContactFunctions.h"
+#include "pe/contact/ContactHistory.h"
+
+#include "core/debug/Debug.h"
+
+#include <boost/mpl/int.hpp>
+
+#include <utility>
 
 namespace walberla {
 namespace pe {
@@ -52,8 +59,146 @@ public:
 
       WALBERLA_LOG_DETAIL("nForce: " << fN << "\ntForce: " << fT);
    }
+
+};
+
+/**
+ * \brief Linear spring-dashpot model with a tangential spring (Cundall and Strack).
+ *
+ * The normal force is calculated as in ResolveContactSpringDashpotHaffWerner. In tangential
+ * direction, the relative displacement of the contact points is integrated over the lifetime of
+ * the contact and stored in the contact history of the solver. The tangential force is the force
+ * of a linear spring (with a stiffness of \a stiffnessRatio times the normal stiffness) and a
+ * dashpot, limited by the Coulomb friction. In the sliding case, the spring is shortened such that
+ * it corresponds to the limited force. In contrast to the Haff and Werner model, static friction
+ * is possible, e.g. bodies can rest on inclined planes.
+ */
+class ResolveContactSpringDashpotCundallStrack {
+public:
+   explicit ResolveContactSpringDashpotCundallStrack( const real_t stiffnessRatio = real_t(2) / real_t(7) )
+      : stiffnessRatio_( stiffnessRatio )
+   {
+      WALBERLA_ASSERT_GREATER( stiffnessRatio_, real_t(0) );
+   }
+
+   void operator()( ContactID c, const real_t dt, ContactHistory<Vec3>& history ) const
+   {
+      WALBERLA_LOG_DETAIL( "resolving contact: " << c->getID() );
+      BodyID b1( c->getBody1()->getTopSuperBody() );
+      BodyID b2( c->getBody2()->getTopSuperBody() );
+
+      // Global position of contact
+      const Vec3 gpos( c->getPosition() );
+
+      // The absolute value of the penetration length
+      real_t delta( -c->getDistance() );
+
+      // Calculating the relative velocity in normal and tangential direction
+      // The negative signs result from the different definition of the relative
+      // normal velocity of the pe (see Contact::getType)
+      const real_t relVelN( -c->getNormalRelVel() );
+      const Vec3   relVel ( -c->getRelVel() );
+      const Vec3   relVelT( relVel - ( relVelN * c->getNormal() ) );
+
+      // The tangential displacement is stored with respect to the body with the smaller system ID
+      Vec3&        history_xi( history.value( b1->getSystemID(), b2->getSystemID() ) );
+      const real_t orientation( ContactHistory<Vec3>::orientation( b1->getSystemID(), b2->getSystemID() ) );
+
+      if( delta < real_t(0) )
+      {
+         // the bodies are not (yet) in contact
+         history_xi = Vec3();
+         return;
+      }
+
+      // Calculating the normal force based on a linear spring-dashpot force model
+      real_t fNabs( getStiffness(c) * delta + getDampingN(c) * relVelN );
+      if( fNabs < real_c(0) ) fNabs = real_c(0);
+      const Vec3 fN( fNabs * c->getNormal() );
+
+      // Rotating the tangential displacement of the last time step into the current tangential plane
+      // and adding the displacement of the current time step
+      Vec3 xi( orientation * history_xi );
+      xi -= ( xi * c->getNormal() ) * c->getNormal();
+      xi += relVelT * dt;
+
+      // Calculating the tangential force and limiting it by Coulomb's law of friction
+      const real_t stiffnessT( stiffnessRatio_ * getStiffness(c) );
+      Vec3 fT( stiffnessT * xi + getDampingT(c) * relVelT );
+      const real_t fTmax( getFriction(c) * fNabs );
+      if( fT.sqrLength() > fTmax * fTmax )
+      {
+         fT = fTmax * fT.getNormalizedOrZero();
+         xi = ( fT - getDampingT(c) * relVelT ) / stiffnessT;
+      }
+
+      history_xi = orientation * xi;
+
+      // Add normal force at contact point
+      b1->addForceAtPos(  fN, gpos );
+      b2->addForceAtPos( -fN, gpos );
+
+      // Add tangential force at contact point
+      b1->addForceAtPos(  fT, gpos );
+      b2->addForceAtPos( -fT, gpos );
+
+      WALBERLA_LOG_DETAIL("nForce: " << fN << "\ntForce: " << fT);
+   }
+
+   real_t getStiffnessRatio() const { return stiffnessRatio_; }
+
+private:
+   real_t stiffnessRatio_; ///< ratio of the tangential to the normal stiffness
+};
+
+namespace internal {
+
+/**
+ * \brief Selects the call signature of a contact resolver of the DEMSolver.
+ *
+ * Contact resolvers that need data of the previous time step (like ResolveContactSpringDashpotCundallStrack) provide
+ * operator()( ContactID, real_t dt, ContactHistory<Vec3>& ). All other resolvers only need to provide
+ * operator()( ContactID, real_t dt ) or operator()( ContactID ). The value is 2, 1, or 0, respectively.
+ */
+template< typename ContactResolver >
+class ContactResolverSignature
+{
+   template< typename T >
+   static auto checkHistory( int ) -> decltype( std::declval< const T & >()( ContactID(), real_t(), std::declval< ContactHistory<Vec3> & >() ), char() );
+   template< typename T >
+   static long checkHistory( ... );
+
+   template< typename T >
+   static auto checkTimeStep( int ) -> decltype( std::declval< const T & >()( ContactID(), real_t() ), char() );
+   template< typename T >
+   static long checkTimeStep( ... );
+
+public:
+   static const int value = ( sizeof( checkHistory< ContactResolver >( 0 ) ) == sizeof( char ) ) ? 2 :
+                            ( ( sizeof( checkTimeStep< ContactResolver >( 0 ) ) == sizeof( char ) ) ? 1 : 0 );
+   typedef boost::mpl::int_< value > type;
 };
 
+template< typename ContactResolver >
+inline void resolveContact( const ContactResolver & resolver, ContactID c, const real_t dt, ContactHistory<Vec3> & history, boost::mpl::int_<2> )
+{
+   resolver( c, dt, history );
+}
+
+template< typename ContactResolver >
+inline void resolveContact( const ContactResolver & resolver, ContactID c, const real_t dt, ContactHistory<Vec3> & /*history*/, boost::mpl::int_<1> )
+{
+   resolver( c, dt );
+}
+
+template< typename ContactResolver >
+inline void resolveContact( const ContactResolver & resolver, ContactID c, const real_t /*dt*/, ContactHistory<Vec3> & /*history*/, boost::mpl::int_<0> )
+{
+   resolver( c );
+}
+
+} // namespace internal
+
 }  // namespace cr
 } // namespace pe
 }  // namespace walberla
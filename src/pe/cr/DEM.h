@@ -31,6 +31,7 @@
 #include "Integrators.h"
 #include "ContactResolvers.h"
 #include "pe/Types.h"
+#include "pe/contact/ContactHistory.h"
 
 #include "domain_decomposition/BlockStorage.h"
 
@@ -62,6 +63,10 @@ public:
    virtual inline real_t            getMaximumPenetration()        const WALBERLA_OVERRIDE { return maxPenetration_; }
    virtual inline size_t            getNumberOfContacts()          const WALBERLA_OVERRIDE { return numberOfContacts_; }
    virtual inline size_t            getNumberOfContactsTreated()   const WALBERLA_OVERRIDE { return numberOfContactsTreated_; }
+
+   /// Data of the contacts of the last time step that is kept by the contact resolver (e.g. the
+   /// tangential displacement of ResolveContactSpringDashpotCundallStrack).
+   inline const ContactHistory<Vec3>& getContactHistory() const { return contactHistory_; }
 private:
    const Integrator                  integrate_;
    const ContactResolver             resolveContact_;
@@ -72,6 +77,8 @@ private:
    domain_decomposition::BlockDataID fcdID_;
    WcTimingTree*                     tt_;
 
+   ContactHistory<Vec3>              contactHistory_;
+
    real_t                            maxPenetration_;
    size_t                            numberOfContacts_;
    size_t                            numberOfContactsTreated_;
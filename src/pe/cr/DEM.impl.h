@@ -88,7 +88,8 @@ void DEMSolver<Integrator,ContactResolver>::timestep( real_t dt )
          if (shouldContactBeTreated( &(*cIt), currentBlock.getAABB() ))
          {
             ++numberOfContactsTreated_;
-            resolveContact_( &(*cIt) );
+            internal::resolveContact( resolveContact_, &(*cIt), dt, contactHistory_,
+                                      typename internal::ContactResolverSignature< ContactResolver >::type() );
          }
       }
 
@@ -97,6 +98,9 @@ void DEMSolver<Integrator,ContactResolver>::timestep( real_t dt )
       cont.clear();
    }
 
+   // forget the contacts that were broken up
+   contactHistory_.finishTimestep();
+
 //   if (numContacts > 0)
 //      WALBERLA_LOG_DEVEL_ON_ROOT("#Contacts: " << numContacts << "." );
 
@@ -29,6 +29,7 @@
 #include "pe/cr/ICR.h"
 #include "pe/communication/PackNotification.h"
 #include "pe/communication/RigidBodyVelocityCorrectionNotification.h"
+#include "pe/contact/ContactHistory.h"
 #include "pe/rigidbody/RigidBody.h"
 #include "pe/Types.h"
 
@@ -94,6 +95,9 @@ private:
       std::vector<Mat2>   diag_to_inv_;
       std::vector<real_t> diag_n_inv_;
       std::vector<Vec3>   p_;
+      std::vector<Vec3*>  pHistory_;    //!< Entries of the contacts in the impulse history (only used for warm starting).
+      std::vector<size_t> colorOrder_;  //!< Contact indices sorted by color.
+      std::vector<size_t> colorStart_;  //!< Start of each color in colorOrder_ (plus one past the end entry).
    };
    std::map<IBlockID::IDType, ContactCache> blockToContactCache_;
 
@@ -108,6 +112,19 @@ public:
       InelasticGeneralizedMaximumDissipationContact
    };
    //**********************************************************************************************
+   //**Definition of relaxation schedules **********************************************************
+   /*!\brief Order in which the contacts of a block are relaxed within one iteration.
+    *
+    * SequentialGaussSeidel relaxes the contacts one after another in the order of detection.
+    * ColoredGaussSeidel partitions the contacts of each block into colors such that no two
+    * contacts of the same color act on the same body with finite mass. The colors are processed
+    * one after another, the contacts within a color are relaxed concurrently by OpenMP threads.
+    */
+   enum RelaxationSchedule {
+      SequentialGaussSeidel,
+      ColoredGaussSeidel
+   };
+   //**********************************************************************************************
 public:
    //**Constructor*********************************************************************************
    /*!\name Constructor */
@@ -139,6 +156,8 @@ public:
    inline real_t                    getRelaxationParameter() const { return relaxationParam_; }
    inline real_t                    getErrorReductionParameter() const { return erp_; }
    inline RelaxationModel           getRelaxationModel() const { return relaxationModel_; }
+   inline RelaxationSchedule        getRelaxationSchedule() const { return relaxationSchedule_; }
+   inline const ContactHistory<Vec3>& getImpulseHistory() const { return impulseHistory_; }
    //@}
    //**********************************************************************************************
 
@@ -148,9 +167,11 @@ public:
    inline void            setRelaxationParameter( real_t f );
    inline void            setMaxIterations( size_t n );
    inline void            setRelaxationModel( RelaxationModel relaxationModel );
+   inline void            setRelaxationSchedule( RelaxationSchedule relaxationSchedule );
    inline void            setErrorReductionParameter( real_t erp );
    inline void            setAbortThreshold( real_t threshold );
    inline void            setSpeedLimiter( bool active, const real_t speedLimitFactor = real_t(0.0) );
+   inline void            setWarmStarting( bool active );
    //@}
    //**********************************************************************************************
 
@@ -160,6 +181,7 @@ public:
    inline bool            isSyncRequired()        const;
    inline bool            isSyncRequiredLocally() const;
    inline bool            isSpeedLimiterActive() const;
+   inline bool            isWarmStartingActive() const;
    //@}
    //**********************************************************************************************
 
@@ -175,6 +197,25 @@ private:
    /*!\name Simulation functions */
    //@{
    void resolveContacts( const Contacts& contacts, real_t dt );
+   void colorContacts( HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache, size_t numBodies ) const;
+   template< real_t (HardContactSemiImplicitTimesteppingSolvers::*relaxContact)( size_t, real_t,
+                                                                                HardContactSemiImplicitTimesteppingSolvers::ContactCache&,
+                                                                                HardContactSemiImplicitTimesteppingSolvers::BodyCache& ) >
+   real_t relaxContacts( real_t dtinv,
+                         HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                         HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
+   real_t relaxInelasticFrictionlessContact( size_t i, real_t dtinv,
+                                             HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                             HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
+   real_t relaxApproximateInelasticCoulombContactByDecoupling( size_t i, real_t dtinv,
+                                                               HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                               HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
+   real_t relaxInelasticCoulombContactByDecoupling( size_t i, real_t dtinv,
+                                                    HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                    HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
+   real_t relaxInelasticGeneralizedMaximumDissipationContact( size_t i, real_t dtinv,
+                                                              HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                              HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
    real_t relaxInelasticFrictionlessContacts( real_t dtinv,
                                               HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
                                               HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache );
@@ -208,6 +249,7 @@ private:
    //@{
    void initializeVelocityCorrections( BodyID body, Vec3& dv, Vec3& dw, real_t dt ) const;
    void integratePositions( BodyID body, Vec3 v, Vec3 w, real_t dt ) const;
+   inline void addImpulse( BodyCache& bodyCache, BodyID body, const Vec3& r, const Vec3& p ) const;
    //@}
    //**********************************************************************************************
 
@@ -237,6 +279,7 @@ private:
    size_t maxSubIterations_;          //!< Maximum number of iterations of iterative solvers in the one-contact problem.
    real_t abortThreshold_;            //!< If L-infinity iterate difference drops below this threshold the iteration is aborted.
    RelaxationModel relaxationModel_;  //!< The method used to relax unilateral contacts
+   RelaxationSchedule relaxationSchedule_;  //!< The order in which the contacts are relaxed
    real_t relaxationParam_;           //!< Parameter specifying underrelaxation of velocity corrections for boundary bodies.
    real_t maximumPenetration_;
    size_t numContacts_;
@@ -245,6 +288,9 @@ private:
    bool   speedLimiterActive_;        //!< is the speed limiter active?
    real_t speedLimitFactor_;          //!< what multiple of boundingbox edge length is the body allowed to travel in one timestep
 
+   bool                 warmStarting_;    //!< are the contact impulses initialized with the ones of the previous time step?
+   ContactHistory<Vec3> impulseHistory_;  //!< contact impulses of the previous time step (warm starting)
+
    //**********************************************************************************************
    /*! \cond WALBERLA_INTERNAL */
    /*!\brief Functor for comparing the system ID of two bodies.
@@ -371,6 +417,24 @@ inline void HardContactSemiImplicitTimesteppingSolvers::setRelaxationModel( Rela
 //*************************************************************************************************
 
 
+
+//*************************************************************************************************
+/*!\brief Sets the relaxation schedule used by the iterative solver.
+ *
+ * \param relaxationSchedule The order in which the contacts are relaxed.
+ * \return void
+ *
+ * With ColoredGaussSeidel the contacts of a block are relaxed concurrently if waLBerla is built
+ * with OpenMP. The result then depends on the coloring and differs from the sequential schedule
+ * (although it is deterministic for a given set of contacts).
+ */
+inline void HardContactSemiImplicitTimesteppingSolvers::setRelaxationSchedule( RelaxationSchedule relaxationSchedule )
+{
+   relaxationSchedule_ = relaxationSchedule;
+}
+//*************************************************************************************************
+
+
 //*************************************************************************************************
 /*!\brief Sets the error reduction parameter.
  *
@@ -423,6 +487,25 @@ inline void HardContactSemiImplicitTimesteppingSolvers::setSpeedLimiter( bool ac
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Activates/Deactivates warm starting of the contact impulses
+*
+* \param active activate/deactivate warm starting
+* \return void
+*
+* With warm starting, the impulses of contacts which already existed in the previous time step
+* (identified by the system IDs of the bodies, see ContactHistory) are initialized with their final
+* values of the previous time step instead of zero. For quasi-static packings this reduces the
+* number of iterations needed considerably.
+*/
+inline void HardContactSemiImplicitTimesteppingSolvers::setWarmStarting( bool active )
+{
+   warmStarting_ = active;
+   impulseHistory_.clear();
+}
+//*************************************************************************************************
+
+
 
 
 //=================================================================================================
@@ -500,6 +583,18 @@ inline bool HardContactSemiImplicitTimesteppingSolvers::isSpeedLimiterActive() c
 //*************************************************************************************************
 
 
+//*************************************************************************************************
+/*!\brief Returns if the contact impulses are warm started.
+ *
+ * \return status of warm starting
+ */
+inline bool HardContactSemiImplicitTimesteppingSolvers::isWarmStartingActive() const
+{
+   return warmStarting_;
+}
+//*************************************************************************************************
+
+
 } // namespace cr
 } // namespace pe
 
@@ -37,6 +37,7 @@
 #include "core/math/Utility.h"
 
 #include "core/ConcatIterator.h"
+#include "core/OpenMP.h"
 
 
 namespace walberla {
@@ -67,6 +68,7 @@ inline void HardContactSemiImplicitTimesteppingSolvers::ContactCache::resize(con
    diag_to_inv_.resize(n);
    diag_n_inv_.resize(n);
    p_.resize(n);
+   pHistory_.resize(n);
 }
 
 //=================================================================================================
@@ -98,12 +100,14 @@ inline HardContactSemiImplicitTimesteppingSolvers::HardContactSemiImplicitTimest
    , maxSubIterations_ ( 20 )
    , abortThreshold_   ( real_c(1e-7) )
    , relaxationModel_  ( InelasticFrictionlessContact )
+   , relaxationSchedule_( SequentialGaussSeidel )
    , relaxationParam_  ( real_c(0.75) )
    , maximumPenetration_ ( real_c(0.0) )
    , numContacts_      ( 0 )
    , numContactsTreated_( 0)
    , speedLimiterActive_( false )
    , speedLimitFactor_ ( real_c(1.0) )
+   , warmStarting_     ( false )
    , requireSync_      ( false )
 {
    // Logging the successful setup of the collision system
@@ -271,7 +275,16 @@ inline void HardContactSemiImplicitTimesteppingSolvers::timestep( const real_t d
             contactCache.diag_nto_inv_[j]  = diag.getInverse();
             contactCache.diag_n_inv_[j]    = math::inv(diag[0]);
             contactCache.diag_to_inv_[j]   = Mat2( diag[4], diag[5], diag[7], diag[8] ).getInverse();
-            contactCache.p_[j] = Vec3();
+            if( warmStarting_ )
+            {
+               Vec3& p = impulseHistory_.value( b1->getSystemID(), b2->getSystemID() );
+               contactCache.pHistory_[j] = &p;
+               contactCache.p_[j]        = ContactHistory<Vec3>::orientation( b1->getSystemID(), b2->getSystemID() ) / relaxationParam_ * p;
+            }
+            else
+            {
+               contactCache.p_[j] = Vec3();
+            }
 
             ++j;
          }
@@ -331,7 +344,24 @@ inline void HardContactSemiImplicitTimesteppingSolvers::timestep( const real_t d
 #endif
       }
 
+      if( warmStarting_ )
+      {
+         // Apply the impulses of the previous time step, they are synchronized together with the external forces.
+         // Only the fraction relaxationParam_ of the changes of p_ is applied to the velocities, hence the
+         // history stores the applied impulse relaxationParam_ * p_.
+         for( size_t i = 0; i < contactCache.p_.size(); ++i )
+         {
+            addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i],  relaxationParam_ * contactCache.p_[i] );
+            addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i], -relaxationParam_ * contactCache.p_[i] );
+         }
+      }
+
       if (tt_ != NULL) tt_->stop("Collision Response Body Caching");
+      if (tt_ != NULL) tt_->start("Collision Response Contact Coloring");
+
+      colorContacts( contactCache, numBodies );
+
+      if (tt_ != NULL) tt_->stop("Collision Response Contact Coloring");
    }
 
    if (tt_ != NULL) tt_->start("Collision Response Resolution");
@@ -415,6 +445,19 @@ inline void HardContactSemiImplicitTimesteppingSolvers::timestep( const real_t d
 #endif
    }
 
+   if( warmStarting_ )
+   {
+      for (auto blkIt = blockStorage_->begin(); blkIt != blockStorage_->end(); ++blkIt)
+      {
+         ContactCache& contactCache = blockToContactCache_[blkIt->getId().getID()];
+         for( size_t i = 0; i < contactCache.p_.size(); ++i )
+         {
+            *contactCache.pHistory_[i] = ContactHistory<Vec3>::orientation( contactCache.body1_[i]->getSystemID(), contactCache.body2_[i]->getSystemID() ) * relaxationParam_ * contactCache.p_[i];
+         }
+      }
+      impulseHistory_.finishTimestep();
+   }
+
    if (tt_ != NULL) tt_->stop("Collision Response Resolution");
    if (tt_ != NULL) tt_->start("Collision Response Integration");
 
@@ -491,66 +534,137 @@ inline void HardContactSemiImplicitTimesteppingSolvers::timestep( const real_t d
 
 
 //*************************************************************************************************
-/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts without friction.
+/*!\brief Partitions the contacts of a block into colors for the relaxation.
  *
- * \return The largest variation of contact impulses in the L-infinity norm.
+ * \param contactCache The contacts of the block.
+ * \param numBodies The number of cached bodies of the block.
+ * \return void
  *
- * This function is to be called from resolveContacts(). Separating contacts are preferred over
- * persisting solutions if valid.
+ * For the ColoredGaussSeidel schedule each contact gets the smallest color which is not yet used
+ * by a previous contact acting on one of its bodies (greedy coloring of the contact graph). Bodies
+ * with infinite mass do not receive velocity corrections and therefore do not connect contacts.
+ * The contact indices are stored sorted by color in ContactCache::colorOrder_. For the
+ * SequentialGaussSeidel schedule all contacts get the same color and keep their order.
  */
-inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticFrictionlessContacts( real_t dtinv,
-                                                                                              HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
-                                                                                              HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+inline void HardContactSemiImplicitTimesteppingSolvers::colorContacts( HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache, size_t numBodies ) const
 {
-   real_t delta_max( 0 );
-   size_t numContactsMasked( contactCache.p_.size() );
+   const size_t numContacts( contactCache.p_.size() );
 
-   // Relax contacts
-   for( size_t i = 0; i < numContactsMasked; ++i )
+   contactCache.colorOrder_.resize( numContacts );
+   for( size_t i = 0; i < numContacts; ++i )
+      contactCache.colorOrder_[i] = i;
+
+   if( relaxationSchedule_ == SequentialGaussSeidel || numContacts == 0 )
    {
-      // Remove velocity corrections of this contact's reaction.
-      bodyCache.dv_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-      bodyCache.dv_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
+      contactCache.colorStart_.resize( 2 );
+      contactCache.colorStart_[0] = 0;
+      contactCache.colorStart_[1] = numContacts;
+      return;
+   }
 
-      // Calculate the relative contact VELOCITY in the global world frame (if no contact reaction is present at contact i)
-      Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
-            ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
-            ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
-            ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   // contacts attached to each body with finite mass (compressed row storage)
+   std::vector<size_t> bodyStart( numBodies + 1, 0 );
+   for( size_t i = 0; i < numContacts; ++i )
+   {
+      if( !contactCache.body1_[i]->hasInfiniteMass() ) ++bodyStart[contactCache.body1_[i]->index_ + 1];
+      if( !contactCache.body2_[i]->hasInfiniteMass() ) ++bodyStart[contactCache.body2_[i]->index_ + 1];
+   }
+   for( size_t j = 0; j < numBodies; ++j )
+      bodyStart[j + 1] += bodyStart[j];
 
-      // Change from the global world frame to the contact frame
-      Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
-      Vec3 gdot_nto( contactframe.getTranspose() * gdot );
+   std::vector<size_t> bodyContacts( bodyStart[numBodies] );
+   std::vector<size_t> fill( bodyStart.begin(), bodyStart.end() - 1 );
+   for( size_t i = 0; i < numContacts; ++i )
+   {
+      if( !contactCache.body1_[i]->hasInfiniteMass() ) bodyContacts[fill[contactCache.body1_[i]->index_]++] = i;
+      if( !contactCache.body2_[i]->hasInfiniteMass() ) bodyContacts[fill[contactCache.body2_[i]->index_]++] = i;
+   }
 
-      // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
-      gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+   // greedy coloring, forbidden[c] == i marks color c as used by a neighbor of contact i
+   const size_t uncolored( std::numeric_limits<size_t>::max() );
+   std::vector<size_t> color( numContacts, uncolored );
+   std::vector<size_t> forbidden;
+   size_t numColors( 0 );
+   for( size_t i = 0; i < numContacts; ++i )
+   {
+      const BodyID bodies[2] = { contactCache.body1_[i], contactCache.body2_[i] };
+      for( size_t b = 0; b < 2; ++b )
+      {
+         if( bodies[b]->hasInfiniteMass() )
+            continue;
+         for( size_t k = bodyStart[bodies[b]->index_]; k < bodyStart[bodies[b]->index_ + 1]; ++k )
+         {
+            const size_t neighbor( bodyContacts[k] );
+            if( color[neighbor] != uncolored )
+               forbidden[color[neighbor]] = i;
+         }
+      }
 
-      if( gdot_nto[0] >= 0 ) {
-         // Contact is separating if no contact reaction is present at contact i.
+      size_t c( 0 );
+      while( c < numColors && forbidden[c] == i )
+         ++c;
+      if( c == numColors )
+      {
+         ++numColors;
+         forbidden.push_back( uncolored );
+      }
+      color[i] = c;
+   }
 
-         delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
-         contactCache.p_[i] = Vec3();
+   // counting sort of the contacts by color
+   contactCache.colorStart_.assign( numColors + 1, 0 );
+   for( size_t i = 0; i < numContacts; ++i )
+      ++contactCache.colorStart_[color[i] + 1];
+   for( size_t c = 0; c < numColors; ++c )
+      contactCache.colorStart_[c + 1] += contactCache.colorStart_[c];
 
-         // No need to apply zero impulse.
-      }
-      else {
-         // Contact is persisting.
+   fill.assign( contactCache.colorStart_.begin(), contactCache.colorStart_.end() - 1 );
+   for( size_t i = 0; i < numContacts; ++i )
+      contactCache.colorOrder_[fill[color[i]]++] = i;
+}
+//*************************************************************************************************
 
-         // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
-         Vec3 p_wf( contactCache.n_[i] * ( -contactCache.diag_n_inv_[i] * gdot_nto[0] ) );
-         Vec3 dp( contactCache.p_[i] - p_wf );
-         delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
 
-         contactCache.p_[i] = p_wf;
+//*************************************************************************************************
+/*!\brief Relaxes all contacts of a block once with the given single contact relaxation.
+ *
+ * \return The largest variation of contact impulses in the L-infinity norm.
+ *
+ * The colors are relaxed one after another. The contacts of one color do not share bodies with
+ * finite mass and are relaxed in parallel if the ColoredGaussSeidel schedule is selected.
+ */
+template< real_t (HardContactSemiImplicitTimesteppingSolvers::*relaxContact)( size_t, real_t,
+                                                                             HardContactSemiImplicitTimesteppingSolvers::ContactCache&,
+                                                                             HardContactSemiImplicitTimesteppingSolvers::BodyCache& ) >
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxContacts( real_t dtinv,
+                                                                         HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                         HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   real_t delta_max( 0 );
+   const size_t numColors( contactCache.colorStart_.size() - 1 );
+
+#ifdef _OPENMP
+   #pragma omp parallel if( relaxationSchedule_ == ColoredGaussSeidel )
+#endif
+   {
+      real_t thread_delta_max( 0 );
+
+      for( size_t c = 0; c < numColors; ++c )
+      {
+         const int begin( int_c( contactCache.colorStart_[c]     ) );
+         const int end  ( int_c( contactCache.colorStart_[c + 1] ) );
 
-         // Apply impulse right away.
-         bodyCache.dv_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-         bodyCache.dv_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
+#ifdef _OPENMP
+         #pragma omp for schedule(static)
+#endif
+         for( int k = begin; k < end; ++k )
+            thread_delta_max = std::max( thread_delta_max, (this->*relaxContact)( contactCache.colorOrder_[uint_c(k)], dtinv, contactCache, bodyCache ) );
       }
+
+#ifdef _OPENMP
+      #pragma omp critical (HCSITS_relaxContacts)
+#endif
+      delta_max = std::max( delta_max, thread_delta_max );
    }
 
    return delta_max;
@@ -559,176 +673,282 @@ inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticFriction
 
 
 //*************************************************************************************************
-/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with approximate Coulomb friction.
+/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts without friction.
  *
  * \return The largest variation of contact impulses in the L-infinity norm.
+ */
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticFrictionlessContacts( real_t dtinv,
+                                                                                              HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                              HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   return relaxContacts< &HardContactSemiImplicitTimesteppingSolvers::relaxInelasticFrictionlessContact >( dtinv, contactCache, bodyCache );
+}
+//*************************************************************************************************
+
+
+//*************************************************************************************************
+/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with approximate Coulomb friction.
  *
- * This function is to be called from resolveContacts(). Separating contacts are preferred over
- * other solutions if valid. Static solutions are preferred over dynamic solutions. Dynamic
- * solutions are computed by decoupling the normal from the frictional components. That is
- * for a dynamic contact the normal component is relaxed first followed by the frictional
- * components. The determination of the frictional components does not perform any subiterations
- * and guarantees that the friction partially opposes slip.
+ * \return The largest variation of contact impulses in the L-infinity norm.
  */
 inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxApproximateInelasticCoulombContactsByDecoupling( real_t dtinv,
                                                                                                                 HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
                                                                                                                 HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
 {
-   real_t delta_max( 0 );
-   size_t numContactsMasked( contactCache.p_.size() );
+   return relaxContacts< &HardContactSemiImplicitTimesteppingSolvers::relaxApproximateInelasticCoulombContactByDecoupling >( dtinv, contactCache, bodyCache );
+}
+//*************************************************************************************************
 
-   // Relax contacts
-   for( size_t i = 0; i < numContactsMasked; ++i ) {
-      // Remove velocity corrections of this contact's reaction.
-      bodyCache.dv_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-      bodyCache.dv_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
 
-      // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
-      Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+//*************************************************************************************************
+/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with Coulomb friction.
+ *
+ * \return The largest variation of contact impulses in the L-infinity norm.
+ */
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombContactsByDecoupling( real_t dtinv,
+                                                                                                     HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                                     HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   return relaxContacts< &HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombContactByDecoupling >( dtinv, contactCache, bodyCache );
+}
+//*************************************************************************************************
 
-      // Change from the global world frame to the contact frame
-      Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
-      Vec3 gdot_nto( contactframe.getTranspose() * gdot );
 
-      //real_t gdot_n  ( trans( contactCache.n_[i] ) * gdot );  // The component of gdot along the contact normal n
-      //Vec3 gdot_t  ( gdot - gdot_n * contactCache.n_[i] );  // The components of gdot tangential to the contact normal n
-      //real_t g_n     ( gdot_n * dt /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] );  // The gap in normal direction
+//*************************************************************************************************
+/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with the generalized maximum dissipation friction law.
+ *
+ * \return The largest variation of contact impulses in the L-infinity norm.
+ */
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticGeneralizedMaximumDissipationContacts( real_t dtinv,
+                                                                                                               HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                                               HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   return relaxContacts< &HardContactSemiImplicitTimesteppingSolvers::relaxInelasticGeneralizedMaximumDissipationContact >( dtinv, contactCache, bodyCache );
+}
+//*************************************************************************************************
 
-      // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
-      gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
 
-      if( gdot_nto[0] >= 0 ) {
-         // Contact is separating if no contact reaction is present at contact i.
+//*************************************************************************************************
+/*!\brief Relaxes contact \a i once. The contact model is for inelastic unilateral contacts without friction.
+ *
+ * \return The largest variation of contact impulses in the L-infinity norm.
+ *
+ * This function is to be called from resolveContacts(). Separating contacts are preferred over
+ * persisting solutions if valid.
+ */
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticFrictionlessContact( size_t i, real_t dtinv,
+                                                                                             HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                             HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   real_t delta_max( 0 );
 
-         delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
-         contactCache.p_[i] = Vec3();
+   // Remove velocity corrections of this contact's reaction.
+   addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i], -contactCache.p_[i] );
+   addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i],  contactCache.p_[i] );
 
-         // No need to apply zero impulse.
-      }
-      else {
-         // Contact is persisting (either static or dynamic).
+   // Calculate the relative contact VELOCITY in the global world frame (if no contact reaction is present at contact i)
+   Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
+         ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
+         ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
+         ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
 
-         // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
-         Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
+   // Change from the global world frame to the contact frame
+   Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
+   Vec3 gdot_nto( contactframe.getTranspose() * gdot );
 
-         // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
-         // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
-         // b = [0.01 -1 -1]';
-         // A\b    \approx [-0.19 -2.28 -1.21]'
-         // eig(A) \approx [ 0.40  0.56  1.04]'
+   // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
+   gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
 
-         real_t flimit( contactCache.mu_[i] * p_cf[0] );
-         real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
-         if( fsq > flimit * flimit || p_cf[0] < 0 ) {
-            // Contact cannot be static so it must be dynamic.
-            // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
+   if( gdot_nto[0] >= 0 ) {
+      // Contact is separating if no contact reaction is present at contact i.
 
-            // For simplicity we change to a simpler relaxation scheme here:
-            // 1. Relax normal reaction with the tangential components equal to the previous values
-            // 2. Relax tangential components with the newly relaxed normal reaction
-            // Note: The better approach would be to solve the true 3x3 block problem!
-            // Warning: Simply projecting the frictional components is wrong since then the normal action is no longer 0 and simulations break.
+      delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
+      contactCache.p_[i] = Vec3();
 
-            // Add the action of the frictional reactions from the last iteration to the relative contact velocity in normal direction so we can relax it separately.
-            // TODO This can be simplified:
-            //p_cf = trans( contactframe ) * contactCache.p_[i];
-            //p_cf[0] = 0;
-            //p_[i] = contactframe * p_cf;
-            Vec3 p_tmp = ( contactCache.t_[i] * contactCache.p_[i] ) * contactCache.t_[i] + ( contactCache.o_[i] * contactCache.p_[i] ) * contactCache.o_[i];
+      // No need to apply zero impulse.
+   }
+   else {
+      // Contact is persisting.
 
-            //      |<-- This should vanish below since p_cf[0] = 0          -->|
-            //gdot += ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_tmp + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp] ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i] /* + diag_[i] * p */;
-            //real_t gdot_n = trans( contactCache.n_[i] ) * gdot;
-            //gdot_n += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+      // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
+      Vec3 p_wf( contactCache.n_[i] * ( -contactCache.diag_n_inv_[i] * gdot_nto[0] ) );
+      Vec3 dp( contactCache.p_[i] - p_wf );
+      delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
 
-            real_t gdot_n = gdot_nto[0] + contactCache.n_[i] * ( ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i] /* + diag_[i] * p */ );
-            p_cf[0] = -( contactCache.diag_n_inv_[i] * gdot_n );
+      contactCache.p_[i] = p_wf;
 
-            // We cannot be sure that gdot_n <= 0 here and thus p_cf[0] >= 0 since we just modified it with the old values of the tangential reactions! => Project
-            p_cf[0] = std::max( real_c( 0 ), p_cf[0] );
+      // Apply impulse right away.
+      addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i],  contactCache.p_[i] );
+      addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i], -contactCache.p_[i] );
+   }
 
-            // Now add the action of the normal reaction to the relative contact velocity in the tangential directions so we can relax the frictional components separately.
-            p_tmp = contactCache.n_[i] * p_cf[0];
-            Vec3 gdot2 = gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i];
-            Vec2 gdot_to;
-            gdot_to[0] = contactCache.t_[i] * gdot2;
-            gdot_to[1] = contactCache.o_[i] * gdot2;
+   return delta_max;
+}
+//*************************************************************************************************
 
-            Vec2 ret = -( contactCache.diag_to_inv_[i] * gdot_to );
-            p_cf[1] = ret[0];
-            p_cf[2] = ret[1];
 
-            flimit = contactCache.mu_[i] * p_cf[0];
-            fsq = p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2];
-            if( fsq > flimit * flimit ) {
-               const real_t f( flimit / std::sqrt( fsq ) );
-               p_cf[1] *= f;
-               p_cf[2] *= f;
-            }
-         }
-         else {
-            // Contact is static.
-         }
-         Vec3 p_wf( contactframe * p_cf );
-         Vec3 dp( contactCache.p_[i] - p_wf );
-         delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
+//*************************************************************************************************
+/*!\brief Relaxes contact \a i once. The contact model is for inelastic unilateral contacts with approximate Coulomb friction.
+ *
+ * \return The largest variation of contact impulses in the L-infinity norm.
+ *
+ * This function is to be called from resolveContacts(). Separating contacts are preferred over
+ * other solutions if valid. Static solutions are preferred over dynamic solutions. Dynamic
+ * solutions are computed by decoupling the normal from the frictional components. That is
+ * for a dynamic contact the normal component is relaxed first followed by the frictional
+ * components. The determination of the frictional components does not perform any subiterations
+ * and guarantees that the friction partially opposes slip.
+ */
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxApproximateInelasticCoulombContactByDecoupling( size_t i, real_t dtinv,
+                                                                                                               HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                                               HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+{
+   real_t delta_max( 0 );
 
-         contactCache.p_[i] = p_wf;
+   // Remove velocity corrections of this contact's reaction.
+   addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i], -contactCache.p_[i] );
+   addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i],  contactCache.p_[i] );
 
-         // Apply impulse right away
-         bodyCache.dv_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-         bodyCache.dv_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
-      }
+   // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
+   Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
 
-#if 0
-      Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
-            ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
-            ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
-            ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_contactCache.[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
-      Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
-      WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
-      WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
-      WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
-      gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
-      WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] );
-#endif
+   // Change from the global world frame to the contact frame
+   Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
+   Vec3 gdot_nto( contactframe.getTranspose() * gdot );
+
+   //real_t gdot_n  ( trans( contactCache.n_[i] ) * gdot );  // The component of gdot along the contact normal n
+   //Vec3 gdot_t  ( gdot - gdot_n * contactCache.n_[i] );  // The components of gdot tangential to the contact normal n
+   //real_t g_n     ( gdot_n * dt /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] );  // The gap in normal direction
 
-      /*
-       * compare DEM time-step with NSCD iteration:
-       * - projections are the same
-       * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
-       *
-      f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
-      f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
-      f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
+   // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
+   gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
 
-      or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
-      vs. f_cf = -diaginv * gdot_nto in NSCD iteration
+   if( gdot_nto[0] >= 0 ) {
+      // Contact is separating if no contact reaction is present at contact i.
+
+      delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
+      contactCache.p_[i] = Vec3();
+
+      // No need to apply zero impulse.
+   }
+   else {
+      // Contact is persisting (either static or dynamic).
 
-      => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
+      // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
+      Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
 
-      f_cf[0] = std::max( 0, f_cf[0] );
+      // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
+      // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
+      // b = [0.01 -1 -1]';
+      // A\b    \approx [-0.19 -2.28 -1.21]'
+      // eig(A) \approx [ 0.40  0.56  1.04]'
 
-      flimit = contactCache.mu_ * f_cf[0];
-      fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
-      if( fsq > flimit * flimit ) {
-         f = flimit / sqrt( fsq );
-         f_cf[1] *= f;
-         f_cf[2] *= f;
+      real_t flimit( contactCache.mu_[i] * p_cf[0] );
+      real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
+      if( fsq > flimit * flimit || p_cf[0] < 0 ) {
+         // Contact cannot be static so it must be dynamic.
+         // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
+
+         // For simplicity we change to a simpler relaxation scheme here:
+         // 1. Relax normal reaction with the tangential components equal to the previous values
+         // 2. Relax tangential components with the newly relaxed normal reaction
+         // Note: The better approach would be to solve the true 3x3 block problem!
+         // Warning: Simply projecting the frictional components is wrong since then the normal action is no longer 0 and simulations break.
+
+         // Add the action of the frictional reactions from the last iteration to the relative contact velocity in normal direction so we can relax it separately.
+         // TODO This can be simplified:
+         //p_cf = trans( contactframe ) * contactCache.p_[i];
+         //p_cf[0] = 0;
+         //p_[i] = contactframe * p_cf;
+         Vec3 p_tmp = ( contactCache.t_[i] * contactCache.p_[i] ) * contactCache.t_[i] + ( contactCache.o_[i] * contactCache.p_[i] ) * contactCache.o_[i];
+
+         //      |<-- This should vanish below since p_cf[0] = 0          -->|
+         //gdot += ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_tmp + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp] ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i] /* + diag_[i] * p */;
+         //real_t gdot_n = trans( contactCache.n_[i] ) * gdot;
+         //gdot_n += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+
+         real_t gdot_n = gdot_nto[0] + contactCache.n_[i] * ( ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+         p_cf[0] = -( contactCache.diag_n_inv_[i] * gdot_n );
+
+         // We cannot be sure that gdot_n <= 0 here and thus p_cf[0] >= 0 since we just modified it with the old values of the tangential reactions! => Project
+         p_cf[0] = std::max( real_c( 0 ), p_cf[0] );
+
+         // Now add the action of the normal reaction to the relative contact velocity in the tangential directions so we can relax the frictional components separately.
+         p_tmp = contactCache.n_[i] * p_cf[0];
+         Vec3 gdot2 = gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % p_tmp ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % p_tmp ) ) % contactCache.r2_[i];
+         Vec2 gdot_to;
+         gdot_to[0] = contactCache.t_[i] * gdot2;
+         gdot_to[1] = contactCache.o_[i] * gdot2;
+
+         Vec2 ret = -( contactCache.diag_to_inv_[i] * gdot_to );
+         p_cf[1] = ret[0];
+         p_cf[2] = ret[1];
+
+         flimit = contactCache.mu_[i] * p_cf[0];
+         fsq = p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2];
+         if( fsq > flimit * flimit ) {
+            const real_t f( flimit / std::sqrt( fsq ) );
+            p_cf[1] *= f;
+            p_cf[2] *= f;
+         }
+      }
+      else {
+         // Contact is static.
       }
+      Vec3 p_wf( contactframe * p_cf );
+      Vec3 dp( contactCache.p_[i] - p_wf );
+      delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
 
-      f_wf = contactframe * f_cf;
+      contactCache.p_[i] = p_wf;
 
-      b1->addForceAtPos(  f_wf, gpos );
-      b2->addForceAtPos( -f_wf, gpos );
-      */
+      // Apply impulse right away
+      addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i],  contactCache.p_[i] );
+      addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i], -contactCache.p_[i] );
+   }
 
+#if 0
+   Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
+         ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
+         ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
+         ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_contactCache.[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
+   WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
+   WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
+   WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
+   gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+   WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] );
+#endif
+
+   /*
+    * compare DEM time-step with NSCD iteration:
+    * - projections are the same
+    * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
+    *
+   f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
+   f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
+   f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
+
+   or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
+   vs. f_cf = -diaginv * gdot_nto in NSCD iteration
+
+   => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
+
+   f_cf[0] = std::max( 0, f_cf[0] );
+
+   flimit = contactCache.mu_ * f_cf[0];
+   fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
+   if( fsq > flimit * flimit ) {
+      f = flimit / sqrt( fsq );
+      f_cf[1] *= f;
+      f_cf[2] *= f;
    }
 
+   f_wf = contactframe * f_cf;
+
+   b1->addForceAtPos(  f_wf, gpos );
+   b2->addForceAtPos( -f_wf, gpos );
+   */
+
    return delta_max;
 }
 //*************************************************************************************************
@@ -736,7 +956,7 @@ inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxApproximateInelas
 
 //*************************************************************************************************
 
-/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with Coulomb friction.
+/*!\brief Relaxes contact \a i once. The contact model is for inelastic unilateral contacts with Coulomb friction.
  *
  * \return The largest variation of contact impulses in the L-infinity norm.
  *
@@ -748,240 +968,232 @@ inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxApproximateInelas
  * friction model depends on the number of subiterations performed. If no subiterations are
  * performed the friction is guaranteed to be at least partially dissipative.
  */
-inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombContactsByDecoupling( real_t dtinv,
-                                                                                                     HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
-                                                                                                     HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombContactByDecoupling( size_t i, real_t dtinv,
+                                                                                                    HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                                    HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
 {
    real_t delta_max( 0 );
-   size_t numContactsMasked( contactCache.p_.size() );
 
-   // Relax contacts
-   for( size_t i = 0; i < numContactsMasked; ++i ) {
-      // Remove velocity corrections of this contact's reaction.
-      bodyCache.dv_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-      bodyCache.dv_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
+   // Remove velocity corrections of this contact's reaction.
+   addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i], -contactCache.p_[i] );
+   addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i],  contactCache.p_[i] );
 
-      // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
-      Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
+   Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
 
-      // Change from the global world frame to the contact frame
-      Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
-      Vec3 gdot_nto( contactframe.getTranspose() * gdot );
+   // Change from the global world frame to the contact frame
+   Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
+   Vec3 gdot_nto( contactframe.getTranspose() * gdot );
 
-      //real_t gdot_n  ( trans( contactCache.n_[i] ) * gdot );  // The component of gdot along the contact normal n
-      //Vec3 gdot_t  ( gdot - gdot_n * contactCache.n_[i] );  // The components of gdot tangential to the contact normal n
-      //real_t g_n     ( gdot_n * dt /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] );  // The gap in normal direction
+   //real_t gdot_n  ( trans( contactCache.n_[i] ) * gdot );  // The component of gdot along the contact normal n
+   //Vec3 gdot_t  ( gdot - gdot_n * contactCache.n_[i] );  // The components of gdot tangential to the contact normal n
+   //real_t g_n     ( gdot_n * dt /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] );  // The gap in normal direction
 
-      // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
-      gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+   // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
+   gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
 
-      //WALBERLA_LOG_WARNING( "Contact #" << i << " is\nA = \n" << contactCache.diag_nto_[i] << "\nb = \n" << gdot_nto << "\nmu = " << contactCache.mu_[i] );
+   //WALBERLA_LOG_WARNING( "Contact #" << i << " is\nA = \n" << contactCache.diag_nto_[i] << "\nb = \n" << gdot_nto << "\nmu = " << contactCache.mu_[i] );
 
-      if( gdot_nto[0] >= 0 ) {
-         // Contact is separating if no contact reaction is present at contact i.
+   if( gdot_nto[0] >= 0 ) {
+      // Contact is separating if no contact reaction is present at contact i.
 
-         delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
-         contactCache.p_[i] = Vec3();
-         //WALBERLA_LOG_WARNING( "Contact #" << i << " is separating." );
+      delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
+      contactCache.p_[i] = Vec3();
+      //WALBERLA_LOG_WARNING( "Contact #" << i << " is separating." );
 
-         // No need to apply zero impulse.
-      }
-      else {
-         // Contact is persisting (either static or dynamic).
-
-         // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
-         Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
-
-         // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
-         // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
-         // b = [0.01 -1 -1]';
-         // A\b    \approx [-0.19 -2.28 -1.21]'
-         // eig(A) \approx [ 0.40  0.56  1.04]'
-
-         real_t flimit( contactCache.mu_[i] * p_cf[0] );
-         real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
-         if( fsq > flimit * flimit || p_cf[0] < 0 ) {
-            // Contact cannot be static so it must be dynamic.
-            // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
-
-            for (int j = 0; j < 20; ++j) {
-               // For simplicity we change to a simpler relaxation scheme here:
-               // 1. Relax normal reaction with the tangential components equal to the previous values
-               // 2. Relax tangential components with the newly relaxed normal reaction
-               // Note: The better approach would be to solve the true 3x3 block problem!
-               // Warning: Simply projecting the frictional components is wrong since then the normal action is no longer 0 and simulations break.
-
-               Vec3 gdotCorrected;
-               real_t gdotCorrected_n;
-               Vec2 gdotCorrected_to;
-
-               // Calculate the relative contact velocity in the global world frame (if no normal contact reaction is present at contact i)
-               p_cf[0] = 0;
-               //                       |<- p_cf is orthogonal to the normal and drops out in next line ->|
-               gdotCorrected   = /* ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_cf  */ gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % ( contactCache.t_[i] * p_cf[1] + contactCache.o_[i] * p_cf[2] ) ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % ( contactCache.t_[i] * p_cf[1] + contactCache.o_[i] * p_cf[2] ) ) ) % contactCache.r2_[i];
-               gdotCorrected_n = contactCache.n_[i] * gdotCorrected + contactCache.dist_[i] * dtinv;
-
-               // Relax normal component.
-               p_cf[0] = std::max( real_c( 0 ), -( contactCache.diag_n_inv_[i] * gdotCorrected_n ) );
-
-               // Calculate the relative contact velocity in the global world frame (if no frictional contact reaction is present at contact i)
-               p_cf[1] = p_cf[2] = real_c( 0 );
-               //                       |<- p_cf is orthogonal to the tangential plane and drops out   ->|
-               gdotCorrected   = /* ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_cf */ gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % ( contactCache.n_[i] * p_cf[0] ) ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % ( contactCache.n_[i] * p_cf[0] ) ) ) % contactCache.r2_[i];
-               gdotCorrected_to[0] = contactCache.t_[i] * gdotCorrected;
-               gdotCorrected_to[1] = contactCache.o_[i] * gdotCorrected;
-
-               // Relax frictional components.
-               Vec2 ret = -( contactCache.diag_to_inv_[i] * gdotCorrected_to );
-               p_cf[1] = ret[0];
-               p_cf[2] = ret[1];
-
-               flimit = contactCache.mu_[i] * p_cf[0];
-               fsq = p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2];
-               if( fsq > flimit * flimit ) {
-                  // 3.2.1 Decoupling
-                  // \tilde{x}^0 = p_cf[1..2]
-
-                  // Determine \tilde{A}
-                  Mat2 diag_to( contactCache.diag_nto_[i](1, 1), contactCache.diag_nto_[i](1, 2), contactCache.diag_nto_[i](2, 1), contactCache.diag_nto_[i](2, 2) );
-
-                        const real_t f( flimit / std::sqrt( fsq ) );
-                  //p_cf[1] *= f;
-                  //p_cf[2] *= f;
-
-                  // Determine search interval for Golden Section Search
-                  const real_t phi( real_c(0.5) * ( real_c(1) + std::sqrt( real_c( 5 ) ) ) );
-                  real_t shift( std::atan2( -p_cf[2], p_cf[1] ) );
-                  real_t acos_f( std::acos( f ) );
-
-                  //WALBERLA_LOG_WARNING( acos_f << " " << shift );
-
-                  real_t alpha_left( -acos_f - shift );
-                  //Vec2 x_left( flimit * std::cos( alpha_left ), flimit * std::sin( alpha_left ) );
-                  //real_t f_left( 0.5 * trans( x_left ) * ( diag_to * x_left ) - trans( x_left ) * ( -gdot_to ) );
-
-                  real_t alpha_right( acos_f - shift );
-                  //Vec2 x_right( flimit * std::cos( alpha_right ), flimit * std::sin( alpha_right ) );
-                  //real_t f_right( 0.5 * trans( x_right ) * ( diag_to * x_right ) - trans( x_right ) * ( -gdot_to ) );
-
-                  real_t alpha_mid( ( alpha_right + alpha_left * phi ) / ( 1 + phi ) );
-                  Vec2 x_mid( flimit * std::cos( alpha_mid ), flimit * std::sin( alpha_mid ) );
-                  real_t f_mid( real_c(0.5) * x_mid * ( diag_to * x_mid ) - x_mid * ( -gdotCorrected_to ) );
-
-                  bool leftlarger = false;
-                  for( size_t k = 0; k < maxSubIterations_; ++k ) {
-                     real_t alpha_next( alpha_left + ( alpha_right - alpha_mid ) );
-                     Vec2 x_next( flimit * std::cos( alpha_next ), flimit * std::sin( alpha_next ) );
-                     real_t f_next( real_c(0.5) * x_next * ( diag_to * x_next ) - x_next * ( -gdotCorrected_to ) );
-                     //WALBERLA_LOG_WARNING( "[(" << alpha_left << ", ?); (" << alpha_mid << ", " << f_mid << "); (" << alpha_right << ", ?)] <- (" << alpha_next << ", " << f_next << ")" );
-                     //WALBERLA_LOG_WARNING( "left: " << alpha_mid - alpha_left << "  right: " << alpha_right - alpha_mid << "  ll: " << leftlarger );
-                     //WALBERLA_ASSERT(leftlarger ? (alpha_mid - alpha_left > alpha_right - alpha_mid) : (alpha_mid - alpha_left < alpha_right - alpha_mid), "ll inconsistent!" );
-
-                     if (leftlarger) {
-                        // left interval larger
-                        if( f_next < f_mid ) {
-                           alpha_right = alpha_mid;
-                           alpha_mid   = alpha_next;
-                           x_mid       = x_next;
-                           f_mid       = f_next;
-                           leftlarger = true;
-                        }
-                        else {
-                           alpha_left  = alpha_next;
-                           leftlarger = false;
-                        }
+      // No need to apply zero impulse.
+   }
+   else {
+      // Contact is persisting (either static or dynamic).
+
+      // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
+      Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
+
+      // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
+      // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
+      // b = [0.01 -1 -1]';
+      // A\b    \approx [-0.19 -2.28 -1.21]'
+      // eig(A) \approx [ 0.40  0.56  1.04]'
+
+      real_t flimit( contactCache.mu_[i] * p_cf[0] );
+      real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
+      if( fsq > flimit * flimit || p_cf[0] < 0 ) {
+         // Contact cannot be static so it must be dynamic.
+         // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
+
+         for (int j = 0; j < 20; ++j) {
+            // For simplicity we change to a simpler relaxation scheme here:
+            // 1. Relax normal reaction with the tangential components equal to the previous values
+            // 2. Relax tangential components with the newly relaxed normal reaction
+            // Note: The better approach would be to solve the true 3x3 block problem!
+            // Warning: Simply projecting the frictional components is wrong since then the normal action is no longer 0 and simulations break.
+
+            Vec3 gdotCorrected;
+            real_t gdotCorrected_n;
+            Vec2 gdotCorrected_to;
+
+            // Calculate the relative contact velocity in the global world frame (if no normal contact reaction is present at contact i)
+            p_cf[0] = 0;
+            //                       |<- p_cf is orthogonal to the normal and drops out in next line ->|
+            gdotCorrected   = /* ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_cf  */ gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % ( contactCache.t_[i] * p_cf[1] + contactCache.o_[i] * p_cf[2] ) ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % ( contactCache.t_[i] * p_cf[1] + contactCache.o_[i] * p_cf[2] ) ) ) % contactCache.r2_[i];
+            gdotCorrected_n = contactCache.n_[i] * gdotCorrected + contactCache.dist_[i] * dtinv;
+
+            // Relax normal component.
+            p_cf[0] = std::max( real_c( 0 ), -( contactCache.diag_n_inv_[i] * gdotCorrected_n ) );
+
+            // Calculate the relative contact velocity in the global world frame (if no frictional contact reaction is present at contact i)
+            p_cf[1] = p_cf[2] = real_c( 0 );
+            //                       |<- p_cf is orthogonal to the tangential plane and drops out   ->|
+            gdotCorrected   = /* ( contactCache.body1_[i]->getInvMass() + contactCache.body2_[i]->getInvMass() ) * p_cf */ gdot + ( contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % ( contactCache.n_[i] * p_cf[0] ) ) ) % contactCache.r1_[i] + ( contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % ( contactCache.n_[i] * p_cf[0] ) ) ) % contactCache.r2_[i];
+            gdotCorrected_to[0] = contactCache.t_[i] * gdotCorrected;
+            gdotCorrected_to[1] = contactCache.o_[i] * gdotCorrected;
+
+            // Relax frictional components.
+            Vec2 ret = -( contactCache.diag_to_inv_[i] * gdotCorrected_to );
+            p_cf[1] = ret[0];
+            p_cf[2] = ret[1];
+
+            flimit = contactCache.mu_[i] * p_cf[0];
+            fsq = p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2];
+            if( fsq > flimit * flimit ) {
+               // 3.2.1 Decoupling
+               // \tilde{x}^0 = p_cf[1..2]
+
+               // Determine \tilde{A}
+               Mat2 diag_to( contactCache.diag_nto_[i](1, 1), contactCache.diag_nto_[i](1, 2), contactCache.diag_nto_[i](2, 1), contactCache.diag_nto_[i](2, 2) );
+
+                     const real_t f( flimit / std::sqrt( fsq ) );
+               //p_cf[1] *= f;
+               //p_cf[2] *= f;
+
+               // Determine search interval for Golden Section Search
+               const real_t phi( real_c(0.5) * ( real_c(1) + std::sqrt( real_c( 5 ) ) ) );
+               real_t shift( std::atan2( -p_cf[2], p_cf[1] ) );
+               real_t acos_f( std::acos( f ) );
+
+               //WALBERLA_LOG_WARNING( acos_f << " " << shift );
+
+               real_t alpha_left( -acos_f - shift );
+               //Vec2 x_left( flimit * std::cos( alpha_left ), flimit * std::sin( alpha_left ) );
+               //real_t f_left( 0.5 * trans( x_left ) * ( diag_to * x_left ) - trans( x_left ) * ( -gdot_to ) );
+
+               real_t alpha_right( acos_f - shift );
+               //Vec2 x_right( flimit * std::cos( alpha_right ), flimit * std::sin( alpha_right ) );
+               //real_t f_right( 0.5 * trans( x_right ) * ( diag_to * x_right ) - trans( x_right ) * ( -gdot_to ) );
+
+               real_t alpha_mid( ( alpha_right + alpha_left * phi ) / ( 1 + phi ) );
+               Vec2 x_mid( flimit * std::cos( alpha_mid ), flimit * std::sin( alpha_mid ) );
+               real_t f_mid( real_c(0.5) * x_mid * ( diag_to * x_mid ) - x_mid * ( -gdotCorrected_to ) );
+
+               bool leftlarger = false;
+               for( size_t k = 0; k < maxSubIterations_; ++k ) {
+                  real_t alpha_next( alpha_left + ( alpha_right - alpha_mid ) );
+                  Vec2 x_next( flimit * std::cos( alpha_next ), flimit * std::sin( alpha_next ) );
+                  real_t f_next( real_c(0.5) * x_next * ( diag_to * x_next ) - x_next * ( -gdotCorrected_to ) );
+                  //WALBERLA_LOG_WARNING( "[(" << alpha_left << ", ?); (" << alpha_mid << ", " << f_mid << "); (" << alpha_right << ", ?)] <- (" << alpha_next << ", " << f_next << ")" );
+                  //WALBERLA_LOG_WARNING( "left: " << alpha_mid - alpha_left << "  right: " << alpha_right - alpha_mid << "  ll: " << leftlarger );
+                  //WALBERLA_ASSERT(leftlarger ? (alpha_mid - alpha_left > alpha_right - alpha_mid) : (alpha_mid - alpha_left < alpha_right - alpha_mid), "ll inconsistent!" );
+
+                  if (leftlarger) {
+                     // left interval larger
+                     if( f_next < f_mid ) {
+                        alpha_right = alpha_mid;
+                        alpha_mid   = alpha_next;
+                        x_mid       = x_next;
+                        f_mid       = f_next;
+                        leftlarger = true;
                      }
                      else {
-                        // right interval larger
-                        if( f_next < f_mid ) {
-                           alpha_left = alpha_mid;
-                           alpha_mid  = alpha_next;
-                           x_mid      = x_next;
-                           f_mid      = f_next;
-                           leftlarger = false;
-                        }
-                        else {
-                           alpha_right = alpha_next;
-                           leftlarger = true;
-                        }
+                        alpha_left  = alpha_next;
+                        leftlarger = false;
+                     }
+                  }
+                  else {
+                     // right interval larger
+                     if( f_next < f_mid ) {
+                        alpha_left = alpha_mid;
+                        alpha_mid  = alpha_next;
+                        x_mid      = x_next;
+                        f_mid      = f_next;
+                        leftlarger = false;
+                     }
+                     else {
+                        alpha_right = alpha_next;
+                        leftlarger = true;
                      }
                   }
-                  //WALBERLA_LOG_WARNING( "dalpha = " << alpha_right - alpha_left );
-
-                  p_cf[1] = x_mid[0];
-                  p_cf[2] = x_mid[1];
                }
+               //WALBERLA_LOG_WARNING( "dalpha = " << alpha_right - alpha_left );
+
+               p_cf[1] = x_mid[0];
+               p_cf[2] = x_mid[1];
             }
-            //WALBERLA_LOG_WARNING( "Contact #" << i << " is dynamic." );
-         }
-         else {
-            // Contact is static.
-            //WALBERLA_LOG_WARNING( "Contact #" << i << " is static." );
          }
+         //WALBERLA_LOG_WARNING( "Contact #" << i << " is dynamic." );
+      }
+      else {
+         // Contact is static.
+         //WALBERLA_LOG_WARNING( "Contact #" << i << " is static." );
+      }
 
-         //WALBERLA_LOG_WARNING( "Contact reaction in contact frame: " << p_cf << "\n" << contactCache.diag_nto_[i]*p_cf + gdot_nto );
-         Vec3 p_wf( contactframe * p_cf );
-         Vec3 dp( contactCache.p_[i] - p_wf );
-         delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
+      //WALBERLA_LOG_WARNING( "Contact reaction in contact frame: " << p_cf << "\n" << contactCache.diag_nto_[i]*p_cf + gdot_nto );
+      Vec3 p_wf( contactframe * p_cf );
+      Vec3 dp( contactCache.p_[i] - p_wf );
+      delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
 
-         contactCache.p_[i] = p_wf;
+      contactCache.p_[i] = p_wf;
 
-         // Apply impulse right away
-         bodyCache.dv_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-         bodyCache.dv_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
-      }
+      // Apply impulse right away
+      addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i],  contactCache.p_[i] );
+      addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i], -contactCache.p_[i] );
+   }
 
 #if 0
-      Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
-            ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
-            ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
-            ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
-      Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
-      WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
-      WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
-      WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
-   }
-   gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
-   WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] );
+   Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
+         ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
+         ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
+         ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
+   WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
+   WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
+   WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
+}
+gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] );
 }
 #endif
 
 /*
-       * compare DEM time-step with NSCD iteration:
-       * - projections are the same
-       * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
-       *
-      f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
-      f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
-      f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
-
-      or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
-      vs. f_cf = -diaginv * gdot_nto in NSCD iteration
-
-      => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
-
-      f_cf[0] = std::max( 0, f_cf[0] );
-
-      flimit = contactCache.mu_ * f_cf[0];
-      fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
-      if( fsq > flimit * flimit ) {
-         f = flimit / sqrt( fsq );
-         f_cf[1] *= f;
-         f_cf[2] *= f;
-      }
+    * compare DEM time-step with NSCD iteration:
+    * - projections are the same
+    * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
+    *
+   f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
+   f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
+   f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
+
+   or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
+   vs. f_cf = -diaginv * gdot_nto in NSCD iteration
+
+   => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
+
+   f_cf[0] = std::max( 0, f_cf[0] );
+
+   flimit = contactCache.mu_ * f_cf[0];
+   fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
+   if( fsq > flimit * flimit ) {
+      f = flimit / sqrt( fsq );
+      f_cf[1] *= f;
+      f_cf[2] *= f;
+   }
 
-      f_wf = contactframe * f_cf;
+   f_wf = contactframe * f_cf;
 
-      b1->addForceAtPos(  f_wf, gpos );
-      b2->addForceAtPos( -f_wf, gpos );
-      */
-}
+   b1->addForceAtPos(  f_wf, gpos );
+   b2->addForceAtPos( -f_wf, gpos );
+   */
 
-return delta_max;
+   return delta_max;
 }
 //*************************************************************************************************
 
@@ -1095,7 +1307,7 @@ inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombC
 
 //*************************************************************************************************
 
-/*!\brief Relaxes all contacts once. The contact model is for inelastic unilateral contacts with the generalized maximum dissipation principle for friction.
+/*!\brief Relaxes contact \a i once. The contact model is for inelastic unilateral contacts with the generalized maximum dissipation principle for friction.
  *
  * \return The largest variation of contact impulses in the L-infinity norm.
  *
@@ -1103,283 +1315,275 @@ inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticCoulombC
  * minimizing the kinetic energy along the intersection of the plane of maximum compression and
  * the friction cone.
  */
-inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticGeneralizedMaximumDissipationContacts( real_t dtinv,
-                                                                                                               HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
-                                                                                                               HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
+inline real_t HardContactSemiImplicitTimesteppingSolvers::relaxInelasticGeneralizedMaximumDissipationContact( size_t i, real_t dtinv,
+                                                                                                              HardContactSemiImplicitTimesteppingSolvers::ContactCache& contactCache,
+                                                                                                              HardContactSemiImplicitTimesteppingSolvers::BodyCache& bodyCache )
 {
    real_t delta_max( 0 );
-   size_t numContactsMasked( contactCache.p_.size() );
 
-   // Relax contacts
-   for( size_t i = 0; i < numContactsMasked; ++i ) {
-      // Remove velocity corrections of this contact's reaction.
-      bodyCache.dv_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body1_[i]->index_] -= contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-      bodyCache.dv_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-      bodyCache.dw_[contactCache.body2_[i]->index_] += contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
+   // Remove velocity corrections of this contact's reaction.
+   addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i], -contactCache.p_[i] );
+   addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i],  contactCache.p_[i] );
 
-      // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
-      Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   // Calculate the relative contact velocity in the global world frame (if no contact reaction is present at contact i)
+   Vec3 gdot    ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) - ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) + ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] - ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
 
-      // Change from the global world frame to the contact frame
-      Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
-      Vec3 gdot_nto( contactframe.getTranspose() * gdot );
+   // Change from the global world frame to the contact frame
+   Mat3 contactframe( contactCache.n_[i], contactCache.t_[i], contactCache.o_[i] );
+   Vec3 gdot_nto( contactframe.getTranspose() * gdot );
 
-      // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
-      gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+   // The constraint in normal direction is actually a positional constraint but instead of g_n we use g_n/dt equivalently and call it gdot_n
+   gdot_nto[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
 
-      //WALBERLA_LOG_WARNING( "Contact #" << i << " is\nA = \n" << contactCache.diag_nto_[i] << "\nb = \n" << gdot_nto << "\nmu = " << contactCache.mu_[i] );
+   //WALBERLA_LOG_WARNING( "Contact #" << i << " is\nA = \n" << contactCache.diag_nto_[i] << "\nb = \n" << gdot_nto << "\nmu = " << contactCache.mu_[i] );
 
-      if( gdot_nto[0] >= 0 ) {
-         // Contact is separating if no contact reaction is necessary without violating the penetration constraint.
+   if( gdot_nto[0] >= 0 ) {
+      // Contact is separating if no contact reaction is necessary without violating the penetration constraint.
 
-         delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
-         contactCache.p_[i] = Vec3();
+      delta_max = std::max( delta_max, std::max( std::abs( contactCache.p_[i][0] ), std::max( std::abs( contactCache.p_[i][1] ), std::abs( contactCache.p_[i][2] ) ) ) );
+      contactCache.p_[i] = Vec3();
 
-         //WALBERLA_LOG_WARNING( "Contact #" << i << " is separating." );
+      //WALBERLA_LOG_WARNING( "Contact #" << i << " is separating." );
 
-         // No need to apply zero impulse.
-      }
-      else {
-         // Contact is persisting (either static or dynamic).
-
-         // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
-         Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
-
-         // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
-         // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
-         // b = [0.01 -1 -1]';
-         // A\b    \approx [-0.19 -2.28 -1.21]'
-         // eig(A) \approx [ 0.40  0.56  1.04]'
-
-         real_t flimit( contactCache.mu_[i] * p_cf[0] );
-         real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
-         if( fsq > flimit * flimit || p_cf[0] < 0 ) {
-            // Contact cannot be static so it must be dynamic.
-            // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
-
-            // \breve{x}^0 = p_cf[1..2]
-
-            // Eliminate normal component from 3x3 system: contactCache.diag_nto_[i]*p_cf + gdot_nto => \breve{A} \breve{x} - \breve{b}
-            const real_t invA_nn( math::inv( contactCache.diag_nto_[i](0, 0) ) );
-                                  const real_t offdiag( contactCache.diag_nto_[i](1, 2) - invA_nn * contactCache.diag_nto_[i](0, 1) * contactCache.diag_nto_[i](0, 2) );
-                                  Mat2 A_breve( contactCache.diag_nto_[i](1, 1) - invA_nn *math::sq( contactCache.diag_nto_[i](0, 1) ), offdiag, offdiag, contactCache.diag_nto_[i](2, 2) - invA_nn *math::sq( contactCache.diag_nto_[i](0, 2) ) );
-                                                                                                     Vec2 b_breve( -gdot_nto[1] + invA_nn * contactCache.diag_nto_[i](0, 1) * gdot_nto[0], -gdot_nto[2] + invA_nn * contactCache.diag_nto_[i](0, 2) * gdot_nto[0] );
-
-                                                const real_t shiftI( std::atan2( -contactCache.diag_nto_[i](0, 2), contactCache.diag_nto_[i](0, 1) ) );
-                                                                     const real_t shiftJ( std::atan2( -p_cf[2], p_cf[1] ) );
-                                  const real_t a3( std::sqrt(math::sq( contactCache.diag_nto_[i](0, 1) ) +math::sq( contactCache.diag_nto_[i](0, 2) ) ) );
-                                                                       const real_t fractionI( -contactCache.diag_nto_[i](0, 0) / ( contactCache.mu_[i] * a3 ) );
-                                                                       const real_t fractionJ( std::min( invA_nn * contactCache.mu_[i] * ( ( -gdot_nto[0] ) / std::sqrt( fsq ) - a3 * std::cos( shiftI - shiftJ ) ), real_c( 1 ) ) );
-
-                                                             // Search interval determination.
-                                                             real_t alpha_left, alpha_right;
-                                                   if( fractionJ < -1 ) {
-                                                      // J is complete
-                                                      const real_t angleI( std::acos( fractionI ) );
-                                                      alpha_left = -angleI - shiftI;
-                                                      alpha_right = +angleI - shiftI;
-                                                      if( alpha_left < 0 ) {
-                                                         alpha_left += 2 * math::M_PI;
-                                                         alpha_right += 2 * math::M_PI;
-                                                      }
+      // No need to apply zero impulse.
+   }
+   else {
+      // Contact is persisting (either static or dynamic).
+
+      // Calculate the impulse necessary for a static contact expressed as components in the contact frame.
+      Vec3 p_cf( -( contactCache.diag_nto_inv_[i] * gdot_nto ) );
+
+      // Can p_cf[0] be negative even though -gdot_nto[0] > 0? Yes! Try:
+      // A = [0.5 -0.1 +0.1; -0.1 0.5 -0.1; +0.1 -0.1 1];
+      // b = [0.01 -1 -1]';
+      // A\b    \approx [-0.19 -2.28 -1.21]'
+      // eig(A) \approx [ 0.40  0.56  1.04]'
+
+      real_t flimit( contactCache.mu_[i] * p_cf[0] );
+      real_t fsq( p_cf[1] * p_cf[1] + p_cf[2] * p_cf[2] );
+      if( fsq > flimit * flimit || p_cf[0] < 0 ) {
+         // Contact cannot be static so it must be dynamic.
+         // => Complementarity condition on normal reaction now turns into an equation since we know that the normal reaction is definitely not zero.
+
+         // \breve{x}^0 = p_cf[1..2]
+
+         // Eliminate normal component from 3x3 system: contactCache.diag_nto_[i]*p_cf + gdot_nto => \breve{A} \breve{x} - \breve{b}
+         const real_t invA_nn( math::inv( contactCache.diag_nto_[i](0, 0) ) );
+                               const real_t offdiag( contactCache.diag_nto_[i](1, 2) - invA_nn * contactCache.diag_nto_[i](0, 1) * contactCache.diag_nto_[i](0, 2) );
+                               Mat2 A_breve( contactCache.diag_nto_[i](1, 1) - invA_nn *math::sq( contactCache.diag_nto_[i](0, 1) ), offdiag, offdiag, contactCache.diag_nto_[i](2, 2) - invA_nn *math::sq( contactCache.diag_nto_[i](0, 2) ) );
+                                                                                                  Vec2 b_breve( -gdot_nto[1] + invA_nn * contactCache.diag_nto_[i](0, 1) * gdot_nto[0], -gdot_nto[2] + invA_nn * contactCache.diag_nto_[i](0, 2) * gdot_nto[0] );
+
+                                             const real_t shiftI( std::atan2( -contactCache.diag_nto_[i](0, 2), contactCache.diag_nto_[i](0, 1) ) );
+                                                                  const real_t shiftJ( std::atan2( -p_cf[2], p_cf[1] ) );
+                               const real_t a3( std::sqrt(math::sq( contactCache.diag_nto_[i](0, 1) ) +math::sq( contactCache.diag_nto_[i](0, 2) ) ) );
+                                                                    const real_t fractionI( -contactCache.diag_nto_[i](0, 0) / ( contactCache.mu_[i] * a3 ) );
+                                                                    const real_t fractionJ( std::min( invA_nn * contactCache.mu_[i] * ( ( -gdot_nto[0] ) / std::sqrt( fsq ) - a3 * std::cos( shiftI - shiftJ ) ), real_c( 1 ) ) );
+
+                                                          // Search interval determination.
+                                                          real_t alpha_left, alpha_right;
+                                                if( fractionJ < -1 ) {
+                                                   // J is complete
+                                                   const real_t angleI( std::acos( fractionI ) );
+                                                   alpha_left = -angleI - shiftI;
+                                                   alpha_right = +angleI - shiftI;
+                                                   if( alpha_left < 0 ) {
+                                                      alpha_left += 2 * math::M_PI;
+                                                      alpha_right += 2 * math::M_PI;
                                                    }
-                                                   else if( contactCache.diag_nto_[i](0, 0) > contactCache.mu_[i] * a3 ) {
-               // I is complete
-               const real_t angleJ( std::acos( fractionJ ) );
-               alpha_left = -angleJ - shiftJ;
-               alpha_right = +angleJ - shiftJ;
-               if( alpha_left < 0 ) {
-                  alpha_left += 2 * math::M_PI;
-                  alpha_right += 2 * math::M_PI;
-               }
+                                                }
+                                                else if( contactCache.diag_nto_[i](0, 0) > contactCache.mu_[i] * a3 ) {
+            // I is complete
+            const real_t angleJ( std::acos( fractionJ ) );
+            alpha_left = -angleJ - shiftJ;
+            alpha_right = +angleJ - shiftJ;
+            if( alpha_left < 0 ) {
+               alpha_left += 2 * math::M_PI;
+               alpha_right += 2 * math::M_PI;
+            }
+         }
+         else {
+            // neither I nor J is complete
+            const real_t angleJ( std::acos( fractionJ ) );
+            real_t alpha1_left( -angleJ - shiftJ );
+            real_t alpha1_right( +angleJ - shiftJ );
+            if( alpha1_left < 0 ) {
+               alpha1_left += 2 * math::M_PI;
+               alpha1_right += 2 * math::M_PI;
+            }
+            const real_t angleI( std::acos( fractionI ) );
+            real_t alpha2_left( -angleI - shiftI );
+            real_t alpha2_right( +angleI - shiftI );
+            if( alpha2_left < 0 ) {
+               alpha2_left += 2 * math::M_PI;
+               alpha2_right += 2 * math::M_PI;
             }
-            else {
-               // neither I nor J is complete
-               const real_t angleJ( std::acos( fractionJ ) );
-               real_t alpha1_left( -angleJ - shiftJ );
-               real_t alpha1_right( +angleJ - shiftJ );
-               if( alpha1_left < 0 ) {
-                  alpha1_left += 2 * math::M_PI;
-                  alpha1_right += 2 * math::M_PI;
-               }
-               const real_t angleI( std::acos( fractionI ) );
-               real_t alpha2_left( -angleI - shiftI );
-               real_t alpha2_right( +angleI - shiftI );
-               if( alpha2_left < 0 ) {
-                  alpha2_left += 2 * math::M_PI;
-                  alpha2_right += 2 * math::M_PI;
-               }
 
-               // Swap intervals if second interval does not start right of the first interval.
-               if( alpha1_left > alpha2_left ) {
-                  std::swap( alpha1_left, alpha2_left );
-                  std::swap( alpha1_right, alpha2_right );
-               }
+            // Swap intervals if second interval does not start right of the first interval.
+            if( alpha1_left > alpha2_left ) {
+               std::swap( alpha1_left, alpha2_left );
+               std::swap( alpha1_right, alpha2_right );
+            }
 
-               if( alpha2_left > alpha1_right ) {
-                  alpha2_right -= 2*math::M_PI;
-                  if( alpha2_right > alpha1_right ) {
-                     // [alpha1_left; alpha1_right] \subset [alpha2_left; alpha2_right]
-                  }
-                  else {
-                     // [alpha2_left; alpha2_right] intersects the left end of [alpha1_left; alpha1_right]
-                     alpha1_right = alpha2_right;
-                  }
+            if( alpha2_left > alpha1_right ) {
+               alpha2_right -= 2*math::M_PI;
+               if( alpha2_right > alpha1_right ) {
+                  // [alpha1_left; alpha1_right] \subset [alpha2_left; alpha2_right]
                }
                else {
-                  alpha1_left = alpha2_left;
-                  if( alpha2_right > alpha1_right ) {
-                     // [alpha2_left; alpha2_right] intersects the right end of [alpha1_left; alpha1_right]
-                  }
-                  else {
-                     // [alpha2_left; alpha2_right] \subset [alpha1_left; alpha1_right]
-                     alpha1_right = alpha2_right;
-                  }
+                  // [alpha2_left; alpha2_right] intersects the left end of [alpha1_left; alpha1_right]
+                  alpha1_right = alpha2_right;
+               }
+            }
+            else {
+               alpha1_left = alpha2_left;
+               if( alpha2_right > alpha1_right ) {
+                  // [alpha2_left; alpha2_right] intersects the right end of [alpha1_left; alpha1_right]
+               }
+               else {
+                  // [alpha2_left; alpha2_right] \subset [alpha1_left; alpha1_right]
+                  alpha1_right = alpha2_right;
                }
-
-               alpha_left = alpha1_left;
-               alpha_right = alpha1_right;
             }
 
-            const real_t phi( real_c(0.5) * ( real_c(1) + std::sqrt( real_c( 5 ) ) ) );
-                                                   real_t alpha_mid( ( alpha_right + alpha_left * phi ) / ( 1 + phi ) );
-                                  Vec2 x_mid;
-                  real_t f_mid;
+            alpha_left = alpha1_left;
+            alpha_right = alpha1_right;
+         }
 
-            {
-               real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_mid + shiftI ) );
-                     if( r_ub < 0 )
-                     r_ub = math::Limits<real_t>::inf();
-               x_mid = Vec2( r_ub * std::cos( alpha_mid ), r_ub * std::sin( alpha_mid ) );
-               f_mid = real_c(0.5) * x_mid * ( A_breve * x_mid ) - x_mid * b_breve;
-            }
+         const real_t phi( real_c(0.5) * ( real_c(1) + std::sqrt( real_c( 5 ) ) ) );
+                                                real_t alpha_mid( ( alpha_right + alpha_left * phi ) / ( 1 + phi ) );
+                               Vec2 x_mid;
+               real_t f_mid;
 
-            bool leftlarger = false;
-            for( size_t k = 0; k < maxSubIterations_; ++k ) {
-               real_t alpha_next( alpha_left + ( alpha_right - alpha_mid ) );
-               real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_next + shiftI ) );
-                     if( r_ub < 0 )
-                     r_ub = math::Limits<real_t>::inf();
-               Vec2 x_next( r_ub * std::cos( alpha_next ), r_ub * std::sin( alpha_next ) );
-               real_t f_next( real_c(0.5) * x_next * ( A_breve * x_next ) - x_next * b_breve );
-
-               //WALBERLA_LOG_WARNING( "[(" << alpha_left << ", ?); (" << alpha_mid << ", " << f_mid << "); (" << alpha_right << ", ?)] <- (" << alpha_next << ", " << f_next << ")" );
-               //WALBERLA_LOG_WARNING( "left: " << alpha_mid - alpha_left << "  right: " << alpha_right - alpha_mid << "  ll: " << leftlarger );
-               //WALBERLA_ASSERT(leftlarger ? (alpha_mid - alpha_left > alpha_right - alpha_mid) : (alpha_mid - alpha_left < alpha_right - alpha_mid), "ll inconsistent!" );
-
-               if (leftlarger) {
-                  // left interval larger
-                  if( f_next < f_mid ) {
-                     alpha_right = alpha_mid;
-                     alpha_mid   = alpha_next;
-                     x_mid       = x_next;
-                     f_mid       = f_next;
-                     leftlarger = true;
-                  }
-                  else {
-                     alpha_left  = alpha_next;
-                     leftlarger = false;
-                  }
+         {
+            real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_mid + shiftI ) );
+                  if( r_ub < 0 )
+                  r_ub = math::Limits<real_t>::inf();
+            x_mid = Vec2( r_ub * std::cos( alpha_mid ), r_ub * std::sin( alpha_mid ) );
+            f_mid = real_c(0.5) * x_mid * ( A_breve * x_mid ) - x_mid * b_breve;
+         }
+
+         bool leftlarger = false;
+         for( size_t k = 0; k < maxSubIterations_; ++k ) {
+            real_t alpha_next( alpha_left + ( alpha_right - alpha_mid ) );
+            real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_next + shiftI ) );
+                  if( r_ub < 0 )
+                  r_ub = math::Limits<real_t>::inf();
+            Vec2 x_next( r_ub * std::cos( alpha_next ), r_ub * std::sin( alpha_next ) );
+            real_t f_next( real_c(0.5) * x_next * ( A_breve * x_next ) - x_next * b_breve );
+
+            //WALBERLA_LOG_WARNING( "[(" << alpha_left << ", ?); (" << alpha_mid << ", " << f_mid << "); (" << alpha_right << ", ?)] <- (" << alpha_next << ", " << f_next << ")" );
+            //WALBERLA_LOG_WARNING( "left: " << alpha_mid - alpha_left << "  right: " << alpha_right - alpha_mid << "  ll: " << leftlarger );
+            //WALBERLA_ASSERT(leftlarger ? (alpha_mid - alpha_left > alpha_right - alpha_mid) : (alpha_mid - alpha_left < alpha_right - alpha_mid), "ll inconsistent!" );
+
+            if (leftlarger) {
+               // left interval larger
+               if( f_next < f_mid ) {
+                  alpha_right = alpha_mid;
+                  alpha_mid   = alpha_next;
+                  x_mid       = x_next;
+                  f_mid       = f_next;
+                  leftlarger = true;
                }
                else {
-                  // right interval larger
-                  if( f_next < f_mid ) {
-                     alpha_left = alpha_mid;
-                     alpha_mid  = alpha_next;
-                     x_mid      = x_next;
-                     f_mid      = f_next;
-                     leftlarger = false;
-                  }
-                  else {
-                     alpha_right = alpha_next;
-                     leftlarger = true;
-                  }
+                  alpha_left  = alpha_next;
+                  leftlarger = false;
                }
             }
-            //WALBERLA_LOG_DETAIL( "dalpha = " << alpha_right - alpha_left << "\n");
-            {
-               real_t alpha_init( std::atan2( p_cf[2], p_cf[1] ) );
-               real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_init + shiftI ) );
-                     if( r_ub < 0 )
-                     r_ub = math::Limits<real_t>::inf();
-               Vec2 x_init( r_ub * std::cos( alpha_init ), r_ub * std::sin( alpha_init ) );
-               real_t f_init( real_c(0.5) * x_init * ( A_breve * x_init ) - x_init * b_breve );
-
-               if( f_init < f_mid )
-               {
-                  x_mid = x_init;
-                  WALBERLA_LOG_DETAIL( "Replacing solution by primitive dissipative solution (" << f_init << " < " << f_mid << " at " << alpha_init << " vs. " << alpha_mid << ").\n");
+            else {
+               // right interval larger
+               if( f_next < f_mid ) {
+                  alpha_left = alpha_mid;
+                  alpha_mid  = alpha_next;
+                  x_mid      = x_next;
+                  f_mid      = f_next;
+                  leftlarger = false;
+               }
+               else {
+                  alpha_right = alpha_next;
+                  leftlarger = true;
                }
             }
-
-            p_cf[0] = invA_nn * ( -gdot_nto[0] - contactCache.diag_nto_[i](0, 1) * x_mid[0] - contactCache.diag_nto_[i](0, 2) * x_mid[1] );
-            p_cf[1] = x_mid[0];
-            p_cf[2] = x_mid[1];
-            //WALBERLA_LOG_DETAIL( "Contact #" << i << " is dynamic." );
          }
-         else {
-            // Contact is static.
-            //WALBERLA_LOG_DETAIL( "Contact #" << i << " is static." );
+         //WALBERLA_LOG_DETAIL( "dalpha = " << alpha_right - alpha_left << "\n");
+         {
+            real_t alpha_init( std::atan2( p_cf[2], p_cf[1] ) );
+            real_t r_ub = contactCache.mu_[i] * ( -gdot_nto[0] ) / ( contactCache.diag_nto_[i](0, 0) + contactCache.mu_[i] * a3 * std::cos( alpha_init + shiftI ) );
+                  if( r_ub < 0 )
+                  r_ub = math::Limits<real_t>::inf();
+            Vec2 x_init( r_ub * std::cos( alpha_init ), r_ub * std::sin( alpha_init ) );
+            real_t f_init( real_c(0.5) * x_init * ( A_breve * x_init ) - x_init * b_breve );
+
+            if( f_init < f_mid )
+            {
+               x_mid = x_init;
+               WALBERLA_LOG_DETAIL( "Replacing solution by primitive dissipative solution (" << f_init << " < " << f_mid << " at " << alpha_init << " vs. " << alpha_mid << ").\n");
+            }
          }
-         Vec3 p_wf( contactframe * p_cf );
-         Vec3 dp( contactCache.p_[i] - p_wf );
-         delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
-         //WALBERLA_LOG_DETAIL( "Contact reaction in contact frame: " << p_cf << "\nContact action in contact frame: " << contactCache.diag_nto_[i]*p_cf + gdot_nto );
-
-         contactCache.p_[i] = p_wf;
-
-         // Apply impulse right away
-         bodyCache.dv_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body1_[i]->index_] += contactCache.body1_[i]->getInvInertia() * ( contactCache.r1_[i] % contactCache.p_[i] );
-         bodyCache.dv_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvMass() * contactCache.p_[i];
-         bodyCache.dw_[contactCache.body2_[i]->index_] -= contactCache.body2_[i]->getInvInertia() * ( contactCache.r2_[i] % contactCache.p_[i] );
-      }
 
-#if 0
-      Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
-            ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
-            ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
-            ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
-      Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
-      WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
-      WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
-      WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
-
-      gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
-      WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] << "\n");
-#endif
+         p_cf[0] = invA_nn * ( -gdot_nto[0] - contactCache.diag_nto_[i](0, 1) * x_mid[0] - contactCache.diag_nto_[i](0, 2) * x_mid[1] );
+         p_cf[1] = x_mid[0];
+         p_cf[2] = x_mid[1];
+         //WALBERLA_LOG_DETAIL( "Contact #" << i << " is dynamic." );
+      }
+      else {
+         // Contact is static.
+         //WALBERLA_LOG_DETAIL( "Contact #" << i << " is static." );
+      }
+      Vec3 p_wf( contactframe * p_cf );
+      Vec3 dp( contactCache.p_[i] - p_wf );
+      delta_max = std::max( delta_max, std::max( std::abs( dp[0] ), std::max( std::abs( dp[1] ), std::abs( dp[2] ) ) ) );
+      //WALBERLA_LOG_DETAIL( "Contact reaction in contact frame: " << p_cf << "\nContact action in contact frame: " << contactCache.diag_nto_[i]*p_cf + gdot_nto );
 
-      /*
-       * compare DEM time-step with NSCD iteration:
-       * - projections are the same
-       * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
-       *
-      f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
-      f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
-      f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
+      contactCache.p_[i] = p_wf;
 
-      or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
-      vs. f_cf = -diaginv * gdot_nto in NSCD iteration
+      // Apply impulse right away
+      addImpulse( bodyCache, contactCache.body1_[i], contactCache.r1_[i],  contactCache.p_[i] );
+      addImpulse( bodyCache, contactCache.body2_[i], contactCache.r2_[i], -contactCache.p_[i] );
+   }
 
-      => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
+#if 0
+   Vec3 gdot2   ( ( bodyCache.v_[contactCache.body1_[i]->index_] + bodyCache.dv_[contactCache.body1_[i]->index_] ) -
+         ( bodyCache.v_[contactCache.body2_[i]->index_] + bodyCache.dv_[contactCache.body2_[i]->index_] ) +
+         ( bodyCache.w_[contactCache.body1_[i]->index_] + bodyCache.dw_[contactCache.body1_[i]->index_] ) % contactCache.r1_[i] -
+         ( bodyCache.w_[contactCache.body2_[i]->index_] + bodyCache.dw_[contactCache.body2_[i]->index_] ) % contactCache.r2_[i] /* + diag_[i] * p */ );
+   Vec3 gdot_nto2( contactframe.getTranspose() * gdot2 );
+   WALBERLA_LOG_DETAIL( "gdot_n2 = " << gdot_nto2[0] );
+   WALBERLA_LOG_DETAIL( "gdot_t2 = " << gdot_nto2[1] );
+   WALBERLA_LOG_DETAIL( "gdot_o2 = " << gdot_nto2[2] );
 
-      f_cf[0] = std::max( 0, f_cf[0] );
+   gdot_nto2[0] += ( /* + trans( contactCache.n_[i] ) * ( contactCache.body1_[i]->getPosition() + contactCache.r1_[i] ) - ( contactCache.body2_[i]->getPosition() + contactCache.r2_[i] ) */ + contactCache.dist_[i] ) * dtinv;
+   WALBERLA_LOG_DETAIL( "gdot_n2' = " << gdot_nto2[0] << "\n");
+#endif
 
-      flimit = contactCache.mu_ * f_cf[0];
-      fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
-      if( fsq > flimit * flimit ) {
-         f = flimit / sqrt( fsq );
-         f_cf[1] *= f;
-         f_cf[2] *= f;
-      }
+   /*
+    * compare DEM time-step with NSCD iteration:
+    * - projections are the same
+    * - velocities are the same if we use an explicit Euler discretization for the velocity time integration
+    *
+   f_cf[0] = -stiffness * contactCache.dist_ - damping_n * gdot_n = -[(stiffness * dt) * contactCache.dist_ * dtinv + damping_n * gdot_n] = -foo * (gdot_n + contactCache.dist_ * dtinv) where foo = stiffness * dt = damping_n;
+   f_cf[1] = -damping_t * gdot_t                     = -damping_t * gdot_t;
+   f_cf[2] = -damping_t * gdot_o                     = -damping_t * gdot_o;
+
+   or: f_cf = -diag(foo, damping_t, damping_t) * gdot_nto   (since gdot_nto[0] is modified)
+   vs. f_cf = -diaginv * gdot_nto in NSCD iteration
+
+   => The NSCD iteration is more or less a DEM time step where we choose the stiffness and damping parameters such that penetration is non-existent after a time step and contacts are truly static (tangential rel. vel. is zero) unless the friction force hits its limit
+
+   f_cf[0] = std::max( 0, f_cf[0] );
+
+   flimit = contactCache.mu_ * f_cf[0];
+   fsq = f_cf[1] * f_cf[1] + f_cf[2] * f_cf[2]
+   if( fsq > flimit * flimit ) {
+      f = flimit / sqrt( fsq );
+      f_cf[1] *= f;
+      f_cf[2] *= f;
+   }
 
-      f_wf = contactframe * f_cf;
+   f_wf = contactframe * f_cf;
 
-      b1->addForceAtPos(  f_wf, gpos );
-      b2->addForceAtPos( -f_wf, gpos );
-      */
-   }
+   b1->addForceAtPos(  f_wf, gpos );
+   b2->addForceAtPos( -f_wf, gpos );
+   */
 
    return delta_max;
 }
@@ -1811,6 +2015,29 @@ inline void HardContactSemiImplicitTimesteppingSolvers::integratePositions( Body
 }
 //*************************************************************************************************
 
+
+//*************************************************************************************************
+/*!\brief Applies an impulse to the velocity corrections of a given body.
+ *
+ * \param bodyCache The body cache of the block.
+ * \param body The body the impulse is acting on.
+ * \param r The contact point relative to the center of mass of the body.
+ * \param p The impulse.
+ * \return void
+ *
+ * Bodies with infinite mass are not touched, hence contacts sharing only such bodies can be
+ * relaxed concurrently.
+ */
+inline void HardContactSemiImplicitTimesteppingSolvers::addImpulse( BodyCache& bodyCache, BodyID body, const Vec3& r, const Vec3& p ) const
+{
+   if( body->hasInfiniteMass() )
+      return;
+
+   bodyCache.dv_[body->index_] += body->getInvMass() * p;
+   bodyCache.dw_[body->index_] += body->getInvInertia() * ( r % p );
+}
+//*************************************************************************************************
+
 } // namespace cr
 } // namespace pe
 
@@ -1831,6 +2058,9 @@ void configure( const Config::BlockHandle& config, pe::cr::HCSITS& cr )
    std::string HCSITSRelaxationModelStr = config.getParameter<std::string>("HCSITSRelaxationModelStr", "ApproximateInelasticCoulombContactByDecoupling" );
    WALBERLA_LOG_INFO_ON_ROOT("HCSITSRelaxationModelStr: " << HCSITSRelaxationModelStr);
 
+   std::string HCSITSRelaxationScheduleStr = config.getParameter<std::string>("HCSITSRelaxationScheduleStr", "SequentialGaussSeidel" );
+   WALBERLA_LOG_INFO_ON_ROOT("HCSITSRelaxationScheduleStr: " << HCSITSRelaxationScheduleStr);
+
    cr::HCSITS::RelaxationModel HCSITSRelaxationModel;
    if (HCSITSRelaxationModelStr == "InelasticFrictionlessContact")
    {
@@ -1849,14 +2079,31 @@ void configure( const Config::BlockHandle& config, pe::cr::HCSITS& cr )
       WALBERLA_ABORT("Unknown HCSITSRelaxationModel: " << HCSITSRelaxationModelStr);
    }
 
+   cr::HCSITS::RelaxationSchedule HCSITSRelaxationSchedule;
+   if (HCSITSRelaxationScheduleStr == "SequentialGaussSeidel")
+   {
+      HCSITSRelaxationSchedule = cr::HCSITS::SequentialGaussSeidel;
+   } else if (HCSITSRelaxationScheduleStr == "ColoredGaussSeidel")
+   {
+      HCSITSRelaxationSchedule = cr::HCSITS::ColoredGaussSeidel;
+   } else
+   {
+      WALBERLA_ABORT("Unknown HCSITSRelaxationSchedule: " << HCSITSRelaxationScheduleStr);
+   }
+
    Vec3 globalLinearAcceleration = config.getParameter<Vec3>("globalLinearAcceleration", Vec3(0, 0, 0));
    WALBERLA_LOG_INFO_ON_ROOT("globalLinearAcceleration: " << globalLinearAcceleration);
 
+   bool HCSITSWarmStarting = config.getParameter<bool>("HCSITSWarmStarting", false );
+   WALBERLA_LOG_INFO_ON_ROOT("HCSITSWarmStarting: " << HCSITSWarmStarting);
+
    cr.setMaxIterations( uint_c(HCSITSmaxIterations) );
    cr.setRelaxationModel( HCSITSRelaxationModel );
+   cr.setRelaxationSchedule( HCSITSRelaxationSchedule );
    cr.setRelaxationParameter( HCSITSRelaxationParameter );
    cr.setErrorReductionParameter( HCSITSErrorReductionParameter );
    cr.setGlobalLinearAcceleration( globalLinearAcceleration );
+   cr.setWarmStarting( HCSITSWarmStarting );
 }
 
 } // namespace walberla
@@ -0,0 +1,439 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BatchedFCD.h
+//
+//======================================================================================================================
+
+
+#pragma once
+
+#include "AnalyticCollisionDetection.h"
+#include "IFCD.h"
+
+#include "pe/Thresholds.h"
+#include "pe/utility/BodyCast.h"
+
+#include "blockforest/BlockDataHandling.h"
+
+#include "simd/AlignedAllocator.h"
+#include "simd/SIMD.h"
+
+#include <vector>
+
+namespace walberla{
+namespace pe{
+namespace fcd {
+
+///
+/// \brief Fine collision detection that computes sphere-sphere, sphere-plane and sphere-box contacts in SIMD batches.
+///
+/// Generates the same contacts (in the same order) as GenericFCD with the AnalyticCollideFunctor.
+/// In a first pass, the possible contacts are grouped by their shape combination and the data of
+/// the bodies is gathered into aligned structure-of-arrays buffers. Batched SIMD kernels (see
+/// simd/SIMD.h) then compute the distance, the contact point and the contact normal of four pairs
+/// at a time, following the analytic collision functions:
+///  - sphere-sphere: distance of the centers minus the radii,
+///  - sphere-plane: signed distance of the center to the plane minus the radius,
+///  - sphere-box: distance of the center to its projection onto the box minus the radius. Pairs
+///    whose center lies inside of the box are marked and passed to the analytic function.
+/// In a second pass, the contact container is reserved for all contacts found by the kernels
+/// (plus all pairs that are not batched) and the contacts are written in the order of
+/// \a possibleContacts.
+///
+/// All other shape combinations are passed on to the AnalyticCollideFunctor unchanged.
+///
+/// The kernels compute in double precision. The contact data may therefore differ from the
+/// analytic functions in the last bits (and by the rounding to real_t if real_t is float).
+///
+template <typename BodyTypeTuple>
+class BatchedFCD : public IFCD{
+public:
+   virtual Contacts& generateContacts(PossibleContacts& possibleContacts)
+   {
+      contacts_.clear();
+
+      classify( possibleContacts );
+
+      collideSphereSphere();
+      collideSpherePlane();
+      collideSphereBox();
+
+      contacts_.reserve( countContacts( sphereSphere_ ) + countContacts( spherePlane_ ) + countContacts( sphereBox_ ) + unbatched_ );
+
+      AnalyticCollideFunctor<decltype(contacts_)> func(contacts_);
+      for (size_t i = 0; i < possibleContacts.size(); ++i)
+      {
+         BodyID bd1 = possibleContacts[i].first;
+         BodyID bd2 = possibleContacts[i].second;
+         switch (pairType_[i])
+         {
+         case SPHERE_SPHERE:
+            addContact( sphereSphere_, slot_[i], bd1, bd2 );
+            break;
+         case SPHERE_PLANE:
+            addContact( spherePlane_, slot_[i], bd1, bd2 );
+            break;
+         case PLANE_SPHERE:
+            addContact( spherePlane_, slot_[i], bd2, bd1 );
+            break;
+         case SPHERE_BOX:
+            if (sphereBox_.fallback[ slot_[i] ])
+               analytic::collide( static_cast<SphereID>(bd1), static_cast<BoxID>(bd2), contacts_ );
+            else
+               addContact( sphereBox_, slot_[i], bd1, bd2 );
+            break;
+         case BOX_SPHERE:
+            if (sphereBox_.fallback[ slot_[i] ])
+               analytic::collide( static_cast<BoxID>(bd1), static_cast<SphereID>(bd2), contacts_ );
+            else
+               addContact( sphereBox_, slot_[i], bd2, bd1 );
+            break;
+         default:
+            DoubleCast<BodyTypeTuple, BodyTypeTuple, AnalyticCollideFunctor<decltype(contacts_)>, bool>::execute(bd1, bd2, func);
+         }
+      }
+      return contacts_;
+   }
+
+   /// number of possible contacts that were found to be separated by the SIMD kernels in the last call of generateContacts()
+   size_t getNumberOfRejectedPairs() const { return rejected_; }
+
+private:
+   enum PairType { SPHERE_SPHERE, SPHERE_PLANE, PLANE_SPHERE, SPHERE_BOX, BOX_SPHERE, OTHER };
+
+   /// columns of the input data of the batches
+   enum SphereSphereColumn { SS_DX, SS_DY, SS_DZ, SS_R1, SS_R2, SS_X2, SS_Y2, SS_Z2, SS_COLUMNS };
+   enum SpherePlaneColumn  { SP_X, SP_Y, SP_Z, SP_NX, SP_NY, SP_NZ, SP_R, SP_D, SP_COLUMNS };
+   enum SphereBoxColumn    { SB_DX, SB_DY, SB_DZ, SB_R0, SB_R1, SB_R2, SB_R3, SB_R4, SB_R5, SB_R6, SB_R7, SB_R8,
+                             SB_LX, SB_LY, SB_LZ, SB_R, SB_X, SB_Y, SB_Z, SB_COLUMNS };
+
+   typedef std::vector< double, simd::aligned_allocator< double, 32 > > AlignedVector;
+
+   /// Structure of arrays of the pairs of one shape combination: the input data of the kernels
+   /// (one array per column) and the contact data computed by the kernels.
+   struct Batch
+   {
+      explicit Batch( const size_t columns ) : in( columns ) {}
+
+      void clear()
+      {
+         index.clear();
+         for (size_t c = 0; c < in.size(); ++c)
+            in[c].clear();
+      }
+
+      /// pads the arrays to a multiple of the SIMD width and resizes the results
+      void pad()
+      {
+         const size_t size = ( ( index.size() + 3 ) / 4 ) * 4;
+         for (size_t c = 0; c < in.size(); ++c)
+            in[c].resize( size, 1.0 );
+         dist.resize( size ); px.resize( size ); py.resize( size ); pz.resize( size );
+         nx.resize( size ); ny.resize( size ); nz.resize( size );
+         fallback.assign( size, 0 );
+      }
+
+      void add( const size_t column, const real_t value ) { in[column].push_back( double( value ) ); }
+      const double * column( const size_t c, const size_t i ) const { return &(in[c][i]); }
+
+      std::vector<size_t>        index;  ///< index of the pair in the possible contacts
+      std::vector<AlignedVector> in;
+
+      AlignedVector     dist;            ///< distance of the bodies (negative: penetration depth)
+      AlignedVector     px, py, pz;      ///< contact point
+      AlignedVector     nx, ny, nz;      ///< contact normal
+      std::vector<char> fallback;        ///< pairs that have to be handled by the analytic functions
+   };
+
+   static bool isSphere( ConstBodyID bd ) { return bd->getTypeID() == Sphere::getStaticTypeID(); }
+   static bool isPlane ( ConstBodyID bd ) { return bd->getTypeID() == Plane::getStaticTypeID(); }
+   static bool isBox   ( ConstBodyID bd ) { return bd->getTypeID() == Box::getStaticTypeID(); }
+
+   void classify( const PossibleContacts& possibleContacts )
+   {
+      pairType_.resize( possibleContacts.size() );
+      slot_.resize( possibleContacts.size() );
+      unbatched_ = 0;
+      rejected_  = 0;
+
+      sphereSphere_.clear();
+      spherePlane_.clear();
+      sphereBox_.clear();
+
+      for (size_t i = 0; i < possibleContacts.size(); ++i)
+      {
+         ConstBodyID bd1 = possibleContacts[i].first;
+         ConstBodyID bd2 = possibleContacts[i].second;
+
+         if (isSphere(bd1))
+         {
+            if      (isSphere(bd2)) { pairType_[i] = SPHERE_SPHERE; addSphere( i, static_cast<ConstSphereID>(bd1), static_cast<ConstSphereID>(bd2) ); }
+            else if (isPlane (bd2)) { pairType_[i] = SPHERE_PLANE;  addPlane ( i, static_cast<ConstSphereID>(bd1), static_cast<ConstPlaneID>(bd2) ); }
+            else if (isBox   (bd2)) { pairType_[i] = SPHERE_BOX;    addBox   ( i, static_cast<ConstSphereID>(bd1), static_cast<ConstBoxID>(bd2) ); }
+            else                    { pairType_[i] = OTHER; ++unbatched_; }
+         } else if (isSphere(bd2))
+         {
+            if      (isPlane (bd1)) { pairType_[i] = PLANE_SPHERE;  addPlane ( i, static_cast<ConstSphereID>(bd2), static_cast<ConstPlaneID>(bd1) ); }
+            else if (isBox   (bd1)) { pairType_[i] = BOX_SPHERE;    addBox   ( i, static_cast<ConstSphereID>(bd2), static_cast<ConstBoxID>(bd1) ); }
+            else                    { pairType_[i] = OTHER; ++unbatched_; }
+         } else
+         {
+            pairType_[i] = OTHER;
+            ++unbatched_;
+         }
+      }
+
+      sphereSphere_.pad();
+      spherePlane_.pad();
+      sphereBox_.pad();
+   }
+
+   void addSphere( const size_t i, ConstSphereID s1, ConstSphereID s2 )
+   {
+      const Vec3 d( s1->getPosition() - s2->getPosition() );
+      const Vec3& pos2 = s2->getPosition();
+
+      slot_[i] = sphereSphere_.index.size();
+      sphereSphere_.index.push_back( i );
+      sphereSphere_.add( SS_DX, d[0] );    sphereSphere_.add( SS_DY, d[1] );    sphereSphere_.add( SS_DZ, d[2] );
+      sphereSphere_.add( SS_R1, s1->getRadius() );
+      sphereSphere_.add( SS_R2, s2->getRadius() );
+      sphereSphere_.add( SS_X2, pos2[0] ); sphereSphere_.add( SS_Y2, pos2[1] ); sphereSphere_.add( SS_Z2, pos2[2] );
+   }
+
+   void addPlane( const size_t i, ConstSphereID s, ConstPlaneID p )
+   {
+      const Vec3& pos    = s->getPosition();
+      const Vec3& normal = p->getNormal();
+
+      slot_[i] = spherePlane_.index.size();
+      spherePlane_.index.push_back( i );
+      spherePlane_.add( SP_X,  pos[0] );    spherePlane_.add( SP_Y,  pos[1] );    spherePlane_.add( SP_Z,  pos[2] );
+      spherePlane_.add( SP_NX, normal[0] ); spherePlane_.add( SP_NY, normal[1] ); spherePlane_.add( SP_NZ, normal[2] );
+      spherePlane_.add( SP_R, s->getRadius() );
+      spherePlane_.add( SP_D, p->getDisplacement() );
+   }
+
+   void addBox( const size_t i, ConstSphereID s, ConstBoxID b )
+   {
+      const Vec3 d( s->getPosition() - b->getPosition() );
+      const Vec3& bpos = b->getPosition();
+      const Mat3& R    = b->getRotation();
+      const Vec3 l( real_t(0.5) * b->getLengths() );
+
+      slot_[i] = sphereBox_.index.size();
+      sphereBox_.index.push_back( i );
+      sphereBox_.add( SB_DX, d[0] ); sphereBox_.add( SB_DY, d[1] ); sphereBox_.add( SB_DZ, d[2] );
+      for (size_t c = 0; c < 9; ++c)
+         sphereBox_.add( SB_R0 + c, R[c] );
+      sphereBox_.add( SB_LX, l[0] ); sphereBox_.add( SB_LY, l[1] ); sphereBox_.add( SB_LZ, l[2] );
+      sphereBox_.add( SB_R, s->getRadius() );
+      sphereBox_.add( SB_X, bpos[0] ); sphereBox_.add( SB_Y, bpos[1] ); sphereBox_.add( SB_Z, bpos[2] );
+   }
+
+   /// contact data of sphere-sphere pairs, see analytic::collide( SphereID, SphereID, Container& )
+   void collideSphereSphere()
+   {
+      using namespace simd;
+
+      Batch& b = sphereSphere_;
+      const double4_t half = make_double4( 0.5 );
+      const double4_t one  = make_double4( 1.0 );
+
+      for (size_t i = 0; i < b.index.size(); i += 4)
+      {
+         const double4_t x  = load_aligned( b.column( SS_DX, i ) );
+         const double4_t y  = load_aligned( b.column( SS_DY, i ) );
+         const double4_t z  = load_aligned( b.column( SS_DZ, i ) );
+         const double4_t r2 = load_aligned( b.column( SS_R2, i ) );
+
+         const double4_t len  = sqrt( x * x + y * y + z * z );
+         const double4_t dist = len - load_aligned( b.column( SS_R1, i ) ) - r2;
+         const double4_t ilen = one / len;
+         const double4_t nx   = x * ilen;
+         const double4_t ny   = y * ilen;
+         const double4_t nz   = z * ilen;
+         const double4_t k    = r2 + half * dist;
+
+         store_aligned( &b.dist[i], dist );
+         store_aligned( &b.nx[i], nx );
+         store_aligned( &b.ny[i], ny );
+         store_aligned( &b.nz[i], nz );
+         store_aligned( &b.px[i], load_aligned( b.column( SS_X2, i ) ) + nx * k );
+         store_aligned( &b.py[i], load_aligned( b.column( SS_Y2, i ) ) + ny * k );
+         store_aligned( &b.pz[i], load_aligned( b.column( SS_Z2, i ) ) + nz * k );
+      }
+   }
+
+   /// contact data of sphere-plane pairs, see analytic::collide( SphereID, PlaneID, Container& )
+   void collideSpherePlane()
+   {
+      using namespace simd;
+
+      Batch& b = spherePlane_;
+
+      for (size_t i = 0; i < b.index.size(); i += 4)
+      {
+         const double4_t x  = load_aligned( b.column( SP_X,  i ) );
+         const double4_t y  = load_aligned( b.column( SP_Y,  i ) );
+         const double4_t z  = load_aligned( b.column( SP_Z,  i ) );
+         const double4_t nx = load_aligned( b.column( SP_NX, i ) );
+         const double4_t ny = load_aligned( b.column( SP_NY, i ) );
+         const double4_t nz = load_aligned( b.column( SP_NZ, i ) );
+         const double4_t r  = load_aligned( b.column( SP_R,  i ) );
+
+         const double4_t k    = nx * x + ny * y + nz * z;
+         const double4_t dist = k - r - load_aligned( b.column( SP_D, i ) );
+         const double4_t f    = r + dist;
+
+         store_aligned( &b.dist[i], dist );
+         store_aligned( &b.nx[i], nx );
+         store_aligned( &b.ny[i], ny );
+         store_aligned( &b.nz[i], nz );
+         store_aligned( &b.px[i], x - f * nx );
+         store_aligned( &b.py[i], y - f * ny );
+         store_aligned( &b.pz[i], z - f * nz );
+      }
+   }
+
+   /// Contact data of sphere-box pairs, see analytic::collide( SphereID, BoxID, Container& ). Pairs
+   /// whose sphere center lies inside of the box are marked for the analytic function.
+   void collideSphereBox()
+   {
+      using namespace simd;
+
+      Batch& b = sphereBox_;
+      const double4_t one  = make_double4( 1.0 );
+      const double4_t zero = make_zero();
+
+      for (size_t i = 0; i < b.index.size(); i += 4)
+      {
+         const double4_t dx = load_aligned( b.column( SB_DX, i ) );
+         const double4_t dy = load_aligned( b.column( SB_DY, i ) );
+         const double4_t dz = load_aligned( b.column( SB_DZ, i ) );
+
+         const double4_t R0 = load_aligned( b.column( SB_R0, i ) );
+         const double4_t R1 = load_aligned( b.column( SB_R1, i ) );
+         const double4_t R2 = load_aligned( b.column( SB_R2, i ) );
+         const double4_t R3 = load_aligned( b.column( SB_R3, i ) );
+         const double4_t R4 = load_aligned( b.column( SB_R4, i ) );
+         const double4_t R5 = load_aligned( b.column( SB_R5, i ) );
+         const double4_t R6 = load_aligned( b.column( SB_R6, i ) );
+         const double4_t R7 = load_aligned( b.column( SB_R7, i ) );
+         const double4_t R8 = load_aligned( b.column( SB_R8, i ) );
+
+         const double4_t lx = load_aligned( b.column( SB_LX, i ) );
+         const double4_t ly = load_aligned( b.column( SB_LY, i ) );
+         const double4_t lz = load_aligned( b.column( SB_LZ, i ) );
+
+         // distance in the frame of reference of the box
+         const double4_t px = dx * R0 + dy * R3 + dz * R6;
+         const double4_t py = dx * R1 + dy * R4 + dz * R7;
+         const double4_t pz = dx * R2 + dy * R5 + dz * R8;
+
+         const int inside = movemask( logicalAND( logicalAND( inRange( px, lx ), inRange( py, ly ) ), inRange( pz, lz ) ) );
+
+         // projection onto the box, transformed back to the global frame
+         const double4_t cx = clamp( px, lx );
+         const double4_t cy = clamp( py, ly );
+         const double4_t cz = clamp( pz, lz );
+
+         const double4_t qx = R0 * cx + R1 * cy + R2 * cz;
+         const double4_t qy = R3 * cx + R4 * cy + R5 * cz;
+         const double4_t qz = R6 * cx + R7 * cy + R8 * cz;
+
+         const double4_t nx = dx - qx;
+         const double4_t ny = dy - qy;
+         const double4_t nz = dz - qz;
+
+         const double4_t len  = sqrt( nx * nx + ny * ny + nz * nz );
+         // the length is zero for centers on the surface of the box (these pairs are handled by the analytic function)
+         const double4_t ilen = one / blendv( len, one, compareEQ( len, zero ) );
+
+         store_aligned( &b.dist[i], len - load_aligned( b.column( SB_R, i ) ) );
+         store_aligned( &b.nx[i], nx * ilen );
+         store_aligned( &b.ny[i], ny * ilen );
+         store_aligned( &b.nz[i], nz * ilen );
+         store_aligned( &b.px[i], load_aligned( b.column( SB_X, i ) ) + qx );
+         store_aligned( &b.py[i], load_aligned( b.column( SB_Y, i ) ) + qy );
+         store_aligned( &b.pz[i], load_aligned( b.column( SB_Z, i ) ) + qz );
+
+         for (size_t j = 0; j < 4; ++j)
+            b.fallback[i + j] = char( ( inside >> j ) & 1 );
+      }
+   }
+
+   /// mask of the coordinates with -l <= p <= l
+   static simd::double4_t inRange( const simd::double4_t p, const simd::double4_t l )
+   {
+      return simd::logicalAND( simd::compareGE( p, simd::make_zero() - l ), simd::compareLE( p, l ) );
+   }
+
+   /// projection of the coordinates onto [-l,l]
+   static simd::double4_t clamp( const simd::double4_t p, const simd::double4_t l )
+   {
+      const simd::double4_t ml = simd::make_zero() - l;
+      const simd::double4_t c  = simd::blendv( p, ml, simd::compareLE( p, ml ) );
+      return simd::blendv( c, l, simd::compareGE( c, l ) );
+   }
+
+   /// counts the contacts found by the kernels and the pairs that are handled by the analytic functions
+   size_t countContacts( const Batch& batch )
+   {
+      size_t contacts = 0;
+      for (size_t i = 0; i < batch.index.size(); ++i)
+      {
+         if (batch.fallback[i] || batch.dist[i] < double( contactThreshold ))
+            ++contacts;
+         else
+            ++rejected_;
+      }
+      return contacts;
+   }
+
+   /// writes the contact computed for slot \a i of \a batch, if any
+   void addContact( const Batch& batch, const size_t i, BodyID s, BodyID bd )
+   {
+      if (!( batch.dist[i] < double( contactThreshold ) ))
+         return;
+
+      const Vec3 point ( real_c( batch.px[i] ), real_c( batch.py[i] ), real_c( batch.pz[i] ) );
+      const Vec3 normal( real_c( batch.nx[i] ), real_c( batch.ny[i] ), real_c( batch.nz[i] ) );
+
+      WALBERLA_LOG_DETAIL( "      Contact created between body " << s->getSystemID()
+             << " and body " << bd->getSystemID() << " (dist=" << batch.dist[i] << ")" );
+      contacts_.push_back( Contact( static_cast<GeomID>(s), static_cast<GeomID>(bd), point, normal, real_c( batch.dist[i] ) ) );
+   }
+
+   std::vector<PairType> pairType_;
+   std::vector<size_t>   slot_;       ///< index of the pair in its batch
+   size_t                unbatched_;
+   size_t                rejected_;
+
+   Batch sphereSphere_{ SS_COLUMNS };
+   Batch spherePlane_ { SP_COLUMNS };
+   Batch sphereBox_   { SB_COLUMNS };
+};
+
+template <typename BodyTypeTuple>
+shared_ptr< blockforest::AlwaysCreateBlockDataHandling<BatchedFCD<BodyTypeTuple> > > createBatchedFCDDataHandling()
+{
+   return make_shared< blockforest::AlwaysCreateBlockDataHandling<BatchedFCD<BodyTypeTuple> > >( );
+}
+
+}
+}
+}
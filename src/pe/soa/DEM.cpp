@@ -0,0 +1,240 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file DEM.cpp
+//
+//======================================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "DEM.h"
+
+#include "pe/Materials.h"
+#include "pe/Thresholds.h"
+#include "pe/rigidbody/BodyStorage.h"
+#include "pe/rigidbody/Plane.h"
+
+#include "core/debug/Debug.h"
+#include "core/logging/all.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+DEM::DEM( const shared_ptr<SphereStorage>& spheres, WcTimingTree* tt )
+   : spheres_( spheres )
+   , tt_( tt )
+   , maxPenetration_( 0 )
+   , numberOfContacts_( 0 )
+{
+   WALBERLA_ASSERT_NOT_NULLPTR( spheres_ );
+}
+
+void DEM::addPlane( const Vec3& normal, const real_t displacement, const MaterialID material )
+{
+   WALBERLA_ASSERT_FLOAT_EQUAL( normal.sqrLength(), real_t(1), "Plane normal is not normalized" );
+
+   planeNormal_.push_back( normal );
+   planeDisplacement_.push_back( displacement );
+   planeMaterial_.push_back( material );
+}
+
+size_t DEM::addPlanes( const BodyStorage& bodies )
+{
+   size_t count( 0 );
+   for( auto it = bodies.begin(); it != bodies.end(); ++it )
+   {
+      if( it->getTypeID() != Plane::getStaticTypeID() )
+         continue;
+
+      ConstPlaneID p = static_cast< ConstPlaneID >( *it );
+      addPlane( p->getNormal(), p->getDisplacement(), p->getMaterial() );
+      ++count;
+   }
+   return count;
+}
+
+void DEM::timestep( const real_t dt )
+{
+   maxPenetration_   = real_c(0.0);
+   numberOfContacts_ = 0;
+
+   SphereStorage& spheres = *spheres_;
+   const size_t n = spheres.size();
+
+   const SphereStorage::Array& x      = spheres.position( 0 );
+   const SphereStorage::Array& y      = spheres.position( 1 );
+   const SphereStorage::Array& z      = spheres.position( 2 );
+   const SphereStorage::Array& radius = spheres.radius();
+
+   if (tt_ != NULL) tt_->start("CCD");
+   hashGrid_.generatePossibleContacts( spheres );
+   if (tt_ != NULL) tt_->stop("CCD");
+
+   if (tt_ != NULL) tt_->start("FCD");
+
+   // sphere-sphere contacts (see fcd::collide( SphereID, SphereID, ... ))
+   const std::vector<size_t>& first  = hashGrid_.getFirst();
+   const std::vector<size_t>& second = hashGrid_.getSecond();
+   for( size_t c = 0; c < first.size(); ++c )
+   {
+      const size_t i = first[c];
+      const size_t j = second[c];
+
+      Vec3 contactNormal( x[i] - x[j], y[i] - y[j], z[i] - z[j] );
+      const real_t penetrationDepth = contactNormal.length() - radius[i] - radius[j];
+
+      if( penetrationDepth < contactThreshold )
+      {
+         normalize( contactNormal );
+         const real_t k( radius[j] + real_c(0.5) * penetrationDepth );
+         const Vec3 contactPoint( Vec3( x[j], y[j], z[j] ) + contactNormal * k );
+
+         resolveContact( i, j, spheres.material()[j], contactPoint, contactNormal, penetrationDepth );
+      }
+   }
+
+   // sphere-plane contacts (see fcd::collide( SphereID, PlaneID, ... ))
+   for( size_t p = 0; p < planeMaterial_.size(); ++p )
+   {
+      const Vec3&  normal       = planeNormal_[p];
+      const real_t displacement = planeDisplacement_[p];
+
+      for( size_t i = 0; i < n; ++i )
+      {
+         const real_t penetrationDepth = normal[0] * x[i] + normal[1] * y[i] + normal[2] * z[i] - radius[i] - displacement;
+
+         if( penetrationDepth < contactThreshold )
+         {
+            const Vec3 contactPoint( Vec3( x[i], y[i], z[i] ) - ( radius[i] + penetrationDepth ) * normal );
+            resolveContact( i, n, planeMaterial_[p], contactPoint, normal, penetrationDepth );
+         }
+      }
+   }
+
+   if (tt_ != NULL) tt_->stop("FCD");
+
+   if (tt_ != NULL) tt_->start("Integration");
+   integrate( dt );
+   if (tt_ != NULL) tt_->stop("Integration");
+
+   spheres.resetForceAndTorque();
+}
+
+/// Linear spring-dashpot model with tangential forces according to Haff and Werner, see
+/// cr::ResolveContactSpringDashpotHaffWerner. \a b2 is the index of the second sphere, or
+/// spheres_->size() if the second body is a static plane.
+void DEM::resolveContact( const size_t b1, const size_t b2, const MaterialID material2,
+                          const Vec3& gpos, const Vec3& normal, const real_t dist )
+{
+   SphereStorage& spheres = *spheres_;
+   const bool isSphere2 = b2 < spheres.size();
+   const MaterialID material1 = spheres.material()[b1];
+
+   const real_t overlap( -dist );
+   if( overlap > maxPenetration_ )
+      maxPenetration_ = overlap;
+   ++numberOfContacts_;
+
+   // Relative velocity of the two bodies at the contact point
+   const Vec3 rvel( isSphere2 ? Vec3( spheres.velFromWF( b1, gpos ) - spheres.velFromWF( b2, gpos ) ) : spheres.velFromWF( b1, gpos ) );
+
+   // The absolute value of the penetration length
+   const real_t delta( -dist );
+
+   // Calculating the relative velocity in normal and tangential direction
+   const real_t relVelN( -( normal * rvel ) );
+   const Vec3   relVel ( -rvel );
+   const Vec3   relVelT( relVel - ( relVelN * normal ) );
+
+   // Calculating the normal force based on a linear spring-dashpot force model
+   real_t fNabs = Material::getStiffness( material1, material2 ) * delta + Material::getDampingN( material1, material2 ) * relVelN;
+   if( fNabs < real_c(0) ) fNabs = real_c(0);
+   const Vec3 fN( fNabs * normal );
+
+   // Coefficient of friction (see getFriction( ConstContactID ))
+   const real_t nvel( normal * rvel );
+   const real_t tvel( normal * ( rvel - normal * nvel ) );
+   const real_t friction( ( std::fabs( tvel ) > frictionThreshold ) ? Material::getDynamicFriction( material1, material2 )
+                                                                      : Material::getStaticFriction( material1, material2 ) );
+
+   // Calculating the tangential force based on the model by Haff and Werner
+   const real_t fTabs( std::min( Material::getDampingT( material1, material2 ) * relVelT.length(), friction * fNabs ) );
+   const Vec3   fT   ( fTabs * relVelT.getNormalizedOrZero() );
+
+   spheres.addForceAtPos( b1, fN + fT, gpos );
+   if( isSphere2 )
+      spheres.addForceAtPos( b2, -( fN + fT ), gpos );
+}
+
+/// Implicit Euler method, see cr::IntegrateImplictEuler.
+void DEM::integrate( const real_t dt )
+{
+   SphereStorage& spheres = *spheres_;
+   const size_t n = spheres.size();
+
+   const real_t* const invMass    = spheres.invMass().empty()    ? NULL : &( spheres.invMass()[0] );
+   const real_t* const invInertia = spheres.invInertia().empty() ? NULL : &( spheres.invInertia()[0] );
+   const Vec3& acceleration = getGlobalLinearAcceleration();
+
+   // translation and angular velocity: one pass per component, spheres with infinite mass are masked out
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      real_t* const       pos   = n == 0 ? NULL : &( spheres.position( d )[0] );
+      real_t* const       v     = n == 0 ? NULL : &( spheres.linearVel( d )[0] );
+      real_t* const       w     = n == 0 ? NULL : &( spheres.angularVel( d )[0] );
+      const real_t* const f     = n == 0 ? NULL : &( spheres.force( d )[0] );
+      const real_t* const t     = n == 0 ? NULL : &( spheres.torque( d )[0] );
+      const real_t        accel = acceleration[d];
+
+      for( size_t i = 0; i < n; ++i )
+      {
+         const real_t active = ( invMass[i] > real_t(0) ) ? real_t(1) : real_t(0);
+
+         // linear acceleration: force * m^(-1) + gravity
+         const real_t vdot = f[i] * invMass[i] + accel;
+         // angular acceleration: R * Iinv * R^T * torque = Iinv * torque for a sphere
+         const real_t wdot = invInertia[i] * t[i];
+
+         v[i]   += active * vdot * dt;
+         w[i]   += active * wdot * dt;
+         pos[i] += active * v[i] * dt;
+      }
+   }
+
+   // rotation
+   for( size_t i = 0; i < n; ++i )
+   {
+      if( invMass[i] <= real_t(0) )
+         continue;
+
+      // Calculating the rotation angle
+      const Vec3 phi( spheres.getAngularVel( i ) * dt );
+
+      // Calculating the new orientation
+      if( !floatIsEqual( phi.length(), real_t(0) ) )
+         spheres.setOrientation( i, Quat( phi, phi.length() ) * spheres.getQuaternion( i ) );
+   }
+}
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
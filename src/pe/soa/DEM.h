@@ -0,0 +1,104 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file DEM.h
+//! \brief DEM solver for spheres stored in a SphereStorage
+//
+//======================================================================================================================
+
+#pragma once
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "HashGrid.h"
+#include "SphereStorage.h"
+
+#include "pe/cr/ICR.h"
+#include "pe/Types.h"
+
+#include "core/DataTypes.h"
+#include "core/timing/TimingTree.h"
+
+#include <vector>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+//*************************************************************************************************
+/*!\brief DEM solver for spheres stored in a SphereStorage.
+ *
+ * Structure-of-arrays counterpart of cr::DEM (with ccd::HashGrids, the analytic sphere-sphere and
+ * sphere-plane collision functions, cr::ResolveContactSpringDashpotHaffWerner and
+ * cr::IntegrateImplictEuler). A time step consists of:
+ *  - the coarse collision detection with a HashGrid,
+ *  - the fine collision detection of the possible contacts, directly followed by the evaluation of
+ *    the spring-dashpot contact model (no contact objects are created, the forces and torques are
+ *    accumulated in the arrays of the SphereStorage),
+ *  - the contacts with static planes (e.g. the domain walls),
+ *  - the time integration with the implicit Euler method, which streams through the arrays,
+ *  - resetting the forces and torques.
+ *
+ * The solver works on the spheres of a single SphereStorage. There is no synchronization between
+ * processes, hence the spheres have to be distributed by the application (e.g. one storage per
+ * process for a process-local simulation). Spheres with infinite mass are not moved.
+ */
+class DEM : public cr::ICR
+{
+public:
+   DEM( const shared_ptr<SphereStorage>& spheres, WcTimingTree* tt = NULL );
+
+   /// Adds a static plane with the given (normalized) normal and displacement from the origin.
+   void   addPlane( const Vec3& normal, const real_t displacement, const MaterialID material );
+   /// Adds all planes of \a bodies (usually the global body storage) as static planes.
+   size_t addPlanes( const BodyStorage& bodies );
+   inline size_t getNumberOfPlanes() const { return planeMaterial_.size(); }
+
+   /// forwards to timestep
+   /// Convenience operator to make class a functor.
+   void operator()(const real_t dt) { timestep(dt); }
+   /// Advances the simulation dt seconds.
+   virtual void timestep( const real_t dt ) WALBERLA_OVERRIDE;
+
+   virtual inline real_t            getMaximumPenetration()        const WALBERLA_OVERRIDE { return maxPenetration_; }
+   virtual inline size_t            getNumberOfContacts()          const WALBERLA_OVERRIDE { return numberOfContacts_; }
+   virtual inline size_t            getNumberOfContactsTreated()   const WALBERLA_OVERRIDE { return numberOfContacts_; }
+
+   inline const HashGrid& getHashGrid() const { return hashGrid_; }
+
+private:
+   void resolveContact( const size_t b1, const size_t b2, const MaterialID material2,
+                        const Vec3& gpos, const Vec3& normal, const real_t dist );
+   void integrate( const real_t dt );
+
+   shared_ptr<SphereStorage> spheres_;
+   HashGrid                  hashGrid_;
+   WcTimingTree*             tt_;
+
+   std::vector<Vec3>         planeNormal_;
+   std::vector<real_t>       planeDisplacement_;
+   std::vector<MaterialID>   planeMaterial_;
+
+   real_t                    maxPenetration_;
+   size_t                    numberOfContacts_;
+};
+//*************************************************************************************************
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
@@ -0,0 +1,178 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file HashGrid.cpp
+//
+//======================================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "HashGrid.h"
+
+#include "pe/Thresholds.h"
+
+#include <algorithm>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+HashGrid::HashGrid() : cellSize_( real_t(0) )
+{
+   cells_[0] = cells_[1] = cells_[2] = size_t(0);
+}
+
+void HashGrid::clear()
+{
+   cellSize_ = real_t(0);
+   cells_[0] = cells_[1] = cells_[2] = size_t(0);
+   cellOfSphere_.clear();
+   cellStart_.clear();
+   sorted_.clear();
+}
+
+void HashGrid::generatePossibleContacts( const SphereStorage& spheres )
+{
+   first_.clear();
+   second_.clear();
+
+   const size_t n = spheres.size();
+   if( n < size_t(2) )
+   {
+      clear();
+      return;
+   }
+
+   // bounding box of all sphere centers and largest radius
+
+   real_t minCorner[3];
+   real_t extent[3];
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      const SphereStorage::Array& pos = spheres.position( d );
+      real_t lower = pos[0];
+      real_t upper = pos[0];
+      for( size_t i = 1; i < n; ++i )
+      {
+         lower = std::min( lower, pos[i] );
+         upper = std::max( upper, pos[i] );
+      }
+      minCorner[d] = lower;
+      extent[d]    = upper - lower;
+   }
+
+   const SphereStorage::Array& radius = spheres.radius();
+   const real_t maxRadius = *std::max_element( radius.begin(), radius.end() );
+
+   // cell size: at least one sphere diameter, enlarged if the grid would be much larger than the number of spheres
+
+   cellSize_ = real_t(2) * ( maxRadius + contactThreshold );
+   const real_t maxCells = real_c( 8 * n + 64 );
+   for( ;; )
+   {
+      real_t totalCells( real_t(1) );
+      for( uint_t d = 0; d < 3; ++d )
+         totalCells *= std::floor( extent[d] / cellSize_ ) + real_t(1);
+      if( totalCells <= maxCells )
+         break;
+      cellSize_ *= real_t(2);
+   }
+
+   for( uint_t d = 0; d < 3; ++d )
+      cells_[d] = static_cast< size_t >( extent[d] / cellSize_ ) + size_t(1);
+
+   const size_t numberOfCells = cells_[0] * cells_[1] * cells_[2];
+   const real_t inverseCellSize = real_t(1) / cellSize_;
+
+   // counting sort of the spheres into the cells
+
+   cellOfSphere_.resize( n );
+   for( size_t i = 0; i < n; ++i )
+   {
+      size_t c[3];
+      for( uint_t d = 0; d < 3; ++d )
+         c[d] = std::min( static_cast< size_t >( ( spheres.position( d )[i] - minCorner[d] ) * inverseCellSize ), cells_[d] - size_t(1) );
+      cellOfSphere_[i] = ( c[2] * cells_[1] + c[1] ) * cells_[0] + c[0];
+   }
+
+   cellStart_.assign( numberOfCells + size_t(1), size_t(0) );
+   for( size_t i = 0; i < n; ++i )
+      ++cellStart_[ cellOfSphere_[i] + size_t(1) ];
+   for( size_t c = 0; c < numberOfCells; ++c )
+      cellStart_[c + size_t(1)] += cellStart_[c];
+
+   sorted_.resize( n );
+   std::vector<size_t> fill( cellStart_.begin(), cellStart_.end() - 1 );
+   for( size_t i = 0; i < n; ++i )
+      sorted_[ fill[ cellOfSphere_[i] ]++ ] = i;
+
+   // pairs within a cell and with the 13 "forward" neighbor cells -> every pair of cells is visited once
+
+   for( size_t z = 0; z < cells_[2]; ++z ) {
+      for( size_t y = 0; y < cells_[1]; ++y ) {
+         for( size_t x = 0; x < cells_[0]; ++x )
+         {
+            const size_t cell  = ( z * cells_[1] + y ) * cells_[0] + x;
+            const size_t begin = cellStart_[cell];
+            const size_t end   = cellStart_[cell + size_t(1)];
+            if( begin == end )
+               continue;
+
+            for( size_t i = begin; i < end; ++i )
+            {
+               for( size_t j = i + size_t(1); j < end; ++j )
+               {
+                  first_.push_back( sorted_[i] );
+                  second_.push_back( sorted_[j] );
+               }
+            }
+
+            for( int dz = 0; dz <= 1; ++dz ) {
+               for( int dy = ( dz == 0 ? 0 : -1 ); dy <= 1; ++dy ) {
+                  for( int dx = ( dz == 0 && dy == 0 ? 1 : -1 ); dx <= 1; ++dx )
+                  {
+                     const size_t nx = x + size_t( dx + 1 );
+                     const size_t ny = y + size_t( dy + 1 );
+                     const size_t nz = z + size_t( dz + 1 );
+                     // neighbor coordinates are shifted by one in order to avoid negative values
+                     if( nx == size_t(0) || nx > cells_[0] || ny == size_t(0) || ny > cells_[1] || nz == size_t(0) || nz > cells_[2] )
+                        continue;
+
+                     const size_t neighbor      = ( ( nz - size_t(1) ) * cells_[1] + ( ny - size_t(1) ) ) * cells_[0] + ( nx - size_t(1) );
+                     const size_t neighborBegin = cellStart_[neighbor];
+                     const size_t neighborEnd   = cellStart_[neighbor + size_t(1)];
+
+                     for( size_t i = begin; i < end; ++i )
+                     {
+                        for( size_t j = neighborBegin; j < neighborEnd; ++j )
+                        {
+                           first_.push_back( sorted_[i] );
+                           second_.push_back( sorted_[j] );
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
@@ -0,0 +1,91 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file HashGrid.h
+//! \brief Uniform grid coarse collision detection for a SphereStorage
+//
+//======================================================================================================================
+
+#pragma once
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "SphereStorage.h"
+
+#include "core/DataTypes.h"
+
+#include <vector>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+//*************************************************************************************************
+/*!\brief Coarse collision detection for the spheres of a SphereStorage.
+ *
+ * Counterpart of ccd::HashGrids for the structure-of-arrays storage: Since all bodies are spheres
+ * of similar size, a single uniform grid is used instead of a hierarchy of grids. The edge length
+ * of a cell is at least the largest sphere diameter (plus twice the contact threshold), hence
+ * spheres can only be in contact with spheres of the same or one of the 26 neighboring cells.
+ *
+ * The grid is rebuilt from scratch in every call of generatePossibleContacts(): the spheres are
+ * sorted into the cells with a counting sort, which only needs two linear passes over the
+ * position arrays. Each pair of neighboring cells is visited once (half stencil), so every pair
+ * of spheres is reported at most once. The possible contacts are returned as two index arrays
+ * into the SphereStorage.
+ *
+ * The grid only spans the bounding box of the current sphere positions. If the spheres are
+ * spread out sparsely, the cells are enlarged so that the number of cells does not exceed a
+ * small multiple of the number of spheres.
+ */
+class HashGrid
+{
+public:
+   HashGrid();
+
+   /// Sorts the spheres into the grid and generates all pairs of spheres in neighboring cells.
+   void generatePossibleContacts( const SphereStorage& spheres );
+
+   /// \name Possible contacts of the last call of generatePossibleContacts()
+   /// \{
+   inline size_t                     getNumberOfPossibleContacts() const { return first_.size(); }
+   inline const std::vector<size_t>& getFirst()  const { return first_; }
+   inline const std::vector<size_t>& getSecond() const { return second_; }
+   /// \}
+
+   inline real_t getCellSize() const { return cellSize_; }
+   inline size_t getNumberOfCells() const { return cellStart_.empty() ? size_t(0) : cellStart_.size() - size_t(1); }
+
+private:
+   void clear();
+
+   real_t cellSize_;
+   size_t cells_[3];
+
+   std::vector<size_t> cellOfSphere_;
+   std::vector<size_t> cellStart_;   ///< index of the first sphere of each cell in sorted_ (+ one past the end entry)
+   std::vector<size_t> sorted_;      ///< sphere indices sorted by cell
+
+   std::vector<size_t> first_;
+   std::vector<size_t> second_;
+};
+//*************************************************************************************************
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
@@ -0,0 +1,204 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SphereStorage.cpp
+//
+//======================================================================================================================
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "SphereStorage.h"
+
+#include "pe/Materials.h"
+#include "pe/rigidbody/BodyStorage.h"
+#include "pe/rigidbody/Sphere.h"
+
+#include "core/Abort.h"
+
+#include <algorithm>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+void SphereStorage::reserve( const size_t n )
+{
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      position_[d].reserve( n );
+      linearVel_[d].reserve( n );
+      angularVel_[d].reserve( n );
+      force_[d].reserve( n );
+      torque_[d].reserve( n );
+   }
+   for( uint_t d = 0; d < 4; ++d )
+      orientation_[d].reserve( n );
+
+   radius_.reserve( n );
+   invMass_.reserve( n );
+   invInertia_.reserve( n );
+   material_.reserve( n );
+   systemID_.reserve( n );
+}
+
+void SphereStorage::clear()
+{
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      position_[d].clear();
+      linearVel_[d].clear();
+      angularVel_[d].clear();
+      force_[d].clear();
+      torque_[d].clear();
+   }
+   for( uint_t d = 0; d < 4; ++d )
+      orientation_[d].clear();
+
+   radius_.clear();
+   invMass_.clear();
+   invInertia_.clear();
+   material_.clear();
+   systemID_.clear();
+   index_.clear();
+}
+
+size_t SphereStorage::add( const id_t sid, const Vec3& pos, const real_t radius, const MaterialID material,
+                           const Vec3& linearVel, const Vec3& angularVel, const Quat& q, const bool infiniteMass )
+{
+   WALBERLA_ASSERT_GREATER( radius, real_t(0), "Invalid sphere radius" );
+
+   const size_t idx = size();
+   if( !index_.insert( std::make_pair( sid, idx ) ).second )
+      WALBERLA_ABORT( "Sphere with system id " << sid << " is already part of the sphere storage!" );
+
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      position_[d].push_back( pos[d] );
+      linearVel_[d].push_back( linearVel[d] );
+      angularVel_[d].push_back( angularVel[d] );
+      force_[d].push_back( real_t(0) );
+      torque_[d].push_back( real_t(0) );
+   }
+   for( uint_t d = 0; d < 4; ++d )
+      orientation_[d].push_back( q[d] );
+
+   radius_.push_back( radius );
+   if( infiniteMass )
+   {
+      invMass_.push_back( real_t(0) );
+      invInertia_.push_back( real_t(0) );
+   }
+   else
+   {
+      const real_t mass = Sphere::calcMass( radius, Material::getDensity( material ) );
+      invMass_.push_back( real_t(1) / mass );
+      invInertia_.push_back( real_t(1) / ( real_c(0.4) * mass * radius * radius ) );
+   }
+   material_.push_back( material );
+   systemID_.push_back( sid );
+
+   return idx;
+}
+
+void SphereStorage::remove( const size_t idx )
+{
+   WALBERLA_ASSERT_LESS( idx, size() );
+
+   const size_t last = size() - 1;
+
+   index_.erase( systemID_[idx] );
+   if( idx != last )
+      index_[ systemID_[last] ] = idx;
+
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      position_[d][idx]   = position_[d][last];   position_[d].pop_back();
+      linearVel_[d][idx]  = linearVel_[d][last];  linearVel_[d].pop_back();
+      angularVel_[d][idx] = angularVel_[d][last]; angularVel_[d].pop_back();
+      force_[d][idx]      = force_[d][last];      force_[d].pop_back();
+      torque_[d][idx]     = torque_[d][last];     torque_[d].pop_back();
+   }
+   for( uint_t d = 0; d < 4; ++d )
+   {
+      orientation_[d][idx] = orientation_[d][last]; orientation_[d].pop_back();
+   }
+
+   radius_[idx]     = radius_[last];     radius_.pop_back();
+   invMass_[idx]    = invMass_[last];    invMass_.pop_back();
+   invInertia_[idx] = invInertia_[last]; invInertia_.pop_back();
+   material_[idx]   = material_[last];   material_.pop_back();
+   systemID_[idx]   = systemID_[last];   systemID_.pop_back();
+}
+
+size_t SphereStorage::find( const id_t sid ) const
+{
+   auto it = index_.find( sid );
+   return ( it == index_.end() ) ? size() : it->second;
+}
+
+void SphereStorage::resetForceAndTorque()
+{
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      std::fill( force_[d].begin(),  force_[d].end(),  real_t(0) );
+      std::fill( torque_[d].begin(), torque_[d].end(), real_t(0) );
+   }
+}
+
+
+
+size_t addSpheres( SphereStorage& spheres, const BodyStorage& bodies )
+{
+   size_t count( 0 );
+   for( auto it = bodies.begin(); it != bodies.end(); ++it )
+   {
+      if( it->getTypeID() != Sphere::getStaticTypeID() )
+         continue;
+
+      ConstSphereID s = static_cast< ConstSphereID >( *it );
+      const size_t idx = spheres.add( s->getSystemID(), s->getPosition(), s->getRadius(), s->getMaterial(),
+                                      s->getLinearVel(), s->getAngularVel(), s->getQuaternion(), s->hasInfiniteMass() );
+      // take over the mass properties of the body (which might have been set explicitly)
+      spheres.setInvMassAndInertia( idx, s->getInvMass(), s->getInvBodyInertia()[0] );
+      ++count;
+   }
+   return count;
+}
+
+size_t updateBodyStorage( const SphereStorage& spheres, BodyStorage& bodies )
+{
+   size_t count( 0 );
+   for( size_t i = 0; i < spheres.size(); ++i )
+   {
+      auto it = bodies.find( spheres.systemID()[i] );
+      if( it == bodies.end() )
+         continue;
+
+      BodyID b = *it;
+      b->setPosition( spheres.getPosition( i ) );
+      b->setOrientation( spheres.getQuaternion( i ) );
+      b->setLinearVel( spheres.getLinearVel( i ) );
+      b->setAngularVel( spheres.getAngularVel( i ) );
+      ++count;
+   }
+   return count;
+}
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
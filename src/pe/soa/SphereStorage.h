@@ -0,0 +1,222 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SphereStorage.h
+//! \brief Structure-of-arrays storage for spheres
+//
+//======================================================================================================================
+
+#pragma once
+
+
+//*************************************************************************************************
+// Includes
+//*************************************************************************************************
+
+#include "pe/Types.h"
+
+#include "core/DataTypes.h"
+#include "core/debug/Debug.h"
+#include "core/math/Quaternion.h"
+#include "core/math/Vector3.h"
+
+#include <map>
+#include <vector>
+
+namespace walberla {
+namespace pe {
+namespace soa {
+
+//*************************************************************************************************
+/*!\brief Structure-of-arrays storage for spheres.
+ *
+ * The BodyStorage keeps pointers to heap allocated, polymorphic rigid bodies. Every loop over the
+ * bodies therefore chases a pointer and pulls the complete RigidBody object into the cache, even
+ * if only the position and the velocity are needed. The SphereStorage stores the state of
+ * spheres component-wise in contiguous arrays instead: the x-components of all positions are
+ * stored one after another, followed (in a separate array) by all y-components, and so on.
+ * Loops over all spheres that only need a few of these arrays stream through memory and can be
+ * vectorized by the compiler.
+ *
+ * The index of a sphere within the storage is not stable: removing a sphere moves the last sphere
+ * into the gap. Spheres are identified permanently by their system ID (see find()).
+ *
+ * Spheres with infinite mass (e.g. fixed spheres) are stored with an inverse mass and an inverse
+ * moment of inertia of zero.
+ *
+ * The SphereStorage only holds the spheres of one process/block and does not take part in the
+ * synchronization of the pe. Use addSpheres() and updateBodyStorage() to exchange the state with
+ * a BodyStorage.
+ */
+class SphereStorage
+{
+public:
+   typedef std::vector<real_t> Array;
+
+   inline size_t size()  const { return systemID_.size(); }
+   inline bool   empty() const { return systemID_.empty(); }
+
+   void reserve( const size_t n );
+   void clear();
+
+   size_t add( const id_t sid, const Vec3& pos, const real_t radius, const MaterialID material,
+               const Vec3& linearVel = Vec3(), const Vec3& angularVel = Vec3(), const Quat& q = Quat(),
+               const bool infiniteMass = false );
+   void   remove( const size_t idx );
+
+   /// Returns the index of the sphere with the given system ID or size() if there is no such sphere.
+   size_t find( const id_t sid ) const;
+
+   /// \name Component arrays
+   /// \{
+   inline       Array& position  ( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 3 ); return position_[d]; }
+   inline const Array& position  ( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 3 ); return position_[d]; }
+   inline       Array& linearVel ( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 3 ); return linearVel_[d]; }
+   inline const Array& linearVel ( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 3 ); return linearVel_[d]; }
+   inline       Array& angularVel( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 3 ); return angularVel_[d]; }
+   inline const Array& angularVel( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 3 ); return angularVel_[d]; }
+   inline       Array& force     ( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 3 ); return force_[d]; }
+   inline const Array& force     ( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 3 ); return force_[d]; }
+   inline       Array& torque    ( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 3 ); return torque_[d]; }
+   inline const Array& torque    ( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 3 ); return torque_[d]; }
+   /// components r, i, j, k of the orientation quaternion
+   inline       Array& orientation( const uint_t d )       { WALBERLA_ASSERT_LESS( d, 4 ); return orientation_[d]; }
+   inline const Array& orientation( const uint_t d ) const { WALBERLA_ASSERT_LESS( d, 4 ); return orientation_[d]; }
+
+   inline const Array&                   radius()     const { return radius_; }
+   inline const Array&                   invMass()    const { return invMass_; }
+   inline const Array&                   invInertia() const { return invInertia_; }
+   inline const std::vector<MaterialID>& material()   const { return material_; }
+   inline const std::vector<id_t>&       systemID()   const { return systemID_; }
+   /// \}
+
+   /// \name Access to single spheres
+   /// \{
+   inline Vec3 getPosition   ( const size_t idx ) const { return get( position_, idx ); }
+   inline Vec3 getLinearVel  ( const size_t idx ) const { return get( linearVel_, idx ); }
+   inline Vec3 getAngularVel ( const size_t idx ) const { return get( angularVel_, idx ); }
+   inline Vec3 getForce      ( const size_t idx ) const { return get( force_, idx ); }
+   inline Vec3 getTorque     ( const size_t idx ) const { return get( torque_, idx ); }
+   inline Quat getQuaternion ( const size_t idx ) const;
+
+   inline void setPosition   ( const size_t idx, const Vec3& v ) { set( position_, idx, v ); }
+   inline void setLinearVel  ( const size_t idx, const Vec3& v ) { set( linearVel_, idx, v ); }
+   inline void setAngularVel ( const size_t idx, const Vec3& v ) { set( angularVel_, idx, v ); }
+   inline void setOrientation( const size_t idx, const Quat& q );
+
+   inline bool hasInfiniteMass( const size_t idx ) const { WALBERLA_ASSERT_LESS( idx, size() ); return invMass_[idx] <= real_t(0); }
+   /// Overrides the mass properties calculated from radius and density by add().
+   inline void setInvMassAndInertia( const size_t idx, const real_t invMass, const real_t invInertia );
+
+   /// Velocity of the point \a gpos (in world frame) which is rigidly attached to sphere \a idx.
+   inline Vec3 velFromWF( const size_t idx, const Vec3& gpos ) const;
+   inline void addForceAtPos( const size_t idx, const Vec3& f, const Vec3& gpos );
+   /// \}
+
+   void resetForceAndTorque();
+
+private:
+   static inline Vec3 get( const Array (&a)[3], const size_t idx );
+   static inline void set( Array (&a)[3], const size_t idx, const Vec3& v );
+
+   Array position_[3];
+   Array linearVel_[3];
+   Array angularVel_[3];
+   Array force_[3];
+   Array torque_[3];
+   Array orientation_[4];
+
+   Array radius_;
+   Array invMass_;
+   Array invInertia_;   ///< inverse moment of inertia (identical for all axes of a sphere)
+
+   std::vector<MaterialID> material_;
+   std::vector<id_t>       systemID_;
+
+   std::map<id_t, size_t>  index_;    ///< system ID -> index in the arrays
+};
+//*************************************************************************************************
+
+
+
+inline Vec3 SphereStorage::get( const Array (&a)[3], const size_t idx )
+{
+   WALBERLA_ASSERT_LESS( idx, a[0].size() );
+   return Vec3( a[0][idx], a[1][idx], a[2][idx] );
+}
+
+inline void SphereStorage::set( Array (&a)[3], const size_t idx, const Vec3& v )
+{
+   WALBERLA_ASSERT_LESS( idx, a[0].size() );
+   a[0][idx] = v[0];
+   a[1][idx] = v[1];
+   a[2][idx] = v[2];
+}
+
+inline Quat SphereStorage::getQuaternion( const size_t idx ) const
+{
+   WALBERLA_ASSERT_LESS( idx, size() );
+   return Quat( orientation_[0][idx], orientation_[1][idx], orientation_[2][idx], orientation_[3][idx] );
+}
+
+inline void SphereStorage::setOrientation( const size_t idx, const Quat& q )
+{
+   WALBERLA_ASSERT_LESS( idx, size() );
+   for( uint_t d = 0; d < 4; ++d )
+      orientation_[d][idx] = q[d];
+}
+
+inline void SphereStorage::setInvMassAndInertia( const size_t idx, const real_t invMass, const real_t invInertia )
+{
+   WALBERLA_ASSERT_LESS( idx, size() );
+   invMass_[idx]    = invMass;
+   invInertia_[idx] = invInertia;
+}
+
+inline Vec3 SphereStorage::velFromWF( const size_t idx, const Vec3& gpos ) const
+{
+   return getLinearVel( idx ) + getAngularVel( idx ) % ( gpos - getPosition( idx ) );
+}
+
+inline void SphereStorage::addForceAtPos( const size_t idx, const Vec3& f, const Vec3& gpos )
+{
+   const Vec3 t( ( gpos - getPosition( idx ) ) % f );
+   for( uint_t d = 0; d < 3; ++d )
+   {
+      force_[d][idx]  += f[d];
+      torque_[d][idx] += t[d];
+   }
+}
+
+
+
+//*************************************************************************************************
+/*!\brief Appends all spheres of \a bodies to \a spheres.
+ *
+ * \return The number of spheres that were added. Bodies that are not spheres are skipped.
+ */
+size_t addSpheres( SphereStorage& spheres, const BodyStorage& bodies );
+
+/*!\brief Writes position, orientation and velocities of the spheres back to the corresponding
+ * bodies (identified by their system ID) of \a bodies.
+ *
+ * \return The number of bodies that were updated.
+ */
+size_t updateBodyStorage( const SphereStorage& spheres, BodyStorage& bodies );
+//*************************************************************************************************
+
+}  // namespace soa
+}  // namespace pe
+}  // namespace walberla
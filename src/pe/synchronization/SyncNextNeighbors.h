@@ -26,6 +26,7 @@
 #include "pe/communication/ParseMessage.h"
 #include "pe/communication/DynamicMarshalling.h"
 #include "pe/communication/RigidBodyCopyNotification.h"
+#include "pe/communication/RigidBodyDeltaUpdateNotification.h"
 #include "pe/communication/RigidBodyDeletionNotification.h"
 #include "pe/communication/RigidBodyForceNotification.h"
 #include "pe/communication/RigidBodyMigrationNotification.h"
@@ -42,11 +43,23 @@
 #include "core/mpi/BufferSystem.h"
 #include "core/timing/TimingTree.h"
 
+#include <limits>
+#include <map>
+#include <set>
+
 namespace walberla {
 namespace pe {
 
+/// state of the locally owned bodies that was sent to the shadow copies in the last synchronization
+typedef std::map< walberla::id_t, communication::RigidBodyDeltaUpdateNotification::State > SentBodyStates;
+
+/// Assembles the synchronization messages of \a block.
+/// If \a sentStates is given, shadow copies receive RigidBodyDeltaUpdateNotification%s containing only
+/// the fields that changed compared to \a lastSentStates instead of RigidBodyUpdateNotification%s.
+/// The state sent for each locally owned body with shadow copies is recorded in \a sentStates.
 template <typename BodyTypeTuple>
-void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, BodyStorage& localStorage, BodyStorage& shadowStorage, const real_t dx, const bool syncNonCommunicatingBodies)
+void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, BodyStorage& localStorage, BodyStorage& shadowStorage, const real_t dx, const bool syncNonCommunicatingBodies,
+                                    const SentBodyStates* lastSentStates = NULL, SentBodyStates* sentStates = NULL)
 {
    using namespace walberla::pe::communication;
 
@@ -95,6 +108,14 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
 
       WALBERLA_LOG_DETAIL( "Processing local body " << b->getSystemID() );
 
+      uint8_t changedFields( RigidBodyDeltaUpdateNotification::ALL );
+      if( lastSentStates != NULL )
+      {
+         auto lastState = lastSentStates->find( b->getSystemID() );
+         if( lastState != lastSentStates->end() )
+            changedFields = RigidBodyDeltaUpdateNotification::changedFields( *b, lastState->second );
+      }
+
       // Update (nearest) neighbor processes.
       for( uint_t nb = uint_t(0); nb < block.getNeighborhoodSize(); ++nb )
       {
@@ -106,9 +127,18 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
             if( body->MPITrait.isShadowOwnerRegistered( nbProcess ) ) {
                mpi::SendBuffer& buffer( bs.sendBuffer(nbProcess.rank_) );
 
-               WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
+               if( sentStates == NULL )
+               {
+                  WALBERLA_LOG_DETAIL( "Sending update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
 
-               packNotification(me, nbProcess, buffer, RigidBodyUpdateNotification( *b ));
+                  packNotification(me, nbProcess, buffer, RigidBodyUpdateNotification( *b ));
+               }
+               else if( changedFields != 0 )
+               {
+                  WALBERLA_LOG_DETAIL( "Sending delta update notification for body " << b->getSystemID() << " to process " << (nbProcess) );
+
+                  packNotification(me, nbProcess, buffer, RigidBodyDeltaUpdateNotification( *b, changedFields ));
+               }
             }
             else {
                mpi::SendBuffer& buffer( bs.sendBuffer(nbProcess.rank_) );
@@ -227,6 +257,9 @@ void generateSynchonizationMessages(mpi::BufferSystem& bs, const Block& block, B
       {
          // Body still is locally owned after position update.
          WALBERLA_LOG_DETAIL( "Owner of body " << b->getSystemID() << " is still process " << body->MPITrait.getOwner() );
+
+         if( sentStates != NULL && b->MPITrait.sizeShadowOwners() > 0 )
+            (*sentStates)[ b->getSystemID() ] = RigidBodyDeltaUpdateNotification::State( *b );
       }
 
       ++body;
@@ -293,5 +326,114 @@ void syncNextNeighbors( BlockForest& forest, BlockDataID storageID, WcTimingTree
    if (tt != NULL) tt->stop("Sync");
 }
 
+/// Next neighbor synchronization (see syncNextNeighbors()) with persistent communication channels
+/// that only sends the changed parts of the body states.
+///
+/// The buffer system and the set of neighbor processes are kept between the calls and are only
+/// set up again if the block forest changes. Shadow copies are updated with
+/// RigidBodyDeltaUpdateNotification%s: position, orientation, linear and angular velocity are only
+/// sent if they differ from the values sent in the previous call, and no notification at all is
+/// sent for bodies whose state did not change (e.g. resting bodies).
+///
+/// \attention The shadow copies keep their values for all fields that are not sent. Therefore, this
+///            synchronization requires that shadow copies are not modified in between the
+///            synchronizations. This holds e.g. for cr::DEM, but not for cr::HCSITS, which also
+///            integrates the shadow copies.
+template <typename BodyTypeTuple>
+class SyncNextNeighborsDelta
+{
+public:
+   explicit SyncNextNeighborsDelta( const int tag = 0 )
+      : bs_( mpi::MPIManager::instance()->comm(), tag )
+      , forestModificationStamp_( std::numeric_limits< uint_t >::max() )
+   {}
+
+   void operator()( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt = NULL, const real_t dx = real_t(0), const bool syncNonCommunicatingBodies = false );
+
+private:
+   void setupNeighbors( const BlockForest& forest );
+
+   mpi::BufferSystem        bs_;
+   std::set< mpi::MPIRank > neighborRanks_;
+   uint_t                   forestModificationStamp_;
+
+   SentBodyStates           lastSentStates_;
+   SentBodyStates           sentStates_;
+};
+
+template <typename BodyTypeTuple>
+void SyncNextNeighborsDelta<BodyTypeTuple>::setupNeighbors( const BlockForest& forest )
+{
+   neighborRanks_.clear();
+   for (auto it = forest.begin(); it != forest.end(); ++it)
+   {
+      const Block * block = dynamic_cast< const Block * >( &(*it) );
+      for( uint_t i = uint_t(0); i != block->getNeighborhoodSize(); ++i )
+         neighborRanks_.insert( int_c( block->getNeighborProcess(i) ) );
+   }
+
+   // the message sizes change in every step, the set of communication partners only with the forest
+   bs_.setReceiverInfo( neighborRanks_, true );
+
+   lastSentStates_.clear();
+   forestModificationStamp_ = forest.getModificationStamp();
+}
+
+template <typename BodyTypeTuple>
+void SyncNextNeighborsDelta<BodyTypeTuple>::operator()( BlockForest& forest, BlockDataID storageID, WcTimingTree* tt, const real_t dx, const bool syncNonCommunicatingBodies )
+{
+   if (tt != NULL) tt->start("Sync");
+   if (tt != NULL) tt->start("Assembling Body Synchronization");
+
+   if( forest.getModificationStamp() != forestModificationStamp_ )
+      setupNeighbors( forest );
+
+   for( auto rank = neighborRanks_.begin(); rank != neighborRanks_.end(); ++rank )
+   {
+      // every neighbor expects a message, the dummy byte forces its transmission
+      bs_.sendBuffer( *rank ) << walberla::uint8_c(0);
+   }
+
+   sentStates_.clear();
+   for (auto it = forest.begin(); it != forest.end(); ++it)
+   {
+      Block * block = dynamic_cast< Block * >( &(*it) );
+      Storage* storage  = block->getData< Storage >( storageID );
+      BodyStorage * localStorage  = &(*storage)[0];
+      BodyStorage * shadowStorage = &(*storage)[1];
+
+      generateSynchonizationMessages<BodyTypeTuple>(bs_, *block, *localStorage, *shadowStorage, dx, syncNonCommunicatingBodies, &lastSentStates_, &sentStates_);
+   }
+   std::swap( lastSentStates_, sentStates_ );
+   if (tt != NULL) tt->stop("Assembling Body Synchronization");
+
+   bs_.sendAll();
+
+   if (tt != NULL) tt->start("Parsing Body Synchronization");
+   WALBERLA_LOG_DETAIL( "Parsing of body synchronization response starts..." );
+   for( auto it = bs_.begin(); it != bs_.end(); ++it )
+   {
+      walberla::uint8_t tmp;
+      it.buffer() >> tmp;
+      while( !it.buffer().isEmpty() )
+      {
+         IBlockID::IDType sender;
+         IBlockID::IDType receiver;
+         it.buffer() >> sender;
+         it.buffer() >> receiver;
+         auto blk = forest.getBlock(receiver);
+         WALBERLA_CHECK(blk != NULL, receiver << " not on this process!");
+         IBlock& block = *blk;
+         Storage* storage  = block.getData< Storage >( storageID );
+         BodyStorage& localStorage  = (*storage)[0];
+         BodyStorage& shadowStorage = (*storage)[1];
+         pe::communication::parseMessage<BodyTypeTuple>(Owner(it.rank(), sender), it.buffer(), forest, block, localStorage, shadowStorage);
+      }
+   }
+   WALBERLA_LOG_DETAIL( "Parsing of body synchronization response ended." );
+   if (tt != NULL) tt->stop("Parsing Body Synchronization");
+   if (tt != NULL) tt->stop("Sync");
+}
+
 }  // namespace pe
 }  // namespace walberla
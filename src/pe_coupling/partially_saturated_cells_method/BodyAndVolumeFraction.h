@@ -0,0 +1,46 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BodyAndVolumeFraction.h
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/SmallVector.h"
+
+#include "field/GhostLayerField.h"
+
+#include "pe/Types.h"
+
+#include <utility>
+
+namespace walberla {
+namespace pe_coupling {
+
+/*!\brief Data types of the body and volume fraction field that is used by the PSM
+ *
+ * Each cell stores pairs of a pointer to a PE body and the solid volume fraction of this body in the cell.
+ * As only very few bodies intersect with a cell, the pairs are stored in a SmallVector: for up to two bodies per
+ * cell, no dynamic memory is allocated and the pairs are stored directly in the field.
+ */
+typedef std::pair< pe::BodyID, real_t >                       BodyAndVolumeFraction_T;
+typedef SmallVector< BodyAndVolumeFraction_T, 2 >             BodyAndVolumeFractionVector_T;
+typedef GhostLayerField< BodyAndVolumeFractionVector_T, 1 >   BodyAndVolumeFractionField_T;
+
+} // namespace pe_coupling
+} // namespace walberla
@@ -33,6 +33,11 @@
 #include "pe_coupling/geometry/PeOverlapFraction.h"
 #include "pe_coupling/mapping/BodyBBMapping.h"
 
+#include "BodyAndVolumeFraction.h"
+
+#include <limits>
+#include <map>
+
 namespace walberla {
 namespace pe_coupling {
 
@@ -42,15 +47,12 @@ namespace pe_coupling {
  * super sampling or an analytical formula is used.
  *
  * The information is stored as a pair of a pointer to a PE body and the corresponding solid volume fraction.
- * As several bodies could intersect with one cell, the pairs are stored in a vector with the size of the amount of intersecting bodies.
+ * As several bodies could intersect with one cell, the pairs are stored in a (small) vector with the size of the amount of intersecting bodies.
  *
  */
-void mapPSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block, const shared_ptr<StructuredBlockStorage> & blockStorage,
-                                  const BlockDataID bodyAndVolumeFractionFieldID )
+inline void mapPSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block, const shared_ptr<StructuredBlockStorage> & blockStorage,
+                                         const BlockDataID bodyAndVolumeFractionFieldID )
 {
-   typedef std::pair< pe::BodyID, real_t >                              BodyAndVolumeFraction_T;
-   typedef GhostLayerField< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
-
    BodyAndVolumeFractionField_T * bodyAndVolumeFractionField = block.getData< BodyAndVolumeFractionField_T >( bodyAndVolumeFractionFieldID );
    WALBERLA_ASSERT_NOT_NULLPTR( bodyAndVolumeFractionField );
 
@@ -77,28 +79,32 @@ void mapPSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block, const s
 
 /*!\brief Mapping class that can be used inside the timeloop to update the volume fractions and body mappings
  *
- * Upon construction, it uses the free mapping function to initialize the fraction and body mapping field.
+ * Upon construction, the fraction and body mapping field is initialized.
  *
- * Successive calls try to update this field instead of completely recalculating all volume fractions which is expensive.
- * To do so, the update functionality determines whether bodies have very small velocities, both translational and rotational,
- * (limited with velocityUpdatingEpsilon) or have not traveled very far (limited by positionUpdatingEpsilon) since the last volume fraction recalculation.
- * If both criteria are fulfilled, the volume fraction information is simply copied from the old data field.
- * If not, the recalculation and remapping is carried out.
+ * Successive calls update this field incrementally instead of completely recalculating all volume fractions which is expensive.
+ * For each body, the cell bounding box ("footprint") and the position of the last volume fraction computation are stored.
+ * Only the cells of bodies that have moved are touched:
+ *  - in cells that were covered by the old but not by the new bounding box, the entry of the body is removed
+ *  - in cells of the new bounding box, the volume fraction is recomputed and the entry of the body is updated, added or removed
+ * Bodies that have left the block are removed from the cells of their last bounding box. All other cells are not touched at all.
+ *
+ * A body is considered as not moved if it has very small velocities, both translational and rotational,
+ * (limited with velocityUpdatingEpsilon) and has not traveled very far (limited by positionUpdatingEpsilon) since the last volume
+ * fraction recalculation. In this case, its volume fractions are kept.
  * This functionality is a pure performance optimization and might affect the accuracy of the simulation if the limits are too large.
  *
  * Similarly, the argument superSamplingDepth can be used to limit the default depth (=4) of the super sampling approach
  * which is applied to approximate the volume fraction in each cell when no analytical formula exists. If the depth is smaller,
  * the approximation will be less accurate but faster.
  *
+ * The footprints are stored per block. If the block structure changes (refinement, load balancing), initialize() has to be called.
+ *
  * WARNING: Use these functionalities with care! Extensive use might result in wrong results or crashing simulations.
  */
 class BodyAndVolumeFractionMapping
 {
 public:
 
-   typedef std::pair< pe::BodyID, real_t >                              BodyAndVolumeFraction_T;
-   typedef GhostLayerField< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
-
    BodyAndVolumeFractionMapping( const shared_ptr<StructuredBlockStorage> & blockStorage,
                                  const shared_ptr<pe::BodyStorage> globalBodyStorage,
                                  const BlockDataID & bodyStorageID,
@@ -127,11 +133,23 @@ public:
 
 private:
 
-   void updatePSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block,
-                                        BodyAndVolumeFractionField_T * oldBodyAndVolumeFractionField,
-                                        std::map< walberla::id_t, Vector3< real_t > > & tempLastUpdatedPositionMap );
-   void updateGlobalPSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block,
-                                              BodyAndVolumeFractionField_T * oldBodyAndVolumeFractionField);
+   /// cell bounding box and position of a body at its last volume fraction computation
+   struct Footprint
+   {
+      Footprint() : body( NULL ) {}
+      Footprint( const pe::BodyID b, const CellInterval & bb, const Vector3<real_t> & pos ) : body( b ), cellBB( bb ), position( pos ) {}
+
+      pe::BodyID      body;
+      CellInterval    cellBB;
+      Vector3<real_t> position;
+   };
+   typedef std::map< walberla::id_t, Footprint > FootprintMap;
+
+   Footprint mapBody( const pe::BodyID body, IBlock & block, BodyAndVolumeFractionField_T * bodyAndVolumeFractionField ) const;
+   bool      hasMoved( const pe::BodyID body, const Footprint & footprint ) const;
+
+   static void removeBody( const pe::BodyID body, const CellInterval & cells, const CellInterval & cellsToSkip,
+                           BodyAndVolumeFractionField_T * bodyAndVolumeFractionField );
 
    shared_ptr<StructuredBlockStorage> blockStorage_;
    shared_ptr<pe::BodyStorage> globalBodyStorage_;
@@ -142,192 +160,182 @@ private:
    const bool        mapFixed_;
    const bool        mapGlobal_;
 
-   shared_ptr<BodyAndVolumeFractionField_T> updatedBodyAndVolumeFractionField_;
-   std::map< walberla::id_t, Vector3< real_t > > lastUpdatedPositionMap_;
+   std::map< const IBlock *, FootprintMap > footprints_;
 
    const real_t velocityUpdatingEpsilonSquared_;
    const real_t positionUpdatingEpsilonSquared_;
    const uint_t superSamplingDepth_;
 };
 
-void BodyAndVolumeFractionMapping::initialize()
+inline void BodyAndVolumeFractionMapping::initialize()
 {
+   footprints_.clear();
+
    for( auto blockIt = blockStorage_->begin(); blockIt != blockStorage_->end(); ++blockIt )
    {
       BodyAndVolumeFractionField_T * bodyAndVolumeFractionField = blockIt->getData< BodyAndVolumeFractionField_T >( bodyAndVolumeFractionFieldID_ );
 
-      if( updatedBodyAndVolumeFractionField_ == NULL )
-      {
-         // hold internally an identical field for swapping
-         updatedBodyAndVolumeFractionField_ = shared_ptr<BodyAndVolumeFractionField_T>( bodyAndVolumeFractionField->cloneUninitialized() );
-
-         auto xyzFieldSize = updatedBodyAndVolumeFractionField_->xyzSize();
-         for( auto fieldIt = xyzFieldSize.begin(); fieldIt != xyzFieldSize.end(); ++fieldIt )
-         {
-            (updatedBodyAndVolumeFractionField_->get(*fieldIt)).clear();
-         }
-      }
-
       // clear the field
-      auto xyzFieldSize = bodyAndVolumeFractionField->xyzSize();
+      auto xyzFieldSize = bodyAndVolumeFractionField->xyzSizeWithGhostLayer();
       for( auto fieldIt = xyzFieldSize.begin(); fieldIt != xyzFieldSize.end(); ++fieldIt )
       {
          (bodyAndVolumeFractionField->get(*fieldIt)).clear();
       }
 
+      FootprintMap & footprints = footprints_[ &(*blockIt) ];
+
       for( auto bodyIt = pe::BodyIterator::begin( *blockIt, bodyStorageID_); bodyIt != pe::BodyIterator::end(); ++bodyIt )
       {
          // only PSM and finite bodies (no planes, etc.) are mapped
          if( /*!isPSMBody( *bodyIt ) ||*/ ( bodyIt->isFixed() && !mapFixed_ ) )
             continue;
-         mapPSMBodyAndVolumeFraction( *bodyIt, *blockIt, blockStorage_, bodyAndVolumeFractionFieldID_ );
-         lastUpdatedPositionMap_.insert( std::pair< walberla::id_t, Vector3< real_t > >( bodyIt->getSystemID(), bodyIt->getPosition() ) );
+         footprints[ bodyIt->getSystemID() ] = mapBody( *bodyIt, *blockIt, bodyAndVolumeFractionField );
       }
 
+      // global bodies are mapped once, they are not updated
       if( mapGlobal_ )
       {
          for( auto globalBodyIt = globalBodyStorage_->begin(); globalBodyIt != globalBodyStorage_->end(); ++globalBodyIt )
          {
-            mapPSMBodyAndVolumeFraction( *globalBodyIt, *blockIt, blockStorage_, bodyAndVolumeFractionFieldID_ );
+            mapBody( *globalBodyIt, *blockIt, bodyAndVolumeFractionField );
          }
       }
    }
 }
 
-void BodyAndVolumeFractionMapping::update()
+inline void BodyAndVolumeFractionMapping::update()
 {
-   std::map< walberla::id_t, Vector3< real_t > > tempLastUpdatedPositionMap;
-
    for( auto blockIt = blockStorage_->begin(); blockIt != blockStorage_->end(); ++blockIt )
    {
       BodyAndVolumeFractionField_T * bodyAndVolumeFractionField = blockIt->getData< BodyAndVolumeFractionField_T >( bodyAndVolumeFractionFieldID_ );
 
+      FootprintMap & footprints = footprints_[ &(*blockIt) ];
+
+      std::map< walberla::id_t, pe::BodyID > bodies;
       for( auto bodyIt = pe::BodyIterator::begin( *blockIt, bodyStorageID_); bodyIt != pe::BodyIterator::end(); ++bodyIt )
       {
          // only PSM and finite bodies (no planes, etc.) are mapped
          if( /*!isPSMBody( *bodyIt ) ||*/ ( bodyIt->isFixed() && !mapFixed_ ) )
             continue;
-         updatePSMBodyAndVolumeFraction( *bodyIt, *blockIt, bodyAndVolumeFractionField, tempLastUpdatedPositionMap );
+         bodies[ bodyIt->getSystemID() ] = *bodyIt;
       }
 
-      if( mapGlobal_ )
+      // remove bodies that have left the block (or have been recreated, e.g. as a shadow copy) first,
+      // since the memory of a removed body might already be reused by another body
+      for( auto footprintIt = footprints.begin(); footprintIt != footprints.end(); )
       {
-         for( auto globalBodyIt = globalBodyStorage_->begin(); globalBodyIt != globalBodyStorage_->end(); ++globalBodyIt )
+         auto bodyIt = bodies.find( footprintIt->first );
+         if( bodyIt == bodies.end() || bodyIt->second != footprintIt->second.body )
          {
-            updateGlobalPSMBodyAndVolumeFraction( *globalBodyIt, *blockIt, bodyAndVolumeFractionField );;
+            removeBody( footprintIt->second.body, footprintIt->second.cellBB, CellInterval(), bodyAndVolumeFractionField );
+            footprints.erase( footprintIt++ );
+         }
+         else
+         {
+            ++footprintIt;
          }
       }
 
-      bodyAndVolumeFractionField->swapDataPointers( *updatedBodyAndVolumeFractionField_ );
-
-      auto xyzFieldSize = updatedBodyAndVolumeFractionField_->xyzSize();
-      for( auto fieldIt = xyzFieldSize.begin(); fieldIt != xyzFieldSize.end(); ++fieldIt )
+      for( auto bodyIt = bodies.begin(); bodyIt != bodies.end(); ++bodyIt )
       {
-         (updatedBodyAndVolumeFractionField_->get(*fieldIt)).clear();
+         const pe::BodyID body = bodyIt->second;
+         auto footprintIt = footprints.find( bodyIt->first );
+
+         if( footprintIt == footprints.end() )
+         {
+            // body is new to this block
+            footprints[ bodyIt->first ] = mapBody( body, *blockIt, bodyAndVolumeFractionField );
+         }
+         else if( hasMoved( body, footprintIt->second ) )
+         {
+            // recompute the fractions in the new bounding box and remove the body from all cells that are no longer covered
+            const Footprint footprint = mapBody( body, *blockIt, bodyAndVolumeFractionField );
+            removeBody( body, footprintIt->second.cellBB, footprint.cellBB, bodyAndVolumeFractionField );
+            footprintIt->second = footprint;
+         }
+         // else: just reuse old fraction values
       }
    }
-
-   lastUpdatedPositionMap_ = tempLastUpdatedPositionMap;
 }
 
-void BodyAndVolumeFractionMapping::updatePSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block,
-                                                                   BodyAndVolumeFractionField_T * oldBodyAndVolumeFractionField,
-                                                                   std::map< walberla::id_t, Vector3< real_t > > & tempLastUpdatedPositionMap )
+inline BodyAndVolumeFractionMapping::Footprint
+BodyAndVolumeFractionMapping::mapBody( const pe::BodyID body, IBlock & block, BodyAndVolumeFractionField_T * bodyAndVolumeFractionField ) const
 {
-
-   WALBERLA_ASSERT_NOT_NULLPTR( oldBodyAndVolumeFractionField );
-
-   // estimate traveled distance since last volume fraction update
-   real_t traveledSquaredDistance( real_t(0) );
-   auto mapBodyIt = lastUpdatedPositionMap_.find( body->getSystemID() );
-   if( mapBodyIt != lastUpdatedPositionMap_.end() )
-   {
-      // body found and traveled distance can be estimated
-      Vector3<real_t> distanceVec = body->getPosition() - mapBodyIt->second;
-      traveledSquaredDistance = distanceVec.sqrLength();
-   } else
-   {
-      // body was not found in map -> is a new body, so no information is known
-      traveledSquaredDistance = std::numeric_limits<real_t>::max();
-   }
+   WALBERLA_ASSERT_NOT_NULLPTR( bodyAndVolumeFractionField );
 
    // get bounding box of body
-   CellInterval cellBB = getCellBB( body, block, blockStorage_, oldBodyAndVolumeFractionField->nrOfGhostLayers() );
-
-   // if body has not moved (specified by some epsilon), just reuse old fraction values
-   if( body->getLinearVel().sqrLength()  < velocityUpdatingEpsilonSquared_ &&
-       body->getAngularVel().sqrLength() < velocityUpdatingEpsilonSquared_ &&
-       traveledSquaredDistance < positionUpdatingEpsilonSquared_ )
-   {      
-      for( cell_idx_t z = cellBB.zMin(); z <= cellBB.zMax(); ++z )
-      {
-         for( cell_idx_t y = cellBB.yMin(); y <= cellBB.yMax(); ++y )
-         {
-            for( cell_idx_t x = cellBB.xMin(); x <= cellBB.xMax(); ++x )
-            {
+   CellInterval cellBB = getCellBB( body, block, blockStorage_, bodyAndVolumeFractionField->nrOfGhostLayers() );
 
-               auto oldVec = oldBodyAndVolumeFractionField->get(x,y,z);
-               for( auto pairIt = oldVec.begin(); pairIt != oldVec.end(); ++pairIt ) 
-               {
-                  if( pairIt->first == body )
-                  {
-                     updatedBodyAndVolumeFractionField_->get(x,y,z).push_back(*pairIt);
-                     break;
-                  }
-               }
-            }
-         }
-      }
-      tempLastUpdatedPositionMap.insert( std::pair< walberla::id_t, Vector3< real_t > >( body->getSystemID(), mapBodyIt->second ) );
+   const real_t dx = blockStorage_->dx( blockStorage_->getLevel( block ) );
 
-   } else
+   for( cell_idx_t z = cellBB.zMin(); z <= cellBB.zMax(); ++z )
    {
-      // else body has moved significantly or is new to this block, thus the volume fraction has to be calculated
-      for( cell_idx_t z = cellBB.zMin(); z <= cellBB.zMax(); ++z )
+      for( cell_idx_t y = cellBB.yMin(); y <= cellBB.yMax(); ++y )
       {
-         for( cell_idx_t y = cellBB.yMin(); y <= cellBB.yMax(); ++y )
+         for( cell_idx_t x = cellBB.xMin(); x <= cellBB.xMax(); ++x )
          {
-            for( cell_idx_t x = cellBB.xMin(); x <= cellBB.xMax(); ++x )
-            {
-               // get the cell's center
-               Vector3<real_t> cellCenter;
-               cellCenter = blockStorage_->getBlockLocalCellCenter( block, Cell(x,y,z) );
+            // get the cell's center
+            Vector3<real_t> cellCenter;
+            cellCenter = blockStorage_->getBlockLocalCellCenter( block, Cell(x,y,z) );
 
-               const real_t fraction = overlapFractionPe( *body, cellCenter, blockStorage_->dx( blockStorage_->getLevel( block ) ), superSamplingDepth_ );
+            const real_t fraction = overlapFractionPe( *body, cellCenter, dx, superSamplingDepth_ );
 
-               // if the cell intersected with the body, store a pointer to that body and the corresponding volume fraction in the field
-               if( fraction > real_t(0) )
-               {
-                  updatedBodyAndVolumeFractionField_->get(x,y,z).push_back( BodyAndVolumeFraction_T( body, fraction ) );
-               }
+            // update, add, or remove the entry of the body in this cell
+            BodyAndVolumeFractionVector_T & bodyAndVolumeFractions = bodyAndVolumeFractionField->get(x,y,z);
+
+            auto pairIt = bodyAndVolumeFractions.begin();
+            while( pairIt != bodyAndVolumeFractions.end() && pairIt->first != body )
+               ++pairIt;
+
+            if( fraction > real_t(0) )
+            {
+               if( pairIt != bodyAndVolumeFractions.end() )
+                  pairIt->second = fraction;
+               else
+                  bodyAndVolumeFractions.push_back( BodyAndVolumeFraction_T( body, fraction ) );
+            }
+            else if( pairIt != bodyAndVolumeFractions.end() )
+            {
+               bodyAndVolumeFractions.erase( pairIt );
             }
          }
       }
-
-      tempLastUpdatedPositionMap.insert( std::pair< walberla::id_t, Vector3< real_t > >( body->getSystemID(), body->getPosition() ) );
    }
+
+   return Footprint( body, cellBB, body->getPosition() );
 }
 
-void BodyAndVolumeFractionMapping::updateGlobalPSMBodyAndVolumeFraction( const pe::BodyID body, IBlock & block,
-                                                                         BodyAndVolumeFractionField_T * oldBodyAndVolumeFractionField )
+inline bool BodyAndVolumeFractionMapping::hasMoved( const pe::BodyID body, const Footprint & footprint ) const
 {
+   // if body has not moved (specified by some epsilon), the old fraction values can be reused
+   return !( body->getLinearVel().sqrLength()  < velocityUpdatingEpsilonSquared_ &&
+             body->getAngularVel().sqrLength() < velocityUpdatingEpsilonSquared_ &&
+             ( body->getPosition() - footprint.position ).sqrLength() < positionUpdatingEpsilonSquared_ );
+}
 
-   WALBERLA_ASSERT_NOT_NULLPTR( oldBodyAndVolumeFractionField );
-
-   // get bounding box of body
-   CellInterval cellBB = getCellBB( body, block, blockStorage_, oldBodyAndVolumeFractionField->nrOfGhostLayers() );
+inline void BodyAndVolumeFractionMapping::removeBody( const pe::BodyID body, const CellInterval & cells, const CellInterval & cellsToSkip,
+                                                      BodyAndVolumeFractionField_T * bodyAndVolumeFractionField )
+{
+   WALBERLA_ASSERT_NOT_NULLPTR( bodyAndVolumeFractionField );
 
-   // copy values of global body to new field
-   for( auto cellIt = cellBB.begin(); cellIt != cellBB.end(); ++cellIt )
+   for( cell_idx_t z = cells.zMin(); z <= cells.zMax(); ++z )
    {
-      Cell cell( *cellIt );
-      auto oldVec = oldBodyAndVolumeFractionField->get(cell);
-      for( auto pairIt = oldVec.begin(); pairIt != oldVec.end(); ++pairIt )
+      for( cell_idx_t y = cells.yMin(); y <= cells.yMax(); ++y )
       {
-         if( pairIt->first == body )
+         for( cell_idx_t x = cells.xMin(); x <= cells.xMax(); ++x )
          {
-            updatedBodyAndVolumeFractionField_->get(cell).push_back(*pairIt);
-            break;
+            if( cellsToSkip.contains( x, y, z ) )
+               continue;
+
+            BodyAndVolumeFractionVector_T & bodyAndVolumeFractions = bodyAndVolumeFractionField->get(x,y,z);
+            for( auto pairIt = bodyAndVolumeFractions.begin(); pairIt != bodyAndVolumeFractions.end(); ++pairIt )
+            {
+               if( pairIt->first == body )
+               {
+                  bodyAndVolumeFractions.erase( pairIt );
+                  break;
+               }
+            }
          }
       }
    }
@@ -335,4 +343,3 @@ void BodyAndVolumeFractionMapping::updateGlobalPSMBodyAndVolumeFraction( const p
 
 } // namespace pe_coupling
 } // namespace walberla
-
@@ -0,0 +1,340 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PSMSplitSweep.h
+//! \ingroup pe_coupling
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "domain_decomposition/StructuredBlockStorage.h"
+
+#include "field/FlagField.h"
+
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/EquilibriumDistribution.h"
+#include "lbm/sweeps/SplitSweep.h"
+
+#include "pe/Types.h"
+
+#include "core/cell/Cell.h"
+#include "core/Set.h"
+
+#include "BodyAndVolumeFraction.h"
+#include "PSMSweep.h"
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <vector>
+
+namespace walberla {
+namespace pe_coupling {
+
+/*!\brief Optimized LBM sweep for the partially saturated cells method with the D3Q19 SRT lattice model
+ *
+ * Same method as PSMSweep (see there for the meaning of SolidCollision_T and Weighting_T), but the cells are treated
+ * in two passes:
+ *  - All fluid cells (as specified by the flag field and the set of fluid flags) are processed by the optimized
+ *    lbm::SplitSweep, i.e., pure fluid cells do not pay for the coupling at all.
+ *  - For the cells that are (partially) covered by bodies, an index list is assembled from the body and volume fraction
+ *    field. For these cells only, the PSM collision and the forces on the bodies are computed (before the split sweep
+ *    overwrites the PDFs) and the results then replace the values written by the split sweep.
+ *
+ * Since the split sweep is used for the fluid cells, the lattice model must be D3Q19 with a constant SRT collision model
+ * and without force model. Ghost layers cannot be included. For other lattice models or for the usage within the
+ * refinement time step, PSMSweep has to be used.
+ */
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+class PSMSplitSweep
+{
+public:
+
+   static_assert( (boost::is_same< typename LatticeModel_T::CollisionModel::tag, lbm::collision_model::SRT_tag >::value), "Only works with SRT!" );
+   static_assert( (boost::is_same< typename LatticeModel_T::Stencil, stencil::D3Q19 >::value),                            "Only works with D3Q19!" );
+   static_assert( (boost::is_same< typename LatticeModel_T::ForceModel::tag, lbm::force_model::None_tag >::value),        "Only works without additional forces!" );
+
+   typedef lbm::PdfField< LatticeModel_T >         PdfField_T;
+   typedef typename LatticeModel_T::Stencil        Stencil_T;
+   typedef typename FlagField_T::flag_t            flag_t;
+   typedef Field< BodyAndVolumeFractionVector_T, 1 > BodyAndVolumeFractionField_T;
+
+   PSMSplitSweep( const BlockDataID & pdfFieldID,
+                  const BlockDataID & bodyAndVolumeFractionFieldID,
+                  const shared_ptr<StructuredBlockStorage> & blockStorage,
+                  const ConstBlockDataID & flagFieldID, const Set< FlagUID > & lbmMask ) :
+      fluidSweep_( pdfFieldID, flagFieldID, lbmMask ), pdfFieldID_( pdfFieldID ),
+      bodyAndVolumeFractionFieldID_( bodyAndVolumeFractionFieldID ), blockStorage_( blockStorage ),
+      flagFieldID_( flagFieldID ), lbmMask_( lbmMask ) {}
+
+   PSMSplitSweep( const BlockDataID & src, const BlockDataID & dst,
+                  const BlockDataID & bodyAndVolumeFractionFieldID,
+                  const shared_ptr<StructuredBlockStorage> & blockStorage,
+                  const ConstBlockDataID & flagFieldID, const Set< FlagUID > & lbmMask ) :
+      fluidSweep_( src, dst, flagFieldID, lbmMask ), pdfFieldID_( src ),
+      bodyAndVolumeFractionFieldID_( bodyAndVolumeFractionFieldID ), blockStorage_( blockStorage ),
+      flagFieldID_( flagFieldID ), lbmMask_( lbmMask ) {}
+
+   void operator()( IBlock * const block )
+   {
+      streamCollide( block );
+   }
+
+   void streamCollide( IBlock * const block );
+
+   void stream ( IBlock * const block, const uint_t numberOfGhostLayersToInclude = uint_t(0) );
+   void collide( IBlock * const block );
+
+private:
+
+   // The index list and the PDFs of the covered cells are local to each call (and not members of the sweep), so that
+   // one sweep object can be executed for several blocks at the same time (see, e.g., TaskSweepTimeloop).
+
+   /// assembles the index list of all fluid cells of the block that are covered by at least one body
+   void findSolidCells( IBlock * const block, const PdfField_T * pdfField, std::vector< Cell > & solidCells ) const;
+
+   /// computes the PSM collision for all cells in the index list, the results are stored in 'solidCellPdfs'
+   void collideSolidCells( IBlock * const block, const PdfField_T * pdfField, const bool pullPdfs,
+                           const std::vector< Cell > & solidCells, std::vector< real_t > & solidCellPdfs ) const;
+
+   /// overwrites the PDFs of all cells in the index list with the results of collideSolidCells
+   void setSolidCells( PdfField_T * pdfField, const std::vector< Cell > & solidCells, const std::vector< real_t > & solidCellPdfs ) const;
+
+   lbm::SplitSweep< LatticeModel_T, FlagField_T > fluidSweep_;
+
+   const BlockDataID pdfFieldID_;
+   const BlockDataID bodyAndVolumeFractionFieldID_;
+   shared_ptr<StructuredBlockStorage> blockStorage_;
+
+   const ConstBlockDataID flagFieldID_;
+   const Set< FlagUID > lbmMask_;
+};
+
+
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::streamCollide( IBlock * const block )
+{
+   PdfField_T * pdfField = block->getData< PdfField_T >( pdfFieldID_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+
+   std::vector< Cell >   solidCells;
+   std::vector< real_t > solidCellPdfs;
+
+   findSolidCells( block, pdfField, solidCells );
+   collideSolidCells( block, pdfField, true, solidCells, solidCellPdfs );
+
+   // the split sweep swaps the data pointers of src and dst, afterwards pdfField contains the post collision values
+   fluidSweep_( block );
+
+   setSolidCells( pdfField, solidCells, solidCellPdfs );
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::stream( IBlock * const block, const uint_t numberOfGhostLayersToInclude )
+{
+   fluidSweep_.stream( block, numberOfGhostLayersToInclude );
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::collide( IBlock * const block )
+{
+   PdfField_T * pdfField = block->getData< PdfField_T >( pdfFieldID_ );
+   WALBERLA_ASSERT_NOT_NULLPTR( pdfField );
+
+   std::vector< Cell >   solidCells;
+   std::vector< real_t > solidCellPdfs;
+
+   findSolidCells( block, pdfField, solidCells );
+   collideSolidCells( block, pdfField, false, solidCells, solidCellPdfs );
+
+   fluidSweep_.collide( block );
+
+   setSolidCells( pdfField, solidCells, solidCellPdfs );
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::findSolidCells( IBlock * const block, const PdfField_T * pdfField,
+                                                                                                   std::vector< Cell > & solidCells ) const
+{
+   const FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID_ );
+   const BodyAndVolumeFractionField_T * bodyAndVolumeFractionField = block->getData< BodyAndVolumeFractionField_T >( bodyAndVolumeFractionFieldID_ );
+
+   WALBERLA_ASSERT_NOT_NULLPTR( flagField );
+   WALBERLA_ASSERT_NOT_NULLPTR( bodyAndVolumeFractionField );
+   WALBERLA_ASSERT_EQUAL( pdfField->xyzSize(), bodyAndVolumeFractionField->xyzSize() );
+   WALBERLA_UNUSED( pdfField );
+
+   const flag_t lbm = flagField->getMask( lbmMask_ );
+
+   solidCells.clear();
+
+   const cell_idx_t xSize = cell_idx_c( bodyAndVolumeFractionField->xSize() );
+   const cell_idx_t ySize = cell_idx_c( bodyAndVolumeFractionField->ySize() );
+   const cell_idx_t zSize = cell_idx_c( bodyAndVolumeFractionField->zSize() );
+   for( cell_idx_t z = 0; z < zSize; ++z ) {
+      for( cell_idx_t y = 0; y < ySize; ++y ) {
+         for( cell_idx_t x = 0; x < xSize; ++x ) {
+            if( !bodyAndVolumeFractionField->get(x,y,z).empty() && flagField->isPartOfMaskSet( x, y, z, lbm ) )
+               solidCells.push_back( Cell(x,y,z) );
+         }
+      }
+   }
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::collideSolidCells( IBlock * const block, const PdfField_T * pdfField,
+                                                                                                      const bool pullPdfs, const std::vector< Cell > & solidCells,
+                                                                                                      std::vector< real_t > & solidCellPdfs ) const
+{
+   const BodyAndVolumeFractionField_T * bodyAndVolumeFractionField = block->getData< BodyAndVolumeFractionField_T >( bodyAndVolumeFractionFieldID_ );
+
+   const real_t dxCurrentLevel = blockStorage_->dx( blockStorage_->getLevel( *block ) );
+   const real_t forceScalingFactor = dxCurrentLevel * dxCurrentLevel;
+
+   const real_t omega = pdfField->latticeModel().collisionModel().omega();
+   const real_t tau = real_c(1)/omega;
+
+   solidCellPdfs.resize( solidCells.size() * Stencil_T::Size );
+
+   for( uint_t i = 0; i < solidCells.size(); ++i )
+   {
+      const cell_idx_t x = solidCells[i].x();
+      const cell_idx_t y = solidCells[i].y();
+      const cell_idx_t z = solidCells[i].z();
+
+      real_t pdfs[ Stencil_T::Size ];
+
+      // (stream pull &) temporal storage of PDFs
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         pdfs[d.toIdx()] = pullPdfs ? pdfField->get( x-d.cx(), y-d.cy(), z-d.cz(), d.toIdx() ) : pdfField->get( x, y, z, d.toIdx() );
+      }
+
+      // density and velocity (no force model, hence the velocity equals the equilibrium velocity)
+      Vector3<real_t> velocity( real_t(0) );
+      real_t rho = LatticeModel_T::compressible ? real_t(0) : real_t(1);
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         rho         += pdfs[d.toIdx()];
+         velocity[0] += pdfs[d.toIdx()] * real_c(d.cx());
+         velocity[1] += pdfs[d.toIdx()] * real_c(d.cy());
+         velocity[2] += pdfs[d.toIdx()] * real_c(d.cz());
+      }
+      if( LatticeModel_T::compressible )
+         velocity /= rho;
+
+      // equilibrium distributions
+      auto pdfs_equ = lbm::EquilibriumDistribution< LatticeModel_T >::get( velocity, rho );
+
+      // total coverage ratio in the cell
+      real_t Bn = real_t(0);
+
+      // averaged solid collision operator for all intersecting bodies s
+      // = \sum_s B_s * \Omega_s_i
+      real_t omega_n[ Stencil_T::Size ];
+      for( uint_t f = 0; f < Stencil_T::Size; ++f )
+         omega_n[f] = real_t(0);
+
+      // get center of cell
+      const Vector3<real_t> cellCenter = blockStorage_->getBlockLocalCellCenter( *block, solidCells[i] );
+
+      const BodyAndVolumeFractionVector_T & bodyAndVolumeFractions = bodyAndVolumeFractionField->get(x,y,z);
+      for( auto bodyFracIt = bodyAndVolumeFractions.begin(); bodyFracIt != bodyAndVolumeFractions.end(); ++bodyFracIt )
+      {
+         real_t omega_s ( real_c(0) );
+         Vector3<real_t> forceOnBody ( real_c(0) );
+
+         const real_t Bs = calculateWeighting< Weighting_T >( (*bodyFracIt).second, tau );
+         Bn += Bs;
+
+         // body velocity at cell center
+         const auto bodyVelocity = (*bodyFracIt).first->velFromWF( cellCenter );
+
+         // equilibrium distributions with solid velocity
+         auto pdfs_equ_solid = lbm::EquilibriumDistribution< LatticeModel_T >::get( bodyVelocity, rho );
+
+         for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+         {
+            // Different solid collision operators available
+            if( SolidCollision_T == 1){
+               omega_s = pdfs[d.toInvIdx()] - pdfs_equ[d.toInvIdx()] + pdfs_equ_solid[d.toIdx()] - pdfs[d.toIdx()];
+            }else if( SolidCollision_T == 2 ){
+               omega_s = pdfs_equ_solid[d.toIdx()] - pdfs[d.toIdx()] + ( real_c(1) - omega) * ( pdfs[d.toIdx()] - pdfs_equ[d.toIdx()] );
+            }else if( SolidCollision_T == 3){
+               omega_s = pdfs[d.toInvIdx()] - pdfs_equ_solid[d.toInvIdx()] + pdfs_equ_solid[d.toIdx()] - pdfs[d.toIdx()];
+            }
+            const real_t BsOmegaS = Bs * omega_s;
+
+            omega_n[d.toIdx()] += BsOmegaS;
+
+            forceOnBody[0] -= BsOmegaS * real_c(d.cx());
+            forceOnBody[1] -= BsOmegaS * real_c(d.cy());
+            forceOnBody[2] -= BsOmegaS * real_c(d.cz());
+         }
+
+         // scale force when using refinement with (dx)^3 / dt
+         forceOnBody *= forceScalingFactor;
+
+         // apply force (and automatically torque) on body, the index list only contains cells of the inner domain
+         (*bodyFracIt).first->addForceAtPos(forceOnBody, cellCenter);
+      }
+
+      // collide step
+      real_t * cellPdfs = &solidCellPdfs[ i * Stencil_T::Size ];
+      for( auto d = Stencil_T::begin(); d != Stencil_T::end(); ++d )
+      {
+         cellPdfs[d.toIdx()] = pdfs[d.toIdx()] - omega * ( real_c(1) - Bn ) * ( pdfs[d.toIdx()] - pdfs_equ[d.toIdx()] ) //SRT
+                               + omega_n[d.toIdx()];
+      }
+   }
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+void PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >::setSolidCells( PdfField_T * pdfField, const std::vector< Cell > & solidCells,
+                                                                                                  const std::vector< real_t > & solidCellPdfs ) const
+{
+   for( uint_t i = 0; i < solidCells.size(); ++i )
+   {
+      const real_t * cellPdfs = &solidCellPdfs[ i * Stencil_T::Size ];
+      for( uint_t f = 0; f < Stencil_T::Size; ++f )
+         pdfField->get( solidCells[i], f ) = cellPdfs[f];
+   }
+}
+
+//////////////////////////////////
+// makePSMSplitSweep FUNCTIONS //
+/////////////////////////////////
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+shared_ptr< PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T > >
+makePSMSplitSweep( const BlockDataID & pdfFieldID, const BlockDataID & bodyAndVolumeFractionFieldID, const shared_ptr<StructuredBlockStorage> & blockStorage,
+                   const ConstBlockDataID & flagFieldID, const Set< FlagUID > & cellsToEvaluate )
+{
+   typedef PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T > PSMS_T;
+   return shared_ptr< PSMS_T >( new PSMS_T( pdfFieldID, bodyAndVolumeFractionFieldID, blockStorage, flagFieldID, cellsToEvaluate ) );
+}
+
+template< typename LatticeModel_T, typename FlagField_T, int SolidCollision_T, int Weighting_T >
+shared_ptr< PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T > >
+makePSMSplitSweep( const BlockDataID & srcID, const BlockDataID & dstID, const BlockDataID & bodyAndVolumeFractionFieldID,
+                   const shared_ptr<StructuredBlockStorage> & blockStorage, const ConstBlockDataID & flagFieldID, const Set< FlagUID > & cellsToEvaluate )
+{
+   typedef PSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T > PSMS_T;
+   return shared_ptr< PSMS_T >( new PSMS_T( srcID, dstID, bodyAndVolumeFractionFieldID, blockStorage, flagFieldID, cellsToEvaluate ) );
+}
+
+} // namespace pe_coupling
+} // namespace walberla
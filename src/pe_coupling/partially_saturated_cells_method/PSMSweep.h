@@ -31,6 +31,8 @@
 
 #include "pe/Types.h"
 
+#include "BodyAndVolumeFraction.h"
+
 namespace walberla {
 namespace pe_coupling {
 
@@ -68,8 +70,7 @@ public:
 
    typedef typename lbm::SweepBase< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut_T >::PdfField_T  PdfField_T;
    typedef typename LatticeModel_T::Stencil                   Stencil_T;
-   typedef std::pair< pe::BodyID, real_t >                    BodyAndVolumeFraction_T;
-   typedef Field< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
+   typedef Field< BodyAndVolumeFractionVector_T, 1 > BodyAndVolumeFractionField_T;
 
    PSMSweep( const BlockDataID & pdfFieldID,
              const BlockDataID & bodyAndVolumeFractionFieldID,
@@ -197,7 +198,9 @@ void PSMSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut
 
                   // averaged solid collision operator for all intersecting bodies s
                   // = \sum_s B_s * \Omega_s_i
-                  std::vector< real_t > omega_n( Stencil_T::Size, real_t(0) );
+                  real_t omega_n[ Stencil_T::Size ];
+                  for( uint_t f = 0; f < Stencil_T::Size; ++f )
+                     omega_n[f] = real_t(0);
 
                   // get center of cell
                   Vector3<real_t> cellCenter = blockStorage_->getBlockLocalCellCenter( *block, Cell(x,y,z));
@@ -350,7 +353,9 @@ void PSMSweep< LatticeModel_T, Filter_T, DensityVelocityIn_T, DensityVelocityOut
 
                   // averaged solid collision operator for all intersecting bodies s
                   // = \sum_s B_s * \Omega_s_i
-                  std::vector< real_t > omega_n( Stencil_T::Size, real_t(0) );
+                  real_t omega_n[ Stencil_T::Size ];
+                  for( uint_t f = 0; f < Stencil_T::Size; ++f )
+                     omega_n[f] = real_t(0);
 
                   // get center of cell
                   Vector3<real_t> cellCenter = blockStorage_->getBlockLocalCellCenter( *block, Cell(x,y,z));
@@ -27,6 +27,8 @@
 #include "lbm/field/PdfField.h"
 #include "pe/Types.h"
 
+#include "BodyAndVolumeFraction.h"
+
 namespace walberla {
 namespace pe_coupling {
 
@@ -38,14 +40,14 @@ namespace pe_coupling {
  * v_s = velocity of object s at cell center
  *
  * lbm::PdfField< LatticeModel_T > is typically typedef'ed as PdfField_T;
- * GhostLayerField< std::vector< std::pair< pe::BodyID, real_t > >, 1 > is typically typedef'ed as BodyAndVolumeFractionField_T;
+ * BodyAndVolumeFractionField_T is defined in BodyAndVolumeFraction.h
  *
  * Weighting_T is like in the PSMSweep.
  */
 template < typename LatticeModel_T, int Weighting_T >
 Vector3<real_t> getPSMMacroscopicVelocity( const IBlock & block,
                                            lbm::PdfField< LatticeModel_T > * pdfField,
-                                           GhostLayerField< std::vector< std::pair< pe::BodyID, real_t > >, 1 > * bodyAndVolumeFractionField,
+                                           BodyAndVolumeFractionField_T * bodyAndVolumeFractionField,
                                            const shared_ptr<StructuredBlockStorage> & blockStorage,
                                            const Cell & cell )
 {
@@ -93,8 +95,6 @@ void initializeDomainForPSM( const shared_ptr<StructuredBlockStorage> & blockSto
                              const BlockDataID & pdfFieldID, const BlockDataID & bodyAndVolumeFractionFieldID )
 {
    typedef lbm::PdfField< LatticeModel_T >                              PdfField_T;
-   typedef std::pair< pe::BodyID, real_t >                              BodyAndVolumeFraction_T;
-   typedef GhostLayerField< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
 
    // iterate all blocks with an iterator 'block'
    for( auto blockIt = blockStorage->begin(); blockIt != blockStorage->end(); ++blockIt )
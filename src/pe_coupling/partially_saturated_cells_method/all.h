@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "BodyAndVolumeFraction.h"
 #include "BodyAndVolumeFractionMapping.h"
+#include "PSMSplitSweep.h"
 #include "PSMSweep.h"
 #include "PSMUtility.h"
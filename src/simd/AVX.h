@@ -52,6 +52,8 @@ namespace avx {
    }
 
    inline void      store_aligned ( double * mem_addr, double4_t a )         { _mm256_store_pd ( mem_addr, a) ;  }
+   inline void      stream_aligned( double * mem_addr, double4_t a )         { _mm256_stream_pd( mem_addr, a) ;  }
+   inline void      stream_fence  ()                                         { _mm_sfence(); }
 
    inline double getComponent ( const double4_t & v, int i )           { return reinterpret_cast<const double*>(&v)[i]; }
    inline double getComponent ( const double4_t & v, unsigned long i ) { return reinterpret_cast<const double*>(&v)[i]; }
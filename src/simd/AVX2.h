@@ -47,6 +47,8 @@ namespace avx2 {
    inline double4_t load_aligned  ( double const * mem_addr )                { return _mm256_load_pd (mem_addr); }
    inline double4_t load_unaligned ( double const * mem_addr )               { return _mm256_loadu_pd (mem_addr); }
    inline void      store_aligned ( double * mem_addr, double4_t a )         { _mm256_store_pd ( mem_addr, a) ;  }
+   inline void      stream_aligned( double * mem_addr, double4_t a )         { _mm256_stream_pd( mem_addr, a) ;  }
+   inline void      stream_fence  ()                                         { _mm_sfence(); }
 
    inline void loadNeighbors( const double * p, double4_t & r_left, double4_t & r_center, double4_t & r_right )
    {
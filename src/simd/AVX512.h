@@ -0,0 +1,196 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AVX512.h
+//! \ingroup avx512
+//! \brief Wrapper functions around AVX-512 intrinsics
+//
+//  The generic simd::double4_t interface is implemented with four doubles (256 bit, AVX-512VL instructions), so that
+//  all code written against it works unchanged. Compared to the AVX2 backend, masks are handled with the AVX-512 mask
+//  registers and invSqrt is computed without leaving the vector registers. This alone does not increase the vector
+//  width: Kernels that want to use the full 512 bit registers have to be written against the additional 8-wide type
+//  double8_t (see, e.g., lbm::SplitSIMDSweep).
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "immintrin.h"
+
+#include "waLBerlaDefinitions.h"
+
+#include "IntelVecTypesCppOperators.h"
+
+
+namespace walberla {
+namespace simd {
+namespace avx512 {
+
+   typedef __m256d double4_t;
+
+   inline const char * usedInstructionSet() { return "AVX512"; }
+
+   inline double4_t make_double4   ( double d, double c, double b, double a ) { return _mm256_set_pd  ( d,c,b,a ); }
+   inline double4_t make_double4_r ( double a, double b, double c, double d ) { return _mm256_setr_pd ( a,b,c,d ); }
+
+   inline double4_t make_double4  ( double a                               ) { return _mm256_set1_pd ( a ); }
+
+   inline double4_t make_zero()   { return _mm256_setzero_pd(); }
+
+   inline double4_t load_aligned  ( double const * mem_addr )                { return _mm256_load_pd (mem_addr); }
+   inline double4_t load_unaligned ( double const * mem_addr )               { return _mm256_loadu_pd (mem_addr); }
+   inline void      store_aligned ( double * mem_addr, double4_t a )         { _mm256_store_pd ( mem_addr, a) ;  }
+   inline void      stream_aligned( double * mem_addr, double4_t a )         { _mm256_stream_pd( mem_addr, a) ;  }
+   inline void      stream_fence  ()                                         { _mm_sfence(); }
+
+   inline void loadNeighbors( const double * p, double4_t & r_left, double4_t & r_center, double4_t & r_right )
+   {
+      r_left   = load_unaligned( p-1 );
+      r_center = load_aligned  ( p   );
+      r_right  = load_unaligned( p+1 );
+   }
+
+   inline double getComponent ( const double4_t & v, int           i ) { return reinterpret_cast<const double*>(&v)[i]; }
+   inline double getComponent ( const double4_t & v, unsigned long i ) { return reinterpret_cast<const double*>(&v)[i]; }
+
+   inline bool   getBoolComponent ( const double4_t & v, int i           ) { return (reinterpret_cast<const uint64_t*>(&v)[i]) != 0; }
+   inline bool   getBoolComponent ( const double4_t & v, unsigned long i ) { return (reinterpret_cast<const uint64_t*>(&v)[i]) != 0; }
+
+   inline double4_t hadd( double4_t a,  double4_t b ) { return _mm256_hadd_pd ( a,b); }
+
+   inline double4_t horizontalSum ( double4_t a )
+   {
+     double4_t t1 = avx512::hadd(a,a);
+     double4_t t2 = _mm256_permute2f128_pd(t1, t1, 0x01);  // exchange lower and upper half
+     return  _mm256_add_pd(t1,t2);
+   }
+
+   inline double4_t exchangeLowerUpperHalf ( double4_t a )
+   {
+      return _mm256_permute2f128_pd(a, a, 0x01);
+   }
+
+
+   inline void extract( double4_t in, double4_t &d, double4_t &c, double4_t &b, double4_t & a )
+   {
+      a = _mm256_permute4x64_pd( in, 0x00 );
+      b = _mm256_permute4x64_pd( in, 0x55 );
+      c = _mm256_permute4x64_pd( in, 0xAA );
+      d = _mm256_permute4x64_pd( in, 0xFF );
+   }
+
+   inline double4_t rotateRight( double4_t a ) { return _mm256_permute4x64_pd(a, 0x39); } // [3 2 1 0] -> [0 3 2 1]
+   inline double4_t rotateLeft ( double4_t a ) { return _mm256_permute4x64_pd(a, 0x93); } // [3 2 1 0] -> [2 1 0 3]
+
+
+   // comparisons are done in the mask registers, the result is expanded to the usual all-bits-set/zero double mask
+
+   inline double4_t maskToDouble4( __mmask8 m ) { return _mm256_castsi256_pd( _mm256_movm_epi64( m ) ); }
+   inline __mmask8  double4ToMask( double4_t m ) { return _mm256_movepi64_mask( _mm256_castpd_si256( m ) ); }
+
+   inline double4_t compareEQ( double4_t a, double4_t b ) {
+      return maskToDouble4( _mm256_cmp_pd_mask ( a, b, _CMP_EQ_UQ ) );
+   }
+   inline double4_t compareNEQ( double4_t a, double4_t b ) {
+      return maskToDouble4( _mm256_cmp_pd_mask ( a, b, _CMP_NEQ_UQ ) );
+   }
+   inline double4_t compareGE( double4_t a, double4_t b ) {
+      return maskToDouble4( _mm256_cmp_pd_mask ( a, b, _CMP_GE_OQ ) );
+   }
+   inline double4_t compareLE( double4_t a, double4_t b ) {
+      return maskToDouble4( _mm256_cmp_pd_mask ( a, b, _CMP_LE_OQ ) );
+   }
+
+   inline double4_t logicalAND( double4_t a, double4_t b ) {
+      return _mm256_and_pd ( a, b );
+   }
+   inline double4_t logicalOR( double4_t a, double4_t b ) {
+      return _mm256_or_pd ( a, b );
+   }
+
+
+   inline int movemask( double4_t m ) {
+      return static_cast<int>( double4ToMask( m ) );
+   }
+   inline double4_t blendv( double4_t a, double4_t b, double4_t mask) {
+      return _mm256_mask_blend_pd ( double4ToMask( mask ), a, b );
+   }
+   template<int mask>
+   inline double4_t blend( double4_t a, double4_t b ) {
+      return _mm256_blend_pd (a,b,mask);
+   }
+
+   inline double4_t sqrt( double4_t a) {
+      return  _mm256_sqrt_pd (a );
+   }
+
+   template< unsigned int numIter = 3 >
+   inline double4_t invSqrt( double4_t y )
+   {
+      //  (Add, Mul, Div ): (numIter, numIter*3+1,0)
+
+      const __m256i magic = _mm256_set1_epi64x( 0x5fe6ec85e7de30daLL );
+
+      double4_t yHalf = make_double4( 0.5 ) * y;
+
+      y = _mm256_castsi256_pd( _mm256_sub_epi64( magic, _mm256_srai_epi64( _mm256_castpd_si256( y ), 1 ) ) );
+
+      double4_t onePointFive = make_double4( 1.5 );
+      for( unsigned int k=0; k < numIter; ++k )
+         y = y * ( onePointFive - yHalf * y * y );
+
+      return y;
+   }
+
+
+
+   //===================================================================================================================
+   //
+   //  8-wide type (512 bit), only a minimal interface for kernels that explicitly make use of the full register width
+   //
+   //===================================================================================================================
+
+   typedef __m512d double8_t;
+
+   inline double8_t make_double8  ( double a ) { return _mm512_set1_pd( a ); }
+   inline double8_t make_double8_r( double a, double b, double c, double d, double e, double f, double g, double h )
+   {
+      return _mm512_setr_pd( a,b,c,d,e,f,g,h );
+   }
+
+   inline double8_t make_zero8() { return _mm512_setzero_pd(); }
+
+   inline double8_t load8_aligned   ( double const * mem_addr )      { return _mm512_load_pd ( mem_addr ); } // 64 byte aligned
+   inline double8_t load8_unaligned ( double const * mem_addr )      { return _mm512_loadu_pd( mem_addr ); }
+   inline void      store8_aligned  ( double * mem_addr, double8_t a ) { _mm512_store_pd ( mem_addr, a ); }  // 64 byte aligned
+   inline void      store8_unaligned( double * mem_addr, double8_t a ) { _mm512_storeu_pd( mem_addr, a ); }
+   inline void      stream8_aligned ( double * mem_addr, double8_t a ) { _mm512_stream_pd( mem_addr, a ); }  // 64 byte aligned
+
+   /// non-temporal store to an address that is only 32 byte aligned
+   inline void stream8_halves( double * mem_addr, double8_t a )
+   {
+      _mm256_stream_pd( mem_addr,     _mm512_castpd512_pd256( a ) );
+      _mm256_stream_pd( mem_addr + 4, _mm512_extractf64x4_pd( a, 1 ) );
+   }
+
+   inline double getComponent ( const double8_t & v, int           i ) { return reinterpret_cast<const double*>(&v)[i]; }
+   inline double getComponent ( const double8_t & v, unsigned long i ) { return reinterpret_cast<const double*>(&v)[i]; }
+
+   inline double horizontalSum8( double8_t a ) { return _mm512_reduce_add_pd( a ); }
+
+
+} // namespace avx512
+} // namespace simd
+} // namespace walberla
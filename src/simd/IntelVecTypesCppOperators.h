@@ -32,6 +32,12 @@ inline __m256d operator+( __m256d a, __m256d b ) { return _mm256_add_pd ( a, b);
 inline __m256d operator-( __m256d a, __m256d b ) { return _mm256_sub_pd ( a, b); }
 inline __m256d operator*( __m256d a, __m256d b ) { return _mm256_mul_pd ( a, b); }
 inline __m256d operator/( __m256d a, __m256d b ) { return _mm256_div_pd ( a, b); }
+#ifdef __AVX512F__
+inline __m512d operator+( __m512d a, __m512d b ) { return _mm512_add_pd ( a, b); }
+inline __m512d operator-( __m512d a, __m512d b ) { return _mm512_sub_pd ( a, b); }
+inline __m512d operator*( __m512d a, __m512d b ) { return _mm512_mul_pd ( a, b); }
+inline __m512d operator/( __m512d a, __m512d b ) { return _mm512_div_pd ( a, b); }
+#endif
 #endif
 
 
@@ -50,6 +50,8 @@ inline double4_t make_zero()   { return vec_splats(0.0); }
 
 inline double4_t load_aligned  ( const double * mem_addr )          { return vec_ld(0ul, const_cast<double*>(mem_addr) ); }
 inline void      store_aligned ( double * mem_addr, double4_t a )   { vec_st( a, 0ul, mem_addr);                          }
+inline void      stream_aligned( double * mem_addr, double4_t a )   { vec_st( a, 0ul, mem_addr);                          }
+inline void      stream_fence  ()                                   {}
 
 inline double4_t load_unaligned  ( const double * mem_addr )
 {
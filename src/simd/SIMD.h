@@ -32,6 +32,11 @@
 //===================================================================================================================
 
 
+#if defined( __AVX512F__ ) && defined( __AVX512VL__ ) && defined( __AVX512DQ__ )
+#define WALBERLA_SIMD_AVX512_AVAILABLE 1
+#endif
+
+
 #ifdef __AVX2__
 #define WALBERLA_SIMD_AVX2_AVAILABLE 1
 #endif
@@ -73,8 +78,15 @@
 #define WALBERLA_USE_SIMD 1
 #endif
 
+// AVX-512 ( Intel Skylake-SP )
+#if defined( WALBERLA_SIMD_AVX512_AVAILABLE ) && !defined( WALBERLA_USE_SIMD )
+#include "AVX512.h"
+#define WALBERLA_USE_AVX512 1
+#define WALBERLA_USE_SIMD 1
+#endif
+
 // AVX2 ( Intel Haswell )
-#if defined( WALBERLA_SIMD_AVX2_AVAILABLE )
+#if defined( WALBERLA_SIMD_AVX2_AVAILABLE ) && !defined( WALBERLA_USE_SIMD )
 #include "AVX2.h"
 #define WALBERLA_USE_AVX2 1
 #define WALBERLA_USE_SIMD 1
@@ -133,6 +145,12 @@ template<typename T> struct is_vector4_type {  static const bool value = false;
 #endif
 
 
+#ifdef WALBERLA_USE_AVX512
+   using namespace avx512;
+   template<> struct is_vector4_type<avx512::double4_t> {  static const bool value = true; };
+#endif
+
+
 #ifdef WALBERLA_USE_AVX2
   using namespace avx2;
   template<> struct is_vector4_type<avx2::double4_t> {  static const bool value = true; };
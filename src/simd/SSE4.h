@@ -116,6 +116,11 @@ namespace sse4 {
       _mm_store_pd( mem_addr  , a.low  );
       _mm_store_pd( mem_addr+2, a.high );
    }
+   inline void  stream_aligned( double * mem_addr, double4_t a ) {
+      _mm_stream_pd( mem_addr  , a.low  );
+      _mm_stream_pd( mem_addr+2, a.high );
+   }
+   inline void  stream_fence() { _mm_sfence(); }
 
    inline double getComponent ( const double4_t & v, int i )           { return reinterpret_cast<const double*>(&v)[i]; }
    inline double getComponent ( const double4_t & v, unsigned long i ) { return reinterpret_cast<const double*>(&v)[i]; }
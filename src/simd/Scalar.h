@@ -81,6 +81,8 @@ inline double4_t make_zero()   { return make_double4(0.0); }
 inline double4_t load_aligned    ( double const * m )         { return make_double4_r( m[0], m[1],m[2],m[3] ); }
 inline double4_t load_unaligned  ( double const * m )         { return make_double4_r( m[0], m[1],m[2],m[3] ); }
 inline void      store_aligned ( double * m, double4_t a )  { m[0]=a[0]; m[1]=a[1]; m[2]=a[2]; m[3]=a[3];    }
+inline void      stream_aligned( double * m, double4_t a )  { store_aligned( m, a );                          }
+inline void      stream_fence  ()                           {}
 
 inline void loadNeighbors( const double * p, double4_t & r_left, double4_t & r_center, double4_t & r_right )
 {
@@ -0,0 +1,68 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file CommunicationOverlap.h
+//! \ingroup timeloop
+//! \brief Registers a sweep that is split into an inner and an outer part so that it overlaps with communication
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "SweepTimeloop.h"
+
+#include <string>
+
+
+namespace walberla {
+namespace timeloop {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Registers the sequence "start communication -> inner sweep -> wait for communication -> outer sweep"
+*
+*   The inner sweep must only access data that does not depend on the communication (typically the interior of each
+*   block), the outer sweep then finishes the work on the data next to the ghost layers. While the inner sweep is
+*   executed, the messages of the communication are in flight, which hides the communication latency.
+*
+*   'communication' must provide 'getStartCommunicateFunctor()' and 'getWaitFunctor()'
+*   (e.g. blockforest::communication::UniformBufferedScheme). Two sweeps are added to the time loop, the inner sweep
+*   with the start of the communication as before function and the outer sweep with the wait as before function.
+*
+*   \code
+*   auto sweep = lbm::makeCellwiseSweep< LatticeModel_T >( pdfFieldId );
+*   timeloop::addCommunicationOverlap( timeloop, communication,
+*                                      Sweep( lbm::makeInnerSweep( sweep ), "LB stream & collide (inner)" ),
+*                                      Sweep( lbm::makeOuterSweep( sweep ), "LB stream & collide (outer)" ) );
+*   \endcode
+*/
+//**********************************************************************************************************************
+
+template< typename Communication_T >
+void addCommunicationOverlap( SweepTimeloop & timeloop, Communication_T & communication, const Sweep & inner, const Sweep & outer,
+                              const std::string & identifier = std::string( "communication" ) )
+{
+   timeloop.add() << BeforeFunction( communication.getStartCommunicateFunctor(), identifier + " (start)" )
+                  << inner;
+   timeloop.add() << BeforeFunction( communication.getWaitFunctor(), identifier + " (wait)" )
+                  << outer;
+}
+
+
+
+} // namespace timeloop
+} // namespace walberla
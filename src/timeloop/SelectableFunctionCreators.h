@@ -186,6 +186,7 @@ namespace timeloop {
 
    private:
       friend class SweepTimeloop;
+      friend class TaskSweepTimeloop;
 
       BlockStorage & bs_;
 
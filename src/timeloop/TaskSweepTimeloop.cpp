@@ -0,0 +1,185 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TaskSweepTimeloop.cpp
+//! \ingroup timeloop
+//
+//======================================================================================================================
+
+#include "TaskSweepTimeloop.h"
+#include "core/Abort.h"
+#include "core/OpenMP.h"
+
+#include <vector>
+
+
+namespace walberla {
+namespace timeloop {
+
+
+
+void TaskSweepTimeloop::doTimeStep(const Set<SUID> &selectors)
+{
+#if defined(_OPENMP) && ( _OPENMP >= 201307 )
+   executeTasks( selectors, NULL );
+#else
+   SweepTimeloop::doTimeStep( selectors );
+#endif
+}
+
+void TaskSweepTimeloop::doTimeStep(const Set<SUID> &selectors, WcTimingPool &timing)
+{
+#if defined(_OPENMP) && ( _OPENMP >= 201307 )
+   // see SweepTimeloop::doTimeStep: the timers of all sweeps must be registered on all processes
+   if ( firstRun_ || timing.empty() )
+   {
+      for( auto sweepIt = sweeps_.begin(); sweepIt != sweeps_.end(); ++sweepIt )
+      {
+         SweepAdder & s = * ( sweepIt->second );
+         for( auto it = s.sweep.begin(); it != s.sweep.end(); ++it )
+            timing.registerTimer( it.identifier() );
+      }
+      firstRun_ = false;
+   }
+
+   executeTasks( selectors, &timing );
+#else
+   SweepTimeloop::doTimeStep( selectors, timing );
+#endif
+}
+
+
+
+void TaskSweepTimeloop::executeTasks( const Set<SUID> & selectors, WcTimingPool * timing )
+{
+   removeForDeletionMarkedSweeps();
+
+   std::vector< IBlock * > blocks;
+   for( BlockStorage::iterator bi = blockStorage_.begin(); bi != blockStorage_.end(); ++bi )
+      blocks.push_back( bi.get() );
+
+#ifdef _OPENMP
+   // one dependency object per block: all tasks of the same block are executed in the order of the sweeps
+   std::vector< char > dependencies( blocks.size() + size_t(1) );
+   char * const dependency = &( dependencies[0] );
+   WALBERLA_UNUSED( dependency ); // only used in the depend clause, which some compilers do not count as usage
+#endif
+
+   // every task measures its own time, the timers are merged into the timing pool once all tasks are completed
+   std::vector< WcTimer >   taskTimers;
+   std::vector< WcTimer * > sweepTimers;
+   if( timing != NULL )
+   {
+      taskTimers.resize( sweeps_.size() * blocks.size() );
+      sweepTimers.resize( sweeps_.size() * blocks.size(), NULL );
+   }
+   size_t nrOfTasks( 0 );
+
+#ifdef _OPENMP
+   #pragma omp parallel
+   {
+   #pragma omp master
+   {
+#endif
+
+   for( auto sweepIt = sweeps_.begin(); sweepIt != sweeps_.end(); ++sweepIt )
+   {
+      SweepAdder & s = * ( sweepIt->second );
+
+      // before functions may depend on the data of all blocks (communication, ...) -> wait for all tasks
+      if( !s.beforeFuncs.empty() )
+      {
+#ifdef _OPENMP
+         #pragma omp taskwait
+#endif
+         for( size_t j=0; j < s.beforeFuncs.size(); ++j )
+         {
+            if( timing != NULL )
+               executeSelectable( s.beforeFuncs[j].selectableFunc_, selectors, "Pre-Sweep Function", *timing );
+            else
+               executeSelectable( s.beforeFuncs[j].selectableFunc_, selectors, "Pre-Sweep Function" );
+         }
+      }
+
+      if( s.sweep.empty() )
+      {
+         WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
+                        "No sweep has been registered! Did you only register a BeforeFunction or AfterFunction?" );
+      }
+
+      for( size_t b = 0; b < blocks.size(); ++b )
+      {
+         IBlock * const block = blocks[b];
+
+         std::string sweepName;
+         Sweep * const selectedSweep = s.sweep.getUnique( selectors + block->getState(), sweepName );
+         if( !selectedSweep )
+            WALBERLA_ABORT("Selecting Sweep " << sweepIt->first << ": " <<
+                           "Ambiguous, or no sweep selected. Check your selector " <<
+                            selectors + block->getState() << std::endl << s.sweep);
+
+         WALBERLA_LOG_PROGRESS("Creating task for sweep \"" << sweepName << "\" on block " << block->getId() );
+
+         WcTimer * taskTimer( NULL );
+         if( timing != NULL )
+         {
+            taskTimer = &( taskTimers[ nrOfTasks ] );
+            sweepTimers[ nrOfTasks ] = &( (*timing)[ sweepName ] );
+            ++nrOfTasks;
+         }
+
+#ifdef _OPENMP
+         #pragma omp task default(shared) firstprivate( block, selectedSweep, taskTimer ) depend( inout: dependency[b] )
+#endif
+         {
+            if( taskTimer != NULL )
+               taskTimer->start();
+
+            (selectedSweep->function_)( block );
+
+            if( taskTimer != NULL )
+               taskTimer->end();
+         }
+      }
+
+      // after functions may depend on the data of all blocks -> wait for all tasks
+      if( !s.afterFuncs.empty() )
+      {
+#ifdef _OPENMP
+         #pragma omp taskwait
+#endif
+         for( size_t j=0; j < s.afterFuncs.size(); ++j )
+         {
+            if( timing != NULL )
+               executeSelectable( s.afterFuncs[j].selectableFunc_, selectors, "Post-Sweep Function", *timing );
+            else
+               executeSelectable( s.afterFuncs[j].selectableFunc_, selectors, "Post-Sweep Function" );
+         }
+      }
+   }
+
+#ifdef _OPENMP
+   } // omp master
+   } // omp parallel: all tasks are completed at the implicit barrier
+#endif
+
+   for( size_t i = 0; i < nrOfTasks; ++i )
+      sweepTimers[i]->merge( taskTimers[i] );
+}
+
+
+
+} // namespace timeloop
+} // namespace walberla
@@ -0,0 +1,103 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TaskSweepTimeloop.h
+//! \ingroup timeloop
+//! \brief Timeloop that executes the sweeps block-wise as OpenMP tasks
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "SweepTimeloop.h"
+
+
+namespace walberla {
+namespace timeloop {
+
+
+
+   //*******************************************************************************************************************
+   /*! Timeloop that executes every (sweep, block) pair as an OpenMP task
+   *
+   * The SweepTimeloop executes all blocks of a sweep one after another before it starts with the next sweep. If the
+   * blocks are processed in parallel (e.g. with OpenMP inside of the sweeps), every sweep on every block ends with a
+   * barrier, and blocks with little work (partly filled with obstacles, different levels of refinement, ...) leave
+   * threads idle until the slowest block is done.
+   *
+   * The TaskSweepTimeloop instead creates one task per (sweep, block) pair. The only dependency between these tasks is
+   * the order of the sweeps on the same block: sweep n+1 on block b starts as soon as sweep n on block b is finished,
+   * independent of the state of all other blocks. There is no global barrier between two sweeps, idle threads pick
+   * up (steal) tasks of other blocks from the OpenMP runtime.
+   *
+   * Before and after functions (communication, output, ...) in general depend on the data of all blocks. Hence, all
+   * tasks that were created so far are completed before a before/after function is executed. All before/after
+   * functions (and therefore all MPI calls) are executed by the thread that calls run()/singleStep().
+   *
+   * Requirements for the registered sweeps:
+   *  - The same sweep object must be safe to be called concurrently for different blocks. Sweeps that only work with
+   *    block data are fine. Temporary data shared between blocks must be protected or kept per thread
+   *    (e.g. the temporary PDF fields of the lbm sweeps are kept per thread).
+   *  - OpenMP parallel regions inside of the sweeps are executed with one thread only (nested parallelism is disabled
+   *    by default), the parallelism comes from processing different blocks at the same time. Hence, there should be
+   *    (significantly) more blocks per process than threads.
+   *
+   * If waLBerla is built without OpenMP (or the compiler does not support OpenMP 4.0 task dependencies), the
+   * TaskSweepTimeloop behaves exactly like the SweepTimeloop.
+   *
+   * If a timing pool is passed, the timer of each sweep accumulates the time of all blocks, i.e., the sum of the
+   * times of all threads.
+   *
+   * \ingroup timeloop
+   */
+   //*******************************************************************************************************************
+   class TaskSweepTimeloop : public SweepTimeloop
+   {
+   public:
+
+      TaskSweepTimeloop( BlockStorage & blockStorage, uint_t nrOfTimeSteps )
+         : SweepTimeloop( blockStorage, nrOfTimeSteps ) {}
+
+      TaskSweepTimeloop( const shared_ptr<StructuredBlockStorage> & structuredBlockStorage, uint_t nrOfTimeSteps )
+         : SweepTimeloop( structuredBlockStorage, nrOfTimeSteps ) {}
+
+      virtual ~TaskSweepTimeloop() {}
+
+   protected:
+
+      virtual void doTimeStep(const Set<SUID> &selectors);
+      virtual void doTimeStep(const Set<SUID> &selectors, WcTimingPool &tp);
+
+   private:
+
+      void executeTasks( const Set<SUID> & selectors, WcTimingPool * timing );
+   };
+
+
+
+} // namespace timeloop
+} // namespace walberla
+
+
+
+//======================================================================================================================
+//
+//  EXPORT
+//
+//======================================================================================================================
+
+namespace walberla {
+   using timeloop::TaskSweepTimeloop;
+}
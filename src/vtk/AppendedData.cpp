@@ -0,0 +1,312 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AppendedData.cpp
+//! \ingroup vtk
+//
+//======================================================================================================================
+
+#include "AppendedData.h"
+
+#include "core/Abort.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/debug/Debug.h"
+#include "core/mpi/MPIManager.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#ifdef WALBERLA_BUILD_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+
+namespace walberla {
+namespace vtk {
+
+
+
+const uint_t AppendedData::OFFSET_WIDTH;
+const uint_t AppendedData::BLOCK_SIZE;
+
+static const std::string appendedDataBegin( " <AppendedData encoding=\"raw\">\n  _" );
+static const std::string appendedDataEnd( "\n </AppendedData>\n</VTKFile>\n" );
+
+
+
+AppendedData::AppendedData( const bool compress ) : compress_( compress ), formatWritten_( false )
+{
+#ifndef WALBERLA_BUILD_WITH_ZLIB
+   if( compress )
+      WALBERLA_ABORT( "Compression of appended VTK data requires zlib. Activate WALBERLA_BUILD_WITH_ZLIB in your CMake configuration." );
+#endif
+}
+
+
+
+std::string AppendedData::compressorAttribute() const
+{
+   return compress_ ? std::string( " compressor=\"vtkZLibDataCompressor\"" ) : std::string();
+}
+
+
+
+void AppendedData::writeFormat( std::ostream & os )
+{
+   WALBERLA_ASSERT( !formatWritten_ );
+
+   os << "format=\"appended\" offset=\"";
+
+   const std::streamoff position = os.tellp();
+   WALBERLA_CHECK_GREATER_EQUAL( position, std::streamoff(0), "Appended VTK data can only be used with streams that support tellp()" );
+   placeholders_.push_back( std::make_pair( std::string::size_type( position ), uint64_c( data_.size() ) ) );
+
+   os << std::string( OFFSET_WIDTH, '0' ) << "\"";
+
+   formatWritten_ = true;
+}
+
+
+
+void AppendedData::append( const std::vector< char > & data )
+{
+   WALBERLA_ASSERT( formatWritten_ );
+   formatWritten_ = false;
+
+   if( compress_ )
+   {
+      appendCompressed( data );
+      return;
+   }
+
+   WALBERLA_CHECK_LESS_EQUAL( data.size(), size_t( std::numeric_limits< uint32_t >::max() ),
+                              "The size of one VTK DataArray must not exceed " << std::numeric_limits< uint32_t >::max() << " bytes" );
+
+   appendRaw( uint32_c( data.size() ) );
+   data_.insert( data_.end(), data.begin(), data.end() );
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   The data is split into blocks of BLOCK_SIZE bytes which are compressed individually. The header corresponds to the
+*   format expected by the vtkZLibDataCompressor: [#blocks][block size][size of the last block][compressed sizes].
+*   The size of the last block is zero if the last block is a full block.
+*/
+//**********************************************************************************************************************
+#ifdef WALBERLA_BUILD_WITH_ZLIB
+
+void AppendedData::appendCompressed( const std::vector< char > & data )
+{
+   const uint_t lastBlockSize  = uint_c( data.size() ) % BLOCK_SIZE;
+   const uint_t numberOfBlocks = uint_c( data.size() ) / BLOCK_SIZE + ( ( lastBlockSize > uint_t(0) ) ? uint_t(1) : uint_t(0) );
+
+   appendRaw( uint32_c( numberOfBlocks ) );
+   appendRaw( uint32_c( BLOCK_SIZE ) );
+   appendRaw( uint32_c( lastBlockSize ) );
+
+   const size_t compressedSizes = data_.size();
+   data_.resize( data_.size() + numberOfBlocks * sizeof( uint32_t ) );
+
+   std::vector< Bytef > buffer( compressBound( uLong( BLOCK_SIZE ) ) );
+
+   for( uint_t b = 0; b != numberOfBlocks; ++b )
+   {
+      const uLong blockSize = uLong( ( b == numberOfBlocks - uint_t(1) && lastBlockSize > uint_t(0) ) ? lastBlockSize : BLOCK_SIZE );
+      uLongf compressedSize = uLongf( buffer.size() );
+
+      const int result = compress2( &buffer[0], &compressedSize, reinterpret_cast< const Bytef * >( &data[ b * BLOCK_SIZE ] ),
+                                    blockSize, Z_DEFAULT_COMPRESSION );
+      if( result != Z_OK )
+         WALBERLA_ABORT( "zlib compression of appended VTK data failed (error code " << result << ")" );
+
+      const uint32_t size = uint32_c( compressedSize );
+      std::memcpy( &data_[ compressedSizes + b * sizeof( uint32_t ) ], &size, sizeof( uint32_t ) );
+      data_.insert( data_.end(), reinterpret_cast< const char * >( &buffer[0] ), reinterpret_cast< const char * >( &buffer[0] ) + compressedSize );
+   }
+}
+
+#else
+
+void AppendedData::appendCompressed( const std::vector< char > & )
+{
+   WALBERLA_ABORT( "Compression of appended VTK data requires zlib. Activate WALBERLA_BUILD_WITH_ZLIB in your CMake configuration." );
+}
+
+#endif
+
+
+
+void AppendedData::insertOffsets( std::string & xmlPart, MPI_Comm comm ) const
+{
+   WALBERLA_ASSERT( !formatWritten_ );
+
+   uint64_t offset = uint64_t(0);
+
+   WALBERLA_MPI_SECTION()
+   {
+      int rank;
+      MPI_Comm_rank( comm, &rank );
+
+      uint64_t localSize = uint64_c( data_.size() );
+      MPI_Exscan( &localSize, &offset, 1, MPITrait< uint64_t >::type(), MPI_SUM, comm );
+      if( rank == 0 )
+         offset = uint64_t(0);
+   }
+
+   for( auto placeholder = placeholders_.begin(); placeholder != placeholders_.end(); ++placeholder )
+   {
+      std::ostringstream oss;
+      oss << std::setw( int_c( OFFSET_WIDTH ) ) << std::setfill( '0' ) << ( offset + placeholder->second );
+      WALBERLA_ASSERT_EQUAL( oss.str().size(), OFFSET_WIDTH );
+      WALBERLA_ASSERT_EQUAL( xmlPart.compare( placeholder->first, OFFSET_WIDTH, std::string( OFFSET_WIDTH, '0' ) ), 0 );
+
+      xmlPart.replace( placeholder->first, OFFSET_WIDTH, oss.str() );
+   }
+}
+
+
+
+static void writeAll( MPI_File & mpiFile, const std::string & filename, const MPI_Offset offset, const char * data, const size_t size )
+{
+   int result = MPI_File_set_view( mpiFile, offset, MPITrait<char>::type(), MPITrait<char>::type(), const_cast<char*>( "native" ), MPI_INFO_NULL );
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Internal MPI-IO error! MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+   result = MPI_File_write_all( mpiFile, const_cast<char*>( data ), int_c( size ), MPITrait<char>::type(), MPI_STATUS_IGNORE );
+   if( result != MPI_SUCCESS )
+      WALBERLA_ABORT( "Error while writing to file \"" << filename << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+}
+
+
+
+/// exclusive scan and sum of the sizes of the XML part and the binary part
+static void computeOffsets( uint64_t sizes[2], uint64_t offsets[2], uint64_t totals[2], MPI_Comm comm )
+{
+   offsets[0] = offsets[1] = uint64_t(0);
+   totals[0] = sizes[0];
+   totals[1] = sizes[1];
+
+   WALBERLA_MPI_SECTION()
+   {
+      int rank;
+      MPI_Comm_rank( comm, &rank );
+
+      MPI_Exscan( sizes, offsets, 2, MPITrait< uint64_t >::type(), MPI_SUM, comm );
+      if( rank == 0 )
+         offsets[0] = offsets[1] = uint64_t(0);
+      MPI_Allreduce( sizes, totals, 2, MPITrait< uint64_t >::type(), MPI_SUM, comm );
+   }
+}
+
+
+
+void AppendedData::writeFile( const std::string & filename, std::string xmlPart, MPI_Comm comm, mpi::AsyncFileWriter * asyncWriter ) const
+{
+   if( asyncWriter != NULL )
+   {
+      bool lastRank = true;
+      WALBERLA_MPI_SECTION()
+      {
+         int rank, numProcesses;
+         MPI_Comm_rank( comm, &rank         );
+         MPI_Comm_size( comm, &numProcesses );
+         lastRank = ( rank == numProcesses - 1 );
+      }
+
+      if( lastRank )
+         xmlPart.append( appendedDataBegin );
+
+      uint64_t sizes[] = { uint64_c( xmlPart.size() ), uint64_c( data_.size() ) };
+      uint64_t offsets[2];
+      uint64_t totals[2];
+      computeOffsets( sizes, offsets, totals, comm );
+
+      std::vector< mpi::AsyncFileWriter::Segment > segments;
+      segments.push_back( mpi::AsyncFileWriter::Segment( offsets[0] ) );
+      segments.back().data_.assign( xmlPart.begin(), xmlPart.end() );
+      segments.push_back( mpi::AsyncFileWriter::Segment( totals[0] + offsets[1] ) );
+      segments.back().data_ = data_;
+      if( lastRank )
+      {
+         segments.push_back( mpi::AsyncFileWriter::Segment( totals[0] + totals[1] ) );
+         segments.back().data_.assign( appendedDataEnd.begin(), appendedDataEnd.end() );
+      }
+
+      asyncWriter->write( filename, totals[0] + totals[1] + appendedDataEnd.size(), segments, comm );
+      return;
+   }
+
+   WALBERLA_NON_MPI_SECTION()
+   {
+      std::ofstream ofs( filename.c_str(), std::ofstream::binary );
+      ofs << xmlPart << appendedDataBegin;
+      if( !data_.empty() )
+         ofs.write( &data_[0], std::streamsize( data_.size() ) );
+      ofs << appendedDataEnd;
+      ofs.close();
+   }
+
+   WALBERLA_MPI_SECTION()
+   {
+      int rank, numProcesses;
+      MPI_Comm_rank( comm, &rank         );
+      MPI_Comm_size( comm, &numProcesses );
+
+      if( rank == numProcesses - 1 )
+         xmlPart.append( appendedDataBegin );
+
+      if( xmlPart.size() > numeric_cast< std::string::size_type >( std::numeric_limits<int>::max() ) ||
+          data_.size()   > numeric_cast< size_t >( std::numeric_limits<int>::max() ) )
+         WALBERLA_ABORT( "Appended VTK output does not support more than " << std::numeric_limits<int>::max() << " bytes per process!" );
+
+      // all XML parts are stored first, followed by all binary parts -> two exclusive scans
+
+      uint64_t sizes[] = { uint64_c( xmlPart.size() ), uint64_c( data_.size() ) };
+      uint64_t offsets[2];
+      uint64_t totals[2];
+      computeOffsets( sizes, offsets, totals, comm );
+
+      MPI_File mpiFile;
+      int result = MPI_File_open( comm, const_cast<char*>( filename.c_str() ), MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &mpiFile );
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while opening file \"" << filename << "\" for writing. MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+
+      MPI_File_set_size( mpiFile, numeric_cast< MPI_Offset >( totals[0] + totals[1] + appendedDataEnd.size() ) );
+
+      const MPI_Offset xmlOffset    = numeric_cast< MPI_Offset >( offsets[0] );
+      const MPI_Offset binaryOffset = numeric_cast< MPI_Offset >( totals[0] + offsets[1] );
+
+      writeAll( mpiFile, filename, xmlOffset, xmlPart.empty() ? NULL : &xmlPart[0], xmlPart.size() );
+      writeAll( mpiFile, filename, binaryOffset, data_.empty() ? NULL : &data_[0], data_.size() );
+
+      const bool lastRank = ( rank == numProcesses - 1 );
+      writeAll( mpiFile, filename, numeric_cast< MPI_Offset >( totals[0] + totals[1] ), lastRank ? appendedDataEnd.c_str() : NULL,
+                lastRank ? appendedDataEnd.size() : size_t(0) );
+
+      result = MPI_File_close( &mpiFile );
+      if( result != MPI_SUCCESS )
+         WALBERLA_ABORT( "Error while closing file \"" << filename << "\". MPI Error is \"" << MPIManager::instance()->getMPIErrorString( result ) << "\"" );
+   }
+}
+
+
+
+} // namespace vtk
+} // namespace walberla
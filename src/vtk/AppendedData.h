@@ -0,0 +1,108 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AppendedData.h
+//! \ingroup vtk
+//
+//======================================================================================================================
+
+#pragma once
+
+#include "core/DataTypes.h"
+#include "core/mpi/AsyncFileWriter.h"
+#include "core/mpi/MPIWrapper.h"
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace walberla {
+namespace vtk {
+
+
+
+//**********************************************************************************************************************
+/*!
+*   \brief Collects the raw binary data of all DataArrays of one process for the "appended" VTK XML format
+*
+*   Instead of base64 encoding every DataArray inline, the DataArray elements only reference an offset into the
+*   <AppendedData encoding="raw"> section at the end of the file. All processes write their XML part and their binary
+*   part into one shared file with collective MPI I/O. Since the offsets of a process depend on the amount of binary
+*   data of all processes with a lower rank, fixed-width placeholders are written into the XML part which are replaced
+*   by the global offsets (obtained by an exclusive scan) right before the file is written.
+*
+*   Each appended data block is preceded by the header defined by the VTK file format: a 32bit unsigned int value
+*   specifying the size of the data (in bytes), or - if compression is activated - the header of the
+*   vtkZLibDataCompressor (number of blocks, uncompressed block size, uncompressed size of the last block, compressed
+*   size of every block). Compression requires waLBerla to be built with zlib (WALBERLA_BUILD_WITH_ZLIB).
+*/
+//**********************************************************************************************************************
+
+class AppendedData {
+
+public:
+
+   AppendedData( const bool compress = false );
+
+   bool compressed() const { return compress_; }
+
+   /// attribute that must be added to the VTKFile element (empty if no compression is used)
+   std::string compressorAttribute() const;
+
+   /// writes the format and offset attributes of a DataArray element to 'os' and remembers the position of the offset
+   void writeFormat( std::ostream & os );
+   /// appends the data of the DataArray whose format has been written last
+   void append( const std::vector< char > & data );
+
+   void clear() { placeholders_.clear(); data_.clear(); }
+
+   const std::vector< char > & data() const { return data_; }
+
+   /// replaces the offset placeholders in 'xmlPart' (must be collectively called by all processes in 'comm')
+   void insertOffsets( std::string & xmlPart, MPI_Comm comm ) const;
+
+   /// Writes all XML parts (in rank order) followed by all binary parts (in rank order) to one shared file. The
+   /// process with the highest rank opens and closes the <AppendedData> section. Must be called collectively after
+   /// 'insertOffsets'. If 'asyncWriter' is given, the file is written in the background by 'asyncWriter'.
+   void writeFile( const std::string & filename, std::string xmlPart, MPI_Comm comm, mpi::AsyncFileWriter * asyncWriter = NULL ) const;
+
+   static const uint_t OFFSET_WIDTH = 20; // number of digits reserved for an offset
+   static const uint_t BLOCK_SIZE = 32768; // uncompressed size of one compressed block
+
+private:
+
+   void appendCompressed( const std::vector< char > & data );
+
+   template< typename T > void appendRaw( const T & value )
+   {
+      const char * bytePointer = reinterpret_cast< const char * >( &value );
+      data_.insert( data_.end(), bytePointer, bytePointer + sizeof( T ) );
+   }
+
+   bool compress_;
+
+   std::vector< std::pair< std::string::size_type, uint64_t > > placeholders_; // position in the XML part <-> local offset
+   std::vector< char > data_;
+
+   bool formatWritten_; // only used for consistency checks: every call to 'writeFormat' must be followed by 'append'
+
+}; // class AppendedData
+
+
+
+} // namespace vtk
+} // namespace walberla
@@ -73,6 +73,9 @@ public:
 
    void toStream( std::ostream& os );
 
+   /// raw (not yet encoded) bytes that were passed to this Base64Writer
+   const std::vector<char> & data() const { return buffer_; }
+
 private:
 
    void encodeblock( unsigned char in[3], unsigned char out[4], int len )
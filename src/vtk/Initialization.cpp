@@ -206,6 +206,9 @@ void initializeVTKOutput( std::map< std::string, SelectableOutputFunction > & ou
       if( initialWriteCallsToSkip > uint_t(0) )
          vtkOutput->setInitialWriteCallsToSkip( initialWriteCallsToSkip );
 
+      if( block->getParameter< bool >( "appendedRawData", false ) )
+         vtkOutput->enableAppendedRawData( block->getParameter< bool >( "compressed", false ) );
+
       const real_t samplingResolution = block->getParameter< real_t >( "samplingResolution", real_c(-1) );
       vtkOutput->setSamplingResolution( samplingResolution );
 
@@ -451,6 +454,11 @@ void initializeVTKOutput( std::map< std::string, SelectableOutputFunction > & ou
 *
 *         useMPIIO                  [boolean]; // use MPI I/O to write only one file per time step
 *                                              // (optional, default=true)
+*         appendedRawData           [boolean]; // store block data as raw binary data in the <AppendedData>
+*                                              // section instead of base64 encoding it, requires binary output
+*                                              // and MPI I/O (optional, default=false)
+*         compressed                [boolean]; // zlib compression of the appended raw data, requires
+*                                              // WALBERLA_BUILD_WITH_ZLIB (optional, default=false)
 *
 *         // You can either specify "samplingResolution" or "samplingDx", "samplingDy", and "samplingDz"
 *         samplingResolution [floating point value]; // "samplingResolution VALUE" has the same effect as
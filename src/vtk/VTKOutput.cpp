@@ -213,6 +213,9 @@ void VTKOutput::forceWrite( uint_t number, const bool immediatelyWriteCollectors
       }
       else
       {
+         if( appendedData_ )
+            appendedData_->clear();
+
          std::ostringstream oss;
          writeBlockPieces( oss, requiredStates, incompatibleStates );
 
@@ -1260,18 +1263,18 @@ void VTKOutput::writeVTUPiece( std::ostream& ofs, const IBlock& block, const Cel
    if (ghostLayers_ > 0)
    {
       ofs << "    <DataArray type=\"" << vtk::typeToString< uint8_t >()
-          << "\" Name=\"vtkGhostLevels\" NumberOfComponents=\"1\" format=\"" << format_ << "\">\n"
-          << "     ";
+          << "\" Name=\"vtkGhostLevels\" NumberOfComponents=\"1\" "; writeFormat( ofs ); ofs << ">\n";
 
       if (binary_)
       {
          Base64Writer base64;
          for (auto cell = cells.begin(); cell != cells.end(); ++cell)
             base64 << ghostLayerNr(block, cell->x(), cell->y(), cell->z());
-         base64.toStream(ofs);
+         writeBinaryData( ofs, base64 );
       }
       else
       {
+         ofs << "     ";
          for (auto cell = cells.begin(); cell != cells.end(); ++cell)
             ofs << uint_c(ghostLayerNr(block, cell->x(), cell->y(), cell->z())) << " ";
          ofs << "\n";
@@ -1371,7 +1374,7 @@ void VTKOutput::writeVTUHeaderPiece( std::ostream& ofs, const uint_t numberOfCel
 {
    ofs << "  <Piece NumberOfPoints=\"" << vc.size() << "\" NumberOfCells=\"" << numberOfCells << "\">\n"
        << "   <Points>\n"
-       << "    <DataArray type=\"" << vtk::typeToString< float >() << "\" NumberOfComponents=\"3\" format=\"" << format_ << "\">\n";
+       << "    <DataArray type=\"" << vtk::typeToString< float >() << "\" NumberOfComponents=\"3\" "; writeFormat( ofs ); ofs << ">\n";
 
    if( binary_ )
    {
@@ -1379,7 +1382,7 @@ void VTKOutput::writeVTUHeaderPiece( std::ostream& ofs, const uint_t numberOfCel
       for( auto vertex = vc.begin(); vertex != vc.end(); ++vertex )
          base64 << numeric_cast<float>( ( *vertex ).get<0>() ) << numeric_cast<float>( ( *vertex ).get<1>() )
                 << numeric_cast<float>( ( *vertex ).get<2>() );
-      ofs << "     "; base64.toStream( ofs );
+      writeBinaryData( ofs, base64 );
    }
    else for( auto vertex = vc.begin(); vertex != vc.end(); ++vertex )
       ofs << "     " << numeric_cast<float>( ( *vertex ).get<0>() ) << " " << numeric_cast<float>( ( *vertex ).get<1>() )
@@ -1388,41 +1391,41 @@ void VTKOutput::writeVTUHeaderPiece( std::ostream& ofs, const uint_t numberOfCel
    ofs << "    </DataArray>\n"
        << "   </Points>\n"
        << "   <Cells>\n"
-       << "    <DataArray type=\"" << vtk::typeToString< Index >() << "\" Name=\"connectivity\" format=\"" << format_ << "\">\n";
+       << "    <DataArray type=\"" << vtk::typeToString< Index >() << "\" Name=\"connectivity\" "; writeFormat( ofs ); ofs << ">\n";
 
    if( binary_ )
    {
       Base64Writer base64;
       for( uint_t i = 0; i != ci.size(); i += 8 )
          base64 << ci[ i ] << ci[ i + 1 ] << ci[ i + 2 ] << ci[ i + 3 ] << ci[ i + 4 ] << ci[ i + 5 ] << ci[ i + 6 ] << ci[ i + 7 ];
-      ofs << "     "; base64.toStream( ofs );
+      writeBinaryData( ofs, base64 );
    }
    else for( uint_t i = 0; i != ci.size(); i += 8 )
       ofs << "     " << ci[ i ] << " " << ci[ i + 1 ] << " " << ci[ i + 2 ] << " " << ci[ i + 3 ] << " "
           << ci[ i + 4 ] << " " << ci[ i + 5 ] << " " << ci[ i + 6 ] << " " << ci[ i + 7 ] << "\n";
 
    ofs << "    </DataArray>\n"
-       << "    <DataArray type=\"" << vtk::typeToString< Index >() << "\" Name=\"offsets\" format=\"" << format_ << "\">\n";
+       << "    <DataArray type=\"" << vtk::typeToString< Index >() << "\" Name=\"offsets\" "; writeFormat( ofs ); ofs << ">\n";
 
    if( binary_ )
    {
       Base64Writer base64;
       for( uint_t i = 0; i != ci.size(); i += 8 )
          base64 << numeric_cast<Index>( i + uint_c( 8 ) );
-      ofs << "     "; base64.toStream( ofs );
+      writeBinaryData( ofs, base64 );
    }
    else for( uint_t i = 0; i != ci.size(); i += 8 )
       ofs << "     " << numeric_cast<Index>( i + uint_c( 8 ) ) << "\n";
 
    ofs << "    </DataArray>\n"
-       << "    <DataArray type=\"" << vtk::typeToString< uint8_t >() << "\" Name=\"types\" format=\"" << format_ << "\">\n";
+       << "    <DataArray type=\"" << vtk::typeToString< uint8_t >() << "\" Name=\"types\" "; writeFormat( ofs ); ofs << ">\n";
 
    if( binary_ )
    {
       Base64Writer base64;
       for( uint_t i = 0; i != ci.size(); i += 8 )
          base64 << uint8_c( 11 );
-      ofs << "     "; base64.toStream( ofs );
+      writeBinaryData( ofs, base64 );
    }
    else for( uint_t i = 0; i != ci.size(); i += 8 )
       ofs << "     " << "11" << "\n";
@@ -1534,7 +1537,7 @@ void VTKOutput::writeCellData( std::ostream& ofs, const IBlock& block, const Cel
       (*writer)->configure( block, *blockStorage_ );
 
       ofs << "    <DataArray type=\"" << (*writer)->typeString() << "\" Name=\"" << (*writer)->identifier()
-                                      << "\" NumberOfComponents=\"" << (*writer)->fSize() << "\" format=\"" << format_ << "\">\n";
+                                      << "\" NumberOfComponents=\"" << (*writer)->fSize() << "\" "; writeFormat( ofs ); ofs << ">\n";
 
       if( binary_ )
       {
@@ -1542,7 +1545,7 @@ void VTKOutput::writeCellData( std::ostream& ofs, const IBlock& block, const Cel
          for( auto cell = cells.begin(); cell != cells.end(); ++cell )
             for( uint_t f = 0; f != (*writer)->fSize(); ++f )
                (*writer)->push( base64, cell->x(), cell->y(), cell->z(), cell_idx_c(f) );
-         ofs << "     "; base64.toStream( ofs );
+         writeBinaryData( ofs, base64 );
       }
       else
       {
@@ -1571,7 +1574,7 @@ void VTKOutput::writeCellData( std::ostream& ofs, const IBlock& block, const std
       (*writer)->configure( block, *blockStorage_ );
 
       ofs << "    <DataArray type=\"" << (*writer)->typeString() << "\" Name=\"" << (*writer)->identifier()
-                                      << "\" NumberOfComponents=\"" << (*writer)->fSize() << "\" format=\"" << format_ << "\">\n";
+                                      << "\" NumberOfComponents=\"" << (*writer)->fSize() << "\" "; writeFormat( ofs ); ofs << ">\n";
 
       if( binary_ )
       {
@@ -1582,7 +1585,7 @@ void VTKOutput::writeCellData( std::ostream& ofs, const IBlock& block, const std
                                         cell->localCellX_,    cell->localCellY_,    cell->localCellZ_,
                                         cell->globalX_   ,    cell->globalY_,       cell->globalZ_,
                                         samplingDx_,          samplingDy_,          samplingDz_ );
-         ofs << "     "; base64.toStream( ofs );
+         writeBinaryData( ofs, base64 );
       }
       else
       {
@@ -1605,6 +1608,28 @@ void VTKOutput::writeCellData( std::ostream& ofs, const IBlock& block, const std
 
 
 
+void VTKOutput::writeFormat( std::ostream& ofs ) const
+{
+   if( appendedData_ )
+      appendedData_->writeFormat( ofs );
+   else
+      ofs << "format=\"" << format_ << "\"";
+}
+
+
+
+void VTKOutput::writeBinaryData( std::ostream& ofs, Base64Writer& base64 ) const
+{
+   if( appendedData_ )
+      appendedData_->append( base64.data() );
+   else
+   {
+      ofs << "     "; base64.toStream( ofs );
+   }
+}
+
+
+
 void VTKOutput::writeCollectors( const bool barrier )
 {
    if( barrier )
@@ -1815,6 +1840,9 @@ bool VTKOutput::writeCombinedVTI( std::string localPart, const uint_t collector
    if( noData )
       return false;
 
+   if( appendedData_ )
+      appendedData_->insertOffsets( localPart, comm );
+
    std::ostringstream collection;
    collection << baseFolder_ << "/" << identifier_ << "/" << executionFolder_ << "_" << collector << ".vti";
 
@@ -1826,7 +1854,7 @@ bool VTKOutput::writeCombinedVTI( std::string localPart, const uint_t collector
       std::ostringstream header;
 
       header << "<?xml version=\"1.0\"?>\n"
-         << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"" << endianness_ << "\">\n"
+         << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"" << endianness_ << "\"" << compressorAttribute() << ">\n"
          << " <ImageData WholeExtent=\"" << cellBB.xMin() << " " << ( cellBB.xMax() + 1 ) << " "
          << cellBB.yMin() << " " << ( cellBB.yMax() + 1 ) << " "
          << cellBB.zMin() << " " << ( cellBB.zMax() + 1 ) << "\""
@@ -1839,12 +1867,24 @@ bool VTKOutput::writeCombinedVTI( std::string localPart, const uint_t collector
 
    localPart.append( "\n\n" );
 
+   if( appendedData_ )
+   {
+      if( rank == numProcesses - 1 )
+         localPart.append( " </ImageData>\n" );
+
+      appendedData_->writeFile( collection.str(), localPart, comm, asyncWriter_.get() );
+      return true;
+   }
+
    if( rank == numProcesses - 1 )
    {
       localPart.append( " </ImageData>\n</VTKFile>\n" );
    }
 
-   mpi::writeMPITextFile( collection.str(), localPart, comm );
+   if( asyncWriter_ )
+      asyncWriter_->writeMPITextFile( collection.str(), localPart, comm );
+   else
+      mpi::writeMPITextFile( collection.str(), localPart, comm );
 
    return true;
 }
@@ -1864,6 +1904,9 @@ bool VTKOutput::writeCombinedVTI_sampled( std::string localPart, const uint_t co
    if( noData )
       return false;
 
+   if( appendedData_ )
+      appendedData_->insertOffsets( localPart, comm );
+
    std::ostringstream collection;
    collection << baseFolder_ << "/" << identifier_ << "/" << executionFolder_ << "_" << collector << ".vti";
 
@@ -1875,7 +1918,7 @@ bool VTKOutput::writeCombinedVTI_sampled( std::string localPart, const uint_t co
       const CellInterval  cellBB = getSampledCellInterval( domain );
 
       header << "<?xml version=\"1.0\"?>\n"
-         << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"" << endianness_ << "\">\n"
+         << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"" << endianness_ << "\"" << compressorAttribute() << ">\n"
          << " <ImageData WholeExtent=\"" << cellBB.xMin() << " " << ( cellBB.xMax() + 1 ) << " "
          << cellBB.yMin() << " " << ( cellBB.yMax() + 1 ) << " "
          << cellBB.zMin() << " " << ( cellBB.zMax() + 1 ) << "\""
@@ -1887,12 +1930,24 @@ bool VTKOutput::writeCombinedVTI_sampled( std::string localPart, const uint_t co
 
    localPart.append( "\n\n" );
 
+   if( appendedData_ )
+   {
+      if( rank == numProcesses - 1 )
+         localPart.append( " </ImageData>\n" );
+
+      appendedData_->writeFile( collection.str(), localPart, comm, asyncWriter_.get() );
+      return true;
+   }
+
    if( rank == numProcesses - 1 )
    {
       localPart.append( " </ImageData>\n</VTKFile>\n" );
    }
 
-   mpi::writeMPITextFile( collection.str(), localPart, comm );
+   if( asyncWriter_ )
+      asyncWriter_->writeMPITextFile( collection.str(), localPart, comm );
+   else
+      mpi::writeMPITextFile( collection.str(), localPart, comm );
 
    return true;
 }
@@ -1953,6 +2008,9 @@ bool VTKOutput::writeCombinedVTU( std::string localPart, const uint_t collector
    if( noData )
       return false;
 
+   if( appendedData_ )
+      appendedData_->insertOffsets( localPart, comm );
+
    std::ostringstream collection;
    collection << baseFolder_ << "/" << identifier_ << "/" << executionFolder_ << "_" << collector << ".vtu";
 
@@ -1960,7 +2018,7 @@ bool VTKOutput::writeCombinedVTU( std::string localPart, const uint_t collector
    {
       std::ostringstream header;
       header << "<?xml version=\"1.0\"?>\n"
-         << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"" << endianness_ << "\">\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"" << endianness_ << "\"" << compressorAttribute() << ">\n"
          << " <UnstructuredGrid GhostLevel=\"" << ghostLayers_ << "\">\n\n";
 
       localPart.insert( 0, header.str() );
@@ -1968,12 +2026,24 @@ bool VTKOutput::writeCombinedVTU( std::string localPart, const uint_t collector
 
    localPart.append( "\n\n" );
 
+   if( appendedData_ )
+   {
+      if( rank == numProcesses - 1 )
+         localPart.append( " </UnstructuredGrid>\n" );
+
+      appendedData_->writeFile( collection.str(), localPart, comm, asyncWriter_.get() );
+      return true;
+   }
+
    if( rank == numProcesses - 1 )
    {
       localPart.append( " </UnstructuredGrid>\n</VTKFile>\n" );
    }
 
-   mpi::writeMPITextFile( collection.str(), localPart, comm );
+   if( asyncWriter_ )
+      asyncWriter_->writeMPITextFile( collection.str(), localPart, comm );
+   else
+      mpi::writeMPITextFile( collection.str(), localPart, comm );
 
    return true;
 }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "AABBCellFilter.h"
+#include "AppendedData.h"
 #include "Base64Writer.h"
 #include "BlockCellDataWriter.h"
 #include "CellBBCellFilter.h"
@@ -30,6 +31,7 @@
 
 #include "core/Abort.h"
 #include "core/DataTypes.h"
+#include "core/mpi/AsyncFileWriter.h"
 
 #include "domain_decomposition/StructuredBlockStorage.h"
 
@@ -167,6 +169,10 @@ public:
    inline void setSamplingResolution( const real_t spacing );
    inline void setSamplingResolution( const real_t dx, const real_t dy, const real_t dz );
 
+   // binary block data is written as raw appended data (optionally zlib compressed) instead of base64 encoded inline data
+   inline void enableAppendedRawData( const bool compress = false );
+   inline void setAsyncFileWriter( const shared_ptr< mpi::AsyncFileWriter > & asyncWriter );
+
    void write( const bool immediatelyWriteCollectors = true,
                const int simultaneousIOOperations = 0,
                const Set<SUID>& requiredStates     = Set<SUID>::emptySet(),
@@ -261,6 +267,10 @@ private:
    void writeCellData( std::ostream& ofs, const IBlock& block, const CellVector& cells ) const;
    void writeCellData( std::ostream& ofs, const IBlock& block, const std::vector< SamplingCell >& cells ) const;
 
+   void writeFormat( std::ostream& ofs ) const;
+   void writeBinaryData( std::ostream& ofs, Base64Writer& base64 ) const;
+   std::string compressorAttribute() const { return appendedData_ ? appendedData_->compressorAttribute() : std::string(); }
+
    void writePVD();
 
    void writePVTI( const uint_t collector ) const;
@@ -306,6 +316,10 @@ private:
 
    const bool useMPIIO_;
 
+   shared_ptr< AppendedData > appendedData_; // only set if raw appended data is written
+
+   shared_ptr< mpi::AsyncFileWriter > asyncWriter_; // only set if files are written in the background
+
    const bool outputDomainDecomposition_; // if true, only the block structure (= the domain decomposition) is written to file
 
    real_t samplingDx_;
@@ -508,6 +522,52 @@ inline void VTKOutput::setSamplingResolution( const real_t dx, const real_t dy,
 
 
 
+//**********************************************************************************************************************
+/*!
+*   Instead of base64 encoding the block data of every DataArray inline, all data is stored as raw binary data in the
+*   <AppendedData> section at the end of the file. Every time step, all processes write into one shared file with
+*   collective MPI I/O. Hence, this mode requires binary output and the usage of MPI I/O. If 'compress' is true, the
+*   data is additionally compressed with zlib (requires WALBERLA_BUILD_WITH_ZLIB).
+*/
+//**********************************************************************************************************************
+inline void VTKOutput::enableAppendedRawData( const bool compress )
+{
+   if( outputDomainDecomposition_ || pointDataSource_ || polylineDataSource_ )
+      WALBERLA_ABORT( "You are trying to enable appended raw data for VTKOutput \"" << identifier_ << "\", "
+                      "but appended raw data is only supported for outputting block data/cell data." );
+   if( !binary_ )
+      WALBERLA_ABORT( "You are trying to enable appended raw data for VTKOutput \"" << identifier_ << "\", "
+                      "but this VTKOutput is configured to write ascii files." );
+   if( !useMPIIO_ )
+      WALBERLA_ABORT( "You are trying to enable appended raw data for VTKOutput \"" << identifier_ << "\", "
+                      "but this VTKOutput is configured to write one file per block.\n"
+                      "Appended raw data is only supported if all processes write into one file using MPI I/O." );
+
+   appendedData_ = make_shared< AppendedData >( compress );
+}
+
+
+
+//**********************************************************************************************************************
+/*!
+*   The files that all processes write collectively with MPI I/O are handed over to 'asyncWriter' and written in the
+*   background while the simulation continues. Hence, this mode requires the usage of MPI I/O. Several VTKOutput
+*   objects (and, e.g., field checkpoints) can share the same AsyncFileWriter. The .pvd/.pvtu/.pvti files are still
+*   written synchronously.
+*/
+//**********************************************************************************************************************
+inline void VTKOutput::setAsyncFileWriter( const shared_ptr< mpi::AsyncFileWriter > & asyncWriter )
+{
+   if( !useMPIIO_ )
+      WALBERLA_ABORT( "You are trying to set an asynchronous file writer for VTKOutput \"" << identifier_ << "\", "
+                      "but this VTKOutput is configured to write one file per block.\n"
+                      "Asynchronous output is only supported if all processes write into one file." );
+
+   asyncWriter_ = asyncWriter;
+}
+
+
+
 
 
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "AABBCellFilter.h"
+#include "AppendedData.h"
 #include "Base64Writer.h"
 #include "BlockCellDataWriter.h"
 #include "CellBBCellFilter.h"
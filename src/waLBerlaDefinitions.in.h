@@ -22,6 +22,7 @@
 #cmakedefine WALBERLA_BUILD_WITH_MPI
 #cmakedefine WALBERLA_BUILD_WITH_METIS
 #cmakedefine WALBERLA_BUILD_WITH_PARMETIS
+#cmakedefine WALBERLA_BUILD_WITH_ZLIB
 
 #cmakedefine WALBERLA_BUILD_WITH_BOOST_THREAD
 #cmakedefine WALBERLA_BUILD_WITH_PYTHON
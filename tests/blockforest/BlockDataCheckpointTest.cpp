@@ -0,0 +1,267 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BlockDataCheckpointTest.cpp
+//! \ingroup blockforest
+//! \brief Writes (delta) checkpoints and reads them into a block forest with a different process distribution
+//
+//======================================================================================================================
+
+#include "blockforest/BlockDataCheckpoint.h"
+#include "blockforest/SetupBlockForest.h"
+#include "blockforest/StructuredBlockForest.h"
+#include "blockforest/loadbalancing/StaticCurve.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/mpi/AsyncFileWriter.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace block_data_checkpoint_test {
+
+using namespace walberla;
+
+typedef field::GhostLayerField< double, 3 > FieldType;
+
+const uint_t numberOfCheckpoints = uint_t(5);
+
+
+
+static void refinementSelectionFunction( SetupBlockForest & forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+      if( block->getAABB().contains( Vector3< real_t >( real_t(75) ) ) )
+         if( !block->hasFather() )
+            block->setMarker( true );
+}
+
+static void workloadMemorySUIDAssignmentFunction( SetupBlockForest & forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      block->setMemory( memory_t(1) );
+      block->setWorkload( workload_t(1) );
+   }
+}
+
+/// distributes the blocks in reverse round-robin order -> different from the distribution of StaticLevelwiseCurveBalance
+class ReverseRoundRobin
+{
+public:
+   uint_t operator()( SetupBlockForest & forest, const uint_t numberOfProcesses, const memory_t /*perProcessMemoryLimit*/ )
+   {
+      std::vector< SetupBlock * > blocks;
+      forest.getMortonOrder( blocks );
+
+      for( uint_t i = 0; i != blocks.size(); ++i )
+         blocks[i]->assignTargetProcess( numberOfProcesses - uint_t(1) - i % numberOfProcesses );
+
+      return numberOfProcesses;
+   }
+};
+
+
+
+/// only the cells in one slice change from one checkpoint to the next
+double value( const Cell & globalCell, const uint_t checkpoint )
+{
+   double v = double( globalCell.x() ) + 100.0 * double( globalCell.y() ) + 10000.0 * double( globalCell.z() );
+   for( uint_t c = uint_t(1); c <= checkpoint; ++c )
+      if( globalCell.x() == cell_idx_c( c ) )
+         v += double( c ) * 0.1;
+   return v;
+}
+
+void setField( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & id, const uint_t checkpoint )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FieldType * field = block->getData< FieldType >( id );
+      for( auto cell = field->beginXYZ(); cell != field->end(); ++cell )
+      {
+         Cell globalCell = cell.cell();
+         blocks->transformBlockLocalToGlobalCell( globalCell, *block );
+         for( uint_t f = 0; f != FieldType::F_SIZE; ++f )
+            cell.getF( cell_idx_c( f ) ) = value( globalCell, checkpoint ) + double( f );
+      }
+   }
+}
+
+void checkField( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & id, const uint_t checkpoint )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FieldType * field = block->getData< FieldType >( id );
+      for( auto cell = field->beginXYZ(); cell != field->end(); ++cell )
+      {
+         Cell globalCell = cell.cell();
+         blocks->transformBlockLocalToGlobalCell( globalCell, *block );
+         for( uint_t f = 0; f != FieldType::F_SIZE; ++f )
+            WALBERLA_CHECK_IDENTICAL( cell.getF( cell_idx_c( f ) ), value( globalCell, checkpoint ) + double( f ) );
+      }
+   }
+}
+
+std::string filename( const uint_t checkpoint )
+{
+   return "checkpoint_" + boost::lexical_cast< std::string >( checkpoint ) + ".dat";
+}
+
+
+
+int main( int argc, char * argv[] )
+{
+   debug::enterTestMode();
+
+   mpi::Environment mpiEnv( argc, argv );
+
+   MPIManager::instance()->useWorldComm();
+
+   const uint_t numberOfProcesses = uint_c( MPIManager::instance()->numProcesses() );
+
+   SetupBlockForest sforest;
+
+   sforest.addRefinementSelectionFunction( refinementSelectionFunction );
+   sforest.addWorkloadMemorySUIDAssignmentFunction( workloadMemorySUIDAssignmentFunction );
+
+   sforest.init( AABB( 0, 0, 0, 100, 100, 100 ), uint_t(2), uint_t(2), uint_t(2), true, false, false );
+
+   sforest.balanceLoad( blockforest::StaticLevelwiseCurveBalance( true ), numberOfProcesses );
+   auto writeBlocks = make_shared< StructuredBlockForest >( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, true ),
+                                                            uint_t(6), uint_t(5), uint_t(7) );
+   writeBlocks->createCellBoundingBoxes();
+
+   sforest.balanceLoad( ReverseRoundRobin(), numberOfProcesses );
+   auto readBlocks = make_shared< StructuredBlockForest >( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, true ),
+                                                           uint_t(6), uint_t(5), uint_t(7) );
+   readBlocks->createCellBoundingBoxes();
+
+   const BlockDataID writeFieldId = field::addToStorage< FieldType >( writeBlocks, "field", 0.0, field::fzyx, uint_t(1) );
+   const BlockDataID readFieldId  = field::addToStorage< FieldType >( readBlocks,  "field", 0.0, field::fzyx, uint_t(1) );
+
+   // full checkpoint, 2 delta checkpoints, full checkpoint, delta checkpoint (the last ones are written asynchronously)
+
+   std::vector< uintmax_t > fileSizes;
+   {
+      BlockDataCheckpoint checkpoint( writeBlocks->getBlockForestPointer(), writeFieldId, true, uint_t(2) );
+      mpi::AsyncFileWriter asyncWriter;
+
+      for( uint_t c = 0; c != numberOfCheckpoints; ++c )
+      {
+         setField( writeBlocks, writeFieldId, c );
+         checkpoint.write( filename( c ), ( c >= uint_t(3) ) ? &asyncWriter : NULL );
+      }
+
+      asyncWriter.flush();
+      WALBERLA_MPI_BARRIER();
+
+      for( uint_t c = 0; c != numberOfCheckpoints; ++c )
+         fileSizes.push_back( boost::filesystem::file_size( filename( c ) ) );
+   }
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Checkpoint sizes: " << fileSizes[0] << " (full), " << fileSizes[1] << " (delta), " << fileSizes[2] << " (delta), "
+                                                   << fileSizes[3] << " (full), " << fileSizes[4] << " (delta)" );
+
+   WALBERLA_CHECK_LESS( fileSizes[1], fileSizes[0] / uintmax_t(4) );
+   WALBERLA_CHECK_LESS( fileSizes[2], fileSizes[0] / uintmax_t(4) );
+   WALBERLA_CHECK_GREATER( fileSizes[3], fileSizes[2] );
+   WALBERLA_CHECK_LESS( fileSizes[4], fileSizes[3] / uintmax_t(4) );
+
+   for( uint_t c = 0; c != numberOfCheckpoints; ++c )
+   {
+      BlockDataCheckpoint checkpoint( readBlocks->getBlockForestPointer(), readFieldId );
+      setField( readBlocks, readFieldId, numberOfCheckpoints ); // some other state
+      checkpoint.read( filename( c ) );
+      checkField( readBlocks, readFieldId, c );
+   }
+
+   // uncompressed checkpoint, delta to a checkpoint that was read from file
+
+   {
+      BlockDataCheckpoint checkpoint( readBlocks->getBlockForestPointer(), readFieldId, false, uint_t(3) );
+      checkpoint.read( filename( 2 ) );
+      setField( readBlocks, readFieldId, 3 );
+      checkpoint.write( "checkpoint_uncompressed.dat" );
+      WALBERLA_MPI_BARRIER();
+
+      BlockDataCheckpoint reader( writeBlocks->getBlockForestPointer(), writeFieldId );
+      reader.read( "checkpoint_uncompressed.dat" );
+      checkField( writeBlocks, writeFieldId, 3 );
+   }
+
+   // reusing a file name (A, A, A) and alternating file names (A, B, A): a delta must never overwrite a file of its own
+   // chain, hence the third checkpoint must be a full checkpoint in both cases
+
+   {
+      BlockDataCheckpoint checkpoint( writeBlocks->getBlockForestPointer(), writeFieldId, true, uint_t(4) );
+      for( uint_t c = 0; c != uint_t(3); ++c )
+      {
+         setField( writeBlocks, writeFieldId, c );
+         checkpoint.write( "checkpoint_reused.dat" );
+         WALBERLA_MPI_BARRIER();
+
+         BlockDataCheckpoint reader( readBlocks->getBlockForestPointer(), readFieldId );
+         setField( readBlocks, readFieldId, numberOfCheckpoints );
+         reader.read( "checkpoint_reused.dat" );
+         checkField( readBlocks, readFieldId, c );
+      }
+
+      WALBERLA_CHECK_GREATER( boost::filesystem::file_size( "checkpoint_reused.dat" ), fileSizes[0] / uintmax_t(2) );
+
+      const std::string alternating[] = { "checkpoint_A.dat", "checkpoint_B.dat", "checkpoint_A.dat" };
+      for( uint_t c = 0; c != uint_t(3); ++c )
+      {
+         setField( writeBlocks, writeFieldId, c );
+         checkpoint.write( alternating[c] );
+      }
+      WALBERLA_MPI_BARRIER();
+
+      WALBERLA_CHECK_GREATER( boost::filesystem::file_size( "checkpoint_A.dat" ), fileSizes[0] / uintmax_t(2) );
+
+      BlockDataCheckpoint reader( readBlocks->getBlockForestPointer(), readFieldId );
+      setField( readBlocks, readFieldId, numberOfCheckpoints );
+      reader.read( "checkpoint_A.dat" );
+      checkField( readBlocks, readFieldId, 2 );
+   }
+
+   WALBERLA_MPI_BARRIER();
+   WALBERLA_ROOT_SECTION()
+   {
+      for( uint_t c = 0; c != numberOfCheckpoints; ++c )
+         boost::filesystem::remove( filename( c ) );
+      boost::filesystem::remove( "checkpoint_uncompressed.dat" );
+      boost::filesystem::remove( "checkpoint_reused.dat" );
+      boost::filesystem::remove( "checkpoint_A.dat" );
+      boost::filesystem::remove( "checkpoint_B.dat" );
+   }
+
+   return EXIT_SUCCESS;
+}
+
+}
+
+int main( int argc, char * argv[] )
+{
+   return block_data_checkpoint_test::main( argc, argv );
+}
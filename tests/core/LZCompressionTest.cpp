@@ -0,0 +1,96 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file LZCompressionTest.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "core/LZCompression.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+using namespace walberla;
+
+
+
+std::vector< uint8_t > compressAndDecompress( const std::vector< uint8_t > & data )
+{
+   std::vector< uint8_t > compressed;
+   lzCompress( data, compressed );
+
+   std::vector< uint8_t > decompressed( data.size() );
+   WALBERLA_CHECK( lzDecompress( compressed, decompressed ) );
+   WALBERLA_CHECK( decompressed == data );
+
+   // wrong uncompressed size
+   std::vector< uint8_t > tooLarge( data.size() + uint_t(1) );
+   WALBERLA_CHECK( !lzDecompress( compressed, tooLarge ) );
+
+   return compressed;
+}
+
+
+
+int main( int /*argc*/, char** /*argv*/ )
+{
+   debug::enterTestMode();
+
+   // data that is too small for matches
+
+   for( uint_t size = 0; size != 20; ++size )
+      compressAndDecompress( std::vector< uint8_t >( size, uint8_t(42) ) );
+
+   // long runs of zeros (+ long literal/match lengths)
+
+   std::vector< uint8_t > zeros( 100000, uint8_t(0) );
+   zeros[ 50000 ] = uint8_t(1);
+   WALBERLA_CHECK_LESS( compressAndDecompress( zeros ).size(), uint_t(1000) );
+
+   // random data (incompressible, long literal runs)
+
+   std::vector< uint8_t > random( 70000 );
+   for( auto it = random.begin(); it != random.end(); ++it )
+      *it = uint8_c( math::intRandom< int >( 0, 255 ) );
+   WALBERLA_CHECK_LESS_EQUAL( compressAndDecompress( random ).size(), random.size() + random.size() / uint_t(255) + uint_t(16) );
+
+   // repeated pattern of doubles + random data far apart (offsets close to the maximum offset)
+
+   std::vector< uint8_t > pattern;
+   for( uint_t i = 0; i != 10000; ++i )
+   {
+      const double value = double( i % 7 ) * 0.25;
+      const uint8_t * bytes = reinterpret_cast< const uint8_t * >( &value );
+      pattern.insert( pattern.end(), bytes, bytes + sizeof( double ) );
+   }
+   pattern.insert( pattern.end(), random.begin(), random.end() );
+   pattern.insert( pattern.end(), random.begin(), random.begin() + 1000 );
+   compressAndDecompress( pattern );
+
+   // corrupt data must be detected
+
+   std::vector< uint8_t > compressed;
+   lzCompress( zeros, compressed );
+   std::vector< uint8_t > decompressed( zeros.size() );
+   WALBERLA_CHECK( !lzDecompress( std::vector< uint8_t >( compressed.begin(), compressed.begin() + 3 ), decompressed ) );
+   WALBERLA_CHECK( !lzDecompress( std::vector< uint8_t >(), decompressed ) );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SmallVectorTest.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "core/SmallVector.h"
+#include "core/debug/TestSubsystem.h"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using namespace walberla;
+
+
+
+template< typename Container >
+void checkEqual( const Container & container, const std::vector< std::string > & reference )
+{
+   WALBERLA_CHECK_EQUAL( container.size(), reference.size() );
+   WALBERLA_CHECK_EQUAL( container.empty(), reference.empty() );
+   for( size_t i = 0; i != reference.size(); ++i )
+      WALBERLA_CHECK_EQUAL( container[i], reference[i] );
+}
+
+
+
+int main( int /*argc*/, char** /*argv*/ ) {
+
+   debug::enterTestMode();
+
+   typedef SmallVector< std::string, 2 > StringVector;
+
+   StringVector v;
+   std::vector< std::string > reference;
+   WALBERLA_CHECK( v.empty() && v.isInline() );
+
+   // inline storage
+   v.push_back( "a" ); reference.push_back( "a" );
+   v.push_back( "b" ); reference.push_back( "b" );
+   checkEqual( v, reference );
+   WALBERLA_CHECK( v.isInline() );
+
+   // growing beyond the inline capacity, also when pushing an element of the container itself
+   v.push_back( v[0] ); reference.push_back( reference[0] );
+   v.push_back( "c" );  reference.push_back( "c" );
+   v.push_back( "d" );  reference.push_back( "d" );
+   checkEqual( v, reference );
+   WALBERLA_CHECK( !v.isInline() );
+   WALBERLA_CHECK_GREATER_EQUAL( v.capacity(), v.size() );
+
+   // erase preserves the order
+   v.erase( v.begin() + 1 ); reference.erase( reference.begin() + 1 );
+   checkEqual( v, reference );
+   v.pop_back(); reference.pop_back();
+   checkEqual( v, reference );
+
+   // copies
+   StringVector copy( v );
+   checkEqual( copy, reference );
+   WALBERLA_CHECK( copy == v );
+
+   StringVector small;
+   small.push_back( "x" );
+   WALBERLA_CHECK( small != v );
+   small = v;
+   checkEqual( small, reference );
+   StringVector & alias = v;
+   v = alias;
+   checkEqual( v, reference );
+
+   copy.clear();
+   WALBERLA_CHECK( copy.empty() );
+   WALBERLA_CHECK( v.begin() != copy.begin() );
+   checkEqual( v, reference );
+
+   // elements that are stored in fields, e.g. pairs of pointer and value
+   typedef std::pair< const int *, double > Entry;
+   int a = 1, b = 2;
+   SmallVector< Entry, 1 > entries;
+   entries.push_back( Entry( &a, 0.5 ) );
+   entries.push_back( Entry( &b, 0.25 ) );
+   WALBERLA_CHECK_EQUAL( entries.size(), 2 );
+   WALBERLA_CHECK_EQUAL( *( entries.back().first ), 2 );
+   entries.erase( entries.begin() );
+   WALBERLA_CHECK_EQUAL( entries.front().first, &b );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AsyncFileWriterTest.cpp
+//! \ingroup core
+//
+//======================================================================================================================
+
+#include "core/Abort.h"
+#include "core/DataTypes.h"
+
+#include "core/debug/TestSubsystem.h"
+
+#include "core/mpi/AsyncFileWriter.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using namespace walberla;
+
+
+
+std::string readFile( const std::string & filename )
+{
+   std::ifstream ifs( filename.c_str(), std::ifstream::binary );
+   return std::string( ( std::istreambuf_iterator< char >( ifs ) ), std::istreambuf_iterator< char >() );
+}
+
+void removeFile( const std::string & filename )
+{
+   WALBERLA_MPI_BARRIER();
+   WALBERLA_ROOT_SECTION()
+   {
+      if( boost::filesystem::exists( filename ) )
+         boost::filesystem::remove( filename );
+   }
+   WALBERLA_MPI_BARRIER();
+}
+
+/// the chunk of process 'rank' has a size of 'minChunkSize * (rank + 1)'
+std::string chunk( const int rank, const size_t minChunkSize )
+{
+   std::string c( minChunkSize * uint_c( rank + 1 ), char( 'A' + static_cast<char>( rank % 26 ) ) );
+   c[ c.size() - size_t(1) ] = '\n';
+   return c;
+}
+
+
+
+/// same as MPITextFileTest: every process writes a chunk of different size into one shared file
+void testTextFile( const size_t minChunkSize )
+{
+   const int rank = MPIManager::instance()->rank();
+   const std::string filename( "AsyncFileWriterTest.txt" );
+
+   mpi::AsyncFileWriter writer;
+   writer.writeMPITextFile( filename, chunk( rank, minChunkSize ) );
+   writer.flush();
+
+   WALBERLA_CHECK_EQUAL( writer.pendingBytes(), uint_t(0) );
+
+   WALBERLA_MPI_BARRIER();
+   WALBERLA_ROOT_SECTION()
+   {
+      std::string expected;
+      for( int r = 0; r != MPIManager::instance()->numProcesses(); ++r )
+         expected += chunk( r, minChunkSize );
+      WALBERLA_CHECK_EQUAL( readFile( filename ), expected );
+   }
+
+   removeFile( filename );
+}
+
+
+
+/// many files with a memory budget that is smaller than the data of two files -> the caller must be throttled
+void testMemoryBudget( const size_t minChunkSize )
+{
+   const int rank = MPIManager::instance()->rank();
+   const uint_t numberOfFiles = uint_t(10);
+
+   const std::string localChunk = chunk( rank, minChunkSize );
+   const uint_t memoryBudget = uint_c( localChunk.size() + localChunk.size() / 2 );
+
+   {
+      mpi::AsyncFileWriter writer( memoryBudget );
+      WALBERLA_CHECK_EQUAL( writer.memoryBudget(), memoryBudget );
+
+      for( uint_t i = 0; i != numberOfFiles; ++i )
+      {
+         writer.writeMPITextFile( "AsyncFileWriterTest_" + boost::lexical_cast< std::string >( i ) + ".txt", localChunk );
+         WALBERLA_CHECK_LESS_EQUAL( writer.pendingBytes(), memoryBudget );
+      }
+
+      // the destructor writes all pending files
+   }
+
+   WALBERLA_MPI_BARRIER();
+   WALBERLA_ROOT_SECTION()
+   {
+      std::string expected;
+      for( int r = 0; r != MPIManager::instance()->numProcesses(); ++r )
+         expected += chunk( r, minChunkSize );
+      for( uint_t i = 0; i != numberOfFiles; ++i )
+         WALBERLA_CHECK_EQUAL( readFile( "AsyncFileWriterTest_" + boost::lexical_cast< std::string >( i ) + ".txt" ), expected );
+   }
+
+   for( uint_t i = 0; i != numberOfFiles; ++i )
+      removeFile( "AsyncFileWriterTest_" + boost::lexical_cast< std::string >( i ) + ".txt" );
+}
+
+
+
+/// segments are written at arbitrary offsets, gaps are filled with zeros, and the data is swapped into the writer
+/// (only the root process contributes data, all other processes take part with empty segments)
+void testSegments()
+{
+   const std::string filename( "AsyncFileWriterTest.bin" );
+
+   // an existing, larger file is shrunk to the new size
+   WALBERLA_ROOT_SECTION()
+   {
+      std::ofstream ofs( filename.c_str(), std::ofstream::binary );
+      ofs << std::string( 100, 'x' );
+   }
+   WALBERLA_MPI_BARRIER();
+
+   mpi::AsyncFileWriter writer( uint_t(1) ); // a single job that exceeds the budget must still be accepted
+
+   std::vector< mpi::AsyncFileWriter::Segment > segments;
+   WALBERLA_ROOT_SECTION()
+   {
+      segments.push_back( mpi::AsyncFileWriter::Segment( uint64_t(6) ) );
+      segments.back().data_.assign( 3, 'b' );
+      segments.push_back( mpi::AsyncFileWriter::Segment( uint64_t(1) ) );
+      segments.back().data_.assign( 2, 'a' );
+   }
+
+   writer.write( filename, uint64_t(12), segments, MPIManager::instance()->comm() );
+   WALBERLA_CHECK( segments.empty() );
+
+   writer.flush();
+
+   WALBERLA_MPI_BARRIER();
+   WALBERLA_ROOT_SECTION()
+   {
+      WALBERLA_CHECK_EQUAL( readFile( filename ), std::string( "\0aa\0\0\0bbb\0\0\0", 12 ) );
+   }
+
+   removeFile( filename );
+}
+
+
+
+int main( int argc, char * argv[] )
+{
+   debug::enterTestMode();
+
+   // with '--thread-multiple', MPI is initialized with MPI_THREAD_MULTIPLE and the files are written with MPI I/O (if
+   // the MPI library provides this thread level)
+   bool threadMultiple = false;
+   for( int i = 1; i < argc; ++i )
+      threadMultiple = threadMultiple || std::string( argv[i] ) == "--thread-multiple";
+
+#ifdef WALBERLA_BUILD_WITH_MPI
+   int provided = MPI_THREAD_SINGLE;
+   if( threadMultiple )
+      MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+#endif
+
+   mpi::Environment env( argc, argv );
+   MPIManager::instance()->useWorldComm();
+
+#if defined( WALBERLA_BUILD_WITH_MPI ) && defined( WALBERLA_BUILD_WITH_BOOST_THREAD )
+   WALBERLA_CHECK_EQUAL( mpi::AsyncFileWriter().usesMPIIO(), threadMultiple && provided == MPI_THREAD_MULTIPLE );
+#else
+   WALBERLA_CHECK( !mpi::AsyncFileWriter().usesMPIIO() );
+#endif
+
+   testTextFile( size_t(16) );
+   testMemoryBudget( size_t(1000) );
+   testSegments();
+
+   return EXIT_SUCCESS;
+}
@@ -35,6 +35,10 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <fstream>
+#include <iterator>
+#include <string>
+
 
 namespace mpi_file_io_test {
    
@@ -150,6 +154,28 @@ int main( int argc, char* argv[] )
          WALBERLA_CHECK_IDENTICAL( *origIt, *readIt );
    }
 
+   // asynchronous output must create the same file
+
+   mpi::AsyncFileWriter asyncWriter;
+
+   WALBERLA_MPI_BARRIER();
+   timer.start();
+   field::writeToFile<FieldType>( "mpiFileAsync.wlb", sbf->getBlockStorage(), originalFieldId, asyncWriter );
+   timer.end();
+   WALBERLA_LOG_INFO_ON_ROOT( "Handing over the data to the asynchronous writer took " << timer.last() << "s" );
+
+   asyncWriter.flush();
+   WALBERLA_MPI_BARRIER();
+
+   WALBERLA_ROOT_SECTION()
+   {
+      std::ifstream syncFile( "mpiFile.wlb", std::ifstream::binary );
+      std::ifstream asyncFile( "mpiFileAsync.wlb", std::ifstream::binary );
+      const std::string syncContent( ( std::istreambuf_iterator< char >( syncFile ) ), std::istreambuf_iterator< char >() );
+      const std::string asyncContent( ( std::istreambuf_iterator< char >( asyncFile ) ), std::istreambuf_iterator< char >() );
+      WALBERLA_CHECK( syncContent == asyncContent, "Asynchronously written file differs from the synchronously written file" );
+   }
+
    return EXIT_SUCCESS;
 }
 
@@ -20,12 +20,16 @@
 //
 //======================================================================================================================
 
+#include "field/AddToStorage.h"
 #include "field/Field.h"
+#include "field/FlagField.h"
 #include "field/GhostLayerField.h"
 #include "field/Printers.h"
 #include "field/SwapableCompare.h"
 #include "field/iterators/FieldPointer.h"
 
+#include "blockforest/Initialization.h"
+
 #include "core/Environment.h"
 #include "core/debug/TestSubsystem.h"
 
@@ -62,6 +66,156 @@ void alignedAllocWithOffsetTest()
    field::aligned_free(p);
 }
 
+void mappedAllocWithOffsetTest()
+{
+   char * p;
+   p = (char*)field::mapped_malloc_with_offset(64 + 2*8,32,8);
+   WALBERLA_CHECK_EQUAL( ((size_t)p+8) % 32, 0u  );
+   for( uint_t i = 0; i < 64 + 2*8; ++i )
+      p[i] = 'a';
+   field::mapped_free(p);
+
+   p = (char*)field::mapped_malloc_with_offset(uint_t(8) << 20,64,0,true);
+   WALBERLA_CHECK_EQUAL( ((size_t)p) % 64, 0u  );
+   for( uint_t i = 0; i < (uint_t(8) << 20); i += 4096 )
+      p[i] = 'a';
+   field::mapped_free(p);
+}
+
+void firstTouchAllocTest(field::Layout layout, bool hugePages)
+{
+   const uint_t xs = 5;
+   const uint_t ys = 7;
+   const uint_t zs = 3;
+   const uint_t fs = 3;
+   const uint_t gl = 2;
+
+   const uint_t alignment = 4 * sizeof( double );
+   typedef field::AllocateFirstTouch<double,alignment> Allocator;
+   shared_ptr<Allocator> alloc = make_shared<Allocator>( hugePages );
+
+   // all elements have to be constructed, including the padding
+   GhostLayerField<double,fs> field (xs,ys,zs,gl,layout,alloc);
+   const double * data = field.data();
+   for( uint_t i = 0; i < field.allocSize(); ++i )
+      WALBERLA_CHECK_FLOAT_EQUAL( data[i], 0.0 );
+
+   if( layout == field::fzyx )
+   {
+      for(cell_idx_t f=0; f < cell_idx_c( field.fSize() ); ++f )
+         for(cell_idx_t z=0; z < cell_idx_t( field.zSize() ); ++z )
+            for(cell_idx_t y=0; y < cell_idx_t( field.ySize() ); ++y )
+            {
+               void * p = reinterpret_cast<void*>( &(field(0,y,z,f)) );
+               // test that each line is aligned
+               WALBERLA_CHECK_EQUAL( (size_t)p % alignment, 0u);
+            }
+   }
+
+   field.setWithGhostLayer( 42.0 );
+
+   // memory of a clone is constructed without knowledge of the layout
+   shared_ptr< GhostLayerField<double,fs> > clone( field.clone() );
+   for( auto it = field.beginWithGhostLayer(); it != field.end(); ++it )
+      WALBERLA_CHECK_FLOAT_EQUAL( clone->get( it.x(), it.y(), it.z(), it.f() ), 42.0 );
+
+   // same allocator for a field of a different size and layout
+   const field::Layout otherLayout = ( layout == field::fzyx ) ? field::zyxf : field::fzyx;
+   GhostLayerField<double,fs> other (zs,xs,ys,uint_t(1),otherLayout,alloc);
+   for( uint_t i = 0; i < other.allocSize(); ++i )
+      WALBERLA_CHECK_FLOAT_EQUAL( other.data()[i], 0.0 );
+
+
+   // flag fields
+   typedef field::AllocateFirstTouch<uint8_t,64> FlagAllocator;
+   FlagField<uint8_t> flagField (xs,ys,zs,gl,make_shared<FlagAllocator>( hugePages ));
+   for( uint_t i = 0; i < flagField.allocSize(); ++i )
+      WALBERLA_CHECK_EQUAL( flagField.data()[i], uint8_t(0) );
+}
+
+void pooledAllocTest(field::Layout layout)
+{
+   const uint_t xs = 5;
+   const uint_t ys = 4;
+   const uint_t zs = 3;
+   const uint_t fs = 2;
+   const uint_t gl = 1;
+
+   typedef field::PooledFieldAlloc<double,32> Allocator;
+   shared_ptr<Allocator> alloc = make_shared<Allocator>();
+
+   const double * data = NULL;
+   uint_t bytes = 0;
+   uint_t otherBytes = 0;
+   {
+      GhostLayerField<double,fs> field (xs,ys,zs,gl,1.0,layout,alloc);
+      data  = field.data();
+      bytes = field.allocSize() * sizeof(double);
+   }
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().allocations, 1u );
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().allocatedBytes, bytes );
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().pooledBytes, bytes );
+
+   // a field of the same size gets the memory of the destroyed field
+   {
+      GhostLayerField<double,fs> field (xs,ys,zs,gl,2.0,layout,alloc);
+      WALBERLA_CHECK_EQUAL( field.data(), data );
+      for( auto it = field.beginWithGhostLayer(); it != field.end(); ++it )
+         WALBERLA_CHECK_FLOAT_EQUAL( *it, 2.0 );
+
+      WALBERLA_CHECK_EQUAL( alloc->getStatistics().reuses, 1u );
+      WALBERLA_CHECK_EQUAL( alloc->getStatistics().reusedBytes, bytes );
+      WALBERLA_CHECK_EQUAL( alloc->getStatistics().pooledBytes, 0u );
+
+      // no memory in the pool -> the clone needs new memory
+      shared_ptr< GhostLayerField<double,fs> > clone( field.clone() );
+      WALBERLA_CHECK_EQUAL( alloc->getStatistics().allocations, 2u );
+      for( auto it = clone->beginWithGhostLayer(); it != clone->end(); ++it )
+         WALBERLA_CHECK_FLOAT_EQUAL( *it, 2.0 );
+
+      // different size -> new memory
+      GhostLayerField<double,fs> other (zs,ys,xs,gl,layout,alloc);
+      otherBytes = other.allocSize() * sizeof(double);
+      WALBERLA_CHECK_EQUAL( alloc->getStatistics().allocations, 3u );
+   }
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().reuses, 1u );
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().pooledBytes, 2u * bytes + otherBytes );
+
+   alloc->releasePool();
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().pooledBytes, 0u );
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().freedBytes, 2u * bytes + otherBytes );
+
+   // the pool is limited
+   shared_ptr<Allocator> limitedAlloc = make_shared<Allocator>( bytes );
+   {
+      GhostLayerField<double,fs> field0 (xs,ys,zs,gl,layout,limitedAlloc);
+      GhostLayerField<double,fs> field1 (xs,ys,zs,gl,layout,limitedAlloc);
+   }
+   WALBERLA_CHECK_EQUAL( limitedAlloc->getStatistics().pooledBytes, bytes );
+   WALBERLA_CHECK_EQUAL( limitedAlloc->getStatistics().freedBytes, bytes );
+}
+
+void flagFieldAllocTest()
+{
+   shared_ptr< StructuredBlockForest > blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(1), uint_t(1),   // blocks
+                                                                                     uint_t(4), uint_t(3), uint_t(2),   // cells per block
+                                                                                     real_t(1),                         // dx
+                                                                                     false );                           // one block per process
+
+   // the flag fields of all blocks are allocated by the allocator that is passed to the block data handling
+   typedef field::PooledFieldAlloc<uint8_t,64> Allocator;
+   shared_ptr<Allocator> alloc = make_shared<Allocator>();
+   BlockDataID flagFieldID = field::addFlagFieldToStorage< FlagField<uint8_t> >( blocks, "flags", uint_t(1), alloc );
+
+   WALBERLA_CHECK_EQUAL( alloc->getStatistics().allocations, blocks->size() );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FlagField<uint8_t> * flagField = block->getData< FlagField<uint8_t> >( flagFieldID );
+      WALBERLA_CHECK_EQUAL( flagField->xSize(), uint_t(4) );
+      WALBERLA_CHECK_EQUAL( flagField->nrOfGhostLayers(), uint_t(1) );
+   }
+}
+
 void simpleCreateAndIterate(field::Layout layout)
 {
    const uint_t xs = 3;
@@ -586,9 +740,16 @@ int main( int argc, char**argv )
    debug::enterTestMode();
    alignedAllocTest();
    alignedAllocWithOffsetTest();
+   mappedAllocWithOffsetTest();
 
    alignmentTest();
    ghostLayerFieldAlignmentTest();
+   firstTouchAllocTest(fzyx, false);
+   firstTouchAllocTest(zyxf, false);
+   firstTouchAllocTest(fzyx, true);
+   pooledAllocTest(fzyx);
+   pooledAllocTest(zyxf);
+   flagFieldAllocTest();
    sizeTest();
    iteratorToConstConversionTest();
    fieldPointerTest();
@@ -0,0 +1,186 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file StencilRestrictedCommunicationTest.cpp
+//! \ingroup field
+//! \brief Checks that StencilRestrictedPackInfo and StencilRestrictedMPIDatatypeInfo communicate exactly the
+//!        components that point to the neighbor into the innermost ghost layer
+//
+//======================================================================================================================
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+#include "field/communication/StencilRestrictedMPIDatatypeInfo.h"
+#include "field/communication/StencilRestrictedPackInfo.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+#include "blockforest/communication/UniformDirectScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/mpi/Environment.h"
+
+#include "stencil/D3Q19.h"
+#include "stencil/D3Q27.h"
+
+#include <set>
+
+
+using namespace walberla;
+
+typedef GhostLayerField< real_t, stencil::D3Q19::Size > Field_T;
+
+const uint_t BlockSize = uint_t(4);
+
+
+
+real_t value( const shared_ptr< StructuredBlockForest > & blocks, const Cell & globalCell, const uint_t f )
+{
+   // periodic domain: map the cell to the domain before computing the value
+   const cell_idx_t xSize = cell_idx_c( blocks->getNumberOfXCells() );
+   const cell_idx_t ySize = cell_idx_c( blocks->getNumberOfYCells() );
+   const cell_idx_t zSize = cell_idx_c( blocks->getNumberOfZCells() );
+
+   const cell_idx_t x = ( globalCell.x() + xSize ) % xSize;
+   const cell_idx_t y = ( globalCell.y() + ySize ) % ySize;
+   const cell_idx_t z = ( globalCell.z() + zSize ) % zSize;
+
+   return real_c( ( ( z * ySize + y ) * xSize + x ) * cell_idx_t(32) + cell_idx_c( f ) );
+}
+
+
+
+BlockDataID initialize( const shared_ptr< StructuredBlockForest > & blocks, const uint_t ghostLayers, const field::Layout layout )
+{
+   BlockDataID fieldId = field::addToStorage< Field_T >( blocks, "field", real_t(0), layout, ghostLayers );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      Field_T * field = block->getData< Field_T >( fieldId );
+      for( auto cell = field->beginWithGhostLayerXYZ(); cell != field->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+         for( uint_t f = 0; f != stencil::D3Q19::Size; ++f )
+            field->get( cell.x(), cell.y(), cell.z(), f ) = field->isInInnerPart( Cell( cell.x(), cell.y(), cell.z() ) ) ?
+                                                            value( blocks, global, f ) : real_t(-1);
+      }
+   }
+
+   return fieldId;
+}
+
+
+
+template< typename CommunicationStencil_T >
+void check( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId, const uint_t ghostLayers )
+{
+   typedef stencil::D3Q19 Stencil_T;
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      Field_T * field = block->getData< Field_T >( fieldId );
+
+      for( auto dir = CommunicationStencil_T::beginNoCenter(); dir != CommunicationStencil_T::end(); ++dir )
+      {
+         // the components that point from the neighbor in direction 'dir' into this block
+         std::set< uint_t > streaming;
+         const stencil::Direction inv = stencil::inverseDir[ *dir ];
+         for( uint_t i = 0; i < Stencil_T::d_per_d_length[ inv ]; ++i )
+            streaming.insert( Stencil_T::idx[ Stencil_T::d_per_d[ inv ][ i ] ] );
+
+         CellInterval ghostRegion;
+         field->getGhostRegion( *dir, ghostRegion, cell_idx_c( ghostLayers ) );
+
+         for( auto cell = ghostRegion.begin(); cell != ghostRegion.end(); ++cell )
+         {
+            // only the innermost ghost layer is communicated
+            const bool innermost = ( cell->x() >= -1 && cell->x() <= cell_idx_c( BlockSize ) ) &&
+                                   ( cell->y() >= -1 && cell->y() <= cell_idx_c( BlockSize ) ) &&
+                                   ( cell->z() >= -1 && cell->z() <= cell_idx_c( BlockSize ) );
+
+            Cell global( *cell );
+            blocks->transformBlockLocalToGlobalCell( global, *block );
+
+            for( uint_t f = 0; f != Stencil_T::Size; ++f )
+            {
+               const real_t expected = ( innermost && streaming.find( f ) != streaming.end() ) ? value( blocks, global, f ) : real_t(-1);
+               WALBERLA_CHECK_FLOAT_EQUAL( field->get( *cell, f ), expected,
+                                           "Ghost cell " << *cell << ", direction " << stencil::dirToString[ *dir ] << ", component " << f );
+            }
+         }
+      }
+   }
+}
+
+
+
+template< typename CommunicationStencil_T >
+void testPackInfo( const shared_ptr< StructuredBlockForest > & blocks, const uint_t ghostLayers, const field::Layout layout,
+                   const blockforest::LocalCommunicationMode localMode )
+{
+   BlockDataID fieldId = initialize( blocks, ghostLayers, layout );
+
+   blockforest::communication::UniformBufferedScheme< CommunicationStencil_T > communication( blocks );
+   communication.setLocalMode( localMode );
+   communication.addPackInfo( make_shared< field::communication::StencilRestrictedPackInfo< Field_T, stencil::D3Q19 > >( fieldId ) );
+   communication();
+
+   check< CommunicationStencil_T >( blocks, fieldId, ghostLayers );
+}
+
+
+
+template< typename CommunicationStencil_T >
+void testMPIDatatypeInfo( const shared_ptr< StructuredBlockForest > & blocks, const uint_t ghostLayers, const field::Layout layout )
+{
+   BlockDataID fieldId = initialize( blocks, ghostLayers, layout );
+
+   blockforest::communication::UniformDirectScheme< CommunicationStencil_T > communication( blocks );
+   communication.addDataToCommunicate( make_shared< field::communication::StencilRestrictedMPIDatatypeInfo< Field_T, stencil::D3Q19 > >( fieldId ) );
+   communication();
+
+   check< CommunicationStencil_T >( blocks, fieldId, ghostLayers );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process, periodic in all directions
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      BlockSize, BlockSize, BlockSize,
+                                                      real_t(1), false,
+                                                      true, true, true );
+
+   for( uint_t ghostLayers = uint_t(1); ghostLayers <= uint_t(2); ++ghostLayers )
+   {
+      // local communication (START) and packing into buffers (BUFFER)
+      testPackInfo< stencil::D3Q19 >( blocks, ghostLayers, field::fzyx, blockforest::START );
+      testPackInfo< stencil::D3Q19 >( blocks, ghostLayers, field::zyxf, blockforest::BUFFER );
+      // no component points across the corners of a D3Q19 block -> nothing is communicated for these directions
+      testPackInfo< stencil::D3Q27 >( blocks, ghostLayers, field::fzyx, blockforest::BUFFER );
+
+      testMPIDatatypeInfo< stencil::D3Q19 >( blocks, ghostLayers, field::fzyx );
+      testMPIDatatypeInfo< stencil::D3Q19 >( blocks, ghostLayers, field::zyxf );
+      testMPIDatatypeInfo< stencil::D3Q27 >( blocks, ghostLayers, field::fzyx );
+   }
+
+   return 0;
+}
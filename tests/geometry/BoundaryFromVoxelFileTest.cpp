@@ -0,0 +1,232 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BoundaryFromVoxelFileTest.cpp
+//! \ingroup geometry
+//! \brief Checks that all read strategies (root/collective, plain/run-length encoded) of BoundaryFromVoxelFile agree
+//
+//======================================================================================================================
+
+#include "geometry/initializer/BoundaryFromVoxelFile.h"
+#include "geometry/structured/VoxelFileReader.h"
+
+#include "blockforest/Initialization.h"
+
+#include "boundary/Boundary.h"
+#include "boundary/BoundaryHandling.h"
+
+#include "core/config/Config.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/Reduce.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+
+#include "stencil/D3Q7.h"
+
+#include <boost/filesystem.hpp>
+
+#include <string>
+#include <vector>
+
+
+using namespace walberla;
+using walberla::boundary::BoundaryHandling;
+
+typedef FlagField< uint8_t > FlagField_T;
+typedef FlagField_T::flag_t flag_t;
+
+const FlagUID Fluid( "fluid" );
+const FlagUID Obstacle( "obstacle" );
+const FlagUID Marker( "marker" );
+
+const std::string fileName( "BoundaryFromVoxelFileTest.dat" );
+const Cell fileOffset( 2, 1, 0 );
+
+
+
+/// Boundary condition that does nothing, only required for setting boundaries with a configuration block
+class ObstacleBoundary : public boundary::Boundary<flag_t>
+{
+public:
+   static shared_ptr<BoundaryConfiguration> createConfiguration( const Config::BlockHandle & ) { return make_shared<BoundaryConfiguration>(); }
+
+   ObstacleBoundary() : boundary::Boundary<flag_t>( "ObstacleBoundary" ) {}
+
+   void pushFlags( std::vector< FlagUID > & uids ) const { uids.push_back( Obstacle ); }
+
+   void beforeBoundaryTreatment() {}
+   void  afterBoundaryTreatment() {}
+
+   void registerCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t, const BoundaryConfiguration & ) {}
+   void registerCells( const flag_t, const CellInterval &, const BoundaryConfiguration & ) {}
+   template< typename CellIterator >
+   void registerCells( const flag_t, const CellIterator &, const CellIterator &, const BoundaryConfiguration & ) {}
+
+   void unregisterCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) {}
+
+   void treatDirection( const cell_idx_t, const cell_idx_t, const cell_idx_t, const stencil::Direction,
+                        const cell_idx_t, const cell_idx_t, const cell_idx_t, const flag_t ) {}
+};
+
+typedef BoundaryHandling< FlagField_T, stencil::D3Q7, boost::tuples::tuple< ObstacleBoundary > > BoundaryHandling_T;
+
+struct BoundaryHandlingCreator
+{
+   BoundaryHandlingCreator( const BlockDataID & flagFieldID ) : flagFieldID_( flagFieldID ) {}
+
+   BoundaryHandling_T * operator()( IBlock * const block ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID_ );
+      const flag_t fluid = flagField->registerFlag( Fluid );
+      flagField->registerFlag( Marker );
+      return new BoundaryHandling_T( "boundary handling", flagField, fluid, boost::tuples::make_tuple( ObstacleBoundary() ) );
+   }
+
+   BlockDataID flagFieldID_;
+};
+
+
+
+/// Value stored in the voxel file: large regions of equal values (as in typical geometries) and some noise
+uint8_t voxelValue( const uint_t x, const uint_t y, const uint_t z )
+{
+   if( ( x * 7 + y * 3 + z * 5 ) % 31 == 0 )
+      return uint8_t(3);
+   if( x < 6 )
+      return uint8_t(1);
+   if( ( x - 12 ) * ( x - 12 ) + ( y - 8 ) * ( y - 8 ) + ( z - 6 ) * ( z - 6 ) < 25 )
+      return uint8_t(2);
+   return uint8_t(0);
+}
+
+void createVoxelFile( const uint_t xSize, const uint_t ySize, const uint_t zSize )
+{
+   std::vector<uint8_t> data;
+   for( uint_t z = 0; z < zSize; ++z )
+      for( uint_t y = 0; y < ySize; ++y )
+         for( uint_t x = 0; x < xSize; ++x )
+            data.push_back( voxelValue( x, y, z ) );
+
+   geometry::VoxelFileReader<uint8_t> writer( fileName, xSize, ySize, zSize, &data[0] );
+}
+
+
+
+void runLengthEncoding()
+{
+   std::vector<uint8_t> data;
+   for( uint_t i = 0; i < 5; ++i ) data.push_back( uint8_t(1) );
+   data.push_back( uint8_t(2) );
+   for( uint_t i = 0; i < 3; ++i ) data.push_back( uint8_t(1) );
+   for( uint_t i = 0; i < 3; ++i ) data.push_back( uint8_t(0) );
+
+   geometry::initializer::RunLengthData runs;
+   geometry::initializer::runLengthEncode( data, runs );
+   WALBERLA_CHECK_EQUAL( runs.size(), 4 );
+   WALBERLA_CHECK_EQUAL( runs[0].second, 5 );
+   WALBERLA_CHECK_EQUAL( runs[1].first, 2 );
+
+   const CellInterval ci( 1, 2, 3, 3, 3, 4 ); // 3 x 2 x 2 cells
+   for( uint8_t flag = 0; flag < 3; ++flag )
+   {
+      CellVector expected = geometry::initializer::findCellsWithFlag( ci, data, flag );
+      CellVector cells    = geometry::initializer::findCellsWithFlag( ci, runs, flag );
+      WALBERLA_CHECK_EQUAL( cells.size(), expected.size() );
+      for( size_t i = 0; i < cells.size(); ++i )
+         WALBERLA_CHECK_EQUAL( cells[i], expected[i] );
+   }
+}
+
+
+
+void checkFlags( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & flagFieldID, const CellInterval & fileInterval )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID );
+      const flag_t obstacle = flagField->getFlag( Obstacle );
+      const flag_t marker   = flagField->getFlag( Marker );
+
+      for( auto cell = flagField->beginWithGhostLayer(); cell != flagField->end(); ++cell )
+      {
+         Cell globalCell = cell.cell();
+         blocks->transformBlockLocalToGlobalCell( globalCell, *block );
+
+         uint8_t value = uint8_t(0);
+         if( fileInterval.contains( globalCell ) )
+            value = voxelValue( uint_c( globalCell.x() - fileOffset.x() ), uint_c( globalCell.y() - fileOffset.y() ), uint_c( globalCell.z() - fileOffset.z() ) );
+
+         WALBERLA_CHECK_EQUAL( isFlagSet( cell, obstacle ), value == uint8_t(1), globalCell );
+         WALBERLA_CHECK_EQUAL( isFlagSet( cell, marker   ), value == uint8_t(2), globalCell );
+      }
+   }
+}
+
+void boundaryFromVoxelFile( const bool collective, const bool compressed )
+{
+   // 6 blocks on 4 processes: the processes read a different number of blocks
+   shared_ptr< StructuredBlockForest > blocks = blockforest::createUniformBlockGrid( 3, 2, 1, 10, 10, 14, real_t(1), uint_t(0), true, false );
+
+   const BlockDataID flagFieldID = field::addFlagFieldToStorage< FlagField_T >( blocks, "flags", uint_t(1) );
+   BlockDataID handlingID = blocks->addBlockData< BoundaryHandling_T >( BoundaryHandlingCreator( flagFieldID ), "boundary handling" );
+
+   Config config;
+   Config::Block & voxelFileBlock = config.getWritableGlobalBlock().createBlock( "VoxelFile" );
+   voxelFileBlock.addParameter( "file", fileName );
+   voxelFileBlock.addParameter( "offset", "(2,1,0)" );
+   voxelFileBlock.addParameter( "collective", collective ? "true" : "false" );
+   voxelFileBlock.addParameter( "compressed", compressed ? "true" : "false" );
+
+   Config::Block & obstacleBlock = voxelFileBlock.createBlock( "Flag" );
+   obstacleBlock.addParameter( "value", "1" );
+   obstacleBlock.createBlock( "ObstacleBoundary" );
+
+   Config::Block & markerBlock = voxelFileBlock.createBlock( "Flag" );
+   markerBlock.addParameter( "value", "2" );
+   markerBlock.addParameter( "flag", "marker" );
+
+   geometry::initializer::BoundaryFromVoxelFile< BoundaryHandling_T > initializer( *blocks, handlingID );
+   initializer.init( blocks->getBlockStorage(), config.getOneBlock( "VoxelFile" ) );
+
+   CellInterval fileInterval( 0, 0, 0, 22, 16, 12 );
+   fileInterval.shift( fileOffset );
+   checkFlags( blocks, flagFieldID, fileInterval );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+   mpi::Environment env( argc, argv );
+
+   runLengthEncoding();
+
+   WALBERLA_ROOT_SECTION() { createVoxelFile( 23, 17, 13 ); }
+   WALBERLA_MPI_WORLD_BARRIER();
+
+   boundaryFromVoxelFile( false, false );
+   boundaryFromVoxelFile( false, true  );
+   boundaryFromVoxelFile( true,  false );
+   boundaryFromVoxelFile( true,  true  );
+
+   WALBERLA_MPI_WORLD_BARRIER();
+   WALBERLA_ROOT_SECTION() { boost::filesystem::remove( fileName ); }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,361 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TriangleMeshBVHTest.cpp
+//! \ingroup geometry
+//! \brief Compares the queries of the TriangleMeshBVH to brute force and analytic results
+//
+//======================================================================================================================
+
+#include "geometry/initializer/BoundaryFromBody.h"
+#include "geometry/initializer/BoundaryFromTriangleMesh.h"
+#include "geometry/mesh/TriangleMesh.h"
+#include "geometry/mesh/TriangleMeshBVH.h"
+
+#include "blockforest/Initialization.h"
+
+#include "boundary/Boundary.h"
+#include "boundary/BoundaryHandling.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/math/Constants.h"
+#include "core/math/Random.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+#include "field/GhostLayerField.h"
+
+#include "stencil/D3Q19.h"
+
+#include <cmath>
+#include <limits>
+
+
+using namespace walberla;
+using namespace walberla::geometry;
+using walberla::boundary::BoundaryHandling;
+
+typedef Vector3<real_t> Vec3;
+
+typedef FlagField< uint8_t > FlagField_T;
+typedef FlagField_T::flag_t flag_t;
+typedef GhostLayerField< real_t, stencil::D3Q19::Size > QField_T;
+
+const FlagUID Fluid( "fluid" );
+const FlagUID Obstacle( "obstacle" );
+
+
+
+/// Boundary condition that does nothing, only required for registering the obstacle flag at the boundary handling
+class ObstacleBoundary : public boundary::Boundary<flag_t>
+{
+public:
+   static shared_ptr<BoundaryConfiguration> createConfiguration( const Config::BlockHandle & ) { return make_shared<BoundaryConfiguration>(); }
+
+   ObstacleBoundary() : boundary::Boundary<flag_t>( "ObstacleBoundary" ) {}
+
+   void pushFlags( std::vector< FlagUID > & uids ) const { uids.push_back( Obstacle ); }
+
+   void beforeBoundaryTreatment() {}
+   void  afterBoundaryTreatment() {}
+
+   void registerCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t, const BoundaryConfiguration & ) {}
+   void registerCells( const flag_t, const CellInterval &, const BoundaryConfiguration & ) {}
+   template< typename CellIterator >
+   void registerCells( const flag_t, const CellIterator &, const CellIterator &, const BoundaryConfiguration & ) {}
+
+   void unregisterCell( const flag_t, const cell_idx_t, const cell_idx_t, const cell_idx_t ) {}
+
+   void treatDirection( const cell_idx_t, const cell_idx_t, const cell_idx_t, const stencil::Direction,
+                        const cell_idx_t, const cell_idx_t, const cell_idx_t, const flag_t ) {}
+};
+
+typedef BoundaryHandling< FlagField_T, stencil::D3Q19, boost::tuples::tuple< ObstacleBoundary > > BoundaryHandling_T;
+
+
+
+/// Triangulated sphere, all vertices lie on the sphere
+void createSphere( TriangleMesh & mesh, const Vec3 & center, const real_t radius, const uint_t rings, const uint_t segments )
+{
+   const TriangleMesh::index_t top    = mesh.addVertex( center + Vec3( 0, 0,  radius ) );
+   const TriangleMesh::index_t bottom = mesh.addVertex( center + Vec3( 0, 0, -radius ) );
+
+   std::vector< std::vector< TriangleMesh::index_t > > v( rings - 1, std::vector< TriangleMesh::index_t >( segments ) );
+   for( uint_t i = 1; i < rings; ++i )
+   {
+      const real_t theta = math::PI * real_c(i) / real_c(rings);
+      for( uint_t j = 0; j < segments; ++j )
+      {
+         const real_t phi = real_t(2) * math::PI * real_c(j) / real_c(segments);
+         v[i-1][j] = mesh.addVertex( center + radius * Vec3( std::sin( theta ) * std::cos( phi ), std::sin( theta ) * std::sin( phi ), std::cos( theta ) ) );
+      }
+   }
+
+   for( uint_t j = 0; j < segments; ++j )
+   {
+      const uint_t k = ( j + 1 ) % segments;
+      mesh.addTriangle( top, v[0][j], v[0][k] );
+      for( uint_t i = 0; i + 2 < rings; ++i )
+      {
+         mesh.addTriangle( v[i][j], v[i+1][j], v[i+1][k] );
+         mesh.addTriangle( v[i][j], v[i+1][k], v[i][k] );
+      }
+      mesh.addTriangle( bottom, v[rings-2][k], v[rings-2][j] );
+   }
+}
+
+/// Axis-aligned box
+void createBox( TriangleMesh & mesh, const Vec3 & minCorner, const Vec3 & maxCorner )
+{
+   TriangleMesh::index_t v[8];
+   for( uint_t i = 0; i < 8; ++i )
+      v[i] = mesh.addVertex( Vec3( ( i & 1 ) ? maxCorner[0] : minCorner[0], ( i & 2 ) ? maxCorner[1] : minCorner[1], ( i & 4 ) ? maxCorner[2] : minCorner[2] ) );
+
+   const uint_t faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+   for( uint_t f = 0; f < 6; ++f )
+   {
+      mesh.addTriangle( v[ faces[f][0] ], v[ faces[f][1] ], v[ faces[f][2] ] );
+      mesh.addTriangle( v[ faces[f][0] ], v[ faces[f][2] ], v[ faces[f][3] ] );
+   }
+}
+
+/// Brute force distance, see TriangleMeshBVH
+real_t bruteForceSqDistance( const TriangleMesh & mesh, const Vec3 & p )
+{
+   real_t best = std::numeric_limits<real_t>::max();
+   for( size_t t = 0; t < mesh.getNumTriangles(); ++t )
+   {
+      Vec3 a, b, c;
+      mesh.getTriangle( t, a, b, c );
+      // sample the triangle densely and compare the distances to the vertices, edges and the plane of the triangle
+      const Vec3 n = ( ( b - a ) % ( c - a ) ).getNormalized();
+      const real_t dPlane = ( p - a ) * n;
+      const Vec3 q = p - dPlane * n;
+      const Vec3 e[3] = { b - a, c - b, a - c };
+      const Vec3 o[3] = { a, b, c };
+      bool inside = true;
+      for( uint_t i = 0; i < 3; ++i )
+         inside = inside && ( ( e[i] % ( q - o[i] ) ) * n >= real_t(0) );
+      if( inside )
+      {
+         best = std::min( best, dPlane * dPlane );
+         continue;
+      }
+      for( uint_t i = 0; i < 3; ++i )
+      {
+         const real_t s = std::max( real_t(0), std::min( real_t(1), ( ( p - o[i] ) * e[i] ) / e[i].sqrLength() ) );
+         best = std::min( best, ( o[i] + s * e[i] - p ).sqrLength() );
+      }
+   }
+   return best;
+}
+
+
+
+void sphereQueries()
+{
+   const Vec3 center( real_t(0.3), real_t(-0.2), real_t(0.1) );
+   const real_t radius = real_t(4);
+   const uint_t rings = 24;
+   const uint_t segments = 48;
+
+   TriangleMesh mesh;
+   createSphere( mesh, center, radius, rings, segments );
+   WALBERLA_CHECK_FLOAT_EQUAL( real_c( mesh.getNumTriangles() ), real_c( 2 * segments * ( rings - 1 ) ) );
+
+   TriangleMeshBVH bvh( mesh );
+   WALBERLA_LOG_INFO( "BVH of " << mesh.getNumTriangles() << " triangles: " << bvh.getNumNodes() << " nodes, depth " << bvh.getDepth() );
+   WALBERLA_CHECK_GREATER( bvh.getNumNodes(), mesh.getNumTriangles() / 4 );
+   WALBERLA_CHECK_LESS_EQUAL( bvh.getDepth(), 12 );
+
+   // the polyhedron lies between the sphere and the sphere touching the centers of the largest faces
+   const real_t innerRadius = radius * std::cos( math::PI / real_c(rings) ) * std::cos( math::PI / real_c(segments) );
+
+   math::seedRandomGenerator( 42 );
+   for( uint_t i = 0; i < 1000; ++i )
+   {
+      const Vec3 p( math::realRandom( real_t(-6), real_t(6) ), math::realRandom( real_t(-6), real_t(6) ), math::realRandom( real_t(-6), real_t(6) ) );
+      const real_t r = ( p - center ).length();
+
+      // distance
+      Vec3 closest;
+      size_t triangle;
+      const real_t sqDist = bvh.sqDistance( p, &closest, &triangle );
+      WALBERLA_CHECK_FLOAT_EQUAL( sqDist, bruteForceSqDistance( mesh, p ) );
+      WALBERLA_CHECK_FLOAT_EQUAL( sqDist, ( closest - p ).sqrLength() );
+      WALBERLA_CHECK_LESS( triangle, mesh.getNumTriangles() );
+
+      // containment
+      if( r < innerRadius - real_t(1e-6) )
+      {
+         WALBERLA_CHECK( bvh.contains( p ) );
+         WALBERLA_CHECK( geometry::contains( bvh, p ) );
+         WALBERLA_CHECK_LESS( bvh.signedDistance( p ), real_t(0) );
+      }
+      else if( r > radius + real_t(1e-6) )
+      {
+         WALBERLA_CHECK( !bvh.contains( p ) );
+         WALBERLA_CHECK_GREATER( bvh.signedDistance( p ), real_t(0) );
+      }
+
+      // rays from the center hit the surface once, from the outside in direction of the center twice
+      const Vec3 direction = ( p - center ).getNormalized();
+      real_t t;
+      WALBERLA_CHECK( bvh.intersectRay( center, direction, t ) );
+      WALBERLA_CHECK_GREATER_EQUAL( t, innerRadius - real_t(1e-6) );
+      WALBERLA_CHECK_LESS_EQUAL   ( t, radius + real_t(1e-6) );
+      WALBERLA_CHECK_LESS( bvh.sqDistance( center + t * direction ), real_t(1e-12) );
+
+      const Vec3 outside = center + real_t(10) * direction;
+      real_t tOutside;
+      WALBERLA_CHECK( bvh.intersectRay( outside, -direction, tOutside ) );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( tOutside, real_t(10) - t, real_t(1e-6) );
+      WALBERLA_CHECK( !bvh.intersectRay( outside, direction, t ) );
+      WALBERLA_CHECK( !bvh.intersectRay( outside, -direction, t, real_t(10) - radius - real_t(0.1) ) );
+   }
+
+   // fast overlap checks
+   WALBERLA_CHECK_EQUAL( fastOverlapCheck( bvh, AABB( 5, 5, 5, 6, 6, 6 ) ), COMPLETELY_OUTSIDE );
+   WALBERLA_CHECK_EQUAL( fastOverlapCheck( bvh, center, real_t(1) ), CONTAINED_INSIDE_BODY );
+   WALBERLA_CHECK_EQUAL( fastOverlapCheck( bvh, center + Vec3( radius, 0, 0 ), real_t(1) ), DONT_KNOW );
+   WALBERLA_CHECK( !bvh.surfaceMayIntersect( AABB( -1, -1, -1, 1, 1, 1 ) ) );
+}
+
+
+
+void boxQueries()
+{
+   // all points of the lattice lie on planes through the faces and edges of the box
+   TriangleMesh mesh;
+   createBox( mesh, Vec3( 1, 1, 1 ), Vec3( 3, 4, 5 ) );
+   TriangleMeshBVH bvh( mesh, 1 );
+
+   for( int x = 0; x < 9; ++x )
+      for( int y = 0; y < 11; ++y )
+         for( int z = 0; z < 13; ++z )
+         {
+            const Vec3 p( real_c(x) * real_t(0.5), real_c(y) * real_t(0.5), real_c(z) * real_t(0.5) );
+            const bool inside = x > 2 && x < 6 && y > 2 && y < 8 && z > 2 && z < 10;
+            const bool outside = x < 2 || x > 6 || y < 2 || y > 8 || z < 2 || z > 10;
+            if( inside )
+               WALBERLA_CHECK( bvh.contains( p ), p );
+            if( outside )
+               WALBERLA_CHECK( !bvh.contains( p ), p );
+         }
+}
+
+
+
+struct BoundaryHandlingCreator
+{
+   BoundaryHandlingCreator( const BlockDataID & flagFieldID ) : flagFieldID_( flagFieldID ) {}
+
+   BoundaryHandling_T * operator()( IBlock * const block ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID_ );
+      const flag_t fluid = flagField->registerFlag( Fluid );
+      return new BoundaryHandling_T( "boundary handling", flagField, fluid, boost::tuples::make_tuple( ObstacleBoundary() ) );
+   }
+
+   BlockDataID flagFieldID_;
+};
+
+void boundaryInitializer()
+{
+   TriangleMesh mesh;
+   createSphere( mesh, Vec3( real_t(10.3), real_t(9.8), real_t(10.1) ), real_t(6), 16, 32 );
+   TriangleMeshBVH bvh( mesh );
+
+   shared_ptr< StructuredBlockForest > blocks = blockforest::createUniformBlockGrid( 2, 2, 2, 10, 10, 10, real_t(1) );
+
+   const BlockDataID flagFieldID    = field::addFlagFieldToStorage< FlagField_T >( blocks, "flags", uint_t(1) );
+   const BlockDataID referenceID    = field::addFlagFieldToStorage< FlagField_T >( blocks, "reference flags", uint_t(1) );
+   const BlockDataID handlingID     = blocks->addBlockData< BoundaryHandling_T >( BoundaryHandlingCreator( flagFieldID ), "boundary handling" );
+   BlockDataID referenceHandlingID  = blocks->addBlockData< BoundaryHandling_T >( BoundaryHandlingCreator( referenceID ), "reference boundary handling" );
+   const BlockDataID qFieldID       = field::addToStorage< QField_T >( blocks, "q", real_t(0), field::zyxf, uint_t(1) );
+
+   BlockDataID id = handlingID;
+   initializer::BoundaryFromTriangleMesh< BoundaryHandling_T > meshInitializer( *blocks, id );
+   meshInitializer.init( bvh, Obstacle );
+   meshInitializer.initQValues< stencil::D3Q19, QField_T >( bvh, qFieldID );
+
+   // the body concept: same result with the generic initializer
+   initializer::BoundaryFromBody< BoundaryHandling_T > bodyInitializer( *blocks, referenceHandlingID );
+   bodyInitializer.init( bvh, Obstacle );
+
+   uint_t obstacleCells = 0;
+   uint_t cutLinks = 0;
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldID );
+      FlagField_T * reference = block->getData< FlagField_T >( referenceID );
+      QField_T * qField = block->getData< QField_T >( qFieldID );
+      const FlagField_T::flag_t obstacle = flagField->getFlag( Obstacle );
+
+      for( auto cell = flagField->beginWithGhostLayer(); cell != flagField->end(); ++cell )
+      {
+         const Vec3 center = blocks->getBlockLocalCellCenter( *block, cell.cell() );
+         WALBERLA_CHECK_EQUAL( isFlagSet( cell, obstacle ), bvh.contains( center ) );
+         WALBERLA_CHECK_EQUAL( *cell, reference->get( cell.cell() ) );
+      }
+
+      for( auto cell = flagField->begin(); cell != flagField->end(); ++cell )
+      {
+         if( isFlagSet( cell, obstacle ) )
+         {
+            ++obstacleCells;
+            continue;
+         }
+
+         const Vec3 center = blocks->getBlockLocalCellCenter( *block, cell.cell() );
+         for( auto d = stencil::D3Q19::beginNoCenter(); d != stencil::D3Q19::end(); ++d )
+         {
+            const real_t q = qField->get( cell.x(), cell.y(), cell.z(), d.toIdx() );
+            const bool neighborInside = isFlagSet( cell.neighbor( *d ), obstacle );
+            if( neighborInside )
+            {
+               WALBERLA_CHECK_GREATER_EQUAL( q, real_t(0) );
+               WALBERLA_CHECK_LESS_EQUAL( q, real_t(1) );
+            }
+            if( q >= real_t(0) )
+            {
+               ++cutLinks;
+               const Vec3 wall = center + q * Vec3( real_c( d.cx() ), real_c( d.cy() ), real_c( d.cz() ) );
+               WALBERLA_CHECK_LESS( bvh.sqDistance( wall ), real_t(1e-12) );
+            }
+         }
+      }
+   }
+
+   WALBERLA_LOG_INFO( "obstacle cells: " << obstacleCells << ", cut links: " << cutLinks );
+   WALBERLA_CHECK_GREATER( obstacleCells, uint_t(0) );
+   WALBERLA_CHECK_GREATER( cutLinks, uint_t(0) );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+   mpi::Environment env( argc, argv );
+
+   sphereQueries();
+   boxQueries();
+   boundaryInitializer();
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InPlaceSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that the in-place (AA pattern) sweep is equivalent to the two-grid cell-wise sweep
+//
+//======================================================================================================================
+
+#include "lbm/boundary/NoSlip.h"
+#include "lbm/communication/InPlacePdfFieldPackInfo.h"
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/InPlaceSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "boundary/BoundaryHandling.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+typedef walberla::uint8_t    flag_t;
+typedef FlagField< flag_t >  FlagField_T;
+
+const FlagUID  Fluid_Flag( "fluid" );
+const FlagUID NoSlip_Flag( "no slip" );
+
+const uint_t BlockSize  = uint_t(6);
+const uint_t Timesteps  = uint_t(10);
+
+
+
+template< typename LatticeModel_T >
+class NoSlipBoundaryHandling
+{
+public:
+
+   typedef lbm::NoSlip< LatticeModel_T, flag_t >  NoSlip_T;
+   typedef boost::tuples::tuple< NoSlip_T >        BoundaryConditions_T;
+   typedef BoundaryHandling< FlagField_T, typename LatticeModel_T::Stencil, BoundaryConditions_T > BoundaryHandling_T;
+
+   NoSlipBoundaryHandling( const BlockDataID & flagField, const BlockDataID & pdfField ) : flagField_( flagField ), pdfField_( pdfField ) {}
+
+   BoundaryHandling_T * operator()( IBlock * const block, const StructuredBlockStorage * const storage ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagField_ );
+      lbm::PdfField< LatticeModel_T > * pdfField = block->getData< lbm::PdfField< LatticeModel_T > >( pdfField_ );
+
+      const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+      BoundaryHandling_T * handling = new BoundaryHandling_T( "boundary handling", flagField, fluid,
+                                                              boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField ) ) );
+
+      // periodic in x- and y-direction, walls at the bottom and the top
+
+      CellInterval domainBB = storage->getDomainCellBB();
+      storage->transformGlobalToBlockLocalCellInterval( domainBB, *block );
+      domainBB.expand( cell_idx_t(1) );
+
+      handling->forceBoundary( NoSlip_Flag, CellInterval( domainBB.xMin(), domainBB.yMin(), domainBB.zMin(), domainBB.xMax(), domainBB.yMax(), domainBB.zMin() ) );
+      handling->forceBoundary( NoSlip_Flag, CellInterval( domainBB.xMin(), domainBB.yMin(), domainBB.zMax(), domainBB.xMax(), domainBB.yMax(), domainBB.zMax() ) );
+
+      // an obstacle in the middle of the domain that crosses the block borders
+      CellInterval obstacle( cell_idx_c( BlockSize ) - cell_idx_t(2), cell_idx_c( BlockSize ) - cell_idx_t(1), cell_idx_c( BlockSize ) - cell_idx_t(1),
+                             cell_idx_c( BlockSize ) + cell_idx_t(1), cell_idx_c( BlockSize ), cell_idx_c( BlockSize ) );
+      storage->transformGlobalToBlockLocalCellInterval( obstacle, *block );
+      obstacle.intersect( flagField->xyzSizeWithGhostLayer() );
+      if( !obstacle.empty() )
+         handling->forceBoundary( NoSlip_Flag, obstacle );
+
+      handling->fillWithDomain( domainBB );
+
+      return handling;
+   }
+
+private:
+
+   const BlockDataID flagField_;
+   const BlockDataID  pdfField_;
+};
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+
+         const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+         const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+         const real_t z = real_t(2) * math::PI * real_c( global.z() ) / length;
+
+         const Vector3< real_t > velocity( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( z ), real_t(0.01) * std::sin( x ) );
+         pdfField->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, real_t(1) + real_t(0.01) * std::cos( x + y ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+   typedef typename NoSlipBoundaryHandling< LatticeModel_T >::BoundaryHandling_T BoundaryHandling_T;
+
+   // reference: cell-wise sweep with two PDF fields and lbm::NoSlip
+
+   BlockDataID flagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field" );
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, uint_t(1), field::fzyx );
+   BlockDataID   inPlaceId = lbm::addPdfFieldToStorage( blocks, "in-place pdf field" , latticeModel, uint_t(1), field::fzyx );
+
+   BlockDataID boundaryHandlingId = blocks->addStructuredBlockData< BoundaryHandling_T >(
+            NoSlipBoundaryHandling< LatticeModel_T >( flagFieldId, referenceId ), "boundary handling" );
+
+   initialize< LatticeModel_T >( blocks, referenceId );
+   initialize< LatticeModel_T >( blocks,   inPlaceId );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), Timesteps );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   timeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                  << Sweep( BoundaryHandling_T::getBlockSweep( boundaryHandlingId ), "reference boundary handling" );
+   timeloop.add() << Sweep( makeSharedSweep( lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( referenceId, flagFieldId, Fluid_Flag ) ),
+                            "reference stream & collide" );
+
+   // in-place sweep on a single PDF field
+
+   auto timestep = make_shared< lbm::InPlaceTimestep >();
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > inPlaceCommunication( blocks );
+   inPlaceCommunication.addPackInfo( make_shared< lbm::InPlacePdfFieldPackInfo< LatticeModel_T > >( inPlaceId, timestep ) );
+
+   timeloop.add() << BeforeFunction( inPlaceCommunication, "in-place communication" )
+                  << Sweep( makeSharedSweep( lbm::makeInPlaceSweep< LatticeModel_T, FlagField_T >( inPlaceId, flagFieldId, Fluid_Flag, timestep ) ),
+                            "in-place stream & collide" )
+                  << AfterFunction( lbm::InPlaceTimestep::getAdvanceFunction( timestep ), "in-place time step" );
+
+   timeloop.run();
+
+   WALBERLA_CHECK_EQUAL( timestep->getCounter(), Timesteps );
+   WALBERLA_CHECK( timestep->isEven() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const FlagField_T * flagField = block->template getData< FlagField_T >( flagFieldId );
+      const PdfField_T * reference  = block->template getData< PdfField_T >( referenceId );
+      const PdfField_T * inPlace    = block->template getData< PdfField_T >( inPlaceId );
+
+      const flag_t fluid = flagField->getFlag( Fluid_Flag );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         if( !flagField->isFlagSet( cell.x(), cell.y(), cell.z(), fluid ) )
+            continue;
+
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( reference->get( cell.x(), cell.y(), cell.z(), f ),
+                                                  inPlace->get( cell.x(), cell.y(), cell.z(), f ), real_t(1e-12),
+                                                "Cell " << Cell( cell.x(), cell.y(), cell.z() ) << ", component " << f );
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process: local communication between blocks and periodic communication of a block with itself
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      BlockSize, BlockSize, BlockSize,
+                                                      real_t(1), false,
+                                                      true, true, false ); // periodicity
+
+   test( blocks, lbm::D3Q19< lbm::collision_model::SRT, false >( lbm::collision_model::SRT( real_t(1.4) ) ) );
+   test( blocks, lbm::D3Q19< lbm::collision_model::TRT, true  >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ) );
+   test( blocks, lbm::D3Q27< lbm::collision_model::SRT, true  >( lbm::collision_model::SRT( real_t(1.4) ) ) );
+   test( blocks, lbm::D3Q27< lbm::collision_model::TRT, false >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ) );
+
+   return 0;
+}
@@ -0,0 +1,239 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file InnerOuterSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that splitting the stream & collide step into an inner and an outer part (overlapped with the
+//!        communication) is equivalent to the regular stream & collide step
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/SplitPureSweep.h"
+#include "lbm/sweeps/SplitSweep.h"
+#include "lbm/sweeps/SweepWrappers.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+
+#include "timeloop/CommunicationOverlap.h"
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+typedef FlagField< uint8_t > FlagField_T;
+
+const uint_t Timesteps = uint_t(10);
+
+const FlagUID Fluid_Flag( "fluid" );
+
+
+
+template< typename LatticeModel_T >
+struct MakeCellwiseSweep
+{
+   typedef lbm::CellwiseSweep< LatticeModel_T, field::DefaultEvaluationFilter, lbm::DefaultDensityEquilibriumVelocityCalculation,
+                               lbm::DefaultDensityVelocityCallback > Sweep_T;
+
+   shared_ptr< Sweep_T > operator()( const BlockDataID & pdfFieldId ) const
+   {
+      return lbm::makeCellwiseSweep< LatticeModel_T >( pdfFieldId );
+   }
+};
+
+template< typename LatticeModel_T >
+struct MakeSplitSweep
+{
+   MakeSplitSweep( const BlockDataID & flagFieldId ) : flagFieldId_( flagFieldId ) {}
+
+   shared_ptr< lbm::SplitSweep< LatticeModel_T, FlagField_T > > operator()( const BlockDataID & pdfFieldId ) const
+   {
+      return make_shared< lbm::SplitSweep< LatticeModel_T, FlagField_T > >( pdfFieldId, flagFieldId_, Set< FlagUID >( Fluid_Flag ) );
+   }
+
+   const BlockDataID flagFieldId_;
+};
+
+template< typename LatticeModel_T >
+struct MakeSplitPureSweep
+{
+   shared_ptr< lbm::SplitPureSweep< LatticeModel_T > > operator()( const BlockDataID & pdfFieldId ) const
+   {
+      return make_shared< lbm::SplitPureSweep< LatticeModel_T > >( pdfFieldId );
+   }
+};
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+
+         const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+         const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+         const real_t z = real_t(2) * math::PI * real_c( global.z() ) / length;
+
+         const Vector3< real_t > velocity( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( z ), real_t(0.01) * std::sin( x ) );
+         pdfField->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, real_t(1) + real_t(0.01) * std::cos( x + y ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T, typename MakeSweep_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const MakeSweep_T & makeSweep,
+           const field::Layout layout = field::fzyx )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+   typedef typename LatticeModel_T::CommunicationStencil CommunicationStencil_T;
+
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, uint_t(1), layout );
+   BlockDataID  overlapId  = lbm::addPdfFieldToStorage( blocks, "overlap pdf field", latticeModel, uint_t(1), layout );
+
+   initialize< LatticeModel_T >( blocks, referenceId );
+   initialize< LatticeModel_T >( blocks, overlapId );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), Timesteps );
+
+   // reference: blocking communication followed by the regular stream & collide sweep
+
+   blockforest::communication::UniformBufferedScheme< CommunicationStencil_T > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   timeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                  << Sweep( makeSharedSweep( makeSweep( referenceId ) ), "reference stream & collide" );
+
+   // start communication -> inner part -> wait for communication -> outer part
+
+   blockforest::communication::UniformBufferedScheme< CommunicationStencil_T > overlapCommunication( blocks );
+   overlapCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( overlapId ) );
+
+   auto sweep = makeSweep( overlapId );
+
+   timeloop::addCommunicationOverlap( timeloop, overlapCommunication,
+                                      Sweep( lbm::makeInnerSweep( sweep ), "stream & collide (inner)" ),
+                                      Sweep( lbm::makeOuterSweep( sweep ), "stream & collide (outer)" ), "overlap communication" );
+
+   timeloop.run();
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      const PdfField_T * overlap   = block->template getData< PdfField_T >( overlapId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL( reference->get( cell.x(), cell.y(), cell.z(), f ),
+                                          overlap->get( cell.x(), cell.y(), cell.z(), f ),
+                                        "Cell " << Cell( cell.x(), cell.y(), cell.z() ) << ", component " << f );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void testSplit( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const BlockDataID & flagFieldId )
+{
+   // the split sweeps have separate kernels for both layouts
+   test( blocks, latticeModel, MakeSplitSweep< LatticeModel_T >( flagFieldId ), field::fzyx );
+   test( blocks, latticeModel, MakeSplitSweep< LatticeModel_T >( flagFieldId ), field::zyxf );
+   test( blocks, latticeModel, MakeSplitPureSweep< LatticeModel_T >(), field::fzyx );
+   test( blocks, latticeModel, MakeSplitPureSweep< LatticeModel_T >(), field::zyxf );
+}
+
+
+
+void test( const shared_ptr< StructuredBlockForest > & blocks )
+{
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > D3Q19SRT;
+   typedef lbm::D3Q19< lbm::collision_model::TRT, true  > D3Q19TRTCompressible;
+   typedef lbm::D3Q19< lbm::collision_model::D3Q19MRT, false > D3Q19MRT;
+   typedef lbm::D3Q27< lbm::collision_model::SRT, true  > D3Q27SRTCompressible;
+   typedef lbm::D3Q27< lbm::collision_model::D3Q27Cumulant, true > D3Q27Cumulant;
+
+   test( blocks, D3Q19SRT( lbm::collision_model::SRT( real_t(1.4) ) ), MakeCellwiseSweep< D3Q19SRT >() );
+   test( blocks, D3Q19TRTCompressible( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), MakeCellwiseSweep< D3Q19TRTCompressible >() );
+   test( blocks, D3Q19MRT( lbm::collision_model::D3Q19MRT::constructTRT( real_t(1.8), real_t(1.7) ) ), MakeCellwiseSweep< D3Q19MRT >() );
+   test( blocks, D3Q27SRTCompressible( lbm::collision_model::SRT( real_t(1.4) ) ), MakeCellwiseSweep< D3Q27SRTCompressible >() );
+   test( blocks, D3Q27Cumulant( lbm::collision_model::D3Q27Cumulant( real_t(1.4) ) ), MakeCellwiseSweep< D3Q27Cumulant >() );
+
+   BlockDataID flagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field" );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagFieldId );
+      const FlagField_T::flag_t fluid = flagField->registerFlag( Fluid_Flag );
+      for( auto cell = flagField->beginXYZ(); cell != flagField->end(); ++cell )
+         flagField->addFlag( cell.x(), cell.y(), cell.z(), fluid );
+   }
+
+   testSplit( blocks, lbm::D3Q19< lbm::collision_model::SRT, false >( lbm::collision_model::SRT( real_t(1.4) ) ), flagFieldId );
+   testSplit( blocks, lbm::D3Q19< lbm::collision_model::SRT, true  >( lbm::collision_model::SRT( real_t(1.4) ) ), flagFieldId );
+   testSplit( blocks, lbm::D3Q19< lbm::collision_model::TRT, false >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), flagFieldId );
+   testSplit( blocks, lbm::D3Q19< lbm::collision_model::TRT, true  >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), flagFieldId );
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process, periodic in all directions, non-cubic blocks
+   test( blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                              uint_t(5), uint_t(6), uint_t(7),
+                                              real_t(1), false,
+                                              true, true, true ) );
+
+   // blocks that are too thin for an inner part in one direction (everything is processed by the outer part)
+   test( blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                              uint_t(2), uint_t(6), uint_t(4),
+                                              real_t(1), false,
+                                              true, true, true ) );
+
+   return 0;
+}
@@ -0,0 +1,245 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ListSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that the sparse (list-based) LBM kernel is equivalent to the cell-wise sweep with lbm::NoSlip
+//
+//======================================================================================================================
+
+#include "lbm/boundary/NoSlip.h"
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+#include "lbm/list/AddToStorage.h"
+#include "lbm/list/ListPackInfo.h"
+#include "lbm/list/ListSweep.h"
+#include "lbm/list/ListVTKWriter.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "boundary/BoundaryHandling.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+typedef walberla::uint8_t    flag_t;
+typedef FlagField< flag_t >  FlagField_T;
+
+const FlagUID  Fluid_Flag( "fluid" );
+const FlagUID NoSlip_Flag( "no slip" );
+
+const uint_t BlockSize  = uint_t(8);
+const uint_t Timesteps  = uint_t(10);
+
+
+
+// porous medium with a fluid fraction of about 40%, periodic in all directions
+
+bool isSolid( const shared_ptr< StructuredBlockForest > & blocks, const IBlock & block, const Cell & local )
+{
+   Cell global( local );
+   blocks->transformBlockLocalToGlobalCell( global, block );
+
+   const cell_idx_t xSize = cell_idx_c( blocks->getNumberOfXCells() );
+   const cell_idx_t ySize = cell_idx_c( blocks->getNumberOfYCells() );
+   const cell_idx_t zSize = cell_idx_c( blocks->getNumberOfZCells() );
+
+   const cell_idx_t x = ( global.x() + xSize ) % xSize;
+   const cell_idx_t y = ( global.y() + ySize ) % ySize;
+   const cell_idx_t z = ( global.z() + zSize ) % zSize;
+
+   return ( ( x * 7 + y * 13 + z * 29 + x * y * z ) % 10 ) < 6;
+}
+
+
+
+template< typename LatticeModel_T >
+class NoSlipBoundaryHandling
+{
+public:
+
+   typedef lbm::NoSlip< LatticeModel_T, flag_t >  NoSlip_T;
+   typedef boost::tuples::tuple< NoSlip_T >        BoundaryConditions_T;
+   typedef BoundaryHandling< FlagField_T, typename LatticeModel_T::Stencil, BoundaryConditions_T > BoundaryHandling_T;
+
+   NoSlipBoundaryHandling( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & flagField, const BlockDataID & pdfField ) :
+      blocks_( blocks ), flagField_( flagField ), pdfField_( pdfField ) {}
+
+   BoundaryHandling_T * operator()( IBlock * const block, const StructuredBlockStorage * const ) const
+   {
+      FlagField_T * flagField = block->getData< FlagField_T >( flagField_ );
+      lbm::PdfField< LatticeModel_T > * pdfField = block->getData< lbm::PdfField< LatticeModel_T > >( pdfField_ );
+
+      const auto fluid = flagField->flagExists( Fluid_Flag ) ? flagField->getFlag( Fluid_Flag ) : flagField->registerFlag( Fluid_Flag );
+
+      BoundaryHandling_T * handling = new BoundaryHandling_T( "boundary handling", flagField, fluid,
+                                                              boost::tuples::make_tuple( NoSlip_T( "no slip", NoSlip_Flag, pdfField ) ) );
+
+      // flags are set in the interior and in the ghost layer
+
+      for( auto cell = flagField->beginWithGhostLayerXYZ(); cell != flagField->end(); ++cell )
+      {
+         const Cell c( cell.x(), cell.y(), cell.z() );
+         if( isSolid( blocks_, *block, c ) )
+            handling->forceBoundary( NoSlip_Flag, c.x(), c.y(), c.z() );
+         else
+            handling->forceDomain( c.x(), c.y(), c.z() );
+      }
+
+      return handling;
+   }
+
+private:
+
+   shared_ptr< StructuredBlockForest > blocks_;
+   const BlockDataID flagField_;
+   const BlockDataID  pdfField_;
+};
+
+
+
+void initialValues( const shared_ptr< StructuredBlockForest > & blocks, const IBlock & block, const Cell & local,
+                    Vector3< real_t > & velocity, real_t & rho )
+{
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   Cell global( local );
+   blocks->transformBlockLocalToGlobalCell( global, block );
+
+   const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+   const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+   const real_t z = real_t(2) * math::PI * real_c( global.z() ) / length;
+
+   velocity = Vector3< real_t >( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( z ), real_t(0.01) * std::sin( x ) );
+   rho = real_t(1) + real_t(0.01) * std::cos( x + y );
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+   typedef lbm::List< LatticeModel_T > List_T;
+   typedef typename NoSlipBoundaryHandling< LatticeModel_T >::BoundaryHandling_T BoundaryHandling_T;
+
+   // reference: cell-wise sweep with two PDF fields and lbm::NoSlip
+
+   BlockDataID flagFieldId = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field" );
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, uint_t(1), field::fzyx );
+
+   BlockDataID boundaryHandlingId = blocks->addStructuredBlockData< BoundaryHandling_T >(
+            NoSlipBoundaryHandling< LatticeModel_T >( blocks, flagFieldId, referenceId ), "boundary handling" );
+
+   // list: created from the flag field that was set up by the boundary handling
+
+   BlockDataID listId = lbm::addListToStorage< LatticeModel_T, FlagField_T >( blocks, "list", latticeModel, flagFieldId, Fluid_Flag );
+
+   uint_t fluidCells( 0 );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      List_T * list = block->template getData< List_T >( listId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         Vector3< real_t > velocity;
+         real_t rho;
+         initialValues( blocks, *block, cell.cell(), velocity, rho );
+         reference->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, rho );
+
+         const auto idx = list->getIdx( cell.cell() );
+         WALBERLA_CHECK_EQUAL( idx == List_T::INVALID_IDX, isSolid( blocks, *block, cell.cell() ) );
+         if( idx != List_T::INVALID_IDX )
+            list->setDensityAndVelocity( idx, velocity, rho );
+      }
+
+      fluidCells += list->numFluidCells();
+   }
+
+   WALBERLA_CHECK_GREATER( fluidCells, uint_t(0) );
+   WALBERLA_CHECK_LESS( fluidCells, uint_t(8) * BlockSize * BlockSize * BlockSize / uint_t(2) );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), Timesteps );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   timeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                  << Sweep( BoundaryHandling_T::getBlockSweep( boundaryHandlingId ), "reference boundary handling" );
+   timeloop.add() << Sweep( makeSharedSweep( lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( referenceId, flagFieldId, Fluid_Flag ) ),
+                            "reference stream & collide" );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > listCommunication( blocks );
+   listCommunication.addPackInfo( make_shared< lbm::ListPackInfo< LatticeModel_T > >( listId ) );
+
+   timeloop.add() << BeforeFunction( listCommunication, "list communication" )
+                  << Sweep( makeSharedSweep( lbm::makeListSweep< LatticeModel_T >( listId ) ), "list stream & collide" );
+
+   timeloop.run();
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      const List_T * list = block->template getData< List_T >( listId );
+
+      for( uint_t i = 0; i != list->numFluidCells(); ++i )
+      {
+         const Cell & cell = list->getCell( typename List_T::index_t( i ) );
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( reference->get( cell, f ), list->get( typename List_T::index_t( i ), f ), real_t(1e-12),
+                                                "Cell " << cell << ", component " << f );
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process, periodic in all directions
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      BlockSize, BlockSize, BlockSize,
+                                                      real_t(1), false,
+                                                      true, true, true );
+
+   test( blocks, lbm::D3Q19< lbm::collision_model::SRT, false >( lbm::collision_model::SRT( real_t(1.4) ) ) );
+   test( blocks, lbm::D3Q19< lbm::collision_model::TRT, true  >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ) );
+   test( blocks, lbm::D3Q27< lbm::collision_model::SRT, true  >( lbm::collision_model::SRT( real_t(1.4) ) ) );
+
+   return 0;
+}
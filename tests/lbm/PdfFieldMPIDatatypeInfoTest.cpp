@@ -0,0 +1,152 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PdfFieldMPIDatatypeInfoTest.cpp
+//! \ingroup lbm
+//! \brief Checks that the bufferless communication of PDF fields with MPI datatypes fills the ghost layers with
+//!        exactly the PDFs that stream into the block
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldMPIDatatypeInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformDirectScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/mpi/Environment.h"
+
+#include "stencil/D3Q27.h"
+
+
+using namespace walberla;
+
+const uint_t BlockSize = uint_t(4);
+
+
+
+real_t value( const shared_ptr< StructuredBlockForest > & blocks, const Cell & globalCell, const uint_t f )
+{
+   // periodic domain: map the cell to the domain before computing the value
+   const cell_idx_t xSize = cell_idx_c( blocks->getNumberOfXCells() );
+   const cell_idx_t ySize = cell_idx_c( blocks->getNumberOfYCells() );
+   const cell_idx_t zSize = cell_idx_c( blocks->getNumberOfZCells() );
+
+   const cell_idx_t x = ( globalCell.x() + xSize ) % xSize;
+   const cell_idx_t y = ( globalCell.y() + ySize ) % ySize;
+   const cell_idx_t z = ( globalCell.z() + zSize ) % zSize;
+
+   return real_c( ( ( z * ySize + y ) * xSize + x ) * cell_idx_t(32) + cell_idx_c( f ) );
+}
+
+
+
+template< typename LatticeModel_T, typename CommunicationStencil_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const uint_t ghostLayers, const field::Layout layout )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+   typedef typename LatticeModel_T::Stencil Stencil_T;
+
+   LatticeModel_T latticeModel = LatticeModel_T( lbm::collision_model::SRT( real_t(1.4) ) );
+   BlockDataID pdfFieldId = lbm::addPdfFieldToStorage( blocks, "pdf field", latticeModel, ghostLayers, layout );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginWithGhostLayerXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+         for( uint_t f = 0; f != Stencil_T::Size; ++f )
+            pdfField->get( cell.x(), cell.y(), cell.z(), f ) = pdfField->isInInnerPart( Cell( cell.x(), cell.y(), cell.z() ) ) ?
+                                                               value( blocks, global, f ) : real_t(-1);
+      }
+   }
+
+   blockforest::communication::UniformDirectScheme< CommunicationStencil_T > communication( blocks );
+   communication.addDataToCommunicate( make_shared< lbm::communication::PdfFieldMPIDatatypeInfo< PdfField_T > >( pdfFieldId ) );
+   communication();
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+
+      for( auto dir = CommunicationStencil_T::beginNoCenter(); dir != CommunicationStencil_T::end(); ++dir )
+      {
+         // the PDFs that stream from the neighbor in direction 'dir' into this block
+         std::set< uint_t > streaming;
+         const stencil::Direction inv = stencil::inverseDir[ *dir ];
+         for( uint_t i = 0; i < Stencil_T::d_per_d_length[ inv ]; ++i )
+            streaming.insert( Stencil_T::idx[ Stencil_T::d_per_d[ inv ][ i ] ] );
+
+         CellInterval ghostRegion;
+         pdfField->getGhostRegion( *dir, ghostRegion, cell_idx_c( ghostLayers ) );
+
+         for( auto cell = ghostRegion.begin(); cell != ghostRegion.end(); ++cell )
+         {
+            // only the innermost ghost layer is communicated
+            const bool innermost = ( cell->x() >= -1 && cell->x() <= cell_idx_c( BlockSize ) ) &&
+                                   ( cell->y() >= -1 && cell->y() <= cell_idx_c( BlockSize ) ) &&
+                                   ( cell->z() >= -1 && cell->z() <= cell_idx_c( BlockSize ) );
+
+            Cell global( *cell );
+            blocks->transformBlockLocalToGlobalCell( global, *block );
+
+            for( uint_t f = 0; f != Stencil_T::Size; ++f )
+            {
+               const real_t expected = ( innermost && streaming.find( f ) != streaming.end() ) ? value( blocks, global, f ) : real_t(-1);
+               WALBERLA_CHECK_FLOAT_EQUAL( pdfField->get( *cell, f ), expected,
+                                           "Ghost cell " << *cell << ", direction " << stencil::dirToString[ *dir ] << ", component " << f );
+            }
+         }
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process, periodic in all directions
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      BlockSize, BlockSize, BlockSize,
+                                                      real_t(1), false,
+                                                      true, true, true );
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT > D3Q19_T;
+   typedef lbm::D3Q27< lbm::collision_model::SRT > D3Q27_T;
+
+   for( uint_t ghostLayers = uint_t(1); ghostLayers <= uint_t(2); ++ghostLayers )
+   {
+      test< D3Q19_T, D3Q19_T::CommunicationStencil >( blocks, ghostLayers, field::fzyx );
+      test< D3Q19_T, D3Q19_T::CommunicationStencil >( blocks, ghostLayers, field::zyxf );
+
+      // no PDF streams across the corners of a D3Q19 block -> no messages for these directions
+      test< D3Q19_T, stencil::D3Q27 >( blocks, ghostLayers, field::fzyx );
+
+      test< D3Q27_T, D3Q27_T::CommunicationStencil >( blocks, ghostLayers, field::fzyx );
+      test< D3Q27_T, D3Q27_T::CommunicationStencil >( blocks, ghostLayers, field::zyxf );
+   }
+
+   return 0;
+}
@@ -0,0 +1,155 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SplitSIMDSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that the explicitly vectorized split sweep is equivalent to the split pure sweep
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/SplitPureSweep.h"
+#include "lbm/sweeps/SplitSIMDSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "simd/SIMD.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+const uint_t Timesteps = uint_t(10);
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+
+         const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+         const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+         const real_t z = real_t(2) * math::PI * real_c( global.z() ) / length;
+
+         const Vector3< real_t > velocity( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( z ), real_t(0.01) * std::sin( x ) );
+         pdfField->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, real_t(1) + real_t(0.01) * std::cos( x + y ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const bool useStreamingStores )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, field::fzyx );
+   BlockDataID       simdId = lbm::addPdfFieldToStorage( blocks, "simd pdf field"     , latticeModel, field::fzyx );
+
+   initialize< LatticeModel_T >( blocks, referenceId );
+   initialize< LatticeModel_T >( blocks,      simdId );
+
+   SweepTimeloop timeloop( blocks->getBlockStorage(), Timesteps );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > simdCommunication( blocks );
+   simdCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( simdId ) );
+
+   timeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                  << Sweep( makeSharedSweep( make_shared< lbm::SplitPureSweep< LatticeModel_T > >( referenceId ) ), "reference stream & collide" );
+   timeloop.add() << BeforeFunction( simdCommunication, "simd communication" )
+                  << Sweep( makeSharedSweep( make_shared< lbm::SplitSIMDSweep< LatticeModel_T > >( simdId, useStreamingStores ) ), "simd stream & collide" );
+
+   timeloop.run();
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      const PdfField_T * simd      = block->template getData< PdfField_T >( simdId );
+
+      WALBERLA_CHECK( lbm::SplitSIMDSweep< LatticeModel_T >::isVectorizable( simd ) );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( reference->get( cell.x(), cell.y(), cell.z(), f ),
+                                                     simd->get( cell.x(), cell.y(), cell.z(), f ), real_t(1e-12),
+                                                "Cell " << Cell( cell.x(), cell.y(), cell.z() ) << ", component " << f );
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Instruction set: " << simd::usedInstructionSet() );
+
+   // 2x2x1 blocks on one process, periodic in all directions
+   // (x-size 16: 8-wide kernel if AVX-512 is available, x-size 12: always 4-wide kernel)
+   const uint_t xCells[] = { uint_t(16), uint_t(12) };
+
+   for( uint_t i = 0; i != uint_t(2); ++i )
+   {
+      auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(1),
+                                                         xCells[i], uint_t(8), uint_t(12),
+                                                         real_t(1), false,
+                                                         true, true, true );
+
+      for( int streaming = 0; streaming != 2; ++streaming )
+      {
+         const bool useStreamingStores = ( streaming == 1 );
+
+         test( blocks, lbm::D3Q19< lbm::collision_model::SRT, false >( lbm::collision_model::SRT( real_t(1.4) ) ), useStreamingStores );
+         test( blocks, lbm::D3Q19< lbm::collision_model::SRT, true  >( lbm::collision_model::SRT( real_t(1.4) ) ), useStreamingStores );
+         test( blocks, lbm::D3Q19< lbm::collision_model::TRT, false >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), useStreamingStores );
+         test( blocks, lbm::D3Q19< lbm::collision_model::TRT, true  >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), useStreamingStores );
+      }
+   }
+
+   return 0;
+}
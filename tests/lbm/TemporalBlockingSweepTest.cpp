@@ -0,0 +1,157 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TemporalBlockingSweepTest.cpp
+//! \ingroup lbm
+//! \brief Checks that fusing k time steps with wide ghost layers is equivalent to k regular time steps
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/lattice_model/D3Q27.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+#include "lbm/sweeps/TemporalBlockingSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "field/communication/PackInfo.h"
+
+#include "stencil/D3Q27.h"
+
+#include "timeloop/SweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+const uint_t BlockSize = uint_t(8);
+const uint_t Timesteps = uint_t(12);
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+
+         const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+         const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+         const real_t z = real_t(2) * math::PI * real_c( global.z() ) / length;
+
+         const Vector3< real_t > velocity( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( z ), real_t(0.01) * std::sin( x ) );
+         pdfField->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, real_t(1) + real_t(0.01) * std::cos( x + y ) );
+      }
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void test( const shared_ptr< StructuredBlockForest > & blocks, const LatticeModel_T & latticeModel, const uint_t k )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   // reference: one communication and one stream & collide sweep per time step
+
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, uint_t(1), field::fzyx );
+
+   initialize< LatticeModel_T >( blocks, referenceId );
+
+   SweepTimeloop referenceTimeloop( blocks->getBlockStorage(), Timesteps );
+
+   blockforest::communication::UniformBufferedScheme< typename LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   referenceTimeloop.add() << BeforeFunction( referenceCommunication, "reference communication" )
+                           << Sweep( makeSharedSweep( lbm::makeCellwiseSweep< LatticeModel_T >( referenceId ) ), "reference stream & collide" );
+
+   referenceTimeloop.run();
+
+   // temporal blocking: k ghost layers, one communication every k time steps
+
+   BlockDataID blockingId = lbm::addPdfFieldToStorage( blocks, "temporal blocking pdf field", latticeModel, k, field::fzyx );
+
+   initialize< LatticeModel_T >( blocks, blockingId );
+
+   SweepTimeloop blockingTimeloop( blocks->getBlockStorage(), Timesteps / k );
+
+   blockforest::communication::UniformBufferedScheme< stencil::D3Q27 > blockingCommunication( blocks );
+   blockingCommunication.addPackInfo( make_shared< field::communication::PackInfo< PdfField_T > >( blockingId ) );
+
+   blockingTimeloop.add() << BeforeFunction( blockingCommunication, "temporal blocking communication" )
+                          << Sweep( makeSharedSweep( lbm::makeTemporalBlockingSweep< LatticeModel_T >( blockingId, k ) ),
+                                    "temporal blocking stream & collide" );
+
+   blockingTimeloop.run();
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->template getData< PdfField_T >( referenceId );
+      const PdfField_T * blocking  = block->template getData< PdfField_T >( blockingId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( reference->get( cell.x(), cell.y(), cell.z(), f ),
+                                                 blocking->get( cell.x(), cell.y(), cell.z(), f ), real_t(1e-12),
+                                                "Cell " << Cell( cell.x(), cell.y(), cell.z() ) << ", component " << f << ", k = " << k );
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 2x2x2 blocks on one process, periodic in all directions
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(2),
+                                                      BlockSize, BlockSize, BlockSize,
+                                                      real_t(1), false,
+                                                      true, true, true );
+
+   for( uint_t k = uint_t(1); k <= uint_t(4); ++k )
+   {
+      test( blocks, lbm::D3Q19< lbm::collision_model::SRT, false >( lbm::collision_model::SRT( real_t(1.4) ) ), k );
+      test( blocks, lbm::D3Q19< lbm::collision_model::TRT, true  >( lbm::collision_model::TRT( real_t(1.8), real_t(1.7) ) ), k );
+      test( blocks, lbm::D3Q27< lbm::collision_model::SRT, true  >( lbm::collision_model::SRT( real_t(1.4) ) ), k );
+   }
+
+   return 0;
+}
@@ -443,8 +443,13 @@ int main( int argc, char ** argv )
                                                        Vector3< real_t >( topVelocity / real_c(2), real_c(0), real_c(0) ),
                                                        real_t(1), FieldGhostLayers );
 
+   BlockDataID pdfFieldId3 = lbm::addPdfFieldToStorage( blocks, "pdf field (3)", latticeModel,
+                                                       Vector3< real_t >( topVelocity / real_c(2), real_c(0), real_c(0) ),
+                                                       real_t(1), FieldGhostLayers );
+
    BlockDataID flagFieldId1 = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field (1)", FieldGhostLayers );
    BlockDataID flagFieldId2 = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field (2)", FieldGhostLayers );
+   BlockDataID flagFieldId3 = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field (3)", FieldGhostLayers );
 
    BlockDataID boundaryHandlingId1 = blocks->addBlockData< BoundaryHandling_T >( MyBoundaryHandling( flagFieldId1, pdfFieldId1, topVelocity ),
                                                                                  "boundary handling (1)" );
@@ -454,22 +459,32 @@ int main( int argc, char ** argv )
                                                                                  "boundary handling (2)" );
    setFlags( blocks, boundaryHandlingId2);
 
+   BlockDataID boundaryHandlingId3 = blocks->addBlockData< BoundaryHandling_T >( MyBoundaryHandling( flagFieldId3, pdfFieldId3, topVelocity ),
+                                                                                 "boundary handling (3)" );
+   setFlags( blocks, boundaryHandlingId3 );
+
    uint_t timeSteps = shortrun ? uint_t(2) : uint_t(101);
       
    SweepTimeloop timeloop( blocks->getBlockStorage(), timeSteps );
    
    auto mySweep1 = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( pdfFieldId1, flagFieldId1, Fluid_Flag );
    auto mySweep2 = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( pdfFieldId2, flagFieldId2, Fluid_Flag );
+   auto mySweep3 = lbm::makeCellwiseSweep< LatticeModel_T, FlagField_T >( pdfFieldId3, flagFieldId3, Fluid_Flag );
 
    auto tstep1 = lbm::refinement::makeTimeStep< LatticeModel_T, BoundaryHandling_T >( blocks, mySweep1, pdfFieldId1, boundaryHandlingId1 );
    auto tstep2 = lbm::refinement::makeTimeStep< LatticeModel_T, BoundaryHandling_T >( blocks, mySweep2, pdfFieldId2, boundaryHandlingId2 );
+   auto tstep3 = lbm::refinement::makeTimeStep< LatticeModel_T, BoundaryHandling_T >( blocks, mySweep3, pdfFieldId3, boundaryHandlingId3 );
    tstep1->optimizeCommunication( true );
    tstep2->optimizeCommunication( false );
+   tstep3->optimizeCommunication( true );
+   tstep3->pipelinedCommunication( true );
 
    timeloop.addFuncBeforeTimeStep( makeSharedFunctor( tstep1 ), "LBM refinement time step (1)" );
    timeloop.addFuncBeforeTimeStep( makeSharedFunctor( tstep2 ), "LBM refinement time step (2)" );
+   timeloop.addFuncBeforeTimeStep( makeSharedFunctor( tstep3 ), "LBM refinement time step (3)" );
    
    timeloop.addFuncAfterTimeStep( EqualityChecker( blocks, pdfFieldId1, pdfFieldId2 ), "equivalence checker" );
+   timeloop.addFuncAfterTimeStep( EqualityChecker( blocks, pdfFieldId1, pdfFieldId3 ), "equivalence checker (pipelined communication)" );
 
    timeloop.addFuncAfterTimeStep( makeSharedFunctor( field::makeStabilityChecker< lbm::PdfField< LatticeModel_T >, FlagField_T >( blocks, pdfFieldId1, flagFieldId1, Fluid_Flag,
                                                                                                                                   uint_t(1), false, true ) ),
@@ -34,6 +34,7 @@
 
 #include "pde/iterations/CGFixedStencilIteration.h"
 #include "pde/iterations/CGIteration.h"
+#include "pde/iterations/PipelinedCGIteration.h"
 
 #include "stencil/D2Q5.h"
 
@@ -41,6 +42,7 @@
 
 #include "vtk/VTKOutput.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace walberla;
@@ -115,6 +117,33 @@ void clearField( const shared_ptr< StructuredBlockStorage > & blocks, const Bloc
 
 
 
+void copyField( const shared_ptr< StructuredBlockStorage > & blocks, const BlockDataID & srcId, const BlockDataID & dstId )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      block->getData< PdeField_T >( dstId )->set( *( block->getData< PdeField_T >( srcId ) ) );
+   }
+}
+
+
+
+real_t maxDifference( const shared_ptr< StructuredBlockStorage > & blocks, const BlockDataID & aId, const BlockDataID & bId )
+{
+   real_t difference( real_t(0) );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdeField_T * a = block->getData< PdeField_T >( aId );
+      PdeField_T * b = block->getData< PdeField_T >( bId );
+      WALBERLA_FOR_ALL_CELLS_XYZ( a,
+         difference = std::max( difference, std::fabs( a->get(x,y,z) - b->get(x,y,z) ) );
+      );
+   }
+   mpi::allReduceInplace( difference, mpi::MAX );
+   return difference;
+}
+
+
+
 int main( int argc, char** argv )
 {
    debug::enterTestMode();
@@ -194,6 +223,56 @@ int main( int argc, char** argv )
    
    timeloop2.run();
 
+   // rerun the test with the pipelined CG iteration (with and without Jacobi preconditioner) and compare the results
+
+   BlockDataID cgId = field::addToStorage< PdeField_T >( blocks, "u (CG)", real_t(0), field::zyxf, uint_t(1) );
+   copyField( blocks, uId, cgId );
+
+   BlockDataID wId = field::addToStorage< PdeField_T >( blocks, "w", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID mId = field::addToStorage< PdeField_T >( blocks, "m", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID nId = field::addToStorage< PdeField_T >( blocks, "n", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID qId = field::addToStorage< PdeField_T >( blocks, "q", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID sId = field::addToStorage< PdeField_T >( blocks, "s", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID pId = field::addToStorage< PdeField_T >( blocks, "p", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID cId = field::addToStorage< PdeField_T >( blocks, "c", real_t(0), field::zyxf, uint_t(1) ); // preconditioned residual
+
+   blockforest::communication::UniformBufferedScheme< Stencil_T > synchronizeW( blocks );
+   synchronizeW.addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( wId ) );
+
+   blockforest::communication::UniformBufferedScheme< Stencil_T > synchronizeM( blocks );
+   synchronizeM.addPackInfo( make_shared< field::communication::PackInfo< PdeField_T > >( mId ) );
+
+   // Since the stencil is constant, CG with Jacobi preconditioner results in the same iterates as CG without preconditioner.
+
+   for( uint_t run = 0; run != uint_t(2); ++run )
+   {
+      clearField<PdeField_T>( blocks, uId );
+      initU( blocks, uId );
+
+      SweepTimeloop timeloop3( blocks, uint_t(1) );
+
+      if( run == uint_t(0) )
+      {
+         timeloop3.addFuncBeforeTimeStep( pde::PipelinedCGIteration< Stencil_T >( blocks->getBlockStorage(), uId, rId, wId, nId, zId, sId, pId, fId, stencilId,
+                                                                                 shortrun ? uint_t(10) : uint_t(10000), synchronizeW, real_c(1e-6) ),
+                                          "pipelined CG iteration" );
+      }
+      else
+      {
+         timeloop3.addFuncBeforeTimeStep( pde::PipelinedCGIteration< Stencil_T >( blocks->getBlockStorage(), uId, rId, cId, wId, mId, nId, zId, qId, sId, pId, fId, stencilId,
+                                                                                 shortrun ? uint_t(10) : uint_t(10000), synchronizeM,
+                                                                                 pde::JacobiPreconditioner< Stencil_T >( blocks->getBlockStorage(), stencilId ),
+                                                                                 real_c(1e-6) ),
+                                          "preconditioned pipelined CG iteration" );
+      }
+
+      timeloop3.run();
+
+      const real_t difference = maxDifference( blocks, uId, cgId );
+      WALBERLA_LOG_INFO_ON_ROOT( "Maximum difference between CG and pipelined CG" << ( ( run == uint_t(0) ) ? "" : " (Jacobi)" ) << ": " << difference );
+      WALBERLA_CHECK_LESS( difference, real_t(1e-6) );
+   }
+
    if( !shortrun )
    {
       vtk::writeDomainDecomposition( blocks );
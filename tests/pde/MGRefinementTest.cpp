@@ -0,0 +1,220 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file MGRefinementTest.cpp
+//! \ingroup pde
+//
+//======================================================================================================================
+
+#include "blockforest/SetupBlockForest.h"
+#include "blockforest/StructuredBlockForest.h"
+#include "blockforest/loadbalancing/StaticCurve.h"
+
+#include "core/Abort.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Limits.h"
+#include "core/math/Random.h"
+#include "core/mpi/Environment.h"
+#include "core/mpi/MPIManager.h"
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+#include "field/iterators/IteratorMacros.h"
+
+#include "pde/ResidualNormStencilField.h"
+#include "pde/iterations/VCycles.h"
+
+#include "stencil/D3Q7.h"
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace walberla;
+
+
+
+typedef GhostLayerField< real_t, 1 > PdeField_T;
+typedef stencil::D3Q7                Stencil_T;
+typedef pde::VCycles<Stencil_T>::StencilField_T  StencilField_T;
+
+
+
+// refines the blocks around a box in the lower octant of the domain up to level 'levels - 1'
+static void refinementSelection( SetupBlockForest & forest, const uint_t levels )
+{
+   const AABB & domain = forest.getDomain();
+
+   AABB box( domain.xMin() + real_t(0.15) * domain.xSize(), domain.yMin() + real_t(0.15) * domain.ySize(), domain.zMin() + real_t(0.15) * domain.zSize(),
+             domain.xMin() + real_t(0.2)  * domain.xSize(), domain.yMin() + real_t(0.2)  * domain.ySize(), domain.zMin() + real_t(0.2)  * domain.zSize() );
+
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      if( block->getAABB().intersects( box ) && block->getLevel() < ( levels - uint_t(1) ) )
+         block->setMarker( true );
+   }
+}
+
+static void workloadAndMemoryAssignment( SetupBlockForest & forest )
+{
+   for( auto block = forest.begin(); block != forest.end(); ++block )
+   {
+      block->setWorkload( numeric_cast< workload_t >( uint_t(1) ) );
+      block->setMemory( numeric_cast< memory_t >( 1 ) );
+   }
+}
+
+static shared_ptr< StructuredBlockForest > createBlockStructure( const uint_t levels, const uint_t rootBlocks, const uint_t cellsPerBlock )
+{
+   SetupBlockForest sforest;
+
+   sforest.addRefinementSelectionFunction( boost::bind( refinementSelection, _1, levels ) );
+   sforest.addWorkloadMemorySUIDAssignmentFunction( workloadAndMemoryAssignment );
+
+   const real_t size = real_c( rootBlocks * cellsPerBlock );
+   sforest.init( AABB( real_t(0), real_t(0), real_t(0), size, size, size ), rootBlocks, rootBlocks, rootBlocks, true, true, true );
+
+   sforest.balanceLoad( blockforest::StaticLevelwiseCurveBalance( true ), uint_c( MPIManager::instance()->numProcesses() ),
+                        real_t(0), math::Limits< memory_t >::inf(), true );
+
+   WALBERLA_CHECK_EQUAL( sforest.getNumberOfLevels(), levels );
+
+   MPIManager::instance()->useWorldComm();
+
+   auto blocks = make_shared< StructuredBlockForest >( make_shared< BlockForest >( uint_c( MPIManager::instance()->rank() ), sforest, false ),
+                                                      cellsPerBlock, cellsPerBlock, cellsPerBlock );
+   blocks->createCellBoundingBoxes();
+   return blocks;
+}
+
+
+
+// the 7-point Laplacian with the mesh size of the level of each block
+void initStencil( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & stencilId )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const uint_t level = blocks->getLevel( *block );
+      const real_t dx = blocks->dx( level );
+      const real_t dy = blocks->dy( level );
+      const real_t dz = blocks->dz( level );
+
+      std::vector< real_t > weights( Stencil_T::Size );
+      weights[ Stencil_T::idx[ stencil::C ] ] = real_t(2) / ( dx * dx ) + real_t(2) / ( dy * dy ) + real_t(2) / ( dz * dz );
+      weights[ Stencil_T::idx[ stencil::N ] ] = real_t(-1) / ( dy * dy );
+      weights[ Stencil_T::idx[ stencil::S ] ] = real_t(-1) / ( dy * dy );
+      weights[ Stencil_T::idx[ stencil::E ] ] = real_t(-1) / ( dx * dx );
+      weights[ Stencil_T::idx[ stencil::W ] ] = real_t(-1) / ( dx * dx );
+      weights[ Stencil_T::idx[ stencil::T ] ] = real_t(-1) / ( dz * dz );
+      weights[ Stencil_T::idx[ stencil::B ] ] = real_t(-1) / ( dz * dz );
+
+      StencilField_T * stencil = block->getData< StencilField_T >( stencilId );
+      WALBERLA_FOR_ALL_CELLS_XYZ(stencil,
+         for( auto dir = Stencil_T::begin(); dir != Stencil_T::end(); ++dir )
+            stencil->get(x,y,z,dir.toIdx()) = weights[ dir.toIdx() ];
+      );
+   }
+}
+
+
+
+void initU( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & uId )
+{
+   math::seedRandomGenerator( static_cast<unsigned int>( MPIManager::instance()->rank() ) );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdeField_T * u = block->getData< PdeField_T >( uId );
+      WALBERLA_FOR_ALL_CELLS_XYZ(u,
+         u->get(x,y,z) = math::realRandom( real_t(-10), real_t(10) );
+      );
+   }
+}
+
+
+
+// returns the largest convergence rate of all V-cycles
+real_t solve( const uint_t levels, const uint_t rootBlocks, const uint_t cellsPerBlock, const uint_t numLvl, const bool agglomerate )
+{
+   auto blocks = createBlockStructure( levels, rootBlocks, cellsPerBlock );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Solving on a block forest with " << levels << " levels and " << cellsPerBlock << "^3 cells per block with "
+                              << numLvl << " multigrid levels" << ( agglomerate ? " (agglomerated coarsest level)" : "" ) );
+
+   BlockDataID uId = field::addToStorage< PdeField_T >( blocks, "u", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID fId = field::addToStorage< PdeField_T >( blocks, "f", real_t(0), field::zyxf, uint_t(1) );
+   BlockDataID stencilId = field::addToStorage< StencilField_T >( blocks, "w", real_t(0), field::zyxf, uint_t(1) );
+
+   initStencil( blocks, stencilId );
+   initU( blocks, uId );
+
+   pde::VCycles< Stencil_T > solver( blocks, uId, fId, stencilId,
+                                     uint_t(20),                                                                              // iterations
+                                     numLvl,                                                                                  // levels
+                                     3, 3, 10,                                                                                // pre-smoothing, post-smoothing, coarse-grid iterations
+                                     pde::ResidualNormStencilField< Stencil_T >( blocks->getBlockStorage(), uId, fId, stencilId ), // residual norm functor
+                                     real_c(1e-8) );                                                                          // target precision
+   if( agglomerate )
+      solver.agglomerateCoarsestLevel();
+
+   solver();
+
+   real_t maxConvrate( real_t(0) );
+   auto & convrate = solver.convergenceRate();
+   for( uint_t i = 1; i < convrate.size(); ++i )
+   {
+      WALBERLA_LOG_RESULT_ON_ROOT( "Convergence rate in iteration " << i << ": " << convrate[i] );
+      maxConvrate = std::max( maxConvrate, convrate[i] );
+   }
+   WALBERLA_CHECK_GREATER( convrate.size(), uint_t(2) );
+
+   return maxConvrate;
+}
+
+
+
+int main( int argc, char** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   logging::Logging::printHeaderOnStream();
+
+   bool shortrun = false;
+   for( int i = 1; i < argc; ++i )
+      if( std::strcmp( argv[i], "--shortrun" ) == 0 ) shortrun = true;
+
+   // the coarsening uses the levels of the forest, the coarsest multigrid level is solved on the agglomerated forest
+
+   const real_t convrate = solve( uint_t(3), uint_t(2), uint_t(8), uint_t(3), false );
+   WALBERLA_CHECK_LESS( convrate, real_t(0.1) );
+
+   const real_t agglomeratedConvrate = solve( uint_t(3), uint_t(2), uint_t(8), uint_t(3), true );
+   WALBERLA_CHECK_LESS( agglomeratedConvrate, real_t(0.1) );
+
+   if( !shortrun )
+   {
+      // the convergence rate does not depend on the problem size
+
+      const real_t largeConvrate = solve( uint_t(3), uint_t(2), uint_t(16), uint_t(4), true );
+      WALBERLA_CHECK_LESS( largeConvrate, real_t(0.1) );
+   }
+
+   logging::Logging::printFooterOnStream();
+   return EXIT_SUCCESS;
+}
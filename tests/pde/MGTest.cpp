@@ -44,6 +44,7 @@
 #include "vtk/VTKOutput.h"
 
 #include <cmath>
+#include <vector>
 
 using namespace walberla;
 
@@ -245,6 +246,7 @@ int main( int argc, char** argv )
 
    timeloop2.run();
 
+   std::vector< real_t > referenceConvrate;
    if( !shortrun )
    {
       auto & convrate = solver->convergenceRate();
@@ -253,6 +255,35 @@ int main( int argc, char** argv )
          WALBERLA_LOG_RESULT_ON_ROOT("Convergence rate in iteration " << i << ": " << convrate[i]);
          WALBERLA_CHECK_LESS(convrate[i], real_t(0.1));
       }
+      referenceConvrate = convrate;
+   }
+
+   // rerun the test with the coarsest level agglomerated onto fewer processes (and further coarsened there)
+
+   clearField<PdeField_T>( blocks, uId);
+   initU( blocks, uId );
+
+   SweepTimeloop timeloop3( blocks, uint_t(1) );
+
+   solver = walberla::make_shared<pde::VCycles< Stencil_T > >( blocks, uId, fId, stencilId,
+                                                              shortrun ? uint_t(3) : uint_t(20),                                              // iterations
+                                                              shortrun ? uint_t(3) : uint_t(4),                                               // levels
+                                                              3, 3, 10,                                                                       // pre-smoothing, post-smoothing, coarse-grid iterations
+                                                              pde::ResidualNormStencilField< Stencil_T >( blocks->getBlockStorage(), uId, fId, stencilId ), // residual norm functor
+                                                              real_c(1e-12) );                                                                // target precision
+   solver->agglomerateCoarsestLevel( Vector3< uint_t >( xBlocks, uint_t(1), uint_t(1) ) );
+   timeloop3.addFuncBeforeTimeStep( makeSharedFunctor(solver), "Cell-centered multigrid V-cycles (agglomerated coarsest level)" );
+
+   timeloop3.run();
+
+   // the agglomeration must not degrade the convergence: the rates stay close to the ones without agglomeration
+   auto & convrate = solver->convergenceRate();
+   for (uint_t i = 1; i < convrate.size(); ++i)
+   {
+      WALBERLA_LOG_RESULT_ON_ROOT("Convergence rate in iteration " << i << ": " << convrate[i]);
+      WALBERLA_CHECK_LESS(convrate[i], real_t(0.025));
+      if( i < referenceConvrate.size() )
+         WALBERLA_CHECK_LESS(convrate[i], real_t(1.05) * referenceConvrate[i]);
    }
 
    logging::Logging::printFooterOnStream();
@@ -0,0 +1,157 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BatchedFCD.cpp
+//! \brief checks that the batched fine collision detection generates the same contacts as the generic one
+//
+//======================================================================================================================
+
+#include "pe/fcd/BatchedFCD.h"
+#include "pe/fcd/GenericFCD.h"
+#include "pe/Materials.h"
+
+#include "pe/rigidbody/Box.h"
+#include "pe/rigidbody/Capsule.h"
+#include "pe/rigidbody/Plane.h"
+#include "pe/rigidbody/Sphere.h"
+
+#include "pe/rigidbody/SetBodyTypeIDs.h"
+#include "pe/Types.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/DataTypes.h"
+#include "core/math/Random.h"
+
+#include <memory>
+#include <vector>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Box, Capsule, Plane, Sphere> BodyTuple ;
+
+void checkContact(const Contact& c1, const Contact& c2)
+{
+   WALBERLA_CHECK_EQUAL( c1.getBody1(), c2.getBody1() );
+   WALBERLA_CHECK_EQUAL( c1.getBody2(), c2.getBody2() );
+   WALBERLA_CHECK_FLOAT_EQUAL( c1.getPosition(), c2.getPosition() );
+   WALBERLA_CHECK_FLOAT_EQUAL( c1.getNormal(), c2.getNormal() );
+   WALBERLA_CHECK_FLOAT_EQUAL( c1.getDistance(), c2.getDistance() );
+}
+
+Vec3 randomVec3( const real_t min, const real_t max )
+{
+   return Vec3( math::realRandom(min, max), math::realRandom(min, max), math::realRandom(min, max) );
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+
+   math::seedRandomGenerator( 1337 );
+
+   MaterialID iron = Material::find("iron");
+
+   std::vector< std::unique_ptr<RigidBody> > bodies;
+   walberla::id_t sid = 0;
+   for (int i = 0; i < 60; ++i, ++sid)
+   {
+      bodies.emplace_back( new Sphere(sid, sid, randomVec3(0, 4), Vec3(0,0,0), Quat(), math::realRandom(real_t(0.2), real_t(0.8)), iron, false, true, false) );
+   }
+   for (int i = 0; i < 10; ++i, ++sid)
+   {
+      const Quat q( randomVec3(-1, 1).getNormalized(), math::realRandom(real_t(0), real_t(3)) );
+      bodies.emplace_back( new Box(sid, sid, randomVec3(0, 4), Vec3(0,0,0), q, randomVec3(real_t(0.3), real_t(1.5)), iron, false, true, false) );
+   }
+   bodies.emplace_back( new Capsule(sid, sid, Vec3(2,2,2), Vec3(0,0,0), Quat( Vec3(1,1,0).getNormalized(), real_t(1) ), real_t(0.3), real_t(1), iron, false, true, false) );
+   ++sid;
+   for (int i = 0; i < 6; ++i, ++sid)
+   {
+      bodies.emplace_back( new Plane(sid, sid, randomVec3(0, 4), randomVec3(-1, 1).getNormalized(), 0, iron) );
+   }
+
+   // all pairs in both orders, planes are never paired with each other
+   PossibleContacts possibleContacts;
+   for (size_t i = 0; i < bodies.size(); ++i)
+   {
+      for (size_t j = i + 1; j < bodies.size(); ++j)
+      {
+         if (bodies[i]->getTypeID() == Plane::getStaticTypeID() && bodies[j]->getTypeID() == Plane::getStaticTypeID())
+            continue;
+         if ((i + j) % 2 == 0)
+            possibleContacts.push_back( std::make_pair( bodies[i].get(), bodies[j].get() ) );
+         else
+            possibleContacts.push_back( std::make_pair( bodies[j].get(), bodies[i].get() ) );
+      }
+   }
+
+   fcd::GenericFCD<BodyTuple, fcd::AnalyticCollideFunctor> generic;
+   fcd::BatchedFCD<BodyTuple> batched;
+
+   // move the bodies a bit to check that the buffers of the batched version are updated correctly
+   for (int step = 0; step < 3; ++step)
+   {
+      Contacts& reference = generic.generateContacts( possibleContacts );
+      Contacts& contacts  = batched.generateContacts( possibleContacts );
+
+      WALBERLA_LOG_INFO( "possible contacts: " << possibleContacts.size() << ", contacts: " << contacts.size()
+                         << ", rejected by the SIMD kernels: " << batched.getNumberOfRejectedPairs() );
+
+      WALBERLA_CHECK_GREATER( reference.size(), 0 );
+      WALBERLA_CHECK_GREATER( batched.getNumberOfRejectedPairs(), 0 );
+      WALBERLA_CHECK_EQUAL( contacts.size(), reference.size() );
+      for (size_t i = 0; i < contacts.size(); ++i)
+      {
+         checkContact( contacts[i], reference[i] );
+      }
+
+      for (auto it = bodies.begin(); it != bodies.end(); ++it)
+      {
+         if ((*it)->getTypeID() != Plane::getStaticTypeID())
+            (*it)->setPosition( (*it)->getPosition() + randomVec3(real_t(-0.2), real_t(0.2)) );
+      }
+   }
+
+   // touching spheres and a sphere touching a plane must not be rejected
+   Sphere sp1(1000, 1000, Vec3(0,0,0), Vec3(0,0,0), Quat(), 1, iron, false, true, false);
+   Sphere sp2(1001, 1001, Vec3(real_t(2) + contactThreshold * real_t(0.5),0,0), Vec3(0,0,0), Quat(), 1, iron, false, true, false);
+   Plane  pl1(1002, 1002, Vec3(0,0,-1), Vec3(0,0,1), 0, iron);
+   PossibleContacts touching;
+   touching.push_back( std::make_pair( &sp1, &sp2 ) );
+   touching.push_back( std::make_pair( &pl1, &sp1 ) );
+   WALBERLA_CHECK_EQUAL( batched.generateContacts( touching ).size(), 2 );
+   WALBERLA_CHECK_EQUAL( batched.getNumberOfRejectedPairs(), 0 );
+
+   // a sphere whose center lies inside of a box is handled by the analytic function
+   Box bx1(1003, 1003, Vec3(real_t(0.2),0,0), Vec3(0,0,0), Quat(), Vec3(1,1,1), iron, false, true, false);
+   PossibleContacts inside;
+   inside.push_back( std::make_pair( &bx1, &sp1 ) );
+   inside.push_back( std::make_pair( &sp1, &sp2 ) );
+   inside.push_back( std::make_pair( &sp1, &bx1 ) );
+   Contacts& reference = generic.generateContacts( inside );
+   Contacts& contacts  = batched.generateContacts( inside );
+   WALBERLA_CHECK_EQUAL( contacts.size(), 3 );
+   WALBERLA_CHECK_EQUAL( reference.size(), 3 );
+   for (size_t i = 0; i < contacts.size(); ++i)
+   {
+      checkContact( contacts[i], reference[i] );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file ContactHistory.cpp
+//! \brief checks the contact history, warm starting of the HCSITS and the Cundall-Strack contact model of the DEM
+//
+//======================================================================================================================
+
+#include "pe/basic.h"
+#include "pe/contact/ContactHistory.h"
+
+#include "blockforest/all.h"
+#include "core/all.h"
+#include "domain_decomposition/all.h"
+
+#include "core/debug/TestSubsystem.h"
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Sphere, Box, Plane> BodyTuple ;
+
+void historyTest()
+{
+   ContactHistory<Vec3> history;
+
+   // two contacts of the same pair and a third contact
+   history.value( 2, 1 ) = Vec3( 1, 0, 0 );
+   history.value( 1, 2 ) = Vec3( 2, 0, 0 );
+   history.value( 3, 1 ) = Vec3( 3, 0, 0 );
+   history.finishTimestep();
+   WALBERLA_CHECK_EQUAL( history.size(), 3 );
+
+   // the contacts are identified independent of the order of the bodies
+   WALBERLA_CHECK_FLOAT_EQUAL( history.value( 1, 2 ), Vec3( 1, 0, 0 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( history.value( 2, 1 ), Vec3( 2, 0, 0 ) );
+   // new contact
+   WALBERLA_CHECK_FLOAT_EQUAL( history.value( 3, 4 ), Vec3( 0, 0, 0 ) );
+   history.finishTimestep();
+   // contact (1,3) was broken up
+   WALBERLA_CHECK_EQUAL( history.size(), 3 );
+   WALBERLA_CHECK_FLOAT_EQUAL( history.value( 1, 3 ), Vec3( 0, 0, 0 ) );
+
+   WALBERLA_CHECK_FLOAT_EQUAL( ContactHistory<Vec3>::orientation( 1, 2 ), real_t( 1) );
+   WALBERLA_CHECK_FLOAT_EQUAL( ContactHistory<Vec3>::orientation( 2, 1 ), real_t(-1) );
+
+   history.clear();
+   WALBERLA_CHECK_EQUAL( history.size(), 0 );
+}
+
+/// Returns the maximum penetration of a stack of spheres on a plane after some time steps
+real_t stackTest( const bool warmStarting )
+{
+   shared_ptr<BodyStorage> globalBodyStorage = make_shared<BodyStorage>();
+
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            math::AABB(0,0,0,20,20,20),
+            uint_c( 1), uint_c( 1), uint_c( 1), // number of blocks in x,y,z direction
+            uint_c( 1), uint_c( 1), uint_c( 1), // how many cells per block (x,y,z)
+            true,                               // max blocks per process
+            false, false, false,                // periodicity
+            false);
+
+   auto storageID           = forest->addBlockData(createStorageDataHandling<BodyTuple>(), "Storage");
+   auto hccdID              = forest->addBlockData(ccd::createHashGridsDataHandling( globalBodyStorage, storageID ), "HCCD");
+   auto fcdID               = forest->addBlockData(fcd::createGenericFCDDataHandling<BodyTuple, fcd::AnalyticCollideFunctor>(), "FCD");
+   cr::HCSITS cr(globalBodyStorage, forest->getBlockStoragePointer(), storageID, hccdID, fcdID);
+   cr.setMaxIterations( 10 );
+   cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticFrictionlessContact );
+   cr.setRelaxationParameter    ( real_t(0.7) );
+   cr.setErrorReductionParameter( real_t(0.1) );
+   cr.setGlobalLinearAcceleration( Vec3(0,0,-1) );
+   cr.setWarmStarting( warmStarting );
+   WALBERLA_CHECK_EQUAL( cr.isWarmStartingActive(), warmStarting );
+
+   pe::createPlane( *globalBodyStorage, 0, Vec3(0, 0, 1), Vec3(10, 10, 0) );
+
+   const uint_t numSpheres = 6;
+   std::vector<SphereID> spheres;
+   for (uint_t i = 0; i < numSpheres; ++i)
+      spheres.push_back( pe::createSphere( *globalBodyStorage, forest->getBlockStorage(), storageID, i + 1, Vec3(10, 10, real_t(1) + real_t(2) * real_c(i)), real_t(1) ) );
+
+   for (int t = 0; t < 200; ++t)
+      cr.timestep( real_t(0.1) );
+
+   if (warmStarting)
+   {
+      // one contact with the plane and between each pair of neighboring spheres
+      WALBERLA_CHECK_EQUAL( cr.getImpulseHistory().size(), numSpheres );
+   } else
+   {
+      WALBERLA_CHECK_EQUAL( cr.getImpulseHistory().size(), 0 );
+   }
+
+   return cr.getMaximumPenetration();
+}
+
+/// Moves a box that rests on a plane with a tangential acceleration of 'tangentialAcceleration'
+/// times the normal acceleration and returns the distance the box traveled. 'historySize' is the
+/// number of contacts in the contact history of the solver at the end.
+template< typename ContactResolver >
+real_t slidingDistance( const ContactResolver& resolveContact, const real_t tangentialAcceleration, size_t& historySize )
+{
+   shared_ptr<BodyStorage> globalBodyStorage = make_shared<BodyStorage>();
+
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            math::AABB(0,0,0,20,20,20),
+            uint_c( 1), uint_c( 1), uint_c( 1), // number of blocks in x,y,z direction
+            uint_c( 1), uint_c( 1), uint_c( 1), // how many cells per block (x,y,z)
+            true,                               // max blocks per process
+            false, false, false,                // periodicity
+            false);
+
+   auto storageID           = forest->addBlockData(createStorageDataHandling<BodyTuple>(), "Storage");
+   auto hccdID              = forest->addBlockData(ccd::createHashGridsDataHandling( globalBodyStorage, storageID ), "HCCD");
+   auto fcdID               = forest->addBlockData(fcd::createGenericFCDDataHandling<BodyTuple, fcd::AnalyticCollideFunctor>(), "FCD");
+   cr::DEMSolver<cr::IntegrateImplictEuler, ContactResolver> cr( cr::IntegrateImplictEuler(), resolveContact,
+                                                                 globalBodyStorage, forest->getBlockStoragePointer(), storageID, hccdID, fcdID );
+
+   // the coefficients of friction of a pair of bodies are the sums of the coefficients of the materials: mu = 0.5
+   //                                   density, cor, csf, cdf, poisson, young, stiffness, dampingN, dampingT
+   MaterialID material = createMaterial( real_t(1), real_t(0.5), real_t(0.25), real_t(0.25), real_t(0.2), real_t(80), real_t(1000), real_t(10), real_t(10) );
+
+   pe::createPlane( *globalBodyStorage, 0, Vec3(0, 0, 1), Vec3(10, 10, 0), material );
+   BoxID box = pe::createBox( *globalBodyStorage, forest->getBlockStorage(), storageID, 1, Vec3(10, 10, real_t(0.5)), Vec3(1, 1, 1), material );
+   WALBERLA_CHECK_NOT_NULLPTR( box );
+
+   const Vec3 acceleration( tangentialAcceleration, 0, -1 );
+   for (int t = 0; t < 5000; ++t)
+   {
+      box->setForce( box->getMass() * acceleration );
+      cr.timestep( real_t(0.001) );
+   }
+
+   WALBERLA_CHECK_EQUAL( cr.getNumberOfContacts(), 4 );
+   historySize = cr.getContactHistory().size();
+
+   return box->getPosition()[0] - real_t(10);
+}
+
+/// Contact resolver that takes the time step, but no contact history (signature selected by the DEMSolver)
+class ResolveContactHaffWernerWithTimeStep
+{
+public:
+   void operator()( ContactID c, const real_t dt ) const
+   {
+      WALBERLA_CHECK_FLOAT_EQUAL( dt, real_t(0.001) );
+      resolveContact_( c );
+   }
+private:
+   cr::ResolveContactSpringDashpotHaffWerner resolveContact_;
+};
+
+static_assert( cr::internal::ContactResolverSignature< cr::ResolveContactSpringDashpotHaffWerner >::value == 0, "wrong contact resolver signature" );
+static_assert( cr::internal::ContactResolverSignature< ResolveContactHaffWernerWithTimeStep      >::value == 1, "wrong contact resolver signature" );
+static_assert( cr::internal::ContactResolverSignature< cr::ResolveContactSpringDashpotCundallStrack >::value == 2, "wrong contact resolver signature" );
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+
+   logging::Logging::instance()->setStreamLogLevel(logging::Logging::PROGRESS);
+
+   WALBERLA_LOG_PROGRESS("Contact History Test");
+   historyTest();
+
+   WALBERLA_LOG_PROGRESS("HCSITS Warm Starting Test");
+   const real_t penetrationCold = stackTest( false );
+   const real_t penetrationWarm = stackTest( true );
+   WALBERLA_LOG_PROGRESS("maximum penetration without/with warm starting: " << penetrationCold << " / " << penetrationWarm);
+   WALBERLA_CHECK_LESS( penetrationWarm, real_t(0.01) * penetrationCold );
+
+   WALBERLA_LOG_PROGRESS("DEM Static Friction Test");
+   size_t historySize;
+   // Haff and Werner: the box creeps down the slope, no history is kept
+   const real_t creep = slidingDistance( cr::ResolveContactSpringDashpotHaffWerner(), real_t(0.3), historySize );
+   WALBERLA_CHECK_EQUAL( historySize, 0 );
+   const real_t creepWithTimeStep = slidingDistance( ResolveContactHaffWernerWithTimeStep(), real_t(0.3), historySize );
+   WALBERLA_CHECK_EQUAL( historySize, 0 );
+   WALBERLA_CHECK_FLOAT_EQUAL( creep, creepWithTimeStep );
+   // Cundall and Strack: only the tangential springs of the four corner contacts are stretched
+   const real_t stick = slidingDistance( cr::ResolveContactSpringDashpotCundallStrack(), real_t(0.3), historySize );
+   WALBERLA_CHECK_EQUAL( historySize, 4 );
+   // the friction force is exceeded
+   const real_t slide = slidingDistance( cr::ResolveContactSpringDashpotCundallStrack(), real_t(0.7), historySize );
+   WALBERLA_LOG_PROGRESS("sliding distances: " << creep << " / " << stick << " / " << slide);
+   WALBERLA_CHECK_GREATER( creep, real_t(5e-2) );
+   WALBERLA_CHECK_LESS   ( stick, real_t(5e-3) );
+   WALBERLA_CHECK_GREATER( slide, real_t(1) );
+
+   return EXIT_SUCCESS;
+}
@@ -96,6 +96,57 @@ void speedLimiterTest(cr::HCSITS& cr, SphereID sp)
    WALBERLA_CHECK_FLOAT_EQUAL( sp->getLinearVel(), Vec3(0,0,real_t(0.44)) );
 }
 
+void coloringTest(cr::HCSITS& cr, const shared_ptr<BodyStorage>& globalBodyStorage, const shared_ptr<StructuredBlockForest>& forest, BlockDataID storageID)
+{
+   // row of overlapping spheres resting on the plane
+   std::vector<SphereID> spheres;
+   for (int i = 0; i < 4; ++i)
+      spheres.push_back( pe::createSphere( *globalBodyStorage, forest->getBlockStorage(), storageID, 100 + uint_c(i), Vec3(real_t(1) + real_t(2.1) * real_c(i), 2, 6), real_c(1.1)) );
+
+   cr.setErrorReductionParameter( real_t(1.0) );
+   cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticFrictionlessContact );
+   cr.setRelaxationSchedule( cr::HardContactSemiImplicitTimesteppingSolvers::ColoredGaussSeidel );
+   cr.timestep( real_c( real_t(1.0) ) );
+
+   auto contactCaches = cr.getContactCache();
+   WALBERLA_CHECK_EQUAL( contactCaches.size(), 1 );
+   auto& contactCache = contactCaches.begin()->second;
+   // 4 sphere-plane contacts, 3 sphere-sphere contacts and the contact of the test sphere with the plane
+   WALBERLA_CHECK_EQUAL( contactCache.p_.size(), 8 );
+   WALBERLA_CHECK_EQUAL( contactCache.colorOrder_.size(), contactCache.p_.size() );
+   WALBERLA_CHECK_EQUAL( contactCache.colorStart_.back(), contactCache.p_.size() );
+   WALBERLA_CHECK_GREATER( contactCache.colorStart_.size(), 2 );
+
+   std::vector<bool> visited( contactCache.p_.size(), false );
+   for (size_t c = 0; c + 1 < contactCache.colorStart_.size(); ++c)
+   {
+      std::set<walberla::id_t> bodies;
+      for (size_t k = contactCache.colorStart_[c]; k < contactCache.colorStart_[c + 1]; ++k)
+      {
+         const size_t i = contactCache.colorOrder_[k];
+         WALBERLA_CHECK( !visited[i] );
+         visited[i] = true;
+         BodyID b[2] = { contactCache.body1_[i], contactCache.body2_[i] };
+         for (int j = 0; j < 2; ++j)
+         {
+            if (b[j]->hasInfiniteMass()) continue;
+            WALBERLA_CHECK( bodies.insert( b[j]->getSystemID() ).second, "contacts of color " << c << " share a body" );
+         }
+      }
+   }
+
+   // the spheres are pushed apart symmetrically and out of the plane
+   for (size_t i = 0; i < spheres.size(); ++i)
+   {
+      WALBERLA_CHECK_GREATER( spheres[i]->getPosition()[2], real_t(6) );
+   }
+   WALBERLA_CHECK_LESS   ( spheres[0]->getLinearVel()[0], real_t(0) );
+   WALBERLA_CHECK_GREATER( spheres[3]->getLinearVel()[0], real_t(0) );
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres[0]->getLinearVel()[0], -spheres[3]->getLinearVel()[0] );
+
+   cr.setRelaxationSchedule( cr::HardContactSemiImplicitTimesteppingSolvers::SequentialGaussSeidel );
+}
+
 int main( int argc, char** argv )
 {
    walberla::debug::enterTestMode();
@@ -154,9 +205,24 @@ int main( int argc, char** argv )
    cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticGeneralizedMaximumDissipationContact );
    normalReactionTest(cr, sp);
 
+   cr.setRelaxationSchedule( cr::HardContactSemiImplicitTimesteppingSolvers::ColoredGaussSeidel );
+   WALBERLA_LOG_PROGRESS("Normal Reaction Test: InelasticFrictionlessContact, ColoredGaussSeidel");
+   cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticFrictionlessContact );
+   normalReactionTest(cr, sp);
+   WALBERLA_LOG_PROGRESS( "Normal Reaction Test: InelasticGeneralizedMaximumDissipationContact, ColoredGaussSeidel");
+   cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticGeneralizedMaximumDissipationContact );
+   normalReactionTest(cr, sp);
+   cr.setRelaxationSchedule( cr::HardContactSemiImplicitTimesteppingSolvers::SequentialGaussSeidel );
+
    WALBERLA_LOG_PROGRESS("SpeedLimiter Test: InelasticFrictionlessContact");
    cr.setRelaxationModel( cr::HardContactSemiImplicitTimesteppingSolvers::InelasticFrictionlessContact );
    speedLimiterTest(cr, sp);
 
+   WALBERLA_LOG_PROGRESS("Coloring Test");
+   cr.setSpeedLimiter( false );
+   sp->setPosition(  Vec3(5,5,6) );
+   sp->setLinearVel( Vec3(0,0,0) );
+   coloringTest(cr, globalBodyStorage, forest, storageID);
+
    return EXIT_SUCCESS;
 }
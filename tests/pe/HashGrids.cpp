@@ -116,6 +116,12 @@ int main( int argc, char** argv )
 
     syncShadowOwners<BodyTuple>( forest->getBlockForest(), storageID);
     for (int i=0; i < 100; ++i){
+       if (i == 50)
+       {
+          // second half: sort the occupied cells of the hash grids every few time steps
+          for (auto it = forest->begin(); it != forest->end(); ++it)
+             it->getData< ccd::HashGrids >( hccdID )->setCellSortingInterval( 7 );
+       }
        cr( real_c(0.1) );
        syncShadowOwners<BodyTuple>( forest->getBlockForest(), storageID);
 
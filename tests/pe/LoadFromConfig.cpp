@@ -70,7 +70,9 @@ int main( int argc, char ** argv )
    configure(configBlock, hcsits);
    //! [Config HCSITS]
    WALBERLA_CHECK_EQUAL( hcsits.getRelaxationModel(), cr::HCSITS::RelaxationModel::ApproximateInelasticCoulombContactByDecoupling );
+   WALBERLA_CHECK_EQUAL( hcsits.getRelaxationSchedule(), cr::HCSITS::RelaxationSchedule::ColoredGaussSeidel );
    WALBERLA_CHECK_EQUAL( hcsits.getMaxIterations(), 123 );
+   WALBERLA_CHECK( hcsits.isWarmStartingActive() );
    WALBERLA_CHECK_FLOAT_EQUAL( hcsits.getRelaxationParameter(), real_t(0.123) );
    WALBERLA_CHECK_FLOAT_EQUAL( hcsits.getErrorReductionParameter(), real_t(0.123) );
    WALBERLA_CHECK_FLOAT_EQUAL( hcsits.getGlobalLinearAcceleration(), Vec3(1,-2,3) );
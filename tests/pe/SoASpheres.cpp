@@ -0,0 +1,219 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file SoASpheres.cpp
+//! \brief Checks the structure-of-arrays sphere storage, its coarse collision detection and that the soa::DEM
+//!        yields the same trajectories as the cr::DEM
+//
+//======================================================================================================================
+
+#include "pe/basic.h"
+#include "pe/soa/DEM.h"
+#include "pe/soa/HashGrid.h"
+#include "pe/soa/SphereStorage.h"
+
+#include "blockforest/all.h"
+#include "core/all.h"
+#include "domain_decomposition/all.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Random.h"
+
+#include <set>
+#include <utility>
+
+using namespace walberla;
+using namespace walberla::pe;
+
+typedef boost::tuple<Sphere, Plane> BodyTuple ;
+
+void checkStorage()
+{
+   MaterialID iron = Material::find("iron");
+
+   soa::SphereStorage spheres;
+   for( walberla::id_t sid = 0; sid < 5; ++sid )
+      spheres.add( sid, Vec3( real_c(sid), 0, 0 ), real_t(1), iron, Vec3( 0, real_c(sid), 0 ) );
+   spheres.add( 5, Vec3( 5, 0, 0 ), real_t(1), iron, Vec3(), Vec3(), Quat(), true );
+
+   WALBERLA_CHECK_EQUAL( spheres.size(), 6 );
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres.invMass()[0], real_t(1) / Sphere::calcMass( real_t(1), Material::getDensity( iron ) ) );
+   WALBERLA_CHECK( !spheres.hasInfiniteMass( 0 ) );
+   WALBERLA_CHECK( spheres.hasInfiniteMass( 5 ) );
+
+   // removing moves the last sphere into the gap
+   spheres.remove( spheres.find( 1 ) );
+   WALBERLA_CHECK_EQUAL( spheres.size(), 5 );
+   WALBERLA_CHECK_EQUAL( spheres.find( 1 ), spheres.size() );
+   WALBERLA_CHECK_EQUAL( spheres.find( 5 ), 1 );
+   WALBERLA_CHECK_EQUAL( spheres.systemID()[1], 5 );
+   WALBERLA_CHECK( spheres.hasInfiniteMass( 1 ) );
+   for( walberla::id_t sid = 2; sid < 5; ++sid )
+   {
+      const size_t idx = spheres.find( sid );
+      WALBERLA_CHECK_LESS( idx, spheres.size() );
+      WALBERLA_CHECK_FLOAT_EQUAL( spheres.getPosition( idx ), Vec3( real_c(sid), 0, 0 ) );
+      WALBERLA_CHECK_FLOAT_EQUAL( spheres.getLinearVel( idx ), Vec3( 0, real_c(sid), 0 ) );
+   }
+
+   spheres.addForceAtPos( 0, Vec3( 0, 1, 0 ), Vec3( 1, 0, 0 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres.getForce( 0 ),  Vec3( 0, 1, 0 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres.getTorque( 0 ), Vec3( 0, 0, 1 ) );
+   spheres.resetForceAndTorque();
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres.getForce( 0 ),  Vec3() );
+   WALBERLA_CHECK_FLOAT_EQUAL( spheres.getTorque( 0 ), Vec3() );
+}
+
+/// every pair of overlapping spheres must be found exactly once
+void checkHashGrid()
+{
+   MaterialID iron = Material::find("iron");
+
+   math::seedRandomGenerator(42);
+
+   soa::SphereStorage spheres;
+   for( walberla::id_t sid = 0; sid < 1000; ++sid )
+   {
+      const Vec3 pos( math::realRandom<real_t>( real_t(0), real_t(20) ), math::realRandom<real_t>( real_t(0), real_t(20) ),
+                      math::realRandom<real_t>( real_t(0), real_t(5) ) );
+      spheres.add( sid, pos, math::realRandom<real_t>( real_c(0.2), real_c(0.6) ), iron );
+   }
+   // a few spheres far away enlarge the bounding box -> the cells are enlarged
+   spheres.add( 1000, Vec3( 1000, 1000, 1000 ), real_c(0.5), iron );
+   spheres.add( 1001, Vec3( -1000, 1000, -1000 ), real_c(0.5), iron );
+
+   soa::HashGrid hashGrid;
+   hashGrid.generatePossibleContacts( spheres );
+   WALBERLA_CHECK_LESS_EQUAL( hashGrid.getNumberOfCells(), 8 * spheres.size() + 64 );
+
+   std::set< std::pair<size_t, size_t> > possibleContacts;
+   for( size_t c = 0; c < hashGrid.getNumberOfPossibleContacts(); ++c )
+   {
+      const size_t i = hashGrid.getFirst()[c];
+      const size_t j = hashGrid.getSecond()[c];
+      WALBERLA_CHECK_UNEQUAL( i, j );
+      WALBERLA_CHECK( possibleContacts.insert( std::make_pair( std::min( i, j ), std::max( i, j ) ) ).second, "Duplicate pair " << i << ", " << j );
+   }
+
+   size_t contacts( 0 );
+   for( size_t i = 0; i < spheres.size(); ++i )
+      for( size_t j = i + 1; j < spheres.size(); ++j )
+      {
+         const real_t dist = ( spheres.getPosition( i ) - spheres.getPosition( j ) ).length() - spheres.radius()[i] - spheres.radius()[j];
+         if( dist < contactThreshold )
+         {
+            WALBERLA_CHECK( possibleContacts.find( std::make_pair( i, j ) ) != possibleContacts.end(), "Missing pair " << i << ", " << j );
+            ++contacts;
+         }
+      }
+   WALBERLA_CHECK_GREATER( contacts, 0 );
+}
+
+/// soa::DEM and cr::DEM must yield the same trajectories (up to round-off)
+void checkDEM()
+{
+   MaterialID material = createMaterial( "soa", real_t(1), real_c(0.5), real_c(0.1), real_c(0.1), real_c(0.2), real_t(80), real_t(1000), real_t(10), real_t(10) );
+
+   shared_ptr<BodyStorage> globalStorage = make_shared<BodyStorage>();
+
+   shared_ptr< StructuredBlockForest > forest = blockforest::createUniformBlockGrid(
+            uint_c( 1), uint_c( 1), uint_c( 1), // number of blocks in x,y,z direction
+            uint_c( 1), uint_c( 1), uint_c( 1), // how many cells per block (x,y,z)
+            real_c( 6),                         // dx: length of one cell in physical coordinates
+            0,                                  // max blocks per process
+            false, false,                       // include metis / force metis
+            false, false, false );              // no periodicity
+
+   SetBodyTypeIDs<BodyTuple>::execute();
+
+   auto storageID = forest->addBlockData(createStorageDataHandling<BodyTuple>(), "Storage");
+   auto ccdID     = forest->addBlockData(ccd::createHashGridsDataHandling( globalStorage, storageID ), "CCD");
+   auto fcdID     = forest->addBlockData(fcd::createGenericFCDDataHandling<BodyTuple, fcd::AnalyticCollideFunctor>(), "FCD");
+
+   cr::DEM reference( globalStorage, forest->getBlockStoragePointer(), storageID, ccdID, fcdID, NULL );
+   reference.setGlobalLinearAcceleration( Vec3( 0, 0, -10 ) );
+
+   pe::createPlane( *globalStorage, 0, Vec3(0, 0, +1), Vec3(3, 3, 0), material);
+   pe::createPlane( *globalStorage, 0, Vec3(0, 0, -1), Vec3(3, 3, 6), material);
+   pe::createPlane( *globalStorage, 0, Vec3(0, +1, 0), Vec3(3, 0, 3), material);
+   pe::createPlane( *globalStorage, 0, Vec3(0, -1, 0), Vec3(3, 6, 3), material);
+   pe::createPlane( *globalStorage, 0, Vec3(+1, 0, 0), Vec3(0, 3, 3), material);
+   pe::createPlane( *globalStorage, 0, Vec3(-1, 0, 0), Vec3(6, 3, 3), material);
+
+   math::seedRandomGenerator(1337);
+   walberla::id_t counter = 0;
+   for (int z = 0; z < 4; ++z)
+      for (int y = 0; y < 4; ++y)
+         for (int x = 0; x < 4; ++x)
+         {
+            SphereID sp = pe::createSphere( *globalStorage, forest->getBlockStorage(), storageID, ++counter,
+                                            Vec3(real_c(0.75) + real_c(1.5) * real_c(x), real_c(0.75) + real_c(1.5) * real_c(y), real_c(0.75) + real_c(1.5) * real_c(z)),
+                                            real_c(0.5) + real_c(0.1) * math::realRandom<real_t>(), material );
+            WALBERLA_CHECK_NOT_NULLPTR( sp );
+            sp->setLinearVel( Vec3( math::realRandom<real_t>(-1, 1), math::realRandom<real_t>(-1, 1), math::realRandom<real_t>(-1, 1) ) );
+         }
+
+   BodyStorage& localStorage = (*forest->begin()->getData< Storage >( storageID ))[0];
+
+   shared_ptr<soa::SphereStorage> spheres = make_shared<soa::SphereStorage>();
+   WALBERLA_CHECK_EQUAL( soa::addSpheres( *spheres, localStorage ), 64 );
+
+   soa::DEM dem( spheres );
+   dem.setGlobalLinearAcceleration( Vec3( 0, 0, -10 ) );
+   WALBERLA_CHECK_EQUAL( dem.addPlanes( *globalStorage ), 6 );
+
+   const real_t dt = real_c(0.001);
+   size_t contacts( 0 );
+   for( int step = 0; step < 1000; ++step )
+   {
+      reference.timestep( dt );
+      dem.timestep( dt );
+
+      WALBERLA_CHECK_EQUAL( dem.getNumberOfContacts(), reference.getNumberOfContacts(), "time step " << step );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( dem.getMaximumPenetration(), reference.getMaximumPenetration(), real_c(1e-8), "time step " << step );
+      contacts += dem.getNumberOfContacts();
+   }
+   WALBERLA_CHECK_GREATER( contacts, 1000 );
+
+   for( auto bodyIt = localStorage.begin(); bodyIt != localStorage.end(); ++bodyIt )
+   {
+      const size_t idx = spheres->find( bodyIt->getSystemID() );
+      WALBERLA_CHECK_LESS( idx, spheres->size() );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( spheres->getPosition( idx ),    bodyIt->getPosition(),    real_c(1e-8) );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( spheres->getLinearVel( idx ),   bodyIt->getLinearVel(),   real_c(1e-8) );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( spheres->getAngularVel( idx ),  bodyIt->getAngularVel(),  real_c(1e-8) );
+      WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( spheres->getQuaternion( idx ),  bodyIt->getQuaternion(),  real_c(1e-8) );
+   }
+
+   // write back to the bodies
+   for( size_t i = 0; i < spheres->size(); ++i )
+      spheres->setLinearVel( i, Vec3( real_c(i), 0, 0 ) );
+   WALBERLA_CHECK_EQUAL( soa::updateBodyStorage( *spheres, localStorage ), 64 );
+   for( auto bodyIt = localStorage.begin(); bodyIt != localStorage.end(); ++bodyIt )
+      WALBERLA_CHECK_FLOAT_EQUAL( bodyIt->getLinearVel(), spheres->getLinearVel( spheres->find( bodyIt->getSystemID() ) ) );
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+
+   checkStorage();
+   checkHashGrid();
+   checkDEM();
+
+   return EXIT_SUCCESS;
+}
@@ -33,6 +33,8 @@
 
 #include <boost/tuple/tuple.hpp>
 
+#include <cstring>
+
 using namespace walberla;
 using namespace walberla::pe;
 using namespace walberla::blockforest;
@@ -86,6 +88,16 @@ int main( int argc, char ** argv )
 
    walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
 
+   bool syncDelta = false;
+   for( int i = 1; i < argc; ++i )
+   {
+      if( std::strcmp( argv[i], "--syncDelta" ) == 0 ) syncDelta = true;
+   }
+   if (syncDelta)
+   {
+      WALBERLA_LOG_INFO_ON_ROOT("running with SyncNextNeighborsDelta");
+   }
+
 //   logging::Logging::instance()->setFileLogLevel( logging::Logging::DETAIL );
 //   logging::Logging::instance()->includeLoggingToFile("SyncLog");
 
@@ -145,152 +157,162 @@ int main( int argc, char ** argv )
    mpi::broadcastObject(sid, sphereRank);
    WALBERLA_LOG_DETAIL("sphere with sid " << sid << " is loacted on rank " << sphereRank);
 
+   SyncNextNeighborsDelta<BodyTuple> syncNextNeighborsDelta;
+   boost::function<void(void)> syncCall;
+   if (!syncDelta)
+   {
+      syncCall = boost::bind( pe::syncNextNeighbors<BodyTuple>, boost::ref(forest->getBlockForest()), storageID, static_cast<WcTimingTree*>(NULL), real_c(0.0), false );
+   } else
+   {
+      syncCall = boost::bind<void>( boost::ref(syncNextNeighborsDelta), boost::ref(forest->getBlockForest()), storageID, static_cast<WcTimingTree*>(NULL), real_c(0.0), false );
+   }
+
    WALBERLA_LOG_PROGRESS("*********************** [1 1 1] TEST ***********************");
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(19,19,19));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(21,21,21));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(25,25,25));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(29,29,29));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(31,31,31));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 5, 5, 5));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 9, 9, 9));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(11,11,11));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,15));
 
 
    WALBERLA_LOG_PROGRESS("*********************** [-1 1 1] TEST ***********************");
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(11,19,19));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 9,21,21));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 5,25,25));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 1,29,29));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(-1,31,31));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(25,05, 5));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(21, 9, 9));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(19,11,11));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,15));
 
 
    WALBERLA_LOG_PROGRESS("*********************** [-1 -1 1] TEST ***********************");
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(11,11,19));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 9, 9,21));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 5, 5,25));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3( 1, 1,29));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(-1,-1,31));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(25,25, 5));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(21,21, 9));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(19,19,11));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,15));
 
 
    WALBERLA_LOG_PROGRESS("*********************** [0 1 1] TEST ***********************");
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,19,19));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,21,21));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,25,25));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,29,29));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,31,31));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15, 5, 5));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15, 9, 9));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,11,11));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,15));
 
 
    WALBERLA_LOG_PROGRESS("*********************** [0 0 1] TEST ***********************");
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,19));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,21));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,25));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,29));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,31));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15, 5));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15, 9));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,11));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
    checkSphere(*forest, storageID, sid, refSphere, Vec3(15,15,15));
 
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
-   syncNextNeighbors<BodyTuple>(forest->getBlockForest(), storageID);
+   syncCall();
+   syncCall();
 
    //*****************************************************************************************
 
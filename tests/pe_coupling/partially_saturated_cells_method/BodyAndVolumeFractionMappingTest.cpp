@@ -0,0 +1,261 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file BodyAndVolumeFractionMappingTest.cpp
+//! \ingroup pe_coupling
+//! \brief Checks that the incremental update of BodyAndVolumeFractionMapping yields the same field as a fresh initialization
+//
+//======================================================================================================================
+
+#include "blockforest/Initialization.h"
+
+#include "core/DataTypes.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+
+#include "pe/basic.h"
+
+#include "pe_coupling/partially_saturated_cells_method/all.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace body_and_volume_fraction_mapping_test
+{
+
+using namespace walberla;
+
+typedef boost::tuple<pe::Sphere> BodyTypeTuple;
+
+typedef std::map< std::pair< const IBlock *, Cell >, real_t > Fractions_T;
+
+const uint_t cellsPerBlock = uint_t(10);
+
+const real_t velocityUpdatingEpsilon = real_t(1e-3);
+const real_t positionUpdatingEpsilon = real_t(0.05);
+const uint_t superSamplingDepth      = uint_t(2);
+
+
+
+/// returns the local copy of the body with system ID 'sid' (NULL if the body does not exist anymore)
+pe::BodyID getLocalBody( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & bodyStorageID, const walberla::id_t sid )
+{
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+      for( auto bodyIt = pe::LocalBodyIterator::begin( *blockIt, bodyStorageID ); bodyIt != pe::LocalBodyIterator::end(); ++bodyIt )
+         if( bodyIt->getSystemID() == sid )
+            return *bodyIt;
+   return NULL;
+}
+
+void sync( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & bodyStorageID )
+{
+   const real_t overlap = real_t(1.5);
+   for( uint_t i = 0; i < uint_t(2); ++i )
+      pe::syncShadowOwners<BodyTypeTuple>( blocks->getBlockForest(), bodyStorageID, NULL, overlap );
+}
+
+void move( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & bodyStorageID, const walberla::id_t sid,
+           const Vector3<real_t> & displacement )
+{
+   pe::BodyID body = getLocalBody( blocks, bodyStorageID, sid );
+   WALBERLA_CHECK_NOT_NULLPTR( body );
+   body->setPosition( body->getPosition() + displacement );
+}
+
+/// returns the volume fractions of 'body' in all cells (including ghost layers) of all blocks
+Fractions_T getFractions( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldID, const pe::BodyID body )
+{
+   Fractions_T fractions;
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+   {
+      pe_coupling::BodyAndVolumeFractionField_T * field = blockIt->getData< pe_coupling::BodyAndVolumeFractionField_T >( fieldID );
+      const CellInterval cells = field->xyzSizeWithGhostLayer();
+      for( auto cell = cells.begin(); cell != cells.end(); ++cell )
+      {
+         const pe_coupling::BodyAndVolumeFractionVector_T & entries = field->get( *cell );
+         for( auto entry = entries.begin(); entry != entries.end(); ++entry )
+            if( entry->first == body )
+               fractions[ std::make_pair( &(*blockIt), *cell ) ] = entry->second;
+      }
+   }
+   return fractions;
+}
+
+/// Compares the incrementally updated field with the freshly initialized reference field. The entries of
+/// 'creepingBody' are compared with 'creepingFractions' instead, since the fractions of a body that has not moved
+/// (according to the updating epsilons) are not recomputed.
+void compare( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & updatedFieldID, const BlockDataID & referenceFieldID,
+              const pe::BodyID creepingBody, const Fractions_T & creepingFractions )
+{
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+   {
+      pe_coupling::BodyAndVolumeFractionField_T * updatedField   = blockIt->getData< pe_coupling::BodyAndVolumeFractionField_T >( updatedFieldID );
+      pe_coupling::BodyAndVolumeFractionField_T * referenceField = blockIt->getData< pe_coupling::BodyAndVolumeFractionField_T >( referenceFieldID );
+
+      const CellInterval cells = updatedField->xyzSizeWithGhostLayer();
+      for( auto cell = cells.begin(); cell != cells.end(); ++cell )
+      {
+         std::vector< pe_coupling::BodyAndVolumeFraction_T > updated;
+         std::vector< pe_coupling::BodyAndVolumeFraction_T > reference;
+         real_t creepingFraction = real_t(0);
+
+         const pe_coupling::BodyAndVolumeFractionVector_T & updatedEntries = updatedField->get( *cell );
+         for( auto entry = updatedEntries.begin(); entry != updatedEntries.end(); ++entry )
+         {
+            if( entry->first == creepingBody )
+               creepingFraction = entry->second;
+            else
+               updated.push_back( *entry );
+         }
+         const pe_coupling::BodyAndVolumeFractionVector_T & referenceEntries = referenceField->get( *cell );
+         for( auto entry = referenceEntries.begin(); entry != referenceEntries.end(); ++entry )
+         {
+            if( entry->first != creepingBody )
+               reference.push_back( *entry );
+         }
+
+         std::sort( updated.begin(), updated.end() );
+         std::sort( reference.begin(), reference.end() );
+
+         WALBERLA_CHECK_EQUAL( updated.size(), reference.size(), "cell " << *cell << " of block " << blockIt->getAABB() );
+         for( uint_t i = 0; i < updated.size(); ++i )
+         {
+            WALBERLA_CHECK_EQUAL( updated[i].first, reference[i].first, "cell " << *cell << " of block " << blockIt->getAABB() );
+            WALBERLA_CHECK_FLOAT_EQUAL( updated[i].second, reference[i].second, "cell " << *cell << " of block " << blockIt->getAABB() );
+         }
+
+         auto expected = creepingFractions.find( std::make_pair( &(*blockIt), *cell ) );
+         WALBERLA_CHECK_FLOAT_EQUAL( creepingFraction, ( expected != creepingFractions.end() ) ? expected->second : real_t(0),
+                                     "creeping body, cell " << *cell << " of block " << blockIt->getAABB() );
+      }
+   }
+}
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+   mpi::Environment env( argc, argv );
+
+   // 2x2x1 blocks on one process, the bodies cross the block borders
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(2), uint_t(2), uint_t(1), cellsPerBlock, cellsPerBlock, cellsPerBlock,
+                                                      real_t(1), false, false, false, false );
+
+   shared_ptr<pe::BodyStorage> globalBodyStorage = make_shared<pe::BodyStorage>();
+   pe::SetBodyTypeIDs<BodyTypeTuple>::execute();
+   auto bodyStorageID = blocks->addBlockData( pe::createStorageDataHandling<BodyTypeTuple>(), "pe Body Storage" );
+
+   // moves from the lower left block into the upper right block
+   pe::BodyID body = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 0, Vector3<real_t>( real_t(6.3), real_t(5.2), real_t(5.1) ), real_t(2.5) );
+   WALBERLA_CHECK_NOT_NULLPTR( body );
+   body->setLinearVel( real_t(0.7), real_t(0.55), real_t(0.05) );
+   body->setAngularVel( real_t(0), real_t(0), real_t(0.1) );
+   const walberla::id_t movingSID = body->getSystemID();
+
+   // at rest: its fractions are never recomputed
+   body = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 1, Vector3<real_t>( real_t(15.4), real_t(14.7), real_t(5.3) ), real_t(2) );
+   WALBERLA_CHECK_NOT_NULLPTR( body );
+
+   // moves slower than the velocity epsilon: its fractions are only recomputed once it has traveled further than the position epsilon
+   body = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 2, Vector3<real_t>( real_t(4.6), real_t(15.2), real_t(4.9) ), real_t(2) );
+   WALBERLA_CHECK_NOT_NULLPTR( body );
+   body->setLinearVel( real_t(5e-4), real_t(0), real_t(0) );
+   const walberla::id_t creepingSID = body->getSystemID();
+
+   // sits on the corner of all four blocks and is removed during the simulation
+   body = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 3, Vector3<real_t>( real_t(10.2), real_t(9.6), real_t(5.4) ), real_t(1.5) );
+   WALBERLA_CHECK_NOT_NULLPTR( body );
+   const walberla::id_t removedSID = body->getSystemID();
+
+   sync( blocks, bodyStorageID );
+
+   BlockDataID updatedFieldID   = field::addToStorage< pe_coupling::BodyAndVolumeFractionField_T >(
+                                     blocks, "updated body and volume fraction field", pe_coupling::BodyAndVolumeFractionVector_T(), field::zyxf, 1 );
+   BlockDataID referenceFieldID = field::addToStorage< pe_coupling::BodyAndVolumeFractionField_T >(
+                                     blocks, "reference body and volume fraction field", pe_coupling::BodyAndVolumeFractionVector_T(), field::zyxf, 1 );
+
+   pe_coupling::BodyAndVolumeFractionMapping updatedMapping( blocks, globalBodyStorage, bodyStorageID, updatedFieldID, false, false,
+                                                             velocityUpdatingEpsilon, positionUpdatingEpsilon, superSamplingDepth );
+   pe_coupling::BodyAndVolumeFractionMapping referenceMapping( blocks, globalBodyStorage, bodyStorageID, referenceFieldID, false, false,
+                                                               real_t(0), real_t(0), superSamplingDepth );
+
+   pe::BodyID creepingBody = getLocalBody( blocks, bodyStorageID, creepingSID );
+   Vector3<real_t> creepingPosition = creepingBody->getPosition();
+   Fractions_T creepingFractions = getFractions( blocks, referenceFieldID, creepingBody );
+   WALBERLA_CHECK( !creepingFractions.empty() );
+
+   compare( blocks, updatedFieldID, referenceFieldID, creepingBody, creepingFractions );
+
+   uint_t creepingUpdates = uint_t(0);
+   walberla::id_t addedSID = 0;
+
+   for( uint_t t = 0; t < uint_t(10); ++t )
+   {
+      move( blocks, bodyStorageID, movingSID, Vector3<real_t>( real_t(0.7), real_t(0.55), real_t(0.05) ) );
+      move( blocks, bodyStorageID, creepingSID, Vector3<real_t>( real_t(0.02), real_t(0), real_t(0) ) );
+      if( addedSID != 0 )
+         move( blocks, bodyStorageID, addedSID, Vector3<real_t>( real_t(0), real_t(0.6), real_t(0) ) );
+
+      if( t == uint_t(3) )
+      {
+         pe::BodyID removedBody = getLocalBody( blocks, bodyStorageID, removedSID );
+         WALBERLA_CHECK_NOT_NULLPTR( removedBody );
+         removedBody->markForDeletion();
+      }
+      if( t == uint_t(5) )
+      {
+         // a new body that enters the lower right block from its neighbor
+         body = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 4, Vector3<real_t>( real_t(14.5), real_t(8.1), real_t(5.5) ), real_t(2) );
+         WALBERLA_CHECK_NOT_NULLPTR( body );
+         body->setLinearVel( real_t(0), real_t(0.6), real_t(0) );
+         addedSID = body->getSystemID();
+      }
+
+      sync( blocks, bodyStorageID );
+
+      updatedMapping();
+      referenceMapping.initialize();
+
+      creepingBody = getLocalBody( blocks, bodyStorageID, creepingSID );
+      if( ( creepingBody->getPosition() - creepingPosition ).sqrLength() >= positionUpdatingEpsilon * positionUpdatingEpsilon )
+      {
+         creepingPosition  = creepingBody->getPosition();
+         creepingFractions = getFractions( blocks, referenceFieldID, creepingBody );
+         ++creepingUpdates;
+      }
+
+      compare( blocks, updatedFieldID, referenceFieldID, creepingBody, creepingFractions );
+   }
+
+   // the moving body ends up in the upper right block, the creeping body was recomputed (but not in every time step)
+   WALBERLA_CHECK_GREATER( getLocalBody( blocks, bodyStorageID, movingSID )->getPosition()[0], real_t(10) );
+   WALBERLA_CHECK_GREATER( getLocalBody( blocks, bodyStorageID, movingSID )->getPosition()[1], real_t(10) );
+   WALBERLA_CHECK_NULLPTR( getLocalBody( blocks, bodyStorageID, removedSID ) );
+   WALBERLA_CHECK_GREATER( creepingUpdates, uint_t(0) );
+   WALBERLA_CHECK_LESS( creepingUpdates, uint_t(10) );
+
+   return EXIT_SUCCESS;
+}
+
+} // namespace body_and_volume_fraction_mapping_test
+
+int main( int argc, char ** argv ){
+   return body_and_volume_fraction_mapping_test::main(argc, argv);
+}
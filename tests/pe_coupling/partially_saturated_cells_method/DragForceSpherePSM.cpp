@@ -84,8 +84,7 @@ typedef lbm::PdfField< LatticeModel_T >                 PdfField_T;
 typedef walberla::uint8_t                 flag_t;
 typedef FlagField< flag_t >               FlagField_T;
 
-typedef std::pair< pe::BodyID, real_t >                              BodyAndVolumeFraction_T;
-typedef GhostLayerField< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
+typedef pe_coupling::BodyAndVolumeFractionField_T                    BodyAndVolumeFractionField_T;
 
 typedef boost::tuple<pe::Sphere> BodyTypeTuple ;
 
@@ -454,7 +453,7 @@ int main( int argc, char **argv )
 
    // add body and volume fraction field
    BlockDataID bodyAndVolumeFractionFieldID = field::addToStorage< BodyAndVolumeFractionField_T >( blocks, "body and volume fraction field",
-                                                                                                   std::vector<BodyAndVolumeFraction_T>(), field::zyxf, 0 );
+                                                                                                   pe_coupling::BodyAndVolumeFractionVector_T(), field::zyxf, 0 );
 
    // map bodies and calculate solid volume fraction initially
    pe_coupling::BodyAndVolumeFractionMapping bodyMapping( blocks, globalBodyStorage, bodyStorageID, bodyAndVolumeFractionFieldID );
@@ -92,8 +92,7 @@ const uint_t FieldGhostLayers = 4;
 typedef walberla::uint8_t                 flag_t;
 typedef FlagField< flag_t >               FlagField_T;
 
-typedef std::pair< pe::BodyID, real_t >                              BodyAndVolumeFraction_T;
-typedef GhostLayerField< std::vector< BodyAndVolumeFraction_T >, 1 > BodyAndVolumeFractionField_T;
+typedef pe_coupling::BodyAndVolumeFractionField_T                    BodyAndVolumeFractionField_T;
 
 typedef lbm::NoSlip< LatticeModel_T, flag_t > NoSlip_T;
 typedef boost::tuples::tuple< NoSlip_T > BoundaryConditions_T;
@@ -568,7 +567,7 @@ int main( int argc, char **argv )
 
    // add body and volume fraction field
    BlockDataID bodyAndVolumeFractionFieldID = field::addToStorage< BodyAndVolumeFractionField_T >( blocks, "body and volume fraction field",
-                                                                                                   std::vector<BodyAndVolumeFraction_T>(), field::zyxf, FieldGhostLayers );
+                                                                                                   pe_coupling::BodyAndVolumeFractionVector_T(), field::zyxf, FieldGhostLayers );
 
    // add boundary handling & initialize outer domain boundaries
    BlockDataID boundaryHandlingID = blocks->addStructuredBlockData< BoundaryHandling_T >(
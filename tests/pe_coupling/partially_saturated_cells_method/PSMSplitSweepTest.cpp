@@ -0,0 +1,195 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file PSMSplitSweepTest.cpp
+//! \ingroup pe_coupling
+//! \brief Checks that PSMSplitSweep yields the same PDFs and hydrodynamic forces as the cell-wise PSMSweep
+//
+//======================================================================================================================
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/DataTypes.h"
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/math/all.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/FlagField.h"
+#include "field/communication/PackInfo.h"
+
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+
+#include "pe/basic.h"
+
+#include "pe_coupling/partially_saturated_cells_method/all.h"
+
+#include "stencil/D3Q27.h"
+
+#include <cmath>
+
+
+namespace psm_split_sweep_test
+{
+
+using namespace walberla;
+
+typedef FlagField< uint8_t > FlagField_T;
+
+typedef boost::tuple<pe::Sphere> BodyTypeTuple;
+
+const FlagUID Fluid_Flag( "fluid" );
+
+const uint_t length = uint_t(16);
+
+
+
+template< typename PdfField_T >
+void initializePdfField( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldID )
+{
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+   {
+      PdfField_T * pdfField = blockIt->getData< PdfField_T >( pdfFieldID );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         const Vector3< real_t > center = blocks->getBlockLocalCellCenter( *blockIt, cell.cell() );
+         const real_t phase = real_t(2) * math::PI * center[2] / real_c( length );
+         const Vector3< real_t > velocity( real_t(0.01) * std::sin( phase ), real_t(0.005) * std::cos( phase ), real_t(0.002) );
+         pdfField->setDensityAndVelocity( cell.cell(), velocity, real_t(1) + real_t(0.01) * std::cos( phase ) );
+      }
+   }
+}
+
+pe::BodyID getSphere( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & bodyStorageID )
+{
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+      for( auto bodyIt = pe::LocalBodyIterator::begin( *blockIt, bodyStorageID ); bodyIt != pe::LocalBodyIterator::end(); ++bodyIt )
+         return *bodyIt;
+   WALBERLA_ABORT( "Sphere not found!" );
+   return NULL;
+}
+
+template< typename LatticeModel_T, int SolidCollision_T, int Weighting_T >
+void compareSweeps( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & bodyStorageID,
+                    const BlockDataID & flagFieldID, const BlockDataID & bodyAndVolumeFractionFieldID )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   WALBERLA_LOG_INFO( "Comparing PSMSweep and PSMSplitSweep with SC" << SolidCollision_T << "W" << Weighting_T << ", compressible: " << LatticeModel_T::compressible );
+
+   LatticeModel_T latticeModel( real_t(1) / real_t(0.8) );
+
+   BlockDataID refFieldID   = lbm::addPdfFieldToStorage< LatticeModel_T >( blocks, "reference pdf field", latticeModel, field::fzyx );
+   BlockDataID splitFieldID = lbm::addPdfFieldToStorage< LatticeModel_T >( blocks, "split pdf field", latticeModel, field::fzyx );
+
+   initializePdfField< PdfField_T >( blocks, refFieldID );
+   initializePdfField< PdfField_T >( blocks, splitFieldID );
+
+   blockforest::communication::UniformBufferedScheme< stencil::D3Q27 > scheme( blocks );
+   scheme.addPackInfo( make_shared< field::communication::PackInfo< PdfField_T > >( refFieldID ) );
+   scheme.addPackInfo( make_shared< field::communication::PackInfo< PdfField_T > >( splitFieldID ) );
+
+   auto refSweep = pe_coupling::makePSMSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >(
+                      refFieldID, bodyAndVolumeFractionFieldID, blocks, flagFieldID, Fluid_Flag );
+   auto splitSweep = pe_coupling::makePSMSplitSweep< LatticeModel_T, FlagField_T, SolidCollision_T, Weighting_T >(
+                        splitFieldID, bodyAndVolumeFractionFieldID, blocks, flagFieldID, Fluid_Flag );
+
+   pe::BodyID sphere = getSphere( blocks, bodyStorageID );
+
+   for( uint_t t = 0; t < uint_t(3); ++t )
+   {
+      scheme();
+
+      sphere->resetForceAndTorque();
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+         (*refSweep)( &(*blockIt) );
+      const Vector3< real_t > refForce  = sphere->getForce();
+      const Vector3< real_t > refTorque = sphere->getTorque();
+
+      sphere->resetForceAndTorque();
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+         (*splitSweep)( &(*blockIt) );
+      const Vector3< real_t > splitForce  = sphere->getForce();
+      const Vector3< real_t > splitTorque = sphere->getTorque();
+
+      WALBERLA_CHECK_GREATER( refForce.length(), real_t(0) );
+      for( uint_t i = 0; i < uint_t(3); ++i )
+      {
+         WALBERLA_CHECK_FLOAT_EQUAL( refForce[i],  splitForce[i]  );
+         WALBERLA_CHECK_FLOAT_EQUAL( refTorque[i], splitTorque[i] );
+      }
+
+      for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+      {
+         PdfField_T * refField   = blockIt->getData< PdfField_T >( refFieldID );
+         PdfField_T * splitField = blockIt->getData< PdfField_T >( splitFieldID );
+         for( auto cell = refField->beginXYZ(); cell != refField->end(); ++cell )
+            for( uint_t f = 0; f < LatticeModel_T::Stencil::Size; ++f )
+               WALBERLA_CHECK_FLOAT_EQUAL( refField->get( cell.cell(), f ), splitField->get( cell.cell(), f ), cell.cell() << ", f = " << f );
+      }
+   }
+}
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+   mpi::Environment env( argc, argv );
+
+   auto blocks = blockforest::createUniformBlockGrid( 1, 1, 1, length, length, length, real_t(1), true, true, true, true );
+
+   // sphere that is translating and rotating in the middle of the domain
+   shared_ptr<pe::BodyStorage> globalBodyStorage = make_shared<pe::BodyStorage>();
+   pe::SetBodyTypeIDs<BodyTypeTuple>::execute();
+   auto bodyStorageID = blocks->addBlockData( pe::createStorageDataHandling<BodyTypeTuple>(), "pe Body Storage" );
+
+   auto sphere = pe::createSphere( *globalBodyStorage, blocks->getBlockStorage(), bodyStorageID, 0,
+                                   Vector3<real_t>( real_t(7.7), real_t(8.2), real_t(8.4) ), real_t(4.3) );
+   WALBERLA_CHECK_NOT_NULLPTR( sphere );
+   sphere->setLinearVel( real_t(0.01), real_t(-0.004), real_t(0.002) );
+   sphere->setAngularVel( real_t(0), real_t(0.001), real_t(0.002) );
+
+   BlockDataID flagFieldID = field::addFlagFieldToStorage< FlagField_T >( blocks, "flag field" );
+   for( auto blockIt = blocks->begin(); blockIt != blocks->end(); ++blockIt )
+   {
+      FlagField_T * flagField = blockIt->getData< FlagField_T >( flagFieldID );
+      const FlagField_T::flag_t fluid = flagField->registerFlag( Fluid_Flag );
+      flagField->setWithGhostLayer( fluid );
+   }
+
+   BlockDataID bodyAndVolumeFractionFieldID = field::addToStorage< pe_coupling::BodyAndVolumeFractionField_T >(
+                                                 blocks, "body and volume fraction field", pe_coupling::BodyAndVolumeFractionVector_T(), field::zyxf, 0 );
+   pe_coupling::BodyAndVolumeFractionMapping bodyMapping( blocks, globalBodyStorage, bodyStorageID, bodyAndVolumeFractionFieldID );
+
+   typedef lbm::D3Q19< lbm::collision_model::SRT, false > IncompressibleLatticeModel_T;
+   typedef lbm::D3Q19< lbm::collision_model::SRT, true >  CompressibleLatticeModel_T;
+
+   compareSweeps< IncompressibleLatticeModel_T, 1, 1 >( blocks, bodyStorageID, flagFieldID, bodyAndVolumeFractionFieldID );
+   compareSweeps< IncompressibleLatticeModel_T, 2, 1 >( blocks, bodyStorageID, flagFieldID, bodyAndVolumeFractionFieldID );
+   compareSweeps< IncompressibleLatticeModel_T, 3, 2 >( blocks, bodyStorageID, flagFieldID, bodyAndVolumeFractionFieldID );
+   compareSweeps< CompressibleLatticeModel_T,   1, 2 >( blocks, bodyStorageID, flagFieldID, bodyAndVolumeFractionFieldID );
+   compareSweeps< CompressibleLatticeModel_T,   3, 1 >( blocks, bodyStorageID, flagFieldID, bodyAndVolumeFractionFieldID );
+
+   return EXIT_SUCCESS;
+}
+
+} // namespace psm_split_sweep_test
+
+int main( int argc, char ** argv ){
+   return psm_split_sweep_test::main(argc, argv);
+}
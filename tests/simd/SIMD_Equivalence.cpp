@@ -35,6 +35,10 @@
 //===================================================================================================================
 
 
+#ifdef WALBERLA_SIMD_AVX512_AVAILABLE
+#include "simd/AVX512.h"
+#endif
+
 #ifdef WALBERLA_SIMD_AVX2_AVAILABLE
 #include "simd/AVX2.h"
 #endif
@@ -67,6 +71,23 @@
 //
 //===================================================================================================================
 
+// ---------------- AVX512 ----------
+#ifdef IS0_AVX512
+#ifdef WALBERLA_SIMD_AVX512_AVAILABLE
+#define is0 avx512
+#else
+#define is0 scalar
+#endif
+#endif
+
+#ifdef IS1_AVX512
+#ifdef WALBERLA_SIMD_AVX512_AVAILABLE
+#define is1 avx512
+#else
+#define is1 scalar
+#endif
+#endif
+
 // ---------------- AVX2 ------------
 #ifdef IS0_AVX2
 #ifdef WALBERLA_SIMD_AVX2_AVAILABLE
@@ -314,6 +335,19 @@ void compareAndMaskTest()
    WALBERLA_CHECK_EQUAL( a_mask, b_mask );
 }
 
+void streamingStore()
+{
+   alignas(32) double memA[4];
+   alignas(32) double memB[4];
+
+   is0::stream_aligned( memA, is0::make_double4_r( 1.0, 2.0, 3.0, 4.0 ) );
+   is1::stream_aligned( memB, is1::make_double4_r( 1.0, 2.0, 3.0, 4.0 ) );
+   is0::stream_fence();
+   is1::stream_fence();
+
+   checkVecEqual( is0::load_aligned( memA ), is1::load_aligned( memB ), "streamingStore" );
+}
+
 
 
 int main( int argc, char ** argv )
@@ -335,6 +369,7 @@ int main( int argc, char ** argv )
    sqrtTest();
    blendInteger();
    compareAndMaskTest();
+   streamingStore();
    return 0;
 }
 
@@ -0,0 +1,247 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file TaskSweepTimeloopTest.cpp
+//! \ingroup timeloop
+//! \brief Checks that the TaskSweepTimeloop executes the sweeps of each block in order and yields the same results
+//!        as the SweepTimeloop
+//
+//======================================================================================================================
+
+#include "lbm/communication/PdfFieldPackInfo.h"
+#include "lbm/field/AddToStorage.h"
+#include "lbm/field/PdfField.h"
+#include "lbm/lattice_model/D3Q19.h"
+#include "lbm/sweeps/CellwiseSweep.h"
+
+#include "blockforest/Initialization.h"
+#include "blockforest/communication/UniformBufferedScheme.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/math/Utility.h"
+#include "core/mpi/Environment.h"
+
+#include "domain_decomposition/SharedSweep.h"
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+
+#include "timeloop/SweepTimeloop.h"
+#include "timeloop/TaskSweepTimeloop.h"
+
+#include <cmath>
+
+
+using namespace walberla;
+
+typedef GhostLayerField< uint_t, 1 > ScalarField_T;
+
+const uint_t Timesteps = uint_t(3);
+
+
+
+// order dependent update: the result is only correct if the sweeps are executed in the order of registration
+class OrderSweep
+{
+public:
+
+   OrderSweep( const BlockDataID & fieldId, const uint_t id ) : fieldId_( fieldId ), id_( id ) {}
+
+   void operator()( IBlock * const block )
+   {
+      ScalarField_T * field = block->getData< ScalarField_T >( fieldId_ );
+      for( auto cell = field->begin(); cell != field->end(); ++cell )
+         *cell = ( *cell * uint_t(3) + id_ ) % uint_t(1000003);
+   }
+
+private:
+
+   BlockDataID fieldId_;
+   uint_t id_;
+};
+
+
+
+uint_t expectedValue( const uint_t timesteps, const uint_t sweeps, const uint_t lastSweep )
+{
+   uint_t value( 0 );
+   for( uint_t t = 0; t < timesteps; ++t )
+      for( uint_t s = 1; s <= sweeps; ++s )
+         value = ( value * uint_t(3) + s ) % uint_t(1000003);
+   for( uint_t s = 1; s <= lastSweep; ++s )
+      value = ( value * uint_t(3) + s ) % uint_t(1000003);
+   return value;
+}
+
+
+
+class CheckFunction
+{
+public:
+
+   CheckFunction( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldId, const Timeloop & timeloop, const uint_t lastSweep ) :
+      blocks_( blocks ), fieldId_( fieldId ), timeloop_( &timeloop ), lastSweep_( lastSweep ) {}
+
+   // all tasks of all previous sweeps must be completed when a before/after function is called
+   void operator()()
+   {
+      const uint_t expected = expectedValue( timeloop_->getCurrentTimeStep(), uint_t(4), lastSweep_ );
+      for( auto block = blocks_->begin(); block != blocks_->end(); ++block )
+      {
+         ScalarField_T * field = block->getData< ScalarField_T >( fieldId_ );
+         for( auto cell = field->begin(); cell != field->end(); ++cell )
+            WALBERLA_CHECK_EQUAL( *cell, expected );
+      }
+   }
+
+private:
+
+   shared_ptr< StructuredBlockForest > blocks_;
+   BlockDataID fieldId_;
+   const Timeloop * timeloop_;
+   uint_t lastSweep_;
+};
+
+
+
+void orderTest( const shared_ptr< StructuredBlockForest > & blocks, const bool useTimingPool )
+{
+   BlockDataID fieldId = field::addToStorage< ScalarField_T >( blocks, "scalar field", uint_t(0) );
+
+   TaskSweepTimeloop timeloop( blocks->getBlockStorage(), Timesteps );
+
+   // no before/after functions between the first three sweeps -> no synchronization of the blocks in between
+   timeloop.add() << Sweep( OrderSweep( fieldId, uint_t(1) ), "sweep 1" );
+   timeloop.add() << Sweep( OrderSweep( fieldId, uint_t(2) ), "sweep 2" );
+   timeloop.add() << Sweep( OrderSweep( fieldId, uint_t(3) ), "sweep 3" )
+                  << AfterFunction( CheckFunction( blocks, fieldId, timeloop, uint_t(3) ), "check after sweep 3" );
+   timeloop.add() << BeforeFunction( CheckFunction( blocks, fieldId, timeloop, uint_t(3) ), "check before sweep 4" )
+                  << Sweep( OrderSweep( fieldId, uint_t(4) ), "sweep 4" );
+
+   WcTimingPool timing;
+   if( useTimingPool )
+      timeloop.run( timing, false );
+   else
+      timeloop.run( false );
+
+   const uint_t expected = expectedValue( Timesteps, uint_t(4), uint_t(0) );
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      ScalarField_T * field = block->getData< ScalarField_T >( fieldId );
+      for( auto cell = field->begin(); cell != field->end(); ++cell )
+         WALBERLA_CHECK_EQUAL( *cell, expected );
+   }
+
+   if( useTimingPool )
+   {
+      WALBERLA_CHECK_EQUAL( timing[ "sweep 1" ].getCounter(), Timesteps * blocks->getNumberOfBlocks() );
+      WALBERLA_CHECK_EQUAL( timing[ "sweep 4" ].getCounter(), Timesteps * blocks->getNumberOfBlocks() );
+   }
+}
+
+
+
+template< typename LatticeModel_T >
+void initialize( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & pdfFieldId )
+{
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   const real_t length = real_c( blocks->getNumberOfXCells() );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      PdfField_T * pdfField = block->template getData< PdfField_T >( pdfFieldId );
+      for( auto cell = pdfField->beginXYZ(); cell != pdfField->end(); ++cell )
+      {
+         Cell global( cell.x(), cell.y(), cell.z() );
+         blocks->transformBlockLocalToGlobalCell( global, *block );
+
+         const real_t x = real_t(2) * math::PI * real_c( global.x() ) / length;
+         const real_t y = real_t(2) * math::PI * real_c( global.y() ) / length;
+
+         const Vector3< real_t > velocity( real_t(0.02) * std::sin( y ), real_t(0.01) * std::cos( x ), real_t(0) );
+         pdfField->setDensityAndVelocity( cell.x(), cell.y(), cell.z(), velocity, real_t(1) );
+      }
+   }
+}
+
+
+
+// the lbm sweeps share their temporary PDF fields between blocks -> must work if different blocks are processed at the same time
+void lbmTest( const shared_ptr< StructuredBlockForest > & blocks )
+{
+   typedef lbm::D3Q19< lbm::collision_model::SRT > LatticeModel_T;
+   typedef lbm::PdfField< LatticeModel_T > PdfField_T;
+
+   LatticeModel_T latticeModel = LatticeModel_T( lbm::collision_model::SRT( real_t(1.4) ) );
+
+   BlockDataID referenceId = lbm::addPdfFieldToStorage( blocks, "reference pdf field", latticeModel, uint_t(1), field::fzyx );
+   BlockDataID    taskId   = lbm::addPdfFieldToStorage( blocks, "task pdf field", latticeModel, uint_t(1), field::fzyx );
+
+   initialize< LatticeModel_T >( blocks, referenceId );
+   initialize< LatticeModel_T >( blocks, taskId );
+
+   blockforest::communication::UniformBufferedScheme< LatticeModel_T::CommunicationStencil > referenceCommunication( blocks );
+   referenceCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( referenceId ) );
+
+   SweepTimeloop referenceTimeloop( blocks->getBlockStorage(), Timesteps );
+   referenceTimeloop.add() << BeforeFunction( referenceCommunication, "communication" )
+                           << Sweep( makeSharedSweep( lbm::makeCellwiseSweep< LatticeModel_T >( referenceId ) ), "stream & collide" );
+   referenceTimeloop.run( false );
+
+   blockforest::communication::UniformBufferedScheme< LatticeModel_T::CommunicationStencil > taskCommunication( blocks );
+   taskCommunication.addPackInfo( make_shared< lbm::PdfFieldPackInfo< LatticeModel_T > >( taskId ) );
+
+   TaskSweepTimeloop taskTimeloop( blocks->getBlockStorage(), Timesteps );
+   taskTimeloop.add() << BeforeFunction( taskCommunication, "communication" )
+                      << Sweep( makeSharedSweep( lbm::makeCellwiseSweep< LatticeModel_T >( taskId ) ), "stream & collide" );
+   taskTimeloop.run( false );
+
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      const PdfField_T * reference = block->getData< PdfField_T >( referenceId );
+      const PdfField_T * task      = block->getData< PdfField_T >( taskId );
+
+      for( auto cell = reference->beginXYZ(); cell != reference->end(); ++cell )
+      {
+         for( uint_t f = 0; f != LatticeModel_T::Stencil::Size; ++f )
+            WALBERLA_CHECK_FLOAT_EQUAL( reference->get( cell.x(), cell.y(), cell.z(), f ),
+                                             task->get( cell.x(), cell.y(), cell.z(), f ),
+                                        "Cell " << Cell( cell.x(), cell.y(), cell.z() ) << ", component " << f );
+      }
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+
+   mpi::Environment env( argc, argv );
+
+   // 4x4x2 blocks on one process, periodic in all directions
+   auto blocks = blockforest::createUniformBlockGrid( uint_t(4), uint_t(4), uint_t(2),
+                                                      uint_t(6), uint_t(5), uint_t(4),
+                                                      real_t(1), false,
+                                                      true, true, true );
+
+   orderTest( blocks, false );
+   orderTest( blocks, true );
+
+   lbmTest( blocks );
+
+   return 0;
+}
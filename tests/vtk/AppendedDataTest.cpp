@@ -0,0 +1,294 @@
+//======================================================================================================================
+//
+//  This file is part of waLBerla. waLBerla is free software: you can
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of
+//  the License, or (at your option) any later version.
+//
+//  waLBerla is distributed in the hope that it will be useful, but WITHOUT
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+//  for more details.
+//
+//  You should have received a copy of the GNU General Public License along
+//  with waLBerla (see COPYING.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+//! \file AppendedDataTest.cpp
+//! \ingroup vtk
+//! \brief Parses VTK files written with raw appended data and checks the offsets, the data sizes, and the data
+//
+//======================================================================================================================
+
+#include "blockforest/Initialization.h"
+
+#include "core/debug/TestSubsystem.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Environment.h"
+
+#include "field/AddToStorage.h"
+#include "field/GhostLayerField.h"
+#include "field/vtk/VTKWriter.h"
+
+#include "vtk/VTKOutput.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef WALBERLA_BUILD_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+
+using namespace walberla;
+
+typedef GhostLayerField< real_t, 1 > ScalarField_T;
+
+const uint_t xCells = uint_t(4);
+const uint_t yCells = uint_t(3);
+const uint_t zCells = uint_t(5);
+
+
+
+real_t cellValue( const Cell & globalCell )
+{
+   return real_c( globalCell.x() + 100 * globalCell.y() + 10000 * globalCell.z() );
+}
+
+void initField( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldID )
+{
+   for( auto block = blocks->begin(); block != blocks->end(); ++block )
+   {
+      ScalarField_T * field = block->getData< ScalarField_T >( fieldID );
+      for( auto cell = field->beginXYZ(); cell != field->end(); ++cell )
+      {
+         Cell globalCell = cell.cell();
+         blocks->transformBlockLocalToGlobalCell( globalCell, *block );
+         *cell = cellValue( globalCell );
+      }
+   }
+}
+
+
+
+std::string attribute( const std::string & tag, const std::string & name )
+{
+   const std::string key = " " + name + "=\"";
+   const size_t begin = tag.find( key );
+   WALBERLA_CHECK_UNEQUAL( begin, std::string::npos, "Attribute \"" << name << "\" is missing in " << tag );
+   const size_t end = tag.find( '"', begin + key.size() );
+   return tag.substr( begin + key.size(), end - begin - key.size() );
+}
+
+uint32_t readUInt32( const std::string & data, const size_t pos )
+{
+   WALBERLA_CHECK_LESS_EQUAL( pos + sizeof( uint32_t ), data.size() );
+   uint32_t value;
+   std::memcpy( &value, &data[pos], sizeof( uint32_t ) );
+   return value;
+}
+
+/// returns the (decompressed) data of the DataArray starting at 'pos', 'length' is set to the number of bytes read
+std::string readArray( const std::string & appended, const size_t pos, const bool compressed, size_t & length )
+{
+   if( !compressed )
+   {
+      const uint32_t size = readUInt32( appended, pos );
+      length = sizeof( uint32_t ) + size;
+      WALBERLA_CHECK_LESS_EQUAL( pos + length, appended.size() );
+      return appended.substr( pos + sizeof( uint32_t ), size );
+   }
+
+#ifdef WALBERLA_BUILD_WITH_ZLIB
+   const uint32_t numberOfBlocks = readUInt32( appended, pos );
+   const uint32_t blockSize      = readUInt32( appended, pos + 4 );
+   const uint32_t lastBlockSize  = readUInt32( appended, pos + 8 );
+
+   std::string data;
+   size_t compressedPos = pos + 12 + 4 * numberOfBlocks;
+   for( uint32_t b = 0; b != numberOfBlocks; ++b )
+   {
+      const uint32_t compressedSize = readUInt32( appended, pos + 12 + 4 * b );
+      uLongf size = ( b == numberOfBlocks - 1 && lastBlockSize > 0 ) ? lastBlockSize : blockSize;
+      std::vector< Bytef > buffer( size );
+      WALBERLA_CHECK_EQUAL( uncompress( &buffer[0], &size, reinterpret_cast< const Bytef * >( &appended[ compressedPos ] ), compressedSize ), Z_OK );
+      data.append( reinterpret_cast< const char * >( &buffer[0] ), size );
+      compressedPos += compressedSize;
+   }
+   length = compressedPos - pos;
+   return data;
+#else
+   WALBERLA_ABORT( "compressed output requires zlib" );
+   return std::string();
+#endif
+}
+
+
+
+/// checks all offsets/sizes in the file and the data written by the field writer
+void checkFile( const std::string & filename, const shared_ptr< StructuredBlockForest > & blocks, const bool compressed )
+{
+   std::ifstream ifs( filename.c_str(), std::ifstream::binary );
+   const std::string content( ( std::istreambuf_iterator< char >( ifs ) ), std::istreambuf_iterator< char >() );
+
+   const std::string appendedBegin( "<AppendedData encoding=\"raw\">" );
+   const std::string appendedEnd( "\n </AppendedData>\n</VTKFile>\n" );
+
+   const size_t appendedPos = content.find( appendedBegin );
+   WALBERLA_CHECK_UNEQUAL( appendedPos, std::string::npos );
+   const size_t dataBegin = content.find( '_', appendedPos ) + 1;
+   WALBERLA_CHECK_GREATER_EQUAL( content.size(), dataBegin + appendedEnd.size() );
+   WALBERLA_CHECK_EQUAL( content.substr( content.size() - appendedEnd.size() ), appendedEnd );
+
+   const std::string xml      = content.substr( 0, appendedPos );
+   const std::string appended = content.substr( dataBegin, content.size() - appendedEnd.size() - dataBegin );
+
+   WALBERLA_CHECK_EQUAL( xml.find( "compressor=\"vtkZLibDataCompressor\"" ) != std::string::npos, compressed );
+   WALBERLA_CHECK_EQUAL( xml.find( "format=\"binary\"" ), std::string::npos );
+
+   uint_t numberOfCells = uint_t(0); // of the current piece
+   CellInterval extent;              // of the current piece (empty for vtu files)
+   uint_t cellsInFile = uint_t(0);
+   real_t sum = real_t(0);
+   size_t expectedOffset = size_t(0);
+
+   size_t pos = xml.find( '<' );
+   while( pos != std::string::npos )
+   {
+      const std::string tag = xml.substr( pos, xml.find( '>', pos ) - pos );
+
+      if( tag.compare( 0, 7, "<Piece " ) == 0 )
+      {
+         if( tag.find( "Extent=" ) != std::string::npos )
+         {
+            std::istringstream iss( attribute( tag, "Extent" ) );
+            cell_idx_t e[6];
+            for( uint_t i = 0; i < 6; ++i ) iss >> e[i];
+            extent = CellInterval( e[0], e[2], e[4], e[1] - 1, e[3] - 1, e[5] - 1 );
+            numberOfCells = extent.numCells();
+         }
+         else
+         {
+            numberOfCells = boost::lexical_cast< uint_t >( attribute( tag, "NumberOfCells" ) );
+         }
+         cellsInFile += numberOfCells;
+      }
+      else if( tag.compare( 0, 11, "<DataArray " ) == 0 )
+      {
+         WALBERLA_CHECK_EQUAL( attribute( tag, "format" ), "appended" );
+         const size_t offset = boost::lexical_cast< size_t >( attribute( tag, "offset" ) );
+         WALBERLA_CHECK_EQUAL( offset, expectedOffset, "DataArrays are expected to be stored contiguously in the appended data section" );
+
+         size_t length;
+         const std::string data = readArray( appended, offset, compressed, length );
+         expectedOffset += length;
+
+         if( tag.find( " Name=\"field\"" ) != std::string::npos )
+         {
+            WALBERLA_CHECK_EQUAL( attribute( tag, "type" ), vtk::typeToString< real_t >() );
+            WALBERLA_CHECK_EQUAL( data.size(), numberOfCells * sizeof( real_t ) );
+
+            std::vector< real_t > values( numberOfCells );
+            if( numberOfCells > uint_t(0) )
+               std::memcpy( &values[0], &data[0], data.size() );
+
+            if( !extent.empty() ) // vti: the order of the cells is known
+            {
+               uint_t i = uint_t(0);
+               for( auto cell = extent.begin(); cell != extent.end(); ++cell, ++i )
+                  WALBERLA_CHECK_FLOAT_EQUAL( values[i], cellValue( *cell ), *cell );
+            }
+
+            for( auto value = values.begin(); value != values.end(); ++value )
+               sum += *value;
+         }
+         else if( tag.find( " Name=\"types\"" ) != std::string::npos )
+         {
+            WALBERLA_CHECK_EQUAL( data.size(), numberOfCells );
+            for( auto type = data.begin(); type != data.end(); ++type )
+               WALBERLA_CHECK_EQUAL( int_c( *type ), 11 ); // voxel
+         }
+      }
+
+      pos = xml.find( '<', pos + 1 );
+   }
+
+   WALBERLA_CHECK_EQUAL( expectedOffset, appended.size() );
+
+   const CellInterval domain = blocks->getDomainCellBB();
+   WALBERLA_CHECK_EQUAL( cellsInFile, domain.numCells() );
+
+   real_t expectedSum = real_t(0);
+   for( auto cell = domain.begin(); cell != domain.end(); ++cell )
+      expectedSum += cellValue( *cell );
+   WALBERLA_CHECK_FLOAT_EQUAL( sum, expectedSum );
+}
+
+
+
+void appendedData( const shared_ptr< StructuredBlockForest > & blocks, const BlockDataID & fieldID,
+                   const bool forcePVTU, const bool compressed, const bool async )
+{
+   const std::string identifier = std::string( "appended_data_" ) + ( forcePVTU ? "vtu" : "vti" ) + ( compressed ? "_compressed" : "" ) +
+                                  ( async ? "_async" : "" );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Writing \"" << identifier << "\"" );
+
+   auto vtkOutput = vtk::createVTKOutput_BlockData( blocks, identifier, uint_t(1), uint_t(0), forcePVTU, "vtk_out_AppendedDataTest" );
+   vtkOutput->addCellDataWriter( make_shared< field::VTKWriter< ScalarField_T > >( fieldID, "field" ) );
+   vtkOutput->enableAppendedRawData( compressed );
+
+   if( async )
+   {
+      auto asyncWriter = make_shared< mpi::AsyncFileWriter >();
+      vtkOutput->setAsyncFileWriter( asyncWriter );
+      vtkOutput->write();
+      asyncWriter->flush();
+   }
+   else
+   {
+      vtkOutput->write();
+   }
+
+   WALBERLA_MPI_WORLD_BARRIER();
+
+   WALBERLA_ROOT_SECTION()
+   {
+      checkFile( "vtk_out_AppendedDataTest/" + identifier + "/simulation_step_0." + ( forcePVTU ? "vtu" : "vti" ), blocks, compressed );
+   }
+}
+
+
+
+int main( int argc, char ** argv )
+{
+   debug::enterTestMode();
+   mpi::Environment env( argc, argv );
+
+   // 8 blocks with different numbers of blocks per process (if run with 3 processes)
+   auto blocks = blockforest::createUniformBlockGrid( 2, 2, 2, xCells, yCells, zCells, real_t(1), uint_t(0), true, false );
+
+   const BlockDataID fieldID = field::addToStorage< ScalarField_T >( blocks, "field", real_t(0), field::zyxf, uint_t(1) );
+   initField( blocks, fieldID );
+
+   appendedData( blocks, fieldID, false, false, false );
+   appendedData( blocks, fieldID, true,  false, false );
+   appendedData( blocks, fieldID, false, false, true  );
+   appendedData( blocks, fieldID, true,  false, true  );
+#ifdef WALBERLA_BUILD_WITH_ZLIB
+   appendedData( blocks, fieldID, false, true,  false );
+   appendedData( blocks, fieldID, true,  true,  false );
+   appendedData( blocks, fieldID, false, true,  true  );
+#endif
+
+   WALBERLA_MPI_WORLD_BARRIER();
+   WALBERLA_ROOT_SECTION() { boost::filesystem::remove_all( "vtk_out_AppendedDataTest" ); }
+
+   return EXIT_SUCCESS;
+}